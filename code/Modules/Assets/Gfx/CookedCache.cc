@@ -0,0 +1,418 @@
+//------------------------------------------------------------------------------
+//  CookedCache.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "CookedCache.h"
+#include "Core/Hash/Hash.h"
+#include "Core/String/StringBuilder.h"
+#include "Core/Memory/Memory.h"
+#include "IO/IO.h"
+#include <cstring>
+
+namespace Oryol {
+
+URL CookedCache::location;
+bool CookedCache::valid = false;
+Map<StringAtom, Ptr<CookedCache::prefetchStat>> CookedCache::prefetches;
+
+//------------------------------------------------------------------------------
+void
+CookedCache::Setup(const URL& loc) {
+    o_assert(!valid);
+    o_assert(!loc.Empty());
+    location = loc;
+    valid = true;
+}
+
+//------------------------------------------------------------------------------
+void
+CookedCache::Discard() {
+    o_assert(valid);
+    for (const auto& kvp : prefetches) {
+        kvp.Value()->Cancelled = true;
+    }
+    prefetches.Clear();
+    location = URL();
+    valid = false;
+}
+
+//------------------------------------------------------------------------------
+bool
+CookedCache::IsValid() {
+    return valid;
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+CookedCache::SourceKey(const URL& url, const IOFileInfo& info) {
+    HashBuilder hashBuilder;
+    hashBuilder.Add(url.AsCStr(), int(std::strlen(url.AsCStr())));
+    hashBuilder.AddValue(info.Size);
+    hashBuilder.AddValue(info.ModTime);
+    return hashBuilder.Result();
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+CookedCache::ContentHash(const void* data, int numBytes) {
+    return Hash::Bytes(data, numBytes);
+}
+
+//------------------------------------------------------------------------------
+URL
+CookedCache::CacheURL(uint64_t sourceKey, const char* ext) {
+    o_assert_dbg(valid && ext);
+    StringBuilder strBuilder(location.AsCStr());
+    strBuilder.AppendFormat(64, "%016llx%s", (unsigned long long) sourceKey, ext);
+    return URL(strBuilder.GetString());
+}
+
+//------------------------------------------------------------------------------
+void
+CookedCache::Prefetch(const URL& source, const char* ext) {
+    o_assert_dbg(valid && ext);
+    // a finished prefetch is started again, the prefetched data might
+    // already have been consumed by a loader
+    const StringAtom key = source.Get();
+    if (prefetches.Contains(key)) {
+        if (!prefetches[key]->done) {
+            return;
+        }
+        prefetches.Erase(key);
+    }
+    // the blob URL depends on the source file attributes, so
+    // this starts with a stat of the source file
+    Ptr<prefetchStat> req = prefetchStat::Create();
+    req->Url = source;
+    req->Priority = IOPriority::Low;
+    req->source = source;
+    req->ext = ext;
+    prefetches.Add(key, req);
+    IO::Put(req);
+}
+
+//------------------------------------------------------------------------------
+void
+CookedCache::CancelPrefetch(const URL& source) {
+    if (prefetches.Contains(source.Get())) {
+        Ptr<prefetchStat> req = prefetches[source.Get()];
+        prefetches.Erase(source.Get());
+        req->Cancelled = true;
+        if (req->isBlob) {
+            IO::CancelPrefetch({ req->Url });
+        }
+    }
+    IO::CancelPrefetch({ source });
+}
+
+//------------------------------------------------------------------------------
+/**
+    NOTE: this is called on the IO worker thread.
+*/
+void
+CookedCache::prefetchStat::onHandled() {
+    Ptr<prefetchStat> self(this);
+    IO::PostToMainThread([self] {
+        CookedCache::prefetchHandled(self);
+    });
+}
+
+//------------------------------------------------------------------------------
+void
+CookedCache::prefetchHandled(const Ptr<prefetchStat>& req) {
+    // the prefetch might have been cancelled in the meantime
+    const StringAtom key = req->source.Get();
+    if (!valid || !prefetches.Contains(key) || (prefetches[key].get() != req.get())) {
+        return;
+    }
+    if (!req->isBlob) {
+        if (IOStatus::OK == req->Status) {
+            // check whether the cooked blob exists
+            const uint64_t sourceKey = SourceKey(req->source, req->Info);
+            Ptr<prefetchStat> blobReq = prefetchStat::Create();
+            blobReq->Url = CacheURL(sourceKey, req->ext);
+            blobReq->Priority = IOPriority::Low;
+            blobReq->source = req->source;
+            blobReq->ext = req->ext;
+            blobReq->isBlob = true;
+            prefetches[key] = blobReq;
+            IO::Put(blobReq);
+        }
+        else {
+            // no cache lookup possible, the loader will load the source file
+            prefetches.Erase(key);
+            IO::Prefetch({ req->source });
+        }
+    }
+    else if (IOStatus::OK == req->Status) {
+        // cache hit, the source file won't be needed
+        req->done = true;
+        IO::Prefetch({ req->Url });
+    }
+    else {
+        // cache miss, the loader will load and cook the source file
+        req->done = true;
+        IO::Prefetch({ req->source });
+    }
+}
+
+//------------------------------------------------------------------------------
+uint8_t*
+CookedCache::writeBlob(Buffer& blob, uint32_t kind, uint64_t sourceKey, uint64_t contentHash, const void* attrs, int attrsSize, int dataSize) {
+    const int dataOffset = Memory::RoundUp(sizeof(header) + attrsSize, DataAlignment);
+    blob.Clear();
+    blob.Reserve(dataOffset + dataSize);
+    uint8_t* ptr = blob.Add(dataOffset + dataSize);
+    Memory::Clear(ptr, dataOffset);
+
+    header hdr;
+    hdr.magic = Magic;
+    hdr.version = Version;
+    hdr.kind = kind;
+    hdr.attrsSize = attrsSize;
+    hdr.sourceKey = sourceKey;
+    hdr.contentHash = contentHash;
+    hdr.dataOffset = dataOffset;
+    hdr.dataSize = dataSize;
+    Memory::Copy(&hdr, ptr, sizeof(hdr));
+    Memory::Copy(attrs, ptr + sizeof(hdr), attrsSize);
+    return ptr + dataOffset;
+}
+
+//------------------------------------------------------------------------------
+bool
+CookedCache::readHeader(const void* blob, int blobSize, header& outHeader) {
+    if ((nullptr == blob) || (blobSize < int(sizeof(header)))) {
+        return false;
+    }
+    Memory::Copy(blob, &outHeader, sizeof(outHeader));
+    const int64_t attrsEnd = int64_t(sizeof(header)) + outHeader.attrsSize;
+    return (outHeader.magic == Magic) &&
+           (outHeader.version == Version) &&
+           (outHeader.dataOffset >= attrsEnd) &&
+           (outHeader.dataOffset <= blobSize) &&
+           (outHeader.dataSize >= 0) &&
+           (outHeader.dataSize <= (blobSize - outHeader.dataOffset));
+}
+
+//------------------------------------------------------------------------------
+const uint8_t*
+CookedCache::readBlob(const void* blob, int blobSize, uint32_t kind, uint64_t sourceKey, int attrsSize, const uint8_t*& outData, int& outNumBytes) {
+    header hdr;
+    if (!readHeader(blob, blobSize, hdr) ||
+        (hdr.kind != kind) ||
+        (hdr.attrsSize != uint32_t(attrsSize)) ||
+        (hdr.sourceKey != sourceKey)) {
+        return nullptr;
+    }
+    const uint8_t* ptr = (const uint8_t*) blob;
+    outData = ptr + hdr.dataOffset;
+    outNumBytes = hdr.dataSize;
+    return ptr + sizeof(hdr);
+}
+
+//------------------------------------------------------------------------------
+bool
+CookedCache::inRange(int offset, int64_t size, int numBytes) {
+    return (offset >= 0) && (size >= 0) && (offset <= numBytes) && (size <= (numBytes - offset));
+}
+
+//------------------------------------------------------------------------------
+bool
+CookedCache::BlobContentHash(const void* blob, int blobSize, uint64_t& outContentHash) {
+    header hdr;
+    if (!readHeader(blob, blobSize, hdr)) {
+        return false;
+    }
+    outContentHash = hdr.contentHash;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+Buffer
+CookedCache::CookTexture(uint64_t sourceKey, uint64_t contentHash, const TextureSetup& setup, const void* data, int numBytes) {
+    o_assert_dbg(setup.ShouldSetupFromPixelData());
+    o_assert_dbg(data);
+    const ImageDataAttrs& img = setup.ImageData;
+
+    // the image surfaces are packed without gaps, file headers
+    // and other data between the surfaces are dropped
+    textureAttrs attrs;
+    Memory::Clear(&attrs, sizeof(attrs));
+    attrs.type = setup.Type;
+    attrs.width = setup.Width;
+    attrs.height = setup.Height;
+    attrs.depth = setup.Depth;
+    attrs.numMipMaps = setup.NumMipMaps;
+    attrs.colorFormat = setup.ColorFormat;
+    attrs.numFaces = img.NumFaces;
+    int dataSize = 0;
+    for (int faceIndex = 0; faceIndex < img.NumFaces; faceIndex++) {
+        for (int mipIndex = 0; mipIndex < img.NumMipMaps; mipIndex++) {
+            const int size = img.Sizes[faceIndex][mipIndex];
+            o_assert((img.Offsets[faceIndex][mipIndex] + size) <= numBytes);
+            attrs.offsets[faceIndex][mipIndex] = dataSize;
+            attrs.sizes[faceIndex][mipIndex] = size;
+            dataSize += size;
+        }
+    }
+
+    Buffer blob;
+    uint8_t* dst = writeBlob(blob, textureKind, sourceKey, contentHash, &attrs, sizeof(attrs), dataSize);
+    const uint8_t* src = (const uint8_t*) data;
+    for (int faceIndex = 0; faceIndex < img.NumFaces; faceIndex++) {
+        for (int mipIndex = 0; mipIndex < img.NumMipMaps; mipIndex++) {
+            Memory::Copy(src + img.Offsets[faceIndex][mipIndex],
+                         dst + attrs.offsets[faceIndex][mipIndex],
+                         attrs.sizes[faceIndex][mipIndex]);
+        }
+    }
+    return blob;
+}
+
+//------------------------------------------------------------------------------
+bool
+CookedCache::ParseTexture(uint64_t sourceKey, const void* blob, int blobSize, const TextureSetup& blueprint, TextureSetup& outSetup, const uint8_t*& outData, int& outNumBytes) {
+    const uint8_t* ptr = readBlob(blob, blobSize, textureKind, sourceKey, sizeof(textureAttrs), outData, outNumBytes);
+    if (nullptr == ptr) {
+        return false;
+    }
+    textureAttrs attrs;
+    Memory::Copy(ptr, &attrs, sizeof(attrs));
+    if ((attrs.width <= 0) || (attrs.height <= 0) || (attrs.depth < 0) ||
+        (attrs.numMipMaps <= 0) || (attrs.numMipMaps > GfxConfig::MaxNumTextureMipMaps) ||
+        (attrs.numFaces <= 0) || (attrs.numFaces > GfxConfig::MaxNumTextureFaces) ||
+        (attrs.type < 0) || (attrs.type >= int(TextureType::NumTextureTypes)) ||
+        (attrs.colorFormat < 0) || (attrs.colorFormat >= int(PixelFormat::NumPixelFormats)) ||
+        !PixelFormat::IsValidTextureColorFormat((PixelFormat::Code) attrs.colorFormat)) {
+        return false;
+    }
+    const TextureType::Code type = (TextureType::Code) attrs.type;
+    const PixelFormat::Code fmt = (PixelFormat::Code) attrs.colorFormat;
+    outSetup = TextureSetup::FromPixelData(attrs.width, attrs.height, attrs.numMipMaps, type, fmt, blueprint);
+    outSetup.Depth = attrs.depth;
+    for (int faceIndex = 0; faceIndex < attrs.numFaces; faceIndex++) {
+        for (int mipIndex = 0; mipIndex < attrs.numMipMaps; mipIndex++) {
+            if (!inRange(attrs.offsets[faceIndex][mipIndex], attrs.sizes[faceIndex][mipIndex], outNumBytes)) {
+                return false;
+            }
+            outSetup.ImageData.Offsets[faceIndex][mipIndex] = attrs.offsets[faceIndex][mipIndex];
+            outSetup.ImageData.Sizes[faceIndex][mipIndex] = attrs.sizes[faceIndex][mipIndex];
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+Buffer
+CookedCache::CookMesh(uint64_t sourceKey, uint64_t contentHash, const MeshSetup& setup, const void* data, int numBytes) {
+    o_assert_dbg(setup.ShouldSetupFromData());
+    o_assert_dbg(data);
+
+    // vertex data is followed by index data, everything else
+    // in the source data is dropped
+    meshAttrs attrs;
+    Memory::Clear(&attrs, sizeof(attrs));
+    const VertexLayout& layout = setup.Layout;
+    attrs.numComps = layout.NumComponents();
+    for (int i = 0; i < attrs.numComps; i++) {
+        attrs.compAttrs[i] = layout.ComponentAt(i).Attr;
+        attrs.compFormats[i] = layout.ComponentAt(i).Format;
+    }
+    attrs.stepFunction = layout.StepFunction;
+    attrs.stepRate = layout.StepRate;
+    attrs.numVertices = setup.NumVertices;
+    attrs.numIndices = setup.NumIndices;
+    attrs.indicesType = setup.IndicesType;
+    attrs.numPrimGroups = setup.NumPrimitiveGroups();
+    for (int i = 0; i < attrs.numPrimGroups; i++) {
+        attrs.primGroups[i][0] = setup.PrimitiveGroup(i).BaseElement;
+        attrs.primGroups[i][1] = setup.PrimitiveGroup(i).NumElements;
+    }
+    int vertexSize = 0;
+    attrs.vertexOffset = InvalidIndex;
+    if (InvalidIndex != setup.DataVertexOffset) {
+        vertexSize = setup.NumVertices * layout.ByteSize();
+        o_assert((setup.DataVertexOffset + vertexSize) <= numBytes);
+        attrs.vertexOffset = 0;
+    }
+    int indexSize = 0;
+    attrs.indexOffset = InvalidIndex;
+    if (InvalidIndex != setup.DataIndexOffset) {
+        indexSize = setup.NumIndices * IndexType::ByteSize(setup.IndicesType);
+        o_assert((setup.DataIndexOffset + indexSize) <= numBytes);
+        attrs.indexOffset = vertexSize;
+    }
+
+    Buffer blob;
+    uint8_t* dst = writeBlob(blob, meshKind, sourceKey, contentHash, &attrs, sizeof(attrs), vertexSize + indexSize);
+    const uint8_t* src = (const uint8_t*) data;
+    if (vertexSize > 0) {
+        Memory::Copy(src + setup.DataVertexOffset, dst, vertexSize);
+    }
+    if (indexSize > 0) {
+        Memory::Copy(src + setup.DataIndexOffset, dst + vertexSize, indexSize);
+    }
+    return blob;
+}
+
+//------------------------------------------------------------------------------
+bool
+CookedCache::ParseMesh(uint64_t sourceKey, const void* blob, int blobSize, const MeshSetup& blueprint, MeshSetup& outSetup, const uint8_t*& outData, int& outNumBytes) {
+    const uint8_t* ptr = readBlob(blob, blobSize, meshKind, sourceKey, sizeof(meshAttrs), outData, outNumBytes);
+    if (nullptr == ptr) {
+        return false;
+    }
+    meshAttrs attrs;
+    Memory::Copy(ptr, &attrs, sizeof(attrs));
+    if ((attrs.numComps < 0) || (attrs.numComps > GfxConfig::MaxNumVertexLayoutComponents) ||
+        (attrs.numPrimGroups < 0) || (attrs.numPrimGroups > GfxConfig::MaxNumPrimGroups) ||
+        (attrs.indicesType < 0) || (attrs.indicesType >= int(IndexType::NumIndexTypes)) ||
+        (attrs.stepFunction < VertexStepFunction::PerVertex) || (attrs.stepFunction > VertexStepFunction::PerInstance) ||
+        (attrs.stepRate < 0) || (attrs.stepRate > 255) ||
+        (attrs.numVertices < 0) || (attrs.numIndices < 0)) {
+        return false;
+    }
+    for (int i = 0; i < attrs.numComps; i++) {
+        if ((attrs.compAttrs[i] < 0) || (attrs.compAttrs[i] >= VertexAttr::NumVertexAttrs) ||
+            (attrs.compFormats[i] < 0) || (attrs.compFormats[i] >= VertexFormat::NumVertexFormats)) {
+            return false;
+        }
+    }
+    outSetup = MeshSetup::FromData(blueprint);
+    o_assert_dbg(outSetup.NumPrimitiveGroups() == 0);
+    outSetup.Layout.Clear();
+    for (int i = 0; i < attrs.numComps; i++) {
+        outSetup.Layout.Add((VertexAttr::Code) attrs.compAttrs[i], (VertexFormat::Code) attrs.compFormats[i]);
+    }
+    outSetup.Layout.StepFunction = (VertexStepFunction::Code) attrs.stepFunction;
+    outSetup.Layout.StepRate = uint8_t(attrs.stepRate);
+    outSetup.NumVertices = attrs.numVertices;
+    outSetup.NumIndices = attrs.numIndices;
+    outSetup.IndicesType = (IndexType::Code) attrs.indicesType;
+    for (int i = 0; i < attrs.numPrimGroups; i++) {
+        outSetup.AddPrimitiveGroup(PrimitiveGroup(attrs.primGroups[i][0], attrs.primGroups[i][1]));
+    }
+    for (int i = 0; i < attrs.numPrimGroups; i++) {
+        if ((attrs.primGroups[i][0] < 0) || (attrs.primGroups[i][1] < 0)) {
+            return false;
+        }
+    }
+    if (InvalidIndex != attrs.vertexOffset) {
+        const int64_t vertexSize = int64_t(attrs.numVertices) * outSetup.Layout.ByteSize();
+        if (!inRange(attrs.vertexOffset, vertexSize, outNumBytes)) {
+            return false;
+        }
+    }
+    if (InvalidIndex != attrs.indexOffset) {
+        const int64_t indexSize = int64_t(attrs.numIndices) * IndexType::ByteSize(outSetup.IndicesType);
+        if (!inRange(attrs.indexOffset, indexSize, outNumBytes)) {
+            return false;
+        }
+    }
+    outSetup.DataVertexOffset = attrs.vertexOffset;
+    outSetup.DataIndexOffset = attrs.indexOffset;
+    return true;
+}
+
+} // namespace Oryol
@@ -0,0 +1,157 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::CookedCache
+    @ingroup Assets
+    @brief persist parsed texture and mesh setups with their upload data
+
+    The cooked cache stores the TextureSetup or MeshSetup created by
+    a loader's parser, together with the ready-to-upload pixel or
+    vertex/index data, as a versioned binary blob. The blobs are keyed
+    by the source file's path, size and modification time (see
+    SourceKey()), so a warm hit only costs an IO::Stat() of the source
+    file and reading the blob, the source file itself is never loaded.
+    The content hash of the source file is stored in the blob header,
+    so a blob can still be checked against the source data it was
+    cooked from (see BlobContentHash()).
+
+    The cache is disabled by default, call CookedCache::Setup() with a
+    writable location (e.g. "cache:cooked/", the assign must be
+    registered with IO) to enable it in TextureLoader and MeshLoader.
+    On a cache hit, the loader passes the cooked setup and data
+    straight to Gfx without parsing (the blob is used in place),
+    on a miss the source file is loaded and parsed as usual and the
+    cooked blob is written asynchronously.
+
+    Prefetch() warms up the cache the same way: it stats the source
+    file and the cooked blob, and prefetches the blob if it exists,
+    the source file is only prefetched on a cache miss.
+
+    NOTE: modification times have a resolution of one second on some
+    file systems, a source file which is overwritten with new content
+    of the same size within that second keeps hitting the old blob.
+    File systems which don't support IO::Stat() never hit the cache.
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Buffer.h"
+#include "Core/Containers/Map.h"
+#include "Core/String/StringAtom.h"
+#include "IO/Core/URL.h"
+#include "IO/FS/ioRequests.h"
+#include "Gfx/Setup/TextureSetup.h"
+#include "Gfx/Setup/MeshSetup.h"
+
+namespace Oryol {
+
+class CookedCache {
+public:
+    /// blob format version, bump when the blob layout or a parser output changes
+    static const uint32_t Version = 2;
+
+    /// enable the cooked cache with a location prefix (e.g. "cache:cooked/")
+    static void Setup(const URL& location);
+    /// disable the cooked cache
+    static void Discard();
+    /// return true if the cooked cache is enabled
+    static bool IsValid();
+
+    /// compute the cache key of a source file from its location and attributes
+    static uint64_t SourceKey(const URL& url, const IOFileInfo& info);
+    /// compute the content hash of source file data
+    static uint64_t ContentHash(const void* data, int numBytes);
+    /// get the URL of a cooked blob
+    static URL CacheURL(uint64_t sourceKey, const char* ext);
+    /// get the source content hash stored in a cooked blob, return false if not a valid blob
+    static bool BlobContentHash(const void* blob, int blobSize, uint64_t& outContentHash);
+
+    /// serialize a texture setup and its pixel data into a cooked blob
+    static Buffer CookTexture(uint64_t sourceKey, uint64_t contentHash, const TextureSetup& setup, const void* data, int numBytes);
+    /// restore texture setup from a cooked blob, outData points into the blob
+    static bool ParseTexture(uint64_t sourceKey, const void* blob, int blobSize, const TextureSetup& blueprint, TextureSetup& outSetup, const uint8_t*& outData, int& outNumBytes);
+    /// serialize a mesh setup and its vertex/index data into a cooked blob
+    static Buffer CookMesh(uint64_t sourceKey, uint64_t contentHash, const MeshSetup& setup, const void* data, int numBytes);
+    /// restore mesh setup from a cooked blob, outData points into the blob
+    static bool ParseMesh(uint64_t sourceKey, const void* blob, int blobSize, const MeshSetup& blueprint, MeshSetup& outSetup, const uint8_t*& outData, int& outNumBytes);
+
+    /// prefetch the cooked blob of a source file, or the source file on a cache miss
+    static void Prefetch(const URL& source, const char* ext);
+    /// cancel a prefetch started with Prefetch() and drop the prefetched data
+    static void CancelPrefetch(const URL& source);
+
+private:
+    /// stat request of a prefetch, first of the source file, then of the cooked blob
+    class prefetchStat : public IOStat {
+        OryolClassDecl(prefetchStat);
+        OryolTypeDecl(prefetchStat, IOStat);
+    public:
+        /// called on the IO worker thread, continues on the main thread
+        virtual void onHandled() override;
+
+        URL source;
+        const char* ext = nullptr;
+        bool isBlob = false;
+        bool done = false;      // blob or source has been handed to IO::Prefetch()
+    };
+    /// continue a prefetch on the main thread after a stat request has been handled
+    static void prefetchHandled(const Ptr<prefetchStat>& req);
+
+    /// the blob kinds
+    enum kind : uint32_t {
+        textureKind = 1,
+        meshKind = 2,
+    };
+    /// common blob header
+    struct header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t kind;
+        uint32_t attrsSize;
+        uint64_t sourceKey;
+        uint64_t contentHash;
+        int32_t dataOffset;
+        int32_t dataSize;
+    };
+    /// serialized texture setup attributes
+    struct textureAttrs {
+        int32_t type;
+        int32_t width;
+        int32_t height;
+        int32_t depth;
+        int32_t numMipMaps;
+        int32_t colorFormat;
+        int32_t numFaces;
+        int32_t offsets[GfxConfig::MaxNumTextureFaces][GfxConfig::MaxNumTextureMipMaps];
+        int32_t sizes[GfxConfig::MaxNumTextureFaces][GfxConfig::MaxNumTextureMipMaps];
+    };
+    /// serialized mesh setup attributes
+    struct meshAttrs {
+        int32_t numComps;
+        int32_t compAttrs[GfxConfig::MaxNumVertexLayoutComponents];
+        int32_t compFormats[GfxConfig::MaxNumVertexLayoutComponents];
+        int32_t stepFunction;
+        int32_t stepRate;
+        int32_t numVertices;
+        int32_t numIndices;
+        int32_t indicesType;
+        int32_t numPrimGroups;
+        int32_t primGroups[GfxConfig::MaxNumPrimGroups][2];
+        int32_t vertexOffset;
+        int32_t indexOffset;
+    };
+    /// write the blob header and setup attributes, return pointer to data area
+    static uint8_t* writeBlob(Buffer& blob, uint32_t kind, uint64_t sourceKey, uint64_t contentHash, const void* attrs, int attrsSize, int dataSize);
+    /// validate the blob header, return false if the blob is invalid
+    static bool readHeader(const void* blob, int blobSize, header& outHeader);
+    /// validate the blob header and key, return pointer to setup attributes or nullptr
+    static const uint8_t* readBlob(const void* blob, int blobSize, uint32_t kind, uint64_t sourceKey, int attrsSize, const uint8_t*& outData, int& outNumBytes);
+    /// check that a data range lies within the blob's data area
+    static bool inRange(int offset, int64_t size, int numBytes);
+
+    static const uint32_t Magic = 0x444B434F;   // 'OCKD'
+    static const int DataAlignment = 16;
+    static URL location;
+    static bool valid;
+    static Map<StringAtom, Ptr<prefetchStat>> prefetches;   // by source URL
+};
+
+} // namespace Oryol
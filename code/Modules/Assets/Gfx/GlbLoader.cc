@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+//  GlbLoader.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "GlbLoader.h"
+#include "Assets/Gfx/GlbParser.h"
+#include "Core/Threading/WorkerPool.h"
+#include "Core/Memory/Memory.h"
+#include "Gfx/Gfx.h"
+#include "IO/IO.h"
+
+namespace Oryol {
+
+WorkerPool* GlbLoader::workers = nullptr;
+
+//------------------------------------------------------------------------------
+void
+GlbLoader::SetupWorkers(int numWorkers) {
+    o_assert(nullptr == workers);
+    workers = Memory::New<WorkerPool>();
+    workers->Setup(numWorkers);
+}
+
+//------------------------------------------------------------------------------
+void
+GlbLoader::DiscardWorkers() {
+    o_assert(nullptr != workers);
+    workers->Discard();
+    Memory::Delete(workers);
+    workers = nullptr;
+}
+
+//------------------------------------------------------------------------------
+GlbLoader::GlbLoader(const MeshSetup& setup_, int meshIndex_) :
+MeshLoaderBase(setup_),
+meshIndex(meshIndex_) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+GlbLoader::GlbLoader(const MeshSetup& setup_, int meshIndex_, LoadedFunc loadedFunc_) :
+MeshLoaderBase(setup_, std::move(loadedFunc_)),
+meshIndex(meshIndex_) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+GlbLoader::~GlbLoader() {
+    o_assert_dbg(!this->ioRequest);
+}
+
+//------------------------------------------------------------------------------
+void
+GlbLoader::Cancel() {
+    if (this->ioRequest) {
+        this->ioRequest->Cancelled = true;
+        this->ioRequest = nullptr;
+    }
+    // a running parse job keeps its own references to
+    // the file data and the result
+    this->parsed = Future<parseResult>();
+}
+
+//------------------------------------------------------------------------------
+void
+GlbLoader::Prefetch() {
+    IO::Prefetch({ URL(this->setup.Locator.Location()) });
+}
+
+//------------------------------------------------------------------------------
+void
+GlbLoader::CancelPrefetch() {
+    IO::CancelPrefetch({ URL(this->setup.Locator.Location()) });
+}
+
+//------------------------------------------------------------------------------
+Id
+GlbLoader::Start() {
+    this->resId = Gfx::resource().prepareAsync(this->setup);
+    this->ioRequest = IO::LoadFile(setup.Locator.Location());
+    return this->resId;
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+GlbLoader::Continue() {
+    o_assert_dbg(this->resId.IsValid());
+    o_assert_dbg(this->ioRequest.isValid());
+
+    ResourceState::Code result = ResourceState::Pending;
+    if (this->parsed.IsValid()) {
+        // waiting for the worker thread to parse the file data
+        if (this->parsed.IsReady()) {
+            result = this->create(this->parsed.Value());
+            this->parsed = Future<parseResult>();
+            this->ioRequest = nullptr;
+        }
+    }
+    else if (this->ioRequest->Handled) {
+        if (IOStatus::OK == this->ioRequest->Status) {
+            MeshSetup blueprint = MeshSetup::FromData(this->setup);
+            if (workers) {
+                // the job holds a reference to the IO request, so the
+                // file data stays alive even if the loader is cancelled
+                Promise<parseResult> promise;
+                this->parsed = promise.GetFuture();
+                Ptr<IORead> ioReq = this->ioRequest;
+                const int meshIndex = this->meshIndex;
+                workers->Async([promise, ioReq, meshIndex, blueprint] {
+                    parseResult res;
+                    res.setup = blueprint;
+                    parse(ioReq, meshIndex, res);
+                    promise.SetValue(std::move(res));
+                });
+                return ResourceState::Pending;
+            }
+            parseResult res;
+            res.setup = blueprint;
+            parse(this->ioRequest, this->meshIndex, res);
+            result = this->create(res);
+        }
+        else {
+            // IO had failed
+            result = Gfx::resource().failedAsync(this->resId);
+        }
+        this->ioRequest = nullptr;
+    }
+    return result;
+}
+
+//------------------------------------------------------------------------------
+/**
+    NOTE: this is called on a worker thread if SetupWorkers() has been
+    called. A job must not call ParallelFor() on the pool it is running
+    on, so the conversion of a single file runs serially, the workers
+    parse several files in parallel instead.
+*/
+void
+GlbLoader::parse(const Ptr<IORead>& ioReq, int meshIndex, parseResult& res) {
+    // if the GLB data can't be used as is, the parser
+    // converts it into convertedData
+    res.valid = GlbParser::Parse(ioReq->Data.Data(), ioReq->Data.Size(), meshIndex, res.setup, res.convertedData);
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+GlbLoader::create(parseResult& res) {
+    if (!res.valid) {
+        o_warn("GlbLoader: failed to parse '%s'\n", this->setup.Locator.Location().AsCStr());
+        return Gfx::resource().failedAsync(this->resId);
+    }
+    if (this->onLoaded) {
+        this->onLoaded(res.setup);
+    }
+    if (res.convertedData.Empty()) {
+        const Buffer& data = this->ioRequest->Data;
+        return Gfx::resource().initAsync(this->resId, res.setup, data.Data(), data.Size());
+    }
+    else {
+        return Gfx::resource().initAsync(this->resId, res.setup, res.convertedData.Data(), res.convertedData.Size());
+    }
+}
+
+} // namespace Oryol
@@ -0,0 +1,76 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::GlbLoader
+    @ingroup Assets
+    @brief mesh loader for glTF 2.0 binary (.glb) files
+
+    Loads a .glb file through IO, and creates a mesh from either
+    all meshes in the file (one PrimitiveGroup per glTF primitive),
+    or from a single mesh selected by index. See GlbParser for
+    what's supported.
+
+    A mesh can have at most GfxConfig::MaxNumPrimGroups primitive
+    groups, so merging all meshes only works for small files. For
+    bigger files, create one GlbLoader per glTF mesh, the number of
+    meshes is returned by GlbParser::NumMeshes().
+
+    Where possible the vertex and index data is uploaded straight
+    from the loaded file data. If GlbLoader::SetupWorkers() has been
+    called, the file data is parsed and converted on one of the shared
+    worker threads, and Continue() only polls the result. Otherwise
+    the parser runs on the main thread in Continue().
+*/
+#include "Gfx/Resource/MeshLoaderBase.h"
+#include "IO/FS/ioRequests.h"
+#include "Core/Threading/Future.h"
+#include "Core/Containers/Buffer.h"
+
+namespace Oryol {
+
+class WorkerPool;
+
+class GlbLoader : public MeshLoaderBase {
+    OryolClassDecl(GlbLoader);
+public:
+    /// start the shared worker threads for parsing and converting mesh data
+    static void SetupWorkers(int numWorkers);
+    /// stop the shared worker threads
+    static void DiscardWorkers();
+
+    /// constructor without success-callback
+    GlbLoader(const MeshSetup& setup, int meshIndex=InvalidIndex);
+    /// constructor with success callback
+    GlbLoader(const MeshSetup& setup, int meshIndex, LoadedFunc onLoaded);
+    /// destructor
+    ~GlbLoader();
+    /// start loading, return a resource id
+    virtual Id Start() override;
+    /// continue loading, return resource state (Pending, Valid, Failed)
+    virtual ResourceState::Code Continue() override;
+    /// cancel the load process
+    virtual void Cancel() override;
+    /// start prefetching the file data into the IO prefetch cache
+    virtual void Prefetch() override;
+    /// cancel prefetching, evict prefetched file data
+    virtual void CancelPrefetch() override;
+private:
+    /// the result of parsing the file data
+    struct parseResult {
+        bool valid = false;
+        MeshSetup setup;
+        Buffer convertedData;
+    };
+    /// parse the loaded file data
+    static void parse(const Ptr<IORead>& ioReq, int meshIndex, parseResult& res);
+    /// create the mesh resource from the parse result
+    ResourceState::Code create(parseResult& res);
+
+    static WorkerPool* workers;
+    int meshIndex;
+    Id resId;
+    Ptr<IORead> ioRequest;
+    Future<parseResult> parsed;
+};
+
+} // namespace Oryol
@@ -0,0 +1,642 @@
+//------------------------------------------------------------------------------
+//  GlbParser.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "GlbParser.h"
+#include "Assets/Gfx/JsonValue.h"
+#include "Assets/Gfx/VertexWriter.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Threading/WorkerPool.h"
+#include <cstring>
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+int
+GlbParser::elementSize(const accessor& acc) {
+    switch (acc.componentType) {
+        case byteType:
+        case ubyteType:     return acc.numComponents;
+        case shortType:
+        case ushortType:    return acc.numComponents * 2;
+        case uintType:
+        case floatType:     return acc.numComponents * 4;
+        default:            return 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+int
+GlbParser::elementStride(const state& s, const accessor& acc) {
+    const int stride = s.views[acc.view].byteStride;
+    return stride > 0 ? stride : elementSize(acc);
+}
+
+//------------------------------------------------------------------------------
+const uint8_t*
+GlbParser::elementData(const state& s, const accessor& acc) {
+    return s.bin + s.views[acc.view].byteOffset + acc.byteOffset;
+}
+
+//------------------------------------------------------------------------------
+bool
+GlbParser::vertexFormat(const accessor& acc, VertexFormat::Code& outFormat) {
+    static const VertexFormat::Code floatFormats[4] = {
+        VertexFormat::Float, VertexFormat::Float2, VertexFormat::Float3, VertexFormat::Float4
+    };
+    o_assert_dbg((acc.numComponents >= 1) && (acc.numComponents <= 4));
+    outFormat = floatFormats[acc.numComponents - 1];
+    switch (acc.componentType) {
+        case floatType:
+            return true;
+        case byteType:
+            if (4 == acc.numComponents) {
+                outFormat = acc.normalized ? VertexFormat::Byte4N : VertexFormat::Byte4;
+                return true;
+            }
+            break;
+        case ubyteType:
+            if (4 == acc.numComponents) {
+                outFormat = acc.normalized ? VertexFormat::UByte4N : VertexFormat::UByte4;
+                return true;
+            }
+            break;
+        case shortType:
+            if (2 == acc.numComponents) {
+                outFormat = acc.normalized ? VertexFormat::Short2N : VertexFormat::Short2;
+                return true;
+            }
+            else if (4 == acc.numComponents) {
+                outFormat = acc.normalized ? VertexFormat::Short4N : VertexFormat::Short4;
+                return true;
+            }
+            break;
+        default:
+            break;
+    }
+    // no matching vertex format, convert to float
+    return false;
+}
+
+//------------------------------------------------------------------------------
+VertexAttr::Code
+GlbParser::vertexAttr(const JsonValue& name) {
+    if (name.Equals("POSITION"))        return VertexAttr::Position;
+    else if (name.Equals("NORMAL"))     return VertexAttr::Normal;
+    else if (name.Equals("TANGENT"))    return VertexAttr::Tangent;
+    else if (name.Equals("TEXCOORD_0")) return VertexAttr::TexCoord0;
+    else if (name.Equals("TEXCOORD_1")) return VertexAttr::TexCoord1;
+    else if (name.Equals("TEXCOORD_2")) return VertexAttr::TexCoord2;
+    else if (name.Equals("TEXCOORD_3")) return VertexAttr::TexCoord3;
+    else if (name.Equals("COLOR_0"))    return VertexAttr::Color0;
+    else if (name.Equals("COLOR_1"))    return VertexAttr::Color1;
+    else if (name.Equals("JOINTS_0"))   return VertexAttr::Indices;
+    else if (name.Equals("WEIGHTS_0"))  return VertexAttr::Weights;
+    else                                return VertexAttr::InvalidVertexAttr;
+}
+
+//------------------------------------------------------------------------------
+bool
+GlbParser::checkAccessor(const state& s, int index) {
+    if ((index < 0) || (index >= s.accessors.Size())) {
+        return false;
+    }
+    const accessor& acc = s.accessors[index];
+    if (acc.sparse) {
+        o_warn("GlbParser: sparse accessors not supported!\n");
+        return false;
+    }
+    if ((acc.view < 0) || (acc.view >= s.views.Size())) {
+        return false;
+    }
+    const int elmSize = elementSize(acc);
+    if ((0 == elmSize) || (acc.count <= 0) || (acc.byteOffset < 0)) {
+        return false;
+    }
+    const int64_t endOffset = int64_t(acc.byteOffset) + int64_t(acc.count - 1) * elementStride(s, acc) + elmSize;
+    return endOffset <= s.views[acc.view].byteLength;
+}
+
+//------------------------------------------------------------------------------
+bool
+GlbParser::parseTables(const JsonValue& root, state& s) {
+    const JsonValue views = root.Member("bufferViews");
+    for (JsonValue val = views.First(); val.IsValid(); val = val.Next()) {
+        if (0 != val.Member("buffer").AsInt(0)) {
+            o_warn("GlbParser: external buffers not supported!\n");
+            return false;
+        }
+        bufferView view;
+        view.byteOffset = val.Member("byteOffset").AsInt(0);
+        view.byteLength = val.Member("byteLength").AsInt(0);
+        view.byteStride = val.Member("byteStride").AsInt(0);
+        if ((view.byteOffset < 0) || (view.byteLength < 0) || (view.byteStride < 0) ||
+            (int64_t(view.byteOffset) + view.byteLength > s.binSize)) {
+            return false;
+        }
+        s.views.Add(view);
+    }
+    const JsonValue accessors = root.Member("accessors");
+    for (JsonValue val = accessors.First(); val.IsValid(); val = val.Next()) {
+        accessor acc;
+        acc.view = val.Member("bufferView").AsInt(InvalidIndex);
+        acc.byteOffset = val.Member("byteOffset").AsInt(0);
+        acc.componentType = val.Member("componentType").AsInt(0);
+        acc.count = val.Member("count").AsInt(0);
+        acc.normalized = val.Member("normalized").AsBool(false);
+        acc.sparse = val.Member("sparse").IsValid();
+        const JsonValue type = val.Member("type");
+        if (type.Equals("SCALAR"))      acc.numComponents = 1;
+        else if (type.Equals("VEC2"))   acc.numComponents = 2;
+        else if (type.Equals("VEC3"))   acc.numComponents = 3;
+        else if (type.Equals("VEC4"))   acc.numComponents = 4;
+        s.accessors.Add(acc);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+GlbParser::parseMesh(const JsonValue& mesh, state& s) {
+    const JsonValue prims = mesh.Member("primitives");
+    for (JsonValue val = prims.First(); val.IsValid(); val = val.Next()) {
+        const int mode = val.Member("mode").AsInt(4);
+        if ((2 == mode) || (6 == mode)) {
+            o_warn("GlbParser: line loop and triangle fan primitives not supported!\n");
+            return false;
+        }
+        primitive prim;
+        const JsonValue attrs = val.Member("attributes");
+        for (JsonValue attr = attrs.First(); attr.IsValid(); attr = attr.Next()) {
+            const VertexAttr::Code vertexAttr = GlbParser::vertexAttr(attr.Key());
+            if (VertexAttr::InvalidVertexAttr != vertexAttr) {
+                const int index = attr.AsInt(InvalidIndex);
+                if (!checkAccessor(s, index)) {
+                    return false;
+                }
+                prim.attrs[vertexAttr] = index;
+            }
+        }
+        if (InvalidIndex == prim.attrs[VertexAttr::Position]) {
+            return false;
+        }
+        const JsonValue indices = val.Member("indices");
+        if (indices.IsValid()) {
+            prim.indices = indices.AsInt(InvalidIndex);
+            if (!checkAccessor(s, prim.indices)) {
+                return false;
+            }
+            const accessor& acc = s.accessors[prim.indices];
+            if ((1 != acc.numComponents) ||
+                ((ubyteType != acc.componentType) && (ushortType != acc.componentType) && (uintType != acc.componentType))) {
+                return false;
+            }
+        }
+        s.prims.Add(prim);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+GlbParser::readElement(const accessor& acc, const uint8_t* src, float* out) {
+    for (int i = 0; i < acc.numComponents; i++) {
+        switch (acc.componentType) {
+            case byteType:
+            {
+                const float f = float(((const int8_t*)src)[i]);
+                out[i] = acc.normalized ? (f < -127.0f ? -1.0f : f / 127.0f) : f;
+                break;
+            }
+            case ubyteType:
+            {
+                const float f = float(src[i]);
+                out[i] = acc.normalized ? f / 255.0f : f;
+                break;
+            }
+            case shortType:
+            {
+                int16_t s;
+                std::memcpy(&s, src + i * 2, sizeof(s));
+                const float f = float(s);
+                out[i] = acc.normalized ? (f < -32767.0f ? -1.0f : f / 32767.0f) : f;
+                break;
+            }
+            case ushortType:
+            {
+                uint16_t us;
+                std::memcpy(&us, src + i * 2, sizeof(us));
+                out[i] = acc.normalized ? float(us) / 65535.0f : float(us);
+                break;
+            }
+            case uintType:
+            {
+                uint32_t ui;
+                std::memcpy(&ui, src + i * 4, sizeof(ui));
+                out[i] = float(ui);
+                break;
+            }
+            default:
+                std::memcpy(&out[i], src + i * 4, sizeof(float));
+                break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+GlbParser::writeElement(uint8_t* dst, VertexFormat::Code fmt, const float* v) {
+    switch (fmt) {
+        case VertexFormat::Float:
+            VertexWriter::Write(dst, fmt, v[0]);
+            break;
+        case VertexFormat::Float2:
+        case VertexFormat::Short2:
+        case VertexFormat::Short2N:
+            VertexWriter::Write(dst, fmt, v[0], v[1]);
+            break;
+        case VertexFormat::Float3:
+            VertexWriter::Write(dst, fmt, v[0], v[1], v[2]);
+            break;
+        default:
+            VertexWriter::Write(dst, fmt, v[0], v[1], v[2], v[3]);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+uint32_t
+GlbParser::readIndex(const accessor& acc, const uint8_t* src) {
+    if (ubyteType == acc.componentType) {
+        return *src;
+    }
+    else if (ushortType == acc.componentType) {
+        uint16_t us;
+        std::memcpy(&us, src, sizeof(us));
+        return us;
+    }
+    else {
+        uint32_t ui;
+        std::memcpy(&ui, src, sizeof(ui));
+        return ui;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+GlbParser::checkIndices(const state& s) {
+    for (const auto& prim : s.prims) {
+        if (InvalidIndex == prim.indices) {
+            continue;
+        }
+        const accessor& acc = s.accessors[prim.indices];
+        const uint32_t numVertices = uint32_t(s.sets[prim.set].numVertices);
+        const uint8_t* src = elementData(s, acc);
+        const int srcStride = elementStride(s, acc);
+        for (int i = 0; i < acc.count; i++, src += srcStride) {
+            if (readIndex(acc, src) >= numVertices) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+GlbParser::setupInPlace(const state& s, const void* ptr, MeshSetup& outSetup) {
+    // all primitives must share the same vertices...
+    if (s.sets.Size() != 1) {
+        return false;
+    }
+    const primitive& prim0 = s.prims[0];
+
+    // ...which must be interleaved in one buffer view in a layout
+    // which can be expressed as VertexLayout, sort components by offset
+    int attrs[VertexAttr::NumVertexAttrs];
+    int numAttrs = 0;
+    for (int attr = 0; attr < VertexAttr::NumVertexAttrs; attr++) {
+        if (InvalidIndex == prim0.attrs[attr]) {
+            continue;
+        }
+        const accessor& acc = s.accessors[prim0.attrs[attr]];
+        if (acc.view != s.accessors[prim0.attrs[VertexAttr::Position]].view) {
+            return false;
+        }
+        int i = numAttrs++;
+        for (; (i > 0) && (s.accessors[prim0.attrs[attrs[i - 1]]].byteOffset > acc.byteOffset); i--) {
+            attrs[i] = attrs[i - 1];
+        }
+        attrs[i] = attr;
+    }
+    VertexLayout layout;
+    const accessor& first = s.accessors[prim0.attrs[attrs[0]]];
+    for (int i = 0; i < numAttrs; i++) {
+        const accessor& acc = s.accessors[prim0.attrs[attrs[i]]];
+        VertexFormat::Code fmt;
+        if (!vertexFormat(acc, fmt) || ((acc.byteOffset - first.byteOffset) != layout.ByteSize())) {
+            return false;
+        }
+        layout.Add((VertexAttr::Code) attrs[i], fmt);
+    }
+    if (elementStride(s, first) != layout.ByteSize()) {
+        return false;
+    }
+
+    // indices must be 16- or 32-bit, contiguous in primitive order in one buffer view
+    IndexType::Code indexType = IndexType::None;
+    int numIndices = 0;
+    if (InvalidIndex == prim0.indices) {
+        if (s.prims.Size() > 1) {
+            return false;
+        }
+    }
+    else {
+        const accessor& acc0 = s.accessors[prim0.indices];
+        if (ushortType == acc0.componentType) {
+            indexType = IndexType::Index16;
+        }
+        else if (uintType == acc0.componentType) {
+            indexType = IndexType::Index32;
+        }
+        else {
+            return false;
+        }
+        const int indexSize = IndexType::ByteSize(indexType);
+        if (elementStride(s, acc0) != indexSize) {
+            return false;
+        }
+        for (const auto& prim : s.prims) {
+            if (InvalidIndex == prim.indices) {
+                return false;
+            }
+            const accessor& acc = s.accessors[prim.indices];
+            if ((acc.componentType != acc0.componentType) || (acc.view != acc0.view) ||
+                (acc.byteOffset != (acc0.byteOffset + numIndices * indexSize))) {
+                return false;
+            }
+            numIndices += acc.count;
+        }
+    }
+
+    // all good, setup the mesh with offsets into the GLB data
+    outSetup.Layout = layout;
+    outSetup.NumVertices = s.sets[0].numVertices;
+    outSetup.NumIndices = numIndices;
+    outSetup.IndicesType = indexType;
+    outSetup.DataVertexOffset = int(elementData(s, first) - (const uint8_t*)ptr);
+    if (IndexType::None == indexType) {
+        outSetup.DataIndexOffset = InvalidIndex;
+        outSetup.AddPrimitiveGroup(PrimitiveGroup(0, outSetup.NumVertices));
+    }
+    else {
+        outSetup.DataIndexOffset = int(elementData(s, s.accessors[prim0.indices]) - (const uint8_t*)ptr);
+        int baseElement = 0;
+        for (const auto& prim : s.prims) {
+            const int count = s.accessors[prim.indices].count;
+            outSetup.AddPrimitiveGroup(PrimitiveGroup(baseElement, count));
+            baseElement += count;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+GlbParser::convert(const state& s, MeshSetup& outSetup, Buffer& outData, WorkerPool* workers) {
+
+    // the vertex layout is the union of all primitive's attributes,
+    // the format of an attribute is defined by the first primitive using it
+    VertexLayout& layout = outSetup.Layout;
+    for (int attr = 0; attr < VertexAttr::NumVertexAttrs; attr++) {
+        for (const auto& prim : s.prims) {
+            if (InvalidIndex != prim.attrs[attr]) {
+                VertexFormat::Code fmt;
+                vertexFormat(s.accessors[prim.attrs[attr]], fmt);
+                layout.Add((VertexAttr::Code) attr, fmt);
+                break;
+            }
+        }
+    }
+    const vertexSet& lastSet = s.sets[s.sets.Size() - 1];
+    const int numVertices = lastSet.baseVertex + lastSet.numVertices;
+    int numIndices = 0;
+    for (const auto& prim : s.prims) {
+        const int count = (InvalidIndex != prim.indices) ? s.accessors[prim.indices].count : s.sets[prim.set].numVertices;
+        outSetup.AddPrimitiveGroup(PrimitiveGroup(numIndices, count));
+        numIndices += count;
+    }
+    const IndexType::Code indexType = numVertices <= 0xFFFF ? IndexType::Index16 : IndexType::Index32;
+    const int vertexSize = layout.ByteSize();
+    const int indexSize = IndexType::ByteSize(indexType);
+    const int vertexDataSize = numVertices * vertexSize;
+    uint8_t* dst = outData.Add(vertexDataSize + numIndices * indexSize);
+    // attributes a vertex set doesn't provide are zero
+    Memory::Clear(dst, vertexDataSize);
+
+    outSetup.NumVertices = numVertices;
+    outSetup.NumIndices = numIndices;
+    outSetup.IndicesType = indexType;
+    outSetup.DataVertexOffset = 0;
+    outSetup.DataIndexOffset = vertexDataSize;
+
+    // write vertices, one vertex set per chunk
+    WorkerPool::RangeFunc writeVertices = [&s, &layout, dst, vertexSize](int begin, int end) {
+        for (int setIndex = begin; setIndex < end; setIndex++) {
+            const vertexSet& set = s.sets[setIndex];
+            const primitive& prim = s.prims[set.prim];
+            for (int compIndex = 0; compIndex < layout.NumComponents(); compIndex++) {
+                const auto& comp = layout.ComponentAt(compIndex);
+                if (InvalidIndex == prim.attrs[comp.Attr]) {
+                    continue;
+                }
+                const accessor& acc = s.accessors[prim.attrs[comp.Attr]];
+                const uint8_t* src = elementData(s, acc);
+                const int srcStride = elementStride(s, acc);
+                uint8_t* dstPtr = dst + set.baseVertex * vertexSize + layout.ComponentByteOffset(compIndex);
+                VertexFormat::Code fmt;
+                if (vertexFormat(acc, fmt) && (fmt == comp.Format)) {
+                    const int compSize = comp.ByteSize();
+                    for (int i = 0; i < set.numVertices; i++, src += srcStride, dstPtr += vertexSize) {
+                        std::memcpy(dstPtr, src, compSize);
+                    }
+                }
+                else {
+                    for (int i = 0; i < set.numVertices; i++, src += srcStride, dstPtr += vertexSize) {
+                        float v[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+                        readElement(acc, src, v);
+                        writeElement(dstPtr, comp.Format, v);
+                    }
+                }
+            }
+        }
+    };
+
+    // write indices rebased to the primitive's vertex set, one primitive per chunk
+    uint8_t* indexDst = dst + vertexDataSize;
+    WorkerPool::RangeFunc writeIndices = [&s, &outSetup, indexDst, indexSize](int begin, int end) {
+        for (int primIndex = begin; primIndex < end; primIndex++) {
+            const primitive& prim = s.prims[primIndex];
+            const PrimitiveGroup& group = outSetup.PrimitiveGroup(primIndex);
+            const uint32_t baseVertex = s.sets[prim.set].baseVertex;
+            uint8_t* dstPtr = indexDst + group.BaseElement * indexSize;
+            const accessor* acc = (InvalidIndex != prim.indices) ? &s.accessors[prim.indices] : nullptr;
+            const uint8_t* src = acc ? elementData(s, *acc) : nullptr;
+            const int srcStride = acc ? elementStride(s, *acc) : 0;
+            for (int i = 0; i < group.NumElements; i++, dstPtr += indexSize) {
+                const uint32_t index = baseVertex + (acc ? readIndex(*acc, src + i * srcStride) : uint32_t(i));
+                if (2 == indexSize) {
+                    const uint16_t index16 = uint16_t(index);
+                    std::memcpy(dstPtr, &index16, sizeof(index16));
+                }
+                else {
+                    std::memcpy(dstPtr, &index, sizeof(index));
+                }
+            }
+        }
+    };
+
+    if (workers && workers->IsValid()) {
+        workers->ParallelFor(s.sets.Size(), 1, writeVertices);
+        workers->ParallelFor(s.prims.Size(), 1, writeIndices);
+    }
+    else {
+        writeVertices(0, s.sets.Size());
+        writeIndices(0, s.prims.Size());
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+GlbParser::parseChunks(const void* ptr, uint32_t size, JsonValue& outRoot, state& s) {
+    o_assert_dbg(ptr);
+
+    // GLB header and JSON chunk header
+    if ((size < 20) || ((size & 3) != 0)) {
+        return false;
+    }
+    const uint8_t* u8Ptr = (const uint8_t*) ptr;
+    const uint32_t* header = (const uint32_t*) ptr;
+    const uint32_t magic = 0x46546C67;      // 'glTF'
+    const uint32_t jsonChunk = 0x4E4F534A;  // 'JSON'
+    const uint32_t binChunk = 0x004E4942;   // 'BIN\0'
+    const uint32_t glbSize = header[2];
+    const uint32_t jsonSize = header[3];
+    if ((magic != header[0]) || (2 != header[1]) || (glbSize < 20) || (glbSize > size)) {
+        return false;
+    }
+    if ((jsonChunk != header[4]) || (jsonSize > (glbSize - 20))) {
+        return false;
+    }
+    outRoot = JsonValue::Parse((const char*)(u8Ptr + 20), int(jsonSize));
+    if (JsonValue::Object != outRoot.GetType()) {
+        return false;
+    }
+
+    // optional BIN chunk
+    const uint32_t binOffset = 20 + ((jsonSize + 3) & ~3);
+    if ((binOffset + 8) <= glbSize) {
+        const uint32_t* binHeader = (const uint32_t*)(u8Ptr + binOffset);
+        if ((binChunk != binHeader[1]) || (binHeader[0] > (glbSize - binOffset - 8))) {
+            return false;
+        }
+        s.bin = u8Ptr + binOffset + 8;
+        s.binSize = int(binHeader[0]);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+int
+GlbParser::NumMeshes(const void* ptr, uint32_t size) {
+    JsonValue root;
+    state s;
+    if (!parseChunks(ptr, size, root, s)) {
+        return 0;
+    }
+    const JsonValue meshes = root.Member("meshes");
+    return (JsonValue::Array == meshes.GetType()) ? meshes.Size() : 0;
+}
+
+//------------------------------------------------------------------------------
+bool
+GlbParser::Parse(const void* ptr, uint32_t size, int meshIndex, MeshSetup& outSetup, Buffer& outData, WorkerPool* workers) {
+    o_assert_dbg(ptr);
+    o_assert_dbg(outSetup.NumPrimitiveGroups() == 0);
+    o_assert_dbg(outSetup.Layout.Empty());
+    o_assert_dbg(outData.Empty());
+
+    JsonValue root;
+    state s;
+    if (!parseChunks(ptr, size, root, s)) {
+        return false;
+    }
+
+    // gather primitives of all meshes, or the requested mesh
+    if (!parseTables(root, s)) {
+        return false;
+    }
+    const JsonValue meshes = root.Member("meshes");
+    int curMeshIndex = 0;
+    for (JsonValue mesh = meshes.First(); mesh.IsValid(); mesh = mesh.Next(), curMeshIndex++) {
+        if ((InvalidIndex == meshIndex) || (curMeshIndex == meshIndex)) {
+            if (!parseMesh(mesh, s)) {
+                return false;
+            }
+        }
+    }
+    if (s.prims.Empty()) {
+        return false;
+    }
+    if (s.prims.Size() > GfxConfig::MaxNumPrimGroups) {
+        if (InvalidIndex == meshIndex) {
+            o_warn("GlbParser: %d meshes have too many primitives to merge (%d, max is %d), load them one by one!\n",
+                curMeshIndex, s.prims.Size(), GfxConfig::MaxNumPrimGroups);
+        }
+        else {
+            o_warn("GlbParser: mesh %d has too many primitives (%d, max is %d)!\n",
+                meshIndex, s.prims.Size(), GfxConfig::MaxNumPrimGroups);
+        }
+        return false;
+    }
+
+    // primitives with identical attribute accessors share their vertices
+    for (int primIndex = 0; primIndex < s.prims.Size(); primIndex++) {
+        primitive& prim = s.prims[primIndex];
+        for (int setIndex = 0; setIndex < s.sets.Size(); setIndex++) {
+            if (0 == std::memcmp(prim.attrs, s.prims[s.sets[setIndex].prim].attrs, sizeof(prim.attrs))) {
+                prim.set = setIndex;
+                break;
+            }
+        }
+        if (InvalidIndex == prim.set) {
+            vertexSet set;
+            set.prim = primIndex;
+            set.numVertices = s.accessors[prim.attrs[VertexAttr::Position]].count;
+            if (!s.sets.Empty()) {
+                const vertexSet& prev = s.sets[s.sets.Size() - 1];
+                set.baseVertex = prev.baseVertex + prev.numVertices;
+            }
+            for (int attr = 0; attr < VertexAttr::NumVertexAttrs; attr++) {
+                if ((InvalidIndex != prim.attrs[attr]) && (s.accessors[prim.attrs[attr]].count != set.numVertices)) {
+                    return false;
+                }
+            }
+            prim.set = s.sets.Size();
+            s.sets.Add(set);
+        }
+    }
+
+    // indices must be within their vertex set, both for the in-place
+    // mesh and for rebasing the indices during conversion
+    if (!checkIndices(s)) {
+        o_warn("GlbParser: vertex index out of range!\n");
+        return false;
+    }
+    if (!setupInPlace(s, ptr, outSetup)) {
+        convert(s, outSetup, outData, workers);
+    }
+    return true;
+}
+
+} // namespace Oryol
@@ -0,0 +1,145 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::GlbParser
+    @ingroup Assets
+    @brief in-memory glTF 2.0 binary (.glb) mesh parser
+
+    Takes a piece of memory with a GLB file in it, and returns a
+    MeshSetup object with one PrimitiveGroup per glTF primitive,
+    either of all meshes in the file, or of a single mesh.
+
+    If the vertex data of all primitives is a single interleaved
+    buffer view whose layout maps 1:1 to a VertexLayout, and the
+    indices are contiguous 16- or 32-bit indices in a single buffer
+    view, the parser doesn't copy anything: outData stays empty,
+    and the MeshSetup's DataVertexOffset and DataIndexOffset point
+    straight into the GLB data.
+
+    Otherwise the primitives are converted into outData: vertex
+    components are copied where the glTF accessor format matches
+    the vertex format, and converted through VertexWriter where
+    it doesn't, indices are rebased into a single 16- or 32-bit
+    index buffer. If a WorkerPool is provided, the vertex sets and
+    primitives are converted in parallel.
+
+    Not supported: sparse accessors, line-loop and triangle-fan
+    primitives, external buffers (only the GLB's BIN chunk), and
+    more than GfxConfig::MaxNumPrimGroups primitives in one MeshSetup.
+    Merging all meshes of a file (meshIndex == InvalidIndex) only works
+    for small files, to load files with more primitives, create one
+    mesh per glTF mesh (see NumMeshes()). The primitive mode isn't part
+    of the MeshSetup, it must match the pipeline.
+
+    glTF attribute mapping:
+
+    POSITION    -> VertexAttr::Position
+    NORMAL      -> VertexAttr::Normal
+    TANGENT     -> VertexAttr::Tangent
+    TEXCOORD_n  -> VertexAttr::TexCoord0..3
+    COLOR_n     -> VertexAttr::Color0..1
+    JOINTS_0    -> VertexAttr::Indices
+    WEIGHTS_0   -> VertexAttr::Weights
+*/
+#include "Gfx/Setup/MeshSetup.h"
+#include "Core/Containers/Buffer.h"
+#include "Core/Containers/Array.h"
+
+namespace Oryol {
+
+class WorkerPool;
+class JsonValue;
+
+class GlbParser {
+public:
+    /// parse GLB data into MeshSetup, and converted data into outData if needed
+    static bool Parse(const void* ptr, uint32_t size, int meshIndex, MeshSetup& outSetup, Buffer& outData, WorkerPool* workers=nullptr);
+    /// get the number of glTF meshes in GLB data (0 if the data is invalid)
+    static int NumMeshes(const void* ptr, uint32_t size);
+
+private:
+    /// glTF accessor component types
+    enum componentType {
+        byteType = 5120,
+        ubyteType = 5121,
+        shortType = 5122,
+        ushortType = 5123,
+        uintType = 5125,
+        floatType = 5126,
+    };
+    /// a glTF buffer view
+    struct bufferView {
+        int byteOffset = 0;
+        int byteLength = 0;
+        int byteStride = 0;
+    };
+    /// a glTF accessor
+    struct accessor {
+        int view = InvalidIndex;
+        int byteOffset = 0;
+        int componentType = 0;
+        int numComponents = 0;
+        int count = 0;
+        bool normalized = false;
+        bool sparse = false;
+    };
+    /// a glTF mesh primitive
+    struct primitive {
+        primitive() {
+            for (int i = 0; i < VertexAttr::NumVertexAttrs; i++) {
+                this->attrs[i] = InvalidIndex;
+            }
+        }
+        int attrs[VertexAttr::NumVertexAttrs];
+        int indices = InvalidIndex;
+        int set = InvalidIndex;
+    };
+    /// a unique set of vertex attribute accessors
+    struct vertexSet {
+        int prim = InvalidIndex;
+        int baseVertex = 0;
+        int numVertices = 0;
+    };
+    /// parser state
+    struct state {
+        const uint8_t* bin = nullptr;
+        int binSize = 0;
+        Array<bufferView> views;
+        Array<accessor> accessors;
+        Array<primitive> prims;
+        Array<vertexSet> sets;
+    };
+
+    /// validate the GLB header and chunks, get the JSON root and BIN chunk
+    static bool parseChunks(const void* ptr, uint32_t size, JsonValue& outRoot, state& s);
+    /// parse bufferViews and accessors into state
+    static bool parseTables(const JsonValue& root, state& s);
+    /// parse the primitives of a glTF mesh into state
+    static bool parseMesh(const JsonValue& mesh, state& s);
+    /// check that an accessor exists and is within its buffer view
+    static bool checkAccessor(const state& s, int index);
+    /// check that all indices are within their primitive's vertex set
+    static bool checkIndices(const state& s);
+    /// map a glTF attribute name to a vertex attribute
+    static VertexAttr::Code vertexAttr(const JsonValue& name);
+    /// get the vertex format for an accessor, return true if the data can be used as is
+    static bool vertexFormat(const accessor& acc, VertexFormat::Code& outFormat);
+    /// get the byte size of one accessor element
+    static int elementSize(const accessor& acc);
+    /// get the byte stride between accessor elements
+    static int elementStride(const state& s, const accessor& acc);
+    /// get pointer to the first element of an accessor
+    static const uint8_t* elementData(const state& s, const accessor& acc);
+    /// read an accessor element as float, with glTF normalization rules
+    static void readElement(const accessor& acc, const uint8_t* src, float* out);
+    /// write a float element with VertexWriter
+    static void writeElement(uint8_t* dst, VertexFormat::Code fmt, const float* v);
+    /// read an index element
+    static uint32_t readIndex(const accessor& acc, const uint8_t* src);
+    /// try to setup the mesh directly from the GLB data
+    static bool setupInPlace(const state& s, const void* ptr, MeshSetup& outSetup);
+    /// convert the mesh data into outData
+    static void convert(const state& s, MeshSetup& outSetup, Buffer& outData, WorkerPool* workers);
+};
+
+} // namespace Oryol
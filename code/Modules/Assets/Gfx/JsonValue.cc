@@ -0,0 +1,388 @@
+//------------------------------------------------------------------------------
+//  JsonValue.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "JsonValue.h"
+#include "Core/Assertion.h"
+#include <cstring>
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+static const uint8_t jsonWhitespace[256] = {
+    0,0,0,0,0,0,0,0,0,1,1,0,0,1,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+//------------------------------------------------------------------------------
+const char*
+JsonValue::skipWhitespace(const char* p, const char* end) {
+    while ((p < end) && jsonWhitespace[uint8_t(*p)]) {
+        p++;
+    }
+    return p;
+}
+
+//------------------------------------------------------------------------------
+const char*
+JsonValue::skipString(const char* p, const char* end) {
+    o_assert_dbg('"' == *p);
+    p++;
+    for (;;) {
+        const char* q = (const char*) std::memchr(p, '"', end - p);
+        if (nullptr == q) {
+            return nullptr;
+        }
+        // an odd number of backslashes escapes the quote
+        int numBackslashes = 0;
+        for (const char* b = q - 1; (b >= p) && ('\\' == *b); b--) {
+            numBackslashes++;
+        }
+        if (0 == (numBackslashes & 1)) {
+            return q + 1;
+        }
+        p = q + 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+const char*
+JsonValue::skipNumber(const char* p, const char* end) {
+    if ((p < end) && ('-' == *p)) {
+        p++;
+    }
+    const char* digits = p;
+    while ((p < end) && (*p >= '0') && (*p <= '9')) {
+        p++;
+    }
+    if (p == digits) {
+        return nullptr;
+    }
+    if ((p < end) && ('.' == *p)) {
+        digits = ++p;
+        while ((p < end) && (*p >= '0') && (*p <= '9')) {
+            p++;
+        }
+        if (p == digits) {
+            return nullptr;
+        }
+    }
+    if ((p < end) && (('e' == *p) || ('E' == *p))) {
+        p++;
+        if ((p < end) && (('+' == *p) || ('-' == *p))) {
+            p++;
+        }
+        digits = p;
+        while ((p < end) && (*p >= '0') && (*p <= '9')) {
+            p++;
+        }
+        if (p == digits) {
+            return nullptr;
+        }
+    }
+    return p;
+}
+
+//------------------------------------------------------------------------------
+const char*
+JsonValue::skipValue(const char* p, const char* end, int depth) {
+    if (p >= end) {
+        return nullptr;
+    }
+    switch (*p) {
+        case '"':
+            return skipString(p, end);
+        case '{':
+        case '[':
+        {
+            if (depth >= MaxDepth) {
+                return nullptr;
+            }
+            const bool isObject = '{' == *p;
+            const char closer = isObject ? '}' : ']';
+            p = skipWhitespace(p + 1, end);
+            if ((p < end) && (closer == *p)) {
+                return p + 1;
+            }
+            for (;;) {
+                if (isObject) {
+                    if ((p >= end) || ('"' != *p)) {
+                        return nullptr;
+                    }
+                    p = skipString(p, end);
+                    if (nullptr == p) {
+                        return nullptr;
+                    }
+                    p = skipWhitespace(p, end);
+                    if ((p >= end) || (':' != *p)) {
+                        return nullptr;
+                    }
+                    p = skipWhitespace(p + 1, end);
+                }
+                p = skipValue(p, end, depth + 1);
+                if (nullptr == p) {
+                    return nullptr;
+                }
+                p = skipWhitespace(p, end);
+                if (p >= end) {
+                    return nullptr;
+                }
+                else if (closer == *p) {
+                    return p + 1;
+                }
+                else if (',' != *p) {
+                    return nullptr;
+                }
+                p = skipWhitespace(p + 1, end);
+            }
+        }
+        case 't':
+            return ((end - p) >= 4) && (0 == std::memcmp(p, "true", 4)) ? p + 4 : nullptr;
+        case 'f':
+            return ((end - p) >= 5) && (0 == std::memcmp(p, "false", 5)) ? p + 5 : nullptr;
+        case 'n':
+            return ((end - p) >= 4) && (0 == std::memcmp(p, "null", 4)) ? p + 4 : nullptr;
+        default:
+            return skipNumber(p, end);
+    }
+}
+
+//------------------------------------------------------------------------------
+JsonValue
+JsonValue::Parse(const char* text, int numBytes) {
+    o_assert_dbg(text && (numBytes >= 0));
+    const char* end = text + numBytes;
+    const char* p = skipWhitespace(text, end);
+    const char* valueEnd = skipValue(p, end, 0);
+    if (valueEnd && (skipWhitespace(valueEnd, end) == end)) {
+        return JsonValue(p, end, nullptr);
+    }
+    else {
+        return JsonValue();
+    }
+}
+
+//------------------------------------------------------------------------------
+JsonValue::Type
+JsonValue::GetType() const {
+    if (nullptr == this->ptr) {
+        return Invalid;
+    }
+    switch (*this->ptr) {
+        case '{':   return Object;
+        case '[':   return Array;
+        case '"':   return String;
+        case 't':
+        case 'f':   return Bool;
+        case 'n':   return Null;
+        default:    return Number;
+    }
+}
+
+//------------------------------------------------------------------------------
+JsonValue
+JsonValue::first() const {
+    // the document has been validated, so no error checks here
+    const char* p = skipWhitespace(this->ptr + 1, this->end);
+    if (('}' == *p) || (']' == *p)) {
+        return JsonValue();
+    }
+    if ('{' == *this->ptr) {
+        const char* k = p;
+        p = skipWhitespace(skipString(p, this->end), this->end);
+        o_assert_dbg(':' == *p);
+        return JsonValue(skipWhitespace(p + 1, this->end), this->end, k);
+    }
+    else {
+        return JsonValue(p, this->end, nullptr);
+    }
+}
+
+//------------------------------------------------------------------------------
+JsonValue
+JsonValue::First() const {
+    const Type type = this->GetType();
+    if ((Array == type) || (Object == type)) {
+        return this->first();
+    }
+    else {
+        return JsonValue();
+    }
+}
+
+//------------------------------------------------------------------------------
+JsonValue
+JsonValue::Next() const {
+    if (nullptr == this->ptr) {
+        return JsonValue();
+    }
+    const char* p = skipWhitespace(skipValue(this->ptr, this->end, 0), this->end);
+    if ((p >= this->end) || (',' != *p)) {
+        return JsonValue();
+    }
+    p = skipWhitespace(p + 1, this->end);
+    if (this->key) {
+        const char* k = p;
+        p = skipWhitespace(skipString(p, this->end), this->end);
+        o_assert_dbg(':' == *p);
+        return JsonValue(skipWhitespace(p + 1, this->end), this->end, k);
+    }
+    else {
+        return JsonValue(p, this->end, nullptr);
+    }
+}
+
+//------------------------------------------------------------------------------
+JsonValue
+JsonValue::Key() const {
+    if (this->key) {
+        return JsonValue(this->key, this->end, nullptr);
+    }
+    else {
+        return JsonValue();
+    }
+}
+
+//------------------------------------------------------------------------------
+int
+JsonValue::Size() const {
+    int size = 0;
+    for (JsonValue val = this->First(); val.IsValid(); val = val.Next()) {
+        size++;
+    }
+    return size;
+}
+
+//------------------------------------------------------------------------------
+JsonValue
+JsonValue::At(int index) const {
+    if (Array != this->GetType()) {
+        return JsonValue();
+    }
+    JsonValue val = this->first();
+    for (int i = 0; (i < index) && val.IsValid(); i++) {
+        val = val.Next();
+    }
+    return index >= 0 ? val : JsonValue();
+}
+
+//------------------------------------------------------------------------------
+JsonValue
+JsonValue::Member(const char* name) const {
+    o_assert_dbg(name);
+    if (Object != this->GetType()) {
+        return JsonValue();
+    }
+    for (JsonValue val = this->first(); val.IsValid(); val = val.Next()) {
+        if (val.Key().Equals(name)) {
+            return val;
+        }
+    }
+    return JsonValue();
+}
+
+//------------------------------------------------------------------------------
+float
+JsonValue::AsFloat(float def) const {
+    if (Number != this->GetType()) {
+        return def;
+    }
+    const char* p = this->ptr;
+    double sign = 1.0;
+    if ('-' == *p) {
+        sign = -1.0;
+        p++;
+    }
+    double val = 0.0;
+    while ((p < this->end) && (*p >= '0') && (*p <= '9')) {
+        val = val * 10.0 + (*p++ - '0');
+    }
+    if ((p < this->end) && ('.' == *p)) {
+        p++;
+        double scale = 0.1;
+        while ((p < this->end) && (*p >= '0') && (*p <= '9')) {
+            val += (*p++ - '0') * scale;
+            scale *= 0.1;
+        }
+    }
+    if ((p < this->end) && (('e' == *p) || ('E' == *p))) {
+        p++;
+        bool negExp = false;
+        if ((p < this->end) && (('+' == *p) || ('-' == *p))) {
+            negExp = '-' == *p++;
+        }
+        int exp = 0;
+        while ((p < this->end) && (*p >= '0') && (*p <= '9') && (exp < 400)) {
+            exp = exp * 10 + (*p++ - '0');
+        }
+        for (int i = 0; i < exp; i++) {
+            val = negExp ? val * 0.1 : val * 10.0;
+        }
+    }
+    return float(sign * val);
+}
+
+//------------------------------------------------------------------------------
+int
+JsonValue::AsInt(int def) const {
+    if (Number != this->GetType()) {
+        return def;
+    }
+    const char* p = this->ptr;
+    const bool neg = '-' == *p;
+    if (neg) {
+        p++;
+    }
+    int64_t val = 0;
+    while ((p < this->end) && (*p >= '0') && (*p <= '9') && (val <= 0x7FFFFFFF)) {
+        val = val * 10 + (*p++ - '0');
+    }
+    if ((p < this->end) && (('.' == *p) || ('e' == *p) || ('E' == *p))) {
+        // not an integer literal
+        return int(this->AsFloat(float(def)));
+    }
+    if (val > 0x7FFFFFFF) {
+        return def;
+    }
+    return neg ? -int(val) : int(val);
+}
+
+//------------------------------------------------------------------------------
+bool
+JsonValue::AsBool(bool def) const {
+    if (Bool != this->GetType()) {
+        return def;
+    }
+    return 't' == *this->ptr;
+}
+
+//------------------------------------------------------------------------------
+const char*
+JsonValue::StringBegin() const {
+    if (String != this->GetType()) {
+        return nullptr;
+    }
+    return this->ptr + 1;
+}
+
+//------------------------------------------------------------------------------
+int
+JsonValue::StringLength() const {
+    if (String != this->GetType()) {
+        return 0;
+    }
+    return int(skipString(this->ptr, this->end) - this->ptr) - 2;
+}
+
+//------------------------------------------------------------------------------
+bool
+JsonValue::Equals(const char* str) const {
+    o_assert_dbg(str);
+    if (String != this->GetType()) {
+        return false;
+    }
+    const int len = this->StringLength();
+    return (int(std::strlen(str)) == len) && (0 == std::memcmp(this->ptr + 1, str, len));
+}
+
+} // namespace Oryol
@@ -0,0 +1,119 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::JsonValue
+    @ingroup Assets
+    @brief non-allocating, read-only view on a JSON value
+
+    JsonValue::Parse() validates a complete JSON document in one pass
+    and returns a view on the root value. A JsonValue is only a pointer
+    into the JSON text, nothing is copied or allocated, so the text must
+    stay alive as long as values are used. Navigating to array elements
+    and object members scans the text on demand: strings are skipped
+    with memchr(), which is vectorized in the C runtime, everything else
+    with a character class table.
+
+    Since arrays are scanned, At() is O(n). To access many elements of
+    a large array, walk it with First() and Next() instead.
+
+    String values are returned as raw text between the quotes, escape
+    sequences are not resolved.
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+class JsonValue {
+public:
+    /// JSON value types
+    enum Type : uint8_t {
+        Invalid = 0,
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+    /// validate a JSON document, return invalid value if malformed
+    static JsonValue Parse(const char* text, int numBytes);
+
+    /// default constructor (invalid value)
+    JsonValue();
+
+    /// get the value type
+    Type GetType() const;
+    /// return true if valid value
+    bool IsValid() const;
+    /// number of array elements or object members, 0 for other types
+    int Size() const;
+    /// get array element by index (invalid if out of range)
+    JsonValue At(int index) const;
+    /// get object member value by key (invalid if not found)
+    JsonValue Member(const char* key) const;
+    /// get first array element or object member value
+    JsonValue First() const;
+    /// get next element or member value in the same array or object (invalid at end)
+    JsonValue Next() const;
+    /// get the key of an object member value (invalid if not an object member)
+    JsonValue Key() const;
+
+    /// get integer value, or default if not a number
+    int AsInt(int def=0) const;
+    /// get float value, or default if not a number
+    float AsFloat(float def=0.0f) const;
+    /// get bool value, or default if not a bool
+    bool AsBool(bool def=false) const;
+    /// return true if a string value equals str (no escape sequences resolved)
+    bool Equals(const char* str) const;
+    /// pointer to the first character of a string value
+    const char* StringBegin() const;
+    /// number of characters of a string value
+    int StringLength() const;
+
+private:
+    /// construct from a pointer to the first character of a value
+    JsonValue(const char* ptr, const char* end, const char* key);
+    /// skip whitespace, return end if nothing else left
+    static const char* skipWhitespace(const char* p, const char* end);
+    /// skip a string starting at the opening quote, return nullptr if malformed
+    static const char* skipString(const char* p, const char* end);
+    /// skip a number, return nullptr if malformed
+    static const char* skipNumber(const char* p, const char* end);
+    /// skip a complete value, return nullptr if malformed
+    static const char* skipValue(const char* p, const char* end, int depth);
+    /// scan to the first element or member of an array or object
+    JsonValue first() const;
+
+    static const int MaxDepth = 64;
+    const char* ptr;
+    const char* end;
+    const char* key;
+};
+
+//------------------------------------------------------------------------------
+inline
+JsonValue::JsonValue() :
+ptr(nullptr),
+end(nullptr),
+key(nullptr) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+inline
+JsonValue::JsonValue(const char* ptr_, const char* end_, const char* key_) :
+ptr(ptr_),
+end(end_),
+key(key_) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+inline bool
+JsonValue::IsValid() const {
+    return nullptr != this->ptr;
+}
+
+} // namespace Oryol
@@ -18,7 +18,7 @@ MeshBuilder::Begin() {
     this->inBegin = true;
 
     // setup MeshSetup object
-    MeshSetup& meshSetup = this->setupAndData.Setup;
+    MeshSetup& meshSetup = this->meshSetup;
     meshSetup = MeshSetup::FromData(this->VertexUsage, this->IndexUsage);
     meshSetup.Layout = this->Layout;
     meshSetup.NumVertices = this->NumVertices;
@@ -38,7 +38,7 @@ MeshBuilder::Begin() {
     }
     
     // setup the data buffer object
-    this->vertexPointer = this->setupAndData.Data.Add(allSize);
+    this->vertexPointer = this->data.Add(allSize);
     this->indexPointer  = this->vertexPointer + vbSize;
     this->endPointer    = this->indexPointer + ibSize;
     
@@ -53,14 +53,14 @@ MeshBuilder::Build() {
     this->inBegin = false;
 
     // NOTE: explicit moves required by VS2013
-    SetupAndData<MeshSetup> result(std::move(this->setupAndData));
+    SetupAndData<MeshSetup> result(this->meshSetup, std::move(this->data));
 
     // clear private data, not configuration data
     this->vertexPointer = nullptr;
     this->indexPointer = nullptr;
     this->endPointer = nullptr;
-    this->setupAndData.Setup = MeshSetup::FromData();
-    this->setupAndData.Data.Clear();
+    this->meshSetup = MeshSetup::FromData();
+    this->data.Clear();
     
     return result;
 }
@@ -90,7 +90,8 @@ private:
     /// compute byte offset into vertex buffer given vertex and component index
     uint32_t vertexByteOffset(uint32_t vertexIndex, int compIndex) const;
 
-    SetupAndData<MeshSetup> setupAndData;
+    MeshSetup meshSetup;
+    Buffer data;
     bool inBegin = false;
     
     uint8_t* vertexPointer = nullptr;
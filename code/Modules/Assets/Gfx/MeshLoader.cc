@@ -4,11 +4,15 @@
 #include "Pre.h"
 #include "MeshLoader.h"
 #include "Assets/Gfx/OmshParser.h"
+#include "Assets/Gfx/CookedCache.h"
 #include "Gfx/Gfx.h"
 #include "IO/IO.h"
 
 namespace Oryol {
 
+/// file extension of cooked mesh blobs
+static const char* CacheExt = ".cmsh";
+
 //------------------------------------------------------------------------------
 MeshLoader::MeshLoader(const MeshSetup& setup_) :
 MeshLoaderBase(setup_) {
@@ -17,13 +21,15 @@ MeshLoaderBase(setup_) {
 
 //------------------------------------------------------------------------------
 MeshLoader::MeshLoader(const MeshSetup& setup_, LoadedFunc loadedFunc_) :
-MeshLoaderBase(setup_, loadedFunc_) {
+MeshLoaderBase(setup_, std::move(loadedFunc_)) {
     // empty
 }
 
 //------------------------------------------------------------------------------
 MeshLoader::~MeshLoader() {
     o_assert_dbg(!this->ioRequest);
+    o_assert_dbg(!this->statRequest);
+    o_assert_dbg(!this->cacheRequest);
 }
 
 //------------------------------------------------------------------------------
@@ -33,13 +39,54 @@ MeshLoader::Cancel() {
         this->ioRequest->Cancelled = true;
         this->ioRequest = nullptr;
     }
+    if (this->statRequest) {
+        this->statRequest->Cancelled = true;
+        this->statRequest = nullptr;
+    }
+    if (this->cacheRequest) {
+        this->cacheRequest->Cancelled = true;
+        this->cacheRequest = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+MeshLoader::Prefetch() {
+    // NOTE: parsing the loaded data is cheap, the expensive parts are
+    // file IO (which is prefetched here), and resource creation, which
+    // is deferred until the loader is passed to Gfx::LoadResource()
+    // with the cooked cache, only the cooked blob is needed on a cache hit
+    if (CookedCache::IsValid()) {
+        CookedCache::Prefetch(this->setup.Locator.Location(), CacheExt);
+    }
+    else {
+        IO::Prefetch({ URL(this->setup.Locator.Location()) });
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+MeshLoader::CancelPrefetch() {
+    if (CookedCache::IsValid()) {
+        CookedCache::CancelPrefetch(this->setup.Locator.Location());
+    }
+    else {
+        IO::CancelPrefetch({ URL(this->setup.Locator.Location()) });
+    }
 }
 
 //------------------------------------------------------------------------------
 Id
 MeshLoader::Start() {
     this->resId = Gfx::resource().prepareAsync(this->setup);
-    this->ioRequest = IO::LoadFile(setup.Locator.Location());
+    if (CookedCache::IsValid()) {
+        // the cooked blob is keyed by the source file attributes,
+        // the source file is only loaded on a cache miss
+        this->statRequest = IO::Stat(this->setup.Locator.Location());
+    }
+    else {
+        this->ioRequest = IO::LoadFile(this->setup.Locator.Location());
+    }
     return this->resId;
 }
 
@@ -47,36 +94,48 @@ MeshLoader::Start() {
 ResourceState::Code
 MeshLoader::Continue() {
     o_assert_dbg(this->resId.IsValid());
-    o_assert_dbg(this->ioRequest.isValid());
-    
+
     ResourceState::Code result = ResourceState::Pending;
-    
-    if (this->ioRequest->Handled) {
-        if (IOStatus::OK == this->ioRequest->Status) {
-            // async loading has finished, use OmshParser to
-            // create a MeshSetup object from the loaded data
-            const void* data = this->ioRequest->Data.Data();
-            const int numBytes = this->ioRequest->Data.Size();
-
-            MeshSetup meshSetup = MeshSetup::FromData(this->setup);
-            if (OmshParser::Parse(data, numBytes, meshSetup)) {
-
-                // call the Loaded callback if defined, this
-                // gives the app a chance to look at the
-                // setup object, and possibly modify it
-                if (this->onLoaded) {
-                    this->onLoaded(meshSetup);
-                }
-
-                // NOTE: the prepared resource might have already been
-                // destroyed at this point, if this happens, initAsync will
-                // silently fail and return ResourceState::InvalidState
-                // (the same for failedAsync)
-                result = Gfx::resource().initAsync(this->resId, meshSetup, data, numBytes);
+
+    if (this->statRequest) {
+        // waiting for the source file attributes to lookup the cooked blob,
+        // if the source file can't be stat'ed, the regular load reports the error
+        if (this->statRequest->Handled) {
+            if (IOStatus::OK == this->statRequest->Status) {
+                this->sourceKey = CookedCache::SourceKey(this->setup.Locator.Location(), this->statRequest->Info);
+                this->cacheRequest = IO::LoadFile(CookedCache::CacheURL(this->sourceKey, CacheExt));
             }
             else {
-                result = Gfx::resource().failedAsync(this->resId);
+                this->ioRequest = IO::LoadFile(this->setup.Locator.Location());
             }
+            this->statRequest = nullptr;
+        }
+    }
+    else if (this->cacheRequest) {
+        // waiting for the cooked blob
+        if (this->cacheRequest->Handled) {
+            MeshSetup meshSetup;
+            const uint8_t* data = nullptr;
+            int numBytes = 0;
+            if ((IOStatus::OK == this->cacheRequest->Status) &&
+                CookedCache::ParseMesh(this->sourceKey,
+                    this->cacheRequest->Data.Data(), this->cacheRequest->Data.Size(),
+                    this->setup, meshSetup, data, numBytes)) {
+                // cache hit, the cooked data is used in place
+                result = this->create(meshSetup, data, numBytes);
+            }
+            else {
+                // cache miss or stale blob, load and parse the source file
+                this->ioRequest = IO::LoadFile(this->setup.Locator.Location());
+                this->cook = true;
+            }
+            this->cacheRequest = nullptr;
+        }
+    }
+    else if (this->ioRequest->Handled) {
+        if (IOStatus::OK == this->ioRequest->Status) {
+            // async loading has finished, use OmshParser to create a MeshSetup object from the loaded data
+            result = this->parse(this->ioRequest->Data.Data(), this->ioRequest->Data.Size(), this->cook);
         }
         else {
             // IO had failed
@@ -87,4 +146,40 @@ MeshLoader::Continue() {
     return result;
 }
 
+//------------------------------------------------------------------------------
+ResourceState::Code
+MeshLoader::parse(const uint8_t* data, int numBytes, bool cook) {
+    MeshSetup meshSetup = MeshSetup::FromData(this->setup);
+    if (OmshParser::Parse(data, numBytes, meshSetup)) {
+        if (cook) {
+            Ptr<IOWrite> ioReq = IOWrite::Create();
+            const uint64_t contentHash = CookedCache::ContentHash(data, numBytes);
+            ioReq->Url = CookedCache::CacheURL(this->sourceKey, CacheExt);
+            ioReq->Data = CookedCache::CookMesh(this->sourceKey, contentHash, meshSetup, data, numBytes);
+            IO::Put(ioReq);
+        }
+        return this->create(meshSetup, data, numBytes);
+    }
+    else {
+        return Gfx::resource().failedAsync(this->resId);
+    }
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+MeshLoader::create(MeshSetup& meshSetup, const uint8_t* data, int numBytes) {
+    // call the Loaded callback if defined, this
+    // gives the app a chance to look at the
+    // setup object, and possibly modify it
+    if (this->onLoaded) {
+        this->onLoaded(meshSetup);
+    }
+
+    // NOTE: the prepared resource might have already been
+    // destroyed at this point, if this happens, initAsync will
+    // silently fail and return ResourceState::InvalidState
+    // (the same for failedAsync)
+    return Gfx::resource().initAsync(this->resId, meshSetup, data, numBytes);
+}
+
 } // namespace Oryol
@@ -7,6 +7,11 @@
     
     NOTE: .omsh files are created by the oryol-exporter tool
     in the project https://github.com/floooh/oryol-tools
+
+    If the CookedCache is enabled, the loader first stats the source
+    file and looks up the cooked .cmsh blob for its path, size and
+    modification time, the source file is only loaded and parsed
+    on a cache miss.
 */
 #include "Gfx/Resource/MeshLoaderBase.h"
 #include "IO/FS/ioRequests.h"
@@ -28,9 +33,22 @@ public:
     virtual ResourceState::Code Continue() override;
     /// cancel the load process
     virtual void Cancel() override;
+    /// start prefetching the file data (or its cooked blob) into the IO prefetch cache
+    virtual void Prefetch() override;
+    /// cancel prefetching, evict prefetched file data
+    virtual void CancelPrefetch() override;
 private:
+    /// parse the loaded file data and create the mesh, optionally write cooked blob
+    ResourceState::Code parse(const uint8_t* data, int numBytes, bool cook);
+    /// create the mesh resource from setup and data
+    ResourceState::Code create(MeshSetup& meshSetup, const uint8_t* data, int numBytes);
+
     Id resId;
     Ptr<IORead> ioRequest;
+    Ptr<IOStat> statRequest;
+    Ptr<IORead> cacheRequest;
+    uint64_t sourceKey = 0;
+    bool cook = false;
 };
 
 } // namespace Oryol
@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+//  OcclusionCuller.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "OcclusionCuller.h"
+#include "Core/Assertion.h"
+#include "Gfx/Gfx.h"
+#include "Assets/Gfx/ShapeBuilder.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+OcclusionCuller::~OcclusionCuller() {
+    o_assert_dbg(!this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+OcclusionCuller::Setup(int numObjects, const Id& proxyShader) {
+    o_assert(!this->valid);
+    o_assert(numObjects > 0);
+    o_assert(proxyShader.IsValid());
+
+    this->label = Gfx::PushResourceLabel();
+
+    // a unit cube, the proxy shader transforms it into the bounding box
+    ShapeBuilder shapeBuilder;
+    shapeBuilder.Layout.Add(VertexAttr::Position, VertexFormat::Float3);
+    shapeBuilder.Box(1.0f, 1.0f, 1.0f, 1);
+    this->drawState.Mesh[0] = Gfx::CreateResource(shapeBuilder.Build());
+    this->layout = shapeBuilder.Layout;
+
+    // depth test against the occluders, but don't write anything
+    auto ps = PipelineSetup::FromLayoutAndShader(this->layout, proxyShader);
+    ps.DepthStencilState.DepthWriteEnabled = false;
+    ps.DepthStencilState.DepthCmpFunc = CompareFunc::LessEqual;
+    ps.BlendState.ColorWriteMask = PixelChannel::None;
+    ps.RasterizerState.CullFaceEnabled = false;
+    ps.RasterizerState.SampleCount = this->SampleCount;
+    this->drawState.Pipeline = Gfx::CreateResource(ps);
+
+    this->queries.Reserve(numObjects);
+    this->visible.Reserve(numObjects);
+    this->holdFrames.Reserve(numObjects);
+    for (int i = 0; i < numObjects; i++) {
+        this->queries.Add(Gfx::CreateResource(QuerySetup::OcclusionQuery(this->Type)));
+        this->visible.Add(true);
+        this->holdFrames.Add(0);
+    }
+    this->numVisible = numObjects;
+    Gfx::PopResourceLabel();
+    this->valid = true;
+}
+
+//------------------------------------------------------------------------------
+void
+OcclusionCuller::Discard() {
+    o_assert(this->valid);
+    Gfx::DestroyResources(this->label);
+    this->label.Invalidate();
+    this->drawState = DrawState();
+    this->queries.Clear();
+    this->visible.Clear();
+    this->holdFrames.Clear();
+    this->numVisible = 0;
+    this->valid = false;
+}
+
+//------------------------------------------------------------------------------
+void
+OcclusionCuller::Update() {
+    o_assert_dbg(this->valid);
+    this->numVisible = 0;
+    for (int i = 0; i < this->queries.Size(); i++) {
+        // objects without a result (yet) are visible, queries
+        // which failed to create also end up here
+        uint32_t numSamples = 0;
+        bool isVisible = true;
+        if (this->holdFrames[i] > 0) {
+            // the camera was recently inside the proxy, the results
+            // might still be from proxies drawn back then
+            this->holdFrames[i]--;
+        }
+        else if (Gfx::QueryResult(this->queries[i], numSamples)) {
+            isVisible = numSamples >= this->MinVisibleSamples;
+        }
+        this->visible[i] = isVisible;
+        if (isVisible) {
+            this->numVisible++;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+OcclusionCuller::MarkVisible(int index) {
+    o_assert_dbg(this->valid);
+    if (!this->visible[index]) {
+        this->visible[index] = true;
+        this->numVisible++;
+    }
+    this->holdFrames[index] = NumHoldFrames;
+}
+
+//------------------------------------------------------------------------------
+bool
+OcclusionCuller::CameraInside(const glm::vec3& boxMin, const glm::vec3& boxMax, const glm::vec3& eyePos, float nearRadius) {
+    // grow the box, so that proxies which are cut by the near plane also count
+    const float d = nearRadius;
+    return (eyePos.x >= boxMin.x - d) && (eyePos.x <= boxMax.x + d) &&
+           (eyePos.y >= boxMin.y - d) && (eyePos.y <= boxMax.y + d) &&
+           (eyePos.z >= boxMin.z - d) && (eyePos.z <= boxMax.z + d);
+}
+
+//------------------------------------------------------------------------------
+void
+OcclusionCuller::DrawProxy(int index) {
+    o_assert_dbg(this->valid);
+    Gfx::BeginQuery(this->queries[index]);
+    Gfx::Draw();
+    Gfx::EndQuery(this->queries[index]);
+}
+
+//------------------------------------------------------------------------------
+void
+OcclusionCuller::BeginQuery(int index) {
+    o_assert_dbg(this->valid);
+    Gfx::BeginQuery(this->queries[index]);
+}
+
+//------------------------------------------------------------------------------
+void
+OcclusionCuller::EndQuery(int index) {
+    o_assert_dbg(this->valid);
+    Gfx::EndQuery(this->queries[index]);
+}
+
+//------------------------------------------------------------------------------
+void
+OcclusionCuller::BeginConditionalRender(int index) {
+    o_assert_dbg(this->valid);
+    // the proxy of marked objects isn't reliable, render them unconditionally
+    if (0 == this->holdFrames[index]) {
+        Gfx::BeginConditionalRender(this->queries[index]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+OcclusionCuller::EndConditionalRender() {
+    o_assert_dbg(this->valid);
+    Gfx::EndConditionalRender();
+}
+
+} // namespace Oryol
@@ -0,0 +1,148 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::OcclusionCuller
+    @ingroup Assets
+    @brief coarse visibility from occlusion queries on bounding box proxies
+
+    The OcclusionCuller owns one occlusion query per object, a unit-cube
+    proxy mesh (built with the ShapeBuilder, positions only, centered at
+    the origin) and a pipeline which renders the proxy with depth test,
+    but without writing color or depth. The proxy shader is provided by
+    the application, it must scale and translate the unit cube into the
+    object's bounding box.
+
+    Each frame, call Update() first, this fetches the latest query
+    results (usually from the previous frame, or the frame before).
+    Draw the objects for which IsVisible() returns true, and after the
+    occluders have been rendered, apply ProxyDrawState() and call
+    DrawProxy() for every object (after applying the proxy shader's
+    uniforms). Objects without query results yet count as visible, so
+    an object which becomes visible again appears with one or two
+    frames latency, but never disappears by mistake.
+
+    If the camera is inside an object's bounding box (or the near plane
+    cuts through it), the proxy's faces are clipped or hidden behind the
+    object itself, and the query would report the object as occluded
+    forever. Test this with CameraInside() after Update(), and call
+    MarkVisible() for such objects: they count as visible, and stay
+    visible for NumHoldFrames frames after the last call, until the
+    results of proxies drawn while the camera was inside are gone.
+    Proxies should still be drawn for marked objects.
+
+    Alternatively (or additionally), objects can be drawn between
+    BeginConditionalRender() and EndConditionalRender() right after
+    their proxy, then the GPU skips the draw calls if the proxy
+    wasn't visible. The GPU waits for the query result, so there's no
+    latency, but the draw calls are stalled until the proxy has been
+    rendered. Marked objects are rendered unconditionally.
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "Resource/Id.h"
+#include "Resource/ResourceLabel.h"
+#include "Gfx/Core/Enums.h"
+#include "Gfx/Core/DrawState.h"
+#include "Gfx/Core/VertexLayout.h"
+#include "glm/vec3.hpp"
+
+namespace Oryol {
+
+class OcclusionCuller {
+public:
+    /// the query type, AnySamplesPassed is enough for visibility
+    QueryType::Code Type = QueryType::AnySamplesPassed;
+    /// minimum number of passed samples for an object to be visible
+    uint32_t MinVisibleSamples = 1;
+    /// MSAA sample count of the render target the proxies are rendered into
+    int SampleCount = 1;
+    /// number of frames an object stays visible after MarkVisible()
+    static const int NumHoldFrames = 4;
+
+    /// destructor
+    ~OcclusionCuller();
+
+    /// setup with max number of objects and proxy shader, creates Gfx resources
+    void Setup(int numObjects, const Id& proxyShader);
+    /// discard the Gfx resources
+    void Discard();
+    /// return true if has been setup
+    bool IsValid() const;
+    /// get number of objects
+    int NumObjects() const;
+
+    /// get the vertex layout of the proxy mesh
+    const VertexLayout& ProxyLayout() const;
+    /// get the draw state for rendering proxies
+    const struct DrawState& ProxyDrawState() const;
+
+    /// fetch the latest query results, call once per frame
+    void Update();
+    /// return true if object was visible in the latest query result (or has no result yet)
+    bool IsVisible(int index) const;
+    /// number of visible objects after Update()
+    int NumVisible() const;
+    /// force an object visible, call after Update() if the camera is inside its proxy
+    void MarkVisible(int index);
+    /// test if the camera is inside a bounding box, grown by the distance from the eye to the near plane's corners
+    static bool CameraInside(const glm::vec3& boxMin, const glm::vec3& boxMax, const glm::vec3& eyePos, float nearRadius);
+
+    /// draw the proxy of an object inside its occlusion query
+    void DrawProxy(int index);
+    /// begin an object's occlusion query (for custom proxy geometry)
+    void BeginQuery(int index);
+    /// end an object's occlusion query
+    void EndQuery(int index);
+    /// only render following draw calls if the object's last proxy was visible
+    void BeginConditionalRender(int index);
+    /// end conditional rendering
+    void EndConditionalRender();
+
+private:
+    ResourceLabel label;
+    VertexLayout layout;
+    struct DrawState drawState;
+    Array<Id> queries;
+    Array<bool> visible;
+    Array<int> holdFrames;
+    int numVisible = 0;
+    bool valid = false;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+OcclusionCuller::IsValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+inline int
+OcclusionCuller::NumObjects() const {
+    return this->queries.Size();
+}
+
+//------------------------------------------------------------------------------
+inline const VertexLayout&
+OcclusionCuller::ProxyLayout() const {
+    return this->layout;
+}
+
+//------------------------------------------------------------------------------
+inline const DrawState&
+OcclusionCuller::ProxyDrawState() const {
+    return this->drawState;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+OcclusionCuller::IsVisible(int index) const {
+    return this->visible[index];
+}
+
+//------------------------------------------------------------------------------
+inline int
+OcclusionCuller::NumVisible() const {
+    return this->numVisible;
+}
+
+} // namespace Oryol
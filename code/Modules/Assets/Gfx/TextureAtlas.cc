@@ -0,0 +1,272 @@
+//------------------------------------------------------------------------------
+//  TextureAtlas.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "TextureAtlas.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+void
+TextureAtlas::Setup() {
+    o_assert((this->PageWidth > 0) && (this->PageHeight > 0));
+    o_assert(this->MaxNumPages > 0);
+    o_assert(this->Padding >= 0);
+    o_assert(PixelFormat::IsValidTextureColorFormat(this->ColorFormat));
+    o_assert(!PixelFormat::IsCompressedFormat(this->ColorFormat));
+    this->bytesPerPixel = PixelFormat::ByteSize(this->ColorFormat);
+    this->Clear();
+}
+
+//------------------------------------------------------------------------------
+void
+TextureAtlas::Clear() {
+    this->pages.Clear();
+    this->regions.Clear();
+    // pixel memory for all possible pages, so that the array texture
+    // can be created with MaxNumPages layers and updated as a whole
+    this->pixels.Clear();
+    if (this->bytesPerPixel > 0) {
+        const int numBytes = this->MaxNumPages * this->PageByteSize();
+        Memory::Clear(this->pixels.Add(numBytes), numBytes);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+TextureAtlas::addPage() {
+    o_assert_dbg(this->bytesPerPixel > 0);
+    page p;
+    segment seg;
+    seg.width = this->PageWidth;
+    p.skyline.Add(seg);
+    this->pages.Add(std::move(p));
+}
+
+//------------------------------------------------------------------------------
+static int
+paddedSize(int pos, int size, int padding, int limit) {
+    // the padding is only dropped where it would cross the page border
+    return (pos + size + padding) <= limit ? size + padding : limit - pos;
+}
+
+//------------------------------------------------------------------------------
+int
+TextureAtlas::fit(const page& p, int segIndex, int width, int height) const {
+    const int x = p.skyline[segIndex].x;
+    if ((x + width) > this->PageWidth) {
+        return InvalidIndex;
+    }
+    // the rect (including its padding) rests on the highest segment it spans
+    int y = 0;
+    int widthLeft = paddedSize(x, width, this->Padding, this->PageWidth);
+    for (int i = segIndex; widthLeft > 0; i++) {
+        const segment& seg = p.skyline[i];
+        if (seg.y > y) {
+            y = seg.y;
+        }
+        if ((y + height) > this->PageHeight) {
+            return InvalidIndex;
+        }
+        widthLeft -= seg.width;
+    }
+    return y;
+}
+
+//------------------------------------------------------------------------------
+int
+TextureAtlas::findPosition(const page& p, int width, int height, int& outX, int& outY) const {
+    // bottom-left heuristic: lowest top edge, then narrowest segment
+    int bestIndex = InvalidIndex;
+    int bestBottom = this->PageHeight + 1;
+    int bestWidth = this->PageWidth + 1;
+    for (int i = 0; i < p.skyline.Size(); i++) {
+        const int y = this->fit(p, i, width, height);
+        if (InvalidIndex != y) {
+            const int bottom = y + height;
+            const int segWidth = p.skyline[i].width;
+            if ((bottom < bestBottom) || ((bottom == bestBottom) && (segWidth < bestWidth))) {
+                bestIndex = i;
+                bestBottom = bottom;
+                bestWidth = segWidth;
+                outX = p.skyline[i].x;
+                outY = y;
+            }
+        }
+    }
+    return bestIndex;
+}
+
+//------------------------------------------------------------------------------
+void
+TextureAtlas::insert(page& p, int segIndex, int x, int y, int width, int height) {
+    segment newSeg;
+    newSeg.x = x;
+    newSeg.y = y + height;
+    newSeg.width = width;
+    p.skyline.Insert(segIndex, newSeg);
+
+    // shrink or remove the segments covered by the new segment
+    const int right = x + width;
+    int i = segIndex + 1;
+    while (i < p.skyline.Size()) {
+        segment& seg = p.skyline[i];
+        if (seg.x >= right) {
+            break;
+        }
+        const int shrink = right - seg.x;
+        if (shrink >= seg.width) {
+            p.skyline.Erase(i);
+        }
+        else {
+            seg.x += shrink;
+            seg.width -= shrink;
+            break;
+        }
+    }
+
+    // merge neighbouring segments of the same height
+    for (i = 0; i < (p.skyline.Size() - 1); ) {
+        if (p.skyline[i].y == p.skyline[i + 1].y) {
+            p.skyline[i].width += p.skyline[i + 1].width;
+            p.skyline.Erase(i + 1);
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+int
+TextureAtlas::Add(int width, int height, const void* pixelData, int pitch) {
+    o_assert_dbg(this->bytesPerPixel > 0);
+    o_assert_dbg((width > 0) && (height > 0));
+
+    if ((width > this->PageWidth) || (height > this->PageHeight)) {
+        return InvalidIndex;
+    }
+
+    // try existing pages first, then open a new page
+    int pageIndex = InvalidIndex;
+    int segIndex = InvalidIndex;
+    int x = 0, y = 0;
+    for (int i = 0; i < this->pages.Size(); i++) {
+        segIndex = this->findPosition(this->pages[i], width, height, x, y);
+        if (InvalidIndex != segIndex) {
+            pageIndex = i;
+            break;
+        }
+    }
+    if (InvalidIndex == pageIndex) {
+        if (this->pages.Size() >= this->MaxNumPages) {
+            return InvalidIndex;
+        }
+        this->addPage();
+        pageIndex = this->pages.Size() - 1;
+        segIndex = this->findPosition(this->pages[pageIndex], width, height, x, y);
+        o_assert_dbg(InvalidIndex != segIndex);
+    }
+    page& p = this->pages[pageIndex];
+    const int usedWidth = paddedSize(x, width, this->Padding, this->PageWidth);
+    const int usedHeight = paddedSize(y, height, this->Padding, this->PageHeight);
+    this->insert(p, segIndex, x, y, usedWidth, usedHeight);
+
+    // copy pixels into page
+    if (pixelData) {
+        const int rowSize = width * this->bytesPerPixel;
+        const int srcPitch = pitch > 0 ? pitch : rowSize;
+        const int dstPitch = this->PageWidth * this->bytesPerPixel;
+        const uint8_t* src = (const uint8_t*) pixelData;
+        uint8_t* dst = this->pixels.Data() + pageIndex * this->PageByteSize() + y * dstPitch + x * this->bytesPerPixel;
+        for (int row = 0; row < height; row++) {
+            Memory::Copy(src, dst, rowSize);
+            src += srcPitch;
+            dst += dstPitch;
+        }
+        p.dirty = true;
+    }
+
+    Region region;
+    region.Page = pageIndex;
+    region.X = x;
+    region.Y = y;
+    region.Width = width;
+    region.Height = height;
+    region.U0 = float(x) / float(this->PageWidth);
+    region.V0 = float(y) / float(this->PageHeight);
+    region.U1 = float(x + width) / float(this->PageWidth);
+    region.V1 = float(y + height) / float(this->PageHeight);
+    this->regions.Add(region);
+    return this->regions.Size() - 1;
+}
+
+//------------------------------------------------------------------------------
+const uint8_t*
+TextureAtlas::PixelData() const {
+    return this->pixels.Data();
+}
+
+//------------------------------------------------------------------------------
+const uint8_t*
+TextureAtlas::PageData(int page) const {
+    o_assert_range_dbg(page, this->pages.Size());
+    return this->pixels.Data() + page * this->PageByteSize();
+}
+
+//------------------------------------------------------------------------------
+bool
+TextureAtlas::IsDirty() const {
+    for (const auto& p : this->pages) {
+        if (p.dirty) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void
+TextureAtlas::ClearDirty() {
+    for (auto& p : this->pages) {
+        p.dirty = false;
+    }
+}
+
+//------------------------------------------------------------------------------
+ImageDataAttrs
+TextureAtlas::ArrayImageData() const {
+    ImageDataAttrs attrs;
+    attrs.NumFaces = 1;
+    attrs.NumMipMaps = 1;
+    attrs.Offsets[0][0] = 0;
+    attrs.Sizes[0][0] = this->MaxNumPages * this->PageByteSize();
+    return attrs;
+}
+
+//------------------------------------------------------------------------------
+SetupAndData<TextureSetup>
+TextureAtlas::BuildArray(const TextureSetup& blueprint) const {
+    o_assert(this->bytesPerPixel > 0);
+    TextureSetup setup = TextureSetup::FromPixelData(this->PageWidth, this->PageHeight, 1, TextureType::Texture2DArray, this->ColorFormat, blueprint);
+    setup.Depth = this->MaxNumPages;
+    setup.ImageData = this->ArrayImageData();
+    Buffer data;
+    data.Add(this->pixels.Data(), this->pixels.Size());
+    return SetupAndData<TextureSetup>(setup, std::move(data));
+}
+
+//------------------------------------------------------------------------------
+SetupAndData<TextureSetup>
+TextureAtlas::BuildPage(int page, const TextureSetup& blueprint) const {
+    TextureSetup setup = TextureSetup::FromPixelData(this->PageWidth, this->PageHeight, 1, TextureType::Texture2D, this->ColorFormat, blueprint);
+    setup.ImageData.Offsets[0][0] = 0;
+    setup.ImageData.Sizes[0][0] = this->PageByteSize();
+    Buffer data;
+    data.Add(this->PageData(page), this->PageByteSize());
+    return SetupAndData<TextureSetup>(setup, std::move(data));
+}
+
+} // namespace Oryol
@@ -0,0 +1,158 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::TextureAtlas
+    @ingroup Assets
+    @brief pack many small images into texture atlas pages at runtime
+
+    The TextureAtlas packs small images (UI elements, decals, ...) into
+    a number of equally sized pages with a skyline bottom-left packer,
+    so that they can be rendered from a single texture without
+    texture switches. Each page is either one layer of a Texture2DArray
+    (see BuildArray()), or a separate 2D texture (see BuildPage()).
+    The array texture always has MaxNumPages layers (unused layers are
+    empty), so that pages which are opened later already have a layer.
+
+    Images can be added at any time, each Add() returns the index
+    of a Region with the page (== array layer), the pixel rectangle and
+    the normalized UV rectangle of the image. The atlas keeps a CPU copy
+    of the pixels of all MaxNumPages pages, pages which have been changed since the last
+    ClearDirty() are flagged dirty, so that a Stream texture can be
+    updated with Gfx::UpdateTexture(tex, atlas.PixelData(), atlas.ArrayImageData()).
+
+    Only uncompressed pixel formats are supported. A pixel padding is
+    kept between images to prevent filtering from bleeding into
+    neighbouring images.
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Buffer.h"
+#include "Gfx/Setup/TextureSetup.h"
+#include "Gfx/Attrs/ImageDataAttrs.h"
+#include "Resource/Core/SetupAndData.h"
+
+namespace Oryol {
+
+class TextureAtlas {
+public:
+    /// width of a page in pixels
+    int PageWidth = 1024;
+    /// height of a page in pixels
+    int PageHeight = 1024;
+    /// max number of pages (array layers)
+    int MaxNumPages = 8;
+    /// padding in pixels to the right and bottom of each image
+    int Padding = 1;
+    /// the pixel format of images and pages
+    PixelFormat::Code ColorFormat = PixelFormat::RGBA8;
+
+    /// location of a packed image
+    struct Region {
+        /// page index (array layer)
+        int Page = InvalidIndex;
+        /// left pixel position in page
+        int X = 0;
+        /// top pixel position in page
+        int Y = 0;
+        /// width in pixels
+        int Width = 0;
+        /// height in pixels
+        int Height = 0;
+        /// normalized texture coordinates of top-left corner
+        float U0 = 0.0f, V0 = 0.0f;
+        /// normalized texture coordinates of bottom-right corner
+        float U1 = 0.0f, V1 = 0.0f;
+    };
+
+    /// setup the atlas from the public config values (clears all pages)
+    void Setup();
+    /// remove all images and pages
+    void Clear();
+
+    /// pack an image, copies the pixels (optional), returns region index or InvalidIndex if full
+    int Add(int width, int height, const void* pixels=nullptr, int pitch=0);
+    /// get number of packed images
+    int NumRegions() const;
+    /// get region of a packed image
+    const Region& RegionAt(int index) const;
+
+    /// get number of pages in use
+    int NumPages() const;
+    /// get byte size of one page
+    int PageByteSize() const;
+    /// get pointer to pixel data of all MaxNumPages pages (pages are contiguous)
+    const uint8_t* PixelData() const;
+    /// get pointer to pixel data of a page
+    const uint8_t* PageData(int page) const;
+    /// return true if page has changed since last ClearDirty()
+    bool IsPageDirty(int page) const;
+    /// return true if any page has changed since last ClearDirty()
+    bool IsDirty() const;
+    /// clear the dirty flags of all pages
+    void ClearDirty();
+
+    /// get image data attributes of all MaxNumPages pages as one Texture2DArray mipmap
+    ImageDataAttrs ArrayImageData() const;
+    /// build Texture2DArray setup and data with MaxNumPages layers
+    SetupAndData<TextureSetup> BuildArray(const TextureSetup& blueprint=TextureSetup()) const;
+    /// build Texture2D setup and data for a single page
+    SetupAndData<TextureSetup> BuildPage(int page, const TextureSetup& blueprint=TextureSetup()) const;
+
+private:
+    /// a horizontal skyline segment
+    struct segment {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+    };
+    /// a page with its skyline
+    struct page {
+        Array<segment> skyline;
+        bool dirty = false;
+    };
+    /// test if a rect and its padding fits at skyline segment, return y position or InvalidIndex
+    int fit(const page& p, int segIndex, int width, int height) const;
+    /// find best position in page, return segment index or InvalidIndex
+    int findPosition(const page& p, int width, int height, int& outX, int& outY) const;
+    /// insert a rect into the skyline at segment
+    void insert(page& p, int segIndex, int x, int y, int width, int height);
+    /// add a new empty page
+    void addPage();
+
+    int bytesPerPixel = 0;
+    Array<page> pages;
+    Array<Region> regions;
+    Buffer pixels;
+};
+
+//------------------------------------------------------------------------------
+inline int
+TextureAtlas::NumRegions() const {
+    return this->regions.Size();
+}
+
+//------------------------------------------------------------------------------
+inline const TextureAtlas::Region&
+TextureAtlas::RegionAt(int index) const {
+    return this->regions[index];
+}
+
+//------------------------------------------------------------------------------
+inline int
+TextureAtlas::NumPages() const {
+    return this->pages.Size();
+}
+
+//------------------------------------------------------------------------------
+inline int
+TextureAtlas::PageByteSize() const {
+    return this->PageWidth * this->PageHeight * this->bytesPerPixel;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+TextureAtlas::IsPageDirty(int page) const {
+    return this->pages[page].dirty;
+}
+
+} // namespace Oryol
@@ -5,11 +5,15 @@
 #include "TextureLoader.h"
 #include "IO/IO.h"
 #include "Gfx/Gfx.h"
+#include "Assets/Gfx/CookedCache.h"
 #define GLIML_ASSERT(x) o_assert(x)
 #include "gliml.h"
 
 namespace Oryol {
 
+/// file extension of cooked texture blobs
+static const char* CacheExt = ".ctex";
+
 //------------------------------------------------------------------------------
 TextureLoader::TextureLoader(const TextureSetup& setup_) :
 TextureLoaderBase(setup_) {
@@ -18,13 +22,15 @@ TextureLoaderBase(setup_) {
 
 //------------------------------------------------------------------------------
 TextureLoader::TextureLoader(const TextureSetup& setup_, LoadedFunc loadedFunc_) :
-TextureLoaderBase(setup_, loadedFunc_) {
+TextureLoaderBase(setup_, std::move(loadedFunc_)) {
   // empty
 }
 
 //------------------------------------------------------------------------------
 TextureLoader::~TextureLoader() {
     o_assert_dbg(!this->ioRequest);
+    o_assert_dbg(!this->statRequest);
+    o_assert_dbg(!this->cacheRequest);
 }
 
 //------------------------------------------------------------------------------
@@ -34,13 +40,53 @@ TextureLoader::Cancel() {
         this->ioRequest->Cancelled = true;
         this->ioRequest = nullptr;
     }
+    if (this->statRequest) {
+        this->statRequest->Cancelled = true;
+        this->statRequest = nullptr;
+    }
+    if (this->cacheRequest) {
+        this->cacheRequest->Cancelled = true;
+        this->cacheRequest = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+TextureLoader::Prefetch() {
+    // gliml only looks at the file headers, so there's no decoding
+    // work to be done ahead of time, only the file data is prefetched
+    // with the cooked cache, only the cooked blob is needed on a cache hit
+    if (CookedCache::IsValid()) {
+        CookedCache::Prefetch(this->setup.Locator.Location(), CacheExt);
+    }
+    else {
+        IO::Prefetch({ URL(this->setup.Locator.Location()) });
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+TextureLoader::CancelPrefetch() {
+    if (CookedCache::IsValid()) {
+        CookedCache::CancelPrefetch(this->setup.Locator.Location());
+    }
+    else {
+        IO::CancelPrefetch({ URL(this->setup.Locator.Location()) });
+    }
 }
 
 //------------------------------------------------------------------------------
 Id
 TextureLoader::Start() {
     this->resId = Gfx::resource().prepareAsync(this->setup);
-    this->ioRequest = IO::LoadFile(setup.Locator.Location());
+    if (CookedCache::IsValid()) {
+        // the cooked blob is keyed by the source file attributes,
+        // the source file is only loaded on a cache miss
+        this->statRequest = IO::Stat(this->setup.Locator.Location());
+    }
+    else {
+        this->ioRequest = IO::LoadFile(this->setup.Locator.Location());
+    }
     return this->resId;
 }
 
@@ -48,40 +94,48 @@ TextureLoader::Start() {
 ResourceState::Code
 TextureLoader::Continue() {
     o_assert_dbg(this->resId.IsValid());
-    o_assert_dbg(this->ioRequest.isValid());
-    
+
     ResourceState::Code result = ResourceState::Pending;
-    
-    if (this->ioRequest->Handled) {
-        if (IOStatus::OK == this->ioRequest->Status) {
-            // yeah, IO is done, let gliml parse the texture data
-            // and create the texture resource
-            const uint8_t* data = this->ioRequest->Data.Data();
-            const int numBytes = this->ioRequest->Data.Size();
-            
-            gliml::context ctx;
-            ctx.enable_dxt(true);
-            ctx.enable_pvrtc(true);
-            ctx.enable_etc2(true);
-            if (ctx.load(data, numBytes)) {
-                TextureSetup texSetup = this->buildSetup(this->setup, &ctx, data);
-
-                // call the Loaded callback if defined, this
-                // gives the app a chance to look at the
-                // setup object, and possibly modify it
-                if (this->onLoaded) {
-                  this->onLoaded(texSetup);
-                }
-
-                // NOTE: the prepared texture resource might have already been
-                // destroyed at this point, if this happens, initAsync will
-                // silently fail and return ResourceState::InvalidState
-                // (the same for failedAsync)
-                result = Gfx::resource().initAsync(this->resId, texSetup, data, numBytes);
+
+    if (this->statRequest) {
+        // waiting for the source file attributes to lookup the cooked blob,
+        // if the source file can't be stat'ed, the regular load reports the error
+        if (this->statRequest->Handled) {
+            if (IOStatus::OK == this->statRequest->Status) {
+                this->sourceKey = CookedCache::SourceKey(this->setup.Locator.Location(), this->statRequest->Info);
+                this->cacheRequest = IO::LoadFile(CookedCache::CacheURL(this->sourceKey, CacheExt));
+            }
+            else {
+                this->ioRequest = IO::LoadFile(this->setup.Locator.Location());
+            }
+            this->statRequest = nullptr;
+        }
+    }
+    else if (this->cacheRequest) {
+        // waiting for the cooked blob
+        if (this->cacheRequest->Handled) {
+            TextureSetup texSetup;
+            const uint8_t* data = nullptr;
+            int numBytes = 0;
+            if ((IOStatus::OK == this->cacheRequest->Status) &&
+                CookedCache::ParseTexture(this->sourceKey,
+                    this->cacheRequest->Data.Data(), this->cacheRequest->Data.Size(),
+                    this->setup, texSetup, data, numBytes)) {
+                // cache hit, the cooked data is used in place
+                result = this->create(texSetup, data, numBytes);
             }
             else {
-                result = Gfx::resource().failedAsync(this->resId);
+                // cache miss or stale blob, load and parse the source file
+                this->ioRequest = IO::LoadFile(this->setup.Locator.Location());
+                this->cook = true;
             }
+            this->cacheRequest = nullptr;
+        }
+    }
+    else if (this->ioRequest->Handled) {
+        if (IOStatus::OK == this->ioRequest->Status) {
+            // yeah, IO is done, let gliml parse the texture data and create the texture
+            result = this->parse(this->ioRequest->Data.Data(), this->ioRequest->Data.Size(), this->cook);
         }
         else {
             // IO had failed
@@ -92,6 +146,46 @@ TextureLoader::Continue() {
     return result;
 }
 
+//------------------------------------------------------------------------------
+ResourceState::Code
+TextureLoader::parse(const uint8_t* data, int numBytes, bool cook) {
+    gliml::context ctx;
+    ctx.enable_dxt(true);
+    ctx.enable_pvrtc(true);
+    ctx.enable_etc2(true);
+    if (ctx.load(data, numBytes)) {
+        TextureSetup texSetup = this->buildSetup(this->setup, &ctx, data);
+        if (cook) {
+            Ptr<IOWrite> ioReq = IOWrite::Create();
+            const uint64_t contentHash = CookedCache::ContentHash(data, numBytes);
+            ioReq->Url = CookedCache::CacheURL(this->sourceKey, CacheExt);
+            ioReq->Data = CookedCache::CookTexture(this->sourceKey, contentHash, texSetup, data, numBytes);
+            IO::Put(ioReq);
+        }
+        return this->create(texSetup, data, numBytes);
+    }
+    else {
+        return Gfx::resource().failedAsync(this->resId);
+    }
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+TextureLoader::create(TextureSetup& texSetup, const uint8_t* data, int numBytes) {
+    // call the Loaded callback if defined, this
+    // gives the app a chance to look at the
+    // setup object, and possibly modify it
+    if (this->onLoaded) {
+        this->onLoaded(texSetup);
+    }
+
+    // NOTE: the prepared texture resource might have already been
+    // destroyed at this point, if this happens, initAsync will
+    // silently fail and return ResourceState::InvalidState
+    // (the same for failedAsync)
+    return Gfx::resource().initAsync(this->resId, texSetup, data, numBytes);
+}
+
 //------------------------------------------------------------------------------
 TextureSetup
 TextureLoader::buildSetup(const TextureSetup& blueprint, const gliml::context* ctx, const uint8_t* data) {
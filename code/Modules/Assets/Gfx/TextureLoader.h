@@ -4,6 +4,11 @@
     @class Oryol::TextureLoader
     @ingroup Assets
     @brief standard texture loader for most block-compressed texture file formats
+
+    If the CookedCache is enabled, the loader first stats the source
+    file and looks up the cooked .ctex blob for its path, size and
+    modification time, the source file is only loaded and parsed
+    on a cache miss.
 */
 #include "Gfx/Resource/TextureLoaderBase.h"
 #include "IO/FS/ioRequests.h"
@@ -29,13 +34,25 @@ public:
     virtual ResourceState::Code Continue() override;
     /// cancel the load process
     virtual void Cancel() override;
+    /// start prefetching the file data (or its cooked blob) into the IO prefetch cache
+    virtual void Prefetch() override;
+    /// cancel prefetching, evict prefetched file data
+    virtual void CancelPrefetch() override;
 
 private:
     /// convert gliml context attrs into a TextureSetup object
     TextureSetup buildSetup(const TextureSetup& blueprint, const gliml::context* ctx, const uint8_t* data);
+    /// parse the loaded file data and create the texture, optionally write cooked blob
+    ResourceState::Code parse(const uint8_t* data, int numBytes, bool cook);
+    /// create the texture resource from setup and data
+    ResourceState::Code create(TextureSetup& texSetup, const uint8_t* data, int numBytes);
     
     Id resId;
     Ptr<IORead> ioRequest;
+    Ptr<IOStat> statRequest;
+    Ptr<IORead> cacheRequest;
+    uint64_t sourceKey = 0;
+    bool cook = false;
 };
 
 } // namespace Oryol
\ No newline at end of file
@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------------
+//  CookedCacheTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Assets/Gfx/CookedCache.h"
+#include "IO/IO.h"
+#include "Core/Core.h"
+#include "Core/RunLoop.h"
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <chrono>
+
+using namespace Oryol;
+
+// source files always exist, cooked blobs only exist as '.ctex',
+// records the paths of all read requests
+std::mutex cookedReadsMutex;
+Array<String> cookedReads;
+
+class CookedTestFileSystem : public FileSystem {
+    OryolClassDecl(CookedTestFileSystem);
+    OryolClassCreator(CookedTestFileSystem);
+public:
+    virtual void onMsg(const Ptr<IORequest>& msg) override {
+        if (msg->IsA<IOStat>()) {
+            Ptr<IOStat> ioStat = msg->DynamicCast<IOStat>();
+            if (!std::strstr(ioStat->Url.Path().AsCStr(), ".cmsh")) {
+                ioStat->Info.Exists = true;
+                ioStat->Info.Size = 4;
+                ioStat->Info.ModTime = 1000;
+                ioStat->Status = IOStatus::OK;
+            }
+            else {
+                ioStat->Status = IOStatus::NotFound;
+            }
+        }
+        else if (msg->IsA<IORead>()) {
+            Ptr<IORead> ioRead = msg->DynamicCast<IORead>();
+            {
+                std::lock_guard<std::mutex> lock(cookedReadsMutex);
+                cookedReads.Add(ioRead->Url.Path());
+            }
+            static const uint8_t payload[] = {'A', 'B', 'C', 'D'};
+            ioRead->Data.Add(payload, sizeof(payload));
+            ioRead->Status = IOStatus::OK;
+        }
+        msg->Handled = true;
+    };
+};
+
+TEST(CookedCacheTest) {
+    CHECK(!CookedCache::IsValid());
+    CookedCache::Setup("file:///cache/cooked/");
+    CHECK(CookedCache::IsValid());
+    CHECK(CookedCache::CacheURL(0x0123456789ABCDEFULL, ".ctex") == "file:///cache/cooked/0123456789abcdef.ctex");
+    CookedCache::Discard();
+    CHECK(!CookedCache::IsValid());
+
+    // the source key changes with path, size and modification time
+    IOFileInfo info;
+    info.Size = 128;
+    info.ModTime = 1000;
+    const uint64_t key = CookedCache::SourceKey("tex:bla.dds", info);
+    CHECK(key == CookedCache::SourceKey("tex:bla.dds", info));
+    CHECK(key != CookedCache::SourceKey("tex:blub.dds", info));
+    info.ModTime = 1001;
+    CHECK(key != CookedCache::SourceKey("tex:bla.dds", info));
+    info.ModTime = 1000;
+    info.Size = 129;
+    CHECK(key != CookedCache::SourceKey("tex:bla.dds", info));
+}
+
+TEST(CookedTextureTest) {
+    // a fake 4x4 RGBA8 file with a 32 byte header and 3 mipmaps
+    uint8_t file[32 + 64 + 16 + 4];
+    for (int i = 0; i < int(sizeof(file)); i++) {
+        file[i] = uint8_t(i);
+    }
+    TextureSetup setup = TextureSetup::FromPixelData(4, 4, 3, TextureType::Texture2D, PixelFormat::RGBA8);
+    setup.ImageData.Offsets[0][0] = 32;  setup.ImageData.Sizes[0][0] = 64;
+    setup.ImageData.Offsets[0][1] = 96;  setup.ImageData.Sizes[0][1] = 16;
+    setup.ImageData.Offsets[0][2] = 112; setup.ImageData.Sizes[0][2] = 4;
+    const uint64_t key = 0x1234;
+    const uint64_t hash = CookedCache::ContentHash(file, sizeof(file));
+    Buffer blob = CookedCache::CookTexture(key, hash, setup, file, sizeof(file));
+    CHECK(blob.Size() > 84);
+    uint64_t blobHash = 0;
+    CHECK(CookedCache::BlobContentHash(blob.Data(), blob.Size(), blobHash));
+    CHECK(blobHash == hash);
+
+    TextureSetup blueprint;
+    blueprint.Sampler.MinFilter = TextureFilterMode::Linear;
+    TextureSetup cooked;
+    const uint8_t* data = nullptr;
+    int numBytes = 0;
+    CHECK(CookedCache::ParseTexture(key, blob.Data(), blob.Size(), blueprint, cooked, data, numBytes));
+    CHECK(cooked.ShouldSetupFromPixelData());
+    CHECK((cooked.Width == 4) && (cooked.Height == 4) && (cooked.NumMipMaps == 3));
+    CHECK(cooked.Type == TextureType::Texture2D);
+    CHECK(cooked.ColorFormat == PixelFormat::RGBA8);
+    CHECK(cooked.Sampler.MinFilter == TextureFilterMode::Linear);
+    CHECK(cooked.ImageData.NumFaces == 1);
+    CHECK(numBytes == 84);
+    CHECK((uintptr_t(data) & 15) == 0);
+    for (int mip = 0; mip < 3; mip++) {
+        const int size = cooked.ImageData.Sizes[0][mip];
+        CHECK(size == setup.ImageData.Sizes[0][mip]);
+        CHECK(0 == std::memcmp(data + cooked.ImageData.Offsets[0][mip], file + setup.ImageData.Offsets[0][mip], size));
+    }
+
+    // a different source key or a truncated blob is rejected
+    CHECK(!CookedCache::ParseTexture(key + 1, blob.Data(), blob.Size(), blueprint, cooked, data, numBytes));
+    CHECK(!CookedCache::ParseTexture(key, blob.Data(), blob.Size() - 1, blueprint, cooked, data, numBytes));
+    CHECK(!CookedCache::BlobContentHash(blob.Data(), blob.Size() - 1, blobHash));
+    // a texture blob is not a mesh blob
+    MeshSetup meshSetup;
+    CHECK(!CookedCache::ParseMesh(key, blob.Data(), blob.Size(), MeshSetup::FromData(), meshSetup, data, numBytes));
+
+    // negative or oversized surface offsets and sizes are rejected, the
+    // texture attributes directly follow the 40 byte blob header, the
+    // offsets start at byte 28 of the attributes
+    int32_t* offsets = (int32_t*) (blob.Data() + 40 + 28);
+    int32_t* sizes = offsets + GfxConfig::MaxNumTextureFaces * GfxConfig::MaxNumTextureMipMaps;
+    CHECK((offsets[1] == 64) && (sizes[1] == 16));
+    offsets[1] = -16;
+    CHECK(!CookedCache::ParseTexture(key, blob.Data(), blob.Size(), blueprint, cooked, data, numBytes));
+    offsets[1] = 64;
+    sizes[1] = -16;
+    CHECK(!CookedCache::ParseTexture(key, blob.Data(), blob.Size(), blueprint, cooked, data, numBytes));
+    sizes[1] = 0x7FFFFFF0;
+    CHECK(!CookedCache::ParseTexture(key, blob.Data(), blob.Size(), blueprint, cooked, data, numBytes));
+    sizes[1] = 16;
+    CHECK(CookedCache::ParseTexture(key, blob.Data(), blob.Size(), blueprint, cooked, data, numBytes));
+}
+
+TEST(CookedMeshTest) {
+    // a fake file with a 16 byte header, 4 vertices and 6 16-bit indices
+    struct vertex {
+        float x, y, z;
+        uint32_t color;
+    };
+    uint8_t file[16 + 4 * sizeof(vertex) + 6 * sizeof(uint16_t)];
+    for (int i = 0; i < int(sizeof(file)); i++) {
+        file[i] = uint8_t(i * 3);
+    }
+    MeshSetup setup = MeshSetup::FromData();
+    setup.Layout.Add(VertexAttr::Position, VertexFormat::Float3);
+    setup.Layout.Add(VertexAttr::Color0, VertexFormat::UByte4N);
+    setup.NumVertices = 4;
+    setup.NumIndices = 6;
+    setup.IndicesType = IndexType::Index16;
+    setup.AddPrimitiveGroup(PrimitiveGroup(0, 6));
+    setup.DataVertexOffset = 16;
+    setup.DataIndexOffset = 16 + 4 * sizeof(vertex);
+    const uint64_t key = 0x5678;
+    const uint64_t hash = CookedCache::ContentHash(file, sizeof(file));
+    Buffer blob = CookedCache::CookMesh(key, hash, setup, file, sizeof(file));
+
+    MeshSetup cooked;
+    const uint8_t* data = nullptr;
+    int numBytes = 0;
+    CHECK(CookedCache::ParseMesh(key, blob.Data(), blob.Size(), MeshSetup::FromData(), cooked, data, numBytes));
+    CHECK(cooked.ShouldSetupFromData());
+    CHECK(cooked.Layout.NumComponents() == 2);
+    CHECK(cooked.Layout.ComponentAt(0).Attr == VertexAttr::Position);
+    CHECK(cooked.Layout.ComponentAt(1).Format == VertexFormat::UByte4N);
+    CHECK(cooked.Layout.ByteSize() == sizeof(vertex));
+    CHECK((cooked.NumVertices == 4) && (cooked.NumIndices == 6));
+    CHECK(cooked.IndicesType == IndexType::Index16);
+    CHECK(cooked.NumPrimitiveGroups() == 1);
+    CHECK((cooked.PrimitiveGroup(0).BaseElement == 0) && (cooked.PrimitiveGroup(0).NumElements == 6));
+    CHECK(cooked.DataVertexOffset == 0);
+    CHECK(cooked.DataIndexOffset == int(4 * sizeof(vertex)));
+    CHECK(numBytes == int(sizeof(file) - 16));
+    CHECK(0 == std::memcmp(data, file + 16, numBytes));
+
+    // a mesh blob is not a texture blob
+    TextureSetup texSetup;
+    CHECK(!CookedCache::ParseTexture(key, blob.Data(), blob.Size(), TextureSetup(), texSetup, data, numBytes));
+
+    // negative counts and out-of-range index data are rejected, the
+    // index offset is the last member of the mesh attributes
+    const int attrsSize = int(sizeof(int32_t)) * (1 + 2 * GfxConfig::MaxNumVertexLayoutComponents + 6 + 2 * GfxConfig::MaxNumPrimGroups + 2);
+    int32_t* indexOffset = (int32_t*) (blob.Data() + 40 + attrsSize - 4);
+    CHECK(*indexOffset == int(4 * sizeof(vertex)));
+    *indexOffset = -2;
+    CHECK(!CookedCache::ParseMesh(key, blob.Data(), blob.Size(), MeshSetup::FromData(), cooked, data, numBytes));
+    *indexOffset = int(4 * sizeof(vertex)) + 2;
+    CHECK(!CookedCache::ParseMesh(key, blob.Data(), blob.Size(), MeshSetup::FromData(), cooked, data, numBytes));
+    *indexOffset = int(4 * sizeof(vertex));
+    int32_t* numIndices = indexOffset - 4 - 2 * GfxConfig::MaxNumPrimGroups;
+    CHECK(*numIndices == 6);
+    *numIndices = 0x40000000;
+    CHECK(!CookedCache::ParseMesh(key, blob.Data(), blob.Size(), MeshSetup::FromData(), cooked, data, numBytes));
+    *numIndices = -6;
+    CHECK(!CookedCache::ParseMesh(key, blob.Data(), blob.Size(), MeshSetup::FromData(), cooked, data, numBytes));
+    *numIndices = 6;
+    CHECK(CookedCache::ParseMesh(key, blob.Data(), blob.Size(), MeshSetup::FromData(), cooked, data, numBytes));
+}
+
+#if !ORYOL_EMSCRIPTEN && !ORYOL_UNITTESTS_HEADLESS
+TEST(CookedPrefetchTest) {
+    Core::Setup();
+    IO::Setup(IOSetup());
+    IO::RegisterFileSystem("cook", CookedTestFileSystem::Creator());
+    CookedCache::Setup("cook://cache/cooked/");
+    IOFileInfo info;
+    info.Size = 4;
+    info.ModTime = 1000;
+
+    // a cache hit only prefetches the cooked blob
+    const URL tex("cook://src/tex.dds");
+    const URL texBlob = CookedCache::CacheURL(CookedCache::SourceKey(tex, info), ".ctex");
+    CookedCache::Prefetch(tex, ".ctex");
+    while (IO::PrefetchCacheBytes() < 4) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(cookedReads.Size() == 1);
+    CHECK(cookedReads[0] == texBlob.Path());
+    Ptr<IORead> ioReq = IO::LoadFile(texBlob);
+    CHECK(ioReq->Handled);
+    CHECK(ioReq->Data.Size() == 4);
+    CHECK(cookedReads.Size() == 1);
+
+    // a cache miss prefetches the source file
+    const URL mesh("cook://src/mesh.omsh");
+    CookedCache::Prefetch(mesh, ".cmsh");
+    while (IO::PrefetchCacheBytes() < 4) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(cookedReads.Size() == 2);
+    CHECK(cookedReads[1] == mesh.Path());
+
+    // cancelling drops the prefetched data
+    CookedCache::CancelPrefetch(mesh);
+    CHECK(IO::PrefetchCacheBytes() == 0);
+
+    // the same source can be prefetched again after it has been consumed
+    CookedCache::Prefetch(tex, ".ctex");
+    while (IO::PrefetchCacheBytes() < 4) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(cookedReads.Size() == 3);
+    CHECK(cookedReads[2] == texBlob.Path());
+
+    CookedCache::Discard();
+    IO::Discard();
+    Core::Discard();
+}
+#endif
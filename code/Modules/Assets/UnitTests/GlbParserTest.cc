@@ -0,0 +1,326 @@
+//------------------------------------------------------------------------------
+//  GlbParserTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Assets/Gfx/GlbParser.h"
+#include "Core/Threading/WorkerPool.h"
+#include <cstring>
+#include <cstdio>
+
+using namespace Oryol;
+
+// build a GLB file from a JSON string and BIN chunk data
+static Buffer makeGlb(const char* json, const void* bin, int binSize) {
+    const uint32_t jsonSize = (uint32_t(std::strlen(json)) + 3) & ~3;
+    const uint32_t paddedBinSize = (uint32_t(binSize) + 3) & ~3;
+    const uint32_t header[5] = {
+        0x46546C67, 2, 20 + jsonSize + 8 + paddedBinSize, jsonSize, 0x4E4F534A
+    };
+    Buffer glb;
+    glb.Add((const uint8_t*)header, sizeof(header));
+    uint8_t* jsonPtr = glb.Add(jsonSize);
+    std::memset(jsonPtr, ' ', jsonSize);
+    std::memcpy(jsonPtr, json, std::strlen(json));
+    const uint32_t binHeader[2] = { paddedBinSize, 0x004E4942 };
+    glb.Add((const uint8_t*)binHeader, sizeof(binHeader));
+    uint8_t* binPtr = glb.Add(paddedBinSize);
+    std::memset(binPtr, 0, paddedBinSize);
+    std::memcpy(binPtr, bin, binSize);
+    return glb;
+}
+
+//------------------------------------------------------------------------------
+TEST(GlbParserInPlaceTest) {
+    // 3 interleaved vertices (uv first, then position), 2 triangles in 2 primitives
+    struct vertex {
+        float u, v;
+        float x, y, z;
+    };
+    struct {
+        vertex vertices[3];
+        uint16_t indices[6];
+    } bin = {
+        { { 0.0f, 0.0f, 1.0f, 2.0f, 3.0f }, { 1.0f, 0.0f, 4.0f, 5.0f, 6.0f }, { 1.0f, 1.0f, 7.0f, 8.0f, 9.0f } },
+        { 0, 1, 2, 2, 1, 0 }
+    };
+    const char* json =
+        "{\"asset\":{\"version\":\"2.0\"},"
+        "\"buffers\":[{\"byteLength\":72}],"
+        "\"bufferViews\":["
+            "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":60,\"byteStride\":20},"
+            "{\"buffer\":0,\"byteOffset\":60,\"byteLength\":12}],"
+        "\"accessors\":["
+            "{\"bufferView\":0,\"byteOffset\":8,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+            "{\"bufferView\":0,\"byteOffset\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC2\"},"
+            "{\"bufferView\":1,\"byteOffset\":0,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"},"
+            "{\"bufferView\":1,\"byteOffset\":6,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"}],"
+        "\"meshes\":[{\"primitives\":["
+            "{\"attributes\":{\"POSITION\":0,\"TEXCOORD_0\":1},\"indices\":2},"
+            "{\"attributes\":{\"TEXCOORD_0\":1,\"POSITION\":0},\"indices\":3,\"mode\":4}]}]}";
+    Buffer glb = makeGlb(json, &bin, sizeof(bin));
+
+    MeshSetup setup = MeshSetup::FromData();
+    Buffer data;
+    CHECK(GlbParser::Parse(glb.Data(), glb.Size(), InvalidIndex, setup, data));
+    CHECK(data.Empty());
+    CHECK(setup.Layout.NumComponents() == 2);
+    CHECK(setup.Layout.ComponentAt(0).Attr == VertexAttr::TexCoord0);
+    CHECK(setup.Layout.ComponentAt(0).Format == VertexFormat::Float2);
+    CHECK(setup.Layout.ComponentAt(1).Attr == VertexAttr::Position);
+    CHECK(setup.Layout.ComponentAt(1).Format == VertexFormat::Float3);
+    CHECK(setup.NumVertices == 3);
+    CHECK(setup.NumIndices == 6);
+    CHECK(setup.IndicesType == IndexType::Index16);
+    CHECK(setup.NumPrimitiveGroups() == 2);
+    CHECK(setup.PrimitiveGroup(0).BaseElement == 0);
+    CHECK(setup.PrimitiveGroup(0).NumElements == 3);
+    CHECK(setup.PrimitiveGroup(1).BaseElement == 3);
+    CHECK(setup.PrimitiveGroup(1).NumElements == 3);
+    CHECK(0 == std::memcmp(glb.Data() + setup.DataVertexOffset, bin.vertices, sizeof(bin.vertices)));
+    CHECK(0 == std::memcmp(glb.Data() + setup.DataIndexOffset, bin.indices, sizeof(bin.indices)));
+
+    // select the mesh by index
+    MeshSetup setup1 = MeshSetup::FromData();
+    CHECK(GlbParser::Parse(glb.Data(), glb.Size(), 0, setup1, data));
+    CHECK(setup1.NumPrimitiveGroups() == 2);
+    MeshSetup setup2 = MeshSetup::FromData();
+    CHECK(!GlbParser::Parse(glb.Data(), glb.Size(), 1, setup2, data));
+}
+
+//------------------------------------------------------------------------------
+TEST(GlbParserConvertTest) {
+    // 2 meshes with separate vertex data: mesh 0 is non-indexed, with
+    // UByte4N colors, mesh 1 has byte normals and 8-bit indices
+    struct {
+        float positions0[9];
+        uint8_t colors0[12];
+        float positions1[9];
+        int8_t normals1[12];
+        uint8_t indices1[4];
+    } bin = {
+        { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f },
+        { 255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255 },
+        { 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f },
+        { 0, 0, 127, 0, 0, 0, -128, 0, 0, 127, 0, 0 },
+        { 2, 1, 0, 0 }
+    };
+    const char* json =
+        "{\"asset\":{\"version\":\"2.0\"},"
+        "\"bufferViews\":["
+            "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":36},"
+            "{\"buffer\":0,\"byteOffset\":36,\"byteLength\":12},"
+            "{\"buffer\":0,\"byteOffset\":48,\"byteLength\":36},"
+            "{\"buffer\":0,\"byteOffset\":84,\"byteLength\":12,\"byteStride\":4},"
+            "{\"buffer\":0,\"byteOffset\":96,\"byteLength\":3}],"
+        "\"accessors\":["
+            "{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+            "{\"bufferView\":1,\"componentType\":5121,\"normalized\":true,\"count\":3,\"type\":\"VEC4\"},"
+            "{\"bufferView\":2,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+            "{\"bufferView\":3,\"componentType\":5120,\"normalized\":true,\"count\":3,\"type\":\"VEC3\"},"
+            "{\"bufferView\":4,\"componentType\":5121,\"count\":3,\"type\":\"SCALAR\"}],"
+        "\"meshes\":["
+            "{\"primitives\":[{\"attributes\":{\"COLOR_0\":1,\"POSITION\":0}}]},"
+            "{\"primitives\":[{\"attributes\":{\"POSITION\":2,\"NORMAL\":3},\"indices\":4}]}]}";
+    Buffer glb = makeGlb(json, &bin, sizeof(bin));
+
+    MeshSetup setup = MeshSetup::FromData();
+    Buffer data;
+    CHECK(GlbParser::Parse(glb.Data(), glb.Size(), InvalidIndex, setup, data));
+    CHECK(setup.Layout.NumComponents() == 3);
+    CHECK(setup.Layout.ComponentAt(0).Attr == VertexAttr::Position);
+    CHECK(setup.Layout.ComponentAt(0).Format == VertexFormat::Float3);
+    CHECK(setup.Layout.ComponentAt(1).Attr == VertexAttr::Normal);
+    CHECK(setup.Layout.ComponentAt(1).Format == VertexFormat::Float3);
+    CHECK(setup.Layout.ComponentAt(2).Attr == VertexAttr::Color0);
+    CHECK(setup.Layout.ComponentAt(2).Format == VertexFormat::UByte4N);
+    CHECK(setup.NumVertices == 6);
+    CHECK(setup.NumIndices == 6);
+    CHECK(setup.IndicesType == IndexType::Index16);
+    CHECK(setup.DataVertexOffset == 0);
+    CHECK(setup.DataIndexOffset == 6 * 28);
+    CHECK(data.Size() == 6 * 28 + 6 * 2);
+    CHECK(setup.NumPrimitiveGroups() == 2);
+    CHECK(setup.PrimitiveGroup(1).BaseElement == 3);
+    CHECK(setup.PrimitiveGroup(1).NumElements == 3);
+
+    const uint8_t* vertices = data.Data();
+    float f[6];
+    // vertex 1: position copied, no normal, color copied
+    std::memcpy(f, vertices + 28, sizeof(f));
+    CHECK(f[0] == 1.0f && f[1] == 0.0f && f[2] == 0.0f);
+    CHECK(f[3] == 0.0f && f[4] == 0.0f && f[5] == 0.0f);
+    CHECK(0 == std::memcmp(vertices + 28 + 24, &bin.colors0[4], 4));
+    // vertex 4: normal converted from normalized bytes, no color
+    std::memcpy(f, vertices + 4 * 28, sizeof(f));
+    CHECK(f[0] == 1.0f && f[1] == 0.0f && f[2] == 1.0f);
+    CHECK(f[3] == 0.0f && f[4] == 0.0f);
+    CHECK_CLOSE(-1.0f, f[5], 0.0001f);
+    const uint8_t noColor[4] = { 0, 0, 0, 0 };
+    CHECK(0 == std::memcmp(vertices + 4 * 28 + 24, noColor, 4));
+    // indices: generated for mesh 0, rebased for mesh 1
+    uint16_t indices[6];
+    std::memcpy(indices, data.Data() + setup.DataIndexOffset, sizeof(indices));
+    CHECK(indices[0] == 0 && indices[1] == 1 && indices[2] == 2);
+    CHECK(indices[3] == 5 && indices[4] == 4 && indices[5] == 3);
+
+    // the same with worker threads
+    WorkerPool workers;
+    workers.Setup(2);
+    MeshSetup setupMt = MeshSetup::FromData();
+    Buffer dataMt;
+    CHECK(GlbParser::Parse(glb.Data(), glb.Size(), InvalidIndex, setupMt, dataMt, &workers));
+    CHECK(dataMt.Size() == data.Size());
+    CHECK(0 == std::memcmp(dataMt.Data(), data.Data(), data.Size()));
+    workers.Discard();
+
+    // only mesh 1
+    MeshSetup setup1 = MeshSetup::FromData();
+    Buffer data1;
+    CHECK(GlbParser::Parse(glb.Data(), glb.Size(), 1, setup1, data1));
+    CHECK(setup1.NumVertices == 3);
+    CHECK(setup1.Layout.NumComponents() == 2);
+    std::memcpy(indices, data1.Data() + setup1.DataIndexOffset, 3 * sizeof(uint16_t));
+    CHECK(indices[0] == 2 && indices[1] == 1 && indices[2] == 0);
+}
+
+//------------------------------------------------------------------------------
+TEST(GlbParserInvalidTest) {
+    const float positions[9] = { };
+    const char* jsonFmt =
+        "{\"bufferViews\":[{\"buffer\":0,\"byteLength\":36}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":%d,\"type\":\"VEC3\"%s}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0}%s}]}]}";
+    char json[512];
+
+    // valid
+    std::snprintf(json, sizeof(json), jsonFmt, 3, "", "");
+    Buffer glb = makeGlb(json, positions, sizeof(positions));
+    MeshSetup setup = MeshSetup::FromData();
+    Buffer data;
+    CHECK(GlbParser::Parse(glb.Data(), glb.Size(), InvalidIndex, setup, data));
+    CHECK(setup.IndicesType == IndexType::None);
+    CHECK(setup.DataIndexOffset == InvalidIndex);
+
+    // accessor out of buffer view bounds
+    std::snprintf(json, sizeof(json), jsonFmt, 4, "", "");
+    glb = makeGlb(json, positions, sizeof(positions));
+    MeshSetup setup1 = MeshSetup::FromData();
+    CHECK(!GlbParser::Parse(glb.Data(), glb.Size(), InvalidIndex, setup1, data));
+
+    // sparse accessor
+    std::snprintf(json, sizeof(json), jsonFmt, 3, ",\"sparse\":{}", "");
+    glb = makeGlb(json, positions, sizeof(positions));
+    MeshSetup setup2 = MeshSetup::FromData();
+    CHECK(!GlbParser::Parse(glb.Data(), glb.Size(), InvalidIndex, setup2, data));
+
+    // triangle fan
+    std::snprintf(json, sizeof(json), jsonFmt, 3, "", ",\"mode\":6");
+    glb = makeGlb(json, positions, sizeof(positions));
+    MeshSetup setup3 = MeshSetup::FromData();
+    CHECK(!GlbParser::Parse(glb.Data(), glb.Size(), InvalidIndex, setup3, data));
+
+    // malformed JSON
+    glb = makeGlb("{\"meshes\":[}", positions, sizeof(positions));
+    MeshSetup setup4 = MeshSetup::FromData();
+    CHECK(!GlbParser::Parse(glb.Data(), glb.Size(), InvalidIndex, setup4, data));
+
+    // bad magic
+    std::snprintf(json, sizeof(json), jsonFmt, 3, "", "");
+    glb = makeGlb(json, positions, sizeof(positions));
+    glb.Data()[0] = 'X';
+    MeshSetup setup5 = MeshSetup::FromData();
+    CHECK(!GlbParser::Parse(glb.Data(), glb.Size(), InvalidIndex, setup5, data));
+    CHECK(data.Empty());
+
+    // GLB size smaller than the headers, with a huge JSON chunk size
+    const uint32_t truncated[6] = { 0x46546C67, 2, 12, 1024 * 1024, 0x4E4F534A, 0 };
+    MeshSetup setup6 = MeshSetup::FromData();
+    CHECK(!GlbParser::Parse(truncated, sizeof(truncated), InvalidIndex, setup6, data));
+
+    // JSON chunk size bigger than the GLB data
+    std::snprintf(json, sizeof(json), jsonFmt, 3, "", "");
+    glb = makeGlb(json, positions, sizeof(positions));
+    ((uint32_t*)glb.Data())[3] = uint32_t(glb.Size());
+    MeshSetup setup7 = MeshSetup::FromData();
+    CHECK(!GlbParser::Parse(glb.Data(), glb.Size(), InvalidIndex, setup7, data));
+    CHECK(data.Empty());
+}
+
+//------------------------------------------------------------------------------
+TEST(GlbParserIndexRangeTest) {
+    // 3 vertices, followed by 16-bit indices (in-place) or 8-bit indices (converted)
+    struct {
+        float positions[9];
+        uint16_t indices16[3];
+        uint8_t indices8[3];
+        uint8_t pad[3];
+    } bin = { { }, { 0, 1, 2 }, { 0, 1, 2 }, { } };
+    const char* json =
+        "{\"bufferViews\":[{\"buffer\":0,\"byteLength\":36},"
+        "{\"buffer\":0,\"byteOffset\":36,\"byteLength\":6},"
+        "{\"buffer\":0,\"byteOffset\":42,\"byteLength\":3}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+        "{\"bufferView\":1,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"},"
+        "{\"bufferView\":2,\"componentType\":5121,\"count\":3,\"type\":\"SCALAR\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1}]},"
+        "{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":2}]}]}";
+
+    // valid indices, mesh 0 is setup in place, mesh 1 is converted
+    Buffer glb = makeGlb(json, &bin, sizeof(bin));
+    MeshSetup setup0 = MeshSetup::FromData();
+    Buffer data0;
+    CHECK(GlbParser::Parse(glb.Data(), glb.Size(), 0, setup0, data0));
+    CHECK(data0.Empty());
+    MeshSetup setup1 = MeshSetup::FromData();
+    Buffer data1;
+    CHECK(GlbParser::Parse(glb.Data(), glb.Size(), 1, setup1, data1));
+    CHECK(!data1.Empty());
+
+    // an out-of-range index is rejected on both paths
+    bin.indices16[2] = 3;
+    bin.indices8[1] = 200;
+    glb = makeGlb(json, &bin, sizeof(bin));
+    MeshSetup setup2 = MeshSetup::FromData();
+    Buffer data2;
+    CHECK(!GlbParser::Parse(glb.Data(), glb.Size(), 0, setup2, data2));
+    CHECK(data2.Empty());
+    MeshSetup setup3 = MeshSetup::FromData();
+    CHECK(!GlbParser::Parse(glb.Data(), glb.Size(), 1, setup3, data2));
+    CHECK(data2.Empty());
+}
+
+//------------------------------------------------------------------------------
+TEST(GlbParserMeshesTest) {
+    // 5 meshes with 2 primitives each, more than fit into one MeshSetup
+    const float positions[9] = { };
+    char json[1024];
+    int len = std::snprintf(json, sizeof(json),
+        "{\"bufferViews\":[{\"buffer\":0,\"byteLength\":36}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}],"
+        "\"meshes\":[");
+    const int numMeshes = 5;
+    for (int i = 0; i < numMeshes; i++) {
+        len += std::snprintf(json + len, sizeof(json) - len,
+            "%s{\"primitives\":[{\"attributes\":{\"POSITION\":0}},{\"attributes\":{\"POSITION\":0}}]}",
+            i > 0 ? "," : "");
+    }
+    std::snprintf(json + len, sizeof(json) - len, "]}");
+    Buffer glb = makeGlb(json, positions, sizeof(positions));
+    CHECK(GlbParser::NumMeshes(glb.Data(), glb.Size()) == numMeshes);
+    CHECK(GlbParser::NumMeshes(glb.Data(), 16) == 0);
+
+    // merging all meshes fails, loading them one by one works
+    MeshSetup merged = MeshSetup::FromData();
+    Buffer data;
+    CHECK(!GlbParser::Parse(glb.Data(), glb.Size(), InvalidIndex, merged, data));
+    for (int i = 0; i < numMeshes; i++) {
+        MeshSetup setup = MeshSetup::FromData();
+        Buffer meshData;
+        CHECK(GlbParser::Parse(glb.Data(), glb.Size(), i, setup, meshData));
+        CHECK(setup.NumPrimitiveGroups() == 2);
+        CHECK(setup.NumVertices == 3);
+    }
+    MeshSetup outOfRange = MeshSetup::FromData();
+    CHECK(!GlbParser::Parse(glb.Data(), glb.Size(), numMeshes, outOfRange, data));
+}
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+//  JsonValueTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Assets/Gfx/JsonValue.h"
+#include <cstring>
+
+using namespace Oryol;
+
+static JsonValue parse(const char* str) {
+    return JsonValue::Parse(str, int(std::strlen(str)));
+}
+
+TEST(JsonValueTest) {
+    const char* json =
+        "{ \"asset\": { \"version\": \"2.0\" },\n"
+        "  \"nums\": [ 1, -2, 1.5e2, -0.25, 3E-1 ],\n"
+        "  \"flags\": [true, false, null],\n"
+        "  \"str\": \"a \\\"quoted\\\" \\\\\",\n"
+        "  \"empty\": {}, \"none\": [] }";
+    const JsonValue root = parse(json);
+    CHECK(root.IsValid());
+    CHECK(root.GetType() == JsonValue::Object);
+    CHECK(root.Size() == 6);
+    CHECK(!root.Key().IsValid());
+
+    const JsonValue version = root.Member("asset").Member("version");
+    CHECK(version.GetType() == JsonValue::String);
+    CHECK(version.Equals("2.0"));
+    CHECK(!version.Equals("2.00"));
+    CHECK(version.StringLength() == 3);
+    CHECK(0 == std::strncmp(version.StringBegin(), "2.0", 3));
+
+    const JsonValue nums = root.Member("nums");
+    CHECK(nums.GetType() == JsonValue::Array);
+    CHECK(nums.Size() == 5);
+    CHECK(nums.At(0).AsInt() == 1);
+    CHECK(nums.At(1).AsInt() == -2);
+    CHECK(nums.At(2).AsInt() == 150);
+    CHECK_CLOSE(150.0f, nums.At(2).AsFloat(), 0.0001f);
+    CHECK_CLOSE(-0.25f, nums.At(3).AsFloat(), 0.0001f);
+    CHECK_CLOSE(0.3f, nums.At(4).AsFloat(), 0.0001f);
+    CHECK(!nums.At(5).IsValid());
+    CHECK(!nums.At(-1).IsValid());
+    int sum = 0;
+    for (JsonValue val = nums.First(); val.IsValid(); val = val.Next()) {
+        sum += val.AsInt();
+    }
+    CHECK(sum == 149);
+
+    const JsonValue flags = root.Member("flags");
+    CHECK(flags.At(0).GetType() == JsonValue::Bool);
+    CHECK(flags.At(0).AsBool());
+    CHECK(!flags.At(1).AsBool(true));
+    CHECK(flags.At(2).GetType() == JsonValue::Null);
+    CHECK(flags.At(2).AsInt(7) == 7);
+
+    const JsonValue str = root.Member("str");
+    CHECK(str.Equals("a \\\"quoted\\\" \\\\"));
+    CHECK(str.Key().Equals("str"));
+    CHECK(str.Next().Key().Equals("empty"));
+
+    CHECK(root.Member("empty").GetType() == JsonValue::Object);
+    CHECK(root.Member("empty").Size() == 0);
+    CHECK(!root.Member("empty").First().IsValid());
+    CHECK(root.Member("none").Size() == 0);
+    CHECK(!root.Member("missing").IsValid());
+    CHECK(!nums.Member("asset").IsValid());
+    CHECK(root.Member("missing").Member("x").AsInt(3) == 3);
+
+    // scalar documents
+    CHECK(parse(" 42 ").AsInt() == 42);
+    CHECK(parse("\"x\"").Equals("x"));
+}
+
+TEST(JsonValueMalformedTest) {
+    CHECK(!parse("").IsValid());
+    CHECK(!parse("{").IsValid());
+    CHECK(!parse("[1,]").IsValid());
+    CHECK(!parse("[1 2]").IsValid());
+    CHECK(!parse("{\"a\" 1}").IsValid());
+    CHECK(!parse("{\"a\": }").IsValid());
+    CHECK(!parse("{1: 2}").IsValid());
+    CHECK(!parse("tru").IsValid());
+    CHECK(!parse("\"abc").IsValid());
+    CHECK(!parse("\"abc\\\"").IsValid());
+    CHECK(!parse("1.").IsValid());
+    CHECK(!parse("-").IsValid());
+    CHECK(!parse("1e").IsValid());
+    CHECK(!parse("[] []").IsValid());
+
+    // nesting depth is limited
+    char deep[256];
+    for (int i = 0; i < 100; i++) {
+        deep[i] = '[';
+        deep[100 + i] = ']';
+    }
+    deep[200] = 0;
+    CHECK(!parse(deep).IsValid());
+    deep[140] = 0;
+    CHECK(parse(&deep[60]).IsValid());
+}
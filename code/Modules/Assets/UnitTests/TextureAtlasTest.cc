@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+//  TextureAtlasTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Assets/Gfx/TextureAtlas.h"
+
+using namespace Oryol;
+
+// test if two regions overlap (including padding)
+static bool
+overlap(const TextureAtlas::Region& r0, const TextureAtlas::Region& r1, int pad) {
+    if (r0.Page != r1.Page) {
+        return false;
+    }
+    return (r0.X < (r1.X + r1.Width + pad)) && (r1.X < (r0.X + r0.Width + pad)) &&
+           (r0.Y < (r1.Y + r1.Height + pad)) && (r1.Y < (r0.Y + r0.Height + pad));
+}
+
+TEST(TextureAtlasTest) {
+    TextureAtlas atlas;
+    atlas.PageWidth = 64;
+    atlas.PageHeight = 64;
+    atlas.MaxNumPages = 2;
+    atlas.Padding = 1;
+    atlas.ColorFormat = PixelFormat::RGBA8;
+    atlas.Setup();
+    CHECK(atlas.NumPages() == 0);
+    CHECK(atlas.PageByteSize() == 64 * 64 * 4);
+
+    // first image goes to top-left of first page
+    uint32_t pixels[8 * 4];
+    for (int i = 0; i < 8 * 4; i++) {
+        pixels[i] = 0xFF000000 | i;
+    }
+    int r0 = atlas.Add(8, 4, pixels);
+    CHECK(r0 == 0);
+    CHECK(atlas.NumPages() == 1);
+    CHECK(atlas.IsPageDirty(0));
+    const TextureAtlas::Region& reg0 = atlas.RegionAt(r0);
+    CHECK((reg0.Page == 0) && (reg0.X == 0) && (reg0.Y == 0));
+    CHECK((reg0.Width == 8) && (reg0.Height == 4));
+    CHECK_CLOSE(reg0.U0, 0.0f, 0.0001f);
+    CHECK_CLOSE(reg0.U1, 8.0f / 64.0f, 0.0001f);
+    CHECK_CLOSE(reg0.V1, 4.0f / 64.0f, 0.0001f);
+    const uint32_t* page0 = (const uint32_t*) atlas.PageData(0);
+    CHECK(page0[0] == 0xFF000000);
+    CHECK(page0[7] == 0xFF000007);
+    CHECK(page0[64] == 0xFF000008);
+    CHECK(page0[8] == 0);
+
+    // next image goes to the right (bottom-left heuristic)
+    int r1 = atlas.Add(8, 8);
+    CHECK((atlas.RegionAt(r1).X == 9) && (atlas.RegionAt(r1).Y == 0));
+    atlas.ClearDirty();
+    CHECK(!atlas.IsDirty());
+
+    // fill up the first page with many small images, none may overlap
+    int lastRegion = r1;
+    while (true) {
+        int r = atlas.Add(7, 5);
+        CHECK(InvalidIndex != r);
+        lastRegion = r;
+        if (atlas.RegionAt(r).Page != 0) {
+            break;
+        }
+    }
+    CHECK(atlas.NumPages() == 2);
+    CHECK(atlas.RegionAt(lastRegion).Page == 1);
+    CHECK(atlas.RegionAt(lastRegion).X == 0);
+    CHECK(atlas.NumRegions() > 64);
+    for (int i = 0; i < atlas.NumRegions(); i++) {
+        const auto& ri = atlas.RegionAt(i);
+        CHECK((ri.X + ri.Width) <= 64);
+        CHECK((ri.Y + ri.Height) <= 64);
+        for (int j = i + 1; j < atlas.NumRegions(); j++) {
+            CHECK(!overlap(ri, atlas.RegionAt(j), 1));
+        }
+    }
+
+    // images bigger than a page are rejected
+    CHECK(InvalidIndex == atlas.Add(65, 8));
+    // an image filling a whole page fits without padding, but not more than MaxNumPages
+    CHECK(InvalidIndex == atlas.Add(64, 64));
+
+    // build a texture array setup
+    auto arr = atlas.BuildArray();
+    CHECK(arr.Setup.ShouldSetupFromPixelData());
+    CHECK(arr.Setup.Type == TextureType::Texture2DArray);
+    CHECK(arr.Setup.Width == 64);
+    CHECK(arr.Setup.Height == 64);
+    CHECK(arr.Setup.Depth == 2);
+    CHECK(arr.Setup.ImageData.NumFaces == 1);
+    CHECK(arr.Setup.ImageData.Sizes[0][0] == 2 * 64 * 64 * 4);
+    CHECK(arr.Data.Size() == 2 * 64 * 64 * 4);
+
+    // ...and a single page texture
+    auto pg = atlas.BuildPage(1);
+    CHECK(pg.Setup.Type == TextureType::Texture2D);
+    CHECK(pg.Data.Size() == 64 * 64 * 4);
+
+    // the array always has MaxNumPages layers, also with unused pages
+    TextureAtlas atlas4;
+    atlas4.PageWidth = 16;
+    atlas4.PageHeight = 16;
+    atlas4.MaxNumPages = 4;
+    atlas4.Setup();
+    atlas4.Add(16, 16);
+    CHECK(atlas4.NumPages() == 1);
+    auto arr4 = atlas4.BuildArray();
+    CHECK(arr4.Setup.Depth == 4);
+    CHECK(arr4.Data.Size() == 4 * 16 * 16 * 4);
+    CHECK(atlas4.ArrayImageData().Sizes[0][0] == 4 * 16 * 16 * 4);
+    const uint8_t* lastPage = atlas4.PixelData() + 3 * atlas4.PageByteSize();
+    CHECK((lastPage[0] == 0) && (lastPage[atlas4.PageByteSize() - 1] == 0));
+
+    // a cleared atlas starts over
+    atlas.Clear();
+    CHECK(atlas.NumPages() == 0);
+    CHECK(atlas.NumRegions() == 0);
+    int r2 = atlas.Add(64, 64);
+    CHECK((atlas.RegionAt(r2).X == 0) && (atlas.RegionAt(r2).Y == 0));
+}
+
+TEST(TextureAtlasPaddingTest) {
+    // an image which only fits without its padding next to a taller
+    // image must not be packed there (and must not shrink the skyline)
+    TextureAtlas atlas;
+    atlas.PageWidth = 10;
+    atlas.PageHeight = 10;
+    atlas.MaxNumPages = 1;
+    atlas.Padding = 1;
+    atlas.Setup();
+    CHECK(InvalidIndex != atlas.Add(3, 2));
+    CHECK(InvalidIndex != atlas.Add(5, 8));
+    CHECK(InvalidIndex == atlas.Add(4, 2));
+    CHECK(InvalidIndex != atlas.Add(3, 3));
+    atlas.Add(5, 3);
+    for (int i = 0; i < atlas.NumRegions(); i++) {
+        for (int j = i + 1; j < atlas.NumRegions(); j++) {
+            CHECK(!overlap(atlas.RegionAt(i), atlas.RegionAt(j), 0));
+        }
+    }
+
+    // random sizes on a small page, padding is kept except at the page border
+    atlas.PageWidth = 48;
+    atlas.PageHeight = 48;
+    atlas.MaxNumPages = 4;
+    atlas.Setup();
+    uint32_t rnd = 12345;
+    for (int i = 0; i < 200; i++) {
+        rnd = rnd * 1664525 + 1013904223;
+        const int w = 1 + int((rnd >> 8) % 13);
+        const int h = 1 + int((rnd >> 20) % 13);
+        atlas.Add(w, h);
+    }
+    CHECK(atlas.NumRegions() > 20);
+    for (int i = 0; i < atlas.NumRegions(); i++) {
+        const auto& ri = atlas.RegionAt(i);
+        CHECK((ri.X + ri.Width) <= 48);
+        CHECK((ri.Y + ri.Height) <= 48);
+        for (int j = i + 1; j < atlas.NumRegions(); j++) {
+            CHECK(!overlap(ri, atlas.RegionAt(j), 1));
+        }
+    }
+}
@@ -39,6 +39,18 @@
 #define ORYOL_MAX_PLATFORM_ALIGN (16)
 #endif
 
+// SIMD instruction set support (used for optional fast-paths)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ORYOL_HAS_SSE2 (1)
+#else
+#define ORYOL_HAS_SSE2 (0)
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ORYOL_HAS_NEON (1)
+#else
+#define ORYOL_HAS_NEON (0)
+#endif
+
 /// memory debug fill pattern (byte)
 #define ORYOL_MEMORY_DEBUG_BYTE (0xBB)
 /// memory debug fill pattern (short)
@@ -51,6 +63,9 @@
 /// maximum grow size for dynamic container classes (num elements)
 #define ORYOL_CONTAINER_DEFAULT_MAX_GROW (1<<16)
 
+/// allocations of at least this size go through Memory::AllocLarge() (Buffer and poolAllocator puddles)
+#define ORYOL_LARGE_ALLOC_THRESHOLD (1<<21)
+
 #ifndef __GNUC__
 #define __attribute__(x)
 #endif
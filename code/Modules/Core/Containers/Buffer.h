@@ -4,6 +4,9 @@
     @class Oryol::Buffer
     @ingroup Core
     @brief growable memory buffer for raw data
+
+    Buffers of at least ORYOL_LARGE_ALLOC_THRESHOLD bytes capacity
+    are allocated with Memory::AllocLarge().
 */
 #include "Core/Types.h"
 #include "Core/Assertion.h"
@@ -57,6 +60,10 @@ private:
     void destroy();
     /// append-copy content into currently allocated buffer, bump size
     void copy(const uint8_t* ptr, int numBytes);
+    /// allocate memory for a capacity
+    static void* allocData(int capacity);
+    /// free memory allocated with allocData()
+    static void freeData(void* ptr, int capacity);
 
     int size;
     int capacity;
@@ -95,23 +102,45 @@ Buffer::alloc(int newCapacity) {
     o_assert_dbg(newCapacity > this->capacity);
     o_assert_dbg(newCapacity > this->size);
 
-    uint8_t* newBuf = (uint8_t*) Memory::Alloc(newCapacity);
+    uint8_t* newBuf = (uint8_t*) allocData(newCapacity);
     if (this->size > 0) {
         o_assert_dbg(this->data);
         Memory::Copy(this->data, newBuf, this->size);
     }
     if (this->data) {
-        Memory::Free(this->data);
+        freeData(this->data, this->capacity);
     }
     this->data = newBuf;
     this->capacity = newCapacity;
 }
 
+//------------------------------------------------------------------------------
+inline void*
+Buffer::allocData(int capacity) {
+    if (capacity >= ORYOL_LARGE_ALLOC_THRESHOLD) {
+        return Memory::AllocLarge(capacity);
+    }
+    else {
+        return Memory::Alloc(capacity);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+Buffer::freeData(void* ptr, int capacity) {
+    if (capacity >= ORYOL_LARGE_ALLOC_THRESHOLD) {
+        Memory::FreeLarge(ptr);
+    }
+    else {
+        Memory::Free(ptr);
+    }
+}
+
 //------------------------------------------------------------------------------
 inline void
 Buffer::destroy() {
     if (this->data) {
-        Memory::Free(this->data);
+        freeData(this->data, this->capacity);
     }
     this->data = nullptr;
     this->size = 0;
@@ -11,6 +11,7 @@
     @see Map
 */
 #include "Core/Config.h"
+#include "Core/Containers/Relocatable.h"
 
 namespace Oryol {
 
@@ -226,4 +227,9 @@ template<class KEY, class VALUE> inline bool operator<=(const KEY& key, const Ke
     return key <= kvp.key;
 };
 
+/// key-value pairs are trivially relocatable if the key and value are
+template<class KEY, class VALUE> struct IsTriviallyRelocatable<KeyValuePair<KEY, VALUE>> {
+    static const bool Value = IsTriviallyRelocatable<KEY>::Value && IsTriviallyRelocatable<VALUE>::Value;
+};
+
 } // namespace Oryol
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::IsTriviallyRelocatable
+    @ingroup Core
+    @brief type trait for types which can be moved in memory with memcpy
+
+    A type is trivially relocatable if moving an object to a new address
+    and destroying the source is equivalent to copying its bytes, which is
+    true for all types which don't store pointers into themselves and
+    aren't tracked by address. Container classes move such elements with
+    realloc() and memmove() instead of move-constructing and destroying
+    each element when they grow, insert or erase.
+
+    Trivially copyable types are relocatable automatically, other types
+    opt in with ORYOL_TRIVIALLY_RELOCATABLE(type), or with a partial
+    specialization for class templates.
+*/
+#include <type_traits>
+
+namespace Oryol {
+
+template<class TYPE> struct IsTriviallyRelocatable {
+    static const bool Value = std::is_trivially_copyable<TYPE>::value;
+};
+
+} // namespace Oryol
+
+/// declare a (non-template) type as trivially relocatable, must be used outside of any namespace
+#define ORYOL_TRIVIALLY_RELOCATABLE(TYPE) \
+namespace Oryol { \
+template<> struct IsTriviallyRelocatable<TYPE> { static const bool Value = true; }; \
+}
@@ -0,0 +1,224 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::SharedBuffer
+    @ingroup Core
+    @brief ref-counted, immutable view on a chunk of raw data
+
+    A SharedBuffer is a cheap-to-copy, read-only view on a shared
+    payload. Copying a SharedBuffer only bumps a reference count,
+    and Slice() returns a view on a sub-range of the same payload
+    without copying any data. The payload is destroyed when the
+    last SharedBuffer referencing it goes away.
+
+    A SharedBuffer can take ownership of a Buffer (move-construct), or
+    wrap externally owned memory (e.g. mmap'ed files or arena memory)
+    with an optional custom deleter function which is called when
+    the last reference goes away.
+
+    @see Buffer
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include "Core/RefCounted.h"
+#include "Core/Containers/Buffer.h"
+#include <functional>
+
+namespace Oryol {
+
+namespace _priv {
+class sharedBufferPayload : public RefCounted {
+    OryolClassDecl(sharedBufferPayload);
+public:
+    /// deleter function for externally owned memory
+    typedef std::function<void(const uint8_t* ptr, int numBytes)> deleterFunc;
+    /// take ownership of a Buffer
+    sharedBufferPayload(Buffer&& buf) :
+        buffer(std::move(buf)),
+        ptr(this->buffer.Empty() ? nullptr : this->buffer.Data()),
+        size(this->buffer.Size()) { };
+    /// wrap external memory
+    sharedBufferPayload(const uint8_t* ptr_, int size_, deleterFunc deleter_) :
+        ptr(ptr_),
+        size(size_),
+        deleter(deleter_) { };
+    /// destructor, calls deleter function if external memory
+    ~sharedBufferPayload() {
+        if (this->deleter) {
+            this->deleter(this->ptr, this->size);
+        }
+    };
+
+    Buffer buffer;
+    const uint8_t* ptr = nullptr;
+    int size = 0;
+    deleterFunc deleter;
+};
+} // namespace _priv
+
+class SharedBuffer {
+public:
+    /// deleter function typedef for wrapped memory
+    typedef _priv::sharedBufferPayload::deleterFunc DeleterFunc;
+
+    /// default constructor
+    SharedBuffer();
+    /// take ownership of a Buffer object (no copy)
+    explicit SharedBuffer(Buffer&& buf);
+    /// copy constructor (increments ref-count)
+    SharedBuffer(const SharedBuffer& rhs);
+    /// move constructor
+    SharedBuffer(SharedBuffer&& rhs);
+
+    /// copy-assignment (increments ref-count)
+    void operator=(const SharedBuffer& rhs);
+    /// move-assignment
+    void operator=(SharedBuffer&& rhs);
+
+    /// wrap external memory, deleter will be called when last reference goes away
+    static SharedBuffer Wrap(const void* ptr, int numBytes, DeleterFunc deleter=DeleterFunc());
+    /// create a SharedBuffer with a copy of the provided data
+    static SharedBuffer Copy(const void* ptr, int numBytes);
+
+    /// get number of bytes in view
+    int Size() const;
+    /// return true if the view is empty
+    bool Empty() const;
+    /// get read-only pointer to start of view (throws assert if would return nullptr)
+    const uint8_t* Data() const;
+    /// get a view on a sub-range, O(1), shares the same payload
+    SharedBuffer Slice(int offset, int numBytes=EndOfFile) const;
+    /// get number of SharedBuffer objects referencing the same payload
+    int UseCount() const;
+    /// release reference to the payload
+    void Clear();
+
+private:
+    Ptr<_priv::sharedBufferPayload> payload;
+    int offset;
+    int size;
+};
+
+//------------------------------------------------------------------------------
+inline
+SharedBuffer::SharedBuffer() :
+offset(0),
+size(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+inline
+SharedBuffer::SharedBuffer(Buffer&& buf) :
+offset(0),
+size(buf.Size()) {
+    if (this->size > 0) {
+        this->payload = _priv::sharedBufferPayload::Create(std::move(buf));
+    }
+}
+
+//------------------------------------------------------------------------------
+inline
+SharedBuffer::SharedBuffer(const SharedBuffer& rhs) :
+payload(rhs.payload),
+offset(rhs.offset),
+size(rhs.size) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+inline
+SharedBuffer::SharedBuffer(SharedBuffer&& rhs) :
+payload(std::move(rhs.payload)),
+offset(rhs.offset),
+size(rhs.size) {
+    rhs.offset = 0;
+    rhs.size = 0;
+}
+
+//------------------------------------------------------------------------------
+inline void
+SharedBuffer::operator=(const SharedBuffer& rhs) {
+    this->payload = rhs.payload;
+    this->offset = rhs.offset;
+    this->size = rhs.size;
+}
+
+//------------------------------------------------------------------------------
+inline void
+SharedBuffer::operator=(SharedBuffer&& rhs) {
+    this->payload = std::move(rhs.payload);
+    this->offset = rhs.offset;
+    this->size = rhs.size;
+    rhs.offset = 0;
+    rhs.size = 0;
+}
+
+//------------------------------------------------------------------------------
+inline SharedBuffer
+SharedBuffer::Wrap(const void* ptr, int numBytes, DeleterFunc deleter) {
+    o_assert_dbg(ptr && (numBytes >= 0));
+    SharedBuffer result;
+    result.payload = _priv::sharedBufferPayload::Create((const uint8_t*)ptr, numBytes, deleter);
+    result.size = numBytes;
+    return result;
+}
+
+//------------------------------------------------------------------------------
+inline SharedBuffer
+SharedBuffer::Copy(const void* ptr, int numBytes) {
+    o_assert_dbg(ptr && (numBytes >= 0));
+    Buffer buf;
+    buf.Add((const uint8_t*)ptr, numBytes);
+    return SharedBuffer(std::move(buf));
+}
+
+//------------------------------------------------------------------------------
+inline int
+SharedBuffer::Size() const {
+    return this->size;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+SharedBuffer::Empty() const {
+    return 0 == this->size;
+}
+
+//------------------------------------------------------------------------------
+inline const uint8_t*
+SharedBuffer::Data() const {
+    o_assert(this->payload && this->payload->ptr);
+    return this->payload->ptr + this->offset;
+}
+
+//------------------------------------------------------------------------------
+inline SharedBuffer
+SharedBuffer::Slice(int sliceOffset, int numBytes) const {
+    if (EndOfFile == numBytes) {
+        numBytes = this->size - sliceOffset;
+    }
+    o_assert((sliceOffset >= 0) && (numBytes >= 0));
+    o_assert((sliceOffset + numBytes) <= this->size);
+    SharedBuffer result;
+    result.payload = this->payload;
+    result.offset = this->offset + sliceOffset;
+    result.size = numBytes;
+    return result;
+}
+
+//------------------------------------------------------------------------------
+inline int
+SharedBuffer::UseCount() const {
+    return this->payload ? this->payload->GetRefCount() : 0;
+}
+
+//------------------------------------------------------------------------------
+inline void
+SharedBuffer::Clear() {
+    this->payload = nullptr;
+    this->offset = 0;
+    this->size = 0;
+}
+
+} // namespace Oryol
@@ -18,12 +18,17 @@
     
     '----' - empty memory slot (guaranteed to be destructed)
     'XXXX' - valid element (guaranteed to be constructed)
+
+    Elements of trivially relocatable types (see IsTriviallyRelocatable)
+    are moved around with realloc and memmove instead of
+    move-construction/assignment.
 */
 #include <new>
 #include <utility>
 #include "Core/Types.h"
 #include "Core/Assertion.h"
 #include "Core/Memory/Memory.h"
+#include "Core/Containers/Relocatable.h"
 
 //------------------------------------------------------------------------------
 namespace Oryol {
@@ -119,6 +124,8 @@ public:
     /// erase element at index, always swap-in element from the front
     void eraseSwapFront(int index);
     
+    /// move element from src over element at dst, and destroy src
+    static void moveOver(TYPE* src, TYPE* dst);
     /// move elements towards front for insertion, return pointer to free insertion slot
     TYPE* moveInsertFront(int index);
     /// move elements towards end for insertion, return pointer to free insertion slot
@@ -303,9 +310,27 @@ elementBuffer<TYPE>::alloc(int newCapacity, int newStart) {
     }
     const int curSize = this->size();
     o_assert_dbg((newStart + curSize) <= newCapacity);
+    const int newBufSize = newCapacity * sizeof(TYPE);
+
+    // trivially relocatable elements are moved by realloc, when
+    // shrinking, the elements must be moved before the realloc, when
+    // growing, after the realloc
+    if (IsTriviallyRelocatable<TYPE>::Value && (nullptr != this->buf)) {
+        const bool shrink = newCapacity < this->cap;
+        if (shrink && (newStart != this->start) && (curSize > 0)) {
+            Memory::Move(&this->buf[this->start], &this->buf[newStart], curSize * sizeof(TYPE));
+        }
+        this->buf = (TYPE*) Memory::ReAlloc(this->buf, newBufSize);
+        if (!shrink && (newStart != this->start) && (curSize > 0)) {
+            Memory::Move(&this->buf[this->start], &this->buf[newStart], curSize * sizeof(TYPE));
+        }
+        this->cap   = newCapacity;
+        this->start = newStart;
+        this->end   = newStart + curSize;
+        return;
+    }
 
     // allocate new buffer
-    const int newBufSize = newCapacity * sizeof(TYPE);
     TYPE* newBuffer = (TYPE*) Memory::Alloc(newBufSize);
     TYPE* newElmStart = newBuffer + newStart;
     
@@ -445,15 +470,34 @@ elementBuffer<TYPE>::emplaceFront(ARGS&&... args) {
     new(&this->buf[--this->start]) TYPE(std::forward<ARGS>(args)...);
 }
 
+//------------------------------------------------------------------------------
+template<class TYPE> void
+elementBuffer<TYPE>::moveOver(TYPE* src, TYPE* dst) {
+    if (IsTriviallyRelocatable<TYPE>::Value) {
+        dst->~TYPE();
+        Memory::Copy(src, dst, sizeof(TYPE));
+    }
+    else {
+        *dst = std::move(*src);
+        src->~TYPE();
+    }
+}
+
 //------------------------------------------------------------------------------
 template<class TYPE> TYPE*
 elementBuffer<TYPE>::moveInsertFront(int index) {
     // free a slot for insertion by moving the elements
     // at and before it towards the front
-    // the freed slot will NOT be deconstructed!
+    // the freed slot will NOT be deconstructed, unless
+    // the element type is trivially relocatable!
     o_assert_dbg(this->buf && (this->start > 0));
     o_assert_dbg((index >= 0) && (index <= this->size()));
-    
+
+    if (IsTriviallyRelocatable<TYPE>::Value) {
+        Memory::Move(&this->buf[this->start], &this->buf[this->start - 1], index * sizeof(TYPE));
+        this->start--;
+        return &this->buf[this->start + index];
+    }
     new(&this->buf[this->start-1]) TYPE(std::move(this->buf[start]));
     for (int i = this->start; i < (this->start + index - 1); i++) {
         this->buf[i] = std::move(this->buf[i+1]);
@@ -467,10 +511,17 @@ template<class TYPE> TYPE*
 elementBuffer<TYPE>::moveInsertBack(int index) {
     // free a slot for insertion by moving the elements
     // after it towards the back
-    // the freed slot will NOT be deconstructed!
+    // the freed slot will NOT be deconstructed, unless
+    // the element type is trivially relocatable!
     o_assert_dbg(this->buf && (this->end > 0) && (this->end < this->cap));
     o_assert_dbg((index >= 0) && (index < this->size()));
-    
+
+    if (IsTriviallyRelocatable<TYPE>::Value) {
+        TYPE* ptr = &this->buf[this->start + index];
+        Memory::Move(ptr, ptr + 1, (this->size() - index) * sizeof(TYPE));
+        this->end++;
+        return ptr;
+    }
     new(&this->buf[this->end]) TYPE(std::move(this->buf[this->end-1]));
     for (int i = this->end - 1; i > (this->start + index); i--) {
         this->buf[i] = std::move(this->buf[i-1]);
@@ -484,6 +535,12 @@ template<class TYPE> void
 elementBuffer<TYPE>::moveEraseFront(int index) {
     // erase a slot by moving elements from the front
     o_assert_dbg(this->buf && (index >= 0) && (index < this->size()));
+    if (IsTriviallyRelocatable<TYPE>::Value) {
+        this->buf[this->start + index].~TYPE();
+        Memory::Move(&this->buf[this->start], &this->buf[this->start + 1], index * sizeof(TYPE));
+        this->start++;
+        return;
+    }
     for (int i = this->start + index; i > this->start; i--) {
         this->buf[i] = std::move(this->buf[i - 1]);
     }
@@ -496,6 +553,13 @@ template<class TYPE> void
 elementBuffer<TYPE>::moveEraseBack(int index) {
     // erase a slot by moving elements from the back
     o_assert_dbg(this->buf && (index >= 0) && (index < this->size()));
+    if (IsTriviallyRelocatable<TYPE>::Value) {
+        TYPE* ptr = &this->buf[this->start + index];
+        ptr->~TYPE();
+        Memory::Move(ptr + 1, ptr, (this->size() - index - 1) * sizeof(TYPE));
+        this->end--;
+        return;
+    }
     for (int i = this->start + index; i < (this->end - 1); i++) {
         this->buf[i] = std::move(this->buf[i + 1]);
     }
@@ -509,7 +573,9 @@ elementBuffer<TYPE>::prepareInsert(int index, bool& outSlotConstructed) {
 
     // this method will return a pointer to an empty, destructed slot!
 
-    outSlotConstructed = true;
+    // moving elements leaves a constructed slot behind, except for
+    // trivially relocatable elements
+    outSlotConstructed = !IsTriviallyRelocatable<TYPE>::Value;
     const int size = this->size();
     if (index == size) {
         // special case insert at end of array
@@ -596,7 +662,7 @@ elementBuffer<TYPE>::insert(int index, TYPE&& elm) {
     bool slotConstructed = true;
     TYPE* ptr = this->prepareInsert(index, slotConstructed);
     if (slotConstructed) {
-        *ptr = elm;
+        *ptr = std::move(elm);
     }
     else {
         new(ptr) TYPE(std::move(elm));
@@ -648,13 +714,12 @@ elementBuffer<TYPE>::eraseSwap(int index) {
         // either swap in the first or last element (keep frontSpare and backSpare balanced)
         if (this->frontSpare() > this->backSpare()) {
             // swap-in element from back
-            this->buf[this->start + index] = std::move(this->buf[--this->end]);
-            this->buf[this->end].~TYPE();
+            moveOver(&this->buf[--this->end], &this->buf[this->start + index]);
         }
         else {
             // swap-in element from front
-            this->buf[this->start + index] = std::move(this->buf[this->start]);
-            this->buf[this->start++].~TYPE();
+            moveOver(&this->buf[this->start], &this->buf[this->start + index]);
+            this->start++;
         }
     }
 }
@@ -670,8 +735,7 @@ elementBuffer<TYPE>::eraseSwapBack(int index) {
     }
     else {
         // swap-in element from back
-        this->buf[this->start + index] = std::move(this->buf[--this->end]);
-        this->buf[this->end].~TYPE();
+        moveOver(&this->buf[--this->end], &this->buf[this->start + index]);
     }
 }
 
@@ -685,8 +749,8 @@ elementBuffer<TYPE>::eraseSwapFront(int index) {
     }
     else {
         // swap-in element from front
-        this->buf[this->start + index] = std::move(this->buf[this->start]);
-        this->buf[this->start++].~TYPE();
+        moveOver(&this->buf[this->start], &this->buf[this->start + index]);
+        this->start++;
     }
 }
 
@@ -22,6 +22,7 @@ Core::Setup() {
     state->mainThreadId = std::this_thread::get_id();
     threadPreRunLoop = Memory::New<RunLoop>();
     threadPostRunLoop = Memory::New<RunLoop>();
+    state->mainRunLoop = threadPreRunLoop;
 }
 
 //------------------------------------------------------------------------------
@@ -61,6 +62,17 @@ Core::PostRunLoop() {
     return threadPostRunLoop;
 }
 
+//------------------------------------------------------------------------------
+/**
+    NOTE: this may be called from any thread, but only Post() may be
+    called on the returned run loop from threads other than the main thread.
+*/
+RunLoop*
+Core::MainRunLoop() {
+    o_assert_dbg(IsValid());
+    return state->mainRunLoop;
+}
+
 //------------------------------------------------------------------------------
 bool
 Core::IsMainThread() {
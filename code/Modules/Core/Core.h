@@ -30,6 +30,8 @@ public:
     static class RunLoop* PreRunLoop();
     /// get pointer to the per-thread 'after-frame' runloop
     static class RunLoop* PostRunLoop();
+    /// get pointer to the main thread's 'before-frame' runloop (for posting from other threads)
+    static class RunLoop* MainRunLoop();
 
     /// called when a thread is entered
     static void EnterThread();
@@ -43,6 +45,7 @@ private:
     static ORYOL_THREADLOCAL_PTR(RunLoop) threadPostRunLoop;
     struct _state {
         std::thread::id mainThreadId;
+        RunLoop* mainRunLoop = nullptr;
         #if ORYOL_PROFILING
         Trace trace;
         #endif
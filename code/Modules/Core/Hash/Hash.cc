@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+//  Hash.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Hash.h"
+#include "Core/Assertion.h"
+
+namespace Oryol {
+
+const uint64_t Hash::secret[4] = {
+    0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL
+};
+
+//------------------------------------------------------------------------------
+uint64_t
+Hash::Bytes(const void* ptr, int numBytes, uint64_t seed) {
+    o_assert_dbg(ptr || (0 == numBytes));
+    o_assert_dbg(numBytes >= 0);
+    const uint8_t* p = (const uint8_t*) ptr;
+    const uint64_t len = uint64_t(numBytes);
+    seed ^= mix(seed ^ secret[0], secret[1]);
+    uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (r4(p) << 32) | r4(p + ((len >> 3) << 2));
+            b = (r4(p + len - 4) << 32) | r4(p + len - 4 - ((len >> 3) << 2));
+        }
+        else if (len > 0) {
+            a = r3(p, int(len));
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        uint64_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = mix(r8(p) ^ secret[1], r8(p + 8) ^ seed);
+                see1 = mix(r8(p + 16) ^ secret[2], r8(p + 24) ^ see1);
+                see2 = mix(r8(p + 32) ^ secret[3], r8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            }
+            while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mix(r8(p) ^ secret[1], r8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = r8(p + i - 16);
+        b = r8(p + i - 8);
+    }
+    a ^= secret[1];
+    b ^= seed;
+    mum(a, b);
+    return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+Hash::CStr(const char* str, uint64_t seed) {
+    o_assert_dbg(str);
+    return Bytes(str, int(std::strlen(str)), seed);
+}
+
+//------------------------------------------------------------------------------
+HashBuilder::HashBuilder(uint64_t seed_) {
+    this->Reset(seed_);
+}
+
+//------------------------------------------------------------------------------
+void
+HashBuilder::Reset(uint64_t seed_) {
+    this->seed = seed_ ^ Hash::mix(seed_ ^ Hash::secret[0], Hash::secret[1]);
+    this->see1 = this->seed;
+    this->see2 = this->seed;
+    this->totalBytes = 0;
+    this->blocksProcessed = false;
+    this->numPending = 0;
+}
+
+//------------------------------------------------------------------------------
+void
+HashBuilder::processBlock(const uint8_t* p) {
+    this->seed = Hash::mix(Hash::r8(p) ^ Hash::secret[1], Hash::r8(p + 8) ^ this->seed);
+    this->see1 = Hash::mix(Hash::r8(p + 16) ^ Hash::secret[2], Hash::r8(p + 24) ^ this->see1);
+    this->see2 = Hash::mix(Hash::r8(p + 32) ^ Hash::secret[3], Hash::r8(p + 40) ^ this->see2);
+    this->blocksProcessed = true;
+}
+
+//------------------------------------------------------------------------------
+/**
+    A 48-byte block is only processed once it is known that more data
+    follows, since Hash::Bytes() treats the last (up to) 48 bytes
+    differently.
+*/
+void
+HashBuilder::Add(const void* ptr, int numBytes) {
+    o_assert_dbg(ptr || (0 == numBytes));
+    o_assert_dbg(numBytes >= 0);
+    const uint8_t* p = (const uint8_t*) ptr;
+    this->totalBytes += numBytes;
+    uint8_t* pending = this->buf + HistorySize;
+    while (numBytes > 0) {
+        if (BlockSize == this->numPending) {
+            this->processBlock(pending);
+            std::memcpy(this->buf, pending + BlockSize - HistorySize, HistorySize);
+            this->numPending = 0;
+        }
+        if ((0 == this->numPending) && (numBytes > BlockSize)) {
+            // fast path: process blocks directly from source data
+            do {
+                this->processBlock(p);
+                p += BlockSize;
+                numBytes -= BlockSize;
+            }
+            while (numBytes > BlockSize);
+            std::memcpy(this->buf, p - HistorySize, HistorySize);
+        }
+        const int num = (BlockSize - this->numPending) < numBytes ? (BlockSize - this->numPending) : numBytes;
+        std::memcpy(pending + this->numPending, p, num);
+        this->numPending += num;
+        p += num;
+        numBytes -= num;
+    }
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+HashBuilder::Result() const {
+    const uint64_t len = this->totalBytes;
+    const uint8_t* p = this->buf + HistorySize;
+    uint64_t s = this->seed;
+    uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (Hash::r4(p) << 32) | Hash::r4(p + ((len >> 3) << 2));
+            b = (Hash::r4(p + len - 4) << 32) | Hash::r4(p + len - 4 - ((len >> 3) << 2));
+        }
+        else if (len > 0) {
+            a = Hash::r3(p, int(len));
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        if (this->blocksProcessed) {
+            s ^= this->see1 ^ this->see2;
+        }
+        // NOTE: the last 16-byte read may reach back into the history bytes
+        int i = this->numPending;
+        while (i > 16) {
+            s = Hash::mix(Hash::r8(p) ^ Hash::secret[1], Hash::r8(p + 8) ^ s);
+            i -= 16;
+            p += 16;
+        }
+        a = Hash::r8(p + i - 16);
+        b = Hash::r8(p + i - 8);
+    }
+    a ^= Hash::secret[1];
+    b ^= s;
+    Hash::mum(a, b);
+    return Hash::mix(a ^ Hash::secret[0] ^ len, b ^ Hash::secret[1]);
+}
+
+} // namespace Oryol
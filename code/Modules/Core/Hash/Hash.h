@@ -0,0 +1,226 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @defgroup Hash Hash
+    @brief fast hash functions for hash containers and content hashing
+
+    @class Oryol::Hash
+    @ingroup Hash
+    @brief general purpose 64-bit hash functions
+
+    Hash::Bytes() is a fast, high-quality 64-bit hash for byte ranges
+    (this is wyhash, final version 4), use HashBuilder to hash data
+    which isn't in one contiguous chunk of memory (both produce the
+    same hash for the same byte sequence). Hash::Literal() is a
+    constexpr FNV-1a hash for string literals which can be evaluated
+    at compile time (e.g. for switch-case labels), note that it
+    produces different hashes than Hash::Bytes()!
+
+    NOTE: hash values are only stable on little-endian platforms.
+
+    @see HashBuilder, HashTraits
+*/
+#include "Core/Types.h"
+#include "Core/String/String.h"
+#include "Core/String/StringAtom.h"
+#include <cstring>
+#include <type_traits>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace Oryol {
+
+class Hash {
+public:
+    /// hash a range of bytes
+    static uint64_t Bytes(const void* ptr, int numBytes, uint64_t seed=0);
+    /// hash a null-terminated string
+    static uint64_t CStr(const char* str, uint64_t seed=0);
+    /// mix a 64-bit integer (fast, for integer keys)
+    static uint64_t Mix(uint64_t val);
+    /// combine 2 hash values (order-dependent)
+    static uint64_t Combine(uint64_t h0, uint64_t h1);
+    /// compile-time FNV-1a hash of a string literal
+    static constexpr uint64_t Literal(const char* str, uint64_t h=0xcbf29ce484222325ULL) {
+        return *str ? Literal(str + 1, (h ^ uint64_t(uint8_t(*str))) * 0x100000001b3ULL) : h;
+    };
+
+private:
+    friend class HashBuilder;
+    /// multiply 2 64-bit values into a 128-bit result (lo in a, hi in b)
+    static void mum(uint64_t& a, uint64_t& b);
+    /// multiply and fold
+    static uint64_t mix(uint64_t a, uint64_t b);
+    /// read 8 bytes
+    static uint64_t r8(const uint8_t* p);
+    /// read 4 bytes
+    static uint64_t r4(const uint8_t* p);
+    /// read 1..3 bytes
+    static uint64_t r3(const uint8_t* p, int k);
+
+    /// the wyhash secret
+    static const uint64_t secret[4];
+};
+
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::HashBuilder
+    @ingroup Hash
+    @brief incrementally compute the hash of a sequence of data chunks
+
+    The result is identical with calling Hash::Bytes() on the
+    concatenated data.
+*/
+class HashBuilder {
+public:
+    /// constructor
+    HashBuilder(uint64_t seed=0);
+    /// reset to initial state
+    void Reset(uint64_t seed=0);
+    /// add a range of bytes
+    void Add(const void* ptr, int numBytes);
+    /// add the raw bytes of a value (only use for types without padding)
+    template<class TYPE> void AddValue(const TYPE& val);
+    /// get the hash of all data added so far
+    uint64_t Result() const;
+
+private:
+    /// process a complete 48-byte block
+    void processBlock(const uint8_t* p);
+
+    static const int BlockSize = 48;
+    static const int HistorySize = 16;
+    uint64_t seed;
+    uint64_t see1;
+    uint64_t see2;
+    uint64_t totalBytes;
+    bool blocksProcessed;
+    int numPending;
+    // the last 16 processed bytes, followed by up to 48 pending bytes
+    uint8_t buf[HistorySize + BlockSize];
+};
+
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::HashTraits
+    @ingroup Hash
+    @brief compute the 64-bit hash of a value
+
+    The default implementation hashes the raw bytes of the object
+    (only use for types without padding), integers, enums and pointers
+    use Hash::Mix(). Specialize HashTraits for your own types.
+*/
+template<class TYPE, class ENABLE=void> struct HashTraits {
+    static uint64_t Compute(const TYPE& val) {
+        return Hash::Bytes(&val, int(sizeof(val)));
+    };
+};
+
+template<class TYPE> struct HashTraits<TYPE, typename std::enable_if<std::is_integral<TYPE>::value || std::is_enum<TYPE>::value>::type> {
+    static uint64_t Compute(const TYPE& val) {
+        return Hash::Mix(uint64_t(val));
+    };
+};
+
+template<class TYPE> struct HashTraits<TYPE*> {
+    static uint64_t Compute(TYPE* const& val) {
+        return Hash::Mix(uint64_t(uintptr_t(val)));
+    };
+};
+
+template<> struct HashTraits<String> {
+    static uint64_t Compute(const String& str) {
+        return Hash::Bytes(str.AsCStr(), str.Length());
+    };
+};
+
+template<> struct HashTraits<StringAtom> {
+    static uint64_t Compute(const StringAtom& str) {
+        return Hash::Bytes(str.AsCStr(), str.Length());
+    };
+};
+
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::HashFunc
+    @ingroup Hash
+    @brief hash functor based on HashTraits, can be used as HASHER in HashSet
+*/
+template<class TYPE> struct HashFunc {
+    int32_t operator()(const TYPE& val) const {
+        return int32_t(HashTraits<TYPE>::Compute(val));
+    };
+};
+
+//------------------------------------------------------------------------------
+inline void
+Hash::mum(uint64_t& a, uint64_t& b) {
+    #if defined(__SIZEOF_INT128__)
+    __uint128_t r = a;
+    r *= b;
+    a = uint64_t(r);
+    b = uint64_t(r >> 64);
+    #elif defined(_MSC_VER) && defined(_M_X64)
+    a = _umul128(a, b, &b);
+    #else
+    // portable version for 32-bit platforms
+    const uint64_t ha = a >> 32, hb = b >> 32, la = uint32_t(a), lb = uint32_t(b);
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    const uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    a = lo;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+inline uint64_t
+Hash::mix(uint64_t a, uint64_t b) {
+    mum(a, b);
+    return a ^ b;
+}
+
+//------------------------------------------------------------------------------
+inline uint64_t
+Hash::r8(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+//------------------------------------------------------------------------------
+inline uint64_t
+Hash::r4(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+//------------------------------------------------------------------------------
+inline uint64_t
+Hash::r3(const uint8_t* p, int k) {
+    return (uint64_t(p[0]) << 16) | (uint64_t(p[k >> 1]) << 8) | p[k - 1];
+}
+
+//------------------------------------------------------------------------------
+inline uint64_t
+Hash::Mix(uint64_t val) {
+    return mix(val ^ secret[0], secret[1]);
+}
+
+//------------------------------------------------------------------------------
+inline uint64_t
+Hash::Combine(uint64_t h0, uint64_t h1) {
+    return mix(h0 ^ secret[2], h1 ^ secret[3]);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> inline void
+HashBuilder::AddValue(const TYPE& val) {
+    this->Add(&val, int(sizeof(val)));
+}
+
+} // namespace Oryol
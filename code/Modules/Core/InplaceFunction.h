@@ -0,0 +1,178 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::InplaceFunction
+    @ingroup Core
+    @brief move-only std::function replacement which never allocates
+
+    InplaceFunction<void(int), 32> stores a callable object (usually a
+    lambda) in a fixed-size inline buffer of N bytes. Unlike std::function,
+    constructing an InplaceFunction never allocates, a callable which
+    doesn't fit into the buffer is a compile error (increase N or
+    capture less, e.g. a pointer to a struct instead of the struct).
+
+    InplaceFunction objects can be moved but not copied, so the
+    captured objects don't need to be copyable.
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <new>
+
+namespace Oryol {
+
+template<class SIGNATURE, int N=64> class InplaceFunction;
+
+template<class RETURN, class... ARGS, int N>
+class InplaceFunction<RETURN(ARGS...), N> {
+public:
+    /// default constructor, creates an empty function
+    InplaceFunction();
+    /// construct empty function from nullptr
+    InplaceFunction(std::nullptr_t);
+    /// construct from callable object
+    template<class FUNC, class=typename std::enable_if<!std::is_same<typename std::decay<FUNC>::type, InplaceFunction>::value>::type>
+    InplaceFunction(FUNC&& func);
+    /// move constructor
+    InplaceFunction(InplaceFunction&& rhs);
+    /// destructor
+    ~InplaceFunction();
+
+    /// move-assignment
+    void operator=(InplaceFunction&& rhs);
+    /// clear the function
+    void operator=(std::nullptr_t);
+    /// return true if the function is not empty
+    explicit operator bool() const;
+    /// call the function
+    RETURN operator()(ARGS... args) const;
+
+    /// copying is not allowed
+    InplaceFunction(const InplaceFunction&) = delete;
+    void operator=(const InplaceFunction&) = delete;
+
+private:
+    /// destroy the callable object
+    void clear();
+    /// move callable object from other function
+    void move(InplaceFunction& rhs);
+
+    /// call the callable object in storage
+    template<class FUNC> static RETURN invokeFunc(void* obj, ARGS&&... args);
+    /// move-construct callable object at dst and destroy src, or only destroy src if dst is nullptr
+    template<class FUNC> static void manageFunc(void* dst, void* src);
+
+    typedef RETURN (*invoker)(void* obj, ARGS&&... args);
+    typedef void (*manager)(void* dst, void* src);
+    invoker invokePtr = nullptr;
+    manager managePtr = nullptr;
+    mutable typename std::aligned_storage<N, alignof(std::max_align_t)>::type storage;
+};
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N>
+InplaceFunction<RETURN(ARGS...), N>::InplaceFunction() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N>
+InplaceFunction<RETURN(ARGS...), N>::InplaceFunction(std::nullptr_t) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N>
+template<class FUNC, class>
+InplaceFunction<RETURN(ARGS...), N>::InplaceFunction(FUNC&& func) {
+    typedef typename std::decay<FUNC>::type funcType;
+    static_assert(sizeof(funcType) <= N, "InplaceFunction: callable object too big, increase N!");
+    static_assert(alignof(funcType) <= alignof(std::max_align_t), "InplaceFunction: callable object over-aligned!");
+    new(&this->storage) funcType(std::forward<FUNC>(func));
+    this->invokePtr = &invokeFunc<funcType>;
+    this->managePtr = &manageFunc<funcType>;
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N>
+InplaceFunction<RETURN(ARGS...), N>::InplaceFunction(InplaceFunction&& rhs) {
+    this->move(rhs);
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N>
+InplaceFunction<RETURN(ARGS...), N>::~InplaceFunction() {
+    this->clear();
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N> void
+InplaceFunction<RETURN(ARGS...), N>::operator=(InplaceFunction&& rhs) {
+    if (&rhs != this) {
+        this->clear();
+        this->move(rhs);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N> void
+InplaceFunction<RETURN(ARGS...), N>::operator=(std::nullptr_t) {
+    this->clear();
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N>
+InplaceFunction<RETURN(ARGS...), N>::operator bool() const {
+    return nullptr != this->invokePtr;
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N> RETURN
+InplaceFunction<RETURN(ARGS...), N>::operator()(ARGS... args) const {
+    o_assert_dbg(this->invokePtr);
+    return this->invokePtr(&this->storage, std::forward<ARGS>(args)...);
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N> void
+InplaceFunction<RETURN(ARGS...), N>::clear() {
+    if (this->managePtr) {
+        this->managePtr(nullptr, &this->storage);
+        this->invokePtr = nullptr;
+        this->managePtr = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N> void
+InplaceFunction<RETURN(ARGS...), N>::move(InplaceFunction& rhs) {
+    if (rhs.managePtr) {
+        rhs.managePtr(&this->storage, &rhs.storage);
+        this->invokePtr = rhs.invokePtr;
+        this->managePtr = rhs.managePtr;
+        rhs.invokePtr = nullptr;
+        rhs.managePtr = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N>
+template<class FUNC> RETURN
+InplaceFunction<RETURN(ARGS...), N>::invokeFunc(void* obj, ARGS&&... args) {
+    return (*static_cast<FUNC*>(obj))(std::forward<ARGS>(args)...);
+}
+
+//------------------------------------------------------------------------------
+template<class RETURN, class... ARGS, int N>
+template<class FUNC> void
+InplaceFunction<RETURN(ARGS...), N>::manageFunc(void* dst, void* src) {
+    FUNC* srcFunc = static_cast<FUNC*>(src);
+    if (dst) {
+        new(dst) FUNC(std::move(*srcFunc));
+    }
+    srcFunc->~FUNC();
+}
+
+} // namespace Oryol
@@ -1,64 +1,282 @@
-//------------------------------------------------------------------------------
-//  Memory.cc
-//------------------------------------------------------------------------------
-#include <memory>
-#include <cstdlib>
-#include <cstring>
-#include "Memory.h"
-#if ORYOL_USE_VLD
-#include "vld.h"
-#endif
-
-namespace Oryol {
-    
-//------------------------------------------------------------------------------
-void*
-Memory::Alloc(int numBytes) {
-    void* ptr = std::malloc(numBytes);
-#if ORYOL_ALLOCATOR_DEBUG || ORYOL_UNITTESTS
-    Memory::Fill(ptr, numBytes, ORYOL_MEMORY_DEBUG_BYTE);
-#endif
-    return ptr;
-}
-
-//------------------------------------------------------------------------------
-void
-Memory::Fill(void* ptr, int numBytes, uint8_t value) {
-    std::memset(ptr, value, numBytes);
-}
-
-//------------------------------------------------------------------------------
-void*
-Memory::ReAlloc(void* ptr, int s) {
-    /// @todo: HMM need to fix fill with debug pattern...
-    return std::realloc(ptr, s);
-}
-
-//------------------------------------------------------------------------------
-void
-Memory::Free(void* p) {
-    std::free(p);
-}
-
-//------------------------------------------------------------------------------
-void
-Memory::Copy(const void* from, void* to, int numBytes) {
-    std::memcpy(to, from, numBytes);
-}
-
-//------------------------------------------------------------------------------
-void
-Memory::Move(const void* from, void* to, int numBytes) {
-    std::memmove(to, from, numBytes);
-}
-
-//------------------------------------------------------------------------------
-void
-Memory::Clear(void* ptr, int numBytes) {
-    std::memset(ptr, 0, numBytes);
-}
-
-} // namespace Oryol
-
-
-
+//------------------------------------------------------------------------------
+//  Memory.cc
+//------------------------------------------------------------------------------
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+#include "Memory.h"
+#include "Core/Assertion.h"
+#if ORYOL_USE_VLD
+#include "vld.h"
+#endif
+#if ORYOL_HAS_ATOMIC
+#include <atomic>
+#endif
+#if ORYOL_HAS_THREADS
+#include <mutex>
+#endif
+#if ORYOL_POSIX && !ORYOL_EMSCRIPTEN && !ORYOL_PNACL
+#include <sys/mman.h>
+#include <unistd.h>
+#define ORYOL_MEMORY_USE_MMAP (1)
+#else
+#define ORYOL_MEMORY_USE_MMAP (0)
+#endif
+
+namespace Oryol {
+
+/// bookkeeping of a large allocation, kept out of band (not in front of
+/// the user pointer), so that power-of-two sizes exactly fill huge pages
+struct largeAlloc {
+    enum kind : uint32_t {
+        heap,       // allocated with malloc()
+        mapped,     // mapped with regular pages
+        advised,    // mapped with regular pages and transparent huge page advice
+        hugeTLB,    // mapped with explicit huge pages
+    };
+    uintptr_t ptr;      // the user pointer
+    void* base;         // pointer returned by malloc() (heap only)
+    size_t mapSize;
+    int64_t numBytes;
+    kind allocKind;
+};
+/// all live large allocations, sorted by user pointer
+static largeAlloc* largeAllocs = nullptr;
+static int largeAllocsNum = 0;
+static int largeAllocsCapacity = 0;
+#if ORYOL_HAS_THREADS
+static std::mutex largeAllocsMutex;
+#endif
+
+#if ORYOL_HAS_ATOMIC
+static std::atomic<int> largeNumAllocs{0};
+static std::atomic<int64_t> largeNumBytes{0};
+static std::atomic<int64_t> largeNumHugePageBytes{0};
+static std::atomic<int64_t> largeNumAdvisedBytes{0};
+#else
+static int largeNumAllocs = 0;
+static int64_t largeNumBytes = 0;
+static int64_t largeNumHugePageBytes = 0;
+static int64_t largeNumAdvisedBytes = 0;
+#endif
+    
+//------------------------------------------------------------------------------
+void*
+Memory::Alloc(int numBytes) {
+    void* ptr = std::malloc(numBytes);
+#if ORYOL_ALLOCATOR_DEBUG || ORYOL_UNITTESTS
+    Memory::Fill(ptr, numBytes, ORYOL_MEMORY_DEBUG_BYTE);
+#endif
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+void
+Memory::Fill(void* ptr, int numBytes, uint8_t value) {
+    std::memset(ptr, value, numBytes);
+}
+
+//------------------------------------------------------------------------------
+void*
+Memory::ReAlloc(void* ptr, int s) {
+    /// @todo: HMM need to fix fill with debug pattern...
+    return std::realloc(ptr, s);
+}
+
+//------------------------------------------------------------------------------
+void
+Memory::Free(void* p) {
+    std::free(p);
+}
+
+//------------------------------------------------------------------------------
+static int
+findLargeAlloc(uintptr_t ptr) {
+    // binary search, returns the insert position if not found
+    int lo = 0;
+    int hi = largeAllocsNum;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (largeAllocs[mid].ptr < ptr) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+//------------------------------------------------------------------------------
+static void
+addLargeAlloc(const largeAlloc& alloc) {
+    #if ORYOL_HAS_THREADS
+    std::lock_guard<std::mutex> lock(largeAllocsMutex);
+    #endif
+    if (largeAllocsNum == largeAllocsCapacity) {
+        largeAllocsCapacity = largeAllocsCapacity > 0 ? largeAllocsCapacity * 2 : 64;
+        largeAllocs = (largeAlloc*) std::realloc(largeAllocs, largeAllocsCapacity * sizeof(largeAlloc));
+        o_assert(largeAllocs);
+    }
+    const int index = findLargeAlloc(alloc.ptr);
+    std::memmove(&largeAllocs[index + 1], &largeAllocs[index], (largeAllocsNum - index) * sizeof(largeAlloc));
+    largeAllocs[index] = alloc;
+    largeAllocsNum++;
+}
+
+//------------------------------------------------------------------------------
+static largeAlloc
+removeLargeAlloc(uintptr_t ptr) {
+    #if ORYOL_HAS_THREADS
+    std::lock_guard<std::mutex> lock(largeAllocsMutex);
+    #endif
+    const int index = findLargeAlloc(ptr);
+    o_assert2((index < largeAllocsNum) && (largeAllocs[index].ptr == ptr), "Memory::FreeLarge(): unknown pointer!\n");
+    const largeAlloc alloc = largeAllocs[index];
+    largeAllocsNum--;
+    std::memmove(&largeAllocs[index], &largeAllocs[index + 1], (largeAllocsNum - index) * sizeof(largeAlloc));
+    return alloc;
+}
+
+//------------------------------------------------------------------------------
+void*
+Memory::AllocLarge(int numBytes, bool nodeLocal) {
+    o_assert_dbg(numBytes > 0);
+    largeAlloc alloc;
+    alloc.ptr = 0;
+    alloc.base = nullptr;
+    alloc.mapSize = 0;
+    alloc.numBytes = numBytes;
+    alloc.allocKind = largeAlloc::heap;
+
+    #if ORYOL_MEMORY_USE_MMAP
+    const int mapFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+    const size_t pageSize = size_t(sysconf(_SC_PAGESIZE));
+    const size_t hugePageSize = 2 * 1024 * 1024;
+    #if defined(MAP_HUGETLB)
+    // try explicit huge pages first, this fails if no huge pages are reserved
+    if (size_t(numBytes) >= hugePageSize) {
+        const size_t mapSize = (size_t(numBytes) + hugePageSize - 1) & ~(hugePageSize - 1);
+        void* ptr = mmap(nullptr, mapSize, PROT_READ|PROT_WRITE, mapFlags|MAP_HUGETLB, -1, 0);
+        if (MAP_FAILED != ptr) {
+            alloc.ptr = uintptr_t(ptr);
+            alloc.mapSize = mapSize;
+            alloc.allocKind = largeAlloc::hugeTLB;
+        }
+    }
+    #endif
+    if (0 == alloc.ptr) {
+        const size_t mapSize = (size_t(numBytes) + pageSize - 1) & ~(pageSize - 1);
+        // big mappings are aligned to the huge page size, so that all
+        // whole 2 MB extents can be backed by transparent huge pages,
+        // for this, map more than needed and unmap the excess
+        const size_t align = mapSize >= hugePageSize ? hugePageSize : pageSize;
+        const size_t reserveSize = mapSize + align - pageSize;
+        void* ptr = mmap(nullptr, reserveSize, PROT_READ|PROT_WRITE, mapFlags, -1, 0);
+        if (MAP_FAILED != ptr) {
+            const uintptr_t reserveStart = uintptr_t(ptr);
+            const uintptr_t start = (reserveStart + align - 1) & ~uintptr_t(align - 1);
+            if (start > reserveStart) {
+                munmap(ptr, start - reserveStart);
+            }
+            const uintptr_t end = start + mapSize;
+            if ((reserveStart + reserveSize) > end) {
+                munmap((void*)end, (reserveStart + reserveSize) - end);
+            }
+            alloc.ptr = start;
+            alloc.mapSize = mapSize;
+            alloc.allocKind = largeAlloc::mapped;
+            #if defined(MADV_HUGEPAGE)
+            if (0 == madvise((void*)start, mapSize, MADV_HUGEPAGE)) {
+                alloc.allocKind = largeAlloc::advised;
+            }
+            #endif
+        }
+    }
+    if (nodeLocal && (0 != alloc.ptr)) {
+        // fault in all pages now, on this thread
+        for (size_t offset = 0; offset < alloc.mapSize; offset += pageSize) {
+            ((volatile uint8_t*)alloc.ptr)[offset] = 0;
+        }
+    }
+    #endif
+
+    if (0 == alloc.ptr) {
+        // no mmap, or mmap failed: fall back to the heap, keep
+        // the user pointer cache-line aligned
+        alloc.base = std::malloc(size_t(numBytes) + 63);
+        o_assert(alloc.base);
+        alloc.ptr = (uintptr_t(alloc.base) + 63) & ~uintptr_t(63);
+        alloc.mapSize = size_t(numBytes) + 63;
+        alloc.allocKind = largeAlloc::heap;
+        if (nodeLocal) {
+            Memory::Clear((void*)alloc.ptr, numBytes);
+        }
+    }
+    addLargeAlloc(alloc);
+    if (largeAlloc::hugeTLB == alloc.allocKind) {
+        largeNumHugePageBytes += int64_t(alloc.mapSize);
+    }
+    else if (largeAlloc::advised == alloc.allocKind) {
+        largeNumAdvisedBytes += int64_t(alloc.mapSize);
+    }
+    largeNumAllocs++;
+    largeNumBytes += numBytes;
+    return (void*) alloc.ptr;
+}
+
+//------------------------------------------------------------------------------
+void
+Memory::FreeLarge(void* ptr) {
+    o_assert_dbg(ptr);
+    const largeAlloc alloc = removeLargeAlloc(uintptr_t(ptr));
+    largeNumAllocs--;
+    largeNumBytes -= alloc.numBytes;
+    if (largeAlloc::heap == alloc.allocKind) {
+        std::free(alloc.base);
+        return;
+    }
+    #if ORYOL_MEMORY_USE_MMAP
+    if (largeAlloc::hugeTLB == alloc.allocKind) {
+        largeNumHugePageBytes -= int64_t(alloc.mapSize);
+    }
+    else if (largeAlloc::advised == alloc.allocKind) {
+        largeNumAdvisedBytes -= int64_t(alloc.mapSize);
+    }
+    munmap(ptr, alloc.mapSize);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+Memory::LargeAllocStats
+Memory::QueryLargeAllocStats() {
+    LargeAllocStats stats;
+    stats.NumAllocs = largeNumAllocs;
+    stats.NumBytes = largeNumBytes;
+    stats.NumHugePageBytes = largeNumHugePageBytes;
+    stats.NumAdvisedBytes = largeNumAdvisedBytes;
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+void
+Memory::Copy(const void* from, void* to, int numBytes) {
+    std::memcpy(to, from, numBytes);
+}
+
+//------------------------------------------------------------------------------
+void
+Memory::Move(const void* from, void* to, int numBytes) {
+    std::memmove(to, from, numBytes);
+}
+
+//------------------------------------------------------------------------------
+void
+Memory::Clear(void* ptr, int numBytes) {
+    std::memset(ptr, 0, numBytes);
+}
+
+} // namespace Oryol
+
+
+
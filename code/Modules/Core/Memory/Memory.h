@@ -9,8 +9,18 @@
     differs by platforms (e.g. platforms with SSE support return 16-byte
     aligned memory.
     
-    @todo for now this simply calls malloc()/free(), may be more
-    advanced in the future.
+    Small allocations simply call malloc()/free(). Big buffers (see
+    ORYOL_LARGE_ALLOC_THRESHOLD) should go through AllocLarge()/FreeLarge(),
+    which maps memory directly from the OS, backed by huge pages if
+    available (MAP_HUGETLB), or with transparent huge page advice
+    (MADV_HUGEPAGE), and fall back to malloc() on other platforms.
+    The bookkeeping of large allocations is kept in a side table, so
+    a 2 MB allocation exactly fills one huge page, and mappings of at
+    least 2 MB are 2 MB aligned. With the nodeLocal flag, all pages are
+    faulted in by the calling thread, so that a NUMA system places them
+    on the thread's memory node (first-touch policy). Use this for
+    buffers owned by a worker thread, pool allocators have a
+    node-local option for their puddles.
 */
 #include "Core/Types.h"
 #include "Core/Config.h"
@@ -27,6 +37,23 @@ public:
     static void* ReAlloc(void* ptr, int numBytes);
     /// free a raw chunk of memory
     static void Free(void* ptr);
+    /// allocate a big chunk of memory, preferably backed by huge pages
+    static void* AllocLarge(int numBytes, bool nodeLocal=false);
+    /// free memory allocated with AllocLarge()
+    static void FreeLarge(void* ptr);
+    /// large allocation statistics
+    struct LargeAllocStats {
+        /// number of live large allocations
+        int NumAllocs = 0;
+        /// bytes in live large allocations
+        int64_t NumBytes = 0;
+        /// bytes backed by explicit huge pages (MAP_HUGETLB)
+        int64_t NumHugePageBytes = 0;
+        /// bytes advised for transparent huge pages (the kernel may ignore the advice)
+        int64_t NumAdvisedBytes = 0;
+    };
+    /// get current large allocation statistics (thread-safe)
+    static LargeAllocStats QueryLargeAllocStats();
     /// fill range of memory with a byte value
     static void Fill(void* ptr, int numBytes, uint8_t value);
     /// copy a raw chunk of non-overlapping memory
@@ -32,6 +32,8 @@ public:
     template<typename... ARGS> TYPE* Create(ARGS&&... args);
     /// delete and free an object
     void Destroy(TYPE* obj);
+    /// place big puddles on the NUMA node of the thread which allocates them
+    void SetNodeLocal(bool b);
     
 private:
     enum class nodeState : uint8_t {
@@ -65,6 +67,7 @@ private:
     static const uint32_t NumPuddleElements = 256;
     
     int32_t elmSize;                      // offset to next element in bytes
+    bool nodeLocal = false;               // passed to Memory::AllocLarge()
 
     #if ORYOL_HAS_ATOMIC
         std::atomic<uint32_t> uniqueCount;
@@ -98,12 +101,24 @@ template<class TYPE>
 poolAllocator<TYPE>::~poolAllocator() {
 
     const uint32_t num = this->numPuddles;
+    const uint32_t puddleByteSize = NumPuddleElements * this->elmSize;
     for (uint32_t i = 0; i < num; i++) {
-        Memory::Free(this->puddles[i]);
+        if (puddleByteSize >= ORYOL_LARGE_ALLOC_THRESHOLD) {
+            Memory::FreeLarge(this->puddles[i]);
+        }
+        else {
+            Memory::Free(this->puddles[i]);
+        }
         this->puddles[i] = 0;
     }
 }
 
+//------------------------------------------------------------------------------
+template<class TYPE> void
+poolAllocator<TYPE>::SetNodeLocal(bool b) {
+    this->nodeLocal = b;
+}
+
 //------------------------------------------------------------------------------
 template<class TYPE>
 typename poolAllocator<TYPE>::node*
@@ -141,7 +156,8 @@ poolAllocator<TYPE>::allocPuddle() {
     
     // allocate new puddle
     const uint32_t puddleByteSize = NumPuddleElements * this->elmSize;
-    this->puddles[newPuddleIndex] = (uint8_t*) Memory::Alloc(puddleByteSize);
+    this->puddles[newPuddleIndex] = (uint8_t*) (puddleByteSize >= ORYOL_LARGE_ALLOC_THRESHOLD ?
+        Memory::AllocLarge(puddleByteSize, this->nodeLocal) : Memory::Alloc(puddleByteSize));
     Memory::Clear(this->puddles[newPuddleIndex], puddleByteSize);
     
     // populate the free stack
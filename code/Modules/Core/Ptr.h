@@ -13,6 +13,7 @@
 #include <type_traits>
 #include "Core/Types.h"
 #include "Core/Assertion.h"
+#include "Core/Containers/Relocatable.h"
 
 namespace Oryol {
 
@@ -182,4 +183,9 @@ private:
     };
 };
 
+/// smart pointers only hold a raw pointer and can be moved with memcpy
+template<class TYPE> struct IsTriviallyRelocatable<Ptr<TYPE>> {
+    static const bool Value = true;
+};
+
 } // namespace oryol
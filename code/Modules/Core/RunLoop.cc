@@ -3,6 +3,8 @@
 //------------------------------------------------------------------------------
 #include "Pre.h"
 #include "RunLoop.h"
+#include "Core/Time/Clock.h"
+#include "Core/Memory/Memory.h"
 
 namespace Oryol {
 
@@ -15,12 +17,25 @@ curId(InvalidId)
 
 //------------------------------------------------------------------------------
 RunLoop::~RunLoop() {
-    // empty
+    // functions which haven't been called yet are dropped
+    inboxNode* node = this->inbox.exchange(nullptr, std::memory_order_acquire);
+    while (node) {
+        inboxNode* next = node->next;
+        Memory::Delete(node);
+        node = next;
+    }
+    node = this->deferredHead;
+    while (node) {
+        inboxNode* next = node->next;
+        Memory::Delete(node);
+        node = next;
+    }
 }
 
 //------------------------------------------------------------------------------
 void
 RunLoop::Run() {
+    this->drainInbox();
     this->remCallbacks();
     this->addCallbacks();
     for (const auto& entry : this->callbacks) {
@@ -46,7 +61,7 @@ RunLoop::HasCallback(Id id) const {
 RunLoop::Id
 RunLoop::Add(Func func) {
     Id newId = ++this->curId;
-    this->toAdd.Add(newId, item{func, false});
+    this->toAdd.Add(KeyValuePair<Id, item>(Id(newId), item{std::move(func), false}));
     return newId;
 }
 
@@ -62,13 +77,84 @@ RunLoop::Remove(Id id) {
     this->toRemove.Add(id);
 }
 
+//------------------------------------------------------------------------------
+/**
+ NOTE: this may be called from any thread, the function is called on
+ the thread which owns the run loop.
+*/
+void
+RunLoop::Post(Func func) {
+    inboxNode* node = Memory::New<inboxNode>();
+    node->func = std::move(func);
+    node->next = this->inbox.load(std::memory_order_relaxed);
+    while (!this->inbox.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+        // node->next has been updated with the current head, retry
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+RunLoop::SetInboxBudget(Duration budget) {
+    this->inboxBudget = budget;
+}
+
+//------------------------------------------------------------------------------
+int
+RunLoop::NumDeferred() const {
+    return this->numDeferred;
+}
+
+//------------------------------------------------------------------------------
+void
+RunLoop::drainInbox() {
+
+    // take the whole inbox (newest first), and append it in posting
+    // order to the functions deferred from the previous Run()
+    inboxNode* node = this->inbox.exchange(nullptr, std::memory_order_acquire);
+    inboxNode* reversed = nullptr;
+    inboxNode* last = node;
+    while (node) {
+        inboxNode* next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+        this->numDeferred++;
+    }
+    if (reversed) {
+        if (this->deferredTail) {
+            this->deferredTail->next = reversed;
+        }
+        else {
+            this->deferredHead = reversed;
+        }
+        this->deferredTail = last;
+    }
+
+    // call functions until the inbox budget is used up
+    const bool hasBudget = this->inboxBudget.AsTicks() > 0;
+    const TimePoint start = hasBudget ? Clock::Now() : TimePoint();
+    while (this->deferredHead) {
+        node = this->deferredHead;
+        this->deferredHead = node->next;
+        if (nullptr == this->deferredHead) {
+            this->deferredTail = nullptr;
+        }
+        this->numDeferred--;
+        node->func();
+        Memory::Delete(node);
+        if (hasBudget && (this->inboxBudget <= Clock::Since(start))) {
+            break;
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 void
 RunLoop::addCallbacks() {
     for (auto& entry : this->toAdd) {
         item& item = entry.Value();
         item.valid = true;
-        this->callbacks.Add(entry.Key(), item);
+        this->callbacks.Add(KeyValuePair<Id, RunLoop::item>(Id(entry.Key()), std::move(item)));
     }
     this->toAdd.Clear();
 }
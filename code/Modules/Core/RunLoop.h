@@ -16,17 +16,27 @@
     
     1. from C function myFunc():
 
-        Callback("name", pri, std::function<void()>(&myFunc);
+        Callback("name", pri, RunLoop::Func(&myFunc);
     2. from an object's method (careful, object must not go out-of-scope
        as long as the callback is added to the RunLoop!
 
         MyClass myObj;<br>
-        Callback("name", pri, std::function<void()>(&MyClass::MyMethod, &myObj));
+        Callback("name", pri, RunLoop::Func([&myObj] { myObj.MyMethod(); }));
+
+    Add() and Remove() must be called on the thread which owns the
+    runloop, but any thread may Post() one-shot functions into the
+    runloop's inbox. The inbox is a lock-free multi-producer/single-consumer
+    list which is drained at the start of Run(), functions posted while
+    the inbox is drained are called in the next Run(). With an inbox
+    budget, draining stops when the budget is used up (at least one
+    function is called per Run()) and continues in the next Run().
 */
-#include <functional>
+#include <atomic>
 #include "Core/RefCounted.h"
+#include "Core/InplaceFunction.h"
 #include "Core/String/StringAtom.h"
 #include "Core/Containers/Map.h"
+#include "Core/Time/Duration.h"
 
 namespace Oryol {
 
@@ -37,7 +47,7 @@ public:
     /// invalid runloop Id const
     static const Id InvalidId = 0;
     /// runloop function typedef
-    typedef std::function<void()> Func;
+    typedef InplaceFunction<void()> Func;
 
     /// constructor
     RunLoop();
@@ -53,8 +63,17 @@ public:
     void Remove(Id);
     /// test if a callback has been attached, slow!
     bool HasCallback(Id) const;
+
+    /// post a function which is called once at the start of the next Run() (thread-safe)
+    void Post(Func func);
+    /// set max time spent on calling posted functions per Run() (zero for no limit)
+    void SetInboxBudget(Duration budget);
+    /// get number of posted functions which have been taken from the inbox but not called yet
+    int NumDeferred() const;
     
 private:
+    /// call functions posted to the inbox
+    void drainInbox();
     /// add new callbacks that have been added (called at beginning of Run())
     void addCallbacks();
     /// remove callbacks that have been removed (called at end of Run())
@@ -65,7 +84,17 @@ private:
         bool valid;
     };
     
+    struct inboxNode {
+        Func func;
+        inboxNode* next;
+    };
+
     Id curId;
+    std::atomic<inboxNode*> inbox{nullptr};    // written by any thread
+    inboxNode* deferredHead = nullptr;          // only accessed by owner thread
+    inboxNode* deferredTail = nullptr;
+    int numDeferred = 0;
+    Duration inboxBudget;
     Map<Id, item> callbacks;
     Map<Id, item> toAdd;
     Set<Id> toRemove;
@@ -27,6 +27,7 @@
 #include <atomic>
 #include "Core/Types.h"
 #include "Core/Assertion.h"
+#include "Core/Containers/Relocatable.h"
 
 namespace Oryol {
 
@@ -110,6 +111,7 @@ private:
         int length;
     };
     
+    friend class StringConverter;
     /// create new string data block, numBytes does not include the terminating 0
     void create(const char* ptr, int len);
     /// private alloc function for len
@@ -154,3 +156,5 @@ bool operator>=(const StringAtom& s0, const String& s1);
 
 } // namespace Oryol
 
+ORYOL_TRIVIALLY_RELOCATABLE(Oryol::String)
+
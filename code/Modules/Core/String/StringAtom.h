@@ -13,6 +13,7 @@
 */
 #include "Core/Types.h"
 #include "Core/String/stringAtomTable.h"
+#include "Core/Containers/Relocatable.h"
 
 namespace Oryol {
 
@@ -229,3 +230,5 @@ StringAtom::AsCStr() const {
 }
 
 } // namespace Oryol
+
+ORYOL_TRIVIALLY_RELOCATABLE(Oryol::StringAtom)
@@ -8,6 +8,11 @@
 #include <cstdlib>
 #include <cstring>
 #include <cwchar>
+#if ORYOL_HAS_SSE2
+#include <emmintrin.h>
+#elif ORYOL_HAS_NEON
+#include <arm_neon.h>
+#endif
 
 namespace Oryol {
 
@@ -21,81 +26,465 @@ DumpWarning(ConversionResult convRes) {
     o_warn("StringConverter: conversion failed with '%s'\n", err);
 }
 
+//------------------------------------------------------------------------------
+/**
+    Count the number of bits set in a 16-bit SIMD movemask.
+*/
+static inline int
+PopCount16(uint32_t mask) {
+    mask = mask - ((mask >> 1) & 0x5555);
+    mask = (mask & 0x3333) + ((mask >> 2) & 0x3333);
+    mask = (mask + (mask >> 4)) & 0x0F0F;
+    return int((mask + (mask >> 8)) & 0x1F);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Copy a run of ASCII characters from an UTF-8 source into a wide
+    string, stops at the first non-ASCII byte, or when the source or
+    destination is exhausted. Returns number of converted characters.
+*/
+static int
+WidenASCII(const uint8_t* src, int srcNum, wchar_t* dst, int dstNum) {
+    const int num = srcNum < dstNum ? srcNum : dstNum;
+    int i = 0;
+    #if ORYOL_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; (i + 16) <= num; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        if (0 != _mm_movemask_epi8(v)) {
+            break;
+        }
+        const __m128i lo = _mm_unpacklo_epi8(v, zero);
+        const __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i* d = (__m128i*)(dst + i);
+        if (4 == sizeof(wchar_t)) {
+            _mm_storeu_si128(d + 0, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(d + 1, _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(d + 2, _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(d + 3, _mm_unpackhi_epi16(hi, zero));
+        }
+        else {
+            _mm_storeu_si128(d + 0, lo);
+            _mm_storeu_si128(d + 1, hi);
+        }
+    }
+    #elif ORYOL_HAS_NEON
+    for (; (i + 16) <= num; i += 16) {
+        const uint8x16_t v = vld1q_u8(src + i);
+        const uint64x2_t high = vreinterpretq_u64_u8(vshrq_n_u8(v, 7));
+        if (0 != (vgetq_lane_u64(high, 0) | vgetq_lane_u64(high, 1))) {
+            break;
+        }
+        const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+        const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+        if (4 == sizeof(wchar_t)) {
+            uint32_t* d = (uint32_t*)(dst + i);
+            vst1q_u32(d + 0, vmovl_u16(vget_low_u16(lo)));
+            vst1q_u32(d + 4, vmovl_u16(vget_high_u16(lo)));
+            vst1q_u32(d + 8, vmovl_u16(vget_low_u16(hi)));
+            vst1q_u32(d + 12, vmovl_u16(vget_high_u16(hi)));
+        }
+        else {
+            uint16_t* d = (uint16_t*)(dst + i);
+            vst1q_u16(d + 0, lo);
+            vst1q_u16(d + 8, hi);
+        }
+    }
+    #else
+    for (; (i + 8) <= num; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, src + i, sizeof(w));
+        if (0 != (w & 0x8080808080808080ULL)) {
+            break;
+        }
+        for (int j = 0; j < 8; j++) {
+            dst[i + j] = wchar_t(src[i + j]);
+        }
+    }
+    #endif
+    for (; i < num; i++) {
+        if (src[i] & 0x80) {
+            break;
+        }
+        dst[i] = wchar_t(src[i]);
+    }
+    return i;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Copy a run of ASCII characters from a wide string into an UTF-8
+    destination, stops at the first non-ASCII character, or when the
+    source or destination is exhausted. Returns number of converted
+    characters.
+*/
+static int
+NarrowASCII(const wchar_t* src, int srcNum, uint8_t* dst, int dstNum) {
+    const int num = srcNum < dstNum ? srcNum : dstNum;
+    int i = 0;
+    #if ORYOL_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; (i + 16) <= num; i += 16) {
+        const __m128i* s = (const __m128i*)(src + i);
+        __m128i packed;
+        if (4 == sizeof(wchar_t)) {
+            const __m128i v0 = _mm_loadu_si128(s + 0);
+            const __m128i v1 = _mm_loadu_si128(s + 1);
+            const __m128i v2 = _mm_loadu_si128(s + 2);
+            const __m128i v3 = _mm_loadu_si128(s + 3);
+            const __m128i all = _mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3));
+            const __m128i high = _mm_and_si128(all, _mm_set1_epi32(~0x7F));
+            if (0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi32(high, zero))) {
+                break;
+            }
+            packed = _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+        }
+        else {
+            const __m128i v0 = _mm_loadu_si128(s + 0);
+            const __m128i v1 = _mm_loadu_si128(s + 1);
+            const __m128i high = _mm_and_si128(_mm_or_si128(v0, v1), _mm_set1_epi16(~0x7F));
+            if (0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi16(high, zero))) {
+                break;
+            }
+            packed = _mm_packus_epi16(v0, v1);
+        }
+        _mm_storeu_si128((__m128i*)(dst + i), packed);
+    }
+    #elif ORYOL_HAS_NEON
+    for (; (i + 16) <= num; i += 16) {
+        uint8x16_t packed;
+        if (4 == sizeof(wchar_t)) {
+            const uint32_t* s = (const uint32_t*)(src + i);
+            const uint32x4_t v0 = vld1q_u32(s + 0);
+            const uint32x4_t v1 = vld1q_u32(s + 4);
+            const uint32x4_t v2 = vld1q_u32(s + 8);
+            const uint32x4_t v3 = vld1q_u32(s + 12);
+            const uint32x4_t all = vorrq_u32(vorrq_u32(v0, v1), vorrq_u32(v2, v3));
+            const uint64x2_t high = vreinterpretq_u64_u32(vandq_u32(all, vdupq_n_u32(~0x7Fu)));
+            if (0 != (vgetq_lane_u64(high, 0) | vgetq_lane_u64(high, 1))) {
+                break;
+            }
+            const uint16x8_t lo = vcombine_u16(vmovn_u32(v0), vmovn_u32(v1));
+            const uint16x8_t hi = vcombine_u16(vmovn_u32(v2), vmovn_u32(v3));
+            packed = vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+        }
+        else {
+            const uint16_t* s = (const uint16_t*)(src + i);
+            const uint16x8_t v0 = vld1q_u16(s + 0);
+            const uint16x8_t v1 = vld1q_u16(s + 8);
+            const uint64x2_t high = vreinterpretq_u64_u16(vandq_u16(vorrq_u16(v0, v1), vdupq_n_u16(0xFF80)));
+            if (0 != (vgetq_lane_u64(high, 0) | vgetq_lane_u64(high, 1))) {
+                break;
+            }
+            packed = vcombine_u8(vmovn_u16(v0), vmovn_u16(v1));
+        }
+        vst1q_u8(dst + i, packed);
+    }
+    #endif
+    for (; i < num; i++) {
+        if (uint32_t(src[i]) >= 0x80) {
+            break;
+        }
+        dst[i] = uint8_t(src[i]);
+    }
+    return i;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Decode and validate a single multi-byte UTF-8 sequence. Rejects
+    overlong encodings, surrogates and code points above 0x10FFFF.
+    Returns the sequence length, or 0 if the sequence is invalid or
+    truncated.
+*/
+static inline int
+DecodeUTF8(const uint8_t* src, int srcNum, uint32_t& outCodePoint) {
+    const uint8_t c = src[0];
+    int len;
+    uint8_t lo = 0x80;
+    uint8_t hi = 0xBF;
+    if (c < 0x80) {
+        outCodePoint = c;
+        return 1;
+    }
+    else if (c < 0xC2) {
+        // continuation byte, or overlong 2-byte sequence
+        return 0;
+    }
+    else if (c < 0xE0) {
+        len = 2;
+        outCodePoint = c & 0x1F;
+    }
+    else if (c < 0xF0) {
+        len = 3;
+        outCodePoint = c & 0x0F;
+        if (0xE0 == c) lo = 0xA0;       // overlong
+        else if (0xED == c) hi = 0x9F;  // surrogates
+    }
+    else if (c < 0xF5) {
+        len = 4;
+        outCodePoint = c & 0x07;
+        if (0xF0 == c) lo = 0x90;       // overlong
+        else if (0xF4 == c) hi = 0x8F;  // > 0x10FFFF
+    }
+    else {
+        return 0;
+    }
+    if (srcNum < len) {
+        return 0;
+    }
+    if ((src[1] < lo) || (src[1] > hi)) {
+        return 0;
+    }
+    outCodePoint = (outCodePoint << 6) | (src[1] & 0x3F);
+    for (int i = 2; i < len; i++) {
+        if (0x80 != (src[i] & 0xC0)) {
+            return 0;
+        }
+        outCodePoint = (outCodePoint << 6) | (src[i] & 0x3F);
+    }
+    return len;
+}
+
 //------------------------------------------------------------------------------
 int
 StringConverter::UTF8ToWide(const unsigned char* src, int srcNumBytes, wchar_t* dst, int dstMaxBytes) {
     o_assert((0 != src) && (0 != dst));
-    int result = 0;
-    const UTF8* srcPtr = src;
 
     // need to keep 1 wchar_t for the terminating 0
+    const int dstMaxChars = int(dstMaxBytes / sizeof(wchar_t)) - 1;
+    o_assert(dstMaxChars > 0);
     ConversionResult convRes = conversionOK;
-    wchar_t* dstEndPtr = dst + ((dstMaxBytes / sizeof(wchar_t)) - 1);
-    o_assert(dstEndPtr > dst);
-    if (sizeof(wchar_t) == 4) {
-        UTF32* dstPtr = (UTF32*)dst;
-        convRes = ConvertUTF8toUTF32(&srcPtr, src + srcNumBytes, &dstPtr, (UTF32*) dstEndPtr, strictConversion);
-        o_assert(dstPtr < (UTF32*) (dst + (dstMaxBytes / sizeof(wchar_t))));
-        *dstPtr = 0;
-        if (conversionOK == convRes) {
-            result = int(dstPtr - (UTF32*)dst) + 1;
-        }
-    } 
-    else {
-        o_assert(2 == sizeof(wchar_t));
-        UTF16* dstPtr = (UTF16*) dst;
-        convRes = ConvertUTF8toUTF16(&srcPtr, src + srcNumBytes, &dstPtr, (UTF16*) dstEndPtr, strictConversion);
-        o_assert(dstPtr < (UTF16*) (dst + (dstMaxBytes / sizeof(wchar_t))));
-        *dstPtr = 0;
-        if (conversionOK == convRes) {
-            result = int(dstPtr - (UTF16*)dst) + 1;
+    int srcIndex = 0;
+    int dstIndex = 0;
+    while (srcIndex < srcNumBytes) {
+        // fast-path for runs of ASCII characters
+        const int numASCII = WidenASCII(src + srcIndex, srcNumBytes - srcIndex, dst + dstIndex, dstMaxChars - dstIndex);
+        srcIndex += numASCII;
+        dstIndex += numASCII;
+        if (srcIndex >= srcNumBytes) {
+            break;
+        }
+        if (dstIndex >= dstMaxChars) {
+            convRes = targetExhausted;
+            break;
         }
+
+        // slow-path for a single multi-byte sequence
+        uint32_t codePoint = 0;
+        const int seqLen = DecodeUTF8(src + srcIndex, srcNumBytes - srcIndex, codePoint);
+        if (0 == seqLen) {
+            convRes = sourceIllegal;
+            break;
+        }
+        if ((2 == sizeof(wchar_t)) && (codePoint >= 0x10000)) {
+            // need a surrogate pair
+            if ((dstIndex + 2) > dstMaxChars) {
+                convRes = targetExhausted;
+                break;
+            }
+            codePoint -= 0x10000;
+            dst[dstIndex++] = wchar_t(0xD800 + (codePoint >> 10));
+            dst[dstIndex++] = wchar_t(0xDC00 + (codePoint & 0x3FF));
+        }
+        else {
+            dst[dstIndex++] = wchar_t(codePoint);
+        }
+        srcIndex += seqLen;
     }
+    dst[dstIndex] = 0;
     if (conversionOK != convRes) {
         DumpWarning(convRes);
         return 0;
     }
-    return result;
+    return dstIndex + 1;
 }
 
 //------------------------------------------------------------------------------
 int
 StringConverter::WideToUTF8(const wchar_t* src, int srcNumChars, unsigned char* dst, int dstMaxBytes) {
     o_assert((0 != src) && (0 != dst));
-    int result = 0;
-    UTF8* dstPtr = dst;
 
     // need to keep 1 char free for 0-termination
+    const int dstMax = dstMaxBytes - 1;
+    o_assert(dstMax > 0);
     ConversionResult convRes = conversionOK;
-    UTF8* dstEnd = (dst + dstMaxBytes) - 1;
-    o_assert(dstEnd > dst);
-    if (sizeof(wchar_t) == 4) {
-        o_assert(4 == sizeof(wchar_t));
-        const UTF32* srcPtr = (const UTF32*) src;
-        const UTF32* srcEndPtr = (UTF32*) src + srcNumChars;
-        convRes = ConvertUTF32toUTF8(&srcPtr, srcEndPtr, &dstPtr, dstEnd, strictConversion);
-        o_assert(dstPtr < (dst + dstMaxBytes));
-        *dstPtr = 0;
-        if (conversionOK == convRes) {
-            result = int(dstPtr - dst) + 1;
+    int srcIndex = 0;
+    int dstIndex = 0;
+    while (srcIndex < srcNumChars) {
+        // fast-path for runs of ASCII characters
+        const int numASCII = NarrowASCII(src + srcIndex, srcNumChars - srcIndex, dst + dstIndex, dstMax - dstIndex);
+        srcIndex += numASCII;
+        dstIndex += numASCII;
+        if (srcIndex >= srcNumChars) {
+            break;
         }
-    }
-    else {
-        o_assert(2 == sizeof(wchar_t));
-        const UTF16* srcPtr = (UTF16*) src;
-        const UTF16* srcEndPtr = (UTF16*) src + srcNumChars;
-        convRes = ConvertUTF16toUTF8(&srcPtr, srcEndPtr, &dstPtr, dstEnd, strictConversion);
-        o_assert(dstPtr < (dst + dstMaxBytes));
-        *dstPtr = 0;
-        if (conversionOK == convRes) {
-            result = int(dstPtr - dst) + 1;
+        if (dstIndex >= dstMax) {
+            convRes = targetExhausted;
+            break;
+        }
+
+        // slow-path for a single non-ASCII character
+        uint32_t codePoint = uint32_t(src[srcIndex++]);
+        if ((2 == sizeof(wchar_t)) && (codePoint >= 0xD800) && (codePoint <= 0xDBFF)) {
+            // high surrogate, must be followed by low surrogate
+            if (srcIndex >= srcNumChars) {
+                convRes = sourceExhausted;
+                break;
+            }
+            const uint32_t low = uint32_t(src[srcIndex]);
+            if ((low < 0xDC00) || (low > 0xDFFF)) {
+                convRes = sourceIllegal;
+                break;
+            }
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            srcIndex++;
+        }
+        else if (((codePoint >= 0xD800) && (codePoint <= 0xDFFF)) || (codePoint > 0x10FFFF)) {
+            convRes = sourceIllegal;
+            break;
+        }
+        const int seqLen = codePoint < 0x800 ? 2 : (codePoint < 0x10000 ? 3 : 4);
+        if ((dstIndex + seqLen) > dstMax) {
+            convRes = targetExhausted;
+            break;
         }
+        unsigned char* d = dst + dstIndex;
+        switch (seqLen) {
+            case 2:
+                d[0] = uint8_t(0xC0 | (codePoint >> 6));
+                d[1] = uint8_t(0x80 | (codePoint & 0x3F));
+                break;
+            case 3:
+                d[0] = uint8_t(0xE0 | (codePoint >> 12));
+                d[1] = uint8_t(0x80 | ((codePoint >> 6) & 0x3F));
+                d[2] = uint8_t(0x80 | (codePoint & 0x3F));
+                break;
+            default:
+                d[0] = uint8_t(0xF0 | (codePoint >> 18));
+                d[1] = uint8_t(0x80 | ((codePoint >> 12) & 0x3F));
+                d[2] = uint8_t(0x80 | ((codePoint >> 6) & 0x3F));
+                d[3] = uint8_t(0x80 | (codePoint & 0x3F));
+                break;
+        }
+        dstIndex += seqLen;
     }
+    dst[dstIndex] = 0;
     if (conversionOK != convRes) {
         DumpWarning(convRes);
         return 0;
     }
-    return result;
+    return dstIndex + 1;
+}
+
+//------------------------------------------------------------------------------
+bool
+StringConverter::IsValidUTF8(const unsigned char* src, int srcNumBytes) {
+    o_assert(0 != src);
+    int i = 0;
+    while (i < srcNumBytes) {
+        // skip runs of ASCII characters
+        #if ORYOL_HAS_SSE2
+        while (((i + 16) <= srcNumBytes) && (0 == _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(src + i))))) {
+            i += 16;
+        }
+        #elif ORYOL_HAS_NEON
+        while ((i + 16) <= srcNumBytes) {
+            const uint64x2_t high = vreinterpretq_u64_u8(vshrq_n_u8(vld1q_u8(src + i), 7));
+            if (0 != (vgetq_lane_u64(high, 0) | vgetq_lane_u64(high, 1))) {
+                break;
+            }
+            i += 16;
+        }
+        #endif
+        while ((i < srcNumBytes) && (src[i] < 0x80)) {
+            i++;
+        }
+        if (i < srcNumBytes) {
+            uint32_t codePoint;
+            const int seqLen = DecodeUTF8(src + i, srcNumBytes - i, codePoint);
+            if (0 == seqLen) {
+                return false;
+            }
+            i += seqLen;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+    For valid UTF-8, each character starts with a non-continuation
+    byte, and 4-byte sequences need a surrogate pair in UTF-16.
+*/
+int
+StringConverter::UTF8ToWideLength(const unsigned char* src, int srcNumBytes) {
+    o_assert(0 != src);
+    int numContinuation = 0;
+    int numFourByte = 0;
+    int i = 0;
+    #if ORYOL_HAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i contLimit = _mm_set1_epi8(-64);       // 0x80..0xBF < 0xC0 (signed)
+    const __m128i fourLimit = _mm_set1_epi8(-17);       // 0xF0..0xFF > 0xEF (signed)
+    for (; (i + 16) <= srcNumBytes; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        numContinuation += PopCount16(_mm_movemask_epi8(_mm_cmplt_epi8(v, contLimit)));
+        if (2 == sizeof(wchar_t)) {
+            const __m128i four = _mm_and_si128(_mm_cmpgt_epi8(v, fourLimit), _mm_cmplt_epi8(v, zero));
+            numFourByte += PopCount16(_mm_movemask_epi8(four));
+        }
+    }
+    #elif ORYOL_HAS_NEON
+    for (; (i + 16) <= srcNumBytes; i += 16) {
+        const uint8x16_t v = vld1q_u8(src + i);
+        // each compare result lane is 0xFF or 0, shift down to 1 or 0 and add up
+        const uint8x16_t cont = vshrq_n_u8(vandq_u8(vcgeq_u8(v, vdupq_n_u8(0x80)), vcltq_u8(v, vdupq_n_u8(0xC0))), 7);
+        const uint64x2_t contSum = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(cont)));
+        numContinuation += int(vgetq_lane_u64(contSum, 0) + vgetq_lane_u64(contSum, 1));
+        if (2 == sizeof(wchar_t)) {
+            const uint64x2_t fourSum = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(vshrq_n_u8(vcgeq_u8(v, vdupq_n_u8(0xF0)), 7))));
+            numFourByte += int(vgetq_lane_u64(fourSum, 0) + vgetq_lane_u64(fourSum, 1));
+        }
+    }
+    #endif
+    for (; i < srcNumBytes; i++) {
+        if (0x80 == (src[i] & 0xC0)) {
+            numContinuation++;
+        }
+        else if ((2 == sizeof(wchar_t)) && (src[i] >= 0xF0)) {
+            numFourByte++;
+        }
+    }
+    return (srcNumBytes - numContinuation) + numFourByte;
+}
+
+//------------------------------------------------------------------------------
+int
+StringConverter::WideToUTF8Length(const wchar_t* src, int srcNumChars) {
+    o_assert(0 != src);
+    int numBytes = 0;
+    for (int i = 0; i < srcNumChars; i++) {
+        const uint32_t c = uint32_t(src[i]);
+        if (c < 0x80) {
+            numBytes += 1;
+        }
+        else if (c < 0x800) {
+            numBytes += 2;
+        }
+        else if ((2 == sizeof(wchar_t)) && (c >= 0xD800) && (c <= 0xDFFF)) {
+            // each half of a surrogate pair contributes 2 of 4 bytes
+            numBytes += 2;
+        }
+        else if (c < 0x10000) {
+            numBytes += 3;
+        }
+        else {
+            numBytes += 4;
+        }
+    }
+    return numBytes;
 }
 
 //------------------------------------------------------------------------------
@@ -104,20 +493,12 @@ StringConverter::WideToUTF8(const wchar_t* wide, int numWideChars) {
     String converted;
     o_assert(0 != wide);
     if (numWideChars > 0) {
-        if (numWideChars < MaxInternalBufferWChars) {
-            unsigned char dstBuf[(MaxInternalBufferWChars + 1) * MaxUTF8Size];
-            if (0 < StringConverter::WideToUTF8(wide, numWideChars, dstBuf, (int)sizeof(dstBuf))) {
-                converted = (char*) dstBuf;
-            }
-        }
-        else {
-            int dstBufSize = (numWideChars * MaxUTF8Size) + 1;
-            unsigned char* dstBuf = (unsigned char*) Memory::Alloc(dstBufSize);
-            if (0 < StringConverter::WideToUTF8(wide, numWideChars, dstBuf, dstBufSize)) {
-                converted = (char*) dstBuf;
-            }
-            Memory::Free(dstBuf);
-            return converted;
+        // compute the exact length and convert directly into the string object
+        const int numBytes = WideToUTF8Length(wide, numWideChars);
+        converted.alloc(numBytes);
+        unsigned char* dst = (unsigned char*) converted.strPtr;
+        if ((numBytes + 1) != StringConverter::WideToUTF8(wide, numWideChars, dst, numBytes + 1)) {
+            converted.Clear();
         }
     }
     return converted;
@@ -143,25 +524,20 @@ StringConverter::UTF8ToWide(const unsigned char* src, int srcNumBytes) {
     o_assert(0 != src);
     WideString result;
     if (srcNumBytes > 0) {
-        // use a char array as buffer (note, even though String::Length() returns the
-        // number of bytes in the string, not the number of UTF-8 characters, this is a valid
-        // check, since the NumBytes is always >= NumChars!
-        if (srcNumBytes < MaxInternalBufferWChars) {
-            wchar_t dstBuf[MaxInternalBufferWChars];
-            bool success = (0 < StringConverter::UTF8ToWide(src, srcNumBytes, dstBuf, sizeof(dstBuf)));
-            if (success) {
-                result = dstBuf;
+        // compute the exact length and convert directly into the string object,
+        // (for invalid UTF-8 the length may be off, but the conversion
+        // will fail in this case anyway)
+        const int numChars = UTF8ToWideLength(src, srcNumBytes);
+        if (numChars > 0) {
+            result.alloc(numChars);
+            wchar_t* dst = (wchar_t*) result.strPtr;
+            const int dstBytes = (numChars + 1) * sizeof(wchar_t);
+            if ((numChars + 1) != StringConverter::UTF8ToWide(src, srcNumBytes, dst, dstBytes)) {
+                result.Clear();
             }
         }
         else {
-            // use buffer 
-            int bufferSize = (srcNumBytes + 1) * sizeof(wchar_t);
-            wchar_t* dstBuf = (wchar_t*) Memory::Alloc(bufferSize);
-            bool success = (0 < StringConverter::UTF8ToWide(src, srcNumBytes, dstBuf, bufferSize));
-            if (success) {
-                result = dstBuf;
-            }
-            Memory::Free((void*) dstBuf);
+            DumpWarning(sourceIllegal);
         }
     }
     return result;
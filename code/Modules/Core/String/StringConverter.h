@@ -8,6 +8,12 @@
     and from and to simple types (int, float, ...). Please note that
     wchar_t is 2 bytes (UTF-16) on Windows, but 4 bytes (UTF-32) 
     on other UNIX-like platforms!
+
+    The UTF-8 conversion functions have SSE2/NEON fast-paths which
+    convert runs of ASCII characters 16 bytes at a time, only multi-byte
+    UTF-8 sequences go through the (strict) scalar code. The String
+    and WideString conversion functions compute the exact result length
+    upfront and convert directly into the result string.
 */
 #include "Core/Types.h"
 #include "Core/Containers/Array.h"
@@ -44,9 +50,12 @@ public:
     /// convert UTF8 string object to wide string object
     static WideString UTF8ToWide(const String& src);
 
-private:
-    static const int MaxInternalBufferWChars = 128;
-    static const int MaxUTF8Size = 6;
+    /// check if a raw byte range is valid UTF-8
+    static bool IsValidUTF8(const unsigned char* src, int srcNumBytes);
+    /// get number of wchar_t required for a valid UTF-8 range (without 0-terminator)
+    static int UTF8ToWideLength(const unsigned char* src, int srcNumBytes);
+    /// get number of bytes required for a valid wide string range as UTF-8 (without 0-terminator)
+    static int WideToUTF8Length(const wchar_t* src, int srcNumChars);
 };
 
 //------------------------------------------------------------------------------
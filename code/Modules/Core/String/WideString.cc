@@ -21,16 +21,23 @@ WideString::destroy() {
     this->data = 0;
 }
 
+//------------------------------------------------------------------------------
+void
+WideString::alloc(int numChars) {
+    o_assert(numChars > 0);
+    this->data = (StringData*) Memory::Alloc(sizeof(StringData) + ((numChars + 1) * sizeof(wchar_t)));
+    new(this->data) StringData();
+    this->addRef();
+    this->data->length = numChars;
+    this->strPtr = (const wchar_t*) &(this->data[1]);
+}
+
 //------------------------------------------------------------------------------
 void
 WideString::create(const wchar_t* ptr, int numChars) {
     o_assert(0 != ptr);
     if ((ptr[0] != 0) && (numChars > 0)) {
-        this->data = (StringData*) Memory::Alloc(sizeof(StringData) + ((numChars + 1) * sizeof(wchar_t)));
-        new(this->data) StringData();
-        this->addRef();
-        this->data->length = numChars;
-        this->strPtr = (const wchar_t*) &(this->data[1]);
+        this->alloc(numChars);
         Memory::Copy(ptr, (void*) this->strPtr, numChars * sizeof(wchar_t));
         ((wchar_t*)strPtr)[numChars] = 0;
     }
@@ -17,6 +17,7 @@
 #include <atomic>
 #include "Core/Types.h"
 #include "Core/Assertion.h"
+#include "Core/Containers/Relocatable.h"
 
 namespace Oryol {
     
@@ -88,8 +89,11 @@ private:
         int length;
     };
         
+    friend class StringConverter;
     /// create new string data block, len is number of characters (excluding 0 terminator
     void create(const wchar_t* ptr, int len);
+    /// private alloc function for len characters (excluding 0 terminator)
+    void alloc(int len);
     /// destroy shared string data block
     void destroy();
     /// increment refcount
@@ -117,3 +121,5 @@ bool operator<=(const wchar_t* s0, const WideString& s1);
 bool operator>=(const wchar_t* s0, const WideString& s1);
 
 } // namespace Oryol
+
+ORYOL_TRIVIALLY_RELOCATABLE(Oryol::WideString)
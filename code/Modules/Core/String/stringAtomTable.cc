@@ -4,6 +4,7 @@
 #include "Pre.h"
 #include <cstring>
 #include "stringAtomTable.h"
+#include "Core/Hash/Hash.h"
 #if ORYOL_USE_VLD
 #include "vld.h"
 #endif
@@ -76,20 +77,7 @@ stringAtomTable::Add(int32_t hash, const char* str) {
 int32_t
 stringAtomTable::HashForString(const char* str) {
 
-    // see here: http://eternallyconfuzzled.com/tuts/algorithms/jsw_tut_hashing.aspx
-    const char* p = str;
-    int32_t h = 0;
-    char c;
-    while (0 != (c = *p++))
-    {
-        h += c;
-        h += (h << 10);
-        h ^= (h >> 6);
-    }
-    h += (h << 3);
-    h ^= (h >> 11);
-    h += (h << 15);
-    return h;
+    return int32_t(Hash::CStr(str));
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,136 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::Future
+    @ingroup Core
+    @brief a value which is produced on another thread
+
+    A Promise is the producing end, a Future the consuming end of a
+    value which becomes available later, for instance the result of
+    parsing loaded data on an IO worker thread:
+
+        Promise<Result> promise;
+        Future<Result> future = promise.GetFuture();
+        IO::Load(url, [promise](IO::LoadResult res) {
+            // on the IO worker thread
+            promise.SetValue(parse(res.Data));
+        }, IO::LoadFailedFunc(), IO::CallbackThread::WorkerThread);
+
+    The owner of the Future either polls IsReady() (e.g. in a resource
+    loader's Continue()), or attaches a continuation with Then(), which
+    is posted to a run loop's inbox (usually Core::MainRunLoop()) as
+    soon as the value is set, so the continuation is always called on
+    the thread which owns the run loop.
+
+    SetValue() may be called from any thread, but only once. Then() may
+    only be called once per Future. Future and Promise objects are
+    cheap to copy, they share a reference-counted state object.
+*/
+#include "Core/Types.h"
+#include "Core/RefCounted.h"
+#include "Core/RunLoop.h"
+#include "Core/InplaceFunction.h"
+#if ORYOL_HAS_THREADS
+#include <mutex>
+#endif
+
+namespace Oryol {
+
+namespace _priv {
+/// state shared between a Future and its Promise
+template<class TYPE> class futureState : public RefCounted {
+    OryolClassDecl(futureState);
+public:
+    typedef InplaceFunction<void(TYPE&)> continuationFunc;
+
+    #if ORYOL_HAS_THREADS
+    std::mutex mutex;
+    #endif
+    TYPE value;
+    bool ready = false;
+    RunLoop* runLoop = nullptr;
+    continuationFunc continuation;
+};
+} // namespace _priv
+
+template<class TYPE> class Promise;
+
+template<class TYPE> class Future {
+public:
+    /// continuation function, called on the run loop's thread with the value
+    typedef typename _priv::futureState<TYPE>::continuationFunc ContinuationFunc;
+
+    /// return true if the future belongs to a promise
+    bool IsValid() const {
+        return this->state.isValid();
+    };
+    /// return true if the value has been set (thread-safe)
+    bool IsReady() const {
+        o_assert_dbg(this->state);
+        #if ORYOL_HAS_THREADS
+        std::lock_guard<std::mutex> lock(this->state->mutex);
+        #endif
+        return this->state->ready;
+    };
+    /// access the value, only valid when IsReady() returned true
+    TYPE& Value() const {
+        o_assert_dbg(this->state && this->state->ready);
+        return this->state->value;
+    };
+    /// call a function on a run loop's thread when the value has been set
+    void Then(RunLoop* runLoop, ContinuationFunc func) {
+        o_assert_dbg(this->state && runLoop && func);
+        Ptr<_priv::futureState<TYPE>> s = this->state;
+        {
+            #if ORYOL_HAS_THREADS
+            std::lock_guard<std::mutex> lock(s->mutex);
+            #endif
+            o_assert_dbg(!s->continuation);
+            s->runLoop = runLoop;
+            s->continuation = std::move(func);
+            if (!s->ready) {
+                // posted by SetValue()
+                return;
+            }
+        }
+        runLoop->Post([s] { s->continuation(s->value); });
+    };
+
+private:
+    friend class Promise<TYPE>;
+    Ptr<_priv::futureState<TYPE>> state;
+};
+
+template<class TYPE> class Promise {
+public:
+    /// constructor, creates the shared state
+    Promise() : state(_priv::futureState<TYPE>::Create()) { };
+    /// get the consuming end
+    Future<TYPE> GetFuture() const {
+        Future<TYPE> future;
+        future.state = this->state;
+        return future;
+    };
+    /// set the value and post the continuation if one is attached (thread-safe, only once)
+    void SetValue(TYPE value) const {
+        Ptr<_priv::futureState<TYPE>> s = this->state;
+        RunLoop* runLoop = nullptr;
+        {
+            #if ORYOL_HAS_THREADS
+            std::lock_guard<std::mutex> lock(s->mutex);
+            #endif
+            o_assert_dbg(!s->ready);
+            s->value = std::move(value);
+            s->ready = true;
+            runLoop = s->runLoop;
+        }
+        if (runLoop) {
+            runLoop->Post([s] { s->continuation(s->value); });
+        }
+    };
+
+private:
+    Ptr<_priv::futureState<TYPE>> state;
+};
+
+} // namespace Oryol
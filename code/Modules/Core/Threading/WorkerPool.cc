@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+//  WorkerPool.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "WorkerPool.h"
+#include "Core/Assertion.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+WorkerPool::WorkerPool() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+WorkerPool::~WorkerPool() {
+    if (this->valid) {
+        this->Discard();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+WorkerPool::Setup(int numWorkers) {
+    o_assert(!this->valid);
+    o_assert(numWorkers >= 0);
+    this->valid = true;
+    #if ORYOL_HAS_THREADS
+    this->stopRequested = false;
+    this->threads.Reserve(numWorkers);
+    for (int i = 0; i < numWorkers; i++) {
+        this->threads.Add(std::thread(threadFunc, this));
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+WorkerPool::Discard() {
+    o_assert(this->valid);
+    #if ORYOL_HAS_THREADS
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopRequested = true;
+    }
+    this->wakeCondVar.notify_all();
+    for (auto& thread : this->threads) {
+        thread.join();
+    }
+    this->threads.Clear();
+    #endif
+    this->valid = false;
+}
+
+//------------------------------------------------------------------------------
+bool
+WorkerPool::IsValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+int
+WorkerPool::NumWorkers() const {
+    #if ORYOL_HAS_THREADS
+    return this->threads.Size();
+    #else
+    return 0;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+WorkerPool::runChunks() {
+    int chunk;
+    while ((chunk = this->nextChunk++) < this->numChunks) {
+        const int begin = chunk * this->chunkSize;
+        const int end = (begin + this->chunkSize) < this->num ? (begin + this->chunkSize) : this->num;
+        (*this->rangeFunc)(begin, end);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+WorkerPool::ParallelFor(int num, int chunkSize, const RangeFunc& func) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(chunkSize > 0);
+    o_assert_dbg(func);
+    if (num <= 0) {
+        return;
+    }
+    const int numChunks = (num + chunkSize - 1) / chunkSize;
+    if ((1 == numChunks) || (0 == this->NumWorkers())) {
+        // not worth waking up the workers
+        for (int begin = 0; begin < num; begin += chunkSize) {
+            func(begin, (begin + chunkSize) < num ? (begin + chunkSize) : num);
+        }
+        return;
+    }
+
+    #if ORYOL_HAS_THREADS
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->rangeFunc = &func;
+        this->num = num;
+        this->chunkSize = chunkSize;
+        this->numChunks = numChunks;
+        this->nextChunk = 0;
+        this->generation++;
+    }
+    this->wakeCondVar.notify_all();
+
+    // the calling thread helps out, then waits for the workers which
+    // are still busy with the chunks they picked up, once the calling
+    // thread runs out of chunks, no other worker can join in
+    this->runChunks();
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->doneCondVar.wait(lock, [this] { return 0 == this->numBusy; });
+    this->rangeFunc = nullptr;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+WorkerPool::Async(JobFunc func) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(func);
+    if (0 == this->NumWorkers()) {
+        func();
+        return;
+    }
+    #if ORYOL_HAS_THREADS
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->jobs.Enqueue(std::move(func));
+    }
+    this->wakeCondVar.notify_one();
+    #endif
+}
+
+#if ORYOL_HAS_THREADS
+//------------------------------------------------------------------------------
+void
+WorkerPool::threadFunc(WorkerPool* self) {
+    int generation = 0;
+    for (;;) {
+        JobFunc job;
+        bool chunks = false;
+        {
+            std::unique_lock<std::mutex> lock(self->mutex);
+            self->wakeCondVar.wait(lock, [self, generation] {
+                return self->stopRequested || (generation != self->generation) || !self->jobs.Empty();
+            });
+            if (generation != self->generation) {
+                // chunks come first, but only join in if there are chunks
+                // left (the ParallelFor() might already be done if this
+                // worker was busy with a job)
+                generation = self->generation;
+                if (self->nextChunk < self->numChunks) {
+                    self->numBusy++;
+                    chunks = true;
+                }
+            }
+            else if (!self->jobs.Empty()) {
+                job = self->jobs.Dequeue();
+            }
+            else {
+                // stop requested and no jobs left
+                return;
+            }
+        }
+        if (job) {
+            job();
+            continue;
+        }
+        if (!chunks) {
+            continue;
+        }
+        self->runChunks();
+        {
+            std::lock_guard<std::mutex> lock(self->mutex);
+            if (0 == --self->numBusy) {
+                self->doneCondVar.notify_one();
+            }
+        }
+    }
+}
+#endif
+
+} // namespace Oryol
@@ -0,0 +1,93 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::WorkerPool
+    @ingroup Core
+    @brief a small pool of worker threads for data-parallel loops
+
+    The WorkerPool runs a range function over [0, num) split into
+    fixed-size chunks. The chunks are distributed over the worker
+    threads and the calling thread, ParallelFor() returns when all
+    chunks have been processed. Chunks are handed out through an
+    atomic counter, so unevenly expensive chunks are balanced
+    automatically.
+
+    The range function must only touch the data of its own chunk.
+    On platforms without threads (or with 0 worker threads), all
+    chunks are processed on the calling thread.
+
+    Async() hands a single job to the next free worker thread and
+    returns immediately, use a Promise to get a result back. Pending
+    ParallelFor() chunks are picked up before queued jobs, and
+    Discard() waits until all queued jobs have run. ParallelFor() only
+    waits for the workers which actually picked up chunks, so a worker
+    which is busy with a long-running job doesn't hold it up, its
+    share of the chunks is processed by the other threads. A job must
+    not call ParallelFor() on its own pool (it would wait for itself).
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Queue.h"
+#include <functional>
+#if ORYOL_HAS_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#endif
+
+namespace Oryol {
+
+class WorkerPool {
+public:
+    /// range function, called with [begin, end) of a chunk
+    typedef std::function<void(int begin, int end)> RangeFunc;
+    /// job function for Async()
+    typedef std::function<void()> JobFunc;
+
+    /// constructor
+    WorkerPool();
+    /// destructor
+    ~WorkerPool();
+
+    /// start the worker threads (0 is valid and runs everything on the calling thread)
+    void Setup(int numWorkers);
+    /// stop the worker threads
+    void Discard();
+    /// return true if the pool has been setup
+    bool IsValid() const;
+    /// get number of worker threads (not including the calling thread)
+    int NumWorkers() const;
+    /// process [0, num) in chunks of chunkSize, blocks until all chunks are done
+    void ParallelFor(int num, int chunkSize, const RangeFunc& func);
+    /// run a job on a worker thread without waiting for it (on the calling thread without workers)
+    void Async(JobFunc func);
+
+private:
+    /// process chunks until no chunks are left
+    void runChunks();
+
+    bool valid = false;
+    const RangeFunc* rangeFunc = nullptr;
+    int num = 0;
+    int chunkSize = 0;
+    int numChunks = 0;
+    #if ORYOL_HAS_THREADS
+    /// worker thread function
+    static void threadFunc(WorkerPool* self);
+
+    Array<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wakeCondVar;
+    std::condition_variable doneCondVar;
+    Queue<JobFunc> jobs;
+    std::atomic<int> nextChunk{0};
+    int generation = 0;
+    int numBusy = 0;        // workers which are processing chunks of the current ParallelFor()
+    bool stopRequested = false;
+    #else
+    int nextChunk = 0;
+    #endif
+};
+
+} // namespace Oryol
@@ -85,3 +85,21 @@ TEST(BufferTest) {
     CHECK(buf2.Capacity() == 21);
     CHECK(buf2.Spare() == 21);
 }
+
+TEST(LargeBufferTest) {
+    // big buffers go through Memory::AllocLarge()
+    const int numAllocs = Memory::QueryLargeAllocStats().NumAllocs;
+    Buffer buf;
+    buf.Reserve(ORYOL_LARGE_ALLOC_THRESHOLD / 2);
+    CHECK(Memory::QueryLargeAllocStats().NumAllocs == numAllocs);
+    const uint8_t bla[] = { 1, 2, 3, 4 };
+    buf.Add(bla, sizeof(bla));
+    buf.Reserve(ORYOL_LARGE_ALLOC_THRESHOLD);
+    CHECK(Memory::QueryLargeAllocStats().NumAllocs == numAllocs + 1);
+    CHECK(buf.Size() == 4);
+    CHECK((buf.Data()[0] == 1) && (buf.Data()[3] == 4));
+    Buffer buf2(std::move(buf));
+    CHECK(Memory::QueryLargeAllocStats().NumAllocs == numAllocs + 1);
+    buf2 = Buffer();
+    CHECK(Memory::QueryLargeAllocStats().NumAllocs == numAllocs);
+}
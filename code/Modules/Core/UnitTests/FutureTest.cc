@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+//  FutureTest.cc
+//  Test Future and Promise classes.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Threading/Future.h"
+#include "Core/Containers/Array.h"
+#include <thread>
+
+using namespace Oryol;
+
+TEST(FutureTest) {
+    RunLoop runLoop;
+
+    // continuation attached before the value is set
+    Promise<int> p0;
+    Future<int> f0 = p0.GetFuture();
+    CHECK(f0.IsValid());
+    CHECK(!f0.IsReady());
+    int result0 = 0;
+    f0.Then(&runLoop, [&result0](int& val) { result0 = val; });
+    runLoop.Run();
+    CHECK(result0 == 0);
+    p0.SetValue(23);
+    CHECK(f0.IsReady());
+    CHECK(f0.Value() == 23);
+    CHECK(result0 == 0);
+    runLoop.Run();
+    CHECK(result0 == 23);
+
+    // continuation attached after the value is set
+    Promise<int> p1;
+    Future<int> f1 = p1.GetFuture();
+    p1.SetValue(42);
+    int result1 = 0;
+    f1.Then(&runLoop, [&result1](int& val) { result1 = val; });
+    CHECK(result1 == 0);
+    runLoop.Run();
+    CHECK(result1 == 42);
+
+    // a default-constructed future has no promise
+    Future<int> f2;
+    CHECK(!f2.IsValid());
+}
+
+TEST(FutureThreadTest) {
+    RunLoop runLoop;
+    const int numThreads = 4;
+    std::thread threads[numThreads];
+    Array<Future<Array<int>>> futures;
+    Array<int> sums;
+    for (int i = 0; i < numThreads; i++) {
+        Promise<Array<int>> promise;
+        futures.Add(promise.GetFuture());
+        futures.Back().Then(&runLoop, [&sums](Array<int>& val) {
+            // called on the run loop's thread
+            sums.Add(val.Size());
+        });
+        threads[i] = std::thread([promise, i] {
+            Array<int> val;
+            for (int j = 0; j < (i + 1) * 100; j++) {
+                val.Add(j);
+            }
+            promise.SetValue(std::move(val));
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& future : futures) {
+        CHECK(future.IsReady());
+    }
+    CHECK(sums.Empty());
+    runLoop.Run();
+    CHECK(sums.Size() == numThreads);
+    int total = 0;
+    for (int sum : sums) {
+        total += sum;
+    }
+    CHECK(total == 1000);
+}
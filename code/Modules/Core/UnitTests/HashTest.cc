@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+//  HashTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Hash/Hash.h"
+#include "Core/Containers/HashSet.h"
+#include "Core/Containers/Set.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Log.h"
+#include <chrono>
+
+using namespace Oryol;
+
+TEST(HashTest) {
+
+    // wyhash test vectors
+    CHECK(Hash::Bytes("", 0, 0) == 0x0409638ee2bde459ULL);
+    CHECK(Hash::Bytes("a", 1, 1) == 0xa8412d091b5fe0a9ULL);
+    CHECK(Hash::Bytes("abc", 3, 2) == 0x32dd92e4b2915153ULL);
+    CHECK(Hash::CStr("message digest", 3) == 0x8619124089a3a16bULL);
+    CHECK(Hash::CStr("abcdefghijklmnopqrstuvwxyz", 4) == 0x7a43afb61d7f5f40ULL);
+    CHECK(Hash::CStr("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 5) == 0xff42329b90e50d58ULL);
+    CHECK(Hash::CStr("12345678901234567890123456789012345678901234567890123456789012345678901234567890", 6) == 0xc39cab13b115aad3ULL);
+
+    // compile time string hash
+    static_assert(Hash::Literal("") == 0xcbf29ce484222325ULL, "Hash::Literal() failed");
+    static_assert(Hash::Literal("a") == 0xaf63dc4c8601ec8cULL, "Hash::Literal() failed");
+    const uint64_t lit = Hash::Literal("foobar");
+    CHECK(lit == 0x85944171f73967e8ULL);
+    switch (lit) {
+        case Hash::Literal("foobar"): break;
+        default: CHECK(false); break;
+    }
+
+    // hash traits
+    CHECK(HashTraits<String>::Compute(String("Bla")) == Hash::CStr("Bla"));
+    CHECK(HashTraits<StringAtom>::Compute(StringAtom("Bla")) == Hash::CStr("Bla"));
+    CHECK(HashTraits<int>::Compute(1) != HashTraits<int>::Compute(2));
+    CHECK(HashTraits<int>::Compute(1) == HashTraits<int>::Compute(1));
+    HashSet<String, HashFunc<String>, 16> hashSet;
+    hashSet.Add("Bla");
+    hashSet.Add("Blub");
+    CHECK(hashSet.Contains("Bla"));
+    CHECK(hashSet.Contains("Blub"));
+    CHECK(!hashSet.Contains("Blob"));
+}
+
+TEST(HashBuilderTest) {
+
+    // the incremental hash must match Hash::Bytes() for all
+    // lengths and any split of the input data
+    uint8_t data[256];
+    for (int i = 0; i < int(sizeof(data)); i++) {
+        data[i] = uint8_t(i * 7 + 3);
+    }
+    for (int len = 0; len <= int(sizeof(data)); len++) {
+        const uint64_t h = Hash::Bytes(data, len, 23);
+        HashBuilder oneChunk(23);
+        oneChunk.Add(data, len);
+        CHECK(oneChunk.Result() == h);
+        for (int chunkSize = 1; chunkSize < 64; chunkSize += 5) {
+            HashBuilder builder(23);
+            for (int offset = 0; offset < len; offset += chunkSize) {
+                const int num = (len - offset) < chunkSize ? (len - offset) : chunkSize;
+                builder.Add(data + offset, num);
+            }
+            CHECK(builder.Result() == h);
+        }
+    }
+
+    HashBuilder builder;
+    const int32_t i0 = 1;
+    const float f0 = 2.0f;
+    builder.AddValue(i0);
+    builder.AddValue(f0);
+    uint8_t raw[8];
+    std::memcpy(raw, &i0, 4);
+    std::memcpy(raw + 4, &f0, 4);
+    CHECK(builder.Result() == Hash::Bytes(raw, 8));
+    builder.Reset();
+    CHECK(builder.Result() == Hash::Bytes(nullptr, 0));
+}
+
+TEST(HashPerformance) {
+    const int numBytes = 16 * 1024 * 1024;
+    uint8_t* data = (uint8_t*) Memory::Alloc(numBytes);
+    Memory::Fill(data, numBytes, 0x23);
+    for (int run = 0; run < 3; run++) {
+        std::chrono::time_point<std::chrono::system_clock> start = std::chrono::system_clock::now();
+        uint64_t h = Hash::Bytes(data, numBytes);
+        std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+        Log::Info("run %d: Hash::Bytes(%d bytes): %f sec (%.2f GB/s) (hash: 0x%llx)\n",
+            run, numBytes, dur.count(), (numBytes / dur.count()) / (1024.0 * 1024.0 * 1024.0), (unsigned long long)h);
+    }
+
+    // small keys
+    const int numKeys = 1000000;
+    uint64_t h = 0;
+    std::chrono::time_point<std::chrono::system_clock> start = std::chrono::system_clock::now();
+    for (int i = 0; i < numKeys; i++) {
+        h += Hash::Bytes(data + (i & 1023), 16);
+    }
+    std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+    Log::Info("%d x Hash::Bytes(16 bytes): %f sec (hash: 0x%llx)\n", numKeys, dur.count(), (unsigned long long)h);
+    Memory::Free(data);
+}
@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+//  InplaceFunctionTest.cc
+//  Test InplaceFunction class.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/InplaceFunction.h"
+#include "Core/String/String.h"
+
+using namespace Oryol;
+
+static int freeFunc(int a, int b) {
+    return a + b;
+}
+
+static int numAlive = 0;
+struct counted {
+    counted() { numAlive++; }
+    counted(const counted&) { numAlive++; }
+    counted(counted&&) { numAlive++; }
+    ~counted() { numAlive--; }
+};
+
+TEST(InplaceFunctionTest) {
+
+    // empty functions
+    InplaceFunction<void()> f0;
+    CHECK(!f0);
+    InplaceFunction<void()> f1(nullptr);
+    CHECK(!f1);
+
+    // free functions and lambdas
+    InplaceFunction<int(int, int)> add(&freeFunc);
+    CHECK(add);
+    CHECK(add(1, 2) == 3);
+    int x = 0;
+    InplaceFunction<void(int)> inc([&x](int val) { x += val; });
+    inc(3);
+    inc(4);
+    CHECK(x == 7);
+
+    // mutable lambdas keep their state
+    int n = 0;
+    InplaceFunction<int()> counter([n]() mutable { return ++n; });
+    CHECK(counter() == 1);
+    CHECK(counter() == 2);
+
+    // arguments by value, reference and rvalue
+    String str("Bla");
+    InplaceFunction<bool(String, const String&)> equal([](String a, const String& b) {
+        return a == b;
+    });
+    CHECK(equal("Bla", str));
+    CHECK(!equal("Blub", str));
+
+    // moving transfers the callable, clearing destroys it
+    numAlive = 0;
+    {
+        counted c;
+        InplaceFunction<void()> f2([c] { });
+        CHECK(numAlive == 2);
+        InplaceFunction<void()> f3(std::move(f2));
+        CHECK(!f2);
+        CHECK(f3);
+        CHECK(numAlive == 2);
+        f3 = nullptr;
+        CHECK(!f3);
+        CHECK(numAlive == 1);
+        f3 = InplaceFunction<void()>([c] { });
+        CHECK(numAlive == 2);
+    }
+    CHECK(numAlive == 0);
+
+    // a bigger inline buffer for bigger captures
+    struct big {
+        uint64_t vals[16];
+    };
+    big b = { };
+    b.vals[15] = 23;
+    InplaceFunction<uint64_t(), sizeof(big)> getBig([b] { return b.vals[15]; });
+    CHECK(getBig() == 23);
+}
@@ -75,4 +75,49 @@ TEST(Memory) {
     CHECK((intptr_t(ptr) & (ORYOL_MAX_PLATFORM_ALIGN - 1)) == 0);
 }
 
+//------------------------------------------------------------------------------
+TEST(MemoryLarge) {
+    const Memory::LargeAllocStats stats0 = Memory::QueryLargeAllocStats();
+
+    // large allocations are cache-line aligned and writable
+    const int size0 = 3 * 1024 * 1024;
+    uint8_t* p0 = (uint8_t*) Memory::AllocLarge(size0);
+    CHECK(p0);
+    CHECK((intptr_t(p0) & 63) == 0);
+    p0[0] = 1;
+    p0[size0 - 1] = 2;
+    const int size1 = 100000;
+    uint8_t* p1 = (uint8_t*) Memory::AllocLarge(size1, true);
+    CHECK(p1);
+    Memory::Fill(p1, size1, 0xAB);
+    CHECK(p1[size1 - 1] == 0xAB);
+
+    Memory::LargeAllocStats stats1 = Memory::QueryLargeAllocStats();
+    CHECK(stats1.NumAllocs == stats0.NumAllocs + 2);
+    CHECK(stats1.NumBytes == stats0.NumBytes + size0 + size1);
+    CHECK(stats1.NumHugePageBytes >= stats0.NumHugePageBytes);
+    Memory::FreeLarge(p0);
+    Memory::FreeLarge(p1);
+    stats1 = Memory::QueryLargeAllocStats();
+    CHECK(stats1.NumAllocs == stats0.NumAllocs);
+    CHECK(stats1.NumBytes == stats0.NumBytes);
+    CHECK(stats1.NumHugePageBytes == stats0.NumHugePageBytes);
+    CHECK(stats1.NumAdvisedBytes == stats0.NumAdvisedBytes);
+
+    // a 2 MB allocation doesn't need more than 2 MB of pages,
+    // and is 2 MB aligned when mapped from the OS
+    const int size2 = ORYOL_LARGE_ALLOC_THRESHOLD;
+    uint8_t* p2 = (uint8_t*) Memory::AllocLarge(size2);
+    CHECK(p2);
+    p2[size2 - 1] = 3;
+    stats1 = Memory::QueryLargeAllocStats();
+    CHECK((stats1.NumHugePageBytes - stats0.NumHugePageBytes) <= size2);
+    CHECK((stats1.NumAdvisedBytes - stats0.NumAdvisedBytes) <= size2);
+    if ((stats1.NumHugePageBytes > stats0.NumHugePageBytes) || (stats1.NumAdvisedBytes > stats0.NumAdvisedBytes)) {
+        CHECK((intptr_t(p2) & (size2 - 1)) == 0);
+    }
+    Memory::FreeLarge(p2);
+    CHECK(Memory::QueryLargeAllocStats().NumAllocs == stats0.NumAllocs);
+}
+
 
@@ -28,3 +28,20 @@ TEST(PoolAllocator) {
     CHECK(obj == obj1);
     allocatorOne.Destroy(obj1);
 }
+
+TEST(PoolAllocatorNodeLocal) {
+    // big elements, so that a puddle goes through Memory::AllocLarge()
+    struct bigElement {
+        uint8_t data[16 * 1024];
+    };
+    const int numAllocs = Memory::QueryLargeAllocStats().NumAllocs;
+    {
+        poolAllocator<bigElement> allocator;
+        allocator.SetNodeLocal(true);
+        bigElement* elm = allocator.Create();
+        CHECK(elm);
+        CHECK(Memory::QueryLargeAllocStats().NumAllocs == numAllocs + 1);
+        allocator.Destroy(elm);
+    }
+    CHECK(Memory::QueryLargeAllocStats().NumAllocs == numAllocs);
+}
@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------------
+//  RelocatableTest.cc
+//  Test containers with trivially relocatable element types.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/RefCounted.h"
+#include "Core/Ptr.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Map.h"
+#include "Core/Containers/Queue.h"
+#include "Core/String/String.h"
+#include "Core/String/StringAtom.h"
+#include "Core/String/StringBuilder.h"
+#include "Core/Time/Clock.h"
+#include "Core/Log.h"
+
+using namespace Oryol;
+
+class RelocTestClass : public RefCounted {
+    OryolClassDecl(RelocTestClass);
+public:
+    RelocTestClass(int v) : val(v) { };
+    int val;
+};
+
+/// same as Ptr, but without the trivially relocatable opt-in
+struct nonRelocPtr {
+    nonRelocPtr() { };
+    nonRelocPtr(const Ptr<RelocTestClass>& p) : ptr(p) { };
+    Ptr<RelocTestClass> ptr;
+};
+
+TEST(RelocatableTraitTest) {
+    CHECK(IsTriviallyRelocatable<int>::Value);
+    CHECK(IsTriviallyRelocatable<Ptr<RelocTestClass>>::Value);
+    CHECK(IsTriviallyRelocatable<String>::Value);
+    CHECK(IsTriviallyRelocatable<StringAtom>::Value);
+    CHECK((IsTriviallyRelocatable<KeyValuePair<StringAtom, Ptr<RelocTestClass>>>::Value));
+    CHECK(!IsTriviallyRelocatable<nonRelocPtr>::Value);
+    CHECK(!(IsTriviallyRelocatable<KeyValuePair<StringAtom, nonRelocPtr>>::Value));
+}
+
+TEST(RelocatableArrayTest) {
+    Array<Ptr<RelocTestClass>> objs;
+    for (int i = 0; i < 16; i++) {
+        objs.Add(RelocTestClass::Create(i));
+    }
+    Ptr<RelocTestClass> obj = objs[5];
+    CHECK(obj->GetRefCount() == 2);
+
+    // growth must not touch the ref counts
+    for (int i = 16; i < 1000; i++) {
+        objs.Add(RelocTestClass::Create(i));
+    }
+    CHECK(obj->GetRefCount() == 2);
+    for (int i = 0; i < objs.Size(); i++) {
+        CHECK(objs[i]->val == i);
+        CHECK(objs[i]->GetRefCount() == (i == 5 ? 2 : 1));
+    }
+
+    // insert and erase at front, middle and back
+    objs.Insert(0, RelocTestClass::Create(-1));
+    objs.Insert(500, RelocTestClass::Create(-2));
+    objs.Insert(objs.Size() - 1, RelocTestClass::Create(-3));
+    CHECK(objs.Size() == 1003);
+    CHECK(objs[0]->val == -1);
+    CHECK(objs[1]->val == 0);
+    CHECK(objs[500]->val == -2);
+    CHECK(objs[501]->val == 499);
+    CHECK(objs[1001]->val == -3);
+    CHECK(objs[1002]->val == 999);
+    objs.Erase(500);
+    objs.Erase(0);
+    objs.Erase(objs.Size() - 2);
+    CHECK(objs.Size() == 1000);
+    for (int i = 0; i < objs.Size(); i++) {
+        CHECK(objs[i]->val == i);
+        CHECK(objs[i]->GetRefCount() == (i == 5 ? 2 : 1));
+    }
+    objs.Erase(3);
+    CHECK(objs[3]->val == 4);
+    objs.Erase(990);
+    CHECK(objs[990]->val == 992);
+    CHECK(obj->GetRefCount() == 2);
+
+    // erase-swap (may swap in from the front or the back)
+    objs.EraseSwap(5);
+    CHECK(obj->GetRefCount() == 2);
+    objs.EraseSwap(objs.FindIndexLinear(obj));
+    CHECK(obj->GetRefCount() == 1);
+    CHECK(objs.Size() == 996);
+    for (const auto& elm : objs) {
+        CHECK(elm->GetRefCount() == 1);
+    }
+
+    // shrinking with front spare
+    objs.Trim();
+    CHECK(objs.Capacity() == objs.Size());
+    for (const auto& elm : objs) {
+        CHECK(elm->GetRefCount() == 1);
+    }
+    objs.Clear();
+    CHECK(obj->GetRefCount() == 1);
+}
+
+static String
+str(const char* fmt, int i) {
+    StringBuilder strBuilder;
+    strBuilder.Format(32, fmt, i);
+    return strBuilder.GetString();
+}
+
+TEST(RelocatableMapQueueTest) {
+    Map<StringAtom, String> map;
+    for (int i = 0; i < 500; i++) {
+        StringAtom key(str("key_%d", i));
+        map.Add(key, key.AsString());
+    }
+    CHECK(map.Size() == 500);
+    for (int i = 0; i < 500; i++) {
+        StringAtom key(str("key_%d", i));
+        CHECK(map[key] == key.AsString());
+    }
+    map.Erase(StringAtom("key_250"));
+    CHECK(!map.Contains(StringAtom("key_250")));
+    CHECK(map[StringAtom("key_251")] == "key_251");
+
+    Queue<String> queue;
+    for (int i = 0; i < 100; i++) {
+        queue.Enqueue(str("%d", i));
+        if (0 == (i & 1)) {
+            CHECK(queue.Dequeue() == str("%d", i / 2));
+        }
+    }
+    CHECK(queue.Size() == 50);
+    CHECK(queue.Dequeue() == "50");
+}
+
+TEST(RelocatableGrowthBenchmark) {
+    const int num = 100000;
+    Ptr<RelocTestClass> obj = RelocTestClass::Create(0);
+
+    TimePoint start = Clock::Now();
+    Array<nonRelocPtr> nonReloc;
+    for (int i = 0; i < num; i++) {
+        nonReloc.Add(nonRelocPtr(obj));
+    }
+    Duration nonRelocTime = Clock::Since(start);
+
+    start = Clock::Now();
+    Array<Ptr<RelocTestClass>> reloc;
+    for (int i = 0; i < num; i++) {
+        reloc.Add(obj);
+    }
+    Duration relocTime = Clock::Since(start);
+    CHECK(obj->GetRefCount() == 2 * num + 1);
+
+    Log::Info("Array growth: %d elements, move-construct=%.3fms, relocate=%.3fms\n",
+        num, nonRelocTime.AsMilliSeconds(), relocTime.AsMilliSeconds());
+}
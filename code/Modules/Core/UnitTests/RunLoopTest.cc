@@ -5,6 +5,8 @@
 #include "Pre.h"
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/RunLoop.h"
+#include "Core/Containers/Array.h"
+#include <thread>
 
 using namespace Oryol;
 
@@ -29,3 +31,51 @@ TEST(RunLoopTest) {
     CHECK(x == 2);
     CHECK(y == 4);
 }
+
+TEST(RunLoopPostTest) {
+    RunLoop runLoop;
+    Array<int> calls;
+    runLoop.Post([&calls] { calls.Add(0); });
+    runLoop.Post([&calls] { calls.Add(1); });
+    CHECK(calls.Empty());
+    runLoop.Run();
+    CHECK((calls.Size() == 2) && (calls[0] == 0) && (calls[1] == 1));
+
+    // functions posted while draining are called in the next Run()
+    runLoop.Post([&runLoop, &calls] {
+        calls.Add(2);
+        runLoop.Post([&calls] { calls.Add(3); });
+    });
+    runLoop.Run();
+    CHECK((calls.Size() == 3) && (calls[2] == 2));
+    runLoop.Run();
+    CHECK((calls.Size() == 4) && (calls[3] == 3));
+
+    // post from many threads
+    const int numThreads = 4;
+    const int numPosts = 1000;
+    std::atomic<int> counter{0};
+    std::thread threads[numThreads];
+    for (auto& thread : threads) {
+        thread = std::thread([&runLoop, &counter] {
+            for (int i = 0; i < numPosts; i++) {
+                runLoop.Post([&counter] { counter++; });
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    runLoop.Run();
+    CHECK(counter == numThreads * numPosts);
+
+    // with a tiny budget, functions are deferred to the next Run()
+    runLoop.SetInboxBudget(Duration(1));
+    for (int i = 0; i < 4; i++) {
+        runLoop.Post([] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+    }
+    runLoop.Run();
+    CHECK(runLoop.NumDeferred() == 3);
+    runLoop.Run();
+    CHECK(runLoop.NumDeferred() == 2);
+}
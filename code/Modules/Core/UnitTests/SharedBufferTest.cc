@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+//  SharedBufferTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/SharedBuffer.h"
+
+using namespace Oryol;
+
+TEST(SharedBufferTest) {
+
+    SharedBuffer empty;
+    CHECK(empty.Size() == 0);
+    CHECK(empty.Empty());
+    CHECK(empty.UseCount() == 0);
+
+    // take ownership of a Buffer, this must not copy the data
+    static const uint8_t bla[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    Buffer buf;
+    buf.Add(bla, sizeof(bla));
+    const uint8_t* bufPtr = buf.Data();
+    SharedBuffer sb0(std::move(buf));
+    CHECK(buf.Empty());
+    CHECK(sb0.Size() == 8);
+    CHECK(!sb0.Empty());
+    CHECK(sb0.Data() == bufPtr);
+    CHECK(sb0.UseCount() == 1);
+
+    // copies share the payload
+    SharedBuffer sb1 = sb0;
+    CHECK(sb1.Data() == sb0.Data());
+    CHECK(sb1.Size() == 8);
+    CHECK(sb0.UseCount() == 2);
+
+    // slicing
+    SharedBuffer slice0 = sb0.Slice(2, 4);
+    CHECK(slice0.Size() == 4);
+    CHECK(slice0.Data() == bufPtr + 2);
+    CHECK(slice0.Data()[0] == 3);
+    CHECK(slice0.Data()[3] == 6);
+    CHECK(sb0.UseCount() == 3);
+    SharedBuffer slice1 = slice0.Slice(1);
+    CHECK(slice1.Size() == 3);
+    CHECK(slice1.Data()[0] == 4);
+    CHECK(slice1.Data()[2] == 6);
+    SharedBuffer slice2 = sb0.Slice(8);
+    CHECK(slice2.Empty());
+
+    // move
+    SharedBuffer sb2(std::move(sb1));
+    CHECK(sb1.Empty());
+    CHECK(sb1.UseCount() == 0);
+    CHECK(sb2.Size() == 8);
+    CHECK(sb2.UseCount() == 5);
+    sb2.Clear();
+    CHECK(sb2.Empty());
+    CHECK(sb0.UseCount() == 4);
+
+    // copy from raw data
+    SharedBuffer sb3 = SharedBuffer::Copy(bla, sizeof(bla));
+    CHECK(sb3.Size() == 8);
+    CHECK(sb3.Data() != bla);
+    for (int i = 0; i < int(sizeof(bla)); i++) {
+        CHECK(sb3.Data()[i] == bla[i]);
+    }
+
+    // wrap external memory with custom deleter
+    int numDeleterCalls = 0;
+    {
+        SharedBuffer wrapped = SharedBuffer::Wrap(bla, sizeof(bla), [&numDeleterCalls](const uint8_t* ptr, int size) {
+            CHECK(ptr == bla);
+            CHECK(size == 8);
+            numDeleterCalls++;
+        });
+        CHECK(wrapped.Data() == bla);
+        SharedBuffer wrappedSlice = wrapped.Slice(4, 4);
+        wrapped.Clear();
+        CHECK(numDeleterCalls == 0);
+        CHECK(wrappedSlice.Data()[0] == 5);
+    }
+    CHECK(numDeleterCalls == 1);
+
+    // wrap without deleter (e.g. static or arena memory)
+    SharedBuffer wrapped = SharedBuffer::Wrap(bla, sizeof(bla));
+    CHECK(wrapped.Data() == bla);
+    CHECK(wrapped.Size() == 8);
+}
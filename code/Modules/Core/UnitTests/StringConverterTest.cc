@@ -4,6 +4,9 @@
 #include "Pre.h"
 #include "UnitTest++/src/UnitTest++.h"
 #include "Core/String/StringConverter.h"
+#include "Core/String/ConvertUTF.h"
+#include "Core/Log.h"
+#include <chrono>
 
 using namespace Oryol;
 
@@ -37,6 +40,113 @@ TEST(StringConverterTest_UTF8) {
     CHECK(ldst == longString);
 }
 
+TEST(StringConverterTest_UTF8Validation) {
+
+    // mixed ASCII and multi-byte sequences, long enough to cross the
+    // 16-byte SIMD block boundaries at different positions
+    const unsigned char mixed[] = "0123456789ABCDEF\xc3\xa4" "0123456789ABC\xe2\x82\xac" "xyz\xf0\x9f\x98\x80" "0123456789ABCDEFGHIJ";
+    const int mixedLen = int(sizeof(mixed) - 1);
+    CHECK(StringConverter::IsValidUTF8(mixed, mixedLen));
+    const int numChars = StringConverter::UTF8ToWideLength(mixed, mixedLen);
+    CHECK(numChars == (sizeof(wchar_t) == 4 ? 55 : 56));
+    WideString wide = StringConverter::UTF8ToWide(mixed, mixedLen);
+    CHECK(wide.Length() == numChars);
+    CHECK(wide.AsCStr()[16] == 0xE4);
+    CHECK(wide.AsCStr()[30] == 0x20AC);
+    if (4 == sizeof(wchar_t)) {
+        CHECK(uint32_t(wide.AsCStr()[34]) == 0x1F600);
+    }
+    else {
+        CHECK(wide.AsCStr()[34] == 0xD83D);
+        CHECK(wide.AsCStr()[35] == 0xDE00);
+    }
+    CHECK(StringConverter::WideToUTF8Length(wide.AsCStr(), wide.Length()) == mixedLen);
+    String utf8 = StringConverter::WideToUTF8(wide);
+    CHECK(utf8.Length() == mixedLen);
+    CHECK(0 == std::memcmp(utf8.AsCStr(), mixed, mixedLen));
+
+    // invalid sequences
+    const unsigned char cont[] = "0123456789ABCDEFGH\x80";
+    const unsigned char overlong[] = "\xc0\xaf";
+    const unsigned char overlong3[] = "\xe0\x80\xaf";
+    const unsigned char surrogate[] = "\xed\xa0\x80";
+    const unsigned char tooLarge[] = "\xf4\x90\x80\x80";
+    const unsigned char truncated[] = "abc\xe2\x82";
+    CHECK(!StringConverter::IsValidUTF8(cont, sizeof(cont) - 1));
+    CHECK(!StringConverter::IsValidUTF8(overlong, sizeof(overlong) - 1));
+    CHECK(!StringConverter::IsValidUTF8(overlong3, sizeof(overlong3) - 1));
+    CHECK(!StringConverter::IsValidUTF8(surrogate, sizeof(surrogate) - 1));
+    CHECK(!StringConverter::IsValidUTF8(tooLarge, sizeof(tooLarge) - 1));
+    CHECK(!StringConverter::IsValidUTF8(truncated, sizeof(truncated) - 1));
+    CHECK(StringConverter::UTF8ToWide(cont, sizeof(cont) - 1).Empty());
+    CHECK(StringConverter::UTF8ToWide(truncated, sizeof(truncated) - 1).Empty());
+
+    // destination too small
+    wchar_t smallBuf[8];
+    CHECK(0 == StringConverter::UTF8ToWide(mixed, mixedLen, smallBuf, sizeof(smallBuf)));
+    CHECK(8 == StringConverter::UTF8ToWide(mixed, 7, smallBuf, sizeof(smallBuf)));
+    CHECK(smallBuf[7] == 0);
+}
+
+TEST(StringConverterTest_UTF8Performance) {
+
+    // compare against the ConvertUTF reference implementation
+    const int numBytes = 1024 * 1024;
+    unsigned char* text = (unsigned char*) Memory::Alloc(numBytes + 1);
+    for (int i = 0; i < numBytes; i++) {
+        text[i] = 'a' + (i % 26);
+        if ((i % 200) == 199) {
+            // 2-byte sequence (U+00E4)
+            text[i - 1] = 0xC3;
+            text[i] = 0xA4;
+        }
+    }
+    text[numBytes] = 0;
+    const int dstBytes = (numBytes + 1) * sizeof(wchar_t);
+    wchar_t* dst = (wchar_t*) Memory::Alloc(dstBytes);
+    wchar_t* refDst = (wchar_t*) Memory::Alloc(dstBytes);
+
+    for (int run = 0; run < 3; run++) {
+        std::chrono::time_point<std::chrono::system_clock> start = std::chrono::system_clock::now();
+        const int numChars = StringConverter::UTF8ToWide(text, numBytes, dst, dstBytes);
+        std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+        Log::Info("run %d: StringConverter::UTF8ToWide(%d bytes): %f sec\n", run, numBytes, dur.count());
+
+        const UTF8* srcPtr = text;
+        start = std::chrono::system_clock::now();
+        int refNumChars = 0;
+        if (4 == sizeof(wchar_t)) {
+            UTF32* dstPtr = (UTF32*) refDst;
+            ConvertUTF8toUTF32(&srcPtr, text + numBytes, &dstPtr, dstPtr + numBytes, strictConversion);
+            refNumChars = int(dstPtr - (UTF32*)refDst);
+        }
+        else {
+            UTF16* dstPtr = (UTF16*) refDst;
+            ConvertUTF8toUTF16(&srcPtr, text + numBytes, &dstPtr, dstPtr + numBytes, strictConversion);
+            refNumChars = int(dstPtr - (UTF16*)refDst);
+        }
+        dur = std::chrono::system_clock::now() - start;
+        Log::Info("run %d: ConvertUTF8toUTF%d(%d bytes): %f sec\n", run, int(sizeof(wchar_t) * 8), numBytes, dur.count());
+
+        CHECK(numChars == (refNumChars + 1));
+        CHECK(0 == std::memcmp(dst, refDst, refNumChars * sizeof(wchar_t)));
+    }
+
+    for (int run = 0; run < 3; run++) {
+        std::chrono::time_point<std::chrono::system_clock> start = std::chrono::system_clock::now();
+        WideString wide = StringConverter::UTF8ToWide(text, numBytes);
+        String utf8 = StringConverter::WideToUTF8(wide);
+        std::chrono::duration<double> dur = std::chrono::system_clock::now() - start;
+        Log::Info("run %d: UTF-8 => WideString => String roundtrip (%d bytes): %f sec\n", run, numBytes, dur.count());
+        CHECK(utf8.Length() == numBytes);
+        CHECK(0 == std::memcmp(utf8.AsCStr(), text, numBytes));
+    }
+
+    Memory::Free(refDst);
+    Memory::Free(dst);
+    Memory::Free(text);
+}
+
 TEST(StringConverterTest_FromString) {
 
     // conversion to simple types
@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+//  WorkerPoolTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Threading/WorkerPool.h"
+#include "Core/Containers/Array.h"
+#if ORYOL_HAS_THREADS
+#include <atomic>
+#include <thread>
+#include <chrono>
+#endif
+
+using namespace Oryol;
+
+TEST(WorkerPoolTest) {
+    for (int numWorkers = 0; numWorkers < 4; numWorkers++) {
+        WorkerPool pool;
+        CHECK(!pool.IsValid());
+        pool.Setup(numWorkers);
+        CHECK(pool.IsValid());
+        #if ORYOL_HAS_THREADS
+        CHECK(pool.NumWorkers() == numWorkers);
+        #endif
+
+        // each element must be visited exactly once, also
+        // with a partial last chunk
+        const int num = 10007;
+        Array<int> visits;
+        visits.Reserve(num);
+        for (int i = 0; i < num; i++) {
+            visits.Add(0);
+        }
+        for (int iter = 0; iter < 16; iter++) {
+            pool.ParallelFor(num, 256, [&visits](int begin, int end) {
+                for (int i = begin; i < end; i++) {
+                    visits[i]++;
+                }
+            });
+        }
+        bool allVisited = true;
+        for (int i = 0; i < num; i++) {
+            allVisited &= (visits[i] == 16);
+        }
+        CHECK(allVisited);
+
+        // empty and single-chunk ranges
+        int numCalls = 0;
+        pool.ParallelFor(0, 256, [&numCalls](int begin, int end) {
+            numCalls++;
+        });
+        CHECK(numCalls == 0);
+        pool.ParallelFor(100, 256, [&numCalls](int begin, int end) {
+            CHECK((begin == 0) && (end == 100));
+            numCalls++;
+        });
+        CHECK(numCalls == 1);
+
+        pool.Discard();
+        CHECK(!pool.IsValid());
+    }
+}
+
+TEST(WorkerPoolAsyncTest) {
+    for (int numWorkers = 0; numWorkers < 4; numWorkers++) {
+        WorkerPool pool;
+        pool.Setup(numWorkers);
+
+        // jobs run exactly once, also mixed with ParallelFor() calls
+        const int numJobs = 64;
+        #if ORYOL_HAS_THREADS
+        std::atomic<int> numRuns{0};
+        #else
+        int numRuns = 0;
+        #endif
+        int numChunks = 0;
+        for (int i = 0; i < numJobs; i++) {
+            pool.Async([&numRuns] { numRuns++; });
+            pool.ParallelFor(4, 4, [&numChunks](int begin, int end) {
+                numChunks++;
+            });
+        }
+        CHECK(numChunks == numJobs);
+
+        // Discard() waits until all queued jobs have run
+        pool.Discard();
+        CHECK(numRuns == numJobs);
+    }
+}
+
+#if ORYOL_HAS_THREADS
+TEST(WorkerPoolBusyWorkerTest) {
+    WorkerPool pool;
+    pool.Setup(2);
+
+    // a worker which is busy with a long job must not hold up ParallelFor()
+    std::atomic<bool> release{false};
+    std::atomic<bool> started{false};
+    std::atomic<bool> timedOut{false};
+    pool.Async([&release, &started, &timedOut] {
+        started = true;
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!release) {
+            if (std::chrono::steady_clock::now() > timeout) {
+                timedOut = true;
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    std::atomic<int> numItems{0};
+    for (int i = 0; i < 16; i++) {
+        pool.ParallelFor(64, 1, [&numItems](int begin, int end) {
+            numItems += end - begin;
+        });
+    }
+    CHECK(numItems == 16 * 64);
+    CHECK(!timedOut);
+    release = true;
+    pool.Discard();
+}
+#endif
@@ -0,0 +1,556 @@
+//------------------------------------------------------------------------------
+//  Culler.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Culler.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#if ORYOL_HAS_SSE2
+#include <emmintrin.h>
+#elif ORYOL_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+Culler::Culler() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+Culler::~Culler() {
+    if (this->valid) {
+        this->Discard();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::Setup(const CullerSetup& cullerSetup) {
+    o_assert(!this->valid);
+    o_assert(cullerSetup.MaxNumObjects > 0);
+    o_assert(cullerSetup.ChunkSize > 0);
+    o_assert((cullerSetup.LeafSize > 0) && (cullerSetup.LeafSize <= MaxLeafSize));
+    this->valid = true;
+    this->setup = cullerSetup;
+
+    // all bounds arrays in one allocation, padded to SIMD width
+    const int capacity = Memory::RoundUp(cullerSetup.MaxNumObjects, 4);
+    float* ptr = (float*) Memory::Alloc(capacity * NumBoundsStreams * sizeof(float));
+    for (int i = 0; i < NumBoundsStreams; i++) {
+        this->bounds[i] = ptr + i * capacity;
+    }
+    this->scratch = (int*) Memory::Alloc(cullerSetup.MaxNumObjects * sizeof(int));
+    this->slotToId.Reserve(cullerSetup.MaxNumObjects);
+    this->idToSlot.Reserve(cullerSetup.MaxNumObjects);
+    this->workers.Setup(cullerSetup.NumWorkers);
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::Discard() {
+    o_assert(this->valid);
+    this->Clear();
+    this->workers.Discard();
+    Memory::Free(this->bounds[0]);
+    for (int i = 0; i < NumBoundsStreams; i++) {
+        this->bounds[i] = nullptr;
+    }
+    Memory::Free(this->scratch);
+    this->scratch = nullptr;
+    this->valid = false;
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::Clear() {
+    o_assert_dbg(this->valid);
+    this->numObjects = 0;
+    this->slotToId.Clear();
+    this->idToSlot.Clear();
+    this->nodes.Clear();
+    this->slotToLeaf.Clear();
+    this->bvhValid = false;
+    this->bvhDirty = false;
+}
+
+//------------------------------------------------------------------------------
+int
+Culler::AddBox(const glm::vec3& min, const glm::vec3& max) {
+    const float ex = (max.x - min.x) * 0.5f;
+    const float ey = (max.y - min.y) * 0.5f;
+    const float ez = (max.z - min.z) * 0.5f;
+    return this->add(min.x + ex, min.y + ey, min.z + ez, ex, ey, ez, std::sqrt(ex * ex + ey * ey + ez * ez));
+}
+
+//------------------------------------------------------------------------------
+int
+Culler::AddSphere(const glm::vec3& c, float r) {
+    return this->add(c.x, c.y, c.z, r, r, r, r);
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::SetBox(int id, const glm::vec3& min, const glm::vec3& max) {
+    const float ex = (max.x - min.x) * 0.5f;
+    const float ey = (max.y - min.y) * 0.5f;
+    const float ez = (max.z - min.z) * 0.5f;
+    this->set(id, min.x + ex, min.y + ey, min.z + ez, ex, ey, ez, std::sqrt(ex * ex + ey * ey + ez * ez));
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::SetSphere(int id, const glm::vec3& c, float r) {
+    this->set(id, c.x, c.y, c.z, r, r, r, r);
+}
+
+//------------------------------------------------------------------------------
+int
+Culler::add(float cx, float cy, float cz, float ex, float ey, float ez, float r) {
+    o_assert_dbg(this->valid);
+    o_assert(this->numObjects < this->setup.MaxNumObjects);
+    const int id = this->numObjects++;
+    this->slotToId.Add(id);
+    this->idToSlot.Add(id);
+    this->bvhValid = false;
+    this->set(id, cx, cy, cz, ex, ey, ez, r);
+    return id;
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::set(int id, float cx, float cy, float cz, float ex, float ey, float ez, float r) {
+    o_assert_range_dbg(id, this->numObjects);
+    const int slot = this->idToSlot[id];
+    this->bounds[CenterX][slot] = cx;
+    this->bounds[CenterY][slot] = cy;
+    this->bounds[CenterZ][slot] = cz;
+    this->bounds[ExtentX][slot] = ex;
+    this->bounds[ExtentY][slot] = ey;
+    this->bounds[ExtentZ][slot] = ez;
+    this->bounds[Radius][slot] = r;
+    if (this->bvhValid) {
+        // mark the path to the root dirty, stop at the first already dirty node
+        int nodeIndex = this->slotToLeaf[slot];
+        while ((InvalidIndex != nodeIndex) && !this->nodes[nodeIndex].dirty) {
+            this->nodes[nodeIndex].dirty = true;
+            nodeIndex = this->nodes[nodeIndex].parent;
+        }
+        this->bvhDirty = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::Cull(const Frustum& frustum, Array<int>& outVisible) {
+    o_assert_dbg(this->valid);
+    outVisible.Clear();
+    if (this->bvhValid) {
+        if (this->bvhDirty) {
+            this->RefitBVH();
+        }
+        this->cullBVH(frustum, outVisible);
+    }
+    else {
+        this->cullLinear(frustum, outVisible);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Prepare the frustum planes selected by planeMask for the culling kernel.
+*/
+static void
+preparePlanes(const Frustum& frustum, int planeMask, int& num, float (*n)[4], float (*absN)[3]) {
+    num = 0;
+    for (int i = 0; i < Frustum::NumPlanes; i++) {
+        if (planeMask & (1 << i)) {
+            const glm::vec4& p = frustum.Planes[i];
+            n[num][0] = p.x; n[num][1] = p.y; n[num][2] = p.z; n[num][3] = p.w;
+            absN[num][0] = std::fabs(p.x); absN[num][1] = std::fabs(p.y); absN[num][2] = std::fabs(p.z);
+            num++;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    The culling kernel: an object is outside a plane if the signed
+    distance of its center is below minus the projected radius, where
+    the projected radius is the smaller of the box extents projected
+    onto the plane normal, and the sphere radius. Visible object ids
+    are written without branching, the output pointer is advanced
+    by the visibility bit.
+*/
+int
+Culler::cullRange(int begin, int end, const planes& pl, int* out) const {
+    const float* const cx = this->bounds[CenterX];
+    const float* const cy = this->bounds[CenterY];
+    const float* const cz = this->bounds[CenterZ];
+    const float* const ex = this->bounds[ExtentX];
+    const float* const ey = this->bounds[ExtentY];
+    const float* const ez = this->bounds[ExtentZ];
+    const float* const rad = this->bounds[Radius];
+    const int* const ids = &this->slotToId[0];
+    int numVisible = 0;
+
+    int i = begin;
+    #if ORYOL_HAS_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    for (; (i + 4) <= end; i += 4) {
+        const __m128 x = _mm_loadu_ps(cx + i), y = _mm_loadu_ps(cy + i), z = _mm_loadu_ps(cz + i);
+        const __m128 hx = _mm_loadu_ps(ex + i), hy = _mm_loadu_ps(ey + i), hz = _mm_loadu_ps(ez + i);
+        const __m128 r = _mm_loadu_ps(rad + i);
+        __m128 visible = _mm_cmpeq_ps(zero, zero);
+        for (int p = 0; p < pl.num; p++) {
+            __m128 d = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(pl.n[p][0])), _mm_set1_ps(pl.n[p][3]));
+            d = _mm_add_ps(d, _mm_mul_ps(y, _mm_set1_ps(pl.n[p][1])));
+            d = _mm_add_ps(d, _mm_mul_ps(z, _mm_set1_ps(pl.n[p][2])));
+            __m128 e = _mm_mul_ps(hx, _mm_set1_ps(pl.absN[p][0]));
+            e = _mm_add_ps(e, _mm_mul_ps(hy, _mm_set1_ps(pl.absN[p][1])));
+            e = _mm_add_ps(e, _mm_mul_ps(hz, _mm_set1_ps(pl.absN[p][2])));
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(d, _mm_min_ps(e, r)), zero));
+        }
+        const int mask = _mm_movemask_ps(visible);
+        out[numVisible] = ids[i + 0]; numVisible += mask & 1;
+        out[numVisible] = ids[i + 1]; numVisible += (mask >> 1) & 1;
+        out[numVisible] = ids[i + 2]; numVisible += (mask >> 2) & 1;
+        out[numVisible] = ids[i + 3]; numVisible += (mask >> 3) & 1;
+    }
+    #elif ORYOL_HAS_NEON
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (; (i + 4) <= end; i += 4) {
+        const float32x4_t x = vld1q_f32(cx + i), y = vld1q_f32(cy + i), z = vld1q_f32(cz + i);
+        const float32x4_t hx = vld1q_f32(ex + i), hy = vld1q_f32(ey + i), hz = vld1q_f32(ez + i);
+        const float32x4_t r = vld1q_f32(rad + i);
+        uint32x4_t visible = vdupq_n_u32(0xFFFFFFFF);
+        for (int p = 0; p < pl.num; p++) {
+            float32x4_t d = vmlaq_n_f32(vdupq_n_f32(pl.n[p][3]), x, pl.n[p][0]);
+            d = vmlaq_n_f32(d, y, pl.n[p][1]);
+            d = vmlaq_n_f32(d, z, pl.n[p][2]);
+            float32x4_t e = vmulq_n_f32(hx, pl.absN[p][0]);
+            e = vmlaq_n_f32(e, hy, pl.absN[p][1]);
+            e = vmlaq_n_f32(e, hz, pl.absN[p][2]);
+            visible = vandq_u32(visible, vcgeq_f32(vaddq_f32(d, vminq_f32(e, r)), zero));
+        }
+        out[numVisible] = ids[i + 0]; numVisible += vgetq_lane_u32(visible, 0) & 1;
+        out[numVisible] = ids[i + 1]; numVisible += vgetq_lane_u32(visible, 1) & 1;
+        out[numVisible] = ids[i + 2]; numVisible += vgetq_lane_u32(visible, 2) & 1;
+        out[numVisible] = ids[i + 3]; numVisible += vgetq_lane_u32(visible, 3) & 1;
+    }
+    #endif
+    // scalar fallback and remainder
+    for (; i < end; i++) {
+        int visible = 1;
+        for (int p = 0; p < pl.num; p++) {
+            const float d = cx[i] * pl.n[p][0] + cy[i] * pl.n[p][1] + cz[i] * pl.n[p][2] + pl.n[p][3];
+            const float e = ex[i] * pl.absN[p][0] + ey[i] * pl.absN[p][1] + ez[i] * pl.absN[p][2];
+            visible &= int((d + (e < rad[i] ? e : rad[i])) >= 0.0f);
+        }
+        out[numVisible] = ids[i];
+        numVisible += visible;
+    }
+    return numVisible;
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::cullLinear(const Frustum& frustum, Array<int>& outVisible) {
+    if (0 == this->numObjects) {
+        return;
+    }
+    planes pl;
+    preparePlanes(frustum, (1 << Frustum::NumPlanes) - 1, pl.num, pl.n, pl.absN);
+
+    // each chunk writes its visible ids to the start of its own scratch range
+    const int chunkSize = this->setup.ChunkSize;
+    const int numChunks = (this->numObjects + chunkSize - 1) / chunkSize;
+    this->chunkNumVisible.Clear();
+    for (int i = 0; i < numChunks; i++) {
+        this->chunkNumVisible.Add(0);
+    }
+    this->workers.ParallelFor(this->numObjects, chunkSize, [this, &pl, chunkSize](int begin, int end) {
+        this->chunkNumVisible[begin / chunkSize] = this->cullRange(begin, end, pl, this->scratch + begin);
+    });
+
+    // gather the chunk results into the compact output array
+    int numVisible = 0;
+    for (int i = 0; i < numChunks; i++) {
+        numVisible += this->chunkNumVisible[i];
+    }
+    outVisible.Reserve(numVisible);
+    for (int chunk = 0; chunk < numChunks; chunk++) {
+        const int* src = this->scratch + chunk * chunkSize;
+        const int num = this->chunkNumVisible[chunk];
+        for (int i = 0; i < num; i++) {
+            outVisible.Add(src[i]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::BuildBVH() {
+    o_assert_dbg(this->valid);
+    this->nodes.Clear();
+    this->slotToLeaf.Clear();
+    this->bvhValid = true;
+    this->bvhDirty = false;
+    const int num = this->numObjects;
+    if (0 == num) {
+        return;
+    }
+
+    // build the tree over a permutation of the object slots
+    int* perm = (int*) Memory::Alloc(num * sizeof(int));
+    for (int i = 0; i < num; i++) {
+        perm[i] = i;
+    }
+    this->nodes.Reserve(2 * ((num + this->setup.LeafSize - 1) / this->setup.LeafSize));
+    this->buildNode(perm, 0, num, InvalidIndex);
+
+    // reorder the bounds arrays into tree order, so that each leaf
+    // (and each subtree) is a contiguous range of slots
+    float* tmp = (float*) Memory::Alloc(num * sizeof(float));
+    for (int stream = 0; stream < NumBoundsStreams; stream++) {
+        float* src = this->bounds[stream];
+        for (int i = 0; i < num; i++) {
+            tmp[i] = src[perm[i]];
+        }
+        Memory::Copy(tmp, src, num * sizeof(float));
+    }
+    Memory::Free(tmp);
+    Array<int> oldSlotToId(std::move(this->slotToId));
+    this->slotToId.Reserve(this->setup.MaxNumObjects);
+    for (int slot = 0; slot < num; slot++) {
+        const int id = oldSlotToId[perm[slot]];
+        this->slotToId.Add(id);
+        this->idToSlot[id] = slot;
+    }
+    Memory::Free(perm);
+
+    // setup leaf lookup and compute node bounds bottom-up
+    this->slotToLeaf.Reserve(num);
+    for (int i = 0; i < num; i++) {
+        this->slotToLeaf.Add(InvalidIndex);
+    }
+    for (int nodeIndex = this->nodes.Size() - 1; nodeIndex >= 0; nodeIndex--) {
+        const node& n = this->nodes[nodeIndex];
+        if (InvalidIndex == n.right) {
+            for (int slot = n.first; slot < (n.first + n.count); slot++) {
+                this->slotToLeaf[slot] = nodeIndex;
+            }
+        }
+        this->computeNodeBounds(nodeIndex);
+    }
+}
+
+//------------------------------------------------------------------------------
+int
+Culler::buildNode(int* slots, int first, int count, int parent) {
+    const int nodeIndex = this->nodes.Size();
+    this->nodes.Add(node());
+    this->nodes[nodeIndex].first = first;
+    this->nodes[nodeIndex].count = count;
+    this->nodes[nodeIndex].parent = parent;
+    if (count <= this->setup.LeafSize) {
+        return nodeIndex;
+    }
+
+    // split at the median of the object centers along the longest axis
+    float minC[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float maxC[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (int i = first; i < (first + count); i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            const float c = this->bounds[CenterX + axis][slots[i]];
+            minC[axis] = c < minC[axis] ? c : minC[axis];
+            maxC[axis] = c > maxC[axis] ? c : maxC[axis];
+        }
+    }
+    int axis = 0;
+    for (int i = 1; i < 3; i++) {
+        if ((maxC[i] - minC[i]) > (maxC[axis] - minC[axis])) {
+            axis = i;
+        }
+    }
+    const float* center = this->bounds[CenterX + axis];
+    const int mid = first + count / 2;
+    std::nth_element(slots + first, slots + mid, slots + first + count, [center](int a, int b) {
+        return center[a] < center[b];
+    });
+    this->buildNode(slots, first, mid - first, nodeIndex);
+    const int right = this->buildNode(slots, mid, first + count - mid, nodeIndex);
+    this->nodes[nodeIndex].right = right;
+    return nodeIndex;
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::computeNodeBounds(int nodeIndex) {
+    node& n = this->nodes[nodeIndex];
+    float minB[3], maxB[3];
+    if (InvalidIndex == n.right) {
+        for (int axis = 0; axis < 3; axis++) {
+            const float* c = this->bounds[CenterX + axis];
+            const float* e = this->bounds[ExtentX + axis];
+            float mn = FLT_MAX, mx = -FLT_MAX;
+            for (int slot = n.first; slot < (n.first + n.count); slot++) {
+                const float lo = c[slot] - e[slot];
+                const float hi = c[slot] + e[slot];
+                mn = lo < mn ? lo : mn;
+                mx = hi > mx ? hi : mx;
+            }
+            minB[axis] = mn;
+            maxB[axis] = mx;
+        }
+    }
+    else {
+        const node& l = this->nodes[nodeIndex + 1];
+        const node& r = this->nodes[n.right];
+        for (int axis = 0; axis < 3; axis++) {
+            const float lMin = l.center[axis] - l.extents[axis];
+            const float rMin = r.center[axis] - r.extents[axis];
+            const float lMax = l.center[axis] + l.extents[axis];
+            const float rMax = r.center[axis] + r.extents[axis];
+            minB[axis] = lMin < rMin ? lMin : rMin;
+            maxB[axis] = lMax > rMax ? lMax : rMax;
+        }
+    }
+    for (int axis = 0; axis < 3; axis++) {
+        n.extents[axis] = (maxB[axis] - minB[axis]) * 0.5f;
+        n.center[axis] = minB[axis] + n.extents[axis];
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::RefitBVH() {
+    o_assert_dbg(this->valid);
+    if (this->bvhValid && this->bvhDirty) {
+        // children always have higher indices than their parent
+        for (int nodeIndex = this->nodes.Size() - 1; nodeIndex >= 0; nodeIndex--) {
+            if (this->nodes[nodeIndex].dirty) {
+                this->computeNodeBounds(nodeIndex);
+                this->nodes[nodeIndex].dirty = false;
+            }
+        }
+        this->bvhDirty = false;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+Culler::classify(const node& n, const Frustum& frustum, int& planeMask) const {
+    for (int i = 0; i < Frustum::NumPlanes; i++) {
+        if (planeMask & (1 << i)) {
+            const glm::vec4& p = frustum.Planes[i];
+            const float d = p.x * n.center[0] + p.y * n.center[1] + p.z * n.center[2] + p.w;
+            const float r = std::fabs(p.x) * n.extents[0] + std::fabs(p.y) * n.extents[1] + std::fabs(p.z) * n.extents[2];
+            if ((d + r) < 0.0f) {
+                return false;
+            }
+            if ((d - r) >= 0.0f) {
+                // completely inside this plane, children don't need to test it
+                planeMask &= ~(1 << i);
+            }
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::appendAll(const node& n, Array<int>& out) const {
+    for (int slot = n.first; slot < (n.first + n.count); slot++) {
+        out.Add(this->slotToId[slot]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::traverse(int nodeIndex, int planeMask, const Frustum& frustum, Array<int>& out) const {
+    const node& n = this->nodes[nodeIndex];
+    if (!this->classify(n, frustum, planeMask)) {
+        return;
+    }
+    if (0 == planeMask) {
+        this->appendAll(n, out);
+    }
+    else if (InvalidIndex == n.right) {
+        planes pl;
+        preparePlanes(frustum, planeMask, pl.num, pl.n, pl.absN);
+        int visible[MaxLeafSize];
+        const int numVisible = this->cullRange(n.first, n.first + n.count, pl, visible);
+        for (int i = 0; i < numVisible; i++) {
+            out.Add(visible[i]);
+        }
+    }
+    else {
+        this->traverse(nodeIndex + 1, planeMask, frustum, out);
+        this->traverse(n.right, planeMask, frustum, out);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::collectTasks(int nodeIndex, int planeMask, int depth, int maxDepth, const Frustum& frustum) {
+    const node& n = this->nodes[nodeIndex];
+    if ((depth == maxDepth) || (InvalidIndex == n.right)) {
+        task t;
+        t.nodeIndex = nodeIndex;
+        t.planeMask = planeMask;
+        this->tasks.Add(t);
+        return;
+    }
+    if (!this->classify(n, frustum, planeMask)) {
+        return;
+    }
+    this->collectTasks(nodeIndex + 1, planeMask, depth + 1, maxDepth, frustum);
+    this->collectTasks(n.right, planeMask, depth + 1, maxDepth, frustum);
+}
+
+//------------------------------------------------------------------------------
+void
+Culler::cullBVH(const Frustum& frustum, Array<int>& outVisible) {
+    if (this->nodes.Empty()) {
+        return;
+    }
+
+    // split the top of the tree into enough subtrees to keep all threads busy
+    int maxDepth = 0;
+    while ((1 << maxDepth) < (4 * (this->workers.NumWorkers() + 1))) {
+        maxDepth++;
+    }
+    if (0 == this->workers.NumWorkers()) {
+        maxDepth = 0;
+    }
+    this->tasks.Clear();
+    this->collectTasks(0, (1 << Frustum::NumPlanes) - 1, 0, maxDepth, frustum);
+    while (this->taskResults.Size() < this->tasks.Size()) {
+        this->taskResults.Add(Array<int>());
+    }
+    this->workers.ParallelFor(this->tasks.Size(), 1, [this, &frustum](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            this->taskResults[i].Clear();
+            this->traverse(this->tasks[i].nodeIndex, this->tasks[i].planeMask, frustum, this->taskResults[i]);
+        }
+    });
+
+    // tasks are in tree order, so the output is in tree order too
+    int numVisible = 0;
+    for (int i = 0; i < this->tasks.Size(); i++) {
+        numVisible += this->taskResults[i].Size();
+    }
+    outVisible.Reserve(numVisible);
+    for (int i = 0; i < this->tasks.Size(); i++) {
+        for (int id : this->taskResults[i]) {
+            outVisible.Add(id);
+        }
+    }
+}
+
+} // namespace Oryol
@@ -0,0 +1,174 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @defgroup Culling Culling
+    @brief visibility culling
+
+    @class Oryol::Culler
+    @ingroup Culling
+    @brief SIMD frustum culling of bounding volumes, with optional BVH
+
+    Each object has an axis-aligned bounding box (center and extents)
+    and a bounding sphere, both are stored in SoA arrays. An object
+    is culled if it is outside of any frustum plane, using the
+    tighter of the two bounding volumes for each plane. The culling
+    kernel tests 4 objects at once with SSE2 or NEON.
+
+    Object ids are assigned in order of adding, starting at 0, and
+    Cull() writes the ids of all visible objects into a compact
+    index array which can be iterated directly in the draw loop.
+
+    Without a BVH, Cull() tests all objects in parallel chunks.
+    For large, mostly static object sets, call BuildBVH() once, Cull()
+    then skips whole subtrees which are outside, and accepts whole
+    subtrees without per-object tests which are completely inside the
+    frustum. Changing bounds of objects after the BVH has been built
+    refits the affected BVH nodes (bottom-up) before the next Cull(),
+    adding objects invalidates the BVH.
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "Core/Threading/WorkerPool.h"
+#include "Culling/CullerSetup.h"
+#include "Culling/Frustum.h"
+
+namespace Oryol {
+
+class Culler {
+public:
+    /// constructor
+    Culler();
+    /// destructor
+    ~Culler();
+
+    /// setup the culler
+    void Setup(const CullerSetup& setup);
+    /// discard the culler
+    void Discard();
+    /// return true if the culler has been setup
+    bool IsValid() const;
+
+    /// add an object with an axis-aligned bounding box, returns object id
+    int AddBox(const glm::vec3& min, const glm::vec3& max);
+    /// add an object with a bounding sphere, returns object id
+    int AddSphere(const glm::vec3& center, float radius);
+    /// update the bounding box of an object
+    void SetBox(int id, const glm::vec3& min, const glm::vec3& max);
+    /// update the bounding sphere of an object
+    void SetSphere(int id, const glm::vec3& center, float radius);
+    /// remove all objects (and the BVH)
+    void Clear();
+    /// get number of objects
+    int NumObjects() const;
+
+    /// build a BVH over the current objects
+    void BuildBVH();
+    /// return true if a valid BVH exists
+    bool HasBVH() const;
+    /// refit BVH nodes of changed objects (called by Cull() if necessary)
+    void RefitBVH();
+
+    /// write ids of visible objects to outVisible (the array is cleared first)
+    void Cull(const Frustum& frustum, Array<int>& outVisible);
+
+private:
+    /// SoA bounds arrays
+    enum {
+        CenterX = 0,
+        CenterY,
+        CenterZ,
+        ExtentX,
+        ExtentY,
+        ExtentZ,
+        Radius,
+
+        NumBoundsStreams,
+    };
+    /// max number of objects in a BVH leaf
+    static const int MaxLeafSize = 256;
+    /// a BVH node, in depth-first order, the left child directly follows its parent,
+    /// the objects of a subtree occupy a contiguous range of object slots
+    struct node {
+        float center[3];
+        float extents[3];
+        int first = 0;          // first object slot of subtree
+        int count = 0;          // number of objects in subtree
+        int right = InvalidIndex;   // right child index, InvalidIndex for leaf nodes
+        int parent = InvalidIndex;
+        bool dirty = false;
+    };
+    /// a BVH traversal task
+    struct task {
+        int nodeIndex = InvalidIndex;
+        int planeMask = 0;
+    };
+    /// frustum planes prepared for the culling kernel
+    struct planes {
+        int num = 0;
+        float n[Frustum::NumPlanes][4];     // nx, ny, nz, d
+        float absN[Frustum::NumPlanes][3];  // |nx|, |ny|, |nz|
+    };
+
+    /// add an object with center, extents and radius
+    int add(float cx, float cy, float cz, float ex, float ey, float ez, float r);
+    /// write bounds of an object slot and mark BVH nodes dirty
+    void set(int id, float cx, float cy, float cz, float ex, float ey, float ez, float r);
+    /// cull without BVH
+    void cullLinear(const Frustum& frustum, Array<int>& outVisible);
+    /// cull with BVH
+    void cullBVH(const Frustum& frustum, Array<int>& outVisible);
+    /// test a range of object slots against planes, write visible object ids, return number of visible objects
+    int cullRange(int begin, int end, const planes& pl, int* out) const;
+    /// collect BVH traversal tasks for worker threads
+    void collectTasks(int nodeIndex, int planeMask, int depth, int maxDepth, const Frustum& frustum);
+    /// traverse a BVH subtree and append visible object ids
+    void traverse(int nodeIndex, int planeMask, const Frustum& frustum, Array<int>& out) const;
+    /// classify node against frustum planes, return false if outside, updates planeMask to intersecting planes
+    bool classify(const node& n, const Frustum& frustum, int& planeMask) const;
+    /// append all objects of a subtree without testing
+    void appendAll(const node& n, Array<int>& out) const;
+    /// recursively build BVH nodes for a range of object slots, return node index
+    int buildNode(int* slots, int first, int count, int parent);
+    /// compute node bounds from its object slots or children
+    void computeNodeBounds(int nodeIndex);
+
+    bool valid = false;
+    CullerSetup setup;
+    WorkerPool workers;
+    float* bounds[NumBoundsStreams] = { };
+    Array<int> slotToId;
+    Array<int> idToSlot;
+    int numObjects = 0;
+
+    // linear culling scratch space
+    int* scratch = nullptr;
+    Array<int> chunkNumVisible;
+
+    // BVH state
+    bool bvhValid = false;
+    bool bvhDirty = false;
+    Array<node> nodes;
+    Array<int> slotToLeaf;
+    Array<task> tasks;
+    Array<Array<int>> taskResults;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+Culler::IsValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+inline int
+Culler::NumObjects() const {
+    return this->numObjects;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+Culler::HasBVH() const {
+    return this->bvhValid;
+}
+
+} // namespace Oryol
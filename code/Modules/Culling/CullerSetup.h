@@ -0,0 +1,24 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::CullerSetup
+    @ingroup Culling
+    @brief setup parameters for a Culler
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+class CullerSetup {
+public:
+    /// max number of objects
+    int MaxNumObjects = 64 * 1024;
+    /// number of worker threads (0: cull on calling thread)
+    int NumWorkers = 0;
+    /// number of objects per work item when culling without BVH
+    int ChunkSize = 8 * 1024;
+    /// max number of objects in a BVH leaf
+    int LeafSize = 32;
+};
+
+} // namespace Oryol
@@ -0,0 +1,58 @@
+//------------------------------------------------------------------------------
+//  Frustum.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Frustum.h"
+#include <cmath>
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+Frustum
+Frustum::FromViewProj(const glm::mat4& m) {
+    // Gribb/Hartmann plane extraction, glm matrices are column-major,
+    // so row r is (m[0][r], m[1][r], m[2][r], m[3][r])
+    Frustum f;
+    for (int i = 0; i < 3; i++) {
+        const glm::vec4 row(m[0][i], m[1][i], m[2][i], m[3][i]);
+        const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+        f.Planes[i * 2 + 0] = row3 + row;
+        f.Planes[i * 2 + 1] = row3 - row;
+    }
+    for (int i = 0; i < NumPlanes; i++) {
+        glm::vec4& p = f.Planes[i];
+        const float len = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+        if (len > 0.0f) {
+            p = p * (1.0f / len);
+        }
+    }
+    return f;
+}
+
+//------------------------------------------------------------------------------
+bool
+Frustum::TestSphere(const glm::vec3& c, float r) const {
+    for (int i = 0; i < NumPlanes; i++) {
+        const glm::vec4& p = this->Planes[i];
+        if ((p.x * c.x + p.y * c.y + p.z * c.z + p.w) < -r) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+Frustum::TestBox(const glm::vec3& c, const glm::vec3& e) const {
+    for (int i = 0; i < NumPlanes; i++) {
+        const glm::vec4& p = this->Planes[i];
+        const float d = p.x * c.x + p.y * c.y + p.z * c.z + p.w;
+        const float r = std::fabs(p.x) * e.x + std::fabs(p.y) * e.y + std::fabs(p.z) * e.z;
+        if ((d + r) < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Oryol
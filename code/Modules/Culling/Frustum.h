@@ -0,0 +1,44 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::Frustum
+    @ingroup Culling
+    @brief a view frustum described by 6 normalized planes
+
+    The planes are stored as (nx, ny, nz, d) with the normals pointing
+    into the frustum, a point p is inside a plane if dot(n, p) + d >= 0.
+*/
+#include "Core/Types.h"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+#include "glm/mat4x4.hpp"
+
+namespace Oryol {
+
+class Frustum {
+public:
+    /// plane indices
+    enum {
+        Left = 0,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+
+        NumPlanes,
+    };
+
+    /// extract the frustum planes from a (projection * view) matrix
+    static Frustum FromViewProj(const glm::mat4& viewProj);
+
+    /// test if a sphere is (at least partially) inside the frustum
+    bool TestSphere(const glm::vec3& center, float radius) const;
+    /// test if an axis-aligned box is (at least partially) inside the frustum
+    bool TestBox(const glm::vec3& center, const glm::vec3& extents) const;
+
+    /// the frustum planes
+    glm::vec4 Planes[NumPlanes];
+};
+
+} // namespace Oryol
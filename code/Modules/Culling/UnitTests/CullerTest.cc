@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------------
+//  CullerTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Culling/Culler.h"
+#include "Core/Time/Clock.h"
+#include "Core/Log.h"
+#include "glm/mat4x4.hpp"
+
+using namespace Oryol;
+
+// simple deterministic random numbers
+static uint32_t rndState = 12345;
+static float
+rnd(float min, float max) {
+    rndState = rndState * 1664525 + 1013904223;
+    return min + (max - min) * float(rndState >> 8) / float(1 << 24);
+}
+
+// an axis-aligned 'box frustum' from (-10,-10,-10) to (10,10,10)
+static Frustum
+boxFrustum() {
+    Frustum f;
+    f.Planes[Frustum::Left]   = glm::vec4(1.0f, 0.0f, 0.0f, 10.0f);
+    f.Planes[Frustum::Right]  = glm::vec4(-1.0f, 0.0f, 0.0f, 10.0f);
+    f.Planes[Frustum::Bottom] = glm::vec4(0.0f, 1.0f, 0.0f, 10.0f);
+    f.Planes[Frustum::Top]    = glm::vec4(0.0f, -1.0f, 0.0f, 10.0f);
+    f.Planes[Frustum::Near]   = glm::vec4(0.0f, 0.0f, 1.0f, 10.0f);
+    f.Planes[Frustum::Far]    = glm::vec4(0.0f, 0.0f, -1.0f, 10.0f);
+    return f;
+}
+
+// populate culler with random spheres, about 10% of which are inside the box frustum
+static void
+populate(Culler& culler, int num, Array<glm::vec4>& spheres) {
+    spheres.Clear();
+    for (int i = 0; i < num; i++) {
+        const glm::vec4 s(rnd(-21.5f, 21.5f), rnd(-21.5f, 21.5f), rnd(-21.5f, 21.5f), rnd(0.1f, 1.0f));
+        spheres.Add(s);
+        CHECK(culler.AddSphere(glm::vec3(s.x, s.y, s.z), s.w) == i);
+    }
+}
+
+// brute-force reference culling
+static void
+refCull(const Frustum& f, const Array<glm::vec4>& spheres, Array<bool>& visible) {
+    visible.Clear();
+    for (const auto& s : spheres) {
+        visible.Add(f.TestSphere(glm::vec3(s.x, s.y, s.z), s.w));
+    }
+}
+
+static bool
+sameResult(const Array<int>& result, const Array<bool>& ref) {
+    int numRef = 0;
+    for (bool b : ref) {
+        numRef += b ? 1 : 0;
+    }
+    if (numRef != result.Size()) {
+        return false;
+    }
+    for (int id : result) {
+        if (!ref[id]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(FrustumTest) {
+    Frustum f = boxFrustum();
+    CHECK(f.TestSphere(glm::vec3(0.0f, 0.0f, 0.0f), 1.0f));
+    CHECK(f.TestSphere(glm::vec3(10.5f, 0.0f, 0.0f), 1.0f));
+    CHECK(!f.TestSphere(glm::vec3(11.5f, 0.0f, 0.0f), 1.0f));
+    CHECK(f.TestBox(glm::vec3(0.0f, 0.0f, -12.0f), glm::vec3(1.0f, 1.0f, 2.5f)));
+    CHECK(!f.TestBox(glm::vec3(0.0f, 0.0f, -12.0f), glm::vec3(1.0f, 1.0f, 1.5f)));
+
+    // extract from an orthographic projection (which maps the box to clip space)
+    glm::mat4 m(1.0f);
+    m[0][0] = m[1][1] = m[2][2] = 0.1f;
+    Frustum f1 = Frustum::FromViewProj(m);
+    for (int i = 0; i < Frustum::NumPlanes; i++) {
+        CHECK_CLOSE(f1.Planes[i].x, f.Planes[i].x, 0.0001f);
+        CHECK_CLOSE(f1.Planes[i].y, f.Planes[i].y, 0.0001f);
+        CHECK_CLOSE(f1.Planes[i].z, f.Planes[i].z, 0.0001f);
+        CHECK_CLOSE(f1.Planes[i].w, f.Planes[i].w, 0.0001f);
+    }
+}
+
+TEST(CullerTest) {
+    const Frustum frustum = boxFrustum();
+    Array<glm::vec4> spheres;
+    Array<bool> ref;
+    Array<int> visible;
+    for (int numWorkers = 0; numWorkers < 3; numWorkers++) {
+        CullerSetup setup;
+        setup.MaxNumObjects = 10004;
+        setup.NumWorkers = numWorkers;
+        setup.ChunkSize = 1000;
+        setup.LeafSize = 16;
+        Culler culler;
+        culler.Setup(setup);
+        CHECK(culler.IsValid());
+        populate(culler, 10003, spheres);
+        CHECK(culler.NumObjects() == 10003);
+        refCull(frustum, spheres, ref);
+
+        // linear culling
+        CHECK(!culler.HasBVH());
+        culler.Cull(frustum, visible);
+        CHECK(!visible.Empty());
+        CHECK(sameResult(visible, ref));
+
+        // BVH culling must give the same result
+        culler.BuildBVH();
+        CHECK(culler.HasBVH());
+        culler.Cull(frustum, visible);
+        CHECK(sameResult(visible, ref));
+
+        // move some objects, the BVH is refitted
+        for (int i = 0; i < 10003; i += 7) {
+            spheres[i] = glm::vec4(rnd(-21.5f, 21.5f), rnd(-21.5f, 21.5f), rnd(-21.5f, 21.5f), spheres[i].w);
+            culler.SetSphere(i, glm::vec3(spheres[i].x, spheres[i].y, spheres[i].z), spheres[i].w);
+        }
+        refCull(frustum, spheres, ref);
+        culler.Cull(frustum, visible);
+        CHECK(culler.HasBVH());
+        CHECK(sameResult(visible, ref));
+
+        // boxes, and adding an object invalidates the BVH
+        const int id = culler.AddBox(glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, 1.0f));
+        CHECK(!culler.HasBVH());
+        spheres.Add(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        ref.Add(true);
+        culler.Cull(frustum, visible);
+        CHECK(sameResult(visible, ref));
+        culler.SetBox(id, glm::vec3(10.5f, 10.5f, 10.5f), glm::vec3(11.0f, 11.0f, 11.0f));
+        ref[id] = false;
+        culler.Cull(frustum, visible);
+        CHECK(sameResult(visible, ref));
+
+        culler.Clear();
+        CHECK(culler.NumObjects() == 0);
+        culler.Cull(frustum, visible);
+        CHECK(visible.Empty());
+        culler.Discard();
+        CHECK(!culler.IsValid());
+    }
+}
+
+TEST(CullerPerformanceTest) {
+    const Frustum frustum = boxFrustum();
+    Array<glm::vec4> spheres;
+    Array<int> visible;
+    const int sizes[] = { 100 * 1000, 1000 * 1000 };
+    for (int num : sizes) {
+        CullerSetup setup;
+        setup.MaxNumObjects = num;
+        setup.NumWorkers = 3;
+        Culler culler;
+        culler.Setup(setup);
+        populate(culler, num, spheres);
+
+        TimePoint start = Clock::Now();
+        for (int i = 0; i < 10; i++) {
+            culler.Cull(frustum, visible);
+        }
+        Duration linearTime = Clock::Since(start);
+        const int numLinearVisible = visible.Size();
+
+        culler.BuildBVH();
+        start = Clock::Now();
+        for (int i = 0; i < 10; i++) {
+            culler.Cull(frustum, visible);
+        }
+        Duration bvhTime = Clock::Since(start);
+        CHECK(visible.Size() == numLinearVisible);
+        Log::Info("Culler: %d objects, %d visible: linear=%.3fms, bvh=%.3fms\n",
+            num, numLinearVisible, linearTime.AsMilliSeconds() / 10.0, bvhTime.AsMilliSeconds() / 10.0);
+    }
+}
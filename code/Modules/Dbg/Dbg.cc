@@ -12,9 +12,10 @@ struct Dbg::_state* Dbg::state = nullptr;
 
 //------------------------------------------------------------------------------
 void
-Dbg::Setup() {
+Dbg::Setup(const DbgSetup& setup) {
     o_assert(!IsValid());
     state = Memory::New<_state>();
+    state->debugGeomRenderer.setMaxNumLines(setup.MaxNumLines);
 }
 
 //------------------------------------------------------------------------------
@@ -24,6 +25,9 @@ Dbg::Discard() {
     if (state->debugTextRenderer.isValid()) {
         state->debugTextRenderer.discard();
     }
+    if (state->debugGeomRenderer.isValid()) {
+        state->debugGeomRenderer.discard();
+    }
     Memory::Delete(state);
     state = nullptr;
 }
@@ -84,7 +88,57 @@ void
 Dbg::DrawTextBuffer() {
     o_trace_scoped(Dbg_DrawTextBuffer);
     o_assert_dbg(IsValid());
+    state->debugGeomRenderer.drawGeometry();
     state->debugTextRenderer.drawTextBuffer();
 }
 
+//------------------------------------------------------------------------------
+void
+Dbg::SetViewProj(const glm::mat4& viewProj) {
+    o_assert_dbg(IsValid());
+    state->debugGeomRenderer.setViewProj(viewProj);
+}
+
+//------------------------------------------------------------------------------
+void
+Dbg::Line(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, bool depthTest) {
+    o_assert_dbg(IsValid());
+    state->debugGeomRenderer.line(p0, p1, _priv::debugGeomRenderer::packColor(color), depthTest);
+}
+
+//------------------------------------------------------------------------------
+void
+Dbg::Box(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color, bool depthTest) {
+    o_assert_dbg(IsValid());
+    state->debugGeomRenderer.box(min, max, _priv::debugGeomRenderer::packColor(color), depthTest);
+}
+
+//------------------------------------------------------------------------------
+void
+Dbg::Box(const glm::mat4& transform, const glm::vec4& color, bool depthTest) {
+    o_assert_dbg(IsValid());
+    state->debugGeomRenderer.box(transform, _priv::debugGeomRenderer::packColor(color), depthTest);
+}
+
+//------------------------------------------------------------------------------
+void
+Dbg::Sphere(const glm::vec3& center, float radius, const glm::vec4& color, bool depthTest) {
+    o_assert_dbg(IsValid());
+    state->debugGeomRenderer.sphere(center, radius, _priv::debugGeomRenderer::packColor(color), depthTest);
+}
+
+//------------------------------------------------------------------------------
+void
+Dbg::Grid(const glm::vec3& center, float size, int numCells, const glm::vec4& color, bool depthTest) {
+    o_assert_dbg(IsValid());
+    state->debugGeomRenderer.grid(center, size, numCells, _priv::debugGeomRenderer::packColor(color), depthTest);
+}
+
+//------------------------------------------------------------------------------
+void
+Dbg::Arrow(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, bool depthTest) {
+    o_assert_dbg(IsValid());
+    state->debugGeomRenderer.arrow(from, to, _priv::debugGeomRenderer::packColor(color), depthTest);
+}
+
 } // namespace Oryol
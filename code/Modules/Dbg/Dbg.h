@@ -7,9 +7,16 @@
     @class Oryol::Dbg
     @ingroup Dbg
     @brief Dbg module facade
+
+    Debug lines (Line, Box, Sphere, Grid, Arrow) can be added from any
+    thread, they are rendered in world space with the view-projection
+    matrix from SetViewProj() by DrawTextBuffer(), either depth-tested
+    against the current depth buffer or as overlay on top.
 */
 #include "Core/Config.h"
+#include "Dbg/DbgSetup.h"
 #include "Dbg/text/debugTextRenderer.h"
+#include "Dbg/geom/debugGeomRenderer.h"
 #include "glm/fwd.hpp"
 
 namespace Oryol {
@@ -17,7 +24,7 @@ namespace Oryol {
 class Dbg {
 public:
     /// setup the Debug module
-    static void Setup();
+    static void Setup(const DbgSetup& setup=DbgSetup());
     /// discard the Debug module
     static void Discard();
     /// return true if Debug module is valid
@@ -36,12 +43,28 @@ public:
     static void CursorPos(uint8_t x, uint8_t y);
     /// add color tag
     static void TextColor(const glm::vec4& color);
-    /// draw the debug text buffer (call one per frame)
+    /// draw the debug lines and the debug text buffer (call one per frame)
     static void DrawTextBuffer();
+
+    /// set view-projection matrix for debug lines
+    static void SetViewProj(const glm::mat4& viewProj);
+    /// add a debug line
+    static void Line(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, bool depthTest=true);
+    /// add an axis-aligned debug box
+    static void Box(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color, bool depthTest=true);
+    /// add a debug box, transform is applied to a unit cube centered at the origin
+    static void Box(const glm::mat4& transform, const glm::vec4& color, bool depthTest=true);
+    /// add a debug sphere
+    static void Sphere(const glm::vec3& center, float radius, const glm::vec4& color, bool depthTest=true);
+    /// add a debug grid in the xz plane
+    static void Grid(const glm::vec3& center, float size, int numCells, const glm::vec4& color, bool depthTest=true);
+    /// add a debug arrow
+    static void Arrow(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, bool depthTest=true);
     
 private:
     struct _state {
         class _priv::debugTextRenderer debugTextRenderer;
+        class _priv::debugGeomRenderer debugGeomRenderer;
     };
     static _state* state;
 };
@@ -0,0 +1,18 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::DbgSetup
+    @ingroup Dbg
+    @brief setup parameters for the Dbg module
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+class DbgSetup {
+public:
+    /// max number of debug lines per frame (depth-tested and overlay combined)
+    int MaxNumLines = 256 * 1024;
+};
+
+} // namespace Oryol
@@ -0,0 +1,360 @@
+//------------------------------------------------------------------------------
+//  debugGeomRenderer.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "debugGeomRenderer.h"
+#include "Core/Memory/Memory.h"
+#include "Gfx/Gfx.h"
+#include "DebugGeomShaders.h"
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+#include <cmath>
+
+namespace Oryol {
+namespace _priv {
+
+ORYOL_THREADLOCAL_PTR(debugGeomRenderer::threadBuffer) debugGeomRenderer::localBuffer = nullptr;
+ORYOL_THREADLOCAL_PTR(void) debugGeomRenderer::localGeneration = nullptr;
+uint32_t debugGeomRenderer::generationCounter = 0;
+
+//------------------------------------------------------------------------------
+debugGeomRenderer::debugGeomRenderer() :
+valid(false),
+generation(++generationCounter),
+maxNumVertices(0),
+viewProj(1.0f),
+stagingVertices(nullptr) {
+    // NOTE: the Gfx resources are setup lazily on first draw, the
+    // thread-local buffer pointers are only trusted if they were
+    // created for this renderer's generation
+    for (int i = 0; i < numModes; i++) {
+        this->numVertices[i] = 0;
+    }
+    for (int i = 0; i < NumCircleSegments; i++) {
+        const float a = (float(i) / float(NumCircleSegments)) * 6.28318530718f;
+        this->circle[i] = glm::vec2(std::cos(a), std::sin(a));
+    }
+    this->setMaxNumLines(256 * 1024);
+}
+
+//------------------------------------------------------------------------------
+debugGeomRenderer::~debugGeomRenderer() {
+    if (this->valid) {
+        this->discard();
+    }
+    this->bufferLock.LockWrite();
+    for (threadBuffer* buf : this->buffers) {
+        Memory::Delete(buf);
+    }
+    this->buffers.Clear();
+    this->bufferLock.UnlockWrite();
+    Memory::Free(this->stagingVertices);
+    this->stagingVertices = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void
+debugGeomRenderer::setMaxNumLines(int num) {
+    o_assert(!this->valid);
+    o_assert(num > 0);
+    if (this->stagingVertices) {
+        Memory::Free(this->stagingVertices);
+    }
+    this->maxNumVertices = num * 2;
+    this->stagingVertices = (vertex*) Memory::Alloc(this->maxNumVertices * sizeof(vertex));
+}
+
+//------------------------------------------------------------------------------
+void
+debugGeomRenderer::setup() {
+    o_assert(!this->valid);
+    this->resourceLabel = Gfx::PushResourceLabel();
+
+    this->vertexLayout.Clear();
+    this->vertexLayout
+        .Add(VertexAttr::Position, VertexFormat::Float3)
+        .Add(VertexAttr::Color0, VertexFormat::UByte4N);
+    o_assert(sizeof(vertex) == this->vertexLayout.ByteSize());
+    MeshSetup meshSetup = MeshSetup::Empty(this->maxNumVertices, Usage::Stream);
+    meshSetup.Layout = this->vertexLayout;
+    this->drawState.Mesh[0] = Gfx::CreateResource(meshSetup);
+
+    // one pipeline for depth-tested lines, one for overlay lines
+    Id shd = Gfx::CreateResource(DbgGeomShader::Setup());
+    auto ps = PipelineSetup::FromLayoutAndShader(this->vertexLayout, shd);
+    ps.PrimType = PrimitiveType::Lines;
+    ps.DepthStencilState.DepthWriteEnabled = false;
+    ps.DepthStencilState.DepthCmpFunc = CompareFunc::LessEqual;
+    ps.BlendState.BlendEnabled = true;
+    ps.BlendState.SrcFactorRGB = BlendFactor::SrcAlpha;
+    ps.BlendState.DstFactorRGB = BlendFactor::OneMinusSrcAlpha;
+    ps.BlendState.ColorWriteMask = PixelChannel::RGB;
+    ps.BlendState.ColorFormat = Gfx::RenderTargetAttrs().ColorPixelFormat;
+    ps.BlendState.DepthFormat = Gfx::RenderTargetAttrs().DepthPixelFormat;
+    ps.RasterizerState.SampleCount = Gfx::RenderTargetAttrs().SampleCount;
+    this->depthPipeline = Gfx::CreateResource(ps);
+    ps.DepthStencilState.DepthCmpFunc = CompareFunc::Always;
+    this->overlayPipeline = Gfx::CreateResource(ps);
+
+    Gfx::PopResourceLabel();
+    this->valid = true;
+}
+
+//------------------------------------------------------------------------------
+void
+debugGeomRenderer::discard() {
+    o_assert(this->valid);
+    this->valid = false;
+    Gfx::DestroyResources(this->resourceLabel);
+    this->drawState = DrawState();
+    this->depthPipeline.Invalidate();
+    this->overlayPipeline.Invalidate();
+}
+
+//------------------------------------------------------------------------------
+void
+debugGeomRenderer::setViewProj(const glm::mat4& m) {
+    this->viewProj = m;
+}
+
+//------------------------------------------------------------------------------
+uint32_t
+debugGeomRenderer::packColor(const glm::vec4& c) {
+    const uint32_t r = uint32_t(glm::clamp(c.x, 0.0f, 1.0f) * 255.0f);
+    const uint32_t g = uint32_t(glm::clamp(c.y, 0.0f, 1.0f) * 255.0f);
+    const uint32_t b = uint32_t(glm::clamp(c.z, 0.0f, 1.0f) * 255.0f);
+    const uint32_t a = uint32_t(glm::clamp(c.w, 0.0f, 1.0f) * 255.0f);
+    return (a<<24) | (b<<16) | (g<<8) | r;
+}
+
+//------------------------------------------------------------------------------
+debugGeomRenderer::threadBuffer*
+debugGeomRenderer::lockThreadBuffer() {
+    threadBuffer* buf = localBuffer;
+    if ((nullptr == buf) || (localGeneration != (void*)(uintptr_t)this->generation)) {
+        // first line from this thread, register a new thread buffer
+        buf = Memory::New<threadBuffer>();
+        this->bufferLock.LockWrite();
+        this->buffers.Add(buf);
+        this->bufferLock.UnlockWrite();
+        localBuffer = buf;
+        localGeneration = (void*)(uintptr_t)this->generation;
+    }
+    buf->lock.LockWrite();
+    return buf;
+}
+
+//------------------------------------------------------------------------------
+debugGeomRenderer::vertex*
+debugGeomRenderer::addVertices(threadBuffer* buf, bool depthTest, int num) {
+    Buffer& dst = buf->vertices[depthTest ? depthTested : overlay];
+    const int numBytes = num * int(sizeof(vertex));
+    if ((dst.Size() + numBytes) > (this->maxNumVertices * int(sizeof(vertex)))) {
+        // can't be drawn anyway
+        return nullptr;
+    }
+    if (dst.Spare() < numBytes) {
+        // grow by doubling, Buffer::Reserve() only grows by what's requested
+        const int grow = dst.Capacity() > numBytes ? dst.Capacity() : numBytes;
+        dst.Reserve(dst.Spare() + grow);
+    }
+    return (vertex*) dst.Add(numBytes);
+}
+
+//------------------------------------------------------------------------------
+static inline debugGeomRenderer::vertex*
+writeVertex(debugGeomRenderer::vertex* v, const glm::vec3& p, uint32_t color) {
+    v->x = p.x;
+    v->y = p.y;
+    v->z = p.z;
+    v->color = color;
+    return v + 1;
+}
+
+//------------------------------------------------------------------------------
+void
+debugGeomRenderer::line(const glm::vec3& p0, const glm::vec3& p1, uint32_t color, bool depthTest) {
+    threadBuffer* buf = this->lockThreadBuffer();
+    vertex* v = this->addVertices(buf, depthTest, 2);
+    if (v) {
+        v = writeVertex(v, p0, color);
+        writeVertex(v, p1, color);
+    }
+    buf->lock.UnlockWrite();
+}
+
+//------------------------------------------------------------------------------
+/**
+ Write the 12 edges of a box given by its 8 corners, the corner index bits
+ are the x, y and z side (0: min, 1: max).
+*/
+static inline void
+writeBoxEdges(debugGeomRenderer::vertex* v, const glm::vec3* c, uint32_t color) {
+    static const uint8_t edges[12][2] = {
+        { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },     // x edges
+        { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },     // y edges
+        { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 },     // z edges
+    };
+    for (int i = 0; i < 12; i++) {
+        v = writeVertex(v, c[edges[i][0]], color);
+        v = writeVertex(v, c[edges[i][1]], color);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+debugGeomRenderer::box(const glm::vec3& min, const glm::vec3& max, uint32_t color, bool depthTest) {
+    glm::vec3 c[8];
+    for (int i = 0; i < 8; i++) {
+        c[i] = glm::vec3((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z);
+    }
+    threadBuffer* buf = this->lockThreadBuffer();
+    vertex* v = this->addVertices(buf, depthTest, 24);
+    if (v) {
+        writeBoxEdges(v, c, color);
+    }
+    buf->lock.UnlockWrite();
+}
+
+//------------------------------------------------------------------------------
+void
+debugGeomRenderer::box(const glm::mat4& m, uint32_t color, bool depthTest) {
+    glm::vec3 c[8];
+    for (int i = 0; i < 8; i++) {
+        const glm::vec4 p((i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f, 1.0f);
+        c[i] = glm::vec3(m * p);
+    }
+    threadBuffer* buf = this->lockThreadBuffer();
+    vertex* v = this->addVertices(buf, depthTest, 24);
+    if (v) {
+        writeBoxEdges(v, c, color);
+    }
+    buf->lock.UnlockWrite();
+}
+
+//------------------------------------------------------------------------------
+void
+debugGeomRenderer::sphere(const glm::vec3& center, float radius, uint32_t color, bool depthTest) {
+    const int n = NumCircleSegments;
+    threadBuffer* buf = this->lockThreadBuffer();
+    vertex* v = this->addVertices(buf, depthTest, 3 * n * 2);
+    if (v) {
+        for (int i = 0; i < n; i++) {
+            const glm::vec2 c0 = this->circle[i] * radius;
+            const glm::vec2 c1 = this->circle[(i + 1) % n] * radius;
+            v = writeVertex(v, center + glm::vec3(c0.x, c0.y, 0.0f), color);
+            v = writeVertex(v, center + glm::vec3(c1.x, c1.y, 0.0f), color);
+            v = writeVertex(v, center + glm::vec3(c0.x, 0.0f, c0.y), color);
+            v = writeVertex(v, center + glm::vec3(c1.x, 0.0f, c1.y), color);
+            v = writeVertex(v, center + glm::vec3(0.0f, c0.x, c0.y), color);
+            v = writeVertex(v, center + glm::vec3(0.0f, c1.x, c1.y), color);
+        }
+    }
+    buf->lock.UnlockWrite();
+}
+
+//------------------------------------------------------------------------------
+void
+debugGeomRenderer::grid(const glm::vec3& center, float size, int numCells, uint32_t color, bool depthTest) {
+    o_assert_dbg(numCells > 0);
+    const float half = size * 0.5f;
+    const float cell = size / float(numCells);
+    threadBuffer* buf = this->lockThreadBuffer();
+    vertex* v = this->addVertices(buf, depthTest, (numCells + 1) * 4);
+    if (v) {
+        for (int i = 0; i <= numCells; i++) {
+            const float d = -half + i * cell;
+            v = writeVertex(v, center + glm::vec3(d, 0.0f, -half), color);
+            v = writeVertex(v, center + glm::vec3(d, 0.0f, +half), color);
+            v = writeVertex(v, center + glm::vec3(-half, 0.0f, d), color);
+            v = writeVertex(v, center + glm::vec3(+half, 0.0f, d), color);
+        }
+    }
+    buf->lock.UnlockWrite();
+}
+
+//------------------------------------------------------------------------------
+void
+debugGeomRenderer::arrow(const glm::vec3& from, const glm::vec3& to, uint32_t color, bool depthTest) {
+    const glm::vec3 d = to - from;
+    const float len = glm::length(d);
+    if (len <= 0.0f) {
+        return;
+    }
+    // head is a 4-sided pyramid outline, a fifth of the arrow length
+    const glm::vec3 dir = d / len;
+    const glm::vec3 up = std::fabs(dir.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    const glm::vec3 side0 = glm::normalize(glm::cross(dir, up));
+    const glm::vec3 side1 = glm::cross(dir, side0);
+    const float headLen = len * 0.2f;
+    const glm::vec3 base = to - dir * headLen;
+    const float w = headLen * 0.5f;
+    threadBuffer* buf = this->lockThreadBuffer();
+    vertex* v = this->addVertices(buf, depthTest, 10);
+    if (v) {
+        v = writeVertex(v, from, color);
+        v = writeVertex(v, to, color);
+        v = writeVertex(v, to, color); v = writeVertex(v, base + side0 * w, color);
+        v = writeVertex(v, to, color); v = writeVertex(v, base - side0 * w, color);
+        v = writeVertex(v, to, color); v = writeVertex(v, base + side1 * w, color);
+        v = writeVertex(v, to, color); writeVertex(v, base - side1 * w, color);
+    }
+    buf->lock.UnlockWrite();
+}
+
+//------------------------------------------------------------------------------
+int
+debugGeomRenderer::gatherVertices(int m, int firstVertex) {
+    int num = 0;
+    for (threadBuffer* buf : this->buffers) {
+        buf->lock.LockWrite();
+        Buffer& src = buf->vertices[m];
+        const int space = this->maxNumVertices - (firstVertex + num);
+        int n = src.Size() / int(sizeof(vertex));
+        n = n < space ? n : space;
+        if (n > 0) {
+            Memory::Copy(src.Data(), this->stagingVertices + firstVertex + num, n * sizeof(vertex));
+            num += n;
+        }
+        src.Clear();
+        buf->lock.UnlockWrite();
+    }
+    return num;
+}
+
+//------------------------------------------------------------------------------
+void
+debugGeomRenderer::drawGeometry() {
+    this->bufferLock.LockRead();
+    this->numVertices[depthTested] = this->gatherVertices(depthTested, 0);
+    this->numVertices[overlay] = this->gatherVertices(overlay, this->numVertices[depthTested]);
+    this->bufferLock.UnlockRead();
+    const int numDepth = this->numVertices[depthTested];
+    const int numOverlay = this->numVertices[overlay];
+    if ((numDepth + numOverlay) == 0) {
+        return;
+    }
+
+    // one-time setup
+    if (!this->valid) {
+        this->setup();
+    }
+    Gfx::UpdateVertices(this->drawState.Mesh[0], this->stagingVertices, (numDepth + numOverlay) * sizeof(vertex));
+    DbgGeomShader::VSParams vsParams;
+    vsParams.ViewProj = this->viewProj;
+    if (numDepth > 0) {
+        this->drawState.Pipeline = this->depthPipeline;
+        Gfx::ApplyDrawState(this->drawState);
+        Gfx::ApplyUniformBlock(vsParams);
+        Gfx::Draw(PrimitiveGroup(0, numDepth));
+    }
+    if (numOverlay > 0) {
+        this->drawState.Pipeline = this->overlayPipeline;
+        Gfx::ApplyDrawState(this->drawState);
+        Gfx::ApplyUniformBlock(vsParams);
+        Gfx::Draw(PrimitiveGroup(numDepth, numOverlay));
+    }
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,126 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::debugGeomRenderer
+    @ingroup _priv
+    @brief immediate-mode debug line renderer
+
+    Lines are appended to a vertex buffer owned by the calling thread
+    (each thread buffer has its own lock, which is only contended while
+    drawGeometry() collects the buffers). drawGeometry() merges all
+    thread buffers into one streamed line mesh, with the depth-tested
+    lines first and the overlay lines behind them, and renders
+    each group with a single draw call.
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Buffer.h"
+#include "Core/Threading/RWLock.h"
+#include "Core/Threading/ThreadLocalPtr.h"
+#include "Resource/ResourceLabel.h"
+#include "Gfx/Core/VertexLayout.h"
+#include "Gfx/Core/DrawState.h"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+#include "glm/mat4x4.hpp"
+
+namespace Oryol {
+namespace _priv {
+
+class debugGeomRenderer {
+public:
+    /// constructor
+    debugGeomRenderer();
+    /// destructor
+    ~debugGeomRenderer();
+
+    /// set max number of lines per frame (must be called before first line)
+    void setMaxNumLines(int num);
+    /// discard the geometry renderer
+    void discard();
+    /// return true if the Gfx resources have been setup
+    bool isValid() const;
+
+    /// set the view-projection matrix for the next drawGeometry()
+    void setViewProj(const glm::mat4& viewProj);
+    /// add a line
+    void line(const glm::vec3& p0, const glm::vec3& p1, uint32_t color, bool depthTest);
+    /// add an axis-aligned box
+    void box(const glm::vec3& min, const glm::vec3& max, uint32_t color, bool depthTest);
+    /// add a transformed unit-cube (-0.5 .. +0.5)
+    void box(const glm::mat4& transform, uint32_t color, bool depthTest);
+    /// add a wireframe sphere (3 circles)
+    void sphere(const glm::vec3& center, float radius, uint32_t color, bool depthTest);
+    /// add a grid in the xz plane
+    void grid(const glm::vec3& center, float size, int numCells, uint32_t color, bool depthTest);
+    /// add an arrow
+    void arrow(const glm::vec3& from, const glm::vec3& to, uint32_t color, bool depthTest);
+    /// render all accumulated lines and clear the line buffers
+    void drawGeometry();
+
+    /// number of line vertices in the depth-tested and overlay groups of the last drawGeometry()
+    int numDrawnVertices(bool depthTest) const;
+    /// pack a float RGBA color into a vertex color
+    static uint32_t packColor(const glm::vec4& color);
+
+    /// a line vertex
+    struct vertex {
+        float x, y, z;
+        uint32_t color;
+    };
+
+private:
+    enum mode {
+        depthTested = 0,
+        overlay,
+        numModes
+    };
+    struct threadBuffer {
+        RWLock lock;
+        Buffer vertices[numModes];
+    };
+    /// setup the Gfx resources (called on first draw)
+    void setup();
+    /// get the thread buffer of the calling thread, locked
+    threadBuffer* lockThreadBuffer();
+    /// reserve line vertices in a locked thread buffer, return nullptr if full
+    vertex* addVertices(threadBuffer* buf, bool depthTest, int numVertices);
+    /// merge thread buffers into the staging vertex buffer, return number of vertices
+    int gatherVertices(int mode, int firstVertex);
+
+    static const int NumCircleSegments = 24;
+    static ORYOL_THREADLOCAL_PTR(threadBuffer) localBuffer;
+    static ORYOL_THREADLOCAL_PTR(void) localGeneration;
+    static uint32_t generationCounter;
+
+    bool valid;
+    uint32_t generation;
+    int maxNumVertices;
+    glm::mat4 viewProj;
+    RWLock bufferLock;
+    Array<threadBuffer*> buffers;
+    vertex* stagingVertices;
+    int numVertices[numModes];
+    glm::vec2 circle[NumCircleSegments];
+    VertexLayout vertexLayout;
+    DrawState drawState;
+    Id depthPipeline;
+    Id overlayPipeline;
+    ResourceLabel resourceLabel;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+debugGeomRenderer::isValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+inline int
+debugGeomRenderer::numDrawnVertices(bool depthTest) const {
+    return this->numVertices[depthTest ? depthTested : overlay];
+}
+
+} // namespace _priv
+} // namespace Oryol
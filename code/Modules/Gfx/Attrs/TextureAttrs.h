@@ -28,7 +28,7 @@ struct TextureAttrs {
     int Width = 0;
     /// height of top-level mipmap in pixels
     int Height = 0;
-    /// depth of top-level mipmap in pixels (only used for 3D textures)
+    /// depth of top-level mipmap in pixels (3D textures), or number of layers (2D array textures)
     int Depth = 0;
     /// number of mipmaps (1 for 'no child mipmaps')
     int NumMipMaps = 1;
@@ -0,0 +1,57 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::BakedDrawState
+    @ingroup Gfx
+    @brief a DrawState with pre-resolved resource bindings
+
+    Gfx::ApplyDrawState(const DrawState&) looks up the pipeline, mesh
+    and texture objects by their Ids (and validates them in debug mode)
+    on every call. A BakedDrawState is created once with
+    Gfx::BakeDrawState(), which resolves and validates the bindings
+    and caches the resolved pointers together with a generation stamp
+    of the Gfx resource pools. Applying a BakedDrawState only compares
+    the stamp and calls the renderer directly. The bindings are only
+    resolved again after Gfx resources have been created, destroyed
+    or have changed their state (e.g. finished loading).
+
+    BakedDrawState objects are plain values, they can be copied and
+    don't need to be destroyed.
+*/
+#include "Gfx/Core/DrawState.h"
+
+namespace Oryol {
+
+namespace _priv {
+class pipeline;
+class mesh;
+class texture;
+
+/// resolved resource pointers of a DrawState
+struct drawStateBindings {
+    pipeline* pip = nullptr;
+    mesh* meshes[GfxConfig::MaxNumInputMeshes] = { };
+    int numMeshes = 0;
+    texture* vsTextures[GfxConfig::MaxNumVertexTextures] = { };
+    int numVSTextures = 0;
+    texture* fsTextures[GfxConfig::MaxNumFragmentTextures] = { };
+    int numFSTextures = 0;
+};
+} // namespace _priv
+
+class BakedDrawState {
+public:
+    /// get the original DrawState
+    const struct DrawState& DrawState() const {
+        return this->drawState;
+    };
+
+private:
+    friend class Gfx;
+    struct DrawState drawState;
+    mutable uint32_t stamp = 0;
+    mutable bool resolved = false;
+    mutable _priv::drawStateBindings bindings;
+};
+
+} // namespace Oryol
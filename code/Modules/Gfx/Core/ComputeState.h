@@ -0,0 +1,30 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::ComputeState
+    @brief state required to dispatch compute shaders
+
+    The ComputeState struct contains the state required to issue
+    compute dispatches with the exception of shader uniforms:
+
+    - 1 compute shader (created from a compute program)
+    - 0..N meshes, their vertex buffers are bound as storage buffers
+      to the binding points 0..N-1
+
+    Meshes used as storage buffers must have been created with
+    Usage::Dynamic or Usage::Stream.
+*/
+#include "Gfx/Core/GfxConfig.h"
+#include "Resource/Id.h"
+#include "Core/Containers/StaticArray.h"
+
+namespace Oryol {
+
+struct ComputeState {
+    /// the compute shader
+    Id Shader;
+    /// meshes bound as storage buffers
+    StaticArray<Id, GfxConfig::MaxNumStorageBuffers> StorageBuffer;
+};
+
+} // namespace Oryol
@@ -401,6 +401,7 @@ public:
         Mesh,               ///< a mesh
         Shader,             ///< a shader
         Pipeline,           ///< a pipeline state object
+        Query,              ///< a GPU query object (e.g. occlusion query)
 
         NumResourceTypes,
         InvalidResourceType = 0xFFFF,
@@ -411,7 +412,10 @@ public:
 /**
     @class Oryol::ShaderStage
     @ingroup Gfx
-    @brief the shader stages (vertex shader, fragment shader)
+    @brief the shader stages (vertex shader, fragment shader, compute shader)
+
+    The compute shader stage is only used by compute programs, which
+    can't be used in a pipeline, see Gfx::ApplyComputeState().
 */
 class ShaderStage {
 public:
@@ -419,6 +423,7 @@ public:
     enum Code {
         VS = 0,
         FS,
+        CS,
 
         NumShaderStages,
         InvalidShaderStage = 0xFFFFFFFF,
@@ -452,7 +457,7 @@ public:
 /**
     @class Oryol::TextureType
     @ingroup Gfx
-    @brief texture type (2D, 3D, Cube)
+    @brief texture type (2D, 3D, Cube, 2D array)
 */
 class TextureType {
 public:
@@ -461,6 +466,7 @@ public:
         Texture2D = 0,
         Texture3D,
         TextureCube,
+        Texture2DArray,
 
         NumTextureTypes,
         InvalidTextureType = 0xFFFFFFFF,
@@ -671,6 +677,9 @@ public:
         Instancing,                 ///< supports hardware-instanced rendering
         OriginBottomLeft,           ///< image space origin is bottom-left (GL-style)
         OriginTopLeft,              ///< image space origin is top-left (D3D-style)
+        ComputeShaders,             ///< supports compute shaders and storage buffers
+        OcclusionQuery,             ///< supports occlusion queries
+        ConditionalRender,          ///< supports conditional rendering on occlusion query results
 
         NumFeatures,
         InvalidFeature
@@ -861,4 +870,48 @@ public:
     };
 };
 
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::QueryType
+    @ingroup Gfx
+    @brief the type of a GPU query resource
+
+    SamplesPassed counts the samples which passed the depth and stencil
+    tests, AnySamplesPassed only returns 0 or 1 but may be cheaper
+    (and is the only occlusion query type on GLES3).
+*/
+class QueryType {
+public:
+    enum Code {
+        SamplesPassed = 0,  ///< occlusion query, number of samples passed
+        AnySamplesPassed,   ///< occlusion query, 0 if no samples passed, otherwise 1
+
+        NumQueryTypes,
+        InvalidQueryType,
+    };
+};
+
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::BarrierBits
+    @ingroup Gfx
+    @brief what memory writes of compute shaders a Gfx::Barrier() waits for
+
+    A barrier makes storage buffer writes of previous compute dispatches
+    visible to the following operations which read the same data.
+*/
+class BarrierBits {
+public:
+    typedef uint8_t Mask;
+    enum Bits {
+        None         = 0,
+
+        VertexData   = (1<<0),  ///< data is used as vertex data in draw calls
+        StorageData  = (1<<1),  ///< data is used as storage buffer in dispatches
+        BufferUpdate = (1<<2),  ///< data is read back or overwritten by buffer updates
+
+        All = VertexData|StorageData|BufferUpdate,
+    };
+};
+
 } // namespace Oryol
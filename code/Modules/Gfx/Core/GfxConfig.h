@@ -20,6 +20,8 @@ public:
     static const int DefaultMaxApplyDrawStatesPerFrame = 4096;
     /// max number of input meshes
     static const int MaxNumInputMeshes = 4;
+    /// max number of storage buffers bound for compute shaders
+    static const int MaxNumStorageBuffers = 4;
     /// maximum number of primitive groups for one mesh
     static const int MaxNumPrimGroups = 8;
     /// max number of uniform blocks per stage
@@ -19,6 +19,10 @@ struct GfxFrameInfo {
     int NumUpdateTextures = 0;
     int NumDraw = 0;
     int NumDrawInstanced = 0;
+    int NumApplyComputeState = 0;
+    int NumDispatch = 0;
+    int NumBarrier = 0;
+    int NumQueries = 0;
 };
 
 } // namespace Oryol
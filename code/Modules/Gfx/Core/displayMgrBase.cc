@@ -99,6 +99,24 @@ displayMgrBase::QuitRequested() const {
     return false;
 }
 
+//------------------------------------------------------------------------------
+bool
+displayMgrBase::SupportsRenderThread() const {
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void
+displayMgrBase::AcquireContext() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+void
+displayMgrBase::ReleaseContext() {
+    // empty
+}
+
 //------------------------------------------------------------------------------
 const DisplayAttrs&
 displayMgrBase::GetDisplayAttrs() const {
@@ -43,6 +43,12 @@ public:
     void Present();
     /// check whether the window system requests to quit the application
     bool QuitRequested() const;
+    /// return true if the 3D API context can be moved to a render thread
+    bool SupportsRenderThread() const;
+    /// make the 3D API context current on the calling thread
+    void AcquireContext();
+    /// detach the 3D API context from the calling thread
+    void ReleaseContext();
     
     /// get actual display attributes (can be different from DisplaySetup)
     const DisplayAttrs& GetDisplayAttrs() const;
@@ -0,0 +1,248 @@
+//------------------------------------------------------------------------------
+//  gfxCmdStream.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "gfxCmdStream.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::putCmd(cmdCode cmd) {
+    this->put(cmd);
+    this->cmdCount++;
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::putPayload(const void* data, int numBytes) {
+    o_assert_dbg(data && (numBytes > 0));
+
+    // pad so that the payload starts at an aligned offset, the
+    // buffer itself is allocated with at least this alignment
+    const int pad = Memory::RoundUp(this->buf.Size(), PayloadAlign) - this->buf.Size();
+    if (pad > 0) {
+        this->buf.Add(pad);
+    }
+    Memory::Copy(data, this->buf.Add(numBytes), numBytes);
+}
+
+//------------------------------------------------------------------------------
+const uint8_t*
+gfxCmdStream::getPayload(const uint8_t*& ptr, int numBytes) const {
+    const int offset = int(ptr - this->buf.Data());
+    const uint8_t* payload = this->buf.Data() + Memory::RoundUp(offset, PayloadAlign);
+    ptr = payload + numBytes;
+    return payload;
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::clear() {
+    this->buf.Clear();
+    this->cmdCount = 0;
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::applyRenderTarget(texture* rt, const ClearState& clearState) {
+    this->putCmd(cmdApplyRenderTarget);
+    this->put(rt);
+    this->put(clearState);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::applyViewPort(int x, int y, int width, int height, bool originTopLeft) {
+    this->putCmd(cmdApplyViewPort);
+    this->put(x);
+    this->put(y);
+    this->put(width);
+    this->put(height);
+    this->put(originTopLeft);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::applyScissorRect(int x, int y, int width, int height, bool originTopLeft) {
+    this->putCmd(cmdApplyScissorRect);
+    this->put(x);
+    this->put(y);
+    this->put(width);
+    this->put(height);
+    this->put(originTopLeft);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::applyDrawState(pipeline* pip, mesh** meshes, int numMeshes) {
+    o_assert_dbg((numMeshes >= 0) && (numMeshes <= GfxConfig::MaxNumInputMeshes));
+    this->putCmd(cmdApplyDrawState);
+    this->put(pip);
+    this->put(numMeshes);
+    for (int i = 0; i < numMeshes; i++) {
+        this->put(meshes[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::applyTextures(ShaderStage::Code bindStage, texture** textures, int numTextures) {
+    o_assert_dbg((numTextures >= 0) && (numTextures <= GfxConfig::MaxNumShaderTextures));
+    this->putCmd(cmdApplyTextures);
+    this->put(bindStage);
+    this->put(numTextures);
+    for (int i = 0; i < numTextures; i++) {
+        this->put(textures[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::applyUniformBlock(ShaderStage::Code bindStage, int bindSlot, int64_t layoutHash, const uint8_t* ptr, int byteSize) {
+    this->putCmd(cmdApplyUniformBlock);
+    this->put(bindStage);
+    this->put(bindSlot);
+    this->put(layoutHash);
+    this->put(byteSize);
+    this->putPayload(ptr, byteSize);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::draw(int primGroupIndex) {
+    this->putCmd(cmdDraw);
+    this->put(primGroupIndex);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::draw(const PrimitiveGroup& primGroup) {
+    this->putCmd(cmdDrawPrimGroup);
+    this->put(primGroup);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::drawInstanced(int primGroupIndex, int numInstances) {
+    this->putCmd(cmdDrawInstanced);
+    this->put(primGroupIndex);
+    this->put(numInstances);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::drawInstanced(const PrimitiveGroup& primGroup, int numInstances) {
+    this->putCmd(cmdDrawInstancedPrimGroup);
+    this->put(primGroup);
+    this->put(numInstances);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::applyComputeState(shader* shd, mesh** storageBuffers, int numStorageBuffers) {
+    o_assert_dbg((numStorageBuffers >= 0) && (numStorageBuffers <= GfxConfig::MaxNumStorageBuffers));
+    this->putCmd(cmdApplyComputeState);
+    this->put(shd);
+    this->put(numStorageBuffers);
+    for (int i = 0; i < numStorageBuffers; i++) {
+        this->put(storageBuffers[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::dispatch(int numGroupsX, int numGroupsY, int numGroupsZ) {
+    this->putCmd(cmdDispatch);
+    this->put(numGroupsX);
+    this->put(numGroupsY);
+    this->put(numGroupsZ);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::barrier(BarrierBits::Mask bits) {
+    this->putCmd(cmdBarrier);
+    this->put(bits);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::beginQuery(query* qry) {
+    this->putCmd(cmdBeginQuery);
+    this->put(qry);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::endQuery(query* qry) {
+    this->putCmd(cmdEndQuery);
+    this->put(qry);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::beginConditionalRender(query* qry) {
+    this->putCmd(cmdBeginConditionalRender);
+    this->put(qry);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::endConditionalRender() {
+    this->putCmd(cmdEndConditionalRender);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::updateVertices(mesh* msh, const void* data, int numBytes) {
+    this->putCmd(cmdUpdateVertices);
+    this->put(msh);
+    this->put(numBytes);
+    this->putPayload(data, numBytes);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::updateIndices(mesh* msh, const void* data, int numBytes) {
+    this->putCmd(cmdUpdateIndices);
+    this->put(msh);
+    this->put(numBytes);
+    this->putPayload(data, numBytes);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::updateTexture(texture* tex, const void* data, const ImageDataAttrs& offsetsAndSizes) {
+    this->putCmd(cmdUpdateTexture);
+    this->put(tex);
+
+    // the surface offsets are relative to the data pointer, so the copied
+    // payload must cover everything up to the end of the last surface
+    int numBytes = 0;
+    this->put(offsetsAndSizes.NumFaces);
+    this->put(offsetsAndSizes.NumMipMaps);
+    for (int faceIndex = 0; faceIndex < offsetsAndSizes.NumFaces; faceIndex++) {
+        for (int mipIndex = 0; mipIndex < offsetsAndSizes.NumMipMaps; mipIndex++) {
+            const int offset = offsetsAndSizes.Offsets[faceIndex][mipIndex];
+            const int size = offsetsAndSizes.Sizes[faceIndex][mipIndex];
+            this->put(offset);
+            this->put(size);
+            if ((offset + size) > numBytes) {
+                numBytes = offset + size;
+            }
+        }
+    }
+    this->put(numBytes);
+    this->putPayload(data, numBytes);
+}
+
+//------------------------------------------------------------------------------
+void
+gfxCmdStream::resetStateCache() {
+    this->putCmd(cmdResetStateCache);
+}
+
+} // namespace _priv
+} // namespace Oryol
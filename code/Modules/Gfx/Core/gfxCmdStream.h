@@ -0,0 +1,330 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::gfxCmdStream
+    @ingroup _priv
+    @brief private: recorded stream of renderer calls
+
+    A gfxCmdStream records the renderer calls of the Gfx facade
+    into a byte buffer, and replays them later (usually on the
+    render thread) into the actual renderer. Resources are recorded
+    as resolved pointers, data payloads (vertices, indices, texture
+    data and uniform blocks) are copied into the stream, so that the
+    caller may modify or release its data after the call returns.
+
+    The method names and signatures are identical with the renderer
+    class, replay() simply calls the same methods on the renderer.
+
+    @see renderThread
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Buffer.h"
+#include "Gfx/Core/Enums.h"
+#include "Gfx/Core/ClearState.h"
+#include "Gfx/Core/PrimitiveGroup.h"
+#include "Gfx/Core/GfxConfig.h"
+#include "Gfx/Attrs/ImageDataAttrs.h"
+#include <type_traits>
+
+namespace Oryol {
+namespace _priv {
+
+class texture;
+class pipeline;
+class mesh;
+class shader;
+class query;
+
+class gfxCmdStream {
+public:
+    /// apply a render target (default or offscreen)
+    void applyRenderTarget(texture* rt, const ClearState& clearState);
+    /// apply viewport
+    void applyViewPort(int x, int y, int width, int height, bool originTopLeft);
+    /// apply scissor rect
+    void applyScissorRect(int x, int y, int width, int height, bool originTopLeft);
+    /// apply draw state
+    void applyDrawState(pipeline* pip, mesh** meshes, int numMeshes);
+    /// apply a group of textures
+    void applyTextures(ShaderStage::Code bindStage, texture** textures, int numTextures);
+    /// apply a shader uniform block (data is copied)
+    void applyUniformBlock(ShaderStage::Code bindStage, int bindSlot, int64_t layoutHash, const uint8_t* ptr, int byteSize);
+    /// submit a draw call with primitive group index in current mesh
+    void draw(int primGroupIndex);
+    /// submit a draw call with direct primitive group
+    void draw(const PrimitiveGroup& primGroup);
+    /// submit an instanced draw call with primitive group index in current mesh
+    void drawInstanced(int primGroupIndex, int numInstances);
+    /// submit an instanced draw call with direct primitive group
+    void drawInstanced(const PrimitiveGroup& primGroup, int numInstances);
+    /// apply compute state
+    void applyComputeState(shader* shd, mesh** storageBuffers, int numStorageBuffers);
+    /// submit a compute dispatch
+    void dispatch(int numGroupsX, int numGroupsY, int numGroupsZ);
+    /// wait for memory writes of previous compute dispatches
+    void barrier(BarrierBits::Mask bits);
+    /// begin a GPU query
+    void beginQuery(query* qry);
+    /// end a GPU query
+    void endQuery(query* qry);
+    /// begin conditional rendering on an occlusion query result
+    void beginConditionalRender(query* qry);
+    /// end conditional rendering
+    void endConditionalRender();
+    /// update vertex data (data is copied)
+    void updateVertices(mesh* msh, const void* data, int numBytes);
+    /// update index data (data is copied)
+    void updateIndices(mesh* msh, const void* data, int numBytes);
+    /// update texture pixel data (data is copied)
+    void updateTexture(texture* tex, const void* data, const ImageDataAttrs& offsetsAndSizes);
+    /// reset the renderer's state cache
+    void resetStateCache();
+
+    /// replay the recorded calls into a renderer
+    template<class RENDERER> void replay(RENDERER& renderer) const;
+    /// clear the stream, keeps the allocated memory
+    void clear();
+    /// return true if no calls have been recorded
+    bool empty() const;
+    /// number of recorded calls
+    int numCmds() const;
+    /// size of the recorded stream in bytes
+    int numBytes() const;
+
+private:
+    enum cmdCode : uint8_t {
+        cmdApplyRenderTarget,
+        cmdApplyViewPort,
+        cmdApplyScissorRect,
+        cmdApplyDrawState,
+        cmdApplyTextures,
+        cmdApplyUniformBlock,
+        cmdDraw,
+        cmdDrawPrimGroup,
+        cmdDrawInstanced,
+        cmdDrawInstancedPrimGroup,
+        cmdApplyComputeState,
+        cmdDispatch,
+        cmdBarrier,
+        cmdBeginQuery,
+        cmdEndQuery,
+        cmdBeginConditionalRender,
+        cmdEndConditionalRender,
+        cmdUpdateVertices,
+        cmdUpdateIndices,
+        cmdUpdateTexture,
+        cmdResetStateCache,
+    };
+    /// payloads are aligned to this byte boundary
+    static const int PayloadAlign = 16;
+
+    /// append command code
+    void putCmd(cmdCode cmd);
+    /// append a plain value
+    template<class T> void put(const T& val);
+    /// append an aligned data payload
+    void putPayload(const void* data, int numBytes);
+    /// read a plain value and advance read position
+    template<class T> static T get(const uint8_t*& ptr);
+    /// get pointer to aligned data payload and advance read position
+    const uint8_t* getPayload(const uint8_t*& ptr, int numBytes) const;
+
+    Buffer buf;
+    int cmdCount = 0;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+gfxCmdStream::empty() const {
+    return 0 == this->cmdCount;
+}
+
+//------------------------------------------------------------------------------
+inline int
+gfxCmdStream::numCmds() const {
+    return this->cmdCount;
+}
+
+//------------------------------------------------------------------------------
+inline int
+gfxCmdStream::numBytes() const {
+    return this->buf.Size();
+}
+
+//------------------------------------------------------------------------------
+template<class T> inline void
+gfxCmdStream::put(const T& val) {
+    static_assert(std::is_trivially_copyable<T>::value, "gfxCmdStream: only trivially copyable values allowed!");
+    Memory::Copy(&val, this->buf.Add(sizeof(T)), sizeof(T));
+}
+
+//------------------------------------------------------------------------------
+template<class T> inline T
+gfxCmdStream::get(const uint8_t*& ptr) {
+    T val;
+    Memory::Copy(ptr, &val, sizeof(T));
+    ptr += sizeof(T);
+    return val;
+}
+
+//------------------------------------------------------------------------------
+template<class RENDERER> void
+gfxCmdStream::replay(RENDERER& renderer) const {
+    if (this->buf.Empty()) {
+        return;
+    }
+    const uint8_t* ptr = this->buf.Data();
+    const uint8_t* end = ptr + this->buf.Size();
+    while (ptr < end) {
+        const cmdCode cmd = get<cmdCode>(ptr);
+        switch (cmd) {
+            case cmdApplyRenderTarget:
+                {
+                    texture* rt = get<texture*>(ptr);
+                    const ClearState clearState = get<ClearState>(ptr);
+                    renderer.applyRenderTarget(rt, clearState);
+                }
+                break;
+            case cmdApplyViewPort:
+            case cmdApplyScissorRect:
+                {
+                    const int x = get<int>(ptr);
+                    const int y = get<int>(ptr);
+                    const int w = get<int>(ptr);
+                    const int h = get<int>(ptr);
+                    const bool originTopLeft = get<bool>(ptr);
+                    if (cmdApplyViewPort == cmd) {
+                        renderer.applyViewPort(x, y, w, h, originTopLeft);
+                    }
+                    else {
+                        renderer.applyScissorRect(x, y, w, h, originTopLeft);
+                    }
+                }
+                break;
+            case cmdApplyDrawState:
+                {
+                    pipeline* pip = get<pipeline*>(ptr);
+                    const int numMeshes = get<int>(ptr);
+                    mesh* meshes[GfxConfig::MaxNumInputMeshes] = { };
+                    for (int i = 0; i < numMeshes; i++) {
+                        meshes[i] = get<mesh*>(ptr);
+                    }
+                    renderer.applyDrawState(pip, meshes, numMeshes);
+                }
+                break;
+            case cmdApplyTextures:
+                {
+                    const ShaderStage::Code bindStage = get<ShaderStage::Code>(ptr);
+                    const int numTextures = get<int>(ptr);
+                    texture* textures[GfxConfig::MaxNumShaderTextures] = { };
+                    for (int i = 0; i < numTextures; i++) {
+                        textures[i] = get<texture*>(ptr);
+                    }
+                    renderer.applyTextures(bindStage, textures, numTextures);
+                }
+                break;
+            case cmdApplyUniformBlock:
+                {
+                    const ShaderStage::Code bindStage = get<ShaderStage::Code>(ptr);
+                    const int bindSlot = get<int>(ptr);
+                    const int64_t layoutHash = get<int64_t>(ptr);
+                    const int byteSize = get<int>(ptr);
+                    const uint8_t* data = this->getPayload(ptr, byteSize);
+                    renderer.applyUniformBlock(bindStage, bindSlot, layoutHash, data, byteSize);
+                }
+                break;
+            case cmdDraw:
+                renderer.draw(get<int>(ptr));
+                break;
+            case cmdDrawPrimGroup:
+                renderer.draw(get<PrimitiveGroup>(ptr));
+                break;
+            case cmdDrawInstanced:
+                {
+                    const int primGroupIndex = get<int>(ptr);
+                    const int numInstances = get<int>(ptr);
+                    renderer.drawInstanced(primGroupIndex, numInstances);
+                }
+                break;
+            case cmdDrawInstancedPrimGroup:
+                {
+                    const PrimitiveGroup primGroup = get<PrimitiveGroup>(ptr);
+                    const int numInstances = get<int>(ptr);
+                    renderer.drawInstanced(primGroup, numInstances);
+                }
+                break;
+            case cmdApplyComputeState:
+                {
+                    shader* shd = get<shader*>(ptr);
+                    const int numStorageBuffers = get<int>(ptr);
+                    mesh* storageBuffers[GfxConfig::MaxNumStorageBuffers] = { };
+                    for (int i = 0; i < numStorageBuffers; i++) {
+                        storageBuffers[i] = get<mesh*>(ptr);
+                    }
+                    renderer.applyComputeState(shd, storageBuffers, numStorageBuffers);
+                }
+                break;
+            case cmdDispatch:
+                {
+                    const int x = get<int>(ptr);
+                    const int y = get<int>(ptr);
+                    const int z = get<int>(ptr);
+                    renderer.dispatch(x, y, z);
+                }
+                break;
+            case cmdBarrier:
+                renderer.barrier(get<BarrierBits::Mask>(ptr));
+                break;
+            case cmdBeginQuery:
+                renderer.beginQuery(get<query*>(ptr));
+                break;
+            case cmdEndQuery:
+                renderer.endQuery(get<query*>(ptr));
+                break;
+            case cmdBeginConditionalRender:
+                renderer.beginConditionalRender(get<query*>(ptr));
+                break;
+            case cmdEndConditionalRender:
+                renderer.endConditionalRender();
+                break;
+            case cmdUpdateVertices:
+            case cmdUpdateIndices:
+                {
+                    mesh* msh = get<mesh*>(ptr);
+                    const int numBytes = get<int>(ptr);
+                    const uint8_t* data = this->getPayload(ptr, numBytes);
+                    if (cmdUpdateVertices == cmd) {
+                        renderer.updateVertices(msh, data, numBytes);
+                    }
+                    else {
+                        renderer.updateIndices(msh, data, numBytes);
+                    }
+                }
+                break;
+            case cmdUpdateTexture:
+                {
+                    texture* tex = get<texture*>(ptr);
+                    ImageDataAttrs offsetsAndSizes;
+                    offsetsAndSizes.NumFaces = get<int>(ptr);
+                    offsetsAndSizes.NumMipMaps = get<int>(ptr);
+                    for (int faceIndex = 0; faceIndex < offsetsAndSizes.NumFaces; faceIndex++) {
+                        for (int mipIndex = 0; mipIndex < offsetsAndSizes.NumMipMaps; mipIndex++) {
+                            offsetsAndSizes.Offsets[faceIndex][mipIndex] = get<int>(ptr);
+                            offsetsAndSizes.Sizes[faceIndex][mipIndex] = get<int>(ptr);
+                        }
+                    }
+                    const int numBytes = get<int>(ptr);
+                    const uint8_t* data = this->getPayload(ptr, numBytes);
+                    renderer.updateTexture(tex, data, offsetsAndSizes);
+                }
+                break;
+            case cmdResetStateCache:
+                renderer.resetStateCache();
+                break;
+        }
+    }
+    o_assert_dbg(ptr == end);
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -21,6 +21,8 @@ class meshPool;
 class shaderPool;
 class texturePool;
 class pipelinePool;
+class queryPool;
+class renderThread;
 
 struct gfxPointers {
     class renderer* renderer = nullptr;
@@ -30,6 +32,8 @@ struct gfxPointers {
     class shaderPool* shaderPool = nullptr;
     class texturePool* texturePool = nullptr;
     class pipelinePool* pipelinePool = nullptr;
+    class queryPool* queryPool = nullptr;
+    class renderThread* renderThread = nullptr;
 };
 
 } // namespace _priv
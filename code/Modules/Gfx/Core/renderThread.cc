@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+//  renderThread.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "renderThread.h"
+#include "Core/Assertion.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+renderThread::~renderThread() {
+    o_assert_dbg(!this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+renderThread::setup(threadCallback onStart, replayCallback onReplay, threadCallback onStop) {
+    o_assert_dbg(!this->valid);
+    o_assert_dbg(onReplay);
+    #if ORYOL_HAS_THREADS
+    this->startFunc = std::move(onStart);
+    this->replayFunc = std::move(onReplay);
+    this->stopFunc = std::move(onStop);
+    this->jobPending = false;
+    this->stopRequested = false;
+    this->recordIndex = 0;
+    this->frameCount = 0;
+    this->valid = true;
+    this->thread = std::thread(threadMain, this);
+    #else
+    o_error("renderThread::setup(): platform has no threads!\n");
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+renderThread::discard() {
+    o_assert_dbg(this->valid);
+    #if ORYOL_HAS_THREADS
+    // calls recorded since the last commit are still executed (but not presented)
+    this->call(callFunc());
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->stopRequested = true;
+    }
+    this->jobCondVar.notify_one();
+    this->thread.join();
+    #endif
+    this->valid = false;
+    this->startFunc = nullptr;
+    this->replayFunc = nullptr;
+    this->stopFunc = nullptr;
+    this->streams[0].clear();
+    this->streams[1].clear();
+}
+
+//------------------------------------------------------------------------------
+void
+renderThread::commitFrame(const callFunc& syncFunc) {
+    o_assert_dbg(this->valid);
+    #if ORYOL_HAS_THREADS
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->waitIdle(lock);
+        if (syncFunc) {
+            syncFunc();
+        }
+        this->jobCmds = &this->streams[this->recordIndex];
+        this->jobEndOfFrame = true;
+        this->jobFunc = nullptr;
+        this->jobPending = true;
+    }
+    this->jobCondVar.notify_one();
+    #endif
+    // the render thread has cleared the other stream after replaying it
+    this->recordIndex ^= 1;
+    o_assert_dbg(this->cmdStream().empty());
+    this->frameCount++;
+}
+
+//------------------------------------------------------------------------------
+void
+renderThread::call(callFunc func) {
+    if (!this->valid) {
+        if (func) {
+            func();
+        }
+        return;
+    }
+    #if ORYOL_HAS_THREADS
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->waitIdle(lock);
+    this->jobCmds = &this->streams[this->recordIndex];
+    this->jobEndOfFrame = false;
+    this->jobFunc = &func;
+    this->jobPending = true;
+    this->jobCondVar.notify_one();
+    this->waitIdle(lock);
+    #endif
+}
+
+#if ORYOL_HAS_THREADS
+//------------------------------------------------------------------------------
+void
+renderThread::waitIdle(std::unique_lock<std::mutex>& lock) {
+    while (this->jobPending) {
+        this->doneCondVar.wait(lock);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+renderThread::threadMain(renderThread* self) {
+    if (self->startFunc) {
+        self->startFunc();
+    }
+    for (;;) {
+        gfxCmdStream* cmds = nullptr;
+        bool endOfFrame = false;
+        callFunc* func = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(self->mutex);
+            while (!self->jobPending && !self->stopRequested) {
+                self->jobCondVar.wait(lock);
+            }
+            if (!self->jobPending) {
+                break;
+            }
+            cmds = self->jobCmds;
+            endOfFrame = self->jobEndOfFrame;
+            func = self->jobFunc;
+        }
+        // the main thread doesn't touch the job's stream until the job is done
+        if (cmds) {
+            if (endOfFrame || !cmds->empty()) {
+                self->replayFunc(*cmds, endOfFrame);
+            }
+            cmds->clear();
+        }
+        if (func && *func) {
+            (*func)();
+        }
+        {
+            std::unique_lock<std::mutex> lock(self->mutex);
+            self->jobPending = false;
+            self->jobCmds = nullptr;
+            self->jobFunc = nullptr;
+        }
+        self->doneCondVar.notify_all();
+    }
+    if (self->stopFunc) {
+        self->stopFunc();
+    }
+}
+#endif
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,117 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::renderThread
+    @ingroup _priv
+    @brief private: replay recorded Gfx calls on a dedicated thread
+
+    The renderThread owns two command streams. The main thread records
+    the Gfx calls of the current frame into one stream, while the render
+    thread replays the previous frame's stream into the renderer, so that
+    the application update and the 3D API submission of two consecutive
+    frames overlap. commitFrame() waits until the render thread has
+    finished the previous frame and swaps the streams. The optional
+    sync function passed to commitFrame() is called on the main thread
+    while the render thread is idle, this is used to hand data written
+    by the render thread (e.g. query results) over to the main thread.
+
+    call() runs a function on the render thread and waits for it to
+    finish. This is used for everything which needs the 3D API context
+    outside of the command stream (resource creation and destruction,
+    reading back pixels). Before the function runs, all calls recorded so
+    far in the current frame are replayed, so the order of operations is
+    the same as without a render thread.
+
+    The thread callbacks are provided by the owner: onStart and onStop are
+    called on the render thread to bind and unbind the 3D API context,
+    onReplay replays a stream, with endOfFrame set if the stream must be
+    followed by committing and presenting the frame.
+
+    If no thread has been started, call() runs the function directly.
+*/
+#include "Core/Types.h"
+#include "Core/InplaceFunction.h"
+#include "Gfx/Core/gfxCmdStream.h"
+#if ORYOL_HAS_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+class renderThread {
+public:
+    /// render thread start/stop callback
+    typedef InplaceFunction<void()> threadCallback;
+    /// replay callback, called on the render thread
+    typedef InplaceFunction<void(const gfxCmdStream& cmds, bool endOfFrame)> replayCallback;
+    /// a function to run synchronously on the render thread
+    typedef InplaceFunction<void()> callFunc;
+
+    /// destructor
+    ~renderThread();
+
+    /// start the render thread
+    void setup(threadCallback onStart, replayCallback onReplay, threadCallback onStop);
+    /// finish all pending work and stop the render thread
+    void discard();
+    /// return true if the render thread is running
+    bool isValid() const;
+
+    /// get the command stream for recording the current frame
+    gfxCmdStream& cmdStream();
+    /// hand the current frame to the render thread and start recording the next
+    void commitFrame(const callFunc& syncFunc=callFunc());
+    /// replay the current frame's calls so far, then run func on the render thread, and wait
+    void call(callFunc func);
+    /// number of frames handed to the render thread so far
+    int64_t numCommittedFrames() const;
+
+private:
+    #if ORYOL_HAS_THREADS
+    /// the render thread's main loop
+    static void threadMain(renderThread* self);
+    /// wait until the render thread has finished the current job, mutex must be locked
+    void waitIdle(std::unique_lock<std::mutex>& lock);
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable jobCondVar;
+    std::condition_variable doneCondVar;
+    bool jobPending = false;
+    bool stopRequested = false;
+    gfxCmdStream* jobCmds = nullptr;
+    bool jobEndOfFrame = false;
+    callFunc* jobFunc = nullptr;
+    #endif
+    bool valid = false;
+    threadCallback startFunc;
+    replayCallback replayFunc;
+    threadCallback stopFunc;
+    gfxCmdStream streams[2];
+    int recordIndex = 0;
+    int64_t frameCount = 0;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+renderThread::isValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+inline gfxCmdStream&
+renderThread::cmdStream() {
+    return this->streams[this->recordIndex];
+}
+
+//------------------------------------------------------------------------------
+inline int64_t
+renderThread::numCommittedFrames() const {
+    return this->frameCount;
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -27,6 +27,12 @@ Gfx::Setup(const class GfxSetup& setup) {
     pointers.shaderPool = &state->resourceContainer.shaderPool;
     pointers.texturePool = &state->resourceContainer.texturePool;
     pointers.pipelinePool = &state->resourceContainer.pipelinePool;
+    pointers.queryPool = &state->resourceContainer.queryPool;
+    #if ORYOL_HAS_THREADS
+    if (setup.RenderThread) {
+        pointers.renderThread = &state->renderThread;
+    }
+    #endif
     
     state->displayManager.SetupDisplay(setup, pointers);
     state->renderer.setup(setup, pointers);
@@ -35,6 +41,9 @@ Gfx::Setup(const class GfxSetup& setup) {
         state->displayManager.ProcessSystemEvents();
     });
     state->gfxFrameInfo = GfxFrameInfo();
+    if (setup.RenderThread) {
+        setupRenderThread();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -42,6 +51,9 @@ void
 Gfx::Discard() {
     o_assert_dbg(IsValid());
     state->resourceContainer.Destroy(ResourceLabel::All);
+    if (state->renderThread.isValid()) {
+        discardRenderThread();
+    }
     Core::PreRunLoop()->Remove(state->runLoopId);
     state->renderer.discard();
     state->resourceContainer.discard();
@@ -50,6 +62,50 @@ Gfx::Discard() {
     state = nullptr;
 }
 
+//------------------------------------------------------------------------------
+void
+Gfx::setupRenderThread() {
+    #if ORYOL_HAS_THREADS
+    if (!state->displayManager.SupportsRenderThread()) {
+        o_warn("Gfx: render thread not supported on this platform, rendering on main thread\n");
+        state->gfxSetup.RenderThread = false;
+        return;
+    }
+
+    // from here on, Gfx calls on the main thread are recorded into a command
+    // stream, which is replayed and presented on the render thread after
+    // CommitFrame(), the 3D API context moves over to the render thread
+    state->renderTargetAttrs = state->renderer.renderTargetAttrs();
+    state->displayManager.ReleaseContext();
+    state->renderThread.setup(
+        [] {
+            state->displayManager.AcquireContext();
+        },
+        [](const gfxCmdStream& cmds, bool endOfFrame) {
+            o_trace_scoped(Gfx_RenderThreadReplay);
+            cmds.replay(state->renderer);
+            if (endOfFrame) {
+                state->renderer.commitFrame();
+                state->displayManager.Present();
+            }
+        },
+        [] {
+            state->displayManager.ReleaseContext();
+        });
+    #else
+    o_warn("Gfx: render thread requires thread support, rendering on main thread\n");
+    state->gfxSetup.RenderThread = false;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::discardRenderThread() {
+    o_assert_dbg(state->renderThread.isValid());
+    state->renderThread.discard();
+    state->displayManager.AcquireContext();
+}
+
 //------------------------------------------------------------------------------
 bool
 Gfx::IsValid() {
@@ -95,6 +151,9 @@ Gfx::DisplayAttrs() {
 const DisplayAttrs&
 Gfx::RenderTargetAttrs() {
     o_assert_dbg(IsValid());
+    if (state->renderThread.isValid()) {
+        return state->renderTargetAttrs;
+    }
     return state->renderer.renderTargetAttrs();
 }
 
@@ -110,7 +169,13 @@ void
 Gfx::ApplyDefaultRenderTarget(const ClearState& clearState) {
     o_assert_dbg(IsValid());
     state->gfxFrameInfo.NumApplyRenderTarget++;
-    state->renderer.applyRenderTarget(nullptr, clearState);
+    if (state->renderThread.isValid()) {
+        state->renderTargetAttrs = state->displayManager.GetDisplayAttrs();
+        state->renderThread.cmdStream().applyRenderTarget(nullptr, clearState);
+    }
+    else {
+        state->renderer.applyRenderTarget(nullptr, clearState);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -123,7 +188,13 @@ Gfx::ApplyRenderTarget(const Id& id, const ClearState& clearState) {
     state->gfxFrameInfo.NumApplyRenderTarget++;
     texture* renderTarget = state->resourceContainer.lookupTexture(id);
     o_assert_dbg(nullptr != renderTarget);
-    state->renderer.applyRenderTarget(renderTarget, clearState);
+    if (state->renderThread.isValid()) {
+        state->renderTargetAttrs = Oryol::DisplayAttrs::FromTextureAttrs(renderTarget->textureAttrs);
+        state->renderThread.cmdStream().applyRenderTarget(renderTarget, clearState);
+    }
+    else {
+        state->renderer.applyRenderTarget(renderTarget, clearState);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -131,63 +202,269 @@ void
 Gfx::ApplyDrawState(const DrawState& drawState) {
     o_trace_scoped(Gfx_ApplyDrawState);
     o_assert_dbg(IsValid());
-    o_assert_dbg(drawState.Pipeline.Type == GfxResourceType::Pipeline);
     state->gfxFrameInfo.NumApplyDrawState++;
+    drawStateBindings bindings;
+    resolveDrawState(drawState, bindings);
+    applyDrawStateBindings(bindings);
+}
 
-    // apply pipeline and meshes
-    pipeline* pip = state->resourceContainer.lookupPipeline(drawState.Pipeline);
-    o_assert_dbg(pip);
-    mesh* meshes[GfxConfig::MaxNumInputMeshes] = { };
-    int numMeshes = 0;
-    for (; numMeshes < GfxConfig::MaxNumInputMeshes; numMeshes++) {
-        if (drawState.Mesh[numMeshes].IsValid()) {
-            meshes[numMeshes] = state->resourceContainer.lookupMesh(drawState.Mesh[numMeshes]);
+//------------------------------------------------------------------------------
+BakedDrawState
+Gfx::BakeDrawState(const DrawState& drawState) {
+    o_assert_dbg(IsValid());
+    BakedDrawState bakedDrawState;
+    bakedDrawState.drawState = drawState;
+    bakedDrawState.stamp = state->resourceContainer.resourceGeneration();
+    bakedDrawState.resolved = true;
+    resolveDrawState(drawState, bakedDrawState.bindings);
+    return bakedDrawState;
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::ApplyDrawState(const BakedDrawState& bakedDrawState) {
+    o_trace_scoped(Gfx_ApplyDrawState);
+    o_assert_dbg(IsValid());
+    state->gfxFrameInfo.NumApplyDrawState++;
+
+    // only resolve again if resources have been created, destroyed or changed state
+    const uint32_t stamp = state->resourceContainer.resourceGeneration();
+    if (!bakedDrawState.resolved || (stamp != bakedDrawState.stamp)) {
+        bakedDrawState.bindings = drawStateBindings();
+        resolveDrawState(bakedDrawState.drawState, bakedDrawState.bindings);
+        bakedDrawState.stamp = stamp;
+        bakedDrawState.resolved = true;
+    }
+    applyDrawStateBindings(bakedDrawState.bindings);
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::resolveDrawState(const DrawState& drawState, drawStateBindings& out) {
+    o_assert_dbg(drawState.Pipeline.Type == GfxResourceType::Pipeline);
+
+    // lookup pipeline and meshes
+    out.pip = state->resourceContainer.lookupPipeline(drawState.Pipeline);
+    o_assert_dbg(out.pip);
+    for (; out.numMeshes < GfxConfig::MaxNumInputMeshes; out.numMeshes++) {
+        if (drawState.Mesh[out.numMeshes].IsValid()) {
+            out.meshes[out.numMeshes] = state->resourceContainer.lookupMesh(drawState.Mesh[out.numMeshes]);
         }
         else {
             break;
         }
     }
     #if ORYOL_DEBUG
-    validateMeshes(pip, meshes, numMeshes);
+    validateMeshes(out.pip, out.meshes, out.numMeshes);
     #endif
-    state->renderer.applyDrawState(pip, meshes, numMeshes);
 
-    // apply vertex textures if any
-    texture* vsTextures[GfxConfig::MaxNumVertexTextures] = { };
-    int numVSTextures = 0;
-    for (; numVSTextures < GfxConfig::MaxNumVertexTextures; numVSTextures++) {
-        const Id& texId = drawState.VSTexture[numVSTextures];
+    // lookup vertex textures if any
+    for (; out.numVSTextures < GfxConfig::MaxNumVertexTextures; out.numVSTextures++) {
+        const Id& texId = drawState.VSTexture[out.numVSTextures];
         if (texId.IsValid()) {
-            vsTextures[numVSTextures] = state->resourceContainer.lookupTexture(texId);
+            out.vsTextures[out.numVSTextures] = state->resourceContainer.lookupTexture(texId);
         }
         else {
             break;
         }
     }
-    if (numVSTextures > 0) {
-        #if ORYOL_DEBUG
-        validateTextures(ShaderStage::VS, pip, vsTextures, numVSTextures);
-        #endif
-        state->renderer.applyTextures(ShaderStage::VS, vsTextures, numVSTextures);
+    #if ORYOL_DEBUG
+    if (out.numVSTextures > 0) {
+        validateTextures(ShaderStage::VS, out.pip, out.vsTextures, out.numVSTextures);
     }
+    #endif
 
-    // apply fragment textures if any
-    texture* fsTextures[GfxConfig::MaxNumFragmentTextures] = { };
-    int numFSTextures = 0;
-    for (; numFSTextures < GfxConfig::MaxNumFragmentTextures; numFSTextures++) {
-        const Id& texId = drawState.FSTexture[numFSTextures];
+    // lookup fragment textures if any
+    for (; out.numFSTextures < GfxConfig::MaxNumFragmentTextures; out.numFSTextures++) {
+        const Id& texId = drawState.FSTexture[out.numFSTextures];
         if (texId.IsValid()) {
-            fsTextures[numFSTextures] = state->resourceContainer.lookupTexture(texId);
+            out.fsTextures[out.numFSTextures] = state->resourceContainer.lookupTexture(texId);
         }
         else {
             break;
         }
     }
-    if (numFSTextures > 0) {
-        #if ORYOL_DEBUG
-        validateTextures(ShaderStage::FS, pip, fsTextures, numFSTextures);
-        #endif
-        state->renderer.applyTextures(ShaderStage::FS, fsTextures, numFSTextures);
+    #if ORYOL_DEBUG
+    if (out.numFSTextures > 0) {
+        validateTextures(ShaderStage::FS, out.pip, out.fsTextures, out.numFSTextures);
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::applyDrawStateBindings(drawStateBindings& bindings) {
+    if (state->renderThread.isValid()) {
+        gfxCmdStream& cmds = state->renderThread.cmdStream();
+        cmds.applyDrawState(bindings.pip, bindings.meshes, bindings.numMeshes);
+        if (bindings.numVSTextures > 0) {
+            cmds.applyTextures(ShaderStage::VS, bindings.vsTextures, bindings.numVSTextures);
+        }
+        if (bindings.numFSTextures > 0) {
+            cmds.applyTextures(ShaderStage::FS, bindings.fsTextures, bindings.numFSTextures);
+        }
+    }
+    else {
+        state->renderer.applyDrawState(bindings.pip, bindings.meshes, bindings.numMeshes);
+        if (bindings.numVSTextures > 0) {
+            state->renderer.applyTextures(ShaderStage::VS, bindings.vsTextures, bindings.numVSTextures);
+        }
+        if (bindings.numFSTextures > 0) {
+            state->renderer.applyTextures(ShaderStage::FS, bindings.fsTextures, bindings.numFSTextures);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::applyUniformBlock(ShaderStage::Code bindStage, int bindSlot, int64_t layoutHash, const uint8_t* ptr, int byteSize) {
+    o_assert_dbg(IsValid());
+    state->gfxFrameInfo.NumApplyUniformBlock++;
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().applyUniformBlock(bindStage, bindSlot, layoutHash, ptr, byteSize);
+    }
+    else {
+        state->renderer.applyUniformBlock(bindStage, bindSlot, layoutHash, ptr, byteSize);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::ApplyComputeState(const ComputeState& computeState) {
+    o_trace_scoped(Gfx_ApplyComputeState);
+    o_assert_dbg(IsValid());
+    o_assert_dbg(computeState.Shader.Type == GfxResourceType::Shader);
+    state->gfxFrameInfo.NumApplyComputeState++;
+
+    shader* shd = state->resourceContainer.lookupShader(computeState.Shader);
+    mesh* storageBuffers[GfxConfig::MaxNumStorageBuffers] = { };
+    int numStorageBuffers = 0;
+    for (; numStorageBuffers < GfxConfig::MaxNumStorageBuffers; numStorageBuffers++) {
+        const Id& mshId = computeState.StorageBuffer[numStorageBuffers];
+        if (mshId.IsValid()) {
+            storageBuffers[numStorageBuffers] = state->resourceContainer.lookupMesh(mshId);
+        }
+        else {
+            break;
+        }
+    }
+    #if ORYOL_DEBUG
+    validateComputeState(shd, storageBuffers, numStorageBuffers);
+    #endif
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().applyComputeState(shd, storageBuffers, numStorageBuffers);
+    }
+    else {
+        state->renderer.applyComputeState(shd, storageBuffers, numStorageBuffers);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::Dispatch(int numGroupsX, int numGroupsY, int numGroupsZ) {
+    o_trace_scoped(Gfx_Dispatch);
+    o_assert_dbg(IsValid());
+    o_assert_dbg((numGroupsX > 0) && (numGroupsY > 0) && (numGroupsZ > 0));
+    state->gfxFrameInfo.NumDispatch++;
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().dispatch(numGroupsX, numGroupsY, numGroupsZ);
+    }
+    else {
+        state->renderer.dispatch(numGroupsX, numGroupsY, numGroupsZ);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::Barrier(BarrierBits::Mask bits) {
+    o_assert_dbg(IsValid());
+    state->gfxFrameInfo.NumBarrier++;
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().barrier(bits);
+    }
+    else {
+        state->renderer.barrier(bits);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::BeginQuery(const Id& id) {
+    o_assert_dbg(IsValid());
+    o_assert_dbg(id.Type == GfxResourceType::Query);
+    state->gfxFrameInfo.NumQueries++;
+    query* qry = state->resourceContainer.lookupQuery(id);
+    if (nullptr == qry) {
+        return;
+    }
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().beginQuery(qry);
+    }
+    else {
+        state->renderer.beginQuery(qry);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::EndQuery(const Id& id) {
+    o_assert_dbg(IsValid());
+    o_assert_dbg(id.Type == GfxResourceType::Query);
+    query* qry = state->resourceContainer.lookupQuery(id);
+    if (nullptr == qry) {
+        return;
+    }
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().endQuery(qry);
+    }
+    else {
+        state->renderer.endQuery(qry);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+Gfx::QueryResult(const Id& id, uint32_t& outNumSamples) {
+    o_assert_dbg(IsValid());
+    o_assert_dbg(id.Type == GfxResourceType::Query);
+    // results are published by CommitFrame, so this doesn't need
+    // to synchronize with the render thread
+    const query* qry = state->resourceContainer.lookupQuery(id);
+    if (qry && (qry->resultFrameIndex >= 0)) {
+        outNumSamples = qry->numSamples;
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::BeginConditionalRender(const Id& id) {
+    o_assert_dbg(IsValid());
+    o_assert_dbg(id.Type == GfxResourceType::Query);
+    query* qry = state->resourceContainer.lookupQuery(id);
+    if (nullptr == qry) {
+        return;
+    }
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().beginConditionalRender(qry);
+    }
+    else {
+        state->renderer.beginConditionalRender(qry);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::EndConditionalRender() {
+    o_assert_dbg(IsValid());
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().endConditionalRender();
+    }
+    else {
+        state->renderer.endConditionalRender();
     }
 }
 
@@ -226,6 +503,23 @@ Gfx::LoadResource(const Ptr<ResourceLoader>& loader) {
     return state->resourceContainer.Load(loader);
 }
 
+//------------------------------------------------------------------------------
+void
+Gfx::PrefetchResource(const Ptr<ResourceLoader>& loader) {
+    o_assert_dbg(IsValid());
+    // nothing to do if the resource already exists
+    if (!state->resourceContainer.Lookup(loader->Locator()).IsValid()) {
+        loader->Prefetch();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::CancelPrefetchResource(const Ptr<ResourceLoader>& loader) {
+    o_assert_dbg(IsValid());
+    loader->CancelPrefetch();
+}
+
 //------------------------------------------------------------------------------
 Id
 Gfx::LookupResource(const Locator& locator) {
@@ -273,7 +567,12 @@ void
 Gfx::ApplyViewPort(int x, int y, int width, int height, bool originTopLeft) {
     o_assert_dbg(IsValid());
     state->gfxFrameInfo.NumApplyViewPort++;
-    state->renderer.applyViewPort(x, y, width, height, originTopLeft);
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().applyViewPort(x, y, width, height, originTopLeft);
+    }
+    else {
+        state->renderer.applyViewPort(x, y, width, height, originTopLeft);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -281,7 +580,12 @@ void
 Gfx::ApplyScissorRect(int x, int y, int width, int height, bool originTopLeft) {
     o_assert_dbg(IsValid());
     state->gfxFrameInfo.NumApplyScissorRect++;
-    state->renderer.applyScissorRect(x, y, width, height, originTopLeft);
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().applyScissorRect(x, y, width, height, originTopLeft);
+    }
+    else {
+        state->renderer.applyScissorRect(x, y, width, height, originTopLeft);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -289,8 +593,18 @@ void
 Gfx::CommitFrame() {
     o_trace_scoped(Gfx_CommitFrame);
     o_assert_dbg(IsValid());
-    state->renderer.commitFrame();
-    state->displayManager.Present();
+    if (state->renderThread.isValid()) {
+        // waits for the render thread to finish the previous frame, and
+        // publishes the query results it polled while it is idle
+        state->renderThread.commitFrame([] {
+            state->renderer.publishQueryResults();
+        });
+    }
+    else {
+        state->renderer.commitFrame();
+        state->renderer.publishQueryResults();
+        state->displayManager.Present();
+    }
     state->gfxFrameInfo = GfxFrameInfo();
 }
 
@@ -299,7 +613,12 @@ void
 Gfx::ResetStateCache() {
     o_trace_scoped(Gfx_ResetStateCache);
     o_assert_dbg(IsValid());
-    state->renderer.resetStateCache();
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().resetStateCache();
+    }
+    else {
+        state->renderer.resetStateCache();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -309,7 +628,12 @@ Gfx::UpdateVertices(const Id& id, const void* data, int numBytes) {
     o_assert_dbg(IsValid());
     state->gfxFrameInfo.NumUpdateVertices++;
     mesh* msh = state->resourceContainer.lookupMesh(id);
-    state->renderer.updateVertices(msh, data, numBytes);
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().updateVertices(msh, data, numBytes);
+    }
+    else {
+        state->renderer.updateVertices(msh, data, numBytes);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -319,7 +643,12 @@ Gfx::UpdateIndices(const Id& id, const void* data, int numBytes) {
     o_assert_dbg(IsValid());
     state->gfxFrameInfo.NumUpdateIndices++;
     mesh* msh = state->resourceContainer.lookupMesh(id);
-    state->renderer.updateIndices(msh, data, numBytes);
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().updateIndices(msh, data, numBytes);
+    }
+    else {
+        state->renderer.updateIndices(msh, data, numBytes);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -329,7 +658,12 @@ Gfx::UpdateTexture(const Id& id, const void* data, const ImageDataAttrs& offsets
     o_assert_dbg(IsValid());
     state->gfxFrameInfo.NumUpdateTextures++;
     texture* tex = state->resourceContainer.lookupTexture(id);
-    state->renderer.updateTexture(tex, data, offsetsAndSizes);
+    if (state->renderThread.isValid()) {
+        state->renderThread.cmdStream().updateTexture(tex, data, offsetsAndSizes);
+    }
+    else {
+        state->renderer.updateTexture(tex, data, offsetsAndSizes);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -337,7 +671,14 @@ void
 Gfx::ReadPixels(void* buf, int bufNumBytes) {
     o_trace_scoped(Gfx_ReadPixels);
     o_assert_dbg(IsValid());
-    state->renderer.readPixels(buf, bufNumBytes);
+    if (state->renderThread.isValid()) {
+        state->renderThread.call([buf, bufNumBytes] {
+            state->renderer.readPixels(buf, bufNumBytes);
+        });
+    }
+    else {
+        state->renderer.readPixels(buf, bufNumBytes);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -346,7 +687,15 @@ Gfx::Draw(int primGroupIndex, int numInstances) {
     o_trace_scoped(Gfx_Draw);
     o_assert_dbg(IsValid());
     state->gfxFrameInfo.NumDraw++;
-    if (1 == numInstances) {
+    if (state->renderThread.isValid()) {
+        if (1 == numInstances) {
+            state->renderThread.cmdStream().draw(primGroupIndex);
+        }
+        else {
+            state->renderThread.cmdStream().drawInstanced(primGroupIndex, numInstances);
+        }
+    }
+    else if (1 == numInstances) {
         state->renderer.draw(primGroupIndex);
     }
     else {
@@ -360,7 +709,15 @@ Gfx::Draw(const PrimitiveGroup& primGroup, int numInstances) {
     o_trace_scoped(Gfx_Draw);
     o_assert_dbg(IsValid());
     state->gfxFrameInfo.NumDraw++;
-    if (1 == numInstances) {
+    if (state->renderThread.isValid()) {
+        if (1 == numInstances) {
+            state->renderThread.cmdStream().draw(primGroup);
+        }
+        else {
+            state->renderThread.cmdStream().drawInstanced(primGroup, numInstances);
+        }
+    }
+    else if (1 == numInstances) {
         state->renderer.draw(primGroup);
     }
     else {
@@ -444,4 +801,27 @@ Gfx::validateTextures(ShaderStage::Code stage, pipeline* pip, texture** textures
 }
 #endif
 
+//------------------------------------------------------------------------------
+#if ORYOL_DEBUG
+void
+Gfx::validateComputeState(shader* shd, mesh** storageBuffers, int numStorageBuffers) {
+
+    // checks that:
+    //  - the shader is a compute program
+    //  - storage buffer meshes are Dynamic or Stream, immutable
+    //    meshes may live at an offset in the shared vertex arena
+    //
+    // the shader and meshes may still be loading (nullptr)
+    if (shd && !shd->Setup.IsComputeProgram()) {
+        o_error("invalid compute state: shader is not a compute program!\n");
+    }
+    for (int i = 0; i < numStorageBuffers; i++) {
+        const meshBase* msh = storageBuffers[i];
+        if (msh && (Usage::Immutable == msh->vertexBufferAttrs.BufferUsage)) {
+            o_error("invalid compute state: storage buffer at slot '%d' must be Usage::Dynamic or Usage::Stream!\n", i);
+        }
+    }
+}
+#endif
+
 } // namespace Oryol
@@ -14,9 +14,12 @@
 #include "Gfx/Setup/GfxSetup.h"
 #include "Gfx/Core/ClearState.h"
 #include "Gfx/Core/DrawState.h"
+#include "Gfx/Core/BakedDrawState.h"
+#include "Gfx/Core/ComputeState.h"
 #include "Gfx/Core/Enums.h"
 #include "Gfx/Core/PrimitiveGroup.h"
 #include "Gfx/Core/renderer.h"
+#include "Gfx/Core/renderThread.h"
 #include "Gfx/Core/GfxFrameInfo.h"
 #include "Resource/Core/SetupAndData.h"
 #include "glm/vec4.hpp"
@@ -65,10 +68,16 @@ public:
     template<class SETUP> static Id CreateResource(const SetupAndData<SETUP>& setupAndData);
     /// create a resource object with associated data
     template<class SETUP> static Id CreateResource(const SETUP& setup, const Buffer& data);
+    /// create a resource object with associated shared data
+    template<class SETUP> static Id CreateResource(const SETUP& setup, const SharedBuffer& data);
     /// create a resource object with raw pointer to associated data
     template<class SETUP> static Id CreateResource(const SETUP& setup, const void* data, int size);
     /// asynchronously load resource object
     static Id LoadResource(const Ptr<ResourceLoader>& loader);
+    /// warm-up: prefetch resource data, resource creation is deferred until LoadResource()
+    static void PrefetchResource(const Ptr<ResourceLoader>& loader);
+    /// cancel a resource warm-up
+    static void CancelPrefetchResource(const Ptr<ResourceLoader>& loader);
     /// lookup a resource Id by Locator
     static Id LookupResource(const Locator& locator);
     /// destroy one or several resources by matching label
@@ -93,8 +102,14 @@ public:
     static void ApplyScissorRect(int x, int y, int width, int height, bool originTopLeft=false);
     /// apply draw state (Pipeline, Meshes and Textures)
     static void ApplyDrawState(const DrawState& drawState);
-    /// apply a uniform block (call between ApplyDrawState and Draw)
+    /// resolve and validate a draw state once for fast repeated ApplyDrawState calls
+    static BakedDrawState BakeDrawState(const DrawState& drawState);
+    /// apply a baked draw state (only resolved again after resource changes)
+    static void ApplyDrawState(const BakedDrawState& bakedDrawState);
+    /// apply a uniform block (call between ApplyDrawState and Draw, or ApplyComputeState and Dispatch)
     template<class T> static void ApplyUniformBlock(const T& ub);
+    /// apply compute state (compute shader and storage buffers), replaces the current draw state
+    static void ApplyComputeState(const ComputeState& computeState);
 
     /// update dynamic vertex data (complete replace)
     static void UpdateVertices(const Id& id, const void* data, int numBytes);
@@ -109,6 +124,21 @@ public:
     static void Draw(int primGroupIndex=0, int numInstances=1);
     /// submit a draw call with explicit primitve range
     static void Draw(const PrimitiveGroup& primGroup, int numInstances=1);
+    /// submit a compute dispatch with the number of work groups
+    static void Dispatch(int numGroupsX, int numGroupsY=1, int numGroupsZ=1);
+    /// make storage buffer writes of previous dispatches visible to following operations
+    static void Barrier(BarrierBits::Mask bits=BarrierBits::All);
+
+    /// begin an occlusion query, the query counts the samples of following draw calls
+    static void BeginQuery(const Id& id);
+    /// end the current occlusion query
+    static void EndQuery(const Id& id);
+    /// get the latest available query result, returns false if no result is available yet
+    static bool QueryResult(const Id& id, uint32_t& outNumSamples);
+    /// only render following draw calls if the latest query result is non-zero (the GPU waits for the result)
+    static void BeginConditionalRender(const Id& id);
+    /// end conditional rendering
+    static void EndConditionalRender();
 
     /// commit (and display) the current frame
     static void CommitFrame();
@@ -124,9 +154,21 @@ private:
     static void validateMeshes(_priv::pipeline* pip, _priv::mesh** meshes, int numMeshes);
     /// validate texture binding
     static void validateTextures(ShaderStage::Code stage, _priv::pipeline* pip, _priv::texture** textures, int numTextures);
+    /// validate compute state binding
+    static void validateComputeState(_priv::shader* shd, _priv::mesh** storageBuffers, int numStorageBuffers);
     #endif
+    /// lookup (and in debug mode validate) resources of a draw state
+    static void resolveDrawState(const DrawState& drawState, _priv::drawStateBindings& out);
+    /// apply resolved draw state resources
+    static void applyDrawStateBindings(_priv::drawStateBindings& bindings);
     /// private generic apply texture block method
     template<class T> static void applyTextureBlock(const T& tb);
+    /// private non-template apply uniform block method
+    static void applyUniformBlock(ShaderStage::Code bindStage, int bindSlot, int64_t layoutHash, const uint8_t* ptr, int byteSize);
+    /// start the render thread (GfxSetup::RenderThread)
+    static void setupRenderThread();
+    /// stop the render thread and move the 3D API context back to the main thread
+    static void discardRenderThread();
 
     struct _state {
         class GfxSetup gfxSetup;
@@ -135,6 +177,8 @@ private:
         _priv::displayMgr displayManager;
         class _priv::renderer renderer;
         _priv::gfxResourceContainer resourceContainer;
+        _priv::renderThread renderThread;
+        struct DisplayAttrs renderTargetAttrs;  // tracked on main thread in render thread mode
     };
     static _state* state;
 };
@@ -143,8 +187,7 @@ private:
 template<class T> inline void
 Gfx::ApplyUniformBlock(const T& ub) {
     o_assert_dbg(IsValid());
-    state->gfxFrameInfo.NumApplyUniformBlock++;
-    state->renderer.applyUniformBlock(T::_bindShaderStage, T::_bindSlotIndex, T::_layoutHash, (const uint8_t*) &ub, sizeof(ub));
+    applyUniformBlock(T::_bindShaderStage, T::_bindSlotIndex, T::_layoutHash, (const uint8_t*) &ub, sizeof(ub));
 }
 
 //------------------------------------------------------------------------------
@@ -162,6 +205,14 @@ Gfx::CreateResource(const SETUP& setup, const Buffer& data) {
     return state->resourceContainer.Create(setup, data.Data(), data.Size());
 }
 
+//------------------------------------------------------------------------------
+template<class SETUP> inline Id
+Gfx::CreateResource(const SETUP& setup, const SharedBuffer& data) {
+    o_assert_dbg(IsValid());
+    o_assert_dbg(!data.Empty());
+    return state->resourceContainer.Create(setup, data.Data(), data.Size());
+}
+
 //------------------------------------------------------------------------------
 template<class SETUP> inline Id
 Gfx::CreateResource(const SetupAndData<SETUP>& setupAndData) {
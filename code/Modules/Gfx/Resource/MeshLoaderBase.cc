@@ -15,7 +15,7 @@ setup(setup_) {
 //------------------------------------------------------------------------------
 MeshLoaderBase::MeshLoaderBase(const MeshSetup& setup_, LoadedFunc loadedFunc) :
 setup(setup_),
-onLoaded(loadedFunc) {
+onLoaded(std::move(loadedFunc)) {
     // empty
 }
 
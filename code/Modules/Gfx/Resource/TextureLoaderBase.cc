@@ -15,7 +15,7 @@ setup(setup_) {
 //------------------------------------------------------------------------------
 TextureLoaderBase::TextureLoaderBase(const TextureSetup& setup_, LoadedFunc loadedFunc) :
 setup(setup_),
-onLoaded(loadedFunc)
+onLoaded(std::move(loadedFunc))
 {
   // empty
 }
@@ -7,7 +7,7 @@
 */
 #include "Resource/Core/ResourceLoader.h"
 #include "Gfx/Setup/TextureSetup.h"
-#include <functional>
+#include "Core/InplaceFunction.h"
 
 namespace Oryol {
 
@@ -15,7 +15,7 @@ class TextureLoaderBase : public ResourceLoader {
     OryolClassDecl(TextureLoaderBase);
 public:
     /// optional callback when loading has succeeded
-    typedef std::function<void(TextureSetup&)> LoadedFunc;
+    typedef InplaceFunction<void(TextureSetup&)> LoadedFunc;
 
     /// constructor
     TextureLoaderBase(const TextureSetup& setup);
@@ -26,7 +26,7 @@ public:
 
 protected:
     TextureSetup setup;
-    std::function<void(TextureSetup&)> onLoaded;
+    LoadedFunc onLoaded;
 };
 
 } // namespace Oryol
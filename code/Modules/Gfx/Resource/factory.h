@@ -5,6 +5,7 @@
 #include "Gfx/gl/glPipelineFactory.h"
 #include "Gfx/gl/glShaderFactory.h"
 #include "Gfx/gl/glTextureFactory.h"
+#include "Gfx/gl/glQueryFactory.h"
 #elif ORYOL_D3D11
 #include "Gfx/d3d11/d3d11MeshFactory.h"
 #include "Gfx/d3d11/d3d11PipelineFactory.h"
@@ -23,6 +24,7 @@
 #else
 #error "Platform not yet supported!"
 #endif
+#include "Gfx/Resource/queryFactoryBase.h"
 
 namespace Oryol {
 namespace _priv {
@@ -31,6 +33,7 @@ class meshFactory : public glMeshFactory { };
 class pipelineFactory : public glPipelineFactory { };
 class shaderFactory : public glShaderFactory { };
 class textureFactory : public glTextureFactory { };
+class queryFactory : public glQueryFactory { };
 #elif ORYOL_D3D11
 class meshFactory : public d3d11MeshFactory { };
 class pipelineFactory : public d3d11PipelineFactory { };
@@ -47,6 +50,9 @@ class pipelineFactory : public mtlPipelineFactory { };
 class shaderFactory : public mtlShaderFactory { };
 class textureFactory : public mtlTextureFactory { };
 #endif
+#if !ORYOL_OPENGL
+class queryFactory : public queryFactoryBase { };
+#endif
 
 } // namespace _priv
 } // namespace Oryol
@@ -26,11 +26,16 @@ gfxResourceContainerBase::setup(const GfxSetup& setup, const gfxPointers& ptrs)
     this->shaderPool.Setup(GfxResourceType::Shader, setup.PoolSize(GfxResourceType::Shader));
     this->texturePool.Setup(GfxResourceType::Texture, setup.PoolSize(GfxResourceType::Texture));
     this->pipelinePool.Setup(GfxResourceType::Pipeline, setup.PoolSize(GfxResourceType::Pipeline));
+    this->queryPool.Setup(GfxResourceType::Query, setup.PoolSize(GfxResourceType::Query));
 
     this->meshFactory.Setup(this->pointers);
+    #if ORYOL_OPENGL
+    this->meshFactory.SetupArenas(setup.MeshArenaVertexBufferSize, setup.MeshArenaIndexBufferSize);
+    #endif
     this->shaderFactory.Setup(this->pointers);
     this->textureFactory.Setup(this->pointers);
     this->pipelineFactory.Setup(this->pointers);
+    this->queryFactory.Setup(this->pointers);
 
     this->runLoopId = Core::PostRunLoop()->Add([this]() {
         this->update();
@@ -52,6 +57,8 @@ gfxResourceContainerBase::discard() {
     
     resourceContainerBase::discard();
 
+    this->queryPool.Discard();
+    this->queryFactory.Discard();
     this->pipelinePool.Discard();
     this->pipelineFactory.Discard();
     this->texturePool.Discard();
@@ -77,7 +84,10 @@ gfxResourceContainerBase::Create(const MeshSetup& setup) {
         resId = this->meshPool.AllocId();
         this->registry.Add(setup.Locator, resId, this->peekLabel());
         mesh& res = this->meshPool.Assign(resId, setup, ResourceState::Setup);
-        const ResourceState::Code newState = this->meshFactory.SetupResource(res);
+        ResourceState::Code newState = ResourceState::InvalidState;
+        this->callFactory([&] {
+            newState = this->meshFactory.SetupResource(res);
+        });
         o_assert((newState == ResourceState::Valid) || (newState == ResourceState::Failed));
         this->meshPool.UpdateState(resId, newState);
     }
@@ -100,7 +110,10 @@ gfxResourceContainerBase::Create(const MeshSetup& setup, const void* data, int s
         resId = this->meshPool.AllocId();
         this->registry.Add(setup.Locator, resId, this->peekLabel());
         mesh& res = this->meshPool.Assign(resId, setup, ResourceState::Setup);
-        const ResourceState::Code newState = this->meshFactory.SetupResource(res, data, size);
+        ResourceState::Code newState = ResourceState::InvalidState;
+        this->callFactory([&] {
+            newState = this->meshFactory.SetupResource(res, data, size);
+        });
         o_assert((newState == ResourceState::Valid) || (newState == ResourceState::Failed));
         this->meshPool.UpdateState(resId, newState);
     }
@@ -121,7 +134,10 @@ gfxResourceContainerBase::Create(const TextureSetup& setup) {
         resId = this->texturePool.AllocId();
         this->registry.Add(setup.Locator, resId, this->peekLabel());
         texture& res = this->texturePool.Assign(resId, setup, ResourceState::Setup);
-        const ResourceState::Code newState = this->textureFactory.SetupResource(res);
+        ResourceState::Code newState = ResourceState::InvalidState;
+        this->callFactory([&] {
+            newState = this->textureFactory.SetupResource(res);
+        });
         o_assert((newState == ResourceState::Valid) || (newState == ResourceState::Failed));
         this->texturePool.UpdateState(resId, newState);
     }
@@ -144,7 +160,10 @@ gfxResourceContainerBase::Create(const TextureSetup& setup, const void* data, in
         resId = this->texturePool.AllocId();
         this->registry.Add(setup.Locator, resId, this->peekLabel());
         texture& res = this->texturePool.Assign(resId, setup, ResourceState::Setup);
-        const ResourceState::Code newState = this->textureFactory.SetupResource(res, data, size);
+        ResourceState::Code newState = ResourceState::InvalidState;
+        this->callFactory([&] {
+            newState = this->textureFactory.SetupResource(res, data, size);
+        });
         o_assert((newState == ResourceState::Valid) || (newState == ResourceState::Failed));
         this->texturePool.UpdateState(resId, newState);
     }
@@ -170,7 +189,10 @@ gfxResourceContainerBase::initAsync(const Id& resId, const MeshSetup& setup, con
     // the prepared resource may have been destroyed while it was loading
     if (this->meshPool.Contains(resId)) {
         mesh& res = this->meshPool.Assign(resId, setup, ResourceState::Pending);
-        const ResourceState::Code newState = this->meshFactory.SetupResource(res, data, size);
+        ResourceState::Code newState = ResourceState::InvalidState;
+        this->callFactory([&] {
+            newState = this->meshFactory.SetupResource(res, data, size);
+        });
         o_assert((newState == ResourceState::Valid) || (newState == ResourceState::Failed));
         this->meshPool.UpdateState(resId, newState);
         return newState;
@@ -202,7 +224,10 @@ gfxResourceContainerBase::initAsync(const Id& resId, const TextureSetup& setup,
     // the prepared resource may have been destroyed while it was loading
     if (this->texturePool.Contains(resId)) {
         texture& res = this->texturePool.Assign(resId, setup, ResourceState::Pending);
-        const ResourceState::Code newState = this->textureFactory.SetupResource(res, data, size);
+        ResourceState::Code newState = ResourceState::InvalidState;
+        this->callFactory([&] {
+            newState = this->textureFactory.SetupResource(res, data, size);
+        });
         o_assert((newState == ResourceState::Valid) || (newState == ResourceState::Failed));
         this->texturePool.UpdateState(resId, newState);
         return newState;
@@ -259,7 +284,10 @@ gfxResourceContainerBase::Create(const ShaderSetup& setup) {
         resId = this->shaderPool.AllocId();
         this->registry.Add(setup.Locator, resId, this->peekLabel());
         shader& res = this->shaderPool.Assign(resId, setup, ResourceState::Setup);
-        const ResourceState::Code newState = this->shaderFactory.SetupResource(res);
+        ResourceState::Code newState = ResourceState::InvalidState;
+        this->callFactory([&] {
+            newState = this->shaderFactory.SetupResource(res);
+        });
         o_assert((newState == ResourceState::Valid) || (newState == ResourceState::Failed));
         this->shaderPool.UpdateState(resId, newState);
     }
@@ -279,13 +307,39 @@ gfxResourceContainerBase::Create(const PipelineSetup& setup) {
         resId = this->pipelinePool.AllocId();
         this->registry.Add(setup.Locator, resId, this->peekLabel());
         pipeline& res = this->pipelinePool.Assign(resId, setup, ResourceState::Setup);
-        const ResourceState::Code newState = this->pipelineFactory.SetupResource(res);
+        ResourceState::Code newState = ResourceState::InvalidState;
+        this->callFactory([&] {
+            newState = this->pipelineFactory.SetupResource(res);
+        });
         o_assert((newState == ResourceState::Valid) || (newState == ResourceState::Failed));        
         this->pipelinePool.UpdateState(resId, newState);
     }
     return resId;
 }
 
+//------------------------------------------------------------------------------
+template<> Id
+gfxResourceContainerBase::Create(const QuerySetup& setup) {
+    o_assert_dbg(this->isValid());
+    
+    Id resId = this->registry.Lookup(setup.Locator);
+    if (resId.IsValid()) {
+        return resId;
+    }
+    else {
+        resId = this->queryPool.AllocId();
+        this->registry.Add(setup.Locator, resId, this->peekLabel());
+        query& res = this->queryPool.Assign(resId, setup, ResourceState::Setup);
+        ResourceState::Code newState = ResourceState::InvalidState;
+        this->callFactory([&] {
+            newState = this->queryFactory.SetupResource(res);
+        });
+        o_assert((newState == ResourceState::Valid) || (newState == ResourceState::Failed));
+        this->queryPool.UpdateState(resId, newState);
+    }
+    return resId;
+}
+
 //------------------------------------------------------------------------------
 Id
 gfxResourceContainerBase::Load(const Ptr<ResourceLoader>& loader) {
@@ -308,61 +362,80 @@ gfxResourceContainerBase::Destroy(ResourceLabel label) {
     o_assert_dbg(this->isValid());
     
     Array<Id> ids = this->registry.Remove(label);
-    for (const Id& id : ids) {
-        switch (id.Type) {
-            case GfxResourceType::Texture:
-            {
-                if (ResourceState::Valid == this->texturePool.QueryState(id)) {
-                    texture* tex = this->texturePool.Lookup(id);
-                    if (tex) {
-                        this->textureFactory.DestroyResource(*tex);
+    if (ids.Empty()) {
+        return;
+    }
+    // destroying must wait until the render thread has replayed all
+    // recorded calls, since these may still reference the resources
+    this->callFactory([this, &ids] {
+        for (const Id& id : ids) {
+            switch (id.Type) {
+                case GfxResourceType::Texture:
+                {
+                    if (ResourceState::Valid == this->texturePool.QueryState(id)) {
+                        texture* tex = this->texturePool.Lookup(id);
+                        if (tex) {
+                            this->textureFactory.DestroyResource(*tex);
+                        }
                     }
+                    this->texturePool.Unassign(id);
                 }
-                this->texturePool.Unassign(id);
-            }
-            break;
+                break;
                 
-            case GfxResourceType::Mesh:
-            {
-                if (ResourceState::Valid == this->meshPool.QueryState(id)) {
-                    mesh* msh = this->meshPool.Lookup(id);
-                    if (msh) {
-                        this->meshFactory.DestroyResource(*msh);
+                case GfxResourceType::Mesh:
+                {
+                    if (ResourceState::Valid == this->meshPool.QueryState(id)) {
+                        mesh* msh = this->meshPool.Lookup(id);
+                        if (msh) {
+                            this->meshFactory.DestroyResource(*msh);
+                        }
                     }
+                    this->meshPool.Unassign(id);
                 }
-                this->meshPool.Unassign(id);
-            }
-            break;
+                break;
                 
-            case GfxResourceType::Shader:
-            {
-                if (ResourceState::Valid == this->shaderPool.QueryState(id)) {
-                    shader* shd = this->shaderPool.Lookup(id);
-                    if (shd) {
-                        this->shaderFactory.DestroyResource(*shd);
+                case GfxResourceType::Shader:
+                {
+                    if (ResourceState::Valid == this->shaderPool.QueryState(id)) {
+                        shader* shd = this->shaderPool.Lookup(id);
+                        if (shd) {
+                            this->shaderFactory.DestroyResource(*shd);
+                        }
                     }
+                    this->shaderPool.Unassign(id);
                 }
-                this->shaderPool.Unassign(id);
-            }
-            break;
+                break;
                 
-            case GfxResourceType::Pipeline:
-            {
-                if (ResourceState::Valid == this->pipelinePool.QueryState(id)) {
-                    pipeline* pip = this->pipelinePool.Lookup(id);
-                    if (pip) {
-                        this->pipelineFactory.DestroyResource(*pip);
+                case GfxResourceType::Pipeline:
+                {
+                    if (ResourceState::Valid == this->pipelinePool.QueryState(id)) {
+                        pipeline* pip = this->pipelinePool.Lookup(id);
+                        if (pip) {
+                            this->pipelineFactory.DestroyResource(*pip);
+                        }
                     }
+                    this->pipelinePool.Unassign(id);
                 }
-                this->pipelinePool.Unassign(id);
-            }
-            break;
+                break;
 
-            default:
-                o_assert(false);
+                case GfxResourceType::Query:
+                {
+                    if (ResourceState::Valid == this->queryPool.QueryState(id)) {
+                        query* qry = this->queryPool.Lookup(id);
+                        if (qry) {
+                            this->queryFactory.DestroyResource(*qry);
+                        }
+                    }
+                    this->queryPool.Unassign(id);
+                }
                 break;
+
+                default:
+                    o_assert(false);
+                    break;
+            }
         }
-    }
+    });
 }
     
 //------------------------------------------------------------------------------
@@ -375,6 +448,7 @@ gfxResourceContainerBase::update() {
     this->shaderPool.Update();
     this->texturePool.Update();
     this->pipelinePool.Update();
+    this->queryPool.Update();
 
     // trigger loaders, and remove from pending array if finished
     for (int i = this->pendingLoaders.Size() - 1; i >= 0; i--) {
@@ -400,6 +474,8 @@ gfxResourceContainerBase::QueryResourceInfo(const Id& resId) const {
             return this->shaderPool.QueryResourceInfo(resId);
         case GfxResourceType::Pipeline:
             return this->pipelinePool.QueryResourceInfo(resId);
+        case GfxResourceType::Query:
+            return this->queryPool.QueryResourceInfo(resId);
         default:
             o_assert(false);
             return ResourceInfo();
@@ -420,6 +496,8 @@ gfxResourceContainerBase::QueryPoolInfo(GfxResourceType::Code resType) const {
             return this->shaderPool.QueryPoolInfo();
         case GfxResourceType::Pipeline:
             return this->pipelinePool.QueryPoolInfo();
+        case GfxResourceType::Query:
+            return this->queryPool.QueryPoolInfo();
         default:
             o_assert(false);
             return ResourcePoolInfo();
@@ -440,6 +518,8 @@ gfxResourceContainerBase::QueryFreeSlots(GfxResourceType::Code resourceType) con
             return this->shaderPool.GetNumFreeSlots();
         case GfxResourceType::Pipeline:
             return this->pipelinePool.GetNumFreeSlots();
+        case GfxResourceType::Query:
+            return this->queryPool.GetNumFreeSlots();
         default:
             o_assert(false);
             return 0;
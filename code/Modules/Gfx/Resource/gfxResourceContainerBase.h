@@ -18,6 +18,7 @@
 #include "Gfx/Resource/MeshLoaderBase.h"
 #include "Gfx/Resource/TextureLoaderBase.h"
 #include "Gfx/Core/gfxPointers.h"
+#include "Gfx/Core/renderThread.h"
 
 namespace Oryol {
 namespace _priv {
@@ -65,19 +66,27 @@ public:
     texture* lookupTexture(const Id& resId);
     /// lookup pipeline object
     pipeline* lookupPipeline(const Id& resId);
+    /// lookup query object
+    query* lookupQuery(const Id& resId);
 
     /// per-frame update (update resource pools and pending loaders)
     void update();
+    /// get a stamp which changes whenever any resource is created, destroyed or changes state
+    uint32_t resourceGeneration() const;
+    /// call resource factory code on the thread which owns the 3D API context
+    template<class FUNC> void callFactory(FUNC&& func);
 
     gfxPointers pointers;
     class meshFactory meshFactory;
     class shaderFactory shaderFactory;
     class textureFactory textureFactory;
     class pipelineFactory pipelineFactory;
+    class queryFactory queryFactory;
     class meshPool meshPool;
     class shaderPool shaderPool;
     class texturePool texturePool;
     class pipelinePool pipelinePool;
+    class queryPool queryPool;
     RunLoop::Id runLoopId;
     Array<Ptr<ResourceLoader>> pendingLoaders;
 };
@@ -110,5 +119,32 @@ gfxResourceContainerBase::lookupPipeline(const Id& resId) {
     return this->pipelinePool.Lookup(resId);
 }
 
+//------------------------------------------------------------------------------
+inline query*
+gfxResourceContainerBase::lookupQuery(const Id& resId) {
+    o_assert_dbg(this->valid);
+    return this->queryPool.Lookup(resId);
+}
+
+//------------------------------------------------------------------------------
+inline uint32_t
+gfxResourceContainerBase::resourceGeneration() const {
+    // each pool's generation only ever increases, so the sum changes with any of them
+    return this->meshPool.GetGeneration() + this->shaderPool.GetGeneration() +
+           this->texturePool.GetGeneration() + this->pipelinePool.GetGeneration() +
+           this->queryPool.GetGeneration();
+}
+
+//------------------------------------------------------------------------------
+template<class FUNC> inline void
+gfxResourceContainerBase::callFactory(FUNC&& func) {
+    if (this->pointers.renderThread) {
+        this->pointers.renderThread->call(std::forward<FUNC>(func));
+    }
+    else {
+        func();
+    }
+}
+
 } // namespace _priv
 } // namespace Oryol
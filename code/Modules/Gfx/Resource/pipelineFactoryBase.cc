@@ -48,6 +48,7 @@ pipelineFactoryBase::SetupResource(pipeline& pip) {
     o_assert_dbg(this->isValid);
     pip.shd = this->pointers.shaderPool->Lookup(pip.Setup.Shader);
     o_assert_dbg(pip.shd && (ResourceState::Valid == pip.shd->State));
+    o_assert2(!pip.shd->Setup.IsComputeProgram(), "Compute shaders can't be used in pipelines!\n");
     return ResourceState::Valid;
 }
 
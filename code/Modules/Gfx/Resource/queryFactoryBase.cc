@@ -0,0 +1,61 @@
+//------------------------------------------------------------------------------
+//  queryFactoryBase.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "queryFactoryBase.h"
+#include "Core/Assertion.h"
+#include "Core/Log.h"
+#include "Gfx/Resource/resource.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+queryFactoryBase::queryFactoryBase() :
+isValid(false) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+queryFactoryBase::~queryFactoryBase() {
+    o_assert_dbg(!this->isValid);
+}
+
+//------------------------------------------------------------------------------
+void
+queryFactoryBase::Setup(const gfxPointers& ptrs) {
+    o_assert_dbg(!this->isValid);
+    this->pointers = ptrs;
+    this->isValid = true;
+}
+
+//------------------------------------------------------------------------------
+void
+queryFactoryBase::Discard() {
+    o_assert_dbg(this->isValid);
+    this->pointers = gfxPointers();
+    this->isValid = false;
+}
+
+//------------------------------------------------------------------------------
+bool
+queryFactoryBase::IsValid() const {
+    return this->isValid;
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+queryFactoryBase::SetupResource(query& qry) {
+    o_assert_dbg(this->isValid);
+    o_warn("queryFactory: queries not supported on this platform!\n");
+    return ResourceState::Failed;
+}
+
+//------------------------------------------------------------------------------
+void
+queryFactoryBase::DestroyResource(query& qry) {
+    qry.Clear();
+}
+
+} // namespace _priv
+} // namespace Oryol
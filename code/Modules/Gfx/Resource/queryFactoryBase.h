@@ -0,0 +1,43 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::queryFactoryBase
+    @ingroup _priv
+    @brief base class for queryFactory
+
+    This is also used as the queryFactory of the backends which
+    don't implement queries, creating a query resource fails there.
+*/
+#include "Resource/ResourceState.h"
+#include "Gfx/Core/gfxPointers.h"
+
+namespace Oryol {
+namespace _priv {
+
+class query;
+
+class queryFactoryBase {
+public:
+    /// constructor
+    queryFactoryBase();
+    /// destructor
+    ~queryFactoryBase();
+
+    /// setup the factory
+    void Setup(const gfxPointers& ptrs);
+    /// discard the factory
+    void Discard();
+    /// return true if factory has been setup
+    bool IsValid() const;
+    /// setup query resource
+    ResourceState::Code SetupResource(query& qry);
+    /// destroy the query
+    void DestroyResource(query& qry);
+
+protected:
+    gfxPointers pointers;
+    bool isValid;
+};
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,252 @@
+//------------------------------------------------------------------------------
+//  rangeAllocator.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "rangeAllocator.h"
+#include <algorithm>
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+rangeAllocator::~rangeAllocator() {
+    o_assert_dbg(!this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+rangeAllocator::Setup(int size) {
+    o_assert_dbg(!this->valid);
+    o_assert_dbg(size > 0);
+    this->valid = true;
+    this->capacity = size;
+    this->usedSize = 0;
+    this->numAllocs = 0;
+    range r;
+    r.offset = 0;
+    r.size = size;
+    this->freeRanges.Add(r);
+}
+
+//------------------------------------------------------------------------------
+void
+rangeAllocator::Discard() {
+    o_assert_dbg(this->valid);
+    this->freeRanges.Clear();
+    this->allocs.Clear();
+    this->freeIds.Clear();
+    this->capacity = 0;
+    this->usedSize = 0;
+    this->numAllocs = 0;
+    this->valid = false;
+}
+
+//------------------------------------------------------------------------------
+int
+rangeAllocator::alignOffset(int offset, int align) {
+    const int rem = offset % align;
+    return rem ? (offset + align - rem) : offset;
+}
+
+//------------------------------------------------------------------------------
+int
+rangeAllocator::Alloc(int size, int align, void* userData) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg((size > 0) && (align > 0));
+
+    for (int i = 0; i < this->freeRanges.Size(); i++) {
+        const range r = this->freeRanges[i];
+        const int offset = alignOffset(r.offset, align);
+        const int end = offset + size;
+        if (end > (r.offset + r.size)) {
+            continue;
+        }
+        // split the free range into optional head (alignment padding)
+        // and tail remainders
+        const int headSize = offset - r.offset;
+        const int tailSize = (r.offset + r.size) - end;
+        if (headSize > 0) {
+            this->freeRanges[i].size = headSize;
+            if (tailSize > 0) {
+                range tail;
+                tail.offset = end;
+                tail.size = tailSize;
+                this->freeRanges.Insert(i + 1, tail);
+            }
+        }
+        else if (tailSize > 0) {
+            this->freeRanges[i].offset = end;
+            this->freeRanges[i].size = tailSize;
+        }
+        else {
+            this->freeRanges.Erase(i);
+        }
+
+        int id;
+        if (this->freeIds.Empty()) {
+            id = this->allocs.Size();
+            this->allocs.Add();
+        }
+        else {
+            id = this->freeIds.PopBack();
+        }
+        alloc& a = this->allocs[id];
+        a.offset = offset;
+        a.size = size;
+        a.align = align;
+        a.userData = userData;
+        a.used = true;
+        this->usedSize += size;
+        this->numAllocs++;
+        return id;
+    }
+    return InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+void
+rangeAllocator::Free(int id) {
+    o_assert_dbg(this->valid);
+    alloc& a = this->allocs[id];
+    o_assert_dbg(a.used);
+    this->insertFreeRange(a.offset, a.size);
+    this->usedSize -= a.size;
+    this->numAllocs--;
+    a = alloc();
+    this->freeIds.Add(id);
+}
+
+//------------------------------------------------------------------------------
+void
+rangeAllocator::insertFreeRange(int offset, int size) {
+    // binary search for the first free range behind offset
+    int lo = 0;
+    int hi = this->freeRanges.Size();
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (this->freeRanges[mid].offset < offset) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    const int end = offset + size;
+    const bool mergePrev = (lo > 0) &&
+        ((this->freeRanges[lo-1].offset + this->freeRanges[lo-1].size) == offset);
+    const bool mergeNext = (lo < this->freeRanges.Size()) &&
+        (this->freeRanges[lo].offset == end);
+    if (mergePrev && mergeNext) {
+        this->freeRanges[lo-1].size += size + this->freeRanges[lo].size;
+        this->freeRanges.Erase(lo);
+    }
+    else if (mergePrev) {
+        this->freeRanges[lo-1].size += size;
+    }
+    else if (mergeNext) {
+        this->freeRanges[lo].offset = offset;
+        this->freeRanges[lo].size += size;
+    }
+    else {
+        range r;
+        r.offset = offset;
+        r.size = size;
+        this->freeRanges.Insert(lo, r);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+rangeAllocator::Defragment(Array<move>& outMoves) {
+    o_assert_dbg(this->valid);
+    outMoves.Clear();
+
+    // gather live allocations in offset order
+    Array<int> ids;
+    ids.Reserve(this->numAllocs);
+    for (int id = 0; id < this->allocs.Size(); id++) {
+        if (this->allocs[id].used) {
+            ids.Add(id);
+        }
+    }
+    std::sort(ids.begin(), ids.end(), [this](int a, int b) {
+        return this->allocs[a].offset < this->allocs[b].offset;
+    });
+
+    // slide allocations towards the front, this never moves an
+    // allocation behind its old position
+    outMoves.Reserve(ids.Size());
+    int cursor = 0;
+    for (int id : ids) {
+        alloc& a = this->allocs[id];
+        move m;
+        m.id = id;
+        m.srcOffset = a.offset;
+        m.dstOffset = alignOffset(cursor, a.align);
+        m.size = a.size;
+        outMoves.Add(m);
+        a.offset = m.dstOffset;
+        cursor = m.dstOffset + a.size;
+    }
+
+    // rebuild free list: alignment gaps plus one big range at the end
+    this->freeRanges.Clear();
+    cursor = 0;
+    for (int id : ids) {
+        const alloc& a = this->allocs[id];
+        if (a.offset > cursor) {
+            range r;
+            r.offset = cursor;
+            r.size = a.offset - cursor;
+            this->freeRanges.Add(r);
+        }
+        cursor = a.offset + a.size;
+    }
+    if (cursor < this->capacity) {
+        range r;
+        r.offset = cursor;
+        r.size = this->capacity - cursor;
+        this->freeRanges.Add(r);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+rangeAllocator::FitsAfterDefragment(int size, int align) const {
+    o_assert_dbg(this->valid);
+    // cheap rejection first, then simulate the compaction
+    if ((this->usedSize + size) > this->capacity) {
+        return false;
+    }
+    Array<int> ids;
+    ids.Reserve(this->numAllocs);
+    for (int id = 0; id < this->allocs.Size(); id++) {
+        if (this->allocs[id].used) {
+            ids.Add(id);
+        }
+    }
+    std::sort(ids.begin(), ids.end(), [this](int a, int b) {
+        return this->allocs[a].offset < this->allocs[b].offset;
+    });
+    int cursor = 0;
+    for (int id : ids) {
+        const alloc& a = this->allocs[id];
+        cursor = alignOffset(cursor, a.align) + a.size;
+    }
+    return (alignOffset(cursor, align) + size) <= this->capacity;
+}
+
+//------------------------------------------------------------------------------
+int
+rangeAllocator::LargestFreeRange() const {
+    int largest = 0;
+    for (const range& r : this->freeRanges) {
+        if (r.size > largest) {
+            largest = r.size;
+        }
+    }
+    return largest;
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,151 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::rangeAllocator
+    @ingroup _priv
+    @brief free-list allocator for byte ranges in a fixed-size arena
+
+    Manages offsets into an externally owned buffer (e.g. a big GL
+    vertex buffer shared by many meshes). Free ranges are kept sorted
+    by offset, allocation is first-fit, freed ranges are coalesced with
+    their neighbours. The alignment doesn't need to be a power of two
+    (vertex ranges are aligned to the vertex stride).
+
+    Allocations are identified by a stable id which survives
+    Defragment(). Defragment() moves all allocations to the front of
+    the arena and returns the old and new location of every live
+    allocation, so that the owner can copy the content into a fresh
+    buffer.
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+
+namespace Oryol {
+namespace _priv {
+
+class rangeAllocator {
+public:
+    /// old and new location of an allocation after Defragment()
+    struct move {
+        int id = InvalidIndex;
+        int srcOffset = 0;
+        int dstOffset = 0;
+        int size = 0;
+    };
+
+    /// destructor
+    ~rangeAllocator();
+
+    /// setup with arena size in bytes
+    void Setup(int size);
+    /// discard the allocator
+    void Discard();
+    /// return true if the allocator has been setup
+    bool IsValid() const;
+
+    /// allocate a range, returns allocation id, or InvalidIndex if no free range is big enough
+    int Alloc(int size, int align, void* userData=nullptr);
+    /// free a range by allocation id
+    void Free(int id);
+    /// get offset of an allocation
+    int Offset(int id) const;
+    /// get size of an allocation
+    int Size(int id) const;
+    /// get user data pointer of an allocation
+    void* UserData(int id) const;
+
+    /// compact all allocations to the front of the arena, outMoves is sorted by offset
+    void Defragment(Array<move>& outMoves);
+    /// return true if an allocation would succeed after Defragment()
+    bool FitsAfterDefragment(int size, int align) const;
+
+    /// get arena size
+    int Capacity() const;
+    /// get number of allocated bytes (without alignment padding)
+    int UsedSize() const;
+    /// get number of live allocations
+    int NumAllocs() const;
+    /// get number of free ranges (a measure of fragmentation)
+    int NumFreeRanges() const;
+    /// get size of the largest free range
+    int LargestFreeRange() const;
+
+private:
+    struct range {
+        int offset = 0;
+        int size = 0;
+    };
+    struct alloc {
+        int offset = 0;
+        int size = 0;
+        int align = 1;
+        void* userData = nullptr;
+        bool used = false;
+    };
+    /// round offset up to alignment
+    static int alignOffset(int offset, int align);
+    /// insert a free range, coalesce with neighbours
+    void insertFreeRange(int offset, int size);
+
+    bool valid = false;
+    int capacity = 0;
+    int usedSize = 0;
+    int numAllocs = 0;
+    Array<range> freeRanges;
+    Array<alloc> allocs;
+    Array<int> freeIds;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+rangeAllocator::IsValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+inline int
+rangeAllocator::Offset(int id) const {
+    o_assert_dbg(this->allocs[id].used);
+    return this->allocs[id].offset;
+}
+
+//------------------------------------------------------------------------------
+inline int
+rangeAllocator::Size(int id) const {
+    o_assert_dbg(this->allocs[id].used);
+    return this->allocs[id].size;
+}
+
+//------------------------------------------------------------------------------
+inline void*
+rangeAllocator::UserData(int id) const {
+    o_assert_dbg(this->allocs[id].used);
+    return this->allocs[id].userData;
+}
+
+//------------------------------------------------------------------------------
+inline int
+rangeAllocator::Capacity() const {
+    return this->capacity;
+}
+
+//------------------------------------------------------------------------------
+inline int
+rangeAllocator::UsedSize() const {
+    return this->usedSize;
+}
+
+//------------------------------------------------------------------------------
+inline int
+rangeAllocator::NumAllocs() const {
+    return this->numAllocs;
+}
+
+//------------------------------------------------------------------------------
+inline int
+rangeAllocator::NumFreeRanges() const {
+    return this->freeRanges.Size();
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -94,6 +94,21 @@ class texture : public d3d12Texture { };
 class texture : public mtlTexture { };
 #endif
 
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::query
+    @ingroup _priv
+    @brief GPU query object (e.g. an occlusion query)
+
+    Queries are currently only implemented on GL, the other
+    backends fail to create query resources.
+*/
+#if ORYOL_OPENGL
+class query : public glQuery { };
+#else
+class query : public queryBase { };
+#endif
+
 } // namespace _priv
 } // namespace Oryol
 
@@ -31,5 +31,15 @@ pipelineBase::Clear() {
     resourceBase::Clear();
 }
 
+//------------------------------------------------------------------------------
+void
+queryBase::Clear() {
+    this->polledNumSamples = 0;
+    this->polledFrameIndex = -1;
+    this->numSamples = 0;
+    this->resultFrameIndex = -1;
+    resourceBase::Clear();
+}
+
 } // namespace _priv
 } // namespace Oryol
@@ -4,6 +4,7 @@
 #include "Gfx/Setup/PipelineSetup.h"
 #include "Gfx/Setup/TextureSetup.h"
 #include "Gfx/Setup/MeshSetup.h"
+#include "Gfx/Setup/QuerySetup.h"
 #include "Gfx/Attrs/TextureAttrs.h"
 #include "Core/Containers/StaticArray.h"
 #include "Gfx/Attrs/VertexBufferAttrs.h"
@@ -72,6 +73,33 @@ public:
     shader* shd = nullptr;
 };
 
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::queryBase
+    @ingroup _priv
+    @brief base class for query implementations
+
+    The renderer polls query results without waiting at the end of a
+    frame (on the render thread in render thread mode) into the
+    polled members. The polled results are published into the result
+    members, which are read by Gfx::QueryResult(), in Gfx::CommitFrame()
+    while the renderer is idle.
+*/
+class queryBase : public resourceBase<QuerySetup> {
+public:
+    /// clear the object
+    void Clear();
+
+    /// latest result polled by the renderer
+    uint32_t polledNumSamples = 0;
+    /// renderer frame index when the polled query was issued, or -1
+    int polledFrameIndex = -1;
+    /// latest published result
+    uint32_t numSamples = 0;
+    /// renderer frame index of the published result, or -1 if no result yet
+    int resultFrameIndex = -1;
+};
+
 } // namespace _priv
 } // namespace Oryol
 
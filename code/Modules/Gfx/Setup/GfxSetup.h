@@ -71,6 +71,12 @@ public:
     int MaxDrawCallsPerFrame = GfxConfig::DefaultMaxDrawCallsPerFrame;
     /// max number of ApplyDrawState per frame (only relevant on some platforms)
     int MaxApplyDrawStatesPerFrame = GfxConfig::DefaultMaxApplyDrawStatesPerFrame;
+    /// size of shared vertex buffer for immutable meshes, 0 to disable (only GL)
+    int MeshArenaVertexBufferSize = 0;
+    /// size of shared index buffer for immutable meshes, 0 to disable (only GL)
+    int MeshArenaIndexBufferSize = 0;
+    /// record Gfx calls and submit them on a dedicated render thread (only GLFW platforms)
+    bool RenderThread = false;
 
     /// get DisplayAttrs object initialized to setup values
     DisplayAttrs GetDisplayAttrs() const;
@@ -0,0 +1,25 @@
+//------------------------------------------------------------------------------
+//  QuerySetup.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "QuerySetup.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+QuerySetup::QuerySetup() :
+Locator(Locator::NonShared()),
+Type(QueryType::SamplesPassed) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+QuerySetup
+QuerySetup::OcclusionQuery(QueryType::Code type) {
+    o_assert_range_dbg(type, QueryType::NumQueryTypes);
+    QuerySetup setup;
+    setup.Type = type;
+    return setup;
+}
+
+} // namespace Oryol
@@ -0,0 +1,27 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::QuerySetup
+    @ingroup Gfx
+    @brief setup object for GPU query resources
+*/
+#include "Resource/Locator.h"
+#include "Gfx/Core/Enums.h"
+
+namespace Oryol {
+
+class QuerySetup {
+public:
+    /// setup an occlusion query
+    static QuerySetup OcclusionQuery(QueryType::Code type=QueryType::SamplesPassed);
+
+    /// default constructor
+    QuerySetup();
+
+    /// resource locator
+    class Locator Locator;
+    /// the query type
+    QueryType::Code Type;
+};
+
+} // namespace Oryol
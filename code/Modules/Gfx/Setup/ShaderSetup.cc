@@ -56,6 +56,14 @@ ShaderSetup::SetProgramFromLibrary(ShaderLang::Code slang, const Oryol::VertexLa
     this->program.vsInputLayout = vsInputLayout;
 }
 
+//------------------------------------------------------------------------------
+void
+ShaderSetup::SetComputeProgramFromSources(ShaderLang::Code slang, const String& csSource) {
+    o_assert_dbg(csSource.IsValid());
+    this->program.csSources[slang] = csSource;
+    this->program.isCompute = true;
+}
+
 //------------------------------------------------------------------------------
 void
 ShaderSetup::AddUniformBlock(const StringAtom& name, const class UniformBlockLayout& layout, ShaderStage::Code bindStage, int bindSlot) {
@@ -118,6 +126,18 @@ ShaderSetup::FragmentShaderSource(ShaderLang::Code slang) const {
     return this->program.fsSources[slang];
 }
 
+//------------------------------------------------------------------------------
+const String&
+ShaderSetup::ComputeShaderSource(ShaderLang::Code slang) const {
+    return this->program.csSources[slang];
+}
+
+//------------------------------------------------------------------------------
+bool
+ShaderSetup::IsComputeProgram() const {
+    return this->program.isCompute;
+}
+
 //------------------------------------------------------------------------------
 void
 ShaderSetup::VertexShaderByteCode(ShaderLang::Code slang, const void*& outPtr, uint32_t& outSize) const {
@@ -35,6 +35,8 @@ public:
     void SetProgramFromByteCode(ShaderLang::Code slang, const VertexLayout& vsInputLayout, const uint8_t* vsByteCode, uint32_t vsNumBytes, const uint8_t* fsByteCode, uint32_t fsNumBytes);
     /// set shader program from a metal-style shader library
     void SetProgramFromLibrary(ShaderLang::Code slang, const VertexLayout& vsInputLayout, const char* vsFunc, const char* fsFunc);
+    /// set compute shader program from compute-shader source
+    void SetComputeProgramFromSources(ShaderLang::Code slang, const String& csSource);
     /// add a uniform block
     void AddUniformBlock(const StringAtom& name, const UniformBlockLayout& layout, ShaderStage::Code bindStage, int32_t bindSlot);
     /// add a texture block
@@ -55,6 +57,10 @@ public:
     void VertexShaderByteCode(ShaderLang::Code slang, const void*& outPtr, uint32_t& outSize) const;
     /// get program fragment shader byte code, returns nullptr if no byte code exists
     void FragmentShaderByteCode(ShaderLang::Code slang, const void*& outPtr, uint32_t& outSize) const;
+    /// get program compute shader source (only valid if setup from sources)
+    const String& ComputeShaderSource(ShaderLang::Code slang) const;
+    /// return true if this is a compute program
+    bool IsComputeProgram() const;
     /// get vertex shader name (if using metal-style shader library
     const String& VertexShaderFunc(ShaderLang::Code slang) const;
     /// get fragment shader name (if using metal-style shader library
@@ -88,6 +94,7 @@ private:
     struct programEntry {
         StaticArray<String, ShaderLang::NumShaderLangs> vsSources;
         StaticArray<String, ShaderLang::NumShaderLangs> fsSources;
+        StaticArray<String, ShaderLang::NumShaderLangs> csSources;
         StaticArray<String, ShaderLang::NumShaderLangs> vsFuncs;
         StaticArray<String, ShaderLang::NumShaderLangs> fsFuncs;
         struct byteCodeEntry {
@@ -97,6 +104,7 @@ private:
         StaticArray<byteCodeEntry, ShaderLang::NumShaderLangs> vsByteCode;
         StaticArray<byteCodeEntry, ShaderLang::NumShaderLangs> fsByteCode;
         VertexLayout vsInputLayout;
+        bool isCompute = false;
     };
     struct uniformBlockEntry {
         StringAtom name;
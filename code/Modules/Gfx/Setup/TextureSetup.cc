@@ -12,6 +12,7 @@ TextureUsage(Usage::Immutable),
 Type(TextureType::Texture2D),
 Width(0),
 Height(0),
+Depth(1),
 RelWidth(0.0f),
 RelHeight(0.0f),
 NumMipMaps(1),
@@ -78,7 +79,7 @@ TextureSetup::FromPixelData(int w, int h, int numMipMaps, TextureType::Code type
     setup.Height = h;
     setup.NumMipMaps = numMipMaps;
     setup.ColorFormat = fmt;
-    setup.ImageData.NumFaces = (type == TextureType::Texture2D) ? 1 : 6;
+    setup.ImageData.NumFaces = (type == TextureType::TextureCube) ? 6 : 1;
     setup.ImageData.NumMipMaps = numMipMaps;
     return setup;
 }
@@ -90,7 +91,7 @@ TextureSetup::Empty(int w, int h, int numMipMaps, TextureType::Code type, PixelF
     o_assert(h > 0);
     o_assert(PixelFormat::IsValidTextureColorFormat(fmt));
     o_assert(!PixelFormat::IsCompressedFormat(fmt));
-    o_assert(TextureType::Texture2D == type);
+    o_assert((TextureType::Texture2D == type) || (TextureType::Texture2DArray == type));
     o_assert((numMipMaps > 0) && (numMipMaps < GfxConfig::MaxNumTextureMipMaps));
     
     TextureSetup setup;
@@ -57,6 +57,8 @@ public:
     int Width;
     /// the height in pixels (only if absolute-size render target)
     int Height;
+    /// number of layers of a Texture2DArray (default is 1)
+    int Depth;
     /// display-relative width (only if screen render target)
     float RelWidth;
     /// display-relative height (only if screen render target)
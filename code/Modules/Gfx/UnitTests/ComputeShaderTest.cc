@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+//  ComputeShaderTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Gfx/Core/renderer.h"
+#include "Gfx/Resource/factory.h"
+#include "Gfx/Resource/resourcePools.h"
+#include "Gfx/Setup/GfxSetup.h"
+#include "Gfx/Core/displayMgr.h"
+
+#if ORYOL_OPENGL
+#include "Gfx/gl/gl_impl.h"
+#endif
+
+using namespace Oryol;
+using namespace _priv;
+
+#if ORYOL_OPENGL
+static const char* csSource =
+    "#version 430\n"
+    "layout(local_size_x=64) in;\n"
+    "layout(std430, binding=0) buffer data_buf { vec4 data[]; };\n"
+    "uniform float scale;\n"
+    "void main() {\n"
+    "    uint i = gl_GlobalInvocationID.x;\n"
+    "    data[i] = data[i] * scale + vec4(float(i));\n"
+    "}\n";
+#endif
+
+//------------------------------------------------------------------------------
+TEST(ComputeShaderSetupTest) {
+    ShaderSetup setup;
+    CHECK(!setup.IsComputeProgram());
+    setup.SetComputeProgramFromSources(ShaderLang::GLSL150, "bla");
+    CHECK(setup.IsComputeProgram());
+    CHECK(setup.ComputeShaderSource(ShaderLang::GLSL150) == "bla");
+    CHECK(!setup.VertexShaderSource(ShaderLang::GLSL150).IsValid());
+
+    UniformBlockLayout layout;
+    layout.TypeHash = 0x1234;
+    layout.Add("scale", UniformType::Float);
+    setup.AddUniformBlock("params", layout, ShaderStage::CS, 0);
+    CHECK(setup.UniformBlockIndexByStageAndSlot(ShaderStage::CS, 0) == 0);
+    CHECK(setup.UniformBlockIndexByStageAndSlot(ShaderStage::VS, 0) == InvalidIndex);
+    CHECK(setup.UniformBlockBindStage(0) == ShaderStage::CS);
+}
+
+//------------------------------------------------------------------------------
+// NOTE: this is should not be treated as sample code on how
+// to use compute shaders, use the Gfx facade instead!
+TEST(ComputeShaderTest) {
+
+    #if !ORYOL_UNITTESTS_HEADLESS && ORYOL_OPENGL && ORYOL_OPENGL_CORE_PROFILE
+    // setup a GL context
+    auto gfxSetup = GfxSetup::Window(400, 300, "Oryol Test");
+    displayMgr displayManager;
+    class renderer renderer;
+    texturePool texPool;
+    meshPool meshPool;
+
+    gfxPointers ptrs;
+    ptrs.displayMgr = &displayManager;
+    ptrs.renderer = &renderer;
+    ptrs.texturePool = &texPool;
+    ptrs.meshPool = &meshPool;
+
+    displayManager.SetupDisplay(gfxSetup, ptrs);
+    renderer.setup(gfxSetup, ptrs);
+    meshFactory mshFactory;
+    mshFactory.Setup(ptrs);
+    shaderFactory shdFactory;
+    shdFactory.Setup(ptrs);
+
+    if (renderer.queryFeature(GfxFeature::ComputeShaders)) {
+
+        // a dynamic mesh with 256 vec4 vertices as storage buffer
+        const int numVertices = 256;
+        float vertices[numVertices * 4];
+        for (int i = 0; i < numVertices * 4; i++) {
+            vertices[i] = 1.0f;
+        }
+        mesh msh;
+        msh.Setup = MeshSetup::FromData(Usage::Dynamic);
+        msh.Setup.NumVertices = numVertices;
+        msh.Setup.Layout.Add(VertexAttr::Position, VertexFormat::Float4);
+        CHECK(ResourceState::Valid == mshFactory.SetupResource(msh, vertices, sizeof(vertices)));
+
+        // the compute shader
+        shader shd;
+        UniformBlockLayout layout;
+        layout.TypeHash = 0x1234;
+        layout.Add("scale", UniformType::Float);
+        shd.Setup.SetComputeProgramFromSources(ShaderLang::GLSL150, csSource);
+        shd.Setup.AddUniformBlock("params", layout, ShaderStage::CS, 0);
+        CHECK(ResourceState::Valid == shdFactory.SetupResource(shd));
+        CHECK(0 != shd.glProgram);
+
+        // run the compute shader and read back the result
+        mesh* storageBuffers[1] = { &msh };
+        const float scale = 3.0f;
+        renderer.applyComputeState(&shd, storageBuffers, 1);
+        renderer.applyUniformBlock(ShaderStage::CS, 0, 0x1234, (const uint8_t*)&scale, sizeof(scale));
+        renderer.dispatch(numVertices / 64, 1, 1);
+        renderer.barrier(BarrierBits::BufferUpdate);
+
+        float result[numVertices * 4] = { };
+        renderer.bindVertexBuffer(msh.buffers[mesh::vb].glBuffers[0]);
+        ::glGetBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(result), result);
+        CHECK(GL_NO_ERROR == ::glGetError());
+        CHECK_CLOSE(3.0f, result[0], 0.0001f);
+        CHECK_CLOSE(4.0f, result[4], 0.0001f);
+        CHECK_CLOSE(258.0f, result[255 * 4 + 3], 0.0001f);
+
+        // without a compute state, dispatches are ignored
+        renderer.applyComputeState(nullptr, storageBuffers, 0);
+        renderer.dispatch(numVertices / 64, 1, 1);
+        CHECK(GL_NO_ERROR == ::glGetError());
+
+        shdFactory.DestroyResource(shd);
+        mshFactory.DestroyResource(msh);
+    }
+
+    shdFactory.Discard();
+    mshFactory.Discard();
+    renderer.discard();
+    displayManager.DiscardDisplay();
+    #endif
+}
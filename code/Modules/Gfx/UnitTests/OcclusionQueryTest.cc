@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+//  OcclusionQueryTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Gfx/Core/renderer.h"
+#include "Gfx/Resource/factory.h"
+#include "Gfx/Resource/resourcePools.h"
+#include "Gfx/Setup/GfxSetup.h"
+#include "Gfx/Setup/QuerySetup.h"
+#include "Gfx/Core/displayMgr.h"
+
+#if ORYOL_OPENGL
+#include "Gfx/gl/gl_impl.h"
+#endif
+
+using namespace Oryol;
+using namespace _priv;
+
+#if ORYOL_OPENGL
+static const char* vsSource =
+    "#version 150\n"
+    "in vec4 position;\n"
+    "void main() {\n"
+    "    gl_Position = position;\n"
+    "}\n";
+static const char* fsSource =
+    "#version 150\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    fragColor = vec4(1.0);\n"
+    "}\n";
+#endif
+
+//------------------------------------------------------------------------------
+TEST(QuerySetupTest) {
+    const auto setup = QuerySetup::OcclusionQuery();
+    CHECK(setup.Type == QueryType::SamplesPassed);
+    CHECK(!setup.Locator.IsShared());
+    const auto setup1 = QuerySetup::OcclusionQuery(QueryType::AnySamplesPassed);
+    CHECK(setup1.Type == QueryType::AnySamplesPassed);
+}
+
+//------------------------------------------------------------------------------
+// NOTE: this is should not be treated as sample code on how
+// to use occlusion queries, use the Gfx facade instead!
+TEST(OcclusionQueryTest) {
+
+    #if !ORYOL_UNITTESTS_HEADLESS && ORYOL_OPENGL && ORYOL_OPENGL_CORE_PROFILE
+    // setup a GL context
+    auto gfxSetup = GfxSetup::Window(400, 300, "Oryol Test");
+    displayMgr displayManager;
+    class renderer renderer;
+    texturePool texPool;
+    meshPool meshPool;
+    shaderPool shdPool;
+    texPool.Setup(GfxResourceType::Texture, 4);
+    shdPool.Setup(GfxResourceType::Shader, 4);
+
+    gfxPointers ptrs;
+    ptrs.displayMgr = &displayManager;
+    ptrs.renderer = &renderer;
+    ptrs.texturePool = &texPool;
+    ptrs.meshPool = &meshPool;
+    ptrs.shaderPool = &shdPool;
+
+    displayManager.SetupDisplay(gfxSetup, ptrs);
+    renderer.setup(gfxSetup, ptrs);
+    meshFactory mshFactory;
+    mshFactory.Setup(ptrs);
+    shaderFactory shdFactory;
+    shdFactory.Setup(ptrs);
+    textureFactory texFactory;
+    texFactory.Setup(ptrs);
+    pipelineFactory pipFactory;
+    pipFactory.Setup(ptrs);
+    queryFactory qryFactory;
+    qryFactory.Setup(ptrs);
+
+    if (renderer.queryFeature(GfxFeature::OcclusionQuery)) {
+
+        // a 64x64 render target, a fullscreen quad and a degenerate triangle
+        const int rtSize = 64;
+        const Id rtId = texPool.AllocId();
+        texture& rt = texPool.Assign(rtId, TextureSetup::RenderTarget(rtSize, rtSize), ResourceState::Setup);
+        CHECK(ResourceState::Valid == texFactory.SetupResource(rt));
+        texPool.UpdateState(rtId, ResourceState::Valid);
+
+        const float vertices[] = {
+            -1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f,
+            -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f,
+            0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f,
+        };
+        mesh msh;
+        msh.Setup = MeshSetup::FromData();
+        msh.Setup.NumVertices = 9;
+        msh.Setup.Layout.Add(VertexAttr::Position, VertexFormat::Float2);
+        msh.Setup.AddPrimitiveGroup(PrimitiveGroup(0, 6));
+        msh.Setup.AddPrimitiveGroup(PrimitiveGroup(6, 3));
+        CHECK(ResourceState::Valid == mshFactory.SetupResource(msh, vertices, sizeof(vertices)));
+
+        const Id shdId = shdPool.AllocId();
+        ShaderSetup shdSetup;
+        shdSetup.SetProgramFromSources(ShaderLang::GLSL150, msh.Setup.Layout, vsSource, fsSource);
+        shader& shd = shdPool.Assign(shdId, shdSetup, ResourceState::Setup);
+        CHECK(ResourceState::Valid == shdFactory.SetupResource(shd));
+        shdPool.UpdateState(shdId, ResourceState::Valid);
+
+        pipeline pip;
+        pip.Setup = PipelineSetup::FromLayoutAndShader(msh.Setup.Layout, shdId);
+        pip.Setup.BlendState.ColorFormat = rt.Setup.ColorFormat;
+        pip.Setup.BlendState.DepthFormat = rt.Setup.DepthFormat;
+        CHECK(ResourceState::Valid == pipFactory.SetupResource(pip));
+
+        query qryFull, qryEmpty, qryCond;
+        qryFull.Setup = QuerySetup::OcclusionQuery();
+        qryEmpty.Setup = QuerySetup::OcclusionQuery();
+        qryCond.Setup = QuerySetup::OcclusionQuery(QueryType::AnySamplesPassed);
+        CHECK(ResourceState::Valid == qryFactory.SetupResource(qryFull));
+        CHECK(ResourceState::Valid == qryFactory.SetupResource(qryEmpty));
+        CHECK(ResourceState::Valid == qryFactory.SetupResource(qryCond));
+        CHECK(-1 == qryFull.resultFrameIndex);
+
+        // a frame with one query around the quad, and one around the empty triangle
+        mesh* meshes[1] = { &msh };
+        renderer.applyRenderTarget(&rt, ClearState::ClearAll());
+        renderer.applyDrawState(&pip, meshes, 1);
+        renderer.beginQuery(&qryFull);
+        renderer.draw(0);
+        renderer.endQuery(&qryFull);
+        renderer.beginQuery(&qryEmpty);
+        renderer.draw(1);
+        renderer.endQuery(&qryEmpty);
+        if (renderer.queryFeature(GfxFeature::ConditionalRender)) {
+            // the GPU must wait for the result of the empty query
+            // issued right before, and skip the draw call
+            renderer.beginQuery(&qryCond);
+            renderer.beginConditionalRender(&qryEmpty);
+            renderer.draw(0);
+            renderer.endConditionalRender();
+            renderer.endQuery(&qryCond);
+        }
+        CHECK(GL_NO_ERROR == ::glGetError());
+
+        // results are only visible after commitFrame and publishing
+        ::glFinish();
+        CHECK(-1 == qryFull.resultFrameIndex);
+        renderer.commitFrame();
+        CHECK(-1 == qryFull.resultFrameIndex);
+        renderer.publishQueryResults();
+        CHECK(0 == qryFull.resultFrameIndex);
+        CHECK(uint32_t(rtSize * rtSize) == qryFull.numSamples);
+        CHECK(0 == qryEmpty.resultFrameIndex);
+        CHECK(0 == qryEmpty.numSamples);
+        if (renderer.queryFeature(GfxFeature::ConditionalRender)) {
+            CHECK(0 == qryCond.resultFrameIndex);
+            CHECK(0 == qryCond.numSamples);
+        }
+
+        // issue the same query more often than it has GL query objects,
+        // without waiting for results, the newest result must win
+        const int numFrames = query::NumSlots + 2;
+        for (int frame = 1; frame <= numFrames; frame++) {
+            renderer.applyRenderTarget(&rt, ClearState::ClearAll());
+            renderer.applyDrawState(&pip, meshes, 1);
+            renderer.beginQuery(&qryFull);
+            renderer.draw(frame == numFrames ? 1 : 0);
+            renderer.endQuery(&qryFull);
+            if (frame == numFrames) {
+                ::glFinish();
+            }
+            renderer.commitFrame();
+            renderer.publishQueryResults();
+            CHECK(qryFull.resultFrameIndex <= frame);
+        }
+        CHECK(numFrames == qryFull.resultFrameIndex);
+        CHECK(0 == qryFull.numSamples);
+        CHECK(GL_NO_ERROR == ::glGetError());
+
+        qryFactory.DestroyResource(qryCond);
+        qryFactory.DestroyResource(qryEmpty);
+        qryFactory.DestroyResource(qryFull);
+        pipFactory.DestroyResource(pip);
+        shdFactory.DestroyResource(shd);
+        shdPool.Unassign(shdId);
+        mshFactory.DestroyResource(msh);
+        texFactory.DestroyResource(rt);
+        texPool.Unassign(rtId);
+    }
+
+    qryFactory.Discard();
+    pipFactory.Discard();
+    texFactory.Discard();
+    shdFactory.Discard();
+    mshFactory.Discard();
+    renderer.discard();
+    displayManager.DiscardDisplay();
+    shdPool.Discard();
+    texPool.Discard();
+    #endif
+}
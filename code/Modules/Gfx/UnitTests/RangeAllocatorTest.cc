@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+//  RangeAllocatorTest.cc
+//  Test the mesh arena range allocator.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Gfx/Resource/rangeAllocator.h"
+
+using namespace Oryol;
+using namespace _priv;
+
+TEST(RangeAllocatorTest) {
+    rangeAllocator alloc;
+    alloc.Setup(1024);
+    CHECK(alloc.IsValid());
+    CHECK(alloc.Capacity() == 1024);
+    CHECK(alloc.UsedSize() == 0);
+    CHECK(alloc.NumFreeRanges() == 1);
+    CHECK(alloc.LargestFreeRange() == 1024);
+
+    // first-fit with non-power-of-2 alignment
+    int a0 = alloc.Alloc(100, 4);
+    CHECK(a0 != InvalidIndex);
+    CHECK(alloc.Offset(a0) == 0);
+    CHECK(alloc.Size(a0) == 100);
+    int a1 = alloc.Alloc(60, 12);
+    CHECK(alloc.Offset(a1) == 108);
+    CHECK(alloc.NumFreeRanges() == 2);
+    int a2 = alloc.Alloc(8, 4);
+    CHECK(alloc.Offset(a2) == 100);
+    CHECK(alloc.NumFreeRanges() == 1);
+    int a3 = alloc.Alloc(200, 2, &alloc);
+    CHECK(alloc.Offset(a3) == 168);
+    CHECK(alloc.UserData(a3) == &alloc);
+    CHECK(alloc.NumAllocs() == 4);
+    CHECK(alloc.UsedSize() == 368);
+
+    // too big
+    CHECK(InvalidIndex == alloc.Alloc(1024, 4));
+
+    // free and coalesce
+    alloc.Free(a2);
+    CHECK(alloc.NumFreeRanges() == 2);
+    alloc.Free(a0);
+    CHECK(alloc.NumFreeRanges() == 2);
+    CHECK(alloc.LargestFreeRange() == 1024 - 368);
+    alloc.Free(a1);
+    CHECK(alloc.NumFreeRanges() == 2);
+    CHECK(alloc.LargestFreeRange() == 1024 - 368);
+    int a4 = alloc.Alloc(168, 4);
+    CHECK(alloc.Offset(a4) == 0);
+    CHECK(alloc.NumFreeRanges() == 1);
+    alloc.Free(a4);
+    alloc.Free(a3);
+    CHECK(alloc.NumFreeRanges() == 1);
+    CHECK(alloc.LargestFreeRange() == 1024);
+    CHECK(alloc.NumAllocs() == 0);
+
+    // fragment the arena and defragment
+    int ids[8];
+    for (int i = 0; i < 8; i++) {
+        ids[i] = alloc.Alloc(128, 16);
+        CHECK(alloc.Offset(ids[i]) == i * 128);
+    }
+    CHECK(InvalidIndex == alloc.Alloc(16, 16));
+    for (int i = 0; i < 8; i += 2) {
+        alloc.Free(ids[i]);
+    }
+    CHECK(alloc.NumFreeRanges() == 4);
+    CHECK(InvalidIndex == alloc.Alloc(256, 16));
+    CHECK(alloc.FitsAfterDefragment(256, 16));
+    CHECK(alloc.FitsAfterDefragment(512, 16));
+    CHECK(!alloc.FitsAfterDefragment(528, 16));
+    Array<rangeAllocator::move> moves;
+    alloc.Defragment(moves);
+    CHECK(moves.Size() == 4);
+    for (int i = 0; i < 4; i++) {
+        const int id = ids[i * 2 + 1];
+        CHECK(moves[i].id == id);
+        CHECK(moves[i].srcOffset == (i * 2 + 1) * 128);
+        CHECK(moves[i].dstOffset == i * 128);
+        CHECK(moves[i].size == 128);
+        CHECK(alloc.Offset(id) == i * 128);
+    }
+    CHECK(alloc.NumFreeRanges() == 1);
+    CHECK(alloc.LargestFreeRange() == 512);
+    int a5 = alloc.Alloc(256, 16);
+    CHECK(alloc.Offset(a5) == 512);
+
+    // unmoved allocations are reported too
+    alloc.Free(ids[1]);
+    alloc.Defragment(moves);
+    CHECK(moves.Size() == 4);
+    CHECK(moves[0].id == ids[3]);
+    CHECK((moves[0].srcOffset == 128) && (moves[0].dstOffset == 0));
+    CHECK(moves[3].id == a5);
+    CHECK((moves[3].srcOffset == 512) && (moves[3].dstOffset == 384));
+
+    alloc.Discard();
+    CHECK(!alloc.IsValid());
+}
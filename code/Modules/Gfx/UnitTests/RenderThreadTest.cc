@@ -0,0 +1,485 @@
+//------------------------------------------------------------------------------
+//  RenderThreadTest.cc
+//  Test recording Gfx calls and replaying them on the render thread,
+//  with a null renderer which only logs the calls.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Gfx/Core/gfxCmdStream.h"
+#include "Gfx/Core/renderThread.h"
+#include "Core/Containers/Array.h"
+#include "Core/Time/Clock.h"
+#include "Core/Log.h"
+#include <thread>
+
+using namespace Oryol;
+using namespace _priv;
+
+// fake resource pointers, the null renderer never dereferences them
+static texture* const tex0 = (texture*) 0x1000;
+static texture* const tex1 = (texture*) 0x1010;
+static mesh* const msh0 = (mesh*) 0x2000;
+static mesh* const msh1 = (mesh*) 0x2010;
+static pipeline* const pip0 = (pipeline*) 0x3000;
+static shader* const shd0 = (shader*) 0x4000;
+static query* const qry0 = (query*) 0x5000;
+static query* const qry1 = (query*) 0x5010;
+
+class nullRenderer {
+public:
+    enum callCode {
+        ApplyRenderTarget,
+        ApplyViewPort,
+        ApplyScissorRect,
+        ApplyDrawState,
+        ApplyTextures,
+        ApplyUniformBlock,
+        Draw,
+        DrawInstanced,
+        ApplyComputeState,
+        Dispatch,
+        Barrier,
+        BeginQuery,
+        EndQuery,
+        BeginConditionalRender,
+        EndConditionalRender,
+        UpdateVertices,
+        UpdateIndices,
+        UpdateTexture,
+        ResetStateCache,
+        CommitFrame,
+    };
+    Array<int> calls;
+    Array<int> args;
+    Array<uint8_t> payload;
+    std::thread::id threadId;
+
+    void applyRenderTarget(texture* rt, const ClearState& clearState) {
+        this->add(ApplyRenderTarget);
+        this->args.Add(rt == tex1 ? 1 : 0);
+        this->args.Add(clearState.Actions);
+    };
+    void applyViewPort(int x, int y, int width, int height, bool originTopLeft) {
+        this->add(ApplyViewPort);
+        this->args.Add(x); this->args.Add(y); this->args.Add(width); this->args.Add(height); this->args.Add(originTopLeft);
+    };
+    void applyScissorRect(int x, int y, int width, int height, bool originTopLeft) {
+        this->add(ApplyScissorRect);
+        this->args.Add(x); this->args.Add(y); this->args.Add(width); this->args.Add(height); this->args.Add(originTopLeft);
+    };
+    void applyDrawState(pipeline* pip, mesh** meshes, int numMeshes) {
+        this->add(ApplyDrawState);
+        this->args.Add(pip == pip0);
+        this->args.Add(numMeshes);
+        for (int i = 0; i < numMeshes; i++) {
+            this->args.Add(meshes[i] == msh1 ? 1 : 0);
+        }
+    };
+    void applyTextures(ShaderStage::Code bindStage, texture** textures, int numTextures) {
+        this->add(ApplyTextures);
+        this->args.Add(bindStage);
+        this->args.Add(numTextures);
+        for (int i = 0; i < numTextures; i++) {
+            this->args.Add(textures[i] == tex1 ? 1 : 0);
+        }
+    };
+    void applyUniformBlock(ShaderStage::Code bindStage, int bindSlot, int64_t layoutHash, const uint8_t* ptr, int byteSize) {
+        this->add(ApplyUniformBlock);
+        CHECK(0 == (uintptr_t(ptr) & 15));
+        this->args.Add(bindStage); this->args.Add(bindSlot); this->args.Add(int(layoutHash)); this->args.Add(byteSize);
+        this->addPayload(ptr, byteSize);
+    };
+    void draw(int primGroupIndex) {
+        this->add(Draw);
+        this->args.Add(primGroupIndex);
+    };
+    void draw(const PrimitiveGroup& primGroup) {
+        this->add(Draw);
+        this->args.Add(primGroup.BaseElement); this->args.Add(primGroup.NumElements);
+    };
+    void drawInstanced(int primGroupIndex, int numInstances) {
+        this->add(DrawInstanced);
+        this->args.Add(primGroupIndex); this->args.Add(numInstances);
+    };
+    void drawInstanced(const PrimitiveGroup& primGroup, int numInstances) {
+        this->add(DrawInstanced);
+        this->args.Add(primGroup.BaseElement); this->args.Add(primGroup.NumElements); this->args.Add(numInstances);
+    };
+    void applyComputeState(shader* shd, mesh** storageBuffers, int numStorageBuffers) {
+        this->add(ApplyComputeState);
+        this->args.Add(shd == shd0);
+        this->args.Add(numStorageBuffers);
+        for (int i = 0; i < numStorageBuffers; i++) {
+            this->args.Add(storageBuffers[i] == msh1 ? 1 : 0);
+        }
+    };
+    void dispatch(int numGroupsX, int numGroupsY, int numGroupsZ) {
+        this->add(Dispatch);
+        this->args.Add(numGroupsX); this->args.Add(numGroupsY); this->args.Add(numGroupsZ);
+    };
+    void barrier(BarrierBits::Mask bits) {
+        this->add(Barrier);
+        this->args.Add(bits);
+    };
+    void beginQuery(query* qry) {
+        this->add(BeginQuery);
+        this->args.Add(qry == qry1 ? 1 : 0);
+    };
+    void endQuery(query* qry) {
+        this->add(EndQuery);
+        this->args.Add(qry == qry1 ? 1 : 0);
+    };
+    void beginConditionalRender(query* qry) {
+        this->add(BeginConditionalRender);
+        this->args.Add(qry == qry1 ? 1 : 0);
+    };
+    void endConditionalRender() {
+        this->add(EndConditionalRender);
+    };
+    void updateVertices(mesh* msh, const void* data, int numBytes) {
+        this->add(UpdateVertices);
+        this->args.Add(msh == msh1 ? 1 : 0); this->args.Add(numBytes);
+        this->addPayload(data, numBytes);
+    };
+    void updateIndices(mesh* msh, const void* data, int numBytes) {
+        this->add(UpdateIndices);
+        this->args.Add(msh == msh1 ? 1 : 0); this->args.Add(numBytes);
+        this->addPayload(data, numBytes);
+    };
+    void updateTexture(texture* tex, const void* data, const ImageDataAttrs& offsetsAndSizes) {
+        this->add(UpdateTexture);
+        this->args.Add(tex == tex1 ? 1 : 0);
+        this->args.Add(offsetsAndSizes.NumFaces); this->args.Add(offsetsAndSizes.NumMipMaps);
+        for (int mip = 0; mip < offsetsAndSizes.NumMipMaps; mip++) {
+            this->args.Add(offsetsAndSizes.Offsets[0][mip]);
+            this->addPayload((const uint8_t*)data + offsetsAndSizes.Offsets[0][mip], offsetsAndSizes.Sizes[0][mip]);
+        }
+    };
+    void resetStateCache() {
+        this->add(ResetStateCache);
+    };
+    void commitFrame() {
+        this->add(CommitFrame);
+    };
+    void add(callCode call) {
+        this->calls.Add(call);
+        this->threadId = std::this_thread::get_id();
+    };
+    void addPayload(const void* ptr, int numBytes) {
+        for (int i = 0; i < numBytes; i++) {
+            this->payload.Add(((const uint8_t*)ptr)[i]);
+        }
+    };
+};
+
+//------------------------------------------------------------------------------
+TEST(GfxCmdStreamTest) {
+    gfxCmdStream cmds;
+    CHECK(cmds.empty());
+
+    uint8_t data[256];
+    for (int i = 0; i < 256; i++) {
+        data[i] = uint8_t(i);
+    }
+    ImageDataAttrs imgAttrs;
+    imgAttrs.NumFaces = 1;
+    imgAttrs.NumMipMaps = 2;
+    imgAttrs.Offsets[0][0] = 0;
+    imgAttrs.Sizes[0][0] = 4;
+    imgAttrs.Offsets[0][1] = 8;
+    imgAttrs.Sizes[0][1] = 2;
+    mesh* meshes[2] = { msh0, msh1 };
+    texture* textures[3] = { tex0, tex1, tex1 };
+    const PrimitiveGroup primGroup(6, 12);
+
+    cmds.applyRenderTarget(tex1, ClearState::ClearColor());
+    cmds.applyViewPort(1, 2, 3, 4, true);
+    cmds.applyScissorRect(5, 6, 7, 8, false);
+    cmds.applyDrawState(pip0, meshes, 2);
+    cmds.applyTextures(ShaderStage::FS, textures, 3);
+    cmds.applyUniformBlock(ShaderStage::VS, 1, 0x1234, data, 3);
+    cmds.draw(2);
+    cmds.draw(primGroup);
+    cmds.drawInstanced(3, 100);
+    cmds.drawInstanced(primGroup, 200);
+    cmds.updateVertices(msh1, data + 10, 5);
+    cmds.updateIndices(msh0, data + 20, 1);
+    cmds.updateTexture(tex1, data + 100, imgAttrs);
+    cmds.resetStateCache();
+    CHECK(cmds.numCmds() == 14);
+
+    // the payloads have been copied
+    for (int i = 0; i < 256; i++) {
+        data[i] = 0;
+    }
+
+    nullRenderer renderer;
+    cmds.replay(renderer);
+    const int expectedCalls[] = {
+        nullRenderer::ApplyRenderTarget, nullRenderer::ApplyViewPort, nullRenderer::ApplyScissorRect,
+        nullRenderer::ApplyDrawState, nullRenderer::ApplyTextures, nullRenderer::ApplyUniformBlock,
+        nullRenderer::Draw, nullRenderer::Draw, nullRenderer::DrawInstanced, nullRenderer::DrawInstanced,
+        nullRenderer::UpdateVertices, nullRenderer::UpdateIndices, nullRenderer::UpdateTexture,
+        nullRenderer::ResetStateCache
+    };
+    CHECK(renderer.calls.Size() == 14);
+    for (int i = 0; i < renderer.calls.Size(); i++) {
+        CHECK(renderer.calls[i] == expectedCalls[i]);
+    }
+    const int expectedArgs[] = {
+        1, ClearState::ColorBit,
+        1, 2, 3, 4, 1,
+        5, 6, 7, 8, 0,
+        1, 2, 0, 1,
+        ShaderStage::FS, 3, 0, 1, 1,
+        ShaderStage::VS, 1, 0x1234, 3,
+        2,
+        6, 12,
+        3, 100,
+        6, 12, 200,
+        1, 5,
+        0, 1,
+        1, 1, 2, 0, 8
+    };
+    const int numExpectedArgs = sizeof(expectedArgs) / sizeof(int);
+    CHECK(renderer.args.Size() == numExpectedArgs);
+    for (int i = 0; i < numExpectedArgs; i++) {
+        CHECK(renderer.args[i] == expectedArgs[i]);
+    }
+    const uint8_t expectedPayload[] = {
+        0, 1, 2,
+        10, 11, 12, 13, 14,
+        20,
+        100, 101, 102, 103,
+        108, 109
+    };
+    CHECK(renderer.payload.Size() == sizeof(expectedPayload));
+    for (int i = 0; i < renderer.payload.Size(); i++) {
+        CHECK(renderer.payload[i] == expectedPayload[i]);
+    }
+
+    // replaying again gives the same result, clearing empties the stream
+    nullRenderer renderer2;
+    cmds.replay(renderer2);
+    CHECK(renderer2.calls.Size() == 14);
+    CHECK(renderer2.payload.Size() == renderer.payload.Size());
+    cmds.clear();
+    CHECK(cmds.empty());
+    CHECK(0 == cmds.numBytes());
+}
+
+//------------------------------------------------------------------------------
+TEST(GfxCmdStreamComputeTest) {
+    gfxCmdStream cmds;
+    uint8_t data[16];
+    for (int i = 0; i < 16; i++) {
+        data[i] = uint8_t(i);
+    }
+    mesh* storageBuffers[3] = { msh1, msh0, msh1 };
+
+    cmds.applyComputeState(shd0, storageBuffers, 3);
+    cmds.applyUniformBlock(ShaderStage::CS, 0, 0x5678, data, 4);
+    cmds.dispatch(64, 2, 1);
+    cmds.barrier(BarrierBits::VertexData|BarrierBits::BufferUpdate);
+    cmds.applyComputeState(nullptr, storageBuffers, 0);
+    cmds.dispatch(1, 1, 1);
+    CHECK(cmds.numCmds() == 6);
+
+    nullRenderer renderer;
+    cmds.replay(renderer);
+    const int expectedCalls[] = {
+        nullRenderer::ApplyComputeState, nullRenderer::ApplyUniformBlock, nullRenderer::Dispatch,
+        nullRenderer::Barrier, nullRenderer::ApplyComputeState, nullRenderer::Dispatch
+    };
+    CHECK(renderer.calls.Size() == 6);
+    for (int i = 0; i < renderer.calls.Size(); i++) {
+        CHECK(renderer.calls[i] == expectedCalls[i]);
+    }
+    const int expectedArgs[] = {
+        1, 3, 1, 0, 1,
+        ShaderStage::CS, 0, 0x5678, 4,
+        64, 2, 1,
+        BarrierBits::VertexData|BarrierBits::BufferUpdate,
+        0, 0,
+        1, 1, 1
+    };
+    const int numExpectedArgs = sizeof(expectedArgs) / sizeof(int);
+    CHECK(renderer.args.Size() == numExpectedArgs);
+    for (int i = 0; i < numExpectedArgs; i++) {
+        CHECK(renderer.args[i] == expectedArgs[i]);
+    }
+    CHECK(renderer.payload.Size() == 4);
+    CHECK(renderer.payload[3] == 3);
+}
+
+//------------------------------------------------------------------------------
+TEST(GfxCmdStreamQueryTest) {
+    gfxCmdStream cmds;
+    cmds.beginQuery(qry1);
+    cmds.draw(0);
+    cmds.endQuery(qry1);
+    cmds.beginQuery(qry0);
+    cmds.endQuery(qry0);
+    cmds.beginConditionalRender(qry1);
+    cmds.draw(1);
+    cmds.endConditionalRender();
+    CHECK(cmds.numCmds() == 8);
+
+    nullRenderer renderer;
+    cmds.replay(renderer);
+    const int expectedCalls[] = {
+        nullRenderer::BeginQuery, nullRenderer::Draw, nullRenderer::EndQuery,
+        nullRenderer::BeginQuery, nullRenderer::EndQuery,
+        nullRenderer::BeginConditionalRender, nullRenderer::Draw, nullRenderer::EndConditionalRender
+    };
+    CHECK(renderer.calls.Size() == 8);
+    for (int i = 0; i < renderer.calls.Size(); i++) {
+        CHECK(renderer.calls[i] == expectedCalls[i]);
+    }
+    const int expectedArgs[] = { 1, 0, 1, 0, 0, 1, 1 };
+    const int numExpectedArgs = sizeof(expectedArgs) / sizeof(int);
+    CHECK(renderer.args.Size() == numExpectedArgs);
+    for (int i = 0; i < numExpectedArgs; i++) {
+        CHECK(renderer.args[i] == expectedArgs[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(RenderThreadTest) {
+    nullRenderer renderer;
+    bool started = false;
+    bool stopped = false;
+    renderThread rt;
+
+    // without a running thread, call() runs the function directly
+    bool called = false;
+    rt.call([&called] { called = true; });
+    CHECK(called);
+
+    rt.setup([&started] { started = true; },
+        [&renderer](const gfxCmdStream& cmds, bool endOfFrame) {
+            cmds.replay(renderer);
+            if (endOfFrame) {
+                renderer.commitFrame();
+            }
+        },
+        [&stopped] { stopped = true; });
+    CHECK(rt.isValid());
+
+    // record two frames, data is copied so the source can be modified right away,
+    // the sync function runs on the main thread after the previous frame is done
+    uint8_t vertices[16] = { };
+    int numCallsInSync[2] = { -1, -1 };
+    for (int frame = 0; frame < 2; frame++) {
+        vertices[0] = uint8_t(frame + 1);
+        rt.cmdStream().applyRenderTarget(nullptr, ClearState());
+        rt.cmdStream().updateVertices(msh0, vertices, sizeof(vertices));
+        rt.cmdStream().draw(0);
+        vertices[0] = 0xFF;
+        rt.commitFrame([&renderer, &numCallsInSync, frame] {
+            CHECK(renderer.threadId != std::this_thread::get_id());
+            numCallsInSync[frame] = renderer.calls.Size();
+        });
+    }
+    CHECK(rt.numCommittedFrames() == 2);
+    CHECK(numCallsInSync[0] == 0);
+    CHECK(numCallsInSync[1] == 4);
+
+    // a synchronous call first replays the current frame's calls so far
+    rt.cmdStream().applyViewPort(0, 0, 16, 16, false);
+    int numCallsInCall = 0;
+    std::thread::id callThreadId;
+    rt.call([&renderer, &numCallsInCall, &callThreadId] {
+        numCallsInCall = renderer.calls.Size();
+        callThreadId = std::this_thread::get_id();
+    });
+    CHECK(numCallsInCall == 9);
+    CHECK(rt.cmdStream().empty());
+    CHECK(callThreadId == renderer.threadId);
+    CHECK(callThreadId != std::this_thread::get_id());
+
+    // discard executes the remaining calls without presenting them
+    rt.cmdStream().draw(1);
+    rt.discard();
+    CHECK(started);
+    CHECK(stopped);
+    CHECK(!rt.isValid());
+
+    const int expectedCalls[] = {
+        nullRenderer::ApplyRenderTarget, nullRenderer::UpdateVertices, nullRenderer::Draw, nullRenderer::CommitFrame,
+        nullRenderer::ApplyRenderTarget, nullRenderer::UpdateVertices, nullRenderer::Draw, nullRenderer::CommitFrame,
+        nullRenderer::ApplyViewPort,
+        nullRenderer::Draw
+    };
+    CHECK(renderer.calls.Size() == 10);
+    for (int i = 0; i < renderer.calls.Size(); i++) {
+        CHECK(renderer.calls[i] == expectedCalls[i]);
+    }
+    CHECK(renderer.payload.Size() == 32);
+    CHECK(renderer.payload[0] == 1);
+    CHECK(renderer.payload[16] == 2);
+}
+
+//------------------------------------------------------------------------------
+static volatile uint32_t burnSink = 0;
+static void
+burnCPU(int iterations) {
+    uint32_t x = burnSink;
+    for (int i = 0; i < iterations; i++) {
+        x = x * 1664525 + 1013904223;
+    }
+    burnSink = x;
+}
+
+TEST(RenderThreadThroughputTest) {
+    // a CPU-bound frame: 'update' cost on the main thread, plus
+    // the same amount of 'submission' cost in the renderer
+    const int numFrames = 60;
+    const int numDraws = 100;
+    const int burnPerDraw = 20000;
+
+    class slowRenderer : public nullRenderer {
+    public:
+        using nullRenderer::draw;
+        void draw(int primGroupIndex) {
+            burnCPU(burnPerDraw);
+        };
+    };
+
+    // immediate mode: update and submission serialize
+    slowRenderer immRenderer;
+    TimePoint start = Clock::Now();
+    for (int frame = 0; frame < numFrames; frame++) {
+        for (int i = 0; i < numDraws; i++) {
+            burnCPU(burnPerDraw);
+            immRenderer.draw(i);
+        }
+        immRenderer.commitFrame();
+    }
+    Duration immTime = Clock::Since(start);
+
+    // render thread mode: submission of the previous frame overlaps with update
+    slowRenderer thrRenderer;
+    renderThread rt;
+    rt.setup(nullptr, [&thrRenderer](const gfxCmdStream& cmds, bool endOfFrame) {
+        cmds.replay(thrRenderer);
+        if (endOfFrame) {
+            thrRenderer.commitFrame();
+        }
+    }, nullptr);
+    start = Clock::Now();
+    for (int frame = 0; frame < numFrames; frame++) {
+        for (int i = 0; i < numDraws; i++) {
+            burnCPU(burnPerDraw);
+            rt.cmdStream().draw(i);
+        }
+        rt.commitFrame();
+    }
+    rt.discard();
+    Duration thrTime = Clock::Since(start);
+    CHECK(thrRenderer.calls.Size() == numFrames);
+
+    Log::Info("RenderThread: %d frames, immediate=%.3fms, render thread=%.3fms, speedup=%.2fx\n",
+        numFrames, immTime.AsMilliSeconds(), thrTime.AsMilliSeconds(),
+        immTime.AsMilliSeconds() / thrTime.AsMilliSeconds());
+}
@@ -527,6 +527,63 @@ d3d11Renderer::drawInstanced(int primGroupIndex, int numInstances) {
     this->drawInstanced(primGroup, numInstances);
 }
 
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::applyComputeState(shader* shd, mesh** storageBuffers, int numStorageBuffers) {
+    // compute shaders are not supported on D3D11, the shader factory
+    // fails to create compute programs, so shd is always nullptr here
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr == shd);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::dispatch(int numGroupsX, int numGroupsY, int numGroupsZ) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::barrier(BarrierBits::Mask bits) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::beginQuery(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::endQuery(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::beginConditionalRender(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::endConditionalRender() {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::publishQueryResults() {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d11Renderer::discardQuery(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
 //------------------------------------------------------------------------------
 void 
 d3d11Renderer::updateVertices(mesh* msh, const void* data, int numBytes) {
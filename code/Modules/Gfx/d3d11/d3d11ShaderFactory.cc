@@ -51,6 +51,10 @@ d3d11ShaderFactory::SetupResource(shader& shd) {
     this->pointers.renderer->invalidateShaderState();
     const ShaderLang::Code slang = ShaderLang::HLSL5;
     const ShaderSetup& setup = shd.Setup;
+    if (setup.IsComputeProgram()) {
+        o_warn("d3d11ShaderFactory: compute shaders not supported, can't create '%s'\n", setup.Locator.Location().AsCStr());
+        return ResourceState::Failed;
+    }
 
     // create vertex shader
     const void* vsPtr = nullptr;
@@ -917,6 +917,63 @@ d3d12Renderer::drawInstanced(int primGroupIndex, int numInstances) {
     this->drawInstanced(primGroup, numInstances);
 }
 
+//------------------------------------------------------------------------------
+void
+d3d12Renderer::applyComputeState(shader* shd, mesh** storageBuffers, int numStorageBuffers) {
+    // compute shaders are not supported on D3D12, the shader factory
+    // fails to create compute programs, so shd is always nullptr here
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr == shd);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d12Renderer::dispatch(int numGroupsX, int numGroupsY, int numGroupsZ) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d12Renderer::barrier(BarrierBits::Mask bits) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d12Renderer::beginQuery(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d12Renderer::endQuery(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d12Renderer::beginConditionalRender(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d12Renderer::endConditionalRender() {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d12Renderer::publishQueryResults() {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+d3d12Renderer::discardQuery(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
 //------------------------------------------------------------------------------
 static int
 obtainUpdateBufferSlotIndex(mesh::buffer& buf, uint64_t frameIndex) {
@@ -44,6 +44,10 @@ d3d12ShaderFactory::SetupResource(shader& shd) {
 
     const ShaderLang::Code slang = ShaderLang::HLSL5;
     const ShaderSetup& setup = shd.Setup;
+    if (setup.IsComputeProgram()) {
+        o_warn("d3d12ShaderFactory: compute shaders not supported, can't create '%s'\n", setup.Locator.Location().AsCStr());
+        return ResourceState::Failed;
+    }
     setup.VertexShaderByteCode(slang, shd.vertexShader.ptr, shd.vertexShader.size);
     setup.FragmentShaderByteCode(slang, shd.pixelShader.ptr, shd.pixelShader.size);
     o_assert_dbg(shd.vertexShader.ptr && (shd.vertexShader.size > 0));
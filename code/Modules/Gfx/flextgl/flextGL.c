@@ -34,10 +34,22 @@ int flextInit(GLFWwindow* window)
 
     /* --- Check for extensions --- */
 
+    if (glfwExtensionSupported("GL_ARB_compute_shader")) {
+        FLEXT_ARB_compute_shader = GL_TRUE;
+    }
+
     if (glfwExtensionSupported("GL_ARB_debug_output")) {
         FLEXT_ARB_debug_output = GL_TRUE;
     }
 
+    if (glfwExtensionSupported("GL_ARB_shader_image_load_store")) {
+        FLEXT_ARB_shader_image_load_store = GL_TRUE;
+    }
+
+    if (glfwExtensionSupported("GL_ARB_shader_storage_buffer_object")) {
+        FLEXT_ARB_shader_storage_buffer_object = GL_TRUE;
+    }
+
 
     return GL_TRUE;
 }
@@ -49,6 +61,12 @@ void flextLoadOpenGLFunctions(void)
     /* --- Function pointer loading --- */
 
 
+    /* GL_ARB_compute_shader */
+
+    glpfDispatchCompute = (PFNGLDISPATCHCOMPUTE_PROC*)glfwGetProcAddress("glDispatchCompute");
+    glpfDispatchComputeIndirect = (PFNGLDISPATCHCOMPUTEINDIRECT_PROC*)glfwGetProcAddress("glDispatchComputeIndirect");
+
+
     /* GL_ARB_debug_output */
 
     glpfDebugMessageCallbackARB = (PFNGLDEBUGMESSAGECALLBACKARB_PROC*)glfwGetProcAddress("glDebugMessageCallbackARB");
@@ -57,6 +75,17 @@ void flextLoadOpenGLFunctions(void)
     glpfGetDebugMessageLogARB = (PFNGLGETDEBUGMESSAGELOGARB_PROC*)glfwGetProcAddress("glGetDebugMessageLogARB");
 
 
+    /* GL_ARB_shader_image_load_store */
+
+    glpfBindImageTexture = (PFNGLBINDIMAGETEXTURE_PROC*)glfwGetProcAddress("glBindImageTexture");
+    glpfMemoryBarrier = (PFNGLMEMORYBARRIER_PROC*)glfwGetProcAddress("glMemoryBarrier");
+
+
+    /* GL_ARB_shader_storage_buffer_object */
+
+    glpfShaderStorageBlockBinding = (PFNGLSHADERSTORAGEBLOCKBINDING_PROC*)glfwGetProcAddress("glShaderStorageBlockBinding");
+
+
     /* GL_VERSION_1_2 */
 
     glpfCopyTexSubImage3D = (PFNGLCOPYTEXSUBIMAGE3D_PROC*)glfwGetProcAddress("glCopyTexSubImage3D");
@@ -383,10 +412,18 @@ void flextLoadOpenGLFunctions(void)
 }
 
 /* ----------------------- Extension flag definitions ---------------------- */
+int FLEXT_ARB_compute_shader = GL_FALSE;
 int FLEXT_ARB_debug_output = GL_FALSE;
+int FLEXT_ARB_shader_image_load_store = GL_FALSE;
+int FLEXT_ARB_shader_storage_buffer_object = GL_FALSE;
 
 /* ---------------------- Function pointer definitions --------------------- */
 
+/* GL_ARB_compute_shader */
+
+PFNGLDISPATCHCOMPUTE_PROC* glpfDispatchCompute = NULL;
+PFNGLDISPATCHCOMPUTEINDIRECT_PROC* glpfDispatchComputeIndirect = NULL;
+
 /* GL_ARB_debug_output */
 
 PFNGLDEBUGMESSAGECALLBACKARB_PROC* glpfDebugMessageCallbackARB = NULL;
@@ -394,6 +431,15 @@ PFNGLDEBUGMESSAGECONTROLARB_PROC* glpfDebugMessageControlARB = NULL;
 PFNGLDEBUGMESSAGEINSERTARB_PROC* glpfDebugMessageInsertARB = NULL;
 PFNGLGETDEBUGMESSAGELOGARB_PROC* glpfGetDebugMessageLogARB = NULL;
 
+/* GL_ARB_shader_image_load_store */
+
+PFNGLBINDIMAGETEXTURE_PROC* glpfBindImageTexture = NULL;
+PFNGLMEMORYBARRIER_PROC* glpfMemoryBarrier = NULL;
+
+/* GL_ARB_shader_storage_buffer_object */
+
+PFNGLSHADERSTORAGEBLOCKBINDING_PROC* glpfShaderStorageBlockBinding = NULL;
+
 /* GL_VERSION_1_2 */
 
 PFNGLCOPYTEXSUBIMAGE3D_PROC* glpfCopyTexSubImage3D = NULL;
@@ -70,6 +70,19 @@ glCaps::setupFeatures() {
         state.features[TextureCompressionDXT] = true;
         state.features[InstancedArrays] = true;
         state.features[TextureFloat] = true;
+        state.features[DrawBaseVertex] = true;
+        state.features[CopyBuffer] = true;
+        state.features[TextureArray] = true;
+        state.features[OcclusionQuery] = true;
+        state.features[ConditionalRender] = true;
+        #if defined(GL_ARB_compute_shader)
+        // compute shaders are core in GL 4.3, the extension flags are
+        // also set by GL 4.3 drivers, storage buffers and glMemoryBarrier
+        // come from separate extensions
+        state.features[ComputeShader] = FLEXT_ARB_compute_shader &&
+                                        FLEXT_ARB_shader_storage_buffer_object &&
+                                        FLEXT_ARB_shader_image_load_store;
+        #endif
     #else
         state.features[TextureCompressionDXT] = strBuilder.Contains("_texture_compression_s3tc") ||
                                                 strBuilder.Contains("_compressed_texture_s3tc") ||
@@ -81,6 +94,9 @@ glCaps::setupFeatures() {
         state.features[TextureFloat] = strBuilder.Contains("_texture_float");
         state.features[InstancedArrays] = strBuilder.Contains("_instanced_arrays");
         state.features[DebugOutput] = strBuilder.Contains("_debug_output");
+        #if !ORYOL_OPENGLES2
+        state.features[TextureArray] = strBuilder.Contains("_texture_array");
+        #endif
     #endif
     
     #if ORYOL_OPENGLES2
@@ -92,6 +108,10 @@ glCaps::setupFeatures() {
     #if ORYOL_OPENGLES3
         state.features[InstancedArrays] = true;
         state.features[TextureCompressionETC2] = true;
+        state.features[CopyBuffer] = true;
+        state.features[TextureArray] = true;
+        // GLES3 only has boolean occlusion queries, and no conditional rendering
+        state.features[OcclusionQuery] = true;
     #endif
     if (!state.features[InstancedArrays]) {
         o_warn("glCaps::Setup(): instanced_arrays extension not found!\n");
@@ -174,6 +194,98 @@ glCaps::DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const voi
     }
 }
 
+//------------------------------------------------------------------------------
+void
+glCaps::DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint baseVertex) {
+    o_assert_dbg(state.features[DrawBaseVertex]);
+    #if ORYOL_OPENGL_CORE_PROFILE
+    ::glDrawElementsBaseVertex(mode, count, type, indices, baseVertex);
+    #else
+    o_error("glCaps::DrawElementsBaseVertex() called!\n");
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glCaps::DrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount, GLint baseVertex) {
+    o_assert_dbg(state.features[DrawBaseVertex]);
+    #if ORYOL_OPENGL_CORE_PROFILE
+    ::glDrawElementsInstancedBaseVertex(mode, count, type, indices, primcount, baseVertex);
+    #else
+    o_error("glCaps::DrawElementsInstancedBaseVertex() called!\n");
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glCaps::CopyBufferSubData(GLuint srcBuffer, GLuint dstBuffer, GLintptr srcOffset, GLintptr dstOffset, GLsizeiptr size) {
+    o_assert_dbg(state.features[CopyBuffer]);
+    #if ORYOL_OPENGL_CORE_PROFILE || ORYOL_OPENGLES3
+    ::glBindBuffer(GL_COPY_READ_BUFFER, srcBuffer);
+    ::glBindBuffer(GL_COPY_WRITE_BUFFER, dstBuffer);
+    ::glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcOffset, dstOffset, size);
+    ::glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    ::glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    #else
+    o_error("glCaps::CopyBufferSubData() called!\n");
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glCaps::DispatchCompute(GLuint numGroupsX, GLuint numGroupsY, GLuint numGroupsZ) {
+    o_assert_dbg(state.features[ComputeShader]);
+    #if ORYOL_OPENGL_CORE_PROFILE && defined(GL_ARB_compute_shader)
+    ::glDispatchCompute(numGroupsX, numGroupsY, numGroupsZ);
+    #else
+    o_error("glCaps::DispatchCompute() called!\n");
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glCaps::Barrier(GLbitfield barriers) {
+    o_assert_dbg(state.features[ComputeShader]);
+    #if ORYOL_OPENGL_CORE_PROFILE && defined(GL_ARB_shader_image_load_store)
+    ::glMemoryBarrier(barriers);
+    #else
+    o_error("glCaps::Barrier() called!\n");
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glCaps::BindStorageBuffer(GLuint index, GLuint buffer) {
+    o_assert_dbg(state.features[ComputeShader]);
+    #if ORYOL_OPENGL_CORE_PROFILE && defined(GL_ARB_shader_storage_buffer_object)
+    ::glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, buffer);
+    #else
+    o_error("glCaps::BindStorageBuffer() called!\n");
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glCaps::BeginConditionalRender(GLuint query, GLenum mode) {
+    o_assert_dbg(state.features[ConditionalRender]);
+    #if ORYOL_OPENGL_CORE_PROFILE
+    ::glBeginConditionalRender(query, mode);
+    #else
+    o_error("glCaps::BeginConditionalRender() called!\n");
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glCaps::EndConditionalRender() {
+    o_assert_dbg(state.features[ConditionalRender]);
+    #if ORYOL_OPENGL_CORE_PROFILE
+    ::glEndConditionalRender();
+    #else
+    o_error("glCaps::EndConditionalRender() called!\n");
+    #endif
+}
+
 //------------------------------------------------------------------------------
 void
 glCaps::printInfo() {
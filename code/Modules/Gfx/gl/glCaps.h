@@ -38,6 +38,12 @@ public:
         TextureHalfFloat,
         InstancedArrays,
         DebugOutput,
+        DrawBaseVertex,
+        CopyBuffer,
+        TextureArray,
+        ComputeShader,
+        OcclusionQuery,
+        ConditionalRender,
 
         NumFeatures,
     };
@@ -75,6 +81,22 @@ public:
     static void DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei primcount);
     /// wrapper function for glDrawElementsInstanced
     static void DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount);
+    /// wrapper function for glDrawElementsBaseVertex
+    static void DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint baseVertex);
+    /// wrapper function for glDrawElementsInstancedBaseVertex
+    static void DrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount, GLint baseVertex);
+    /// wrapper function for glCopyBufferSubData (binds to GL_COPY_READ/WRITE_BUFFER)
+    static void CopyBufferSubData(GLuint srcBuffer, GLuint dstBuffer, GLintptr srcOffset, GLintptr dstOffset, GLsizeiptr size);
+    /// wrapper function for glDispatchCompute
+    static void DispatchCompute(GLuint numGroupsX, GLuint numGroupsY, GLuint numGroupsZ);
+    /// wrapper function for glMemoryBarrier (MemoryBarrier is a macro on Windows)
+    static void Barrier(GLbitfield barriers);
+    /// wrapper function for glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ...)
+    static void BindStorageBuffer(GLuint index, GLuint buffer);
+    /// wrapper function for glBeginConditionalRender
+    static void BeginConditionalRender(GLuint query, GLenum mode);
+    /// wrapper function for glEndConditionalRender
+    static void EndConditionalRender();
 
 private:
     /// setup the limit values
@@ -8,6 +8,7 @@
 #include "Gfx/gl/gl_impl.h"
 #include "Gfx/Core/renderer.h"
 #include "Gfx/gl/glTypes.h"
+#include "Gfx/gl/glCaps.h"
 #include "Resource/ResourceState.h"
 
 namespace Oryol {
@@ -36,6 +37,16 @@ glMeshFactory::Setup(const gfxPointers& ptrs) {
 void
 glMeshFactory::Discard() {
     o_assert_dbg(this->isValid);
+    for (auto& a : this->arenas) {
+        if (a.allocator.IsValid()) {
+            o_assert_dbg(0 == a.allocator.NumAllocs());
+            a.allocator.Discard();
+        }
+        if (0 != a.glBuffer) {
+            ::glDeleteBuffers(1, &a.glBuffer);
+        }
+        a = arena();
+    }
     this->pointers = gfxPointers();
     this->isValid = false;
 }
@@ -46,6 +57,24 @@ glMeshFactory::IsValid() const {
     return this->isValid;
 }
 
+//------------------------------------------------------------------------------
+/**
+ Immutable meshes created from data are sub-allocated from a big shared
+ vertex and index buffer, the GL buffers are created lazily on first use.
+*/
+void
+glMeshFactory::SetupArenas(int vertexBufferSize, int indexBufferSize) {
+    o_assert_dbg(this->isValid);
+    o_assert_dbg((vertexBufferSize >= 0) && (indexBufferSize >= 0));
+    this->arenas[mesh::vb].size = vertexBufferSize;
+    this->arenas[mesh::ib].size = indexBufferSize;
+    for (auto& a : this->arenas) {
+        if (a.size > 0) {
+            a.allocator.Setup(a.size);
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 ResourceState::Code
 glMeshFactory::SetupResource(mesh& msh) {
@@ -73,7 +102,13 @@ glMeshFactory::SetupResource(mesh& msh, const void* data, int size) {
 void
 glMeshFactory::DestroyResource(mesh& mesh) {
     this->pointers.renderer->invalidateMeshState();
-    for (auto& buf : mesh.buffers) {
+    for (int bufType = 0; bufType < 2; bufType++) {
+        auto& buf = mesh.buffers[bufType];
+        if (InvalidIndex != buf.arenaAllocId) {
+            // shared buffer, only release the range
+            this->arenas[bufType].allocator.Free(buf.arenaAllocId);
+            continue;
+        }
         for (int i = 0; i < buf.numSlots; i++) {
             GLuint glBuf = buf.glBuffers[i];
             if  (0 != glBuf) {
@@ -84,6 +119,98 @@ glMeshFactory::DestroyResource(mesh& mesh) {
     mesh.Clear();
 }
 
+//------------------------------------------------------------------------------
+bool
+glMeshFactory::allocFromArena(mesh& msh, int bufType, const void* data, int size, int align) {
+    arena& a = this->arenas[bufType];
+    if (!a.allocator.IsValid()) {
+        return false;
+    }
+    int id = a.allocator.Alloc(size, align, &msh);
+    if ((InvalidIndex == id) &&
+        glCaps::HasFeature(glCaps::CopyBuffer) &&
+        a.allocator.FitsAfterDefragment(size, align)) {
+        this->defragmentArena(bufType);
+        id = a.allocator.Alloc(size, align, &msh);
+    }
+    if (InvalidIndex == id) {
+        // arena exhausted, caller falls back to a standalone buffer
+        return false;
+    }
+    const int offset = a.allocator.Offset(id);
+    if (mesh::vb == bufType) {
+        if (0 == a.glBuffer) {
+            a.glBuffer = this->createVertexBuffer(nullptr, a.size, Usage::Immutable);
+        }
+        this->pointers.renderer->bindVertexBuffer(a.glBuffer);
+        ::glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+    }
+    else {
+        if (0 == a.glBuffer) {
+            a.glBuffer = this->createIndexBuffer(nullptr, a.size, Usage::Immutable);
+        }
+        this->pointers.renderer->bindIndexBuffer(a.glBuffer);
+        ::glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, data);
+    }
+    ORYOL_GL_CHECK_ERROR();
+    this->pointers.renderer->invalidateMeshState();
+
+    auto& buf = msh.buffers[bufType];
+    buf.numSlots = 1;
+    buf.glBuffers[0] = a.glBuffer;
+    buf.arenaAllocId = id;
+    buf.arenaOffset = offset;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Copies all live ranges of an arena compacted into a new GL buffer, and
+ patches the meshes living in the arena. Adjacent ranges are copied
+ with a single glCopyBufferSubData.
+*/
+void
+glMeshFactory::defragmentArena(int bufType) {
+    arena& a = this->arenas[bufType];
+    o_assert_dbg(0 != a.glBuffer);
+    a.allocator.Defragment(this->moves);
+    GLuint newBuffer = 0;
+    if (mesh::vb == bufType) {
+        newBuffer = this->createVertexBuffer(nullptr, a.size, Usage::Immutable);
+    }
+    else {
+        newBuffer = this->createIndexBuffer(nullptr, a.size, Usage::Immutable);
+    }
+    int runSrc = 0, runDst = 0, runSize = 0;
+    for (const auto& m : this->moves) {
+        if ((runSize > 0) && ((runSrc + runSize) == m.srcOffset) && ((runDst + runSize) == m.dstOffset)) {
+            runSize += m.size;
+        }
+        else {
+            if (runSize > 0) {
+                glCaps::CopyBufferSubData(a.glBuffer, newBuffer, runSrc, runDst, runSize);
+            }
+            runSrc = m.srcOffset;
+            runDst = m.dstOffset;
+            runSize = m.size;
+        }
+        mesh* msh = (mesh*) a.allocator.UserData(m.id);
+        auto& buf = msh->buffers[bufType];
+        buf.glBuffers[0] = newBuffer;
+        buf.arenaOffset = m.dstOffset;
+        if (mesh::vb == bufType) {
+            msh->baseVertex = m.dstOffset / msh->vertexBufferAttrs.Layout.ByteSize();
+        }
+    }
+    if (runSize > 0) {
+        glCaps::CopyBufferSubData(a.glBuffer, newBuffer, runSrc, runDst, runSize);
+    }
+    ORYOL_GL_CHECK_ERROR();
+    ::glDeleteBuffers(1, &a.glBuffer);
+    a.glBuffer = newBuffer;
+    this->pointers.renderer->invalidateMeshState();
+}
+
 //------------------------------------------------------------------------------
 /**
  NOTE: this method can be called with a nullptr for vertexData, in this case
@@ -259,9 +386,18 @@ glMeshFactory::createFromData(mesh& mesh, const void* data, int size) {
             vertices = ptr + mesh.Setup.DataVertexOffset;
             o_assert_dbg((ptr + size) >= (vertices + vbSize));
         }
-        for (uint8_t slotIndex = 0; slotIndex < mesh.buffers[mesh::vb].numSlots; slotIndex++) {
-            mesh.buffers[mesh::vb].glBuffers[slotIndex] = this->createVertexBuffer(vertices, vbSize, vbAttrs.BufferUsage);
-            o_assert_dbg(0 != mesh.buffers[mesh::vb].glBuffers[slotIndex]);
+        // immutable vertex data goes into the shared vertex arena if possible,
+        // aligned to the vertex stride so that it can be drawn with base vertex
+        const int stride = vbAttrs.Layout.ByteSize();
+        if (vertices && (Usage::Immutable == vbAttrs.BufferUsage) &&
+            this->allocFromArena(mesh, mesh::vb, vertices, vbSize, stride)) {
+            mesh.baseVertex = mesh.buffers[mesh::vb].arenaOffset / stride;
+        }
+        else {
+            for (uint8_t slotIndex = 0; slotIndex < mesh.buffers[mesh::vb].numSlots; slotIndex++) {
+                mesh.buffers[mesh::vb].glBuffers[slotIndex] = this->createVertexBuffer(vertices, vbSize, vbAttrs.BufferUsage);
+                o_assert_dbg(0 != mesh.buffers[mesh::vb].glBuffers[slotIndex]);
+            }
         }
     }
 
@@ -274,9 +410,13 @@ glMeshFactory::createFromData(mesh& mesh, const void* data, int size) {
             indices = ptr + mesh.Setup.DataIndexOffset;
             o_assert_dbg((ptr + size) >= (indices + ibSize));
         }
-        for (uint8_t slotIndex = 0; slotIndex < mesh.buffers[mesh::ib].numSlots; slotIndex++) {
-            mesh.buffers[mesh::ib].glBuffers[slotIndex] = this->createIndexBuffer(indices, ibSize, ibAttrs.BufferUsage);
-            o_assert_dbg(0 != mesh.buffers[mesh::ib].glBuffers[slotIndex]);
+        const bool inArena = indices && (Usage::Immutable == ibAttrs.BufferUsage) &&
+            this->allocFromArena(mesh, mesh::ib, indices, ibSize, IndexType::ByteSize(ibAttrs.Type));
+        if (!inArena) {
+            for (uint8_t slotIndex = 0; slotIndex < mesh.buffers[mesh::ib].numSlots; slotIndex++) {
+                mesh.buffers[mesh::ib].glBuffers[slotIndex] = this->createIndexBuffer(indices, ibSize, ibAttrs.BufferUsage);
+                o_assert_dbg(0 != mesh.buffers[mesh::ib].glBuffers[slotIndex]);
+            }
         }
     }
     
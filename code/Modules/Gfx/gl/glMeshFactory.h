@@ -9,6 +9,7 @@
 #include "Gfx/gl/gl_decl.h"
 #include "Gfx/Core/Enums.h"
 #include "Gfx/Core/gfxPointers.h"
+#include "Gfx/Resource/rangeAllocator.h"
 
 namespace Oryol {
 namespace _priv {
@@ -28,6 +29,8 @@ public:
     void Discard();
     /// return true if the object has been setup
     bool IsValid() const;
+    /// setup shared vertex/index buffers for immutable meshes (0 size disables)
+    void SetupArenas(int vertexBufferSize, int indexBufferSize);
 
     /// setup resource
     ResourceState::Code SetupResource(mesh& mesh);
@@ -52,9 +55,22 @@ private:
     GLuint createVertexBuffer(const void* vertexData, uint32_t vertexDataSize, Usage::Code usage);
     /// helper method to create index buffer in mesh
     GLuint createIndexBuffer(const void* indexData, uint32_t indexDataSize, Usage::Code usage);
+    /// try to place immutable vertex or index data in a shared buffer arena
+    bool allocFromArena(mesh& msh, int bufType, const void* data, int size, int align);
+    /// compact a shared buffer arena into a new GL buffer
+    void defragmentArena(int bufType);
 
     gfxPointers pointers;
     bool isValid;
+
+    /// a shared GL buffer which immutable meshes are sub-allocated from
+    struct arena {
+        int size = 0;
+        GLuint glBuffer = 0;
+        rangeAllocator allocator;
+    };
+    arena arenas[2];    // mesh::vb and mesh::ib
+    Array<rangeAllocator::move> moves;
 };
     
 } // namespace _priv
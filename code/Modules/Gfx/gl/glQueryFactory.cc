@@ -0,0 +1,59 @@
+//------------------------------------------------------------------------------
+//  glQueryFactory.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "glQueryFactory.h"
+#include "Core/Assertion.h"
+#include "Core/Log.h"
+#include "Gfx/gl/gl_impl.h"
+#include "Gfx/gl/glCaps.h"
+#include "Gfx/Resource/resource.h"
+#include "Gfx/Core/renderer.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+glQueryFactory::SetupResource(query& qry) {
+    o_assert_dbg(this->isValid);
+    o_assert_dbg(0 == qry.glQueries[0]);
+
+    #if ORYOL_OPENGL_CORE_PROFILE || ORYOL_OPENGLES3
+    if (!glCaps::HasFeature(glCaps::OcclusionQuery)) {
+        o_warn("glQueryFactory: occlusion queries not supported!\n");
+        return ResourceState::Failed;
+    }
+    o_assert_range_dbg(qry.Setup.Type, QueryType::NumQueryTypes);
+    #if ORYOL_OPENGLES3
+    // GLES3 only has boolean occlusion queries, the sample
+    // count is 1 if any samples passed
+    qry.glTarget = GL_ANY_SAMPLES_PASSED;
+    #else
+    qry.glTarget = (QueryType::SamplesPassed == qry.Setup.Type) ? GL_SAMPLES_PASSED : GL_ANY_SAMPLES_PASSED;
+    #endif
+    ::glGenQueries(query::NumSlots, &qry.glQueries[0]);
+    ORYOL_GL_CHECK_ERROR();
+    return ResourceState::Valid;
+    #else
+    o_warn("glQueryFactory: occlusion queries not supported!\n");
+    return ResourceState::Failed;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glQueryFactory::DestroyResource(query& qry) {
+    o_assert_dbg(this->isValid);
+    this->pointers.renderer->discardQuery(&qry);
+    #if ORYOL_OPENGL_CORE_PROFILE || ORYOL_OPENGLES3
+    if (0 != qry.glQueries[0]) {
+        ::glDeleteQueries(query::NumSlots, &qry.glQueries[0]);
+        ORYOL_GL_CHECK_ERROR();
+    }
+    #endif
+    qry.Clear();
+}
+
+} // namespace _priv
+} // namespace Oryol
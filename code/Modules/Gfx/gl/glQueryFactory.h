@@ -0,0 +1,22 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::glQueryFactory
+    @ingroup _priv
+    @brief GL implementation of queryFactory
+*/
+#include "Gfx/Resource/queryFactoryBase.h"
+
+namespace Oryol {
+namespace _priv {
+
+class glQueryFactory : public queryFactoryBase {
+public:
+    /// setup query resource
+    ResourceState::Code SetupResource(query& qry);
+    /// destroy the query
+    void DestroyResource(query& qry);
+};
+
+} // namespace _priv
+} // namespace Oryol
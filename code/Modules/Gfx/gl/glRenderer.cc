@@ -83,7 +83,11 @@ rtValid(false),
 frameIndex(0),
 curRenderTarget(nullptr),
 curPipeline(nullptr),
+curComputeShader(nullptr),
 curPrimaryMesh(nullptr),
+curBaseVertex(0),
+curQuery(nullptr),
+inConditionalRender(false),
 scissorX(0),
 scissorY(0),
 scissorWidth(0),
@@ -99,6 +103,7 @@ program(0) {
     for (int i = 0; i < MaxTextureSamplers; i++) {
         this->samplers2D[i] = 0;
         this->samplersCube[i] = 0;
+        this->samplers2DArray[i] = 0;
     }
     for (int i = 0; i < VertexAttr::NumVertexAttrs; i++) {
         this->glAttrVBs[i] = 0;
@@ -145,6 +150,11 @@ glRenderer::discard() {
     this->invalidateTextureState();
     this->curRenderTarget = nullptr;
     this->curPipeline = nullptr;
+    this->curComputeShader = nullptr;
+    this->curQuery = nullptr;
+    this->inConditionalRender = false;
+    this->pendingQueries.Clear();
+    this->polledQueries.Clear();
 
     #if !ORYOL_OPENGLES2
     ::glDeleteVertexArrays(1, &this->globalVAO);
@@ -196,6 +206,12 @@ glRenderer::queryFeature(GfxFeature::Code feat) const {
             return glCaps::HasFeature(glCaps::InstancedArrays);
         case GfxFeature::OriginBottomLeft:
             return true;
+        case GfxFeature::ComputeShaders:
+            return glCaps::HasFeature(glCaps::ComputeShader);
+        case GfxFeature::OcclusionQuery:
+            return glCaps::HasFeature(glCaps::OcclusionQuery);
+        case GfxFeature::ConditionalRender:
+            return glCaps::HasFeature(glCaps::ConditionalRender);
         default:
             return false;
     }
@@ -205,10 +221,15 @@ glRenderer::queryFeature(GfxFeature::Code feat) const {
 void
 glRenderer::commitFrame() {
     o_assert_dbg(this->valid);    
+    o_assert2_dbg(nullptr == this->curQuery, "Query still active at end of frame!\n");
+    o_assert2_dbg(!this->inConditionalRender, "Conditional render still active at end of frame!\n");
+    this->pollQueries();
     this->rtValid = false;
     this->curRenderTarget = nullptr;
     this->curPipeline = nullptr;
+    this->curComputeShader = nullptr;
     this->curPrimaryMesh = nullptr;
+    this->curBaseVertex = 0;
     this->frameIndex++;
 }
 
@@ -357,14 +378,26 @@ glRenderer::applyMeshes(pipeline* pip, mesh** meshes, int numMeshes) {
     // this is the default vertex attribute code path for most desktop and mobile platforms
     const auto& ib = this->curPrimaryMesh->buffers[mesh::ib];
     this->bindIndexBuffer(ib.glBuffers[ib.activeSlot]); // can be 0 if mesh has no index buffer
+
+    // meshes in the shared vertex arena: per-vertex attributes of the
+    // primary mesh are offset with the base vertex in the draw call,
+    // so that switching between arena meshes with the same vertex layout
+    // doesn't touch the vertex attributes at all, all other attributes
+    // (or all attributes without base vertex support) are offset
+    // through the attribute pointer
+    const bool useBaseVertex = glCaps::HasFeature(glCaps::DrawBaseVertex);
+    this->curBaseVertex = useBaseVertex ? this->curPrimaryMesh->baseVertex : 0;
     for (int attrIndex = 0; attrIndex < VertexAttr::NumVertexAttrs; attrIndex++) {
-        const glVertexAttr& attr = pip->glAttrs[attrIndex];
+        glVertexAttr attr = pip->glAttrs[attrIndex];
         o_assert_dbg(attr.vbIndex < numMeshes);
         glVertexAttr& curAttr = this->glAttrs[attrIndex];
         const mesh* msh = meshes[attr.vbIndex];
         o_assert_dbg(msh);
         const auto& vb = msh->buffers[mesh::vb];
         const GLuint glVB = vb.glBuffers[vb.activeSlot];
+        if (!useBaseVertex || (0 != attr.vbIndex) || (0 != attr.divisor)) {
+            attr.offset += vb.arenaOffset;
+        }
 
         bool vbChanged = (glVB != this->glAttrVBs[attrIndex]);
         bool attrChanged = (attr != curAttr);
@@ -398,6 +431,7 @@ glRenderer::applyMeshes(pipeline* pip, mesh** meshes, int numMeshes) {
     // FIXME: currently this doesn't use state-caching
     const auto& ib = this->curPrimaryMesh->buffers[mesh::ib];
     this->bindIndexBuffer(ib.glBuffers[ib.activeSlot]);    // can be 0
+    this->curBaseVertex = 0;
     int maxUsedAttrib = 0;
     for (int attrIndex = 0; attrIndex < VertexAttr::NumVertexAttrs; attrIndex++) {
         const glVertexAttr& attr = pip->glAttrs[attrIndex];
@@ -408,7 +442,8 @@ glRenderer::applyMeshes(pipeline* pip, mesh** meshes, int numMeshes) {
             const auto& vb = msh->buffers[mesh::vb];
             const GLuint glVB = vb.glBuffers[vb.activeSlot];
             this->bindVertexBuffer(glVB);
-            ::glVertexAttribPointer(glAttribIndex, attr.size, attr.type, attr.normalized, attr.stride, (const GLvoid*)(GLintptr)attr.offset);
+            const GLintptr offset = attr.offset + vb.arenaOffset;
+            ::glVertexAttribPointer(glAttribIndex, attr.size, attr.type, attr.normalized, attr.stride, (const GLvoid*)offset);
             ORYOL_GL_CHECK_ERROR();
             ::glEnableVertexAttribArray(glAttribIndex);
             ORYOL_GL_CHECK_ERROR();
@@ -444,8 +479,10 @@ glRenderer::applyDrawState(pipeline* pip, mesh** meshes, int numMeshes) {
         }
     }
 
-    // draw state is valid, ready for rendering
+    // draw state is valid, ready for rendering, this
+    // replaces a previously applied compute state
     this->curPipeline = pip;
+    this->curComputeShader = nullptr;
     o_assert_dbg(pip->shd);
 
     const PipelineSetup& setup = pip->Setup;
@@ -485,13 +522,19 @@ glRenderer::draw(const PrimitiveGroup& primGroup) {
     if (IndexType::None != indexType) {
         // indexed geometry
         const int indexByteSize = IndexType::ByteSize(indexType);
-        const GLvoid* indices = (const GLvoid*) (GLintptr) (primGroup.BaseElement * indexByteSize);
+        const int ibOffset = msh->buffers[mesh::ib].arenaOffset;
+        const GLvoid* indices = (const GLvoid*) (GLintptr) (ibOffset + primGroup.BaseElement * indexByteSize);
         const GLenum glIndexType = glTypes::asGLIndexType(indexType);
-        ::glDrawElements(glPrimType, primGroup.NumElements, glIndexType, indices);
+        if (0 != this->curBaseVertex) {
+            glCaps::DrawElementsBaseVertex(glPrimType, primGroup.NumElements, glIndexType, indices, this->curBaseVertex);
+        }
+        else {
+            ::glDrawElements(glPrimType, primGroup.NumElements, glIndexType, indices);
+        }
     }
     else {
         // non-indexed geometry
-        ::glDrawArrays(glPrimType, primGroup.BaseElement, primGroup.NumElements);
+        ::glDrawArrays(glPrimType, this->curBaseVertex + primGroup.BaseElement, primGroup.NumElements);
     }
     ORYOL_GL_CHECK_ERROR();
 }
@@ -532,13 +575,19 @@ glRenderer::drawInstanced(const PrimitiveGroup& primGroup, int numInstances) {
     if (IndexType::None != indexType) {
         // indexed geometry
         const int indexByteSize = IndexType::ByteSize(indexType);
-        const GLvoid* indices = (const GLvoid*) (GLintptr) (primGroup.BaseElement * indexByteSize);
+        const int ibOffset = msh->buffers[mesh::ib].arenaOffset;
+        const GLvoid* indices = (const GLvoid*) (GLintptr) (ibOffset + primGroup.BaseElement * indexByteSize);
         const GLenum glIndexType = glTypes::asGLIndexType(indexType);
-        glCaps::DrawElementsInstanced(glPrimType, primGroup.NumElements, glIndexType, indices, numInstances);
+        if (0 != this->curBaseVertex) {
+            glCaps::DrawElementsInstancedBaseVertex(glPrimType, primGroup.NumElements, glIndexType, indices, numInstances, this->curBaseVertex);
+        }
+        else {
+            glCaps::DrawElementsInstanced(glPrimType, primGroup.NumElements, glIndexType, indices, numInstances);
+        }
     }
     else {
         // non-indexed geometry
-        glCaps::DrawArraysInstanced(glPrimType, primGroup.BaseElement, primGroup.NumElements, numInstances);
+        glCaps::DrawArraysInstanced(glPrimType, this->curBaseVertex + primGroup.BaseElement, primGroup.NumElements, numInstances);
     }
     ORYOL_GL_CHECK_ERROR();
 }
@@ -563,6 +612,215 @@ glRenderer::drawInstanced(int primGroupIndex, int numInstances) {
     this->drawInstanced(primGroup, numInstances);
 }
 
+//------------------------------------------------------------------------------
+void
+glRenderer::applyComputeState(shader* shd, mesh** storageBuffers, int numStorageBuffers) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg((numStorageBuffers >= 0) && (numStorageBuffers <= GfxConfig::MaxNumStorageBuffers));
+
+    // a compute state replaces the current draw state
+    this->curPipeline = nullptr;
+
+    // if the shader or any of the storage buffers is still loading, cancel the next dispatches
+    this->curComputeShader = nullptr;
+    if (nullptr == shd) {
+        return;
+    }
+    for (int i = 0; i < numStorageBuffers; i++) {
+        if (nullptr == storageBuffers[i]) {
+            return;
+        }
+    }
+    o_assert_dbg(shd->Setup.IsComputeProgram());
+    this->curComputeShader = shd;
+    this->useProgram(shd->glProgram);
+
+    // the vertex buffers of the meshes are bound to the storage buffer binding points,
+    // for Stream meshes this is the buffer slot of the last vertex update
+    for (int i = 0; i < numStorageBuffers; i++) {
+        const auto& vb = storageBuffers[i]->buffers[mesh::vb];
+        o_assert_dbg(InvalidIndex == vb.arenaAllocId);
+        glCaps::BindStorageBuffer(i, vb.glBuffers[vb.activeSlot]);
+    }
+    ORYOL_GL_CHECK_ERROR();
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::dispatch(int numGroupsX, int numGroupsY, int numGroupsZ) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg((numGroupsX > 0) && (numGroupsY > 0) && (numGroupsZ > 0));
+    if (nullptr == this->curComputeShader) {
+        return;
+    }
+    glCaps::DispatchCompute(numGroupsX, numGroupsY, numGroupsZ);
+    ORYOL_GL_CHECK_ERROR();
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::barrier(BarrierBits::Mask bits) {
+    o_assert_dbg(this->valid);
+    const GLbitfield glBits = glTypes::asGLBarrierBits(bits);
+    if ((0 != glBits) && glCaps::HasFeature(glCaps::ComputeShader)) {
+        glCaps::Barrier(glBits);
+        ORYOL_GL_CHECK_ERROR();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::beginQuery(query* qry) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(qry);
+    o_assert2_dbg(nullptr == this->curQuery, "Only one query can be active at a time!\n");
+    #if ORYOL_OPENGL_CORE_PROFILE || ORYOL_OPENGLES3
+    // use the oldest GL query object, if its result hasn't been
+    // polled yet, try once more, and drop the result if it isn't
+    // there yet
+    const int slot = qry->isIssued ? ((qry->curSlot + 1) % query::NumSlots) : 0;
+    if (qry->slotFrameIndex[slot] >= 0) {
+        this->pollQuery(qry);
+        qry->slotFrameIndex[slot] = -1;
+    }
+    ::glBeginQuery(qry->glTarget, qry->glQueries[slot]);
+    ORYOL_GL_CHECK_ERROR();
+    qry->curSlot = slot;
+    qry->isIssued = true;
+    qry->isActive = true;
+    this->curQuery = qry;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::endQuery(query* qry) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(qry);
+    #if ORYOL_OPENGL_CORE_PROFILE || ORYOL_OPENGLES3
+    o_assert2_dbg(qry == this->curQuery, "endQuery(): query is not active!\n");
+    ::glEndQuery(qry->glTarget);
+    ORYOL_GL_CHECK_ERROR();
+    qry->slotFrameIndex[qry->curSlot] = this->frameIndex;
+    qry->isActive = false;
+    this->curQuery = nullptr;
+    if (!qry->isPending) {
+        qry->isPending = true;
+        this->pendingQueries.Add(qry);
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::beginConditionalRender(query* qry) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(qry);
+    o_assert2_dbg(!this->inConditionalRender, "Conditional render already active!\n");
+    o_assert2_dbg(!qry->isActive, "Query must be ended before conditional rendering!\n");
+    // if conditional rendering isn't supported, or the query has never
+    // been issued, rendering just happens unconditionally
+    if (qry->isIssued && glCaps::HasFeature(glCaps::ConditionalRender)) {
+        // the GPU waits for the result of the query (this doesn't stall
+        // the CPU), with NO_WAIT the draw calls would be rendered
+        // whenever the result isn't available yet, which is almost always
+        // the case if the query was issued right before
+        glCaps::BeginConditionalRender(qry->glQueries[qry->curSlot], GL_QUERY_BY_REGION_WAIT);
+        ORYOL_GL_CHECK_ERROR();
+        this->inConditionalRender = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::endConditionalRender() {
+    o_assert_dbg(this->valid);
+    if (this->inConditionalRender) {
+        glCaps::EndConditionalRender();
+        ORYOL_GL_CHECK_ERROR();
+        this->inConditionalRender = false;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::pollQuery(query* qry) {
+    #if ORYOL_OPENGL_CORE_PROFILE || ORYOL_OPENGLES3
+    // query results arrive in order, so stop at the first result
+    // which isn't available yet
+    for (int i = 1; i <= query::NumSlots; i++) {
+        const int slot = (qry->curSlot + i) % query::NumSlots;
+        const int slotFrameIndex = qry->slotFrameIndex[slot];
+        if (slotFrameIndex < 0) {
+            continue;
+        }
+        GLuint available = GL_FALSE;
+        ::glGetQueryObjectuiv(qry->glQueries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (GL_FALSE == available) {
+            break;
+        }
+        GLuint numSamples = 0;
+        ::glGetQueryObjectuiv(qry->glQueries[slot], GL_QUERY_RESULT, &numSamples);
+        ORYOL_GL_CHECK_ERROR();
+        qry->slotFrameIndex[slot] = -1;
+        if (slotFrameIndex > qry->polledFrameIndex) {
+            qry->polledNumSamples = numSamples;
+            qry->polledFrameIndex = slotFrameIndex;
+            if (!qry->isPolled) {
+                qry->isPolled = true;
+                this->polledQueries.Add(qry);
+            }
+        }
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::pollQueries() {
+    for (int i = this->pendingQueries.Size() - 1; i >= 0; i--) {
+        query* qry = this->pendingQueries[i];
+        this->pollQuery(qry);
+        bool stillPending = false;
+        for (int slotFrameIndex : qry->slotFrameIndex) {
+            if (slotFrameIndex >= 0) {
+                stillPending = true;
+                break;
+            }
+        }
+        if (!stillPending) {
+            qry->isPending = false;
+            this->pendingQueries.EraseSwap(i);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::publishQueryResults() {
+    for (query* qry : this->polledQueries) {
+        qry->numSamples = qry->polledNumSamples;
+        qry->resultFrameIndex = qry->polledFrameIndex;
+        qry->isPolled = false;
+    }
+    this->polledQueries.Clear();
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::discardQuery(query* qry) {
+    o_assert_dbg(qry);
+    o_assert2_dbg(qry != this->curQuery, "Query destroyed while active!\n");
+    if (qry->isPending) {
+        this->pendingQueries.EraseSwap(this->pendingQueries.FindIndexLinear(qry));
+        qry->isPending = false;
+    }
+    if (qry->isPolled) {
+        this->polledQueries.EraseSwap(this->polledQueries.FindIndexLinear(qry));
+        qry->isPolled = false;
+    }
+}
+
 //------------------------------------------------------------------------------
 static GLuint
 obtainUpdateBuffer(mesh::buffer& buf, int frameIndex) {
@@ -642,9 +900,9 @@ glRenderer::updateTexture(texture* tex, const void* data, const ImageDataAttrs&
     o_assert_dbg(nullptr != data);
     ORYOL_GL_CHECK_ERROR();
 
-    // only accept 2D textures for now
+    // only accept 2D and 2D array textures for now
     const TextureAttrs& attrs = tex->textureAttrs;
-    o_assert_dbg(TextureType::Texture2D == attrs.Type);
+    o_assert_dbg((TextureType::Texture2D == attrs.Type) || (TextureType::Texture2DArray == attrs.Type));
     o_assert_dbg(Usage::Immutable != attrs.TextureUsage);
     o_assert_dbg(!PixelFormat::IsCompressedFormat(attrs.ColorFormat));
     o_assert_dbg(offsetsAndSizes.NumMipMaps == attrs.NumMipMaps);
@@ -661,15 +919,26 @@ glRenderer::updateTexture(texture* tex, const void* data, const ImageDataAttrs&
         if (mipWidth == 0) mipWidth = 1;
         int mipHeight = attrs.Height >> mipIndex;
         if (mipHeight == 0) mipHeight = 1;
-        ::glTexSubImage2D(tex->glTarget,    // target
-                          mipIndex,         // level
-                          0,                // xoffset
-                          0,                // yoffset
-                          mipWidth,         // width
-                          mipHeight,        // height
-                          glTexImageFormat, // format
-                          glTexImageType,   // type
-                          srcPtr + offsetsAndSizes.Offsets[0][mipIndex]);
+        if (TextureType::Texture2DArray == attrs.Type) {
+            // all layers of a mipmap level are one block in the pixel data
+            o_assert_dbg(offsetsAndSizes.Sizes[0][mipIndex] >= attrs.Depth * mipWidth * mipHeight * PixelFormat::ByteSize(attrs.ColorFormat));
+            #if !ORYOL_OPENGLES2
+            ::glTexSubImage3D(tex->glTarget, mipIndex, 0, 0, 0, mipWidth, mipHeight, attrs.Depth,
+                              glTexImageFormat, glTexImageType,
+                              srcPtr + offsetsAndSizes.Offsets[0][mipIndex]);
+            #endif
+        }
+        else {
+            ::glTexSubImage2D(tex->glTarget,    // target
+                              mipIndex,         // level
+                              0,                // xoffset
+                              0,                // yoffset
+                              mipWidth,         // width
+                              mipHeight,        // height
+                              glTexImageFormat, // format
+                              glTexImageType,   // type
+                              srcPtr + offsetsAndSizes.Offsets[0][mipIndex]);
+        }
         ORYOL_GL_CHECK_ERROR();
     }
 }
@@ -773,6 +1042,7 @@ glRenderer::invalidateTextureState() {
     for (int i = 0; i < MaxTextureSamplers; i++) {
         this->samplers2D[i] = 0;
         this->samplersCube[i] = 0;
+        this->samplers2DArray[i] = 0;
     }
 }
     
@@ -781,9 +1051,17 @@ void
 glRenderer::bindTexture(int samplerIndex, GLenum target, GLuint tex) {
     o_assert_dbg(this->valid);
     o_assert_range_dbg(samplerIndex, MaxTextureSamplers);
-    o_assert_dbg((target == GL_TEXTURE_2D) || (target == GL_TEXTURE_CUBE_MAP));
-    
-    GLuint* samplers = (GL_TEXTURE_2D == target) ? this->samplers2D : this->samplersCube;
+    GLuint* samplers;
+    switch (target) {
+        case GL_TEXTURE_2D:         samplers = this->samplers2D; break;
+        case GL_TEXTURE_CUBE_MAP:   samplers = this->samplersCube; break;
+        #if !ORYOL_OPENGLES2
+        case GL_TEXTURE_2D_ARRAY:   samplers = this->samplers2DArray; break;
+        #endif
+        default:
+            o_error("glRenderer::bindTexture(): invalid texture target!\n");
+            return;
+    }
     if (tex != samplers[samplerIndex]) {
         samplers[samplerIndex] = tex;
         ::glActiveTexture(GL_TEXTURE0 + samplerIndex);
@@ -1046,14 +1324,20 @@ void
 glRenderer::applyUniformBlock(ShaderStage::Code bindStage, int bindSlot, int64_t layoutHash, const uint8_t* ptr, int byteSize) {
     o_assert_dbg(this->valid);
     o_assert_dbg(0 != layoutHash);
-    if (!this->curPipeline) {
-        // currently no valid draw state set
+
+    // get the uniform layout object for this uniform block, compute
+    // shader uniforms go to the shader of the current compute state
+    const shader* shd = nullptr;
+    if (ShaderStage::CS == bindStage) {
+        shd = this->curComputeShader;
+    }
+    else if (this->curPipeline) {
+        shd = this->curPipeline->shd;
+    }
+    if (nullptr == shd) {
+        // currently no valid draw or compute state set
         return;
     }
-
-    // get the uniform layout object for this uniform block
-    const shader* shd = this->curPipeline->shd;
-    o_assert_dbg(shd);
     int ubIndex = shd->Setup.UniformBlockIndexByStageAndSlot(bindStage, bindSlot);
     o_assert_dbg(InvalidIndex != ubIndex);
     const UniformBlockLayout& layout = shd->Setup.UniformBlockLayout(ubIndex);
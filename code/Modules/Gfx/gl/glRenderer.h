@@ -17,6 +17,7 @@
 #include "Gfx/Setup/GfxSetup.h"
 #include "Gfx/gl/gl_decl.h"
 #include "Gfx/gl/glVertexAttr.h"
+#include "Core/Containers/Array.h"
 #include "glm/vec4.hpp"
 
 namespace Oryol {
@@ -27,6 +28,7 @@ class pipeline;
 class mesh;
 class shader;
 class textureBlock;
+class query;
 
 class glRenderer {
 public:
@@ -71,6 +73,24 @@ public:
     void drawInstanced(int primGroupIndex, int numInstances);
     /// submit a draw call for instanced rendering with direct primitive group
     void drawInstanced(const PrimitiveGroup& primGroup, int numInstances);
+    /// apply compute state (compute shader and storage buffers)
+    void applyComputeState(shader* shd, mesh** storageBuffers, int numStorageBuffers);
+    /// submit a compute dispatch with the current compute state
+    void dispatch(int numGroupsX, int numGroupsY, int numGroupsZ);
+    /// wait for memory writes of previous compute dispatches
+    void barrier(BarrierBits::Mask bits);
+    /// begin an occlusion query
+    void beginQuery(query* qry);
+    /// end the current occlusion query
+    void endQuery(query* qry);
+    /// begin rendering conditionally on the latest result of a query
+    void beginConditionalRender(query* qry);
+    /// end conditional rendering
+    void endConditionalRender();
+    /// make query results polled at commitFrame visible to the Gfx facade
+    void publishQueryResults();
+    /// remove a query from the renderer's internal lists (called when query is destroyed)
+    void discardQuery(query* qry);
     /// update vertex data
     void updateVertices(mesh* msh, const void* data, int numBytes);
     /// update index data
@@ -114,6 +134,10 @@ private:
     void applyRasterizerState(const RasterizerState& rs);
     /// apply meshes
     void applyMeshes(pipeline* pip, mesh** meshes, int numMeshes);
+    /// non-blocking read of available query results, oldest first
+    void pollQuery(query* qry);
+    /// poll all queries with pending results (called from commitFrame)
+    void pollQueries();
 
     bool valid;
     gfxPointers pointers;
@@ -135,7 +159,13 @@ private:
     // high-level state cache
     texture* curRenderTarget;
     pipeline* curPipeline;
+    shader* curComputeShader;
     mesh* curPrimaryMesh;
+    int curBaseVertex;      // base vertex of primary mesh in shared vertex arena
+    query* curQuery;
+    bool inConditionalRender;
+    Array<query*> pendingQueries;   // queries with GL results in flight
+    Array<query*> polledQueries;    // queries with polled but unpublished results
 
     // GL state cache
     BlendState blendState;
@@ -161,6 +191,7 @@ private:
     static const int MaxTextureSamplers = 16;
     GLuint samplers2D[MaxTextureSamplers];
     GLuint samplersCube[MaxTextureSamplers];
+    GLuint samplers2DArray[MaxTextureSamplers];
     glVertexAttr glAttrs[VertexAttr::NumVertexAttrs];
     GLuint glAttrVBs[VertexAttr::NumVertexAttrs];
 };
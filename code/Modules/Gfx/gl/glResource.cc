@@ -24,6 +24,7 @@ glMesh::Clear() {
     for (auto& buf : this->buffers) {
         buf = buffer();
     }
+    this->baseVertex = 0;
     meshBase::Clear();
 }
 
@@ -119,6 +120,40 @@ glTexture::Clear() {
     this->glTextures.Fill(0);
 }
 
+//------------------------------------------------------------------------------
+glQuery::glQuery() :
+glTarget(0),
+curSlot(0),
+isIssued(false),
+isActive(false),
+isPending(false),
+isPolled(false) {
+    this->glQueries.Fill(0);
+    this->slotFrameIndex.Fill(-1);
+}
+
+//------------------------------------------------------------------------------
+glQuery::~glQuery() {
+    #if ORYOL_DEBUG
+    for (const auto& glQuery : this->glQueries) {
+        o_assert_dbg(0 == glQuery);
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+glQuery::Clear() {
+    this->glTarget = 0;
+    this->glQueries.Fill(0);
+    this->slotFrameIndex.Fill(-1);
+    this->curSlot = 0;
+    this->isIssued = false;
+    this->isActive = false;
+    this->isPending = false;
+    this->isPolled = false;
+    queryBase::Clear();
+}
+
 } // namespace _priv
 } // namespace Oryol
-
@@ -25,17 +25,23 @@ public:
 
     static const int MaxNumSlots = 2;
     struct buffer {
-        buffer() : updateFrameIndex(-1), numSlots(1), activeSlot(0) {
+        buffer() : updateFrameIndex(-1), numSlots(1), activeSlot(0), arenaAllocId(InvalidIndex), arenaOffset(0) {
             this->glBuffers.Fill(0);
         }
         int updateFrameIndex;
         uint8_t numSlots;
         uint8_t activeSlot;
         StaticArray<GLuint, MaxNumSlots> glBuffers;
+        /// allocation id in shared buffer arena, or InvalidIndex
+        int arenaAllocId;
+        /// byte offset in shared buffer arena
+        int arenaOffset;
     };
     static const int vb = 0;
     static const int ib = 1;
     StaticArray<buffer, 2> buffers;
+    /// first vertex in shared vertex arena (arenaOffset / vertex stride)
+    int baseVertex = 0;
 };
 
 //------------------------------------------------------------------------------
@@ -172,5 +178,45 @@ public:
     StaticArray<GLuint, MaxNumSlots> glTextures;
 };
 
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::glQuery
+    @ingroup _priv
+    @brief GL implementation of query
+
+    A query object rotates through several GL query objects, so that
+    a query can be issued again while the results of previous frames
+    are still in flight. If a GL query object is reused before its result
+    has arrived, that result is dropped.
+*/
+class glQuery : public queryBase {
+public:
+    /// constructor
+    glQuery();
+    /// destructor
+    ~glQuery();
+
+    /// clear the object
+    void Clear();
+
+    /// GL query target (GL_SAMPLES_PASSED or GL_ANY_SAMPLES_PASSED)
+    GLenum glTarget;
+    static const int NumSlots = 4;
+    /// the GL query objects
+    StaticArray<GLuint, NumSlots> glQueries;
+    /// renderer frame index of the issued query per slot, -1 if no result pending
+    StaticArray<int, NumSlots> slotFrameIndex;
+    /// slot of the most recently begun query
+    uint8_t curSlot;
+    /// true once at least one query has been issued
+    bool isIssued;
+    /// true between beginQuery and endQuery
+    bool isActive;
+    /// true while in the renderer's list of queries with pending results
+    bool isPending;
+    /// true while in the renderer's list of queries with unpublished results
+    bool isPolled;
+};
+
 } // namespace _priv
 } // namespace Oryol
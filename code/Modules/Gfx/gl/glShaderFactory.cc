@@ -55,44 +55,68 @@ glShaderFactory::SetupResource(shader& shd) {
     #endif
     const ShaderSetup& setup = shd.Setup;
 
-    o_assert_dbg(setup.VertexShaderSource(slang).IsValid());
-    o_assert_dbg(setup.FragmentShaderSource(slang).IsValid());
+    GLuint glProg = 0;
+    if (setup.IsComputeProgram()) {
+        // compute programs only exist on GL 4.3 or with the compute extensions
+        if (!glCaps::HasFeature(glCaps::ComputeShader)) {
+            o_warn("Compute shaders not supported, can't create '%s'\n", setup.Locator.Location().AsCStr());
+            return ResourceState::Failed;
+        }
+        o_assert_dbg(setup.ComputeShaderSource(slang).IsValid());
 
-    // compile vertex shader
-    const String& vsSource = setup.VertexShaderSource(slang);
-    GLuint glVertexShader = this->compileShader(ShaderStage::VS, vsSource.AsCStr(), vsSource.Length());
-    o_assert_dbg(0 != glVertexShader);
-        
-    // compile fragment shader
-    const String& fsSource = setup.FragmentShaderSource(slang);
-    GLuint glFragmentShader = this->compileShader(ShaderStage::FS, fsSource.AsCStr(), fsSource.Length());
-    o_assert_dbg(0 != glFragmentShader);
-        
-    // create GL program object and attach vertex/fragment shader
-    GLuint glProg = ::glCreateProgram();
-    ::glAttachShader(glProg, glVertexShader);
-    ORYOL_GL_CHECK_ERROR();
-    ::glAttachShader(glProg, glFragmentShader);
-    ORYOL_GL_CHECK_ERROR();
-        
-    // bind vertex attribute locations
-    /// @todo: would be good to optimize this to only bind
-    /// attributes which exist in the shader (may be with more shader source generation)
-    #if !ORYOL_GL_USE_GETATTRIBLOCATION
-    o_assert_dbg(VertexAttr::NumVertexAttrs <= glCaps::IntLimit(glCaps::MaxVertexAttribs));
-    for (int i = 0; i < VertexAttr::NumVertexAttrs; i++) {
-        ::glBindAttribLocation(glProg, i, VertexAttr::ToString((VertexAttr::Code)i));
+        // compile compute shader
+        const String& csSource = setup.ComputeShaderSource(slang);
+        GLuint glComputeShader = this->compileShader(ShaderStage::CS, csSource.AsCStr(), csSource.Length());
+        o_assert_dbg(0 != glComputeShader);
+
+        // create GL program object, attach compute shader and link
+        glProg = ::glCreateProgram();
+        ::glAttachShader(glProg, glComputeShader);
+        ORYOL_GL_CHECK_ERROR();
+        ::glLinkProgram(glProg);
+        ORYOL_GL_CHECK_ERROR();
+        ::glDeleteShader(glComputeShader);
+    }
+    else {
+        o_assert_dbg(setup.VertexShaderSource(slang).IsValid());
+        o_assert_dbg(setup.FragmentShaderSource(slang).IsValid());
+
+        // compile vertex shader
+        const String& vsSource = setup.VertexShaderSource(slang);
+        GLuint glVertexShader = this->compileShader(ShaderStage::VS, vsSource.AsCStr(), vsSource.Length());
+        o_assert_dbg(0 != glVertexShader);
+
+        // compile fragment shader
+        const String& fsSource = setup.FragmentShaderSource(slang);
+        GLuint glFragmentShader = this->compileShader(ShaderStage::FS, fsSource.AsCStr(), fsSource.Length());
+        o_assert_dbg(0 != glFragmentShader);
+
+        // create GL program object and attach vertex/fragment shader
+        glProg = ::glCreateProgram();
+        ::glAttachShader(glProg, glVertexShader);
+        ORYOL_GL_CHECK_ERROR();
+        ::glAttachShader(glProg, glFragmentShader);
+        ORYOL_GL_CHECK_ERROR();
+
+        // bind vertex attribute locations
+        /// @todo: would be good to optimize this to only bind
+        /// attributes which exist in the shader (may be with more shader source generation)
+        #if !ORYOL_GL_USE_GETATTRIBLOCATION
+        o_assert_dbg(VertexAttr::NumVertexAttrs <= glCaps::IntLimit(glCaps::MaxVertexAttribs));
+        for (int i = 0; i < VertexAttr::NumVertexAttrs; i++) {
+            ::glBindAttribLocation(glProg, i, VertexAttr::ToString((VertexAttr::Code)i));
+        }
+        ORYOL_GL_CHECK_ERROR();
+        #endif
+
+        // link the program
+        ::glLinkProgram(glProg);
+        ORYOL_GL_CHECK_ERROR();
+
+        // can discard shaders now if we compiled them ourselves
+        ::glDeleteShader(glVertexShader);
+        ::glDeleteShader(glFragmentShader);
     }
-    ORYOL_GL_CHECK_ERROR();
-    #endif
-        
-    // link the program
-    ::glLinkProgram(glProg);
-    ORYOL_GL_CHECK_ERROR();
-        
-    // can discard shaders now if we compiled them ourselves
-    ::glDeleteShader(glVertexShader);
-    ::glDeleteShader(glFragmentShader);
 
     // linking successful?
     GLint linkStatus;
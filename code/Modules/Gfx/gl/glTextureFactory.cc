@@ -263,12 +263,12 @@ glTextureFactory::createRenderTarget(texture& tex) {
 
 //------------------------------------------------------------------------------
 void
-glTextureFactory::setupTextureParams(const TextureSetup& setup, GLuint glTex) {
+glTextureFactory::setupTextureParams(const TextureSetup& setup, GLenum glTarget) {
     GLenum glMinFilter = glTypes::asGLTexFilterMode(setup.Sampler.MinFilter);
     GLenum glMagFilter = glTypes::asGLTexFilterMode(setup.Sampler.MagFilter);
     if (1 == setup.NumMipMaps) {
         #if !ORYOL_OPENGLES2
-        ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0); // see: http://www.opengl.org/wiki/Hardware_specifics:_NVidia
+        ::glTexParameteri(glTarget, GL_TEXTURE_MAX_LEVEL, 0); // see: http://www.opengl.org/wiki/Hardware_specifics:_NVidia
         #endif
         if ((glMinFilter == GL_NEAREST_MIPMAP_NEAREST) || (glMinFilter == GL_NEAREST_MIPMAP_LINEAR)) {
             glMinFilter = GL_NEAREST;
@@ -277,15 +277,15 @@ glTextureFactory::setupTextureParams(const TextureSetup& setup, GLuint glTex) {
             glMinFilter = GL_LINEAR;
         }
     }
-    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glMinFilter);
-    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glMagFilter);
+    ::glTexParameteri(glTarget, GL_TEXTURE_MIN_FILTER, glMinFilter);
+    ::glTexParameteri(glTarget, GL_TEXTURE_MAG_FILTER, glMagFilter);
     if (setup.Type == TextureType::TextureCube) {
-        ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        ::glTexParameteri(glTarget, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        ::glTexParameteri(glTarget, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     }
     else {
-        ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, glTypes::asGLTexWrapMode(setup.Sampler.WrapU));
-        ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, glTypes::asGLTexWrapMode(setup.Sampler.WrapV));
+        ::glTexParameteri(glTarget, GL_TEXTURE_WRAP_S, glTypes::asGLTexWrapMode(setup.Sampler.WrapU));
+        ::glTexParameteri(glTarget, GL_TEXTURE_WRAP_T, glTypes::asGLTexWrapMode(setup.Sampler.WrapV));
     }
     ORYOL_GL_CHECK_ERROR();
 }
@@ -300,6 +300,7 @@ glTextureFactory::setupTextureAttrs(texture& tex) {
     attrs.TextureUsage = tex.Setup.TextureUsage;
     attrs.Width = tex.Setup.Width;
     attrs.Height = tex.Setup.Height;
+    attrs.Depth = tex.Setup.Depth;
     attrs.NumMipMaps = tex.Setup.NumMipMaps;
     tex.textureAttrs = attrs;
 }
@@ -321,13 +322,18 @@ glTextureFactory::createFromPixelData(texture& tex, const void* data, int size)
         o_warn("glTextureFactory: unsupported texture format for resource '%s'\n", setup.Locator.Location().AsCStr());
         return ResourceState::Failed;
     }
+    const bool isArray = TextureType::Texture2DArray == setup.Type;
+    if (isArray && !glCaps::HasFeature(glCaps::TextureArray)) {
+        o_warn("glTextureFactory: texture arrays not supported for resource '%s'\n", setup.Locator.Location().AsCStr());
+        return ResourceState::Failed;
+    }
     
     // create a texture object
     const GLenum glTextureTarget = glTypes::asGLTextureTarget(setup.Type);
     const GLuint glTex = this->glGenAndBindTexture(glTextureTarget);
     
     // setup texture params
-    this->setupTextureParams(setup, glTex);
+    this->setupTextureParams(setup, glTextureTarget);
 
     // copy image data intp texture
     const uint8_t* srcPtr = (const uint8_t*) data;
@@ -362,7 +368,36 @@ glTextureFactory::createFromPixelData(texture& tex, const void* data, int size)
             if (mipHeight == 0) {
                 mipHeight = 1;
             }
-            if (isCompressed) {
+            if (isArray) {
+                // all layers of a mipmap level are one block in the pixel data
+                #if !ORYOL_OPENGLES2
+                if (isCompressed) {
+                    ::glCompressedTexImage3D(glImgTarget,
+                                             mipIndex,
+                                             glTexImageInternalFormat,
+                                             mipWidth,
+                                             mipHeight,
+                                             setup.Depth,
+                                             0,
+                                             setup.ImageData.Sizes[faceIndex][mipIndex],
+                                             srcPtr + setup.ImageData.Offsets[faceIndex][mipIndex]);
+                }
+                else {
+                    ::glTexImage3D(glImgTarget,
+                                   mipIndex,
+                                   glTexImageInternalFormat,
+                                   mipWidth,
+                                   mipHeight,
+                                   setup.Depth,
+                                   0,
+                                   glTypes::asGLTexImageFormat(setup.ColorFormat),
+                                   glTypes::asGLTexImageType(setup.ColorFormat),
+                                   srcPtr + setup.ImageData.Offsets[faceIndex][mipIndex]);
+                }
+                ORYOL_GL_CHECK_ERROR();
+                #endif
+            }
+            else if (isCompressed) {
                 // compressed texture data
                 ::glCompressedTexImage2D(glImgTarget,
                                          mipIndex,
@@ -408,8 +443,9 @@ glTextureFactory::createEmptyTexture(texture& tex) {
 
     const TextureSetup& setup = tex.Setup;
     o_assert_dbg(setup.TextureUsage != Usage::Immutable);
-    o_assert_dbg(setup.Type == TextureType::Texture2D);
+    o_assert_dbg((setup.Type == TextureType::Texture2D) || (setup.Type == TextureType::Texture2DArray));
     o_assert_dbg(!PixelFormat::IsCompressedFormat(setup.ColorFormat));
+    const bool isArray = TextureType::Texture2DArray == setup.Type;
     const int width = setup.Width;
     const int height = setup.Height;
     const GLenum glTextureTarget = glTypes::asGLTextureTarget(setup.Type);
@@ -422,13 +458,17 @@ glTextureFactory::createEmptyTexture(texture& tex) {
         o_warn("glTextureFactory: unsupported texture format for resource '%s'\n", setup.Locator.Location().AsCStr());
         return ResourceState::Failed;
     }
+    if (isArray && !glCaps::HasFeature(glCaps::TextureArray)) {
+        o_warn("glTextureFactory: texture arrays not supported for resource '%s'\n", setup.Locator.Location().AsCStr());
+        return ResourceState::Failed;
+    }
 
     // create one or two texture object
     tex.numSlots = Usage::Stream == setup.TextureUsage ? 2 : 1;
     for (int slotIndex = 0; slotIndex < tex.numSlots; slotIndex++) {
 
         tex.glTextures[slotIndex] = this->glGenAndBindTexture(glTextureTarget);
-        this->setupTextureParams(setup, tex.glTextures[slotIndex]);
+        this->setupTextureParams(setup, glTextureTarget);
 
         // initialize texture storage
         const int numMipMaps = setup.NumMipMaps;
@@ -441,15 +481,31 @@ glTextureFactory::createEmptyTexture(texture& tex) {
             if (mipHeight == 0) {
                 mipHeight = 1;
             }
-            ::glTexImage2D(glTextureTarget,
-                           mipIndex,
-                           glTexImageInternalFormat,
-                           mipWidth,
-                           mipHeight,
-                           0,
-                           glTexImageFormat,
-                           glTexImageType,
-                           nullptr);
+            if (isArray) {
+                #if !ORYOL_OPENGLES2
+                ::glTexImage3D(glTextureTarget,
+                               mipIndex,
+                               glTexImageInternalFormat,
+                               mipWidth,
+                               mipHeight,
+                               setup.Depth,
+                               0,
+                               glTexImageFormat,
+                               glTexImageType,
+                               nullptr);
+                #endif
+            }
+            else {
+                ::glTexImage2D(glTextureTarget,
+                               mipIndex,
+                               glTexImageInternalFormat,
+                               mipWidth,
+                               mipHeight,
+                               0,
+                               glTexImageFormat,
+                               glTexImageType,
+                               nullptr);
+            }
             ORYOL_GL_CHECK_ERROR();
         }
     }
@@ -215,6 +215,9 @@ glTypes::asGLShaderStage(ShaderStage::Code c) {
     switch (c) {
         case ShaderStage::VS: return GL_VERTEX_SHADER;
         case ShaderStage::FS: return GL_FRAGMENT_SHADER;
+        #if ORYOL_OPENGL_CORE_PROFILE && defined(GL_ARB_compute_shader)
+        case ShaderStage::CS: return GL_COMPUTE_SHADER;
+        #endif
         default:
             o_error("glTypes::asGLShaderType(): invalid param!\n");
             return 0;
@@ -257,6 +260,7 @@ glTypes::asGLTextureTarget(TextureType::Code c) {
         case TextureType::Texture2D:    return GL_TEXTURE_2D;
         #if !ORYOL_OPENGLES2
         case TextureType::Texture3D:    return GL_TEXTURE_3D;
+        case TextureType::Texture2DArray: return GL_TEXTURE_2D_ARRAY;
         #endif
         case TextureType::TextureCube:  return GL_TEXTURE_CUBE_MAP;
         default:
@@ -278,5 +282,23 @@ glTypes::asGLBufferUsage(Usage::Code c) {
     }
 }
 
+//------------------------------------------------------------------------------
+GLbitfield
+glTypes::asGLBarrierBits(BarrierBits::Mask mask) {
+    GLbitfield bits = 0;
+    #if ORYOL_OPENGL_CORE_PROFILE && defined(GL_ARB_shader_storage_buffer_object)
+    if (mask & BarrierBits::VertexData) {
+        bits |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+    }
+    if (mask & BarrierBits::StorageData) {
+        bits |= GL_SHADER_STORAGE_BARRIER_BIT;
+    }
+    if (mask & BarrierBits::BufferUpdate) {
+        bits |= GL_BUFFER_UPDATE_BARRIER_BIT;
+    }
+    #endif
+    return bits;
+}
+
 } // namespace _priv
 } // namespace Oryol
@@ -36,6 +36,8 @@ public:
     static GLenum asGLTextureTarget(TextureType::Code c);
     /// convert Oryol usage to GL buffer usage
     static GLenum asGLBufferUsage(Usage::Code c);
+    /// convert Oryol barrier bits to glMemoryBarrier bits
+    static GLbitfield asGLBarrierBits(BarrierBits::Mask mask);
 };
     
 } // namespace _priv
@@ -125,6 +125,26 @@ glfwDisplayMgr::Present() {
     displayMgrBase::Present();
 }
 
+//------------------------------------------------------------------------------
+bool
+glfwDisplayMgr::SupportsRenderThread() const {
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+glfwDisplayMgr::AcquireContext() {
+    o_assert(nullptr != glfwWindow);
+    glfwMakeContextCurrent(glfwWindow);
+}
+
+//------------------------------------------------------------------------------
+void
+glfwDisplayMgr::ReleaseContext() {
+    o_assert(nullptr != glfwWindow);
+    glfwMakeContextCurrent(nullptr);
+}
+
 //------------------------------------------------------------------------------
 void
 glfwDisplayMgr::glBindDefaultFramebuffer() {
@@ -34,6 +34,12 @@ public:
     void Present();
     /// check whether the window system requests to quit the application
     bool QuitRequested() const;
+    /// the GL context can be moved to a render thread
+    bool SupportsRenderThread() const;
+    /// make the GL context current on the calling thread
+    void AcquireContext();
+    /// detach the GL context from the calling thread
+    void ReleaseContext();
     
     /// bind the default frame buffer
     void glBindDefaultFramebuffer();
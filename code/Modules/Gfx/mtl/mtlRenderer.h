@@ -28,6 +28,8 @@ namespace _priv {
 class texture;
 class pipeline;
 class mesh;
+class shader;
+class query;
 class textureBlock;
 
 class mtlRenderer {
@@ -73,6 +75,24 @@ public:
     void drawInstanced(int primGroupIndex, int numInstances);
     /// submit a draw call for instanced rendering with direct primitive group
     void drawInstanced(const PrimitiveGroup& primGroup, int numInstances);
+    /// apply compute state (not supported, compute shaders can't be created)
+    void applyComputeState(shader* shd, mesh** storageBuffers, int numStorageBuffers);
+    /// submit a compute dispatch (not supported)
+    void dispatch(int numGroupsX, int numGroupsY, int numGroupsZ);
+    /// wait for memory writes of previous compute dispatches (not supported)
+    void barrier(BarrierBits::Mask bits);
+    /// begin an occlusion query (not supported)
+    void beginQuery(query* qry);
+    /// end an occlusion query (not supported)
+    void endQuery(query* qry);
+    /// begin conditional rendering (not supported)
+    void beginConditionalRender(query* qry);
+    /// end conditional rendering (not supported)
+    void endConditionalRender();
+    /// publish polled query results (not supported)
+    void publishQueryResults();
+    /// remove a query from internal lists (not supported)
+    void discardQuery(query* qry);
     /// update vertex data
     void updateVertices(mesh* msh, const void* data, int numBytes);
     /// update index data
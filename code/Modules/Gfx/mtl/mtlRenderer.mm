@@ -506,6 +506,63 @@ mtlRenderer::drawInstanced(int primGroupIndex, int numInstances) {
     this->drawInstanced(primGroup, numInstances);
 }
 
+//------------------------------------------------------------------------------
+void
+mtlRenderer::applyComputeState(shader* shd, mesh** storageBuffers, int numStorageBuffers) {
+    // compute shaders are not supported on Metal, the shader factory
+    // fails to create compute programs, so shd is always nullptr here
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr == shd);
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::dispatch(int numGroupsX, int numGroupsY, int numGroupsZ) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::barrier(BarrierBits::Mask bits) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::beginQuery(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::endQuery(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::beginConditionalRender(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::endConditionalRender() {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::publishQueryResults() {
+    o_assert_dbg(this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+mtlRenderer::discardQuery(query* qry) {
+    o_assert_dbg(this->valid);
+}
+
 //------------------------------------------------------------------------------
 void
 mtlRenderer::draw(const PrimitiveGroup& primGroup) {
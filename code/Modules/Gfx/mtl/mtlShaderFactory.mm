@@ -45,6 +45,10 @@ mtlShaderFactory::SetupResource(shader& shd) {
 
     const ShaderLang::Code slang = ShaderLang::Metal;
     const ShaderSetup& setup = shd.Setup;
+    if (setup.IsComputeProgram()) {
+        o_warn("mtlShaderFactory: compute shaders not supported, can't create '%s'\n", setup.Locator.Location().AsCStr());
+        return ResourceState::Failed;
+    }
     const void* libraryByteCode = nullptr;
     uint32 libraryByteCodeSize = 0;
     setup.LibraryByteCode(slang, libraryByteCode, libraryByteCodeSize);
@@ -13,6 +13,12 @@ HTTPFileSystem::onMsg(const Ptr<IORequest>& ioReq) {
     if (ioReadRequest.isValid()) {
         this->loader.doRequest(ioReadRequest);
     }
+    else {
+        // HTTP has no way to query file attributes or list directories,
+        // so IOStat, IOStatBatch and IOListDir are not supported
+        ioReq->Status = IOStatus::NotImplemented;
+        ioReq->Handled = true;
+    }
 }
 
 } // namespace Oryol
@@ -9,6 +9,10 @@
     @brief implements a simple HTTP-based filesystem
     @see HTTPClient, FileSystem
     
+    Only IORead requests are supported, all other requests (like
+    IOStat, IOStatBatch and IOListDir) are answered with
+    IOStatus::NotImplemented.
+
     @todo: HTTPFileSystem description
 */
 #include "IO/FS/FileSystem.h"
@@ -118,7 +118,7 @@ pnaclURLLoader::cbRequestComplete(void* data, int32_t result) {
         // HTTP error, dump a warning, and cleanup
         Log::Warn("pnaclURLLoader::cbRequestComplete: GET '%s' returned with '%d'\n", 
             req->ioRequest->Url.AsCStr(), httpStatus);
-        req->ioRequest->Handled = true;
+        req->ioRequest->SetHandled();
         req->release();
     }
 }
@@ -130,7 +130,7 @@ pnaclURLLoader::cbOnRead(void* data, int32_t result) {
     if (PP_OK == result)
     {
         // all data received
-        req->ioRequest->Handled = true;
+        req->ioRequest->SetHandled();
         req->release();
     }
     else if (result > 0)
@@ -145,7 +145,7 @@ pnaclURLLoader::cbOnRead(void* data, int32_t result) {
         // an error occurred
         Log::Warn("pnaclURLLoader::cbOnRead: Error while reading body data.\n");
         req->ioRequest->Status = IOStatus::DownloadError;
-        req->ioRequest->Handled = true;
+        req->ioRequest->SetHandled();
         req->release();
     }
 }
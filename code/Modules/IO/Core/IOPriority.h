@@ -0,0 +1,29 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::IOPriority
+    @ingroup IO
+    @brief IO request priorities
+
+    The IO worker threads always handle queued requests of higher
+    priority first. Low priority is used for prefetching, so that
+    prefetch requests never delay regular loads.
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+class IOPriority {
+public:
+    /// priority enum
+    enum Code {
+        High = 0,
+        Normal,
+        Low,
+
+        NumPriorities,
+        InvalidPriority = InvalidIndex
+    };
+};
+
+} // namespace Oryol
@@ -19,6 +19,8 @@ public:
     Map<String, String> Assigns;
     /// initial file systems
     Map<StringAtom, std::function<Ptr<FileSystem>()>> FileSystems;
+    /// max number of bytes kept in the prefetch cache
+    int PrefetchCacheSize = 16 * 1024 * 1024;
 };
     
 } // namespace Oryol
@@ -55,6 +55,7 @@ IOStatus::ToString(Code c) {
         __ORYOL_TOSTRING(HTTPVersionNotSupported);
         __ORYOL_TOSTRING(Cancelled);
         __ORYOL_TOSTRING(DownloadError);
+        __ORYOL_TOSTRING(WriteError);
         default: return "InvalidIOStatus";
     }
 }
@@ -105,6 +106,7 @@ IOStatus::FromString(const char* str) {
     __ORYOL_FROMSTRING(HTTPVersionNotSupported);
     __ORYOL_FROMSTRING(Cancelled);
     __ORYOL_FROMSTRING(DownloadError);
+    __ORYOL_FROMSTRING(WriteError);
     return InvalidIOStatus;
 }
     
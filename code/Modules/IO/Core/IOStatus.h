@@ -68,6 +68,7 @@ public:
         // these are custom Oryol status codes
         Cancelled = 1000,
         DownloadError = 1001,
+        WriteError = 1002,
         
         InvalidIOStatus = InvalidIndex
     };
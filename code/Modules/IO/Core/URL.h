@@ -18,6 +18,7 @@
 #include "Core/String/StringAtom.h"
 #include "Core/Containers/Map.h"
 #include "Core/String/String.h"
+#include "Core/Hash/Hash.h"
 
 namespace Oryol {
 
@@ -133,4 +134,11 @@ private:
     bool valid;
 };
    
+//------------------------------------------------------------------------------
+template<> struct HashTraits<URL> {
+    static uint64_t Compute(const URL& url) {
+        return HashTraits<StringAtom>::Compute(url.Get());
+    };
+};
+
 } // namespace Oryol
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include "Pre.h"
 #include "assignRegistry.h"
 #include "Core/String/StringBuilder.h"
+#include "Core/Hash/Hash.h"
+#include <algorithm>
+#include <cstring>
 
 namespace Oryol {
 namespace _priv {
@@ -53,9 +56,15 @@ assignRegistry::LookupAssign(const String& assign) const {
 //------------------------------------------------------------------------------
 String
 assignRegistry::ResolveAssigns(const String& str) const {
-
     this->rwLock.LockRead();
-    
+    String result = this->resolveAssigns(str);
+    this->rwLock.UnlockRead();
+    return result;
+}
+
+//------------------------------------------------------------------------------
+String
+assignRegistry::resolveAssigns(const String& str) const {
     StringBuilder builder;
     builder.Set(str);
     
@@ -72,14 +81,147 @@ assignRegistry::ResolveAssigns(const String& str) const {
                 // replace assign string
                 builder.SubstituteFirst(assignString, this->assigns[assignString]);
             }
+            else if (this->overlays.Contains(assignString)) {
+
+                // replace overlay assign with the layer which contains the path
+                const overlay& ovl = this->overlays[assignString];
+                const char* path = builder.AsCStr() + index + 1;
+                const int pathLength = builder.Length() - (index + 1);
+                const int layer = lookupLayer(ovl, OverlayPathHash(path, pathLength));
+                builder.SubstituteFirst(assignString, ovl.layers[layer]);
+            }
             else break;
         }
         else break;
     }
-    String result = builder.GetString();
+    return builder.GetString();
+}
+
+//------------------------------------------------------------------------------
+void
+assignRegistry::SetOverlay(const String& assign, const Array<String>& layers) {
+    o_assert(assign.Back() == ':');
+    o_assert(assign.Length() > 1);
+    o_assert(!layers.Empty());
+    for (const String& layer : layers) {
+        o_assert((layer.Back() == '/') || (layer.Back() == ':'));
+    }
+
+    this->rwLock.LockWrite();
+    o_assert(!this->assigns.Contains(assign));
+    overlay ovl;
+    ovl.layers = layers;
+    if (this->overlays.Contains(assign)) {
+        this->overlays[assign] = std::move(ovl);
+    }
+    else {
+        this->overlays.Add(assign, std::move(ovl));
+    }
+    this->rwLock.UnlockWrite();
+}
+
+//------------------------------------------------------------------------------
+void
+assignRegistry::RemoveOverlay(const String& assign) {
+    this->rwLock.LockWrite();
+    if (this->overlays.Contains(assign)) {
+        this->overlays.Erase(assign);
+    }
+    this->rwLock.UnlockWrite();
+}
+
+//------------------------------------------------------------------------------
+bool
+assignRegistry::HasOverlay(const String& assign) const {
+    this->rwLock.LockRead();
+    bool result = this->overlays.Contains(assign);
     this->rwLock.UnlockRead();
     return result;
 }
 
+//------------------------------------------------------------------------------
+uint64_t
+assignRegistry::OverlayPathHash(const char* path, int length) {
+    return Hash::Bytes(path, length);
+}
+
+//------------------------------------------------------------------------------
+void
+assignRegistry::SetOverlayIndex(const String& assign, Array<overlayEntry>&& entries) {
+
+    // sort by path hash, and for the same path by layer, then
+    // only keep the first (highest-priority) layer of each path
+    std::sort(entries.begin(), entries.end(), [](const overlayEntry& a, const overlayEntry& b) {
+        return (a.pathHash < b.pathHash) || ((a.pathHash == b.pathHash) && (a.layer < b.layer));
+    });
+    int numUnique = 0;
+    for (int i = 0; i < entries.Size(); i++) {
+        if ((0 == numUnique) || (entries[numUnique - 1].pathHash != entries[i].pathHash)) {
+            entries[numUnique++] = entries[i];
+        }
+    }
+    while (entries.Size() > numUnique) {
+        entries.PopBack();
+    }
+
+    this->rwLock.LockWrite();
+    if (this->overlays.Contains(assign)) {
+        this->overlays[assign].index = std::move(entries);
+    }
+    this->rwLock.UnlockWrite();
+}
+
+//------------------------------------------------------------------------------
+void
+assignRegistry::AddOverlayFile(const String& path) {
+    this->rwLock.LockWrite();
+    for (auto& kvp : this->overlays) {
+        overlay& ovl = kvp.Value();
+        for (int layer = 0; layer < ovl.layers.Size(); layer++) {
+            const String root = this->resolveAssigns(ovl.layers[layer]);
+            if ((path.Length() > root.Length()) && (0 == std::strncmp(path.AsCStr(), root.AsCStr(), root.Length()))) {
+                const uint64_t hash = OverlayPathHash(path.AsCStr() + root.Length(), path.Length() - root.Length());
+                auto it = std::lower_bound(ovl.index.begin(), ovl.index.end(), hash,
+                    [](const overlayEntry& e, uint64_t h) { return e.pathHash < h; });
+                const int i = int(it - ovl.index.begin());
+                if ((i < ovl.index.Size()) && (ovl.index[i].pathHash == hash)) {
+                    if (layer < ovl.index[i].layer) {
+                        ovl.index[i].layer = layer;
+                    }
+                }
+                else {
+                    ovl.index.Insert(i, overlayEntry{ hash, layer });
+                }
+                break;
+            }
+        }
+    }
+    this->rwLock.UnlockWrite();
+}
+
+//------------------------------------------------------------------------------
+int
+assignRegistry::LookupOverlayLayer(const String& assign, const String& path) const {
+    this->rwLock.LockRead();
+    int layer = InvalidIndex;
+    if (this->overlays.Contains(assign)) {
+        layer = lookupLayer(this->overlays[assign], OverlayPathHash(path.AsCStr(), path.Length()));
+    }
+    this->rwLock.UnlockRead();
+    return layer;
+}
+
+//------------------------------------------------------------------------------
+int
+assignRegistry::lookupLayer(const overlay& ovl, uint64_t pathHash) {
+    auto it = std::lower_bound(ovl.index.begin(), ovl.index.end(), pathHash,
+        [](const overlayEntry& e, uint64_t h) { return e.pathHash < h; });
+    if ((it != ovl.index.end()) && (it->pathHash == pathHash)) {
+        return it->layer;
+    }
+    // paths which are not in the index resolve to the first layer
+    return 0;
+}
+
 } // namespace _priv
 } // namespace Oryol
\ No newline at end of file
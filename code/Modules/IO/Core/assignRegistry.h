@@ -7,8 +7,16 @@
  
     Central registry for assign definitions. Assigns are
     path aliases (google for AmigaOS assign).
+
+    An overlay assign resolves a path against an ordered list of
+    layers (e.g. "patch:", "dlc:", "base:"), the first layer which
+    contains the path wins. Instead of probing the layers, the path is
+    looked up in a merged index which maps path hashes to layer indices
+    (the index is built from directory listings, see IO::MountOverlay()).
+    Paths which are not in the index resolve to the first layer.
 */
 #include "Core/Containers/Map.h"
+#include "Core/Containers/Array.h"
 #include "Core/String/String.h"
 #include "Core/Threading/RWLock.h"
 
@@ -25,13 +33,43 @@ public:
     String LookupAssign(const String& assign) const;
     /// resolve assigns in the provided string
     String ResolveAssigns(const String& str) const;
+
+    /// an overlay index entry
+    struct overlayEntry {
+        uint64_t pathHash;
+        int layer;
+    };
+    /// add or replace an overlay assign, the first layer has the highest priority
+    void SetOverlay(const String& assign, const Array<String>& layers);
+    /// remove an overlay assign
+    void RemoveOverlay(const String& assign);
+    /// check if an overlay assign exists
+    bool HasOverlay(const String& assign) const;
+    /// set the merged index of an overlay (entries can contain a path for several layers)
+    void SetOverlayIndex(const String& assign, Array<overlayEntry>&& entries);
+    /// update overlay indices after a file has been written (path must be resolved)
+    void AddOverlayFile(const String& path);
+    /// get the layer index a path relative to an overlay resolves to
+    int LookupOverlayLayer(const String& assign, const String& path) const;
+    /// compute the hash of a path relative to an overlay
+    static uint64_t OverlayPathHash(const char* path, int length);
     
 private:
     /// setup the standard assigns
     void setStandardAssigns();
+    /// resolve assigns without locking
+    String resolveAssigns(const String& str) const;
+    /// an overlay assign
+    struct overlay {
+        Array<String> layers;
+        Array<overlayEntry> index;  // sorted by pathHash, one entry per path
+    };
+    /// find the layer index of a path hash in an overlay index
+    static int lookupLayer(const overlay& ovl, uint64_t pathHash);
     
     mutable RWLock rwLock;
     Map<String, String> assigns;
+    Map<String, overlay> overlays;
 };
     
 } // namespace _priv
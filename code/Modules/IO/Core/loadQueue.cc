@@ -9,108 +9,424 @@
 
 namespace Oryol {
 
+//------------------------------------------------------------------------------
+loadQueue::loadQueue() :
+numPendingItems(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+loadQueue::~loadQueue() {
+    // break the request <=> group reference cycles of unfinished groups,
+    // no matter whether their requests are pending, cancelled or
+    // completed (the IO workers have already been stopped here)
+    for (const auto& group : this->pendingGroups) {
+        for (const auto& req : group->ioRequests) {
+            req->group = nullptr;
+        }
+        group->ioRequests.Clear();
+    }
+    this->pendingGroups.Clear();
+    this->cancelAllPrefetches();
+}
+
 //------------------------------------------------------------------------------
 void
-loadQueue::add(const URL& url, successFunc onSuccess, failFunc onFail) {
+loadQueue::add(const URL& url, successFunc onSuccess, failFunc onFail, callbackThread thread) {
     o_assert_dbg(onSuccess);
-    Ptr<IORead> ioReq = IORead::Create();
+
+    // if the URL has been prefetched (or a prefetch is still pending),
+    // take over the prefetch request
+    if (this->prefetchCache.Contains(url.Get())) {
+        const bool completed = this->prefetchCache[url.Get()]->inPrefetchList;
+        Ptr<request> ioReq = this->removePrefetched(url.Get());
+        ioReq->prefetch = false;
+        ioReq->thread = thread;
+        ioReq->onSuccess = std::move(onSuccess);
+        ioReq->onFail = std::move(onFail);
+        // if the IO worker hasn't looked at the request yet, it invokes
+        // a worker thread callback itself, otherwise update() takes care of it
+        #if ORYOL_HAS_ATOMIC
+        int expected = MainThread;
+        ioReq->callbackState.compare_exchange_strong(expected, thread);
+        #else
+        if (MainThread == ioReq->callbackState) {
+            ioReq->callbackState = thread;
+        }
+        #endif
+        this->numPendingItems++;
+        if (completed) {
+            // already went through update(), feed it in again
+            this->putCompleted(ioReq);
+        }
+        else {
+            raisePriority(ioReq);
+        }
+        return;
+    }
+
+    Ptr<request> ioReq = request::Create();
     ioReq->Url = url;
+    ioReq->queue = this;
+    ioReq->thread = thread;
+    ioReq->callbackState = thread;
+    ioReq->onSuccess = std::move(onSuccess);
+    ioReq->onFail = std::move(onFail);
+    this->numPendingItems++;
     IO::Put(ioReq);
-    this->items.Add(item{ ioReq, onSuccess, onFail });
 }
 
 //------------------------------------------------------------------------------
 void
-loadQueue::addGroup(const Array<URL>& urls, groupSuccessFunc onSuccess, failFunc onFail) {
+loadQueue::addGroup(const Array<URL>& urls, groupSuccessFunc onSuccess, failFunc onFail, callbackThread thread) {
     o_assert_dbg(onSuccess);
-    
-    groupItem item;
-    item.ioRequests.Reserve(urls.Size());
+    o_assert_dbg(!urls.Empty());
+
+    Ptr<groupItem> group = groupItem::Create();
+    group->thread = thread;
+    group->onSuccess = std::move(onSuccess);
+    group->onFail = std::move(onFail);
+    group->ioRequests.Reserve(urls.Size());
     for (const URL& url : urls) {
-        Ptr<IORead> ioReq = IORead::Create();
+        Ptr<request> ioReq = request::Create();
         ioReq->Url = url;
+        ioReq->queue = this;
+        ioReq->group = group;
+        group->ioRequests.Add(ioReq);
+    }
+    // only start the requests after the group is complete, since
+    // the IO threads look at the group's request array
+    for (const auto& ioReq : group->ioRequests) {
         IO::Put(ioReq);
-        item.ioRequests.Add(ioReq);
-        item.onSuccess = onSuccess;
-        item.onFail = onFail;
     }
-    this->groupItems.Add(item);
+    group->pendingIndex = this->pendingGroups.Size();
+    this->pendingGroups.Add(group);
+    this->numPendingItems++;
 }
 
 //------------------------------------------------------------------------------
 int
 loadQueue::numPending() const {
-    return this->items.Size() + this->groupItems.Size();
+    return this->numPendingItems;
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::setPrefetchCacheSize(int numBytes) {
+    o_assert_dbg(numBytes >= 0);
+    this->prefetchBudget = numBytes;
+    this->evictPrefetched();
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::prefetch(const URL& url, IOPriority::Code prio) {
+    if (!this->prefetchCache.Contains(url.Get())) {
+        Ptr<request> ioReq = request::Create();
+        ioReq->Url = url;
+        ioReq->Priority = prio;
+        ioReq->queue = this;
+        ioReq->prefetch = true;
+        this->prefetchCache.Add(url.Get(), ioReq);
+        IO::Put(ioReq);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::cancelPrefetch(const URL& url) {
+    if (this->prefetchCache.Contains(url.Get())) {
+        Ptr<request> ioReq = this->removePrefetched(url.Get());
+        ioReq->Cancelled = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::cancelAllPrefetches() {
+    for (const auto& kvp : this->prefetchCache) {
+        request* req = kvp.Value().get();
+        req->Cancelled = true;
+        req->olderPrefetch = req->newerPrefetch = nullptr;
+        req->inPrefetchList = false;
+    }
+    this->prefetchCache.Clear();
+    this->oldestPrefetch = this->newestPrefetch = nullptr;
+    this->prefetchBytes = 0;
+}
+
+//------------------------------------------------------------------------------
+Ptr<IORead>
+loadQueue::takePrefetched(const URL& url) {
+    if (this->prefetchCache.Contains(url.Get())) {
+        // NOTE: the request remains flagged as prefetch request, and
+        // will be ignored by update() since it is no longer in the cache
+        Ptr<request> ioReq = this->removePrefetched(url.Get());
+        raisePriority(ioReq);
+        return Ptr<IORead>(ioReq);
+    }
+    else {
+        return Ptr<IORead>();
+    }
+}
+
+//------------------------------------------------------------------------------
+int
+loadQueue::prefetchCacheBytes() const {
+    return this->prefetchBytes;
+}
+
+//------------------------------------------------------------------------------
+Ptr<loadQueue::request>
+loadQueue::removePrefetched(const StringAtom& key) {
+    Ptr<request> ioReq = this->prefetchCache[key];
+    this->prefetchCache.Erase(key);
+    if (ioReq->inPrefetchList) {
+        this->unlinkPrefetched(ioReq.get());
+        this->prefetchBytes -= ioReq->Data.Size();
+    }
+    return ioReq;
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::raisePriority(const Ptr<request>& ioReq) {
+    if (!ioReq->Handled && (ioReq->Priority > IOPriority::Normal)) {
+        // the request is still queued at its old priority, put it in
+        // again, the IO worker which gets to it first handles it
+        ioReq->Priority = IOPriority::Normal;
+        IO::Put(ioReq);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::evictPrefetched() {
+    while ((this->prefetchBytes > this->prefetchBudget) && this->oldestPrefetch) {
+        this->removePrefetched(this->oldestPrefetch->Url.Get());
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::linkPrefetched(request* req) {
+    o_assert_dbg(!req->inPrefetchList);
+    req->olderPrefetch = this->newestPrefetch;
+    req->newerPrefetch = nullptr;
+    if (this->newestPrefetch) {
+        this->newestPrefetch->newerPrefetch = req;
+    }
+    else {
+        this->oldestPrefetch = req;
+    }
+    this->newestPrefetch = req;
+    req->inPrefetchList = true;
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::unlinkPrefetched(request* req) {
+    o_assert_dbg(req->inPrefetchList);
+    if (req->olderPrefetch) {
+        req->olderPrefetch->newerPrefetch = req->newerPrefetch;
+    }
+    else {
+        this->oldestPrefetch = req->newerPrefetch;
+    }
+    if (req->newerPrefetch) {
+        req->newerPrefetch->olderPrefetch = req->olderPrefetch;
+    }
+    else {
+        this->newestPrefetch = req->olderPrefetch;
+    }
+    req->olderPrefetch = req->newerPrefetch = nullptr;
+    req->inPrefetchList = false;
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::forwardToWorker(const Ptr<request>& req) {
+    // the forwarded request is already handled, so the IO worker
+    // only calls its onHandled() method, which invokes the callback
+    Ptr<request> fwdReq = request::Create();
+    fwdReq->Url = req->Url;
+    fwdReq->queue = this;
+    fwdReq->thread = WorkerThread;
+    fwdReq->callbackState = WorkerThread;
+    fwdReq->onSuccess = std::move(req->onSuccess);
+    fwdReq->onFail = std::move(req->onFail);
+    fwdReq->Data = std::move(req->Data);
+    fwdReq->Status = req->Status;
+    fwdReq->Handled = true;
+    IO::Put(fwdReq);
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::removePendingGroup(const Ptr<groupItem>& group) {
+    const int index = group->pendingIndex;
+    o_assert_dbg((index >= 0) && (this->pendingGroups[index] == group));
+    this->pendingGroups.EraseSwapBack(index);
+    if (index < this->pendingGroups.Size()) {
+        this->pendingGroups[index]->pendingIndex = index;
+    }
+    group->pendingIndex = InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::prefetchCompleted(const Ptr<request>& ioReq) {
+    // if the request is no longer in the cache, the prefetch has been
+    // cancelled or taken over by IO::LoadFile()
+    const StringAtom& key = ioReq->Url.Get();
+    if (this->prefetchCache.Contains(key) && (this->prefetchCache[key] == ioReq)) {
+        if (IOStatus::OK == ioReq->Status) {
+            this->linkPrefetched(ioReq.get());
+            this->prefetchBytes += ioReq->Data.Size();
+            this->evictPrefetched();
+        }
+        else {
+            // prefetch failures are silent, a later load will report the error
+            this->prefetchCache.Erase(key);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::putCompleted(const Ptr<request>& req) {
+    #if ORYOL_HAS_THREADS
+    std::lock_guard<std::mutex> lock(this->completedMutex);
+    #endif
+    this->completed.Add(req);
+}
+
+//------------------------------------------------------------------------------
+/**
+    NOTE: this is called on the IO worker thread.
+*/
+void
+loadQueue::request::onHandled() {
+    if (this->group) {
+        // if this was the last request of the group to finish, and all
+        // requests were successful, invoke the group success callback
+        if ((WorkerThread == this->group->thread) &&
+            (++this->group->numHandled == this->group->ioRequests.Size()) &&
+            !this->group->anyFailed()) {
+            this->group->onSuccess(this->group->buildResult());
+        }
+    }
+    else {
+        // a load which takes over a pending prefetch might change the
+        // callback thread concurrently, so claim the callback atomically
+        #if ORYOL_HAS_ATOMIC
+        const int state = this->callbackState.exchange(callbackClaimed);
+        #else
+        const int state = this->callbackState;
+        this->callbackState = callbackClaimed;
+        #endif
+        if ((WorkerThread == state) && (IOStatus::OK == this->Status)) {
+            this->onSuccess(result(this->Url, std::move(this->Data)));
+            this->callbackState = callbackInvoked;
+        }
+    }
+    // hand the request over to the main thread for cleanup and
+    // failure handling
+    this->queue->putCompleted(this);
+}
+
+//------------------------------------------------------------------------------
+Array<loadQueue::result>
+loadQueue::groupItem::buildResult() {
+    Array<result> result;
+    result.Reserve(this->ioRequests.Size());
+    for (const auto& ioReq : this->ioRequests) {
+        result.Add(ioReq->Url, std::move(ioReq->Data));
+    }
+    return result;
+}
+
+//------------------------------------------------------------------------------
+bool
+loadQueue::groupItem::anyFailed() const {
+    for (const auto& ioReq : this->ioRequests) {
+        if (IOStatus::OK != ioReq->Status) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void
+loadQueue::failed(const Ptr<request>& req, const failFunc& onFail) {
+    if (onFail) {
+        onFail(req->Url, req->Status);
+    }
+    else {
+        // no fail handler was set, just print a warning
+        o_warn("loadQueue:: failed to load file '%s' with '%s'\n",
+            req->Url.AsCStr(), IOStatus::ToString(req->Status));
+    }
 }
 
 //------------------------------------------------------------------------------
 void
 loadQueue::update() {
 
-    // check single items
-    for (int i = this->items.Size() - 1; i >= 0; --i) {
-        const item& curItem = this->items[i];
-        const auto& ioReq = curItem.ioRequest;
-        if (ioReq->Handled) {
-            // io request has been handled
-            if (IOStatus::OK == ioReq->Status) {
-                // io request was successful
-                curItem.onSuccess(result(ioReq->Url, std::move(ioReq->Data)));
+    // grab the completed requests, keep the lock only as long as necessary
+    o_assert_dbg(this->completedRead.Empty());
+    {
+        #if ORYOL_HAS_THREADS
+        std::lock_guard<std::mutex> lock(this->completedMutex);
+        #endif
+        if (!this->completed.Empty()) {
+            this->completedRead = std::move(this->completed);
+        }
+    }
+
+    // handle completed requests, note that only requests that
+    // have actually been handled are visited here, pending requests
+    // are not polled
+    for (const auto& ioReq : this->completedRead) {
+        if (ioReq->prefetch) {
+            this->prefetchCompleted(ioReq);
+        }
+        else if (ioReq->group) {
+            Ptr<groupItem> group = std::move(ioReq->group);
+            if (IOStatus::OK != ioReq->Status) {
+                failed(ioReq, group->onFail);
             }
-            else {
-                // io request failed
-                if (curItem.onFail) {
-                    curItem.onFail(ioReq->Url, ioReq->Status);
-                }
-                else {
-                    // no fail handler was set, just print a warning
-                    o_warn("loadQueue:: failed to load file '%s' with '%s'\n",
-                        ioReq->Url.AsCStr(), IOStatus::ToString(ioReq->Status));
+            if (++group->numCompleted == group->ioRequests.Size()) {
+                // all requests in the group have been handled, if all were
+                // successful, and the success callback must be called on
+                // the main thread, do this now
+                if ((MainThread == group->thread) && !group->anyFailed()) {
+                    group->onSuccess(group->buildResult());
                 }
+                this->removePendingGroup(group);
+                this->numPendingItems--;
             }
-            // remove the handled io request from the queue
-            this->items.Erase(i);
         }
-    }
-    
-    // check group items
-    for (int i = this->groupItems.Size() - 1; i >= 0; --i) {
-        const groupItem& curItem = this->groupItems[i];
-        bool allHandled = true;
-        bool anyFailed = false;
-        for (const auto& ioReq : curItem.ioRequests) {
-            if (ioReq->Handled) {
-                if (IOStatus::OK != ioReq->Status) {
-                    anyFailed = true;
-                    if (curItem.onFail) {
-                        curItem.onFail(ioReq->Url, ioReq->Status);
-                    }
-                    else {
-                        o_warn("loadQueue:: failed to load file '%s' with '%s'\n",
-                            ioReq->Url.AsCStr(), IOStatus::ToString(ioReq->Status));
-                    }
+        else if ((IOStatus::OK == ioReq->Status) && (WorkerThread == ioReq->thread) &&
+                 (request::callbackInvoked != ioReq->callbackState)) {
+            // a worker thread callback for a prefetch which had already
+            // been loaded when the load took over, still pending
+            this->forwardToWorker(ioReq);
+        }
+        else {
+            if (IOStatus::OK == ioReq->Status) {
+                if (MainThread == ioReq->thread) {
+                    ioReq->onSuccess(result(ioReq->Url, std::move(ioReq->Data)));
                 }
             }
             else {
-                allHandled = false;
-                break;
-            }
-        }
-        
-        // if all request in this group have been handled, remove item, and
-        // if all were successful, call the success-callback
-        if (allHandled) {
-            if (!anyFailed) {
-                Array<result> result;
-                result.Reserve(curItem.ioRequests.Size());
-                for (const auto& ioReq : curItem.ioRequests) {
-                    result.Add(ioReq->Url, std::move(ioReq->Data));
-                }
-                curItem.onSuccess(std::move(result));
+                failed(ioReq, ioReq->onFail);
             }
-            this->groupItems.Erase(i);
+            this->numPendingItems--;
         }
     }
+    this->completedRead.Clear();
 }
 
 } // namespace Oryol
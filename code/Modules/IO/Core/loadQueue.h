@@ -6,64 +6,202 @@
     @brief asynchronously load multiple files, invoke callbacks with result
 
     This is the class behind the IO::Load() and LoadGroup() functions.
+
+    The loadQueue doesn't poll its pending IO requests, instead the
+    IO worker threads push handled requests into a thread-safe
+    completion list, which is drained once per frame on the main thread.
+
+    Success callbacks can optionally be invoked directly on the IO
+    worker thread which handled the request (for instance to parse
+    or decode the loaded data without blocking the main thread), use
+    IO::PostToMainThread() (or a Promise/Future pair) to send results
+    back to the main thread from there. Failure callbacks are always invoked
+    on the main thread. The callbacks are InplaceFunction objects,
+    so queueing a load never allocates memory for the callbacks.
+
+    The loadQueue also manages the prefetch cache: prefetch() starts
+    low-priority requests whose results are kept in memory (up to a
+    byte budget, oldest entries are evicted first) until a later load
+    of the same URL consumes them, or cancelPrefetch() is called.
+    A load which hits a prefetched or still pending prefetch request
+    doesn't go through the filesystem again. A pending prefetch request
+    which is taken over by a load is raised to IOPriority::Normal, so
+    that it doesn't wait behind the remaining low-priority prefetches.
+    If the load wants its success callback on a worker thread, but the
+    prefetched data had already been loaded, the data is handed to an
+    IO worker thread which only invokes the callback.
+
+    The completed prefetches are kept in a doubly linked list through
+    the requests (oldest first), so that taking over, cancelling and
+    evicting prefetched data doesn't need to search the list.
 */
 #include "Core/Types.h"
 #include "Core/String/StringAtom.h"
 #include "Core/Containers/Array.h"
+#include "Core/Containers/Map.h"
 #include "Core/Containers/Buffer.h"
+#include "Core/Containers/SharedBuffer.h"
 #include "IO/Core/URL.h"
 #include "IO/Core/IOStatus.h"
+#include "IO/Core/IOPriority.h"
 #include "IO/FS/ioRequests.h"
-#include <functional>
+#include "Core/InplaceFunction.h"
+#if ORYOL_HAS_THREADS
+#include <mutex>
+#endif
 
 namespace Oryol {
-    
+
 class loadQueue {
 public:
-    /// loading result (iff successful)
+    /// loading result (iff successful), the data can be shared without copying
     struct result {
         result(const URL& url, Buffer&& data) : Url(url), Data(std::move(data)) { };
+        result(const result& rhs) : Url(rhs.Url), Data(rhs.Data) { };
         result(result&& rhs) {
             this->Url = std::move(rhs.Url);
             this->Data = std::move(rhs.Data);
         };
+        void operator=(const result& rhs) {
+            this->Url = rhs.Url;
+            this->Data = rhs.Data;
+        };
         void operator=(result&& rhs) {
             this->Url = std::move(rhs.Url);
-            this->Data = std::move(rhs.Data);            
+            this->Data = std::move(rhs.Data);
         };
         URL Url;
-        Buffer Data;
+        SharedBuffer Data;
     };
 
     /// callback function signature for success
-    typedef std::function<void(result result)> successFunc;
+    typedef InplaceFunction<void(result result)> successFunc;
     /// callback function signature for success when loading URL groups
-    typedef std::function<void(Array<result>)> groupSuccessFunc;
+    typedef InplaceFunction<void(Array<result>)> groupSuccessFunc;
     /// callback function signature for failure
-    typedef std::function<void(const URL& url, IOStatus::Code ioStatus)> failFunc;
+    typedef InplaceFunction<void(const URL& url, IOStatus::Code ioStatus)> failFunc;
+    /// the thread where success callbacks are invoked
+    enum callbackThread {
+        MainThread,     ///< on the main thread, during the IO runloop callback (default)
+        WorkerThread,   ///< on the IO worker thread which handled the request
+    };
+
+    /// constructor
+    loadQueue();
+    /// destructor
+    ~loadQueue();
 
     /// add a file load request to the queue
-    void add(const URL& url, successFunc onSuccess, failFunc onFail=failFunc());
+    void add(const URL& url, successFunc onSuccess, failFunc onFail=failFunc(), callbackThread thread=MainThread);
     /// add a file group request to the queue
-    void addGroup(const Array<URL>& urls, groupSuccessFunc onSuccess, failFunc onFail=failFunc());
+    void addGroup(const Array<URL>& urls, groupSuccessFunc onSuccess, failFunc onFail=failFunc(), callbackThread thread=MainThread);
     /// update the queue, called per frame from runloop
     void update();
     /// get number of pending load actions
     int numPending() const;
 
+    /// set the prefetch cache budget in bytes
+    void setPrefetchCacheSize(int numBytes);
+    /// start prefetching a file into the prefetch cache (no-op if already prefetched)
+    void prefetch(const URL& url, IOPriority::Code prio);
+    /// cancel a pending prefetch, or evict prefetched data
+    void cancelPrefetch(const URL& url);
+    /// cancel all pending prefetches and clear the prefetch cache
+    void cancelAllPrefetches();
+    /// take a pending or completed prefetch request out of the cache (used by IO::LoadFile)
+    Ptr<IORead> takePrefetched(const URL& url);
+    /// get number of bytes in the prefetch cache (completed prefetches only)
+    int prefetchCacheBytes() const;
+
 private:
-    struct item {
-        Ptr<IORead> ioRequest;
+    class groupItem;
+
+    /// an IORead request which knows about its loadQueue and callbacks
+    class request : public IORead {
+        OryolClassDecl(request);
+        OryolTypeDecl(request, IORead);
+    public:
+        /// called on the IO worker thread when the request has been handled
+        virtual void onHandled() override;
+
+        /// callbackState after the IO worker has looked at it
+        static const int callbackClaimed = 2;
+        /// callbackState after the IO worker has invoked the success callback
+        static const int callbackInvoked = 3;
+
+        loadQueue* queue = nullptr;
+        bool prefetch = false;      // only accessed on main thread
+        callbackThread thread = MainThread;     // only accessed on main thread
+        /// the thread which invokes the success callback, claimed by the IO worker in onHandled()
+        #if ORYOL_HAS_ATOMIC
+        std::atomic<int> callbackState{MainThread};
+        #else
+        int callbackState = MainThread;
+        #endif
         successFunc onSuccess;
         failFunc onFail;
+        Ptr<groupItem> group;
+        request* olderPrefetch = nullptr;   // prefetch list links, only accessed on main thread
+        request* newerPrefetch = nullptr;
+        bool inPrefetchList = false;
     };
-    Array<item> items;
-    struct groupItem {
-        Array<Ptr<IORead>> ioRequests;
+
+    /// state shared between the requests of a LoadGroup() call
+    class groupItem : public RefCounted {
+        OryolClassDecl(groupItem);
+    public:
+        /// build group result array, moves data out of requests
+        Array<result> buildResult();
+        /// return true if any of the group's requests has failed
+        bool anyFailed() const;
+
+        Array<Ptr<request>> ioRequests;
+        callbackThread thread = MainThread;
         groupSuccessFunc onSuccess;
         failFunc onFail;
+        int numCompleted = 0;       // only accessed on main thread
+        int pendingIndex = InvalidIndex;    // index in loadQueue::pendingGroups, only accessed on main thread
+        #if ORYOL_HAS_ATOMIC
+        std::atomic<int> numHandled{0};
+        #else
+        int numHandled = 0;
+        #endif
     };
-    Array<groupItem> groupItems;
+
+    /// called from IO worker thread when a request has been handled
+    void putCompleted(const Ptr<request>& req);
+    /// invoke failure callback or print a warning
+    static void failed(const Ptr<request>& req, const failFunc& onFail);
+    /// handle a completed prefetch request on the main thread
+    void prefetchCompleted(const Ptr<request>& req);
+    /// remove a prefetch cache entry (doesn't cancel the request)
+    Ptr<request> removePrefetched(const StringAtom& key);
+    /// raise a pending prefetch request which is taken over by a load to normal priority
+    static void raisePriority(const Ptr<request>& req);
+    /// evict oldest prefetched data until the cache fits into its budget
+    void evictPrefetched();
+    /// append a completed prefetch to the prefetch list
+    void linkPrefetched(request* req);
+    /// remove a completed prefetch from the prefetch list
+    void unlinkPrefetched(request* req);
+    /// hand loaded data to an IO worker thread which invokes the success callback
+    void forwardToWorker(const Ptr<request>& req);
+    /// remove a finished group from the pending groups
+    void removePendingGroup(const Ptr<groupItem>& group);
+
+    int numPendingItems;
+    #if ORYOL_HAS_THREADS
+    std::mutex completedMutex;
+    #endif
+    Array<Ptr<request>> completed;      // written by IO threads, locked
+    Array<Ptr<request>> completedRead;  // only accessed on main thread
+    Array<Ptr<groupItem>> pendingGroups;    // groups with unfinished requests
+
+    Map<StringAtom, Ptr<request>> prefetchCache;    // pending and completed prefetches
+    request* oldestPrefetch = nullptr;  // list of completed prefetches, owned by prefetchCache
+    request* newestPrefetch = nullptr;
+    int prefetchBytes = 0;
+    int prefetchBudget = 0;
 };
 
 } // namespace Oryol
@@ -35,4 +35,48 @@ FileSystem::onMsg(const Ptr<IORequest>& ioReq) {
     o_warn("FileSystem::onMsg(): message not handled by FileSystem!\n");
 }
 
+//------------------------------------------------------------------------------
+bool
+FileSystem::MatchGlob(const char* pattern, const char* str) {
+    o_assert_dbg(pattern && str);
+    // iterative matching with backtracking to the last '*'
+    const char* starPattern = nullptr;
+    const char* starStr = nullptr;
+    while (*str) {
+        if ((*pattern == '?') || ((*pattern != '*') && (*pattern == *str))) {
+            pattern++;
+            str++;
+        }
+        else if (*pattern == '*') {
+            starPattern = ++pattern;
+            starStr = str;
+        }
+        else if (starPattern) {
+            pattern = starPattern;
+            str = ++starStr;
+        }
+        else {
+            return false;
+        }
+    }
+    while (*pattern == '*') {
+        pattern++;
+    }
+    return 0 == *pattern;
+}
+
+//------------------------------------------------------------------------------
+bool
+FileSystem::MatchFilters(const Array<String>& filters, const char* str) {
+    if (filters.Empty()) {
+        return true;
+    }
+    for (const String& filter : filters) {
+        if (MatchGlob(filter.AsCStr(), str)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace Oryol
\ No newline at end of file
@@ -7,6 +7,10 @@
 
     Subclasses of FileSystem provide a specific file-system implementation
     (e.g. HttpFileSystem, HostFileSystem, etc).
+
+    Besides IORead and IOWrite, a filesystem can implement the IOStat,
+    IOStatBatch and IOListDir requests, requests a filesystem doesn't
+    implement must be set to handled with IOStatus::NotImplemented.
 */
 #include "Core/String/StringAtom.h"
 #include "Core/RefCounted.h"
@@ -29,6 +33,11 @@ public:
     /// called when IO message should be handled
     virtual void onMsg(const Ptr<IORequest>& ioReq);
 
+    /// match a file name against a glob pattern with '*' and '?' wildcards
+    static bool MatchGlob(const char* pattern, const char* str);
+    /// match a file name against a list of glob patterns (an empty list matches everything)
+    static bool MatchFilters(const Array<String>& filters, const char* str);
+
     StringAtom scheme;
 };
     
@@ -0,0 +1,22 @@
+//------------------------------------------------------------------------------
+//  ioRequests.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "ioRequests.h"
+#include "IO/FS/ioWorker.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+void
+IORequest::SetHandled() {
+    // NOTE: the request may be destroyed on the worker thread as soon
+    // as Handled is set, so the worker pointer must be read first
+    _priv::ioWorker* ioWorker = this->worker;
+    this->Handled = true;
+    if (ioWorker) {
+        ioWorker->notifyHandled();
+    }
+}
+
+} // namespace Oryol
@@ -10,11 +10,14 @@
 */
 #include "Core/RefCounted.h"
 #include "Core/Containers/Buffer.h"
+#include "Core/Containers/Array.h"
 #include "IO/Core/URL.h"
 #include "IO/Core/IOStatus.h"
+#include "IO/Core/IOPriority.h"
 
 namespace Oryol {
 namespace _priv {
+class ioWorker;
 //------------------------------------------------------------------------------
 class ioMsg : public RefCounted {
     OryolClassDecl(ioMsg);
@@ -42,6 +45,26 @@ public:
     Buffer Data;
     IOStatus::Code Status = IOStatus::InvalidIOStatus;
     String ErrorDesc;
+    /// the IO worker handles requests with higher priority first
+    #if ORYOL_HAS_ATOMIC
+    std::atomic<IOPriority::Code> Priority{IOPriority::Normal};
+    #else
+    IOPriority::Code Priority = IOPriority::Normal;
+    #endif
+    /// set by the IO worker which picked up the request (a request is queued twice if its priority is raised)
+    #if ORYOL_HAS_ATOMIC
+    std::atomic<bool> Dispatched{false};
+    #else
+    bool Dispatched = false;
+    #endif
+
+    /// called by the IO worker thread after the request has been handled
+    virtual void onHandled() { };
+    /// set Handled and wake up the IO worker, use this if a filesystem handles the request on another thread
+    void SetHandled();
+
+    /// the IO worker which dispatched the request to a filesystem
+    _priv::ioWorker* worker = nullptr;
 };
 
 //------------------------------------------------------------------------------
@@ -57,6 +80,64 @@ public:
 class IOWrite : public IORequest {
     OryolClassDecl(IOWrite);
     OryolTypeDecl(IOWrite, IORequest);
+public:
+    /// append the data to the file instead of replacing the file
+    bool Append = false;
+    /// flush the file to disk before the request is handled
+    bool Sync = false;
+};
+
+//------------------------------------------------------------------------------
+/// file attributes returned by IOStat, IOStatBatch and IOListDir
+class IOFileInfo {
+public:
+    /// file path (relative to the request URL for IOStatBatch and IOListDir)
+    String Path;
+    /// file size in bytes
+    int64_t Size = 0;
+    /// last modification time in seconds since the epoch
+    int64_t ModTime = 0;
+    /// true if the file exists
+    bool Exists = false;
+    /// true if this is a directory
+    bool IsDirectory = false;
+};
+
+//------------------------------------------------------------------------------
+/// get attributes of the file at Url, Status is NotFound if it doesn't exist
+class IOStat : public IORequest {
+    OryolClassDecl(IOStat);
+    OryolTypeDecl(IOStat, IORequest);
+public:
+    IOFileInfo Info;
+};
+
+//------------------------------------------------------------------------------
+/// get attributes of many files relative to the directory at Url in one request
+class IOStatBatch : public IORequest {
+    OryolClassDecl(IOStatBatch);
+    OryolTypeDecl(IOStatBatch, IORequest);
+public:
+    /// file paths relative to Url
+    Array<String> Paths;
+    /// one entry per path, check IOFileInfo::Exists
+    Array<IOFileInfo> Infos;
+};
+
+//------------------------------------------------------------------------------
+/// list the directory at Url
+class IOListDir : public IORequest {
+    OryolClassDecl(IOListDir);
+    OryolTypeDecl(IOListDir, IORequest);
+public:
+    /// also list the content of sub-directories (symlinked directories are not descended into)
+    bool Recursive = false;
+    /// also return entries for directories (not filtered)
+    bool IncludeDirectories = false;
+    /// glob patterns (with '*' and '?') for file names, empty lists all files
+    Array<String> Filters;
+    /// the directory entries, paths are relative to Url
+    Array<IOFileInfo> Entries;
 };
 
 //------------------------------------------------------------------------------
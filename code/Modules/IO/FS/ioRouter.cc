@@ -40,6 +40,13 @@ ioRouter::put(const Ptr<ioMsg>& msg) {
             worker.put(msg);
         }
     }
+    else if (msg->IsA<IOWrite>()) {
+        // writes to the same URL always go through the same worker,
+        // so that they arrive at the filesystem in submission order
+        const URL& url = msg->DynamicCast<IOWrite>()->Url;
+        const int worker = int(HashTraits<URL>::Compute(url) % IOConfig::NumWorkers);
+        this->workers[worker].put(msg);
+    }
     else {
         // for all other messages, use a round-robin dispatch
         this->curWorker = (this->curWorker + 1) % IOConfig::NumWorkers;
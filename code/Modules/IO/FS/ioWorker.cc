@@ -30,11 +30,20 @@ ioWorker::start(const ioPointers& ptrs) {
 void
 ioWorker::stop() {
     o_assert(this->threadStartRequested);
-    this->threadStopRequested = true;
     #if ORYOL_HAS_THREADS
+        {
+            std::lock_guard<std::mutex> lock(this->transferMutex);
+            this->threadStopRequested = true;
+        }
         this->transferCondVar.notify_one();
         this->thread.join();
+    #else
+        this->threadStopRequested = true;
     #endif
+    // destroy the filesystems while the worker is still alive, since
+    // filesystems which complete requests on their own threads notify
+    // the worker about it (see IORequest::SetHandled())
+    this->fileSystems.Clear();
     this->threadStopped = true;
 }
 
@@ -71,10 +80,24 @@ ioWorker::doWork() {
     #if !ORYOL_HAS_THREADS
         // if platform has no threads, pump the message queue right
         // FIXME: we could do without all those queue transfers here!
-        this->moveTransferToReadQueue();
-        while (!this->readQueue.Empty()) {
-            this->onMsg(std::move(this->readQueue.Dequeue()));
+        this->moveTransferToReadQueues();
+        while (this->hasReadMessages()) {
+            this->handleNextMessage();
         }
+        this->checkInflight();
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+ioWorker::notifyHandled() {
+    // NOTE: without threads, doWork() checks the in-flight requests each frame
+    #if ORYOL_HAS_THREADS
+    {
+        std::lock_guard<std::mutex> lock(this->transferMutex);
+        this->inflightHandled = true;
+    }
+    this->transferCondVar.notify_one();
     #endif
 }
 
@@ -88,18 +111,27 @@ ioWorker::threadFunc(ioWorker* self) {
     // moves them from the transfer queue, processes them then goes back to sleep
     while (!self->threadStopRequested) {
 
-        // wait for messages to arrive, and if so, transfer to read queue
+        // wait for messages to arrive or in-flight requests to be
+        // handled, and if so, transfer to read queues, if there's
+        // still queued work, don't wait at all
         {
             std::unique_lock<std::mutex> lock(self->transferMutex);
-            self->transferCondVar.wait(lock);
-            self->moveTransferToReadQueue();
+            while (self->transferQueue.Empty() && !self->hasReadMessages() &&
+                   !self->inflightHandled && !self->threadStopRequested) {
+                self->transferCondVar.wait(lock);
+            }
+            self->inflightHandled = false;
+            self->moveTransferToReadQueues();
             lock.unlock();
         }
 
-        // now process the messages, this happens without locking
-        while (!self->readQueue.Empty()) {
-            self->onMsg(std::move(self->readQueue.Dequeue()));
+        // now process the next message, this happens without locking,
+        // only one message is handled before checking for new messages
+        // so that newly arrived high-priority requests come first
+        if (self->hasReadMessages()) {
+            self->handleNextMessage();
         }
+        self->checkInflight();
     }
 }
 #endif
@@ -147,10 +179,40 @@ ioWorker::moveWriteToTransferQueue() {
 
 //------------------------------------------------------------------------------
 void
-ioWorker::moveTransferToReadQueue() {
+ioWorker::moveTransferToReadQueues() {
     o_assert(this->isWorkerThread());
-    o_assert(this->readQueue.Empty());
-    this->readQueue = std::move(this->transferQueue);
+    while (!this->transferQueue.Empty()) {
+        Ptr<ioMsg> msg = this->transferQueue.Dequeue();
+        IOPriority::Code prio = IOPriority::High;
+        if (msg->IsA<IORequest>()) {
+            prio = msg->DynamicCast<IORequest>()->Priority;
+            o_assert_dbg((prio >= 0) && (prio < IOPriority::NumPriorities));
+        }
+        this->readQueues[prio].Enqueue(std::move(msg));
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+ioWorker::hasReadMessages() const {
+    for (const auto& queue : this->readQueues) {
+        if (!queue.Empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void
+ioWorker::handleNextMessage() {
+    o_assert_dbg(this->isWorkerThread());
+    for (auto& queue : this->readQueues) {
+        if (!queue.Empty()) {
+            this->onMsg(queue.Dequeue());
+            return;
+        }
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -172,6 +234,7 @@ ioWorker::checkCancelled(const Ptr<IORequest>& msg) {
     if (msg->Cancelled) {
         msg->Status = IOStatus::Cancelled;
         msg->Handled = true;
+        msg->onHandled();
         return true;
     }
     else {
@@ -179,6 +242,19 @@ ioWorker::checkCancelled(const Ptr<IORequest>& msg) {
     }
 }
 
+//------------------------------------------------------------------------------
+void
+ioWorker::checkInflight() {
+    o_assert_dbg(this->isWorkerThread());
+    for (int i = this->inflight.Size() - 1; i >= 0; i--) {
+        const Ptr<IORequest>& ioReq = this->inflight[i];
+        if (ioReq->Handled) {
+            ioReq->onHandled();
+            this->inflight.Erase(i);
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 void
 ioWorker::onMsg(const Ptr<ioMsg>& msg) {
@@ -187,10 +263,34 @@ ioWorker::onMsg(const Ptr<ioMsg>& msg) {
         // the filesystem is responsible to set the
         // request to 'handled'!
         Ptr<IORequest> ioReq = msg->DynamicCast<IORequest>();
-        if (!this->checkCancelled(ioReq)) {
+        // a request which has been queued again with a higher priority
+        // is only handled by the worker which gets to it first
+        #if ORYOL_HAS_ATOMIC
+        if (ioReq->Dispatched.exchange(true)) {
+            return;
+        }
+        #else
+        if (ioReq->Dispatched) {
+            return;
+        }
+        ioReq->Dispatched = true;
+        #endif
+        if (ioReq->Handled) {
+            // the request was already handled when it was put (the loadQueue
+            // does this to invoke worker thread callbacks for loaded data)
+            ioReq->onHandled();
+        }
+        else if (!this->checkCancelled(ioReq)) {
             Ptr<FileSystem> fs = this->fileSystemForURL(ioReq->Url);
             if (fs) {
+                ioReq->worker = this;
                 fs->onMsg(ioReq);
+                if (ioReq->Handled) {
+                    ioReq->onHandled();
+                }
+                else {
+                    this->inflight.Add(ioReq);
+                }
             }
         }
     }
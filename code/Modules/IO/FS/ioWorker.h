@@ -10,9 +10,30 @@
     runloop-frame, messages from the main thread will be moved to a
     'transfer queue', and the worker thread will be signaled. The 
     worker thread wakes up, moves the messages from the transfer queue
-    to a read-queue, processes them and goes back to sleep.
+    to one read-queue per IOPriority, processes them and goes back to sleep.
+
+    The worker always handles the next message from the highest-priority
+    read-queue which isn't empty, and checks the transfer queue for new
+    messages after each handled message, so that low-priority requests
+    (like prefetches) never hold up more important requests. To raise
+    the priority of a queued request, set its new Priority and put it
+    again, the request is only handled by the first worker which picks
+    it up, the other queue entry is dropped.
+
+    Once a request has been handled by a filesystem, the worker
+    calls the request's onHandled() method, this is used to notify
+    the loadQueue about completed requests without polling. If a
+    filesystem handles a request asynchronously, the request is
+    kept in an 'in-flight' list, the filesystem must complete the
+    request with IORequest::SetHandled(), which wakes up the worker
+    to check its in-flight list. The worker thread never polls, it
+    sleeps until new messages arrive or an in-flight request is done.
+    A request which is already handled when it is put isn't passed
+    to a filesystem, only its onHandled() method is called.
 */
 #include "Core/Containers/Queue.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/StaticArray.h"
 #include "Core/Containers/Map.h"
 #include "Core/String/StringAtom.h"
 #include "IO/Core/ioPointers.h"
@@ -40,12 +61,16 @@ public:
     void put(const Ptr<ioMsg>& msg);
     /// do work on the main thread, this moves queued messages to transfer queue
     void doWork();
+    /// wake up the worker thread after an in-flight request has been handled (called from any thread)
+    void notifyHandled();
 
 private:
     /// lookup filesystem for URL
     Ptr<FileSystem> fileSystemForURL(const URL& url);
     /// check for and handle cancelled message
     bool checkCancelled(const Ptr<IORequest>& msg);
+    /// check in-flight requests for completion
+    void checkInflight();
     /// called from thread to handle a generic message
     void onMsg(const Ptr<ioMsg>& msg);
     /// the thread worker func
@@ -58,15 +83,20 @@ private:
     bool isWorkerThread();
     /// move messages from the write queue to the transfer queue
     void moveWriteToTransferQueue();
-    /// move messages from transfer queue to read queue
-    void moveTransferToReadQueue();
+    /// move messages from transfer queue to the priority read queues
+    void moveTransferToReadQueues();
+    /// return true if any of the read queues contains messages
+    bool hasReadMessages() const;
+    /// handle the next message from the highest-priority read queue
+    void handleNextMessage();
 
     ioPointers pointers;
     Map<StringAtom, Ptr<FileSystem>> fileSystems;
 
     Queue<Ptr<ioMsg>> writeQueue;     // written by sender thread
     Queue<Ptr<ioMsg>> transferQueue;  // written by sender, read by worker thread (locked)
-    Queue<Ptr<ioMsg>> readQueue;      // read by worker thread
+    StaticArray<Queue<Ptr<ioMsg>>, IOPriority::NumPriorities> readQueues;  // read by worker thread
+    Array<Ptr<IORequest>> inflight;   // requests handled asynchronously by a filesystem
 
     #if ORYOL_HAS_THREADS
     std::thread::id sendThreadId;
@@ -74,6 +104,7 @@ private:
     std::thread thread;
     std::mutex transferMutex;
     std::condition_variable transferCondVar;
+    bool inflightHandled = false;     // set by notifyHandled(), protected by transferMutex
     #endif
     #if ORYOL_HAS_ATOMIC
     std::atomic<bool> threadStopRequested;
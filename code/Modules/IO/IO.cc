@@ -33,6 +33,7 @@ IO::Setup(const IOSetup& setup) {
     for (const auto& fs : setup.FileSystems) {
         RegisterFileSystem(fs.Key(), fs.Value());
     }
+    state->loadQueue.setPrefetchCacheSize(setup.PrefetchCacheSize);
 
     state->runLoopId = Core::PreRunLoop()->Add([] { doWork(); });
 }
@@ -54,6 +55,9 @@ IO::doWork() {
     o_assert_dbg(Core::IsMainThread());
     state->router.doWork();
     state->loadQueue.update();
+    if (!state->overlayMounts.Empty()) {
+        updateOverlayMounts();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -89,6 +93,82 @@ IO::ResolveAssigns(const String& str) {
     return state->assignReg.ResolveAssigns(str);
 }
 
+//------------------------------------------------------------------------------
+/**
+    The overlay assign is usable immediately, but until the layer
+    directories have been listed all paths resolve to the first layer.
+    A layer which can't be listed is treated as empty.
+*/
+void
+IO::MountOverlay(const String& assign, const Array<String>& layers, std::function<void()> onMounted) {
+    o_assert_dbg(IsValid());
+    state->assignReg.SetOverlay(assign, layers);
+    overlayMount mount;
+    mount.assign = assign;
+    mount.onMounted = onMounted;
+    for (const String& layer : layers) {
+        mount.listings.Add(ListDir(URL(layer), Array<String>(), true));
+    }
+    state->overlayMounts.Add(std::move(mount));
+}
+
+//------------------------------------------------------------------------------
+void
+IO::UnmountOverlay(const String& assign) {
+    o_assert_dbg(IsValid());
+    for (int i = state->overlayMounts.Size() - 1; i >= 0; i--) {
+        if (state->overlayMounts[i].assign == assign) {
+            for (const auto& listing : state->overlayMounts[i].listings) {
+                listing->Cancelled = true;
+            }
+            state->overlayMounts.Erase(i);
+        }
+    }
+    state->assignReg.RemoveOverlay(assign);
+}
+
+//------------------------------------------------------------------------------
+bool
+IO::HasOverlay(const String& assign) {
+    o_assert_dbg(IsValid());
+    return state->assignReg.HasOverlay(assign);
+}
+
+//------------------------------------------------------------------------------
+void
+IO::updateOverlayMounts() {
+    for (int i = 0; i < state->overlayMounts.Size();) {
+        overlayMount& mount = state->overlayMounts[i];
+        bool allHandled = true;
+        for (const auto& listing : mount.listings) {
+            allHandled &= listing->Handled;
+        }
+        if (!allHandled) {
+            i++;
+            continue;
+        }
+        Array<assignRegistry::overlayEntry> entries;
+        for (int layer = 0; layer < mount.listings.Size(); layer++) {
+            const Ptr<IOListDir>& listing = mount.listings[layer];
+            if (IOStatus::OK != listing->Status) {
+                continue;
+            }
+            for (const IOFileInfo& info : listing->Entries) {
+                if (!info.IsDirectory) {
+                    const uint64_t hash = assignRegistry::OverlayPathHash(info.Path.AsCStr(), info.Path.Length());
+                    entries.Add(assignRegistry::overlayEntry{ hash, layer });
+                }
+            }
+        }
+        state->assignReg.SetOverlayIndex(mount.assign, std::move(entries));
+        std::function<void()> onMounted = std::move(mount.onMounted);
+        state->overlayMounts.Erase(i);
+        if (onMounted) {
+            onMounted();
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 void
 IO::RegisterFileSystem(const StringAtom& scheme, std::function<Ptr<FileSystem>()> fsCreator) {
@@ -126,16 +206,16 @@ IO::IsFileSystemRegistered(const StringAtom& scheme) {
 
 //------------------------------------------------------------------------------
 void
-IO::Load(const URL& url, LoadSuccessFunc onSuccess, LoadFailedFunc onFailed) {
+IO::Load(const URL& url, LoadSuccessFunc onSuccess, LoadFailedFunc onFailed, CallbackThread thread) {
     o_assert_dbg(IsValid());
-    state->loadQueue.add(url, onSuccess, onFailed);
+    state->loadQueue.add(url, std::move(onSuccess), std::move(onFailed), thread);
 }
 
 //------------------------------------------------------------------------------
 void
-IO::LoadGroup(const Array<URL>& urls, LoadGroupSuccessFunc onSuccess, LoadFailedFunc onFailed) {
+IO::LoadGroup(const Array<URL>& urls, LoadGroupSuccessFunc onSuccess, LoadFailedFunc onFailed, CallbackThread thread) {
     o_assert_dbg(IsValid());
-    state->loadQueue.addGroup(urls, onSuccess, onFailed);
+    state->loadQueue.addGroup(urls, std::move(onSuccess), std::move(onFailed), thread);
 }
 
 //------------------------------------------------------------------------------
@@ -145,10 +225,61 @@ IO::NumPendingLoads() {
     return state->loadQueue.numPending();
 }
 
+//------------------------------------------------------------------------------
+/**
+    NOTE: this may be called from any thread, for instance from
+    a success callback running on an IO worker thread. This is
+    just a shortcut for Core::MainRunLoop()->Post().
+*/
+void
+IO::PostToMainThread(MainThreadFunc func) {
+    o_assert_dbg(IsValid());
+    Core::MainRunLoop()->Post(std::move(func));
+}
+
+//------------------------------------------------------------------------------
+void
+IO::Prefetch(const Array<URL>& urls, IOPriority::Code prio) {
+    o_assert_dbg(IsValid());
+    for (const URL& url : urls) {
+        state->loadQueue.prefetch(url, prio);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+IO::CancelPrefetch(const Array<URL>& urls) {
+    o_assert_dbg(IsValid());
+    for (const URL& url : urls) {
+        state->loadQueue.cancelPrefetch(url);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+IO::CancelAllPrefetches() {
+    o_assert_dbg(IsValid());
+    state->loadQueue.cancelAllPrefetches();
+}
+
+//------------------------------------------------------------------------------
+int
+IO::PrefetchCacheBytes() {
+    o_assert_dbg(IsValid());
+    return state->loadQueue.prefetchCacheBytes();
+}
+
 //------------------------------------------------------------------------------
 Ptr<IORead>
 IO::LoadFile(const URL& url) {
     o_assert_dbg(IsValid());
+
+    // if the file has been prefetched, return the prefetch request
+    // (which might still be in flight)
+    Ptr<IORead> prefetched = state->loadQueue.takePrefetched(url);
+    if (prefetched) {
+        return prefetched;
+    }
     Ptr<IORead> ioReq = IORead::Create();
     ioReq->Url = url;
     state->router.put(ioReq);
@@ -162,6 +293,39 @@ IO::WriteFile(const URL& url, const Buffer& data) {
     Ptr<IOWrite> ioReq = IOWrite::Create();
     ioReq->Url = url;
     ioReq->Data.Add(data.Data(), data.Size());
+    Put(ioReq);
+    return ioReq;
+}
+
+//------------------------------------------------------------------------------
+Ptr<IOStat>
+IO::Stat(const URL& url) {
+    o_assert_dbg(IsValid());
+    Ptr<IOStat> ioReq = IOStat::Create();
+    ioReq->Url = url;
+    state->router.put(ioReq);
+    return ioReq;
+}
+
+//------------------------------------------------------------------------------
+Ptr<IOStatBatch>
+IO::StatBatch(const URL& dirUrl, const Array<String>& paths) {
+    o_assert_dbg(IsValid());
+    Ptr<IOStatBatch> ioReq = IOStatBatch::Create();
+    ioReq->Url = dirUrl;
+    ioReq->Paths = paths;
+    state->router.put(ioReq);
+    return ioReq;
+}
+
+//------------------------------------------------------------------------------
+Ptr<IOListDir>
+IO::ListDir(const URL& dirUrl, const Array<String>& filters, bool recursive) {
+    o_assert_dbg(IsValid());
+    Ptr<IOListDir> ioReq = IOListDir::Create();
+    ioReq->Url = dirUrl;
+    ioReq->Filters = filters;
+    ioReq->Recursive = recursive;
     state->router.put(ioReq);
     return ioReq;
 }
@@ -170,6 +334,10 @@ IO::WriteFile(const URL& url, const Buffer& data) {
 void
 IO::Put(const Ptr<IORequest>& ioReq) {
     o_assert_dbg(IsValid());
+    if (ioReq->IsA<IOWrite>() && ioReq->Url.HasPath()) {
+        // a written file may change which overlay layer a path resolves to
+        state->assignReg.AddOverlayFile(ioReq->Url.Get().AsString());
+    }
     state->router.put(ioReq);
 }
 
@@ -36,6 +36,13 @@ public:
     static String LookupAssign(const String& assign);
     /// resolve assigns in the provided string
     static String ResolveAssigns(const String& str);
+
+    /// mount an overlay assign over layer locations (first layer wins), index is built asynchronously
+    static void MountOverlay(const String& assign, const Array<String>& layers, std::function<void()> onMounted=nullptr);
+    /// unmount an overlay assign
+    static void UnmountOverlay(const String& assign);
+    /// check if an overlay assign is mounted
+    static bool HasOverlay(const String& assign);
     
     /// associate URL scheme with filesystem
     static void RegisterFileSystem(const StringAtom& scheme, std::function<Ptr<FileSystem>()> fsCreator);
@@ -52,31 +59,61 @@ public:
     typedef loadQueue::failFunc LoadFailedFunc;
     /// result of an asynchronous loading operation
     typedef loadQueue::result LoadResult;
+    /// function posted to the main thread
+    typedef RunLoop::Func MainThreadFunc;
+    /// thread where success callbacks are invoked (MainThread or WorkerThread)
+    typedef loadQueue::callbackThread CallbackThread;
     
     /// async load a file, with success and fail callbacks
-    static void Load(const URL& url, LoadSuccessFunc onSuccess, LoadFailedFunc onFailed=LoadFailedFunc());
+    static void Load(const URL& url, LoadSuccessFunc onSuccess, LoadFailedFunc onFailed=LoadFailedFunc(), CallbackThread thread=CallbackThread::MainThread);
     /// async load a group of files, with success and fail callbacks
-    static void LoadGroup(const Array<URL>& urls, LoadGroupSuccessFunc onSuccess, LoadFailedFunc onFailed=LoadFailedFunc());
+    static void LoadGroup(const Array<URL>& urls, LoadGroupSuccessFunc onSuccess, LoadFailedFunc onFailed=LoadFailedFunc(), CallbackThread thread=CallbackThread::MainThread);
     /// get number of pending Load() and LoadGroup() actions
     static int NumPendingLoads();
+    /// call a function at the start of the main run loop's next Run() (thread-safe)
+    static void PostToMainThread(MainThreadFunc func);
+
+    /// start loading files into the prefetch cache without consuming them
+    static void Prefetch(const Array<URL>& urls, IOPriority::Code prio=IOPriority::Low);
+    /// cancel pending prefetches and evict prefetched data
+    static void CancelPrefetch(const Array<URL>& urls);
+    /// cancel all pending prefetches and clear the prefetch cache
+    static void CancelAllPrefetches();
+    /// get number of bytes currently held in the prefetch cache
+    static int PrefetchCacheBytes();
 
     /// low-level: start async loading of file from URL, return message for polling result
     static Ptr<IORead> LoadFile(const URL& url);
     /// low-level: start async writing of file via URL, return message for polling result
     static Ptr<IOWrite> WriteFile(const URL& url, const Buffer& data);
+    /// low-level: start async query of file attributes
+    static Ptr<IOStat> Stat(const URL& url);
+    /// low-level: start async query of attributes of many files relative to a directory URL
+    static Ptr<IOStatBatch> StatBatch(const URL& dirUrl, const Array<String>& paths);
+    /// low-level: start async listing of a directory, optionally filtered by glob patterns
+    static Ptr<IOListDir> ListDir(const URL& dirUrl, const Array<String>& filters=Array<String>(), bool recursive=false);
     /// low-level: push a generic asynchronous IO request
     static void Put(const Ptr<IORequest>& ioReq);
     
 private:
     /// pump the ioRequestRouter
     static void doWork();
+    /// build overlay indices from finished directory listings
+    static void updateOverlayMounts();
 
+    /// an overlay which is waiting for its layer listings
+    struct overlayMount {
+        String assign;
+        Array<Ptr<IOListDir>> listings;
+        std::function<void()> onMounted;
+    };
     struct _state {
         _priv::assignRegistry assignReg;
         _priv::schemeRegistry schemeReg;
         _priv::ioRouter router;
         RunLoop::Id runLoopId = RunLoop::InvalidId;
         class loadQueue loadQueue;
+        Array<overlayMount> overlayMounts;
     };
     static _state* state;
 };
@@ -6,6 +6,11 @@
 #include "IO/IO.h"
 #include "Core/Core.h"
 #include "Core/RunLoop.h"
+#include "Core/String/StringBuilder.h"
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 
 using namespace Oryol;
 
@@ -22,6 +27,45 @@ public:
             numRequestsHandled++;
         
             Ptr<IORead> ioRead = msg->DynamicCast<IORead>();
+            if (ioRead->Url.Path() == "fail.txt") {
+                ioRead->Status = IOStatus::NotFound;
+            }
+            else {
+                static const uint8_t payload[] = {'A', 'B', 'C', 'D'};
+                ioRead->Data.Add(payload, sizeof(payload));
+                ioRead->Status = IOStatus::OK;
+            }
+        }
+        msg->Handled = true;
+    };
+};
+
+// blocks reads of 'gate.txt' until the gate is opened, and records
+// which worker thread handled which file in which order
+std::atomic<bool> gateOpen{false};
+std::atomic<int> numGated{0};
+std::mutex handledMutex;
+Array<std::thread::id> handledThreads;
+Array<String> handledPaths;
+
+class GatedFileSystem : public FileSystem {
+    OryolClassDecl(GatedFileSystem);
+    OryolClassCreator(GatedFileSystem);
+public:
+    virtual void onMsg(const Ptr<IORequest>& msg) override {
+        if (msg->IsA<IORead>()) {
+            Ptr<IORead> ioRead = msg->DynamicCast<IORead>();
+            if (ioRead->Url.Path() == "gate.txt") {
+                numGated++;
+                while (!gateOpen) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            else {
+                std::lock_guard<std::mutex> lock(handledMutex);
+                handledThreads.Add(std::this_thread::get_id());
+                handledPaths.Add(ioRead->Url.Path());
+            }
             static const uint8_t payload[] = {'A', 'B', 'C', 'D'};
             ioRead->Data.Add(payload, sizeof(payload));
             ioRead->Status = IOStatus::OK;
@@ -30,6 +74,37 @@ public:
     };
 };
 
+// completes reads on its own threads, and never completes 'never.txt'
+std::mutex asyncMutex;
+Array<std::thread> asyncThreads;
+
+class AsyncFileSystem : public FileSystem {
+    OryolClassDecl(AsyncFileSystem);
+    OryolClassCreator(AsyncFileSystem);
+public:
+    virtual void onMsg(const Ptr<IORequest>& msg) override {
+        if (msg->IsA<IORead>() && (msg->Url.Path() != "never.txt")) {
+            Ptr<IORequest> ioReq = msg;
+            std::lock_guard<std::mutex> lock(asyncMutex);
+            asyncThreads.Add(std::thread([ioReq] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                static const uint8_t payload[] = {'A', 'B', 'C', 'D'};
+                ioReq->Data.Add(payload, sizeof(payload));
+                ioReq->Status = IOStatus::OK;
+                ioReq->SetHandled();
+            }));
+        }
+    };
+};
+
+// counts live copies, to check that callbacks are destroyed
+std::atomic<int> numLiveTrackers{0};
+struct liveTracker {
+    liveTracker() { numLiveTrackers++; };
+    liveTracker(const liveTracker& rhs) { numLiveTrackers++; };
+    ~liveTracker() { numLiveTrackers--; };
+};
+
 // try to find out which of the IO tests hangs in travis-ci
 #if !ORYOL_EMSCRIPTEN && !ORYOL_UNITTESTS_HEADLESS
 TEST(IOFacadeTest) {
@@ -70,4 +145,273 @@ TEST(IOFacadeTest) {
     IO::Discard();
     Core::Discard();
 }
+
+TEST(IOLoadQueueTest) {
+    Core::Setup();
+    IO::Setup(IOSetup());
+    IO::RegisterFileSystem("test", TestFileSystem::Creator());
+
+    // success callback on main thread
+    std::thread::id mainThreadId = std::this_thread::get_id();
+    bool mainDone = false;
+    IO::Load("test://blub.com/main.txt", [&mainDone, mainThreadId](IO::LoadResult res) {
+        CHECK(std::this_thread::get_id() == mainThreadId);
+        CHECK(res.Data.Size() == 4);
+        mainDone = true;
+    });
+
+    // success callback on worker thread, result posted back to main thread
+    std::atomic<bool> workerCalled{false};
+    bool workerDone = false;
+    IO::Load("test://blub.com/worker.txt", [&workerCalled, &workerDone](IO::LoadResult res) {
+        CHECK(res.Data.Size() == 4);
+        workerCalled = true;
+        const uint8_t c = res.Data.Data()[0];
+        IO::PostToMainThread([&workerDone, c] {
+            CHECK(c == 'A');
+            workerDone = true;
+        });
+    }, IO::LoadFailedFunc(), IO::CallbackThread::WorkerThread);
+
+    // group load with worker-thread callback
+    std::atomic<int> groupSize{0};
+    IO::LoadGroup(Array<URL>({ "test://blub.com/0.txt", "test://blub.com/1.txt", "test://blub.com/2.txt" }),
+        [&groupSize](Array<IO::LoadResult> results) {
+            groupSize = results.Size();
+        }, IO::LoadFailedFunc(), IO::CallbackThread::WorkerThread);
+
+    // failed group load, failure callback is called on main thread
+    bool failCalled = false;
+    bool failedGroupSuccessCalled = false;
+    IO::LoadGroup(Array<URL>({ "test://blub.com/0.txt", "test://blub.com/fail.txt" }),
+        [&failedGroupSuccessCalled](Array<IO::LoadResult> results) {
+            failedGroupSuccessCalled = true;
+        },
+        [&failCalled, mainThreadId](const URL& url, IOStatus::Code ioStatus) {
+            CHECK(std::this_thread::get_id() == mainThreadId);
+            CHECK(ioStatus == IOStatus::NotFound);
+            failCalled = true;
+        });
+    CHECK(IO::NumPendingLoads() == 4);
+
+    while (IO::NumPendingLoads() > 0) {
+        Core::PreRunLoop()->Run();
+    }
+    // the posted function is called in the same or next update
+    Core::PreRunLoop()->Run();
+    CHECK(mainDone);
+    CHECK(workerCalled);
+    CHECK(workerDone);
+    CHECK(groupSize == 3);
+    CHECK(failCalled);
+    CHECK(!failedGroupSuccessCalled);
+
+    IO::Discard();
+    Core::Discard();
+}
+TEST(IOPrefetchTest) {
+    Core::Setup();
+    IOSetup ioSetup;
+    ioSetup.PrefetchCacheSize = 8;
+    IO::Setup(ioSetup);
+    IO::RegisterFileSystem("test", TestFileSystem::Creator());
+
+    // prefetch some files, this must not count as pending loads
+    IO::Prefetch({ "test://blub.com/0.txt", "test://blub.com/1.txt", "test://blub.com/fail.txt" });
+    CHECK(IO::NumPendingLoads() == 0);
+    const int numHandledBefore = numRequestsHandled;
+    while (numRequestsHandled < (numHandledBefore + 3)) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    while (IO::PrefetchCacheBytes() < 8) {
+        Core::PreRunLoop()->Run();
+    }
+
+    // prefetching the same file again is a no-op
+    IO::Prefetch({ "test://blub.com/0.txt" });
+
+    // loading prefetched files must not go through the filesystem again
+    bool loaded0 = false;
+    IO::Load("test://blub.com/0.txt", [&loaded0](IO::LoadResult res) {
+        CHECK(res.Data.Size() == 4);
+        loaded0 = true;
+    });
+    Ptr<IORead> ioReq = IO::LoadFile("test://blub.com/1.txt");
+    CHECK(ioReq->Handled);
+    CHECK(ioReq->Status == IOStatus::OK);
+    CHECK(ioReq->Data.Size() == 4);
+    CHECK(IO::PrefetchCacheBytes() == 0);
+    while (IO::NumPendingLoads() > 0) {
+        Core::PreRunLoop()->Run();
+    }
+    CHECK(loaded0);
+
+    // a cache budget overflow evicts the oldest data
+    IO::Prefetch({ "test://blub.com/2.txt", "test://blub.com/3.txt", "test://blub.com/4.txt" });
+    while (numRequestsHandled < (numHandledBefore + 6)) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (int i = 0; i < 10; i++) {
+        Core::PreRunLoop()->Run();
+    }
+    CHECK(IO::PrefetchCacheBytes() == 8);
+    CHECK(numRequestsHandled == (numHandledBefore + 6));
+
+    // cancelled prefetches are dropped
+    IO::CancelPrefetch({ "test://blub.com/2.txt", "test://blub.com/3.txt", "test://blub.com/4.txt" });
+    CHECK(IO::PrefetchCacheBytes() == 0);
+    IO::Prefetch({ "test://blub.com/5.txt" });
+    IO::CancelAllPrefetches();
+    CHECK(IO::PrefetchCacheBytes() == 0);
+
+    IO::Discard();
+    Core::Discard();
+}
+
+TEST(IOPrefetchPriorityTest) {
+    Core::Setup();
+    IOSetup ioSetup;
+    ioSetup.PrefetchCacheSize = 64;
+    IO::Setup(ioSetup);
+    IO::RegisterFileSystem("gated", GatedFileSystem::Creator());
+
+    // block all IO workers, so that the following prefetches queue up
+    for (int i = 0; i < IOConfig::NumWorkers; i++) {
+        IO::Load("gated://blub.com/gate.txt", [](IO::LoadResult res) { });
+    }
+    while (numGated < IOConfig::NumWorkers) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const int numPrefetches = 2 * IOConfig::NumWorkers;
+    Array<URL> urls;
+    StringBuilder strBuilder;
+    for (int i = 0; i < numPrefetches; i++) {
+        strBuilder.Format(64, "gated://blub.com/%d.txt", i);
+        urls.Add(URL(strBuilder.GetString()));
+    }
+    IO::Prefetch(urls);
+    Core::PreRunLoop()->Run();
+
+    // take over the last prefetch, it must be raised above the other
+    // prefetches which are queued on the same worker
+    bool loaded = false;
+    IO::Load(urls.Back(), [&loaded](IO::LoadResult res) {
+        CHECK(res.Data.Size() == 4);
+        loaded = true;
+    });
+    Core::PreRunLoop()->Run();
+    gateOpen = true;
+    while ((IO::NumPendingLoads() > 0) || (IO::PrefetchCacheBytes() < 4 * (numPrefetches - 1))) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(loaded);
+
+    // each file has been read exactly once, and the taken-over prefetch
+    // was the first file handled by its worker
+    {
+        std::lock_guard<std::mutex> lock(handledMutex);
+        CHECK(handledPaths.Size() == numPrefetches);
+        const int index = handledPaths.FindIndexLinear(urls.Back().Path());
+        CHECK(InvalidIndex != index);
+        if (InvalidIndex != index) {
+            for (int i = 0; i < index; i++) {
+                CHECK(handledThreads[i] != handledThreads[index]);
+            }
+        }
+    }
+
+    IO::Discard();
+    Core::Discard();
+}
+TEST(IOAsyncFileSystemTest) {
+    Core::Setup();
+    IO::Setup(IOSetup());
+    IO::RegisterFileSystem("async", AsyncFileSystem::Creator());
+
+    // requests which are handled on another thread wake up the IO worker
+    int numLoaded = 0;
+    IO::Load("async://blub.com/0.txt", [&numLoaded](IO::LoadResult res) {
+        CHECK(res.Data.Size() == 4);
+        numLoaded++;
+    });
+    IO::LoadGroup({ "async://blub.com/1.txt", "async://blub.com/2.txt" }, [&numLoaded](Array<IO::LoadResult> res) {
+        numLoaded += res.Size();
+    });
+    while (IO::NumPendingLoads() > 0) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(numLoaded == 3);
+
+    // a group which is still pending when the IO system is discarded
+    // must not leak its requests and callbacks
+    {
+        liveTracker tracker;
+        IO::LoadGroup({ "async://blub.com/3.txt", "async://blub.com/never.txt" }, [tracker](Array<IO::LoadResult> res) { });
+    }
+    CHECK(numLiveTrackers > 0);
+    for (;;) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        if (asyncThreads.Size() == 4) {
+            break;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        for (auto& thread : asyncThreads) {
+            thread.join();
+        }
+        asyncThreads.Clear();
+    }
+    IO::Discard();
+    CHECK(numLiveTrackers == 0);
+    Core::Discard();
+}
+TEST(IOPrefetchCallbackThreadTest) {
+    Core::Setup();
+    IOSetup ioSetup;
+    ioSetup.PrefetchCacheSize = 64;
+    IO::Setup(ioSetup);
+    IO::RegisterFileSystem("test", TestFileSystem::Creator());
+
+    // worker thread callbacks for prefetched data are invoked on a
+    // worker thread, no matter whether the data has already been loaded
+    IO::Prefetch({ "test://blub.com/0.txt" });
+    while (IO::PrefetchCacheBytes() < 4) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    IO::Prefetch({ "test://blub.com/1.txt" });
+    const std::thread::id mainThreadId = std::this_thread::get_id();
+    std::atomic<int> numOnWorker{0};
+    std::atomic<int> numLoaded{0};
+    for (int i = 0; i < 2; i++) {
+        StringBuilder strBuilder;
+        strBuilder.Format(64, "test://blub.com/%d.txt", i);
+        IO::Load(strBuilder.GetString(), [mainThreadId, &numOnWorker, &numLoaded](IO::LoadResult res) {
+            if (std::this_thread::get_id() != mainThreadId) {
+                numOnWorker++;
+            }
+            if (res.Data.Size() == 4) {
+                numLoaded++;
+            }
+        }, IO::LoadFailedFunc(), IO::CallbackThread::WorkerThread);
+    }
+    while (IO::NumPendingLoads() > 0) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(numLoaded == 2);
+    CHECK(numOnWorker == 2);
+    CHECK(IO::PrefetchCacheBytes() == 0);
+
+    IO::Discard();
+    Core::Discard();
+}
 #endif
@@ -55,6 +55,7 @@ TEST(IOStatusTest) {
     CHECK(TOSTR(HTTPVersionNotSupported));
     CHECK(TOSTR(Cancelled));
     CHECK(TOSTR(DownloadError));
+    CHECK(TOSTR(WriteError));
 
     CHECK(FROMSTR(Continue));
     CHECK(FROMSTR(SwitchingProtocols));
@@ -98,4 +99,5 @@ TEST(IOStatusTest) {
     CHECK(FROMSTR(HTTPVersionNotSupported));
     CHECK(FROMSTR(Cancelled));
     CHECK(FROMSTR(DownloadError));
+    CHECK(FROMSTR(WriteError));
 }
@@ -0,0 +1,31 @@
+//------------------------------------------------------------------------------
+//  MatchGlobTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "IO/FS/FileSystem.h"
+
+using namespace Oryol;
+
+TEST(MatchGlobTest) {
+    CHECK(FileSystem::MatchGlob("*", ""));
+    CHECK(FileSystem::MatchGlob("*", "bla.dds"));
+    CHECK(FileSystem::MatchGlob("*.dds", "bla.dds"));
+    CHECK(!FileSystem::MatchGlob("*.dds", "bla.dds.tmp"));
+    CHECK(FileSystem::MatchGlob("bla.*", "bla.dds"));
+    CHECK(FileSystem::MatchGlob("b?a.dds", "bla.dds"));
+    CHECK(!FileSystem::MatchGlob("b?a.dds", "ba.dds"));
+    CHECK(FileSystem::MatchGlob("*_n*.dds", "wood_normal.dds"));
+    CHECK(FileSystem::MatchGlob("*a*a*a", "aaaa"));
+    CHECK(!FileSystem::MatchGlob("*a*a*b", "aaaa"));
+    CHECK(FileSystem::MatchGlob("bla.dds", "bla.dds"));
+    CHECK(!FileSystem::MatchGlob("bla.dds", "bla.ddsx"));
+    CHECK(!FileSystem::MatchGlob("", "bla"));
+
+    Array<String> filters;
+    CHECK(FileSystem::MatchFilters(filters, "bla.txt"));
+    filters.Add("*.dds");
+    filters.Add("*.ktx");
+    CHECK(FileSystem::MatchFilters(filters, "bla.ktx"));
+    CHECK(!FileSystem::MatchFilters(filters, "bla.txt"));
+}
@@ -33,3 +33,43 @@ TEST(assignRegistryTest) {
     res = reg.ResolveAssigns("blub:");
     CHECK(res == "http://www.flohofwoe.net/blub/");
 }
+
+TEST(overlayAssignTest) {
+
+    assignRegistry reg;
+    reg.SetAssign("base:", "file:///data/base/");
+    reg.SetAssign("patch:", "file:///data/patch/");
+    reg.SetOverlay("game:", { "patch:", "file:///data/dlc/", "base:" });
+    CHECK(reg.HasOverlay("game:"));
+    CHECK(!reg.HasAssign("game:"));
+
+    // a.txt in all layers, b.txt in dlc and base, c.txt only in base
+    Array<assignRegistry::overlayEntry> entries;
+    entries.Add(assignRegistry::overlayEntry{ assignRegistry::OverlayPathHash("c.txt", 5), 2 });
+    entries.Add(assignRegistry::overlayEntry{ assignRegistry::OverlayPathHash("b.txt", 5), 2 });
+    entries.Add(assignRegistry::overlayEntry{ assignRegistry::OverlayPathHash("a.txt", 5), 2 });
+    entries.Add(assignRegistry::overlayEntry{ assignRegistry::OverlayPathHash("b.txt", 5), 1 });
+    entries.Add(assignRegistry::overlayEntry{ assignRegistry::OverlayPathHash("a.txt", 5), 0 });
+    entries.Add(assignRegistry::overlayEntry{ assignRegistry::OverlayPathHash("a.txt", 5), 1 });
+    reg.SetOverlayIndex("game:", std::move(entries));
+    CHECK(reg.LookupOverlayLayer("game:", "a.txt") == 0);
+    CHECK(reg.LookupOverlayLayer("game:", "b.txt") == 1);
+    CHECK(reg.LookupOverlayLayer("game:", "c.txt") == 2);
+    CHECK(reg.ResolveAssigns("game:a.txt") == "file:///data/patch/a.txt");
+    CHECK(reg.ResolveAssigns("game:b.txt") == "file:///data/dlc/b.txt");
+    CHECK(reg.ResolveAssigns("game:c.txt") == "file:///data/base/c.txt");
+
+    // unknown paths resolve to the first layer
+    CHECK(reg.ResolveAssigns("game:d.txt") == "file:///data/patch/d.txt");
+    CHECK(reg.ResolveAssigns("game:") == "file:///data/patch/");
+
+    // a new file in a higher-priority layer takes over
+    reg.AddOverlayFile("file:///data/patch/c.txt");
+    reg.AddOverlayFile("file:///data/base/b.txt");
+    CHECK(reg.ResolveAssigns("game:c.txt") == "file:///data/patch/c.txt");
+    CHECK(reg.ResolveAssigns("game:b.txt") == "file:///data/dlc/b.txt");
+
+    reg.RemoveOverlay("game:");
+    CHECK(!reg.HasOverlay("game:"));
+    CHECK(reg.ResolveAssigns("game:a.txt") == "game:a.txt");
+}
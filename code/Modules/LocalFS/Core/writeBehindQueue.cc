@@ -0,0 +1,245 @@
+//------------------------------------------------------------------------------
+//  writeBehindQueue.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "writeBehindQueue.h"
+#include "LocalFS/Core/fsWrapper.h"
+#include "Core/String/StringBuilder.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+namespace _priv {
+
+#if ORYOL_HAS_THREADS
+std::mutex writeBehindQueue::sharedMutex;
+#endif
+writeBehindQueue* writeBehindQueue::shared = nullptr;
+int writeBehindQueue::useCount = 0;
+int writeBehindQueue::tmpCounter = 0;
+
+//------------------------------------------------------------------------------
+writeBehindQueue*
+writeBehindQueue::acquire() {
+    #if ORYOL_HAS_THREADS
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    #endif
+    if (0 == useCount++) {
+        o_assert_dbg(nullptr == shared);
+        shared = Memory::New<writeBehindQueue>();
+        #if ORYOL_HAS_THREADS
+        shared->thread = std::thread(threadFunc, shared);
+        #endif
+    }
+    return shared;
+}
+
+//------------------------------------------------------------------------------
+void
+writeBehindQueue::release() {
+    #if ORYOL_HAS_THREADS
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    #endif
+    o_assert_dbg(useCount > 0);
+    if (0 == --useCount) {
+        #if ORYOL_HAS_THREADS
+        {
+            std::lock_guard<std::mutex> queueLock(shared->mutex);
+            shared->stopRequested = true;
+        }
+        shared->condVar.notify_one();
+        shared->thread.join();
+        #endif
+        Memory::Delete(shared);
+        shared = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+writeBehindQueue::put(const Ptr<IOWrite>& req) {
+    o_assert_dbg(req->Url.HasPath());
+    #if ORYOL_HAS_THREADS
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->pending.Add(req);
+    }
+    this->condVar.notify_one();
+    #else
+    Array<Ptr<IOWrite>> batch;
+    batch.Add(req);
+    writeBatch(batch);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+#if ORYOL_HAS_THREADS
+void
+writeBehindQueue::threadFunc(writeBehindQueue* self) {
+    // all requests which arrived while the previous batch was
+    // written are handled as one batch, pending requests are
+    // still written after a stop has been requested
+    Array<Ptr<IOWrite>> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(self->mutex);
+            while (self->pending.Empty() && !self->stopRequested) {
+                self->condVar.wait(lock);
+            }
+            if (self->pending.Empty()) {
+                break;
+            }
+            batch = std::move(self->pending);
+        }
+        writeBatch(batch);
+        batch.Clear();
+    }
+}
+#endif
+
+//------------------------------------------------------------------------------
+void
+writeBehindQueue::writeBatch(Array<Ptr<IOWrite>>& batch) {
+    Array<int> group;
+    for (int i = 0; i < batch.Size(); i++) {
+        if (!batch[i]) {
+            continue;
+        }
+        // gather the following requests for the same path, in submission order
+        const String path = batch[i]->Url.Path();
+        group.Clear();
+        for (int j = i; j < batch.Size(); j++) {
+            if (batch[j] && (batch[j]->Url.Path() == path)) {
+                if (batch[j]->Cancelled) {
+                    batch[j]->Status = IOStatus::Cancelled;
+                    batch[j]->SetHandled();
+                    batch[j] = nullptr;
+                }
+                else {
+                    group.Add(j);
+                }
+            }
+        }
+        if (!group.Empty()) {
+            writeGroup(batch, group);
+            for (int j : group) {
+                batch[j] = nullptr;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+writeBehindQueue::writeGroup(Array<Ptr<IOWrite>>& batch, const Array<int>& group) {
+
+    // everything before the last replacing write is superseded
+    int first = 0;
+    for (int i = group.Size() - 1; i >= 0; i--) {
+        if (!batch[group[i]]->Append) {
+            first = i;
+            break;
+        }
+    }
+    // replaced files are always committed to disk before the rename,
+    // otherwise a crash could leave an empty file behind
+    const bool replace = !batch[group[first]]->Append;
+    bool sync = false;
+    for (int i = first; i < group.Size(); i++) {
+        sync |= batch[group[i]]->Sync;
+    }
+    const String path = batch[group[first]]->Url.Path();
+    String tmpPath;
+    fsWrapper::handle h = fsWrapper::invalidHandle;
+    if (replace) {
+        h = openTempFile(path, tmpPath);
+    }
+    else {
+        h = fsWrapper::openAppend(path.AsCStr());
+    }
+
+    IOStatus::Code status = IOStatus::OK;
+    const char* errorDesc = nullptr;
+    if (fsWrapper::invalidHandle != h) {
+        for (int i = first; i < group.Size(); i++) {
+            const Buffer& data = batch[group[i]]->Data;
+            if (!data.Empty() && (fsWrapper::write(h, data.Data(), data.Size()) != data.Size())) {
+                status = IOStatus::WriteError;
+                errorDesc = "Fewer bytes written than expected";
+                break;
+            }
+        }
+        if ((IOStatus::OK == status) && (sync || replace) && !fsWrapper::sync(h)) {
+            status = IOStatus::WriteError;
+            errorDesc = "Failed to sync file";
+        }
+        // buffered data is flushed on close, which can still fail
+        if (!fsWrapper::close(h) && (IOStatus::OK == status)) {
+            status = IOStatus::WriteError;
+            errorDesc = "Failed to close file";
+        }
+        if (replace) {
+            if ((IOStatus::OK == status) && !fsWrapper::rename(tmpPath.AsCStr(), path.AsCStr())) {
+                status = IOStatus::WriteError;
+                errorDesc = "Failed to replace file";
+            }
+            if (IOStatus::OK != status) {
+                fsWrapper::remove(tmpPath.AsCStr());
+            }
+        }
+        // the file is only durable once its directory entry is
+        if ((IOStatus::OK == status) && sync && !fsWrapper::syncDir(dirPath(path).AsCStr())) {
+            status = IOStatus::WriteError;
+            errorDesc = "Failed to sync directory";
+        }
+    }
+    else {
+        status = IOStatus::NotFound;
+        errorDesc = "Failed to open file";
+    }
+
+    for (int i : group) {
+        const Ptr<IOWrite>& req = batch[i];
+        req->Status = status;
+        if (errorDesc) {
+            req->ErrorDesc = errorDesc;
+        }
+        req->SetHandled();
+    }
+}
+
+//------------------------------------------------------------------------------
+fsWrapper::handle
+writeBehindQueue::openTempFile(const String& path, String& outTmpPath) {
+    // the temporary file must not exist yet, it might belong to another
+    // process writing the same file, or be left over from a crash
+    StringBuilder strBuilder;
+    for (int i = 0; i < 16; i++) {
+        strBuilder.Set(path);
+        strBuilder.AppendFormat(32, ".tmp%d", tmpCounter++);
+        fsWrapper::handle h = fsWrapper::openWriteNew(strBuilder.AsCStr());
+        if (fsWrapper::invalidHandle != h) {
+            outTmpPath = strBuilder.GetString();
+            return h;
+        }
+    }
+    return fsWrapper::invalidHandle;
+}
+
+//------------------------------------------------------------------------------
+String
+writeBehindQueue::dirPath(const String& path) {
+    StringBuilder strBuilder(path);
+    const int slashIndex = strBuilder.FindLastOf(0, EndOfString, "/");
+    if (InvalidIndex == slashIndex) {
+        return String(".");
+    }
+    else if (0 == slashIndex) {
+        return String("/");
+    }
+    else {
+        return strBuilder.GetSubString(0, slashIndex);
+    }
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,80 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::writeBehindQueue
+    @ingroup _priv
+    @brief asynchronous file writer shared by all LocalFileSystem instances
+
+    The IO lanes hand IOWrite requests to the write-behind queue and
+    return immediately, so that reads are never stuck behind slow writes
+    (the requests are tracked as 'in-flight' by the ioWorker until the
+    writer thread sets them to handled).
+
+    The writer thread takes all requests queued since its last batch,
+    and groups them by file path:
+
+    - a replacing write supersedes all earlier requests of the same
+      file in the batch, superseded requests get the status of the
+      request which replaced them
+    - appending writes which follow are written through the same
+      file handle
+    - if any request of a group has the Sync flag set, the file and
+      its directory entry are committed to disk once for the whole group
+    - replacing writes go to a new temporary file with a unique name,
+      which is committed to disk and then renamed over the destination
+      file, so a reader (or a crash) never leaves a partially written
+      file behind
+
+    Short writes and failed syncs or renames are reported
+    as IOStatus::WriteError.
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "IO/FS/ioRequests.h"
+#include "LocalFS/Core/fsWrapper.h"
+#if ORYOL_HAS_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+class writeBehindQueue {
+public:
+    /// get the shared queue, starts the writer thread on first call
+    static writeBehindQueue* acquire();
+    /// release the shared queue, the last release writes pending requests and stops the writer thread
+    static void release();
+
+    /// queue a write request (the request must have a path)
+    void put(const Ptr<IOWrite>& req);
+    /// write a batch of requests and set them to handled
+    static void writeBatch(Array<Ptr<IOWrite>>& batch);
+
+private:
+    /// write all requests of a batch with the same path
+    static void writeGroup(Array<Ptr<IOWrite>>& batch, const Array<int>& group);
+    /// create a temporary file next to path with a unique name
+    static fsWrapper::handle openTempFile(const String& path, String& outTmpPath);
+    /// get the directory of a file path
+    static String dirPath(const String& path);
+    #if ORYOL_HAS_THREADS
+    /// the writer thread function
+    static void threadFunc(writeBehindQueue* self);
+
+    static std::mutex sharedMutex;
+    std::mutex mutex;
+    std::condition_variable condVar;
+    std::thread thread;
+    bool stopRequested = false;
+    Array<Ptr<IOWrite>> pending;
+    #endif
+    static writeBehindQueue* shared;
+    static int useCount;
+    static int tmpCounter;      // only accessed by the writer thread
+};
+
+} // namespace _priv
+} // namespace Oryol
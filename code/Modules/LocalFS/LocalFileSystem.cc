@@ -11,6 +11,17 @@ namespace Oryol {
 
 using namespace _priv;
 
+//------------------------------------------------------------------------------
+LocalFileSystem::LocalFileSystem() :
+writer(writeBehindQueue::acquire()) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+LocalFileSystem::~LocalFileSystem() {
+    writeBehindQueue::release();
+}
+
 //------------------------------------------------------------------------------
 void
 LocalFileSystem::init(const StringAtom& scheme_) {
@@ -29,13 +40,28 @@ LocalFileSystem::init(const StringAtom& scheme_) {
 //------------------------------------------------------------------------------
 void
 LocalFileSystem::onMsg(const Ptr<IORequest>& req) {
-    if (req->IsA<IORead>()) {
-        this->onRead(req->DynamicCast<IORead>());
-    }
-    else if (req->IsA<IOWrite>()) {
+    if (req->IsA<IOWrite>()) {
+        // NOTE: write requests are set to handled by the write-behind queue
         this->onWrite(req->DynamicCast<IOWrite>());
     }
-    req->Handled = true;
+    else {
+        if (req->IsA<IORead>()) {
+            this->onRead(req->DynamicCast<IORead>());
+        }
+        else if (req->IsA<IOStat>()) {
+            this->onStat(req->DynamicCast<IOStat>());
+        }
+        else if (req->IsA<IOStatBatch>()) {
+            this->onStatBatch(req->DynamicCast<IOStatBatch>());
+        }
+        else if (req->IsA<IOListDir>()) {
+            this->onListDir(req->DynamicCast<IOListDir>());
+        }
+        else {
+            req->Status = IOStatus::NotImplemented;
+        }
+        req->Handled = true;
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -84,17 +110,31 @@ LocalFileSystem::onRead(const Ptr<IORead>& msg) {
 void
 LocalFileSystem::onWrite(const Ptr<IOWrite>& msg) {
     if (msg->Url.HasPath()) {
-        fsWrapper::handle h = fsWrapper::openWrite(msg->Url.Path().AsCStr());
-        if (fsWrapper::invalidHandle != h) {
-            if (!msg->Data.Empty()) {
-                fsWrapper::write(h, msg->Data.Data(), msg->Data.Size());
-            }
-            fsWrapper::close(h);
+        this->writer->put(msg);
+    }
+    else {
+        msg->Status = IOStatus::BadRequest;
+        msg->ErrorDesc = "No path in URL";
+        msg->Handled = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+LocalFileSystem::onStat(const Ptr<IOStat>& msg) {
+    if (msg->Url.HasPath()) {
+        fsWrapper::fileInfo info;
+        msg->Info.Path = msg->Url.Path();
+        if (fsWrapper::stat(msg->Info.Path.AsCStr(), info)) {
+            msg->Info.Size = info.size;
+            msg->Info.ModTime = info.modTime;
+            msg->Info.IsDirectory = info.isDirectory;
+            msg->Info.Exists = true;
             msg->Status = IOStatus::OK;
         }
         else {
             msg->Status = IOStatus::NotFound;
-            msg->ErrorDesc = "Failed to open file";
+            msg->ErrorDesc = "File not found";
         }
     }
     else {
@@ -103,5 +143,119 @@ LocalFileSystem::onWrite(const Ptr<IOWrite>& msg) {
     }
 }
 
+//------------------------------------------------------------------------------
+void
+LocalFileSystem::onStatBatch(const Ptr<IOStatBatch>& msg) {
+    if (msg->Url.HasPath()) {
+        StringBuilder strBuilder;
+        const String dirPath = msg->Url.Path();
+        msg->Infos.Reserve(msg->Paths.Size());
+        for (const String& path : msg->Paths) {
+            strBuilder.Set(dirPath);
+            if ((strBuilder.Length() > 0) && (strBuilder.Back() != '/')) {
+                strBuilder.Append('/');
+            }
+            strBuilder.Append(path);
+            msg->Infos.Add(IOFileInfo());
+            IOFileInfo& info = msg->Infos.Back();
+            info.Path = path;
+            fsWrapper::fileInfo fsInfo;
+            if (fsWrapper::stat(strBuilder.AsCStr(), fsInfo)) {
+                info.Size = fsInfo.size;
+                info.ModTime = fsInfo.modTime;
+                info.IsDirectory = fsInfo.isDirectory;
+                info.Exists = true;
+            }
+        }
+        msg->Status = IOStatus::OK;
+    }
+    else {
+        msg->Status = IOStatus::BadRequest;
+        msg->ErrorDesc = "No path in URL";
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+LocalFileSystem::onListDir(const Ptr<IOListDir>& msg) {
+    if (!msg->Url.HasPath()) {
+        msg->Status = IOStatus::BadRequest;
+        msg->ErrorDesc = "No path in URL";
+        return;
+    }
+    StringBuilder strBuilder(msg->Url.Path());
+    if ((strBuilder.Length() > 0) && (strBuilder.Back() != '/')) {
+        strBuilder.Append('/');
+    }
+    const String rootPath = strBuilder.GetString();
+
+    // iterate over a stack of directories relative to the root
+    // directory, instead of recursing into each sub-directory
+    Array<String> dirStack;
+    dirStack.Add(String());
+    bool rootOpened = false;
+    while (!dirStack.Empty()) {
+        const String relDir = dirStack.PopBack();
+        strBuilder.Set(rootPath);
+        strBuilder.Append(relDir);
+        fsWrapper::dirHandle d = fsWrapper::openDir(strBuilder.AsCStr());
+        if (fsWrapper::invalidDirHandle == d) {
+            continue;
+        }
+        rootOpened = true;
+        const char* name = nullptr;
+        fsWrapper::entryType type;
+        fsWrapper::fileInfo fsInfo;
+        while (fsWrapper::readDir(d, name, type)) {
+            // symlinks are resolved to find out whether they point to a
+            // directory, but never descended into, since cyclic links
+            // would keep the directory stack from ever running empty
+            bool isDirectory = fsWrapper::directoryEntry == type;
+            bool hasInfo = false;
+            if (fsWrapper::symLinkEntry == type) {
+                if (!fsWrapper::statEntry(d, name, fsInfo)) {
+                    continue;
+                }
+                isDirectory = fsInfo.isDirectory;
+                hasInfo = true;
+            }
+            const bool listed = isDirectory ?
+                msg->IncludeDirectories :
+                FileSystem::MatchFilters(msg->Filters, name);
+            const bool descend = msg->Recursive && (fsWrapper::directoryEntry == type);
+            if (!(listed || descend)) {
+                continue;
+            }
+            // only stat entries which are actually listed
+            if (listed && !hasInfo && !fsWrapper::statEntry(d, name, fsInfo)) {
+                continue;
+            }
+            strBuilder.Set(relDir);
+            strBuilder.Append(name);
+            if (listed) {
+                msg->Entries.Add(IOFileInfo());
+                IOFileInfo& info = msg->Entries.Back();
+                info.Path = strBuilder.GetString();
+                info.Size = fsInfo.size;
+                info.ModTime = fsInfo.modTime;
+                info.IsDirectory = isDirectory;
+                info.Exists = true;
+            }
+            if (descend) {
+                strBuilder.Append('/');
+                dirStack.Add(strBuilder.GetString());
+            }
+        }
+        fsWrapper::closeDir(d);
+    }
+    if (rootOpened) {
+        msg->Status = IOStatus::OK;
+    }
+    else {
+        msg->Status = IOStatus::NotFound;
+        msg->ErrorDesc = "Failed to open directory";
+    }
+}
+
 } // namespace Oryol
 
@@ -7,9 +7,20 @@
     @class Oryol::LocalFileSystem
     @ingroup LocalFS
     @brief FileSystem subclass to access the local host file system
+
+    Reads are handled directly on the IO lane. Writes are handed to a
+    write-behind queue with its own thread (see _priv::writeBehindQueue),
+    IOWrite::Append appends to a file instead of replacing it, and
+    IOWrite::Sync commits the file to disk before the request is
+    handled. Replacing a file is atomic (write to a temporary file,
+    then rename).
+
+    IOStat, IOStatBatch and IOListDir requests are handled on the IO
+    lane, directory entries are stat'ed relative to the open directory.
 */
 #include "IO/FS/FileSystem.h"
 #include "Core/Creator.h"
+#include "LocalFS/Core/writeBehindQueue.h"
 
 namespace Oryol {
 
@@ -17,6 +28,10 @@ class LocalFileSystem : public FileSystem {
     OryolClassDecl(LocalFileSystem);
     OryolClassCreator(LocalFileSystem);
 public:
+    /// constructor
+    LocalFileSystem();
+    /// destructor
+    virtual ~LocalFileSystem();
     /// called once on main-thread
     virtual void init(const StringAtom& scheme) override;
     /// called when IO message should be handled
@@ -27,6 +42,14 @@ private:
     void onRead(const Ptr<IORead>& ioRead);
     /// handle IOWrite msg
     void onWrite(const Ptr<IOWrite>& ioWrite);
+    /// handle IOStat msg
+    void onStat(const Ptr<IOStat>& ioStat);
+    /// handle IOStatBatch msg
+    void onStatBatch(const Ptr<IOStatBatch>& ioStatBatch);
+    /// handle IOListDir msg
+    void onListDir(const Ptr<IOListDir>& ioListDir);
+
+    _priv::writeBehindQueue* writer;
 };
 
 } // namespace Oryol
@@ -61,5 +61,30 @@ TEST(FSWrapperTest) {
     CHECK(fsWrapper::read(hs, buf, sizeof(buf)) == 6);
     readStr.Assign(buf, 0, 6);
     CHECK(readStr == "World\n");
-    fsWrapper::close(hs);
+    CHECK(fsWrapper::close(hs));
+
+    // append, sync and rename
+    const fsWrapper::handle ha = fsWrapper::openAppend(strBuilder.AsCStr());
+    CHECK(ha != fsWrapper::invalidHandle);
+    CHECK(fsWrapper::write(ha, str, len) == len);
+    CHECK(fsWrapper::sync(ha));
+    CHECK(fsWrapper::close(ha));
+    StringBuilder newPath;
+    newPath.Format(4096, "%s/test_renamed.txt", cwdPath.AsCStr());
+    CHECK(fsWrapper::rename(strBuilder.AsCStr(), newPath.AsCStr()));
+    CHECK(fsWrapper::openRead(strBuilder.AsCStr()) == fsWrapper::invalidHandle);
+    const fsWrapper::handle hn = fsWrapper::openRead(newPath.AsCStr());
+    CHECK(hn != fsWrapper::invalidHandle);
+    CHECK(fsWrapper::size(hn) == 2 * len);
+    fsWrapper::close(hn);
+    CHECK(fsWrapper::syncDir(cwdPath.AsCStr()));
+
+    // creating a new file fails if the file exists
+    CHECK(fsWrapper::openWriteNew(newPath.AsCStr()) == fsWrapper::invalidHandle);
+    CHECK(fsWrapper::remove(newPath.AsCStr()));
+    const fsWrapper::handle hc = fsWrapper::openWriteNew(newPath.AsCStr());
+    CHECK(hc != fsWrapper::invalidHandle);
+    CHECK(fsWrapper::close(hc));
+    CHECK(fsWrapper::remove(newPath.AsCStr()));
+    CHECK(!fsWrapper::remove(newPath.AsCStr()));
 }
@@ -8,6 +8,11 @@
 #include "IO/IO.h"
 #include "LocalFS/LocalFileSystem.h"
 #include "LocalFS/Core/fsWrapper.h"
+#include <cstring>
+#if !ORYOL_WINDOWS
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
 
 using namespace Oryol;
 
@@ -190,5 +195,219 @@ TEST(SameExtensionTest) {
     Core::Discard();
 }
 
+static String
+readFile(const URL& url) {
+    auto read = IORead::Create();
+    read->Url = url;
+    IO::Put(read);
+    wait(read);
+    if (IOStatus::OK == read->Status) {
+        return String((const char*)read->Data.Data(), 0, read->Data.Size());
+    }
+    return String();
+}
+
+static Ptr<IOWrite>
+writeFile(const URL& url, const char* str, bool append=false, bool sync=false) {
+    auto write = IOWrite::Create();
+    write->Url = url;
+    write->Data.Add((const uint8_t*)str, int(std::strlen(str)));
+    write->Append = append;
+    write->Sync = sync;
+    IO::Put(write);
+    return write;
+}
+
+TEST(WriteBehindTest) {
+    Core::Setup();
+    IOSetup ioSetup;
+    ioSetup.FileSystems.Add("file", LocalFileSystem::Creator());
+    IO::Setup(ioSetup);
+
+    // replace, then append
+    auto w0 = writeFile("root:writebehind.txt", "Hello");
+    wait(w0);
+    CHECK(w0->Status == IOStatus::OK);
+    auto w1 = writeFile("root:writebehind.txt", " World", true);
+    auto w2 = writeFile("root:writebehind.txt", "!", true, true);
+    wait(w1);
+    wait(w2);
+    CHECK(w1->Status == IOStatus::OK);
+    CHECK(w2->Status == IOStatus::OK);
+    CHECK(readFile("root:writebehind.txt") == "Hello World!");
+
+    // a batch of writes to the same file, the last replacing write wins
+    auto w3 = writeFile("root:writebehind.txt", "Bla", true);
+    auto w4 = writeFile("root:writebehind.txt", "Blub");
+    auto w5 = writeFile("root:writebehind.txt", "Blob");
+    auto w6 = writeFile("root:writebehind.txt", "Blab", true);
+    wait(w3); wait(w4); wait(w5); wait(w6);
+    CHECK(w3->Status == IOStatus::OK);
+    CHECK(w4->Status == IOStatus::OK);
+    CHECK(w5->Status == IOStatus::OK);
+    CHECK(w6->Status == IOStatus::OK);
+    CHECK(readFile("root:writebehind.txt") == "BlobBlab");
+
+    // a synced replacing write, no temporary files are left behind
+    auto w9 = writeFile("root:writebehind.txt", "Synced", false, true);
+    wait(w9);
+    CHECK(w9->Status == IOStatus::OK);
+    CHECK(readFile("root:writebehind.txt") == "Synced");
+    auto tmpFiles = IO::ListDir("root:", { "writebehind.txt.tmp*" });
+    wait(tmpFiles);
+    CHECK(tmpFiles->Status == IOStatus::OK);
+    CHECK(tmpFiles->Entries.Empty());
+
+    // writing into a directory which doesn't exist fails
+    auto w7 = writeFile("root:nonexisting/writebehind.txt", "Bla");
+    wait(w7);
+    CHECK(w7->Status == IOStatus::NotFound);
+    auto w8 = writeFile("root:nonexisting/writebehind.txt", "Bla", true);
+    wait(w8);
+    CHECK(w8->Status == IOStatus::NotFound);
+
+    IO::Discard();
+    Core::Discard();
+}
+
+TEST(StatListDirTest) {
+    Core::Setup();
+    IOSetup ioSetup;
+    ioSetup.FileSystems.Add("file", LocalFileSystem::Creator());
+    IO::Setup(ioSetup);
+
+    wait(writeFile("root:listtest_0.txt", "Bla"));
+    wait(writeFile("root:listtest_1.txt", "Blub"));
+    wait(writeFile("root:listtest_2.dds", "Blob Blob"));
+
+    // stat a single file
+    auto stat = IO::Stat("root:listtest_1.txt");
+    wait(stat);
+    CHECK(stat->Status == IOStatus::OK);
+    CHECK(stat->Info.Exists);
+    CHECK(!stat->Info.IsDirectory);
+    CHECK(stat->Info.Size == 4);
+    CHECK(stat->Info.ModTime > 0);
+    stat = IO::Stat("root:listtest_3.txt");
+    wait(stat);
+    CHECK(stat->Status == IOStatus::NotFound);
+    CHECK(!stat->Info.Exists);
+
+    // stat a batch of files relative to a directory
+    auto statBatch = IO::StatBatch("root:", { "listtest_0.txt", "listtest_2.dds", "listtest_3.txt" });
+    wait(statBatch);
+    CHECK(statBatch->Status == IOStatus::OK);
+    CHECK(statBatch->Infos.Size() == 3);
+    CHECK(statBatch->Infos[0].Exists && (statBatch->Infos[0].Size == 3));
+    CHECK(statBatch->Infos[1].Exists && (statBatch->Infos[1].Size == 9));
+    CHECK(!statBatch->Infos[2].Exists);
+    CHECK(statBatch->Infos[2].Path == "listtest_3.txt");
+
+    // list directory with filters
+    auto listDir = IO::ListDir("root:", { "listtest_*.txt" });
+    wait(listDir);
+    CHECK(listDir->Status == IOStatus::OK);
+    CHECK(listDir->Entries.Size() == 2);
+    for (const auto& entry : listDir->Entries) {
+        CHECK((entry.Path == "listtest_0.txt") || (entry.Path == "listtest_1.txt"));
+        CHECK(!entry.IsDirectory);
+    }
+    listDir = IO::ListDir("root:", { "*.txt", "*.dds" });
+    wait(listDir);
+    CHECK(listDir->Entries.Size() >= 3);
+    listDir = IO::ListDir("root:", { "listtest_*.txt" }, true);
+    wait(listDir);
+    CHECK(listDir->Status == IOStatus::OK);
+    CHECK(listDir->Entries.Size() >= 2);
+
+    // a directory which doesn't exist
+    listDir = IO::ListDir("root:nonexisting/");
+    wait(listDir);
+    CHECK(listDir->Status == IOStatus::NotFound);
+
+    IO::Discard();
+    Core::Discard();
+}
+
+#if !ORYOL_WINDOWS
+TEST(ListDirSymLinkTest) {
+    Core::Setup();
+    IOSetup ioSetup;
+    ioSetup.FileSystems.Add("file", LocalFileSystem::Creator());
+    IO::Setup(ioSetup);
+
+    // a directory with a symlink to itself and a symlink to a file
+    const String dir = StringBuilder({ _priv::fsWrapper::getExecutableDir(), "symlinktest" }).GetString();
+    mkdir(dir.AsCStr(), 0755);
+    wait(writeFile("root:symlinktest/file.txt", "Bla"));
+    const String selfLink = StringBuilder({ dir, "/self" }).GetString();
+    const String fileLink = StringBuilder({ dir, "/link.txt" }).GetString();
+    unlink(selfLink.AsCStr());
+    unlink(fileLink.AsCStr());
+    CHECK(0 == symlink(".", selfLink.AsCStr()));
+    CHECK(0 == symlink("file.txt", fileLink.AsCStr()));
 
+    // the recursive listing must terminate, the file symlink is resolved
+    auto listDir = IOListDir::Create();
+    listDir->Url = "root:symlinktest/";
+    listDir->Recursive = true;
+    listDir->IncludeDirectories = true;
+    IO::Put(listDir);
+    wait(listDir);
+    CHECK(listDir->Status == IOStatus::OK);
+    CHECK(listDir->Entries.Size() == 3);
+    for (const auto& entry : listDir->Entries) {
+        if (entry.Path == "self") {
+            CHECK(entry.IsDirectory);
+        }
+        else {
+            CHECK((entry.Path == "file.txt") || (entry.Path == "link.txt"));
+            CHECK(!entry.IsDirectory);
+            CHECK(entry.Size == 3);
+        }
+    }
+
+    // filters are applied to symlinks like to files
+    listDir = IO::ListDir("root:symlinktest/", { "link.*" }, true);
+    wait(listDir);
+    CHECK(listDir->Entries.Size() == 1);
 
+    unlink(selfLink.AsCStr());
+    unlink(fileLink.AsCStr());
+    IO::Discard();
+    Core::Discard();
+}
+#endif
+
+TEST(OverlayTest) {
+    Core::Setup();
+    IOSetup ioSetup;
+    ioSetup.FileSystems.Add("file", LocalFileSystem::Creator());
+    IO::Setup(ioSetup);
+
+    wait(writeFile("root:overlaytest_0.txt", "Bla"));
+    _priv::fsWrapper::remove(URL("root:overlaytest_1.txt").Path().AsCStr());
+
+    // the first layer doesn't exist and is treated as empty
+    bool mounted = false;
+    IO::MountOverlay("ovl:", { "root:nonexisting/", "root:" }, [&mounted] {
+        mounted = true;
+    });
+    CHECK(IO::HasOverlay("ovl:"));
+    while (!mounted) {
+        Core::PreRunLoop()->Run();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    CHECK(IO::ResolveAssigns("ovl:overlaytest_0.txt") == IO::ResolveAssigns("root:overlaytest_0.txt"));
+    CHECK(IO::ResolveAssigns("ovl:overlaytest_1.txt") == IO::ResolveAssigns("root:nonexisting/overlaytest_1.txt"));
+    CHECK(readFile("ovl:overlaytest_0.txt") == "Bla");
+
+    // writing a file updates the overlay index
+    wait(writeFile("root:overlaytest_1.txt", "Blub"));
+    CHECK(readFile("ovl:overlaytest_1.txt") == "Blub");
+
+    IO::UnmountOverlay("ovl:");
+    CHECK(!IO::HasOverlay("ovl:"));
+    IO::Discard();
+    Core::Discard();
+}
@@ -19,6 +19,18 @@ dummyFSWrapper::openWrite(const char* path) {
     return invalidHandle;
 }
 
+//------------------------------------------------------------------------------
+dummyFSWrapper::handle
+dummyFSWrapper::openWriteNew(const char* path) {
+    return invalidHandle;
+}
+
+//------------------------------------------------------------------------------
+dummyFSWrapper::handle 
+dummyFSWrapper::openAppend(const char* path) {
+    return invalidHandle;
+}
+
 //------------------------------------------------------------------------------
 int
 dummyFSWrapper::write(handle f, const void* ptr, int numBytes) {
@@ -44,8 +56,62 @@ dummyFSWrapper::size(handle f) {
 }
 
 //------------------------------------------------------------------------------
-void
+bool
+dummyFSWrapper::sync(handle f) {
+    return false;
+}
+
+//------------------------------------------------------------------------------
+bool
+dummyFSWrapper::syncDir(const char* path) {
+    return false;
+}
+
+//------------------------------------------------------------------------------
+bool
 dummyFSWrapper::close(handle f) {
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+dummyFSWrapper::rename(const char* fromPath, const char* toPath) {
+    return false;
+}
+
+//------------------------------------------------------------------------------
+bool
+dummyFSWrapper::remove(const char* path) {
+    return false;
+}
+
+//------------------------------------------------------------------------------
+bool
+dummyFSWrapper::stat(const char* path, fileInfo& outInfo) {
+    return false;
+}
+
+//------------------------------------------------------------------------------
+dummyFSWrapper::dirHandle
+dummyFSWrapper::openDir(const char* path) {
+    return invalidDirHandle;
+}
+
+//------------------------------------------------------------------------------
+bool
+dummyFSWrapper::readDir(dirHandle d, const char*& outName, entryType& outType) {
+    return false;
+}
+
+//------------------------------------------------------------------------------
+bool
+dummyFSWrapper::statEntry(dirHandle d, const char* name, fileInfo& outInfo) {
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void
+dummyFSWrapper::closeDir(dirHandle d) {
     // empty
 }
 
@@ -4,20 +4,46 @@
 #include "Pre.h"
 #include "posixFSWrapper.h"
 #include "Core/String/StringBuilder.h"
+#include "Core/Memory/Memory.h"
 #include <stdio.h>
+#include <string.h>
 #if !ORYOL_UWP
 #include "LocalFS/whereami/whereami.h"
 #endif
 #if ORYOL_WINDOWS
+#define WIN32_LEAN_AND_MEAN (1)
+#include <windows.h>
 #include <direct.h>
+#include <io.h>
 #else
 #include <unistd.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #endif
 
 namespace Oryol {
 namespace _priv {
 
 const posixFSWrapper::handle posixFSWrapper::invalidHandle = nullptr;
+const posixFSWrapper::dirHandle posixFSWrapper::invalidDirHandle = nullptr;
+
+#if ORYOL_WINDOWS
+/// directory iteration state on Windows
+struct winDir {
+    HANDLE handle = INVALID_HANDLE_VALUE;
+    WIN32_FIND_DATAA data;
+    bool first = true;
+};
+
+//------------------------------------------------------------------------------
+static int64_t
+fileTimeToUnix(const FILETIME& ft) {
+    // FILETIME is in 100ns intervals since 1601-01-01
+    const int64_t ticks = (int64_t(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    return (ticks - 116444736000000000LL) / 10000000LL;
+}
+#endif
 
 //------------------------------------------------------------------------------
 posixFSWrapper::handle
@@ -33,6 +59,20 @@ posixFSWrapper::openWrite(const char* path) {
     return fopen(path, "wb");
 }
 
+//------------------------------------------------------------------------------
+posixFSWrapper::handle
+posixFSWrapper::openWriteNew(const char* path) {
+    o_assert_dbg(path);
+    return fopen(path, "wbx");
+}
+
+//------------------------------------------------------------------------------
+posixFSWrapper::handle
+posixFSWrapper::openAppend(const char* path) {
+    o_assert_dbg(path);
+    return fopen(path, "ab");
+}
+
 //------------------------------------------------------------------------------
 int
 posixFSWrapper::write(handle h, const void* ptr, int numBytes) {
@@ -69,10 +109,215 @@ posixFSWrapper::size(handle h) {
 }
 
 //------------------------------------------------------------------------------
-void
+bool
+posixFSWrapper::sync(handle h) {
+    o_assert_dbg(invalidHandle != h);
+    FILE* fp = (FILE*) h;
+    if (0 != fflush(fp)) {
+        return false;
+    }
+    #if ORYOL_WINDOWS
+    return 0 == _commit(_fileno(fp));
+    #else
+    return 0 == fsync(fileno(fp));
+    #endif
+}
+
+//------------------------------------------------------------------------------
+bool
+posixFSWrapper::syncDir(const char* path) {
+    o_assert_dbg(path);
+    #if ORYOL_WINDOWS
+    // directories can't be opened as files on Windows, NTFS
+    // journals the directory entries itself
+    return true;
+    #else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    const bool result = 0 == fsync(fd);
+    ::close(fd);
+    return result;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+bool
 posixFSWrapper::close(handle h) {
     o_assert_dbg(invalidHandle != h);
-    fclose((FILE*)h);
+    return 0 == fclose((FILE*)h);
+}
+
+//------------------------------------------------------------------------------
+bool
+posixFSWrapper::rename(const char* fromPath, const char* toPath) {
+    o_assert_dbg(fromPath && toPath);
+    #if ORYOL_WINDOWS
+    // rename() fails on Windows if the destination exists
+    return 0 != MoveFileExA(fromPath, toPath, MOVEFILE_REPLACE_EXISTING);
+    #else
+    return 0 == ::rename(fromPath, toPath);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+bool
+posixFSWrapper::remove(const char* path) {
+    o_assert_dbg(path);
+    return 0 == ::remove(path);
+}
+
+//------------------------------------------------------------------------------
+bool
+posixFSWrapper::stat(const char* path, fileInfo& outInfo) {
+    o_assert_dbg(path);
+    #if ORYOL_WINDOWS
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExA(path, GetFileExInfoStandard, &data)) {
+        return false;
+    }
+    outInfo.size = (int64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    outInfo.modTime = fileTimeToUnix(data.ftLastWriteTime);
+    outInfo.isDirectory = 0 != (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
+    #else
+    struct stat st;
+    if (0 != ::stat(path, &st)) {
+        return false;
+    }
+    outInfo.size = int64_t(st.st_size);
+    outInfo.modTime = int64_t(st.st_mtime);
+    outInfo.isDirectory = S_ISDIR(st.st_mode);
+    #endif
+    return true;
+}
+
+//------------------------------------------------------------------------------
+posixFSWrapper::dirHandle
+posixFSWrapper::openDir(const char* path) {
+    o_assert_dbg(path);
+    #if ORYOL_WINDOWS
+    StringBuilder strBuilder(path);
+    if ((strBuilder.Length() > 0) && (strBuilder.Back() != '/') && (strBuilder.Back() != '\\')) {
+        strBuilder.Append('/');
+    }
+    strBuilder.Append('*');
+    winDir* dir = Memory::New<winDir>();
+    dir->handle = FindFirstFileA(strBuilder.AsCStr(), &dir->data);
+    if (INVALID_HANDLE_VALUE == dir->handle) {
+        Memory::Delete(dir);
+        return invalidDirHandle;
+    }
+    return dir;
+    #else
+    return opendir(path);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+bool
+posixFSWrapper::readDir(dirHandle d, const char*& outName, entryType& outType) {
+    o_assert_dbg(invalidDirHandle != d);
+    #if ORYOL_WINDOWS
+    winDir* dir = (winDir*) d;
+    for (;;) {
+        if (dir->first) {
+            dir->first = false;
+        }
+        else if (!FindNextFileA(dir->handle, &dir->data)) {
+            return false;
+        }
+        const char* name = dir->data.cFileName;
+        if ((0 == strcmp(name, ".")) || (0 == strcmp(name, ".."))) {
+            continue;
+        }
+        // junctions and symlinks are reparse points
+        const DWORD attrs = dir->data.dwFileAttributes;
+        outName = name;
+        if (attrs & FILE_ATTRIBUTE_REPARSE_POINT) {
+            outType = symLinkEntry;
+        }
+        else if (attrs & FILE_ATTRIBUTE_DIRECTORY) {
+            outType = directoryEntry;
+        }
+        else {
+            outType = fileEntry;
+        }
+        return true;
+    }
+    #else
+    DIR* dir = (DIR*) d;
+    while (struct dirent* ent = readdir(dir)) {
+        const char* name = ent->d_name;
+        if ((0 == strcmp(name, ".")) || (0 == strcmp(name, ".."))) {
+            continue;
+        }
+        // most file systems report the entry type in the dirent,
+        // only stat (without following symlinks) if they don't
+        int type = DT_UNKNOWN;
+        #ifdef _DIRENT_HAVE_D_TYPE
+        type = ent->d_type;
+        #endif
+        if (DT_UNKNOWN == type) {
+            struct stat st;
+            if (0 != fstatat(dirfd(dir), name, &st, AT_SYMLINK_NOFOLLOW)) {
+                continue;
+            }
+            type = S_ISLNK(st.st_mode) ? DT_LNK : (S_ISDIR(st.st_mode) ? DT_DIR : DT_REG);
+        }
+        outName = name;
+        if (DT_LNK == type) {
+            outType = symLinkEntry;
+        }
+        else if (DT_DIR == type) {
+            outType = directoryEntry;
+        }
+        else {
+            outType = fileEntry;
+        }
+        return true;
+    }
+    return false;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+bool
+posixFSWrapper::statEntry(dirHandle d, const char* name, fileInfo& outInfo) {
+    o_assert_dbg((invalidDirHandle != d) && name);
+    #if ORYOL_WINDOWS
+    // the find data of the current entry already contains the attributes
+    winDir* dir = (winDir*) d;
+    o_assert_dbg(name == dir->data.cFileName);
+    outInfo.size = (int64_t(dir->data.nFileSizeHigh) << 32) | dir->data.nFileSizeLow;
+    outInfo.modTime = fileTimeToUnix(dir->data.ftLastWriteTime);
+    outInfo.isDirectory = 0 != (dir->data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
+    return true;
+    #else
+    // stat relative to the open directory, this skips the path lookup,
+    // dangling symlinks and entries which disappeared return false
+    struct stat st;
+    if (0 != fstatat(dirfd((DIR*)d), name, &st, 0)) {
+        return false;
+    }
+    outInfo.size = int64_t(st.st_size);
+    outInfo.modTime = int64_t(st.st_mtime);
+    outInfo.isDirectory = S_ISDIR(st.st_mode);
+    return true;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+posixFSWrapper::closeDir(dirHandle d) {
+    o_assert_dbg(invalidDirHandle != d);
+    #if ORYOL_WINDOWS
+    winDir* dir = (winDir*) d;
+    FindClose(dir->handle);
+    Memory::Delete(dir);
+    #else
+    closedir((DIR*)d);
+    #endif
 }
 
 //------------------------------------------------------------------------------
@@ -15,13 +15,33 @@ class posixFSWrapper  {
 public:
     /// file-handle typedef
     typedef void* handle;
+    /// directory iteration handle typedef
+    typedef void* dirHandle;
+    /// file attributes
+    struct fileInfo {
+        int64_t size = 0;
+        int64_t modTime = 0;
+        bool isDirectory = false;
+    };
+    /// directory entry type as reported by readDir(), symlinks are not resolved
+    enum entryType {
+        fileEntry,
+        directoryEntry,
+        symLinkEntry,
+    };
     /// invalid file handle
     static const handle invalidHandle;
+    /// invalid directory handle
+    static const dirHandle invalidDirHandle;
 
     /// open file for reading
     static handle openRead(const char* path);
     /// open file for writing
     static handle openWrite(const char* path);
+    /// create a new file for writing, fail if the file already exists
+    static handle openWriteNew(const char* path);
+    /// open file for appending, create file if it doesn't exist
+    static handle openAppend(const char* path);
     /// write to file, return number of bytes actually written
     static int write(handle f, const void* ptr, int numBytes);
     /// read from file, return number of bytes actually read
@@ -30,8 +50,27 @@ public:
     static bool seek(handle f, int offset);
     /// get file size
     static int size(handle f);
-    /// close file
-    static void close(handle f);
+    /// flush buffered data and commit the file to disk
+    static bool sync(handle f);
+    /// commit the entries of a directory (e.g. a renamed file) to disk
+    static bool syncDir(const char* path);
+    /// close file, return false if buffered data could not be written
+    static bool close(handle f);
+    /// rename a file, replacing an existing file at the new path
+    static bool rename(const char* fromPath, const char* toPath);
+    /// delete a file
+    static bool remove(const char* path);
+
+    /// get file attributes, return false if file doesn't exist
+    static bool stat(const char* path, fileInfo& outInfo);
+    /// open a directory for iteration, return invalidDirHandle if failed
+    static dirHandle openDir(const char* path);
+    /// get next directory entry (without '.' and '..'), name is valid until next call, return false when done
+    static bool readDir(dirHandle d, const char*& outName, entryType& outType);
+    /// get attributes of the current directory entry, symlinks are resolved, return false if it doesn't exist
+    static bool statEntry(dirHandle d, const char* name, fileInfo& outInfo);
+    /// close directory
+    static void closeDir(dirHandle d);
     
     /// get path to own executable
     static String getExecutableDir();
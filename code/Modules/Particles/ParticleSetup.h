@@ -0,0 +1,44 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::ParticleSetup
+    @ingroup Particles
+    @brief setup parameters for a ParticleSystem
+*/
+#include "Core/Types.h"
+#include "Gfx/Core/VertexLayout.h"
+#include "glm/vec3.hpp"
+
+namespace Oryol {
+
+class ParticleSetup {
+public:
+    /// max number of alive particles
+    int MaxNumParticles = 64 * 1024;
+    /// constant acceleration applied to all particles
+    glm::vec3 Gravity = glm::vec3(0.0f, -1.0f, 0.0f);
+    /// particles bounce when their y position falls below this height
+    float FloorHeight = -2.0f;
+    /// y position of a particle after bouncing
+    float BounceHeight = -1.8f;
+    /// velocity scale factor applied when bouncing
+    float BounceDamping = 0.8f;
+    /// particle life time in seconds, 0.0 means particles never die
+    float LifeTime = 0.0f;
+
+    /// number of worker threads for the update (0: update on calling thread)
+    int NumWorkers = 0;
+    /// number of particles processed per work item
+    int ChunkSize = 16 * 1024;
+
+    /// optional instance vertex layout, if set, Update() writes instance data in this format
+    VertexLayout Layout;
+    /// vertex attribute which receives the particle position (Float3 or Float4, w=0)
+    VertexAttr::Code PositionAttr = VertexAttr::Instance0;
+    /// optional vertex attribute which receives the particle velocity (Float3 or Float4, w=0)
+    VertexAttr::Code VelocityAttr = VertexAttr::InvalidVertexAttr;
+    /// optional vertex attribute which receives the particle age (Float)
+    VertexAttr::Code AgeAttr = VertexAttr::InvalidVertexAttr;
+};
+
+} // namespace Oryol
@@ -0,0 +1,408 @@
+//------------------------------------------------------------------------------
+//  ParticleSystem.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "ParticleSystem.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include <cfloat>
+#if ORYOL_HAS_SSE2
+#include <emmintrin.h>
+#elif ORYOL_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+ParticleSystem::ParticleSystem() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+ParticleSystem::~ParticleSystem() {
+    if (this->valid) {
+        this->Discard();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+ParticleSystem::Setup(const ParticleSetup& particleSetup) {
+    o_assert(!this->valid);
+    o_assert(particleSetup.MaxNumParticles > 0);
+    o_assert(particleSetup.ChunkSize > 0);
+    o_assert(particleSetup.LifeTime >= 0.0f);
+    this->valid = true;
+    this->setup = particleSetup;
+    this->numParticles = 0;
+    this->numKilled = 0;
+    this->maxAge = particleSetup.LifeTime > 0.0f ? particleSetup.LifeTime : FLT_MAX;
+
+    // allocate all attribute arrays in one chunk, padded to SIMD width
+    const int capacity = Memory::RoundUp(particleSetup.MaxNumParticles, 4);
+    float* ptr = (float*) Memory::Alloc(capacity * ParticleStream::NumStreams * sizeof(float));
+    for (int i = 0; i < ParticleStream::NumStreams; i++) {
+        this->streams[i] = ptr + i * capacity;
+    }
+    const int maxNumChunks = (particleSetup.MaxNumParticles + particleSetup.ChunkSize - 1) / particleSetup.ChunkSize;
+    this->chunkNumAlive.Reserve(maxNumChunks);
+
+    // setup instance data writing
+    const VertexLayout& layout = particleSetup.Layout;
+    if (!layout.Empty()) {
+        int compIndex = layout.ComponentIndexByVertexAttr(particleSetup.PositionAttr);
+        o_assert2(InvalidIndex != compIndex, "ParticleSystem: PositionAttr not in instance layout!\n");
+        const VertexFormat::Code posFmt = layout.ComponentAt(compIndex).Format;
+        o_assert2((VertexFormat::Float3 == posFmt) || (VertexFormat::Float4 == posFmt), "ParticleSystem: position must be Float3 or Float4!\n");
+        this->positionOffset = layout.ComponentByteOffset(compIndex);
+        this->positionFloat4 = VertexFormat::Float4 == posFmt;
+        if (VertexAttr::InvalidVertexAttr != particleSetup.VelocityAttr) {
+            compIndex = layout.ComponentIndexByVertexAttr(particleSetup.VelocityAttr);
+            o_assert2(InvalidIndex != compIndex, "ParticleSystem: VelocityAttr not in instance layout!\n");
+            const VertexFormat::Code velFmt = layout.ComponentAt(compIndex).Format;
+            o_assert2((VertexFormat::Float3 == velFmt) || (VertexFormat::Float4 == velFmt), "ParticleSystem: velocity must be Float3 or Float4!\n");
+            this->velocityOffset = layout.ComponentByteOffset(compIndex);
+            this->velocityFloat4 = VertexFormat::Float4 == velFmt;
+        }
+        if (VertexAttr::InvalidVertexAttr != particleSetup.AgeAttr) {
+            compIndex = layout.ComponentIndexByVertexAttr(particleSetup.AgeAttr);
+            o_assert2(InvalidIndex != compIndex, "ParticleSystem: AgeAttr not in instance layout!\n");
+            o_assert2(VertexFormat::Float == layout.ComponentAt(compIndex).Format, "ParticleSystem: age must be Float!\n");
+            this->ageOffset = layout.ComponentByteOffset(compIndex);
+        }
+        // other components in the layout are left zero-initialized
+        this->instanceStride = layout.ByteSize();
+        const int instanceBufferSize = this->instanceStride * particleSetup.MaxNumParticles;
+        this->instanceData = (uint8_t*) Memory::Alloc(instanceBufferSize);
+        Memory::Clear(this->instanceData, instanceBufferSize);
+    }
+    this->workers.Setup(particleSetup.NumWorkers);
+}
+
+//------------------------------------------------------------------------------
+void
+ParticleSystem::Discard() {
+    o_assert(this->valid);
+    this->workers.Discard();
+    Memory::Free(this->streams[0]);
+    for (int i = 0; i < ParticleStream::NumStreams; i++) {
+        this->streams[i] = nullptr;
+    }
+    if (this->instanceData) {
+        Memory::Free(this->instanceData);
+        this->instanceData = nullptr;
+    }
+    this->instanceStride = 0;
+    this->instanceDataSize = 0;
+    this->positionOffset = InvalidIndex;
+    this->velocityOffset = InvalidIndex;
+    this->ageOffset = InvalidIndex;
+    this->chunkNumAlive.Clear();
+    this->numParticles = 0;
+    this->valid = false;
+}
+
+//------------------------------------------------------------------------------
+int
+ParticleSystem::Emit(const glm::vec3& pos, const glm::vec3& vel) {
+    o_assert_dbg(this->valid);
+    if (this->numParticles >= this->setup.MaxNumParticles) {
+        return InvalidIndex;
+    }
+    const int index = this->numParticles++;
+    this->streams[ParticleStream::PositionX][index] = pos.x;
+    this->streams[ParticleStream::PositionY][index] = pos.y;
+    this->streams[ParticleStream::PositionZ][index] = pos.z;
+    this->streams[ParticleStream::VelocityX][index] = vel.x;
+    this->streams[ParticleStream::VelocityY][index] = vel.y;
+    this->streams[ParticleStream::VelocityZ][index] = vel.z;
+    this->streams[ParticleStream::Age][index] = 0.0f;
+    return index;
+}
+
+//------------------------------------------------------------------------------
+void
+ParticleSystem::Kill(int index) {
+    o_assert_dbg(this->valid);
+    o_assert_range_dbg(index, this->numParticles);
+    // killed particles are older than any life time
+    this->streams[ParticleStream::Age][index] = FLT_MAX;
+    this->numKilled++;
+}
+
+//------------------------------------------------------------------------------
+void
+ParticleSystem::Clear() {
+    o_assert_dbg(this->valid);
+    this->numParticles = 0;
+    this->numKilled = 0;
+    this->instanceDataSize = 0;
+}
+
+//------------------------------------------------------------------------------
+void
+ParticleSystem::Update(float dt) {
+    o_assert_dbg(this->valid);
+
+    // if no particles can die, instance data is written in the
+    // same pass as the update, otherwise after compaction
+    const bool compact = (this->maxAge < FLT_MAX) || (this->numKilled > 0);
+    const bool writeInstances = nullptr != this->instanceData;
+    const int chunkSize = this->setup.ChunkSize;
+    const int numChunks = (this->numParticles + chunkSize - 1) / chunkSize;
+    this->chunkNumAlive.Clear();
+    for (int i = 0; i < numChunks; i++) {
+        this->chunkNumAlive.Add(0);
+    }
+    this->workers.ParallelFor(this->numParticles, chunkSize, [this, dt, compact, writeInstances, chunkSize](int begin, int end) {
+        this->updateRange(begin, end, dt, writeInstances && !compact);
+        if (compact) {
+            this->chunkNumAlive[begin / chunkSize] = this->compactRange(begin, end);
+        }
+    });
+    if (compact) {
+        this->mergeChunks(numChunks);
+        this->numKilled = 0;
+        if (writeInstances) {
+            uint8_t* dst = this->instanceData;
+            this->workers.ParallelFor(this->numParticles, chunkSize, [this, dst](int begin, int end) {
+                this->writeRange(dst, begin, end);
+            });
+        }
+    }
+    this->instanceDataSize = writeInstances ? this->numParticles * this->instanceStride : 0;
+}
+
+//------------------------------------------------------------------------------
+int
+ParticleSystem::WriteInstanceData(void* dst, int maxBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != this->instanceData);
+    o_assert_dbg(nullptr != dst);
+    o_assert_dbg(maxBytes >= 0);
+    int num = this->numParticles;
+    if ((num * this->instanceStride) > maxBytes) {
+        num = maxBytes / this->instanceStride;
+    }
+    uint8_t* dstPtr = (uint8_t*) dst;
+    this->workers.ParallelFor(num, this->setup.ChunkSize, [this, dstPtr](int begin, int end) {
+        this->writeRange(dstPtr, begin, end);
+    });
+    return num * this->instanceStride;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The update kernel is the SoA version of the Instancing sample's
+    particle update: apply gravity, move, and if the particle has
+    fallen below the floor, reset its height, reflect and damp the
+    velocity. The bounce is done with select-masks instead of a
+    branch, so that 4 particles can be handled at once.
+*/
+void
+ParticleSystem::updateRange(int begin, int end, float dt, bool writeInstances) {
+    float* const px = this->streams[ParticleStream::PositionX];
+    float* const py = this->streams[ParticleStream::PositionY];
+    float* const pz = this->streams[ParticleStream::PositionZ];
+    float* const vx = this->streams[ParticleStream::VelocityX];
+    float* const vy = this->streams[ParticleStream::VelocityY];
+    float* const vz = this->streams[ParticleStream::VelocityZ];
+    float* const age = this->streams[ParticleStream::Age];
+    const float gx = this->setup.Gravity.x * dt;
+    const float gy = this->setup.Gravity.y * dt;
+    const float gz = this->setup.Gravity.z * dt;
+    const float floor = this->setup.FloorHeight;
+    const float bounceHeight = this->setup.BounceHeight;
+    const float damping = this->setup.BounceDamping;
+
+    int i = begin;
+    #if ORYOL_HAS_SSE2
+    const __m128 vgx = _mm_set1_ps(gx), vgy = _mm_set1_ps(gy), vgz = _mm_set1_ps(gz);
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 vfloor = _mm_set1_ps(floor);
+    const __m128 vbounce = _mm_set1_ps(bounceHeight);
+    const __m128 vdamp = _mm_set1_ps(damping);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    for (; (i + 4) <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(px + i), y = _mm_loadu_ps(py + i), z = _mm_loadu_ps(pz + i);
+        __m128 dx = _mm_add_ps(_mm_loadu_ps(vx + i), vgx);
+        __m128 dy = _mm_add_ps(_mm_loadu_ps(vy + i), vgy);
+        __m128 dz = _mm_add_ps(_mm_loadu_ps(vz + i), vgz);
+        x = _mm_add_ps(x, _mm_mul_ps(dx, vdt));
+        y = _mm_add_ps(y, _mm_mul_ps(dy, vdt));
+        z = _mm_add_ps(z, _mm_mul_ps(dz, vdt));
+        const __m128 mask = _mm_cmplt_ps(y, vfloor);
+        y = _mm_or_ps(_mm_and_ps(mask, vbounce), _mm_andnot_ps(mask, y));
+        const __m128 d = _mm_or_ps(_mm_and_ps(mask, vdamp), _mm_andnot_ps(mask, one));
+        dx = _mm_mul_ps(dx, d);
+        dy = _mm_mul_ps(_mm_xor_ps(dy, _mm_and_ps(mask, signBit)), d);
+        dz = _mm_mul_ps(dz, d);
+        _mm_storeu_ps(px + i, x); _mm_storeu_ps(py + i, y); _mm_storeu_ps(pz + i, z);
+        _mm_storeu_ps(vx + i, dx); _mm_storeu_ps(vy + i, dy); _mm_storeu_ps(vz + i, dz);
+        _mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), vdt));
+    }
+    #elif ORYOL_HAS_NEON
+    const float32x4_t vgx = vdupq_n_f32(gx), vgy = vdupq_n_f32(gy), vgz = vdupq_n_f32(gz);
+    const float32x4_t vdt = vdupq_n_f32(dt);
+    const float32x4_t vfloor = vdupq_n_f32(floor);
+    const float32x4_t vbounce = vdupq_n_f32(bounceHeight);
+    const float32x4_t vdamp = vdupq_n_f32(damping);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    for (; (i + 4) <= end; i += 4) {
+        float32x4_t x = vld1q_f32(px + i), y = vld1q_f32(py + i), z = vld1q_f32(pz + i);
+        float32x4_t dx = vaddq_f32(vld1q_f32(vx + i), vgx);
+        float32x4_t dy = vaddq_f32(vld1q_f32(vy + i), vgy);
+        float32x4_t dz = vaddq_f32(vld1q_f32(vz + i), vgz);
+        x = vmlaq_f32(x, dx, vdt);
+        y = vmlaq_f32(y, dy, vdt);
+        z = vmlaq_f32(z, dz, vdt);
+        const uint32x4_t mask = vcltq_f32(y, vfloor);
+        y = vbslq_f32(mask, vbounce, y);
+        const float32x4_t d = vbslq_f32(mask, vdamp, one);
+        dx = vmulq_f32(dx, d);
+        dy = vmulq_f32(vbslq_f32(mask, vnegq_f32(dy), dy), d);
+        dz = vmulq_f32(dz, d);
+        vst1q_f32(px + i, x); vst1q_f32(py + i, y); vst1q_f32(pz + i, z);
+        vst1q_f32(vx + i, dx); vst1q_f32(vy + i, dy); vst1q_f32(vz + i, dz);
+        vst1q_f32(age + i, vaddq_f32(vld1q_f32(age + i), vdt));
+    }
+    #endif
+    // scalar fallback and remainder, the compiler turns the selects into cmovs
+    for (; i < end; i++) {
+        const float dx = vx[i] + gx;
+        const float dy = vy[i] + gy;
+        const float dz = vz[i] + gz;
+        px[i] += dx * dt;
+        pz[i] += dz * dt;
+        const float y = py[i] + dy * dt;
+        const bool bounce = y < floor;
+        const float d = bounce ? damping : 1.0f;
+        py[i] = bounce ? bounceHeight : y;
+        vx[i] = dx * d;
+        vy[i] = (bounce ? -dy : dy) * d;
+        vz[i] = dz * d;
+        age[i] += dt;
+    }
+
+    if (writeInstances) {
+        this->writeRange(this->instanceData, begin, end);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Branchless compaction: each particle is unconditionally copied to
+    the current write position, which is only advanced if the particle
+    is alive.
+*/
+int
+ParticleSystem::compactRange(int begin, int end) {
+    float* const px = this->streams[ParticleStream::PositionX];
+    float* const py = this->streams[ParticleStream::PositionY];
+    float* const pz = this->streams[ParticleStream::PositionZ];
+    float* const vx = this->streams[ParticleStream::VelocityX];
+    float* const vy = this->streams[ParticleStream::VelocityY];
+    float* const vz = this->streams[ParticleStream::VelocityZ];
+    float* const age = this->streams[ParticleStream::Age];
+    const float maxAge = this->maxAge;
+    int w = begin;
+    for (int i = begin; i < end; i++) {
+        const float a = age[i];
+        px[w] = px[i]; py[w] = py[i]; pz[w] = pz[i];
+        vx[w] = vx[i]; vy[w] = vy[i]; vz[w] = vz[i];
+        age[w] = a;
+        w += int(a < maxAge);
+    }
+    return w - begin;
+}
+
+//------------------------------------------------------------------------------
+void
+ParticleSystem::mergeChunks(int numChunks) {
+    // the first chunk is already in place, move the alive particles
+    // of the following chunks down to close the gaps
+    const int chunkSize = this->setup.ChunkSize;
+    int dst = numChunks > 0 ? this->chunkNumAlive[0] : 0;
+    for (int chunk = 1; chunk < numChunks; chunk++) {
+        const int src = chunk * chunkSize;
+        const int num = this->chunkNumAlive[chunk];
+        if ((num > 0) && (src != dst)) {
+            for (int i = 0; i < ParticleStream::NumStreams; i++) {
+                Memory::Move(this->streams[i] + src, this->streams[i] + dst, num * sizeof(float));
+            }
+        }
+        dst += num;
+    }
+    this->numParticles = dst;
+}
+
+//------------------------------------------------------------------------------
+void
+ParticleSystem::writeRange(uint8_t* dst, int begin, int end) const {
+    const float* const px = this->streams[ParticleStream::PositionX];
+    const float* const py = this->streams[ParticleStream::PositionY];
+    const float* const pz = this->streams[ParticleStream::PositionZ];
+    const float* const vx = this->streams[ParticleStream::VelocityX];
+    const float* const vy = this->streams[ParticleStream::VelocityY];
+    const float* const vz = this->streams[ParticleStream::VelocityZ];
+    const float* const age = this->streams[ParticleStream::Age];
+    const int stride = this->instanceStride;
+
+    // fast path for the common 'only a Float4 position' layout, this
+    // is a plain SoA => AoS transpose
+    int i = begin;
+    if (this->positionFloat4 && (16 == stride) && (InvalidIndex == this->velocityOffset) && (InvalidIndex == this->ageOffset)) {
+        float* d = (float*) dst;
+        #if ORYOL_HAS_SSE2
+        const __m128 zero = _mm_setzero_ps();
+        for (; (i + 4) <= end; i += 4) {
+            __m128 x = _mm_loadu_ps(px + i), y = _mm_loadu_ps(py + i), z = _mm_loadu_ps(pz + i), w = zero;
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            _mm_storeu_ps(d + i * 4 + 0, x);
+            _mm_storeu_ps(d + i * 4 + 4, y);
+            _mm_storeu_ps(d + i * 4 + 8, z);
+            _mm_storeu_ps(d + i * 4 + 12, w);
+        }
+        #elif ORYOL_HAS_NEON
+        float32x4x4_t v;
+        v.val[3] = vdupq_n_f32(0.0f);
+        for (; (i + 4) <= end; i += 4) {
+            v.val[0] = vld1q_f32(px + i);
+            v.val[1] = vld1q_f32(py + i);
+            v.val[2] = vld1q_f32(pz + i);
+            vst4q_f32(d + i * 4, v);
+        }
+        #endif
+        for (; i < end; i++) {
+            d[i * 4 + 0] = px[i];
+            d[i * 4 + 1] = py[i];
+            d[i * 4 + 2] = pz[i];
+            d[i * 4 + 3] = 0.0f;
+        }
+        return;
+    }
+
+    // generic path, write each mapped component
+    for (; i < end; i++) {
+        uint8_t* vtx = dst + i * stride;
+        float* p = (float*) (vtx + this->positionOffset);
+        p[0] = px[i]; p[1] = py[i]; p[2] = pz[i];
+        if (this->positionFloat4) {
+            p[3] = 0.0f;
+        }
+        if (InvalidIndex != this->velocityOffset) {
+            float* v = (float*) (vtx + this->velocityOffset);
+            v[0] = vx[i]; v[1] = vy[i]; v[2] = vz[i];
+            if (this->velocityFloat4) {
+                v[3] = 0.0f;
+            }
+        }
+        if (InvalidIndex != this->ageOffset) {
+            *(float*) (vtx + this->ageOffset) = age[i];
+        }
+    }
+}
+
+} // namespace Oryol
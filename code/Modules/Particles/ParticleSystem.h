@@ -0,0 +1,178 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @defgroup Particles Particles
+    @brief CPU particle simulation
+
+    @class Oryol::ParticleSystem
+    @ingroup Particles
+    @brief SoA particle simulation with SIMD update kernels
+
+    Particle attributes are stored in separate float arrays (one
+    array per component, see ParticleStream), the update kernels
+    process 4 particles at once with SSE2 or NEON (with a scalar
+    fallback), bouncing on the floor plane is branchless.
+
+    If ParticleSetup::NumWorkers is > 0, the particles are split into
+    chunks of ParticleSetup::ChunkSize which are updated in parallel
+    on a WorkerPool.
+
+    Emitted particles are appended at the end of the arrays, dead
+    particles (older than ParticleSetup::LifeTime, or explicitly
+    killed) are removed during Update() by branchless compaction,
+    so particle indices are not stable across Update() calls.
+
+    If ParticleSetup::Layout is set, Update() also writes the alive
+    particles in that vertex layout format into an instance data
+    buffer which can be handed directly to Gfx::UpdateVertices().
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "Core/Threading/WorkerPool.h"
+#include "Particles/ParticleSetup.h"
+#include "glm/vec3.hpp"
+
+namespace Oryol {
+
+/// the per-particle attribute arrays of a ParticleSystem
+struct ParticleStream {
+    enum Code {
+        PositionX = 0,
+        PositionY,
+        PositionZ,
+        VelocityX,
+        VelocityY,
+        VelocityZ,
+        Age,
+
+        NumStreams,
+        InvalidStream,
+    };
+};
+
+class ParticleSystem {
+public:
+    /// constructor
+    ParticleSystem();
+    /// destructor
+    ~ParticleSystem();
+
+    /// setup the particle system
+    void Setup(const ParticleSetup& setup);
+    /// discard the particle system
+    void Discard();
+    /// return true if the particle system has been setup
+    bool IsValid() const;
+
+    /// emit a new particle, returns InvalidIndex if the particle system is full
+    int Emit(const glm::vec3& pos, const glm::vec3& vel);
+    /// kill a particle, it will be removed in the next Update()
+    void Kill(int index);
+    /// kill all particles immediately
+    void Clear();
+    /// advance the simulation, remove dead particles and write instance data
+    void Update(float dt);
+
+    /// get current number of particles
+    int NumParticles() const;
+    /// get max number of particles
+    int MaxNumParticles() const;
+    /// direct read-only access to a particle attribute array
+    const float* Stream(ParticleStream::Code stream) const;
+    /// get position of a particle
+    glm::vec3 Position(int index) const;
+    /// get velocity of a particle
+    glm::vec3 Velocity(int index) const;
+
+    /// get pointer to instance data written in Update() (only if Layout was set)
+    const void* InstanceData() const;
+    /// get byte size of valid instance data
+    int InstanceDataSize() const;
+    /// write instance data for all particles into external memory, return number of bytes written
+    int WriteInstanceData(void* dst, int maxBytes);
+
+private:
+    /// integrate a range of particles, optionally write instance data
+    void updateRange(int begin, int end, float dt, bool writeInstances);
+    /// move alive particles to the front of a range, return number of alive particles
+    int compactRange(int begin, int end);
+    /// close the gaps between compacted chunks
+    void mergeChunks(int numChunks);
+    /// write instance data for a range of particles
+    void writeRange(uint8_t* dst, int begin, int end) const;
+
+    bool valid = false;
+    ParticleSetup setup;
+    WorkerPool workers;
+    float* streams[ParticleStream::NumStreams] = { };
+    int numParticles = 0;
+    int numKilled = 0;
+    float maxAge = 0.0f;
+    Array<int> chunkNumAlive;
+
+    uint8_t* instanceData = nullptr;
+    int instanceStride = 0;
+    int instanceDataSize = 0;
+    int positionOffset = InvalidIndex;
+    int velocityOffset = InvalidIndex;
+    int ageOffset = InvalidIndex;
+    bool positionFloat4 = false;
+    bool velocityFloat4 = false;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+ParticleSystem::IsValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+inline int
+ParticleSystem::NumParticles() const {
+    return this->numParticles;
+}
+
+//------------------------------------------------------------------------------
+inline int
+ParticleSystem::MaxNumParticles() const {
+    return this->setup.MaxNumParticles;
+}
+
+//------------------------------------------------------------------------------
+inline const float*
+ParticleSystem::Stream(ParticleStream::Code stream) const {
+    o_assert_range_dbg(stream, ParticleStream::NumStreams);
+    return this->streams[stream];
+}
+
+//------------------------------------------------------------------------------
+inline glm::vec3
+ParticleSystem::Position(int index) const {
+    o_assert_range_dbg(index, this->numParticles);
+    return glm::vec3(this->streams[ParticleStream::PositionX][index],
+                     this->streams[ParticleStream::PositionY][index],
+                     this->streams[ParticleStream::PositionZ][index]);
+}
+
+//------------------------------------------------------------------------------
+inline glm::vec3
+ParticleSystem::Velocity(int index) const {
+    o_assert_range_dbg(index, this->numParticles);
+    return glm::vec3(this->streams[ParticleStream::VelocityX][index],
+                     this->streams[ParticleStream::VelocityY][index],
+                     this->streams[ParticleStream::VelocityZ][index]);
+}
+
+//------------------------------------------------------------------------------
+inline const void*
+ParticleSystem::InstanceData() const {
+    return this->instanceData;
+}
+
+//------------------------------------------------------------------------------
+inline int
+ParticleSystem::InstanceDataSize() const {
+    return this->instanceDataSize;
+}
+
+} // namespace Oryol
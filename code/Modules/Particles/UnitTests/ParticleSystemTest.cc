@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+//  ParticleSystemTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Particles/ParticleSystem.h"
+#include "Core/Time/Clock.h"
+#include "Core/Log.h"
+#include <cmath>
+
+using namespace Oryol;
+
+// scalar AoS reference update, as in the Instancing sample
+struct refParticle {
+    glm::vec3 pos;
+    glm::vec3 vec;
+};
+
+static void
+refUpdate(refParticle& p, float dt) {
+    p.vec.y -= 1.0f * dt;
+    p.pos = p.pos + p.vec * dt;
+    if (p.pos.y < -2.0f) {
+        p.pos.y = -1.8f;
+        p.vec.y = -p.vec.y;
+        p.vec = p.vec * 0.8f;
+    }
+}
+
+static bool
+equal(const glm::vec3& a, const glm::vec3& b) {
+    return (std::fabs(a.x - b.x) < 0.0001f) && (std::fabs(a.y - b.y) < 0.0001f) && (std::fabs(a.z - b.z) < 0.0001f);
+}
+
+TEST(ParticleSystemUpdateTest) {
+    const int num = 1003;
+    const float dt = 1.0f / 60.0f;
+    refParticle ref[num];
+    for (int numWorkers = 0; numWorkers < 3; numWorkers++) {
+        ParticleSetup setup;
+        setup.MaxNumParticles = num;
+        setup.NumWorkers = numWorkers;
+        setup.ChunkSize = 128;
+        ParticleSystem ps;
+        ps.Setup(setup);
+        CHECK(ps.IsValid());
+        CHECK(ps.MaxNumParticles() == num);
+        for (int i = 0; i < num; i++) {
+            ref[i].pos = glm::vec3(0.0f, 0.0f, 0.0f);
+            ref[i].vec = glm::vec3((i % 7) * 0.1f - 0.3f, 2.0f + (i % 5) * 0.1f, (i % 3) * 0.1f);
+            CHECK(ps.Emit(ref[i].pos, ref[i].vec) == i);
+        }
+        CHECK(ps.Emit(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f)) == InvalidIndex);
+        CHECK(ps.NumParticles() == num);
+
+        // run long enough for all particles to bounce a few times
+        for (int frame = 0; frame < 600; frame++) {
+            ps.Update(dt);
+            for (int i = 0; i < num; i++) {
+                refUpdate(ref[i], dt);
+            }
+        }
+        CHECK(ps.NumParticles() == num);
+        bool allEqual = true;
+        for (int i = 0; i < num; i++) {
+            allEqual &= equal(ps.Position(i), ref[i].pos);
+            allEqual &= equal(ps.Velocity(i), ref[i].vec);
+        }
+        CHECK(allEqual);
+        CHECK(std::fabs(ps.Stream(ParticleStream::Age)[0] - 600 * dt) < 0.001f);
+        ps.Discard();
+        CHECK(!ps.IsValid());
+    }
+}
+
+TEST(ParticleSystemKillTest) {
+    for (int numWorkers = 0; numWorkers < 3; numWorkers++) {
+        ParticleSetup setup;
+        setup.MaxNumParticles = 1000;
+        setup.NumWorkers = numWorkers;
+        setup.ChunkSize = 64;
+        setup.Gravity = glm::vec3(0.0f, 0.0f, 0.0f);
+        setup.LifeTime = 1.0f;
+        ParticleSystem ps;
+        ps.Setup(setup);
+
+        // x position is the particle's id
+        for (int i = 0; i < 1000; i++) {
+            ps.Emit(glm::vec3(float(i), 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f));
+        }
+        // explicitly kill every 3rd particle, order of survivors is preserved
+        for (int i = 0; i < 1000; i += 3) {
+            ps.Kill(i);
+        }
+        ps.Update(0.5f);
+        CHECK(ps.NumParticles() == 666);
+        bool ordered = true;
+        for (int i = 0; i < ps.NumParticles(); i++) {
+            const int id = int(ps.Position(i).x);
+            ordered &= (id % 3) != 0;
+            ordered &= (i == 0) || (id > int(ps.Position(i - 1).x));
+        }
+        CHECK(ordered);
+
+        // new particles are younger and survive the old ones
+        for (int i = 0; i < 10; i++) {
+            ps.Emit(glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f));
+        }
+        ps.Update(0.6f);
+        CHECK(ps.NumParticles() == 10);
+        CHECK(ps.Position(0).x == -1.0f);
+        ps.Update(0.6f);
+        CHECK(ps.NumParticles() == 0);
+        ps.Discard();
+    }
+}
+
+TEST(ParticleSystemInstanceDataTest) {
+    // Float4 position only (the SIMD fast path)
+    {
+        ParticleSetup setup;
+        setup.MaxNumParticles = 7;
+        setup.Layout.EnableInstancing().Add(VertexAttr::Instance0, VertexFormat::Float4);
+        ParticleSystem ps;
+        ps.Setup(setup);
+        for (int i = 0; i < 7; i++) {
+            ps.Emit(glm::vec3(float(i), float(i) * 0.1f, float(-i)), glm::vec3(0.0f, 1.0f, 0.0f));
+        }
+        ps.Update(0.0f);
+        CHECK(ps.InstanceDataSize() == 7 * 16);
+        const float* d = (const float*) ps.InstanceData();
+        bool ok = true;
+        for (int i = 0; i < 7; i++) {
+            ok &= d[i * 4 + 0] == float(i);
+            ok &= d[i * 4 + 1] == float(i) * 0.1f;
+            ok &= d[i * 4 + 2] == float(-i);
+            ok &= d[i * 4 + 3] == 0.0f;
+        }
+        CHECK(ok);
+
+        float buf[4 * 4];
+        CHECK(ps.WriteInstanceData(buf, sizeof(buf)) == 4 * 16);
+        CHECK((buf[12] == 3.0f) && (buf[14] == -3.0f));
+    }
+    // mixed layout with position, age and velocity
+    {
+        ParticleSetup setup;
+        setup.MaxNumParticles = 5;
+        setup.LifeTime = 10.0f;
+        setup.Layout.EnableInstancing()
+            .Add(VertexAttr::Instance0, VertexFormat::Float3)
+            .Add(VertexAttr::Instance1, VertexFormat::Float)
+            .Add(VertexAttr::Instance2, VertexFormat::Float4);
+        setup.AgeAttr = VertexAttr::Instance1;
+        setup.VelocityAttr = VertexAttr::Instance2;
+        setup.Gravity = glm::vec3(0.0f, 0.0f, 0.0f);
+        ParticleSystem ps;
+        ps.Setup(setup);
+        for (int i = 0; i < 5; i++) {
+            ps.Emit(glm::vec3(float(i), 0.0f, 0.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+        }
+        ps.Kill(1);
+        ps.Update(1.0f);
+        CHECK(ps.NumParticles() == 4);
+        CHECK(ps.InstanceDataSize() == 4 * 32);
+        const float* d = (const float*) ps.InstanceData();
+        CHECK(d[0] == 1.0f);
+        CHECK(d[8] == 3.0f);
+        CHECK(d[3] == 1.0f);
+        CHECK((d[4] == 1.0f) && (d[5] == 2.0f) && (d[6] == 3.0f) && (d[7] == 0.0f));
+    }
+}
+
+TEST(ParticleSystemPerformanceTest) {
+    const int num = 1024 * 1024;
+    ParticleSetup setup;
+    setup.MaxNumParticles = num;
+    setup.NumWorkers = 3;
+    setup.Layout.EnableInstancing().Add(VertexAttr::Instance0, VertexFormat::Float4);
+    ParticleSystem ps;
+    ps.Setup(setup);
+    for (int i = 0; i < num; i++) {
+        ps.Emit(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3((i & 15) * 0.05f, 2.0f, 0.5f));
+    }
+    TimePoint start = Clock::Now();
+    for (int i = 0; i < 10; i++) {
+        ps.Update(1.0f / 60.0f);
+    }
+    Duration dur = Clock::Since(start);
+    Log::Info("ParticleSystem: update+write of 1M particles: %.3fms\n", dur.AsMilliSeconds() / 10.0);
+    CHECK(ps.InstanceDataSize() == num * 16);
+}
@@ -31,4 +31,16 @@ ResourceLoader::Cancel() {
     // empty
 }
 
+//------------------------------------------------------------------------------
+void
+ResourceLoader::Prefetch() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+void
+ResourceLoader::CancelPrefetch() {
+    // empty
+}
+
 } // namespace Oryol
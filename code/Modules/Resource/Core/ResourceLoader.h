@@ -23,6 +23,10 @@ public:
     virtual ResourceState::Code Continue();
     /// cancel the resource loading process
     virtual void Cancel();
+    /// warm-up: start loading the resource data without creating the resource
+    virtual void Prefetch();
+    /// cancel a warm-up started with Prefetch() and drop the prefetched data
+    virtual void CancelPrefetch();
 };
 
 } // namespace Oryol
@@ -62,6 +62,8 @@ public:
     int GetNumUsedSlots() const;
     /// get number of free slots
     int GetNumFreeSlots() const;
+    /// get generation counter, changes whenever a resource is assigned, unassigned or changes state
+    uint32_t GetGeneration() const;
     
 protected:
     /// free a resource id
@@ -70,6 +72,7 @@ protected:
     bool isValid;
     int frameCounter;
     int uniqueCounter;
+    uint32_t generation;
     Id::TypeT resourceType;
     
     Array<RESOURCE> slots;
@@ -82,6 +85,7 @@ ResourcePool<RESOURCE,SETUP>::ResourcePool() :
 isValid(false),
 frameCounter(0),
 uniqueCounter(0),
+generation(0),
 resourceType(0xFF) {
     // empty
 }
@@ -174,6 +178,7 @@ ResourcePool<RESOURCE,SETUP>::Assign(const Id& id, const SETUP& setup, ResourceS
     slot.StateStartFrame = this->frameCounter;
     slot.Id = id;
     slot.Setup = setup;
+    this->generation++;
     return slot;
 }
 
@@ -188,6 +193,7 @@ ResourcePool<RESOURCE,SETUP>::Unassign(const Id& id) {
         slot.Id.Invalidate();
         slot.State = ResourceState::Initial;
         slot.StateStartFrame = 0;
+        this->generation++;
         this->freeId(id);
     }
     else {
@@ -236,6 +242,7 @@ ResourcePool<RESOURCE, SETUP>::UpdateState(const Id& id, ResourceState::Code new
         o_assert_dbg(ResourceState::Initial != slot.State);
         slot.State = newState;
         slot.StateStartFrame = this->frameCounter;
+        this->generation++;
     }
     else {
         o_warn("ResourcePool::UpdateState(): id not in pool (type: '%d', slot: '%d')\n", id.Type, id.SlotIndex);
@@ -316,4 +323,10 @@ ResourcePool<RESOURCE,SETUP>::GetNumFreeSlots() const {
     return this->freeSlots.Size();
 }
 
+//------------------------------------------------------------------------------
+template<class RESOURCE, class SETUP> uint32_t
+ResourcePool<RESOURCE,SETUP>::GetGeneration() const {
+    return this->generation;
+}
+
 } // namespace Oryol
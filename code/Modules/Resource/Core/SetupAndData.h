@@ -6,9 +6,13 @@
     @brief holds a setup and a data buffer object
     
     This is used to transfer both a resource setup object and 
-    a stream object to resource creation functions.
+    a data object to resource creation functions. The data is held
+    in a SharedBuffer, so that SetupAndData objects are cheap to
+    copy, and the data may be a slice of a bigger payload (for
+    instance a loaded file) without copying.
 */
 #include "Core/Containers/Buffer.h"
+#include "Core/Containers/SharedBuffer.h"
 
 namespace Oryol {
 
@@ -16,12 +20,18 @@ template<class SETUP> class SetupAndData {
 public:
     /// default constructor
     SetupAndData() { };
-    /// construct from Setup and Stream object
+    /// construct from Setup and Buffer object (takes ownership of data)
     SetupAndData(const SETUP& setup, Buffer&& data) :
         Setup(setup),
         Data(std::move(data)) {
         // empty
     };
+    /// construct from Setup and SharedBuffer object (shares data)
+    SetupAndData(const SETUP& setup, const SharedBuffer& data) :
+        Setup(setup),
+        Data(data) {
+        // empty
+    };
     /// move construct
     SetupAndData(SetupAndData<SETUP>&& rhs) {
         this->Setup = std::move(rhs.Setup);
@@ -32,16 +42,22 @@ public:
         this->Setup = std::move(rhs.Setup);
         this->Data = std::move(rhs.Data);        
     };
-
-    /// disable copy constructor
-    SetupAndData(const SetupAndData<SETUP>& rhs) = delete;
-    /// disable copy assignment
-    void operator=(const SetupAndData<SETUP>& rhs) = delete;
+    /// copy constructor (data is shared, not copied)
+    SetupAndData(const SetupAndData<SETUP>& rhs) :
+        Setup(rhs.Setup),
+        Data(rhs.Data) {
+        // empty
+    };
+    /// copy assignment (data is shared, not copied)
+    void operator=(const SetupAndData<SETUP>& rhs) {
+        this->Setup = rhs.Setup;
+        this->Data = rhs.Data;
+    };
     
     /// embedded setup object
     SETUP Setup;
-    /// embedded data buffer
-    Buffer Data;
+    /// embedded data object
+    SharedBuffer Data;
 };
 
-} // namespace Oryol
\ No newline at end of file
+} // namespace Oryol
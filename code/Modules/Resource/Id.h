@@ -11,6 +11,8 @@
     Resource identifiers are abstract handles to a resource object.
 */
 #include "Core/Types.h"
+#include "Core/Hash/Hash.h"
+#include "Core/Containers/Relocatable.h"
 
 namespace Oryol {
     
@@ -137,7 +139,16 @@ Id::Invalidate() {
     this->Value = invalidId;
 }
 
+//------------------------------------------------------------------------------
+template<> struct HashTraits<Id> {
+    static uint64_t Compute(const Id& id) {
+        return Hash::Mix(id.Value);
+    };
+};
+
 } // namespace Oryol
+
+ORYOL_TRIVIALLY_RELOCATABLE(Oryol::Id)
     
  
     
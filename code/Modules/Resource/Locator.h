@@ -18,6 +18,7 @@
 */
 #include "Core/Types.h"
 #include "Core/String/StringAtom.h"
+#include "Core/Hash/Hash.h"
 
 namespace Oryol {
 
@@ -139,4 +140,11 @@ Locator::Signature() const {
     return this->signature;
 }
 
+//------------------------------------------------------------------------------
+template<> struct HashTraits<Locator> {
+    static uint64_t Compute(const Locator& loc) {
+        return Hash::Combine(HashTraits<StringAtom>::Compute(loc.Location()), loc.Signature());
+    };
+};
+
 } // namespace Oryol
@@ -86,4 +86,35 @@ TEST(ResourcePoolTest) {
     
     resourcePool.Discard();
     CHECK(!resourcePool.IsValid());
+}
+
+TEST(ResourcePoolGenerationTest) {
+    myResourcePool resourcePool;
+    resourcePool.Setup(12, 16);
+    uint32_t gen = resourcePool.GetGeneration();
+
+    // allocating an id or looking up resources doesn't change the generation
+    Id resId = resourcePool.AllocId();
+    CHECK(resourcePool.GetGeneration() == gen);
+
+    resourcePool.Assign(resId, mySetup(1), ResourceState::Pending);
+    CHECK(resourcePool.GetGeneration() != gen);
+    gen = resourcePool.GetGeneration();
+    CHECK(nullptr == resourcePool.Lookup(resId));
+    CHECK(resourcePool.GetGeneration() == gen);
+
+    resourcePool.UpdateState(resId, ResourceState::Valid);
+    CHECK(resourcePool.GetGeneration() != gen);
+    gen = resourcePool.GetGeneration();
+    CHECK(nullptr != resourcePool.Lookup(resId));
+    CHECK(resourcePool.GetGeneration() == gen);
+
+    resourcePool.Unassign(resId);
+    CHECK(resourcePool.GetGeneration() != gen);
+    gen = resourcePool.GetGeneration();
+
+    // unassigning a dangling id changes nothing
+    resourcePool.Unassign(resId);
+    CHECK(resourcePool.GetGeneration() == gen);
+    resourcePool.Discard();
 }
\ No newline at end of file
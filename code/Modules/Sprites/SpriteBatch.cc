@@ -0,0 +1,442 @@
+//------------------------------------------------------------------------------
+//  SpriteBatch.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "SpriteBatch.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include "Gfx/Gfx.h"
+#include "SpriteShaders.h"
+#include <cmath>
+#if ORYOL_HAS_SSE2
+#include <emmintrin.h>
+#elif ORYOL_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+SpriteBatch::SpriteBatch() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+SpriteBatch::~SpriteBatch() {
+    if (this->valid) {
+        this->Discard();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+SpriteBatch::Setup(const SpriteBatchSetup& spriteSetup) {
+    o_assert(!this->valid);
+    o_assert(spriteSetup.MaxNumSprites > 0);
+    this->valid = true;
+    this->setup = spriteSetup;
+    this->numItems = 0;
+
+    // sort keys, sorted indices and radix sort scratch share one allocation
+    const int maxSprites = spriteSetup.MaxNumSprites;
+    this->items = (item*) Memory::Alloc(maxSprites * sizeof(item));
+    this->keys = (uint32_t*) Memory::Alloc(maxSprites * 3 * sizeof(uint32_t));
+    this->sorted = this->keys + maxSprites;
+    this->scratch = this->sorted + maxSprites;
+    this->vertices = (Vertex*) Memory::Alloc(maxSprites * 4 * sizeof(Vertex));
+}
+
+//------------------------------------------------------------------------------
+void
+SpriteBatch::Discard() {
+    o_assert(this->valid);
+    if (this->resourcesValid) {
+        Gfx::DestroyResources(this->resourceLabel);
+        this->resourcesValid = false;
+    }
+    this->drawState = DrawState();
+    Memory::Free(this->items);
+    Memory::Free(this->keys);
+    Memory::Free(this->vertices);
+    this->items = nullptr;
+    this->keys = nullptr;
+    this->sorted = nullptr;
+    this->scratch = nullptr;
+    this->vertices = nullptr;
+    this->numItems = 0;
+    this->textures.Clear();
+    this->lastTexture.Invalidate();
+    this->lastSlot = InvalidIndex;
+    this->batches.Clear();
+    this->valid = false;
+}
+
+//------------------------------------------------------------------------------
+VertexLayout
+SpriteBatch::Layout() {
+    VertexLayout layout;
+    layout.Add(VertexAttr::Position, VertexFormat::Float2)
+        .Add(VertexAttr::TexCoord0, VertexFormat::Float2)
+        .Add(VertexAttr::Color0, VertexFormat::UByte4N);
+    return layout;
+}
+
+//------------------------------------------------------------------------------
+void
+SpriteBatch::setupResources() {
+    o_assert(!this->resourcesValid);
+    const int maxSprites = this->setup.MaxNumSprites;
+    this->resourceLabel = Gfx::PushResourceLabel();
+
+    // a stream vertex buffer, and a static index buffer with 2 triangles per sprite
+    const bool index16 = (maxSprites * 4) <= (1<<16);
+    const int numIndices = maxSprites * 6;
+    Buffer data;
+    if (index16) {
+        uint16_t* dst = (uint16_t*) data.Add(numIndices * sizeof(uint16_t));
+        for (int i = 0; i < maxSprites; i++) {
+            const uint16_t base = uint16_t(i * 4);
+            *dst++ = base; *dst++ = base + 1; *dst++ = base + 2;
+            *dst++ = base; *dst++ = base + 2; *dst++ = base + 3;
+        }
+    }
+    else {
+        uint32_t* dst = (uint32_t*) data.Add(numIndices * sizeof(uint32_t));
+        for (int i = 0; i < maxSprites; i++) {
+            const uint32_t base = uint32_t(i * 4);
+            *dst++ = base; *dst++ = base + 1; *dst++ = base + 2;
+            *dst++ = base; *dst++ = base + 2; *dst++ = base + 3;
+        }
+    }
+    auto meshSetup = MeshSetup::FromData(Usage::Stream, Usage::Immutable);
+    meshSetup.Layout = Layout();
+    meshSetup.NumVertices = maxSprites * 4;
+    meshSetup.NumIndices = numIndices;
+    meshSetup.IndicesType = index16 ? IndexType::Index16 : IndexType::Index32;
+    meshSetup.DataVertexOffset = InvalidIndex;
+    meshSetup.DataIndexOffset = 0;
+    this->drawState.Mesh[0] = Gfx::CreateResource(meshSetup, data);
+
+    // the pipeline with alpha blending, no depth test
+    Id shd = Gfx::CreateResource(SpriteShader::Setup());
+    auto ps = PipelineSetup::FromLayoutAndShader(meshSetup.Layout, shd);
+    ps.DepthStencilState.DepthWriteEnabled = false;
+    ps.DepthStencilState.DepthCmpFunc = CompareFunc::Always;
+    ps.BlendState.BlendEnabled = true;
+    ps.BlendState.SrcFactorRGB = this->setup.PremultipliedAlpha ? BlendFactor::One : BlendFactor::SrcAlpha;
+    ps.BlendState.DstFactorRGB = BlendFactor::OneMinusSrcAlpha;
+    ps.BlendState.ColorWriteMask = PixelChannel::RGB;
+    const auto& rtAttrs = Gfx::RenderTargetAttrs();
+    ps.BlendState.ColorFormat = PixelFormat::InvalidPixelFormat != this->setup.ColorFormat ? this->setup.ColorFormat : rtAttrs.ColorPixelFormat;
+    ps.BlendState.DepthFormat = PixelFormat::InvalidPixelFormat != this->setup.DepthFormat ? this->setup.DepthFormat : rtAttrs.DepthPixelFormat;
+    ps.RasterizerState.SampleCount = this->setup.SampleCount > 0 ? this->setup.SampleCount : rtAttrs.SampleCount;
+    this->drawState.Pipeline = Gfx::CreateResource(ps);
+
+    Gfx::PopResourceLabel();
+    this->resourcesValid = true;
+}
+
+//------------------------------------------------------------------------------
+void
+SpriteBatch::Begin() {
+    o_assert_dbg(this->valid);
+    this->numItems = 0;
+    this->textures.Clear();
+    this->lastTexture.Invalidate();
+    this->lastSlot = InvalidIndex;
+    this->batches.Clear();
+}
+
+//------------------------------------------------------------------------------
+int
+SpriteBatch::textureSlot(const Id& tex) {
+    // consecutive sprites usually share the same texture
+    if (tex == this->lastTexture) {
+        return this->lastSlot;
+    }
+    int slot = this->textures.FindIndexLinear(tex);
+    if (InvalidIndex == slot) {
+        o_assert(this->textures.Size() < (1<<16));
+        slot = this->textures.Size();
+        this->textures.Add(tex);
+    }
+    this->lastTexture = tex;
+    this->lastSlot = slot;
+    return slot;
+}
+
+//------------------------------------------------------------------------------
+bool
+SpriteBatch::Add(const Sprite& sprite) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg((sprite.Layer >= -(1<<15)) && (sprite.Layer < (1<<15)));
+    if (this->numItems >= this->setup.MaxNumSprites) {
+        return false;
+    }
+    const int index = this->numItems++;
+    item& it = this->items[index];
+    it.x = sprite.Position.x;
+    it.y = sprite.Position.y;
+    if (0.0f != sprite.Rotation) {
+        it.rotCos = std::cos(sprite.Rotation);
+        it.rotSin = std::sin(sprite.Rotation);
+    }
+    else {
+        it.rotCos = 1.0f;
+        it.rotSin = 0.0f;
+    }
+    it.left = -sprite.Pivot.x * sprite.Size.x;
+    it.top = -sprite.Pivot.y * sprite.Size.y;
+    it.right = it.left + sprite.Size.x;
+    it.bottom = it.top + sprite.Size.y;
+    it.u0 = sprite.Rect.U0;
+    it.v0 = sprite.Rect.V0;
+    it.u1 = sprite.Rect.U1;
+    it.v1 = sprite.Rect.V1;
+    it.color = sprite.Color;
+
+    // sort key: biased layer in the upper 16 bits, texture slot in the lower 16 bits
+    const uint32_t layer = uint32_t(sprite.Layer + (1<<15));
+    this->keys[index] = (layer << 16) | uint32_t(this->textureSlot(sprite.Texture));
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+SpriteBatch::Add(const Id& tex, const SpriteRect& rect, const glm::vec2& pos, const glm::vec2& size, uint32_t color, int layer) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg((layer >= -(1<<15)) && (layer < (1<<15)));
+    if (this->numItems >= this->setup.MaxNumSprites) {
+        return false;
+    }
+    const int index = this->numItems++;
+    item& it = this->items[index];
+    it.x = pos.x;
+    it.y = pos.y;
+    it.rotCos = 1.0f;
+    it.rotSin = 0.0f;
+    it.left = 0.0f;
+    it.top = 0.0f;
+    it.right = size.x;
+    it.bottom = size.y;
+    it.u0 = rect.U0;
+    it.v0 = rect.V0;
+    it.u1 = rect.U1;
+    it.v1 = rect.V1;
+    it.color = color;
+    this->keys[index] = (uint32_t(layer + (1<<15)) << 16) | uint32_t(this->textureSlot(tex));
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+ LSD radix sort of the item indices, 8 bits per pass. The sort is stable,
+ and passes where all keys have the same digit are skipped, so the common
+ case of a single layer only needs one or two passes.
+*/
+void
+SpriteBatch::sortItems() {
+    const int num = this->numItems;
+    const uint32_t* keys = this->keys;
+    int counts[4][256];
+    Memory::Clear(counts, sizeof(counts));
+    for (int i = 0; i < num; i++) {
+        const uint32_t key = keys[i];
+        counts[0][key & 0xFF]++;
+        counts[1][(key >> 8) & 0xFF]++;
+        counts[2][(key >> 16) & 0xFF]++;
+        counts[3][key >> 24]++;
+    }
+    uint32_t* src = this->sorted;
+    uint32_t* dst = this->scratch;
+    for (int i = 0; i < num; i++) {
+        src[i] = i;
+    }
+    for (int pass = 0; pass < 4; pass++) {
+        const int shift = pass * 8;
+        int* count = counts[pass];
+        if (count[(keys[0] >> shift) & 0xFF] == num) {
+            continue;
+        }
+        int offset = 0;
+        for (int d = 0; d < 256; d++) {
+            const int c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (int i = 0; i < num; i++) {
+            const uint32_t index = src[i];
+            dst[count[(keys[index] >> shift) & 0xFF]++] = index;
+        }
+        uint32_t* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    if (src != this->sorted) {
+        Memory::Copy(src, this->sorted, num * sizeof(uint32_t));
+    }
+}
+
+//------------------------------------------------------------------------------
+static inline void
+writeVertex(SpriteBatch::Vertex& vtx, float x, float y, float c, float s, float lx, float ly, float u, float v, uint32_t color) {
+    vtx.x = x + lx * c - ly * s;
+    vtx.y = y + lx * s + ly * c;
+    vtx.u = u;
+    vtx.v = v;
+    vtx.color = color;
+}
+
+//------------------------------------------------------------------------------
+void
+SpriteBatch::writeVertices(int begin, int end) {
+    const item* items = this->items;
+    const uint32_t* sorted = this->sorted;
+    Vertex* vtx = this->vertices;
+
+    int i = begin;
+    #if ORYOL_HAS_SSE2
+    // transpose 4 sprites into SoA registers, compute 4 corners at
+    // once, and transpose back into (x,y,u,v) vertex rows
+    for (; (i + 4) <= end; i += 4) {
+        const item* it0 = items + sorted[i];
+        const item* it1 = items + sorted[i + 1];
+        const item* it2 = items + sorted[i + 2];
+        const item* it3 = items + sorted[i + 3];
+        __m128 x = _mm_loadu_ps(&it0->x), y = _mm_loadu_ps(&it1->x), c = _mm_loadu_ps(&it2->x), s = _mm_loadu_ps(&it3->x);
+        _MM_TRANSPOSE4_PS(x, y, c, s);
+        __m128 l = _mm_loadu_ps(&it0->left), t = _mm_loadu_ps(&it1->left), r = _mm_loadu_ps(&it2->left), b = _mm_loadu_ps(&it3->left);
+        _MM_TRANSPOSE4_PS(l, t, r, b);
+        __m128 u0 = _mm_loadu_ps(&it0->u0), v0 = _mm_loadu_ps(&it1->u0), u1 = _mm_loadu_ps(&it2->u0), v1 = _mm_loadu_ps(&it3->u0);
+        _MM_TRANSPOSE4_PS(u0, v0, u1, v1);
+        // the 4 corners share products: lx*c, lx*s, ly*c, ly*s
+        const __m128 lc = _mm_mul_ps(l, c), ls = _mm_mul_ps(l, s);
+        const __m128 rc = _mm_mul_ps(r, c), rs = _mm_mul_ps(r, s);
+        const __m128 tc = _mm_mul_ps(t, c), ts = _mm_mul_ps(t, s);
+        const __m128 bc = _mm_mul_ps(b, c), bs = _mm_mul_ps(b, s);
+        __m128 px[4], py[4];
+        px[0] = _mm_add_ps(x, _mm_sub_ps(lc, ts)); py[0] = _mm_add_ps(y, _mm_add_ps(ls, tc));
+        px[1] = _mm_add_ps(x, _mm_sub_ps(rc, ts)); py[1] = _mm_add_ps(y, _mm_add_ps(rs, tc));
+        px[2] = _mm_add_ps(x, _mm_sub_ps(rc, bs)); py[2] = _mm_add_ps(y, _mm_add_ps(rs, bc));
+        px[3] = _mm_add_ps(x, _mm_sub_ps(lc, bs)); py[3] = _mm_add_ps(y, _mm_add_ps(ls, bc));
+        const __m128 cu[4] = { u0, u1, u1, u0 };
+        const __m128 cv[4] = { v0, v0, v1, v1 };
+        Vertex* dst = vtx + i * 4;
+        for (int k = 0; k < 4; k++) {
+            __m128 r0 = px[k], r1 = py[k], r2 = cu[k], r3 = cv[k];
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(&dst[k].x, r0);
+            _mm_storeu_ps(&dst[4 + k].x, r1);
+            _mm_storeu_ps(&dst[8 + k].x, r2);
+            _mm_storeu_ps(&dst[12 + k].x, r3);
+        }
+        for (int k = 0; k < 4; k++) {
+            dst[k].color = it0->color;
+            dst[4 + k].color = it1->color;
+            dst[8 + k].color = it2->color;
+            dst[12 + k].color = it3->color;
+        }
+    }
+    #elif ORYOL_HAS_NEON
+    for (; (i + 4) <= end; i += 4) {
+        const item* its[4] = {
+            items + sorted[i], items + sorted[i + 1], items + sorted[i + 2], items + sorted[i + 3]
+        };
+        // transpose 3 rows of 4 sprites
+        float32x4_t soa[3][4];
+        for (int row = 0; row < 3; row++) {
+            const float32x4x2_t t0 = vtrnq_f32(vld1q_f32(&its[0]->x + row * 4), vld1q_f32(&its[1]->x + row * 4));
+            const float32x4x2_t t1 = vtrnq_f32(vld1q_f32(&its[2]->x + row * 4), vld1q_f32(&its[3]->x + row * 4));
+            soa[row][0] = vcombine_f32(vget_low_f32(t0.val[0]), vget_low_f32(t1.val[0]));
+            soa[row][1] = vcombine_f32(vget_low_f32(t0.val[1]), vget_low_f32(t1.val[1]));
+            soa[row][2] = vcombine_f32(vget_high_f32(t0.val[0]), vget_high_f32(t1.val[0]));
+            soa[row][3] = vcombine_f32(vget_high_f32(t0.val[1]), vget_high_f32(t1.val[1]));
+        }
+        const float32x4_t x = soa[0][0], y = soa[0][1], c = soa[0][2], s = soa[0][3];
+        const float32x4_t l = soa[1][0], t = soa[1][1], r = soa[1][2], b = soa[1][3];
+        const float32x4_t cu[4] = { soa[2][0], soa[2][2], soa[2][2], soa[2][0] };
+        const float32x4_t cv[4] = { soa[2][1], soa[2][1], soa[2][3], soa[2][3] };
+        float32x4_t px[4], py[4];
+        px[0] = vmlsq_f32(vmlaq_f32(x, l, c), t, s); py[0] = vmlaq_f32(vmlaq_f32(y, l, s), t, c);
+        px[1] = vmlsq_f32(vmlaq_f32(x, r, c), t, s); py[1] = vmlaq_f32(vmlaq_f32(y, r, s), t, c);
+        px[2] = vmlsq_f32(vmlaq_f32(x, r, c), b, s); py[2] = vmlaq_f32(vmlaq_f32(y, r, s), b, c);
+        px[3] = vmlsq_f32(vmlaq_f32(x, l, c), b, s); py[3] = vmlaq_f32(vmlaq_f32(y, l, s), b, c);
+        Vertex* dst = vtx + i * 4;
+        for (int k = 0; k < 4; k++) {
+            // interleave into (x,y,u,v) rows, one per sprite
+            const float32x4x2_t t0 = vtrnq_f32(px[k], py[k]);
+            const float32x4x2_t t1 = vtrnq_f32(cu[k], cv[k]);
+            vst1q_f32(&dst[k].x, vcombine_f32(vget_low_f32(t0.val[0]), vget_low_f32(t1.val[0])));
+            vst1q_f32(&dst[4 + k].x, vcombine_f32(vget_low_f32(t0.val[1]), vget_low_f32(t1.val[1])));
+            vst1q_f32(&dst[8 + k].x, vcombine_f32(vget_high_f32(t0.val[0]), vget_high_f32(t1.val[0])));
+            vst1q_f32(&dst[12 + k].x, vcombine_f32(vget_high_f32(t0.val[1]), vget_high_f32(t1.val[1])));
+        }
+        for (int j = 0; j < 4; j++) {
+            for (int k = 0; k < 4; k++) {
+                dst[j * 4 + k].color = its[j]->color;
+            }
+        }
+    }
+    #endif
+    // scalar path for the remaining sprites
+    for (; i < end; i++) {
+        const item& it = items[sorted[i]];
+        Vertex* dst = vtx + i * 4;
+        writeVertex(dst[0], it.x, it.y, it.rotCos, it.rotSin, it.left, it.top, it.u0, it.v0, it.color);
+        writeVertex(dst[1], it.x, it.y, it.rotCos, it.rotSin, it.right, it.top, it.u1, it.v0, it.color);
+        writeVertex(dst[2], it.x, it.y, it.rotCos, it.rotSin, it.right, it.bottom, it.u1, it.v1, it.color);
+        writeVertex(dst[3], it.x, it.y, it.rotCos, it.rotSin, it.left, it.bottom, it.u0, it.v1, it.color);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+SpriteBatch::buildBatches() {
+    this->batches.Clear();
+    int curSlot = InvalidIndex;
+    for (int i = 0; i < this->numItems; i++) {
+        const int slot = this->keys[this->sorted[i]] & 0xFFFF;
+        if (slot != curSlot) {
+            Batch batch;
+            batch.Texture = this->textures[slot];
+            batch.FirstSprite = i;
+            this->batches.Add(batch);
+            curSlot = slot;
+        }
+        this->batches.Back().NumSprites++;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+SpriteBatch::End() {
+    o_assert_dbg(this->valid);
+    if (this->numItems > 0) {
+        this->sortItems();
+        this->writeVertices(0, this->numItems);
+        this->buildBatches();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+SpriteBatch::Draw(const glm::mat4& mvp) {
+    o_assert_dbg(this->valid);
+    if (!this->resourcesValid) {
+        this->setupResources();
+    }
+    if (this->batches.Empty()) {
+        return;
+    }
+    Gfx::UpdateVertices(this->drawState.Mesh[0], this->vertices, this->numItems * 4 * sizeof(Vertex));
+    SpriteShader::VSParams vsParams;
+    vsParams.ModelViewProjection = mvp;
+    for (const Batch& batch : this->batches) {
+        this->drawState.FSTexture[SpriteTextures::Texture] = batch.Texture;
+        Gfx::ApplyDrawState(this->drawState);
+        Gfx::ApplyUniformBlock(vsParams);
+        Gfx::Draw(PrimitiveGroup(batch.FirstSprite * 6, batch.NumSprites * 6));
+    }
+}
+
+} // namespace Oryol
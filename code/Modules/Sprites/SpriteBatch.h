@@ -0,0 +1,205 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @defgroup Sprites Sprites
+    @brief batched 2D sprite rendering
+
+    @class Oryol::SpriteBatch
+    @ingroup Sprites
+    @brief accumulate sprite quads and render them with few draw calls
+
+    Sprites are added between Begin() and End() with a texture, a
+    UV rectangle (see SpriteRect), a position, size, pivot, rotation,
+    color and layer. End() sorts the sprites by layer, and inside a
+    layer by texture (the sort is stable, so sprites with the same layer
+    and texture keep their submission order), and generates the quad
+    vertices in sorted order, 4 sprites at a time with SSE2 or NEON.
+    Draw() uploads all vertices into a streaming vertex buffer and
+    issues one draw call per run of sprites with the same texture.
+    If all sprites are in the same layer, this is one draw call per
+    texture (e.g. per sprite sheet or TextureAtlas page).
+
+    The vertex positions are transformed by the model-view-projection
+    matrix passed to Draw(), e.g. an orthographic pixel-space projection.
+
+    Gfx resources are created lazily on the first Draw().
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "Resource/Id.h"
+#include "Resource/ResourceLabel.h"
+#include "Gfx/Core/VertexLayout.h"
+#include "Gfx/Core/DrawState.h"
+#include "Sprites/SpriteBatchSetup.h"
+#include "glm/vec2.hpp"
+#include "glm/mat4x4.hpp"
+
+namespace Oryol {
+
+/// normalized texture coordinate rectangle of a sprite
+struct SpriteRect {
+    float U0 = 0.0f, V0 = 0.0f, U1 = 1.0f, V1 = 1.0f;
+
+    /// default constructor (full texture)
+    SpriteRect() { };
+    /// construct from normalized texture coordinates
+    SpriteRect(float u0, float v0, float u1, float v1) : U0(u0), V0(v0), U1(u1), V1(v1) { };
+    /// construct from pixel rectangle and texture size
+    static SpriteRect FromPixels(int x, int y, int w, int h, int texWidth, int texHeight) {
+        const float dx = 1.0f / float(texWidth);
+        const float dy = 1.0f / float(texHeight);
+        return SpriteRect(x * dx, y * dy, (x + w) * dx, (y + h) * dy);
+    };
+    /// construct from SpriteSheet generator output, animation frames are laid out horizontally
+    template<class SHEET> static SpriteRect FromSheet(typename SHEET::SpriteId id, int frame=0) {
+        const auto& spr = SHEET::Sprite[id];
+        return FromPixels(spr.X + frame * spr.W, spr.Y, spr.W, spr.H, SHEET::Width, SHEET::Height);
+    };
+};
+
+/// a sprite added to a SpriteBatch
+struct Sprite {
+    /// the texture to sample from
+    Id Texture;
+    /// texture coordinate rectangle
+    SpriteRect Rect;
+    /// position of the pivot point
+    glm::vec2 Position = glm::vec2(0.0f);
+    /// width and height
+    glm::vec2 Size = glm::vec2(1.0f);
+    /// normalized pivot point (0,0 is top-left, 1,1 is bottom-right)
+    glm::vec2 Pivot = glm::vec2(0.5f);
+    /// rotation around pivot in radians
+    float Rotation = 0.0f;
+    /// RGBA8 tint color, red is in the lowest byte
+    uint32_t Color = 0xFFFFFFFF;
+    /// sort layer, lower layers are drawn first
+    int Layer = 0;
+};
+
+class SpriteBatch {
+public:
+    /// constructor
+    SpriteBatch();
+    /// destructor
+    ~SpriteBatch();
+
+    /// setup the sprite batch
+    void Setup(const SpriteBatchSetup& setup);
+    /// discard the sprite batch (also destroys Gfx resources)
+    void Discard();
+    /// return true if the sprite batch has been setup
+    bool IsValid() const;
+
+    /// begin a new frame, removes all sprites
+    void Begin();
+    /// add a sprite, returns false if the batch is full
+    bool Add(const Sprite& sprite);
+    /// add an axis-aligned sprite with top-left pivot, returns false if the batch is full
+    bool Add(const Id& tex, const SpriteRect& rect, const glm::vec2& pos, const glm::vec2& size, uint32_t color=0xFFFFFFFF, int layer=0);
+    /// sort the sprites and generate vertices
+    void End();
+    /// upload the vertices and render the batches (call between End() and the next Begin())
+    void Draw(const glm::mat4& mvp);
+
+    /// number of sprites in current frame
+    int NumSprites() const;
+    /// max number of sprites per frame
+    int MaxNumSprites() const;
+
+    /// a run of sprites with the same texture, rendered with one draw call
+    struct Batch {
+        Id Texture;
+        int FirstSprite = 0;
+        int NumSprites = 0;
+    };
+    /// number of batches generated by End()
+    int NumBatches() const;
+    /// get batch generated by End()
+    const Batch& BatchAt(int index) const;
+
+    /// a generated sprite vertex
+    struct Vertex {
+        float x, y, u, v;
+        uint32_t color;
+    };
+    /// get vertices generated by End(), 4 per sprite in sorted order
+    const Vertex* Vertices() const;
+    /// the vertex layout matching the Vertex struct
+    static VertexLayout Layout();
+
+private:
+    /// a sprite as stored until End(), 3 SIMD-friendly rows of 4 floats
+    struct item {
+        float x, y, rotCos, rotSin;     // pivot position and rotation
+        float left, top, right, bottom; // corners relative to pivot
+        float u0, v0, u1, v1;           // texture coordinates
+        uint32_t color;
+        uint32_t pad[3];
+    };
+    /// get texture slot index for texture id
+    int textureSlot(const Id& tex);
+    /// sort item indices by key (stable)
+    void sortItems();
+    /// write 4 vertices per sprite for a range of sorted sprites
+    void writeVertices(int begin, int end);
+    /// build the batches from the sorted sprites
+    void buildBatches();
+    /// create the Gfx resources
+    void setupResources();
+
+    bool valid = false;
+    bool resourcesValid = false;
+    SpriteBatchSetup setup;
+    ResourceLabel resourceLabel;
+    DrawState drawState;
+
+    int numItems = 0;
+    item* items = nullptr;
+    uint32_t* keys = nullptr;
+    uint32_t* sorted = nullptr;
+    uint32_t* scratch = nullptr;
+    Vertex* vertices = nullptr;
+    Array<Id> textures;
+    Id lastTexture;
+    int lastSlot = InvalidIndex;
+    Array<Batch> batches;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+SpriteBatch::IsValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+inline int
+SpriteBatch::NumSprites() const {
+    return this->numItems;
+}
+
+//------------------------------------------------------------------------------
+inline int
+SpriteBatch::MaxNumSprites() const {
+    return this->setup.MaxNumSprites;
+}
+
+//------------------------------------------------------------------------------
+inline int
+SpriteBatch::NumBatches() const {
+    return this->batches.Size();
+}
+
+//------------------------------------------------------------------------------
+inline const SpriteBatch::Batch&
+SpriteBatch::BatchAt(int index) const {
+    return this->batches[index];
+}
+
+//------------------------------------------------------------------------------
+inline const SpriteBatch::Vertex*
+SpriteBatch::Vertices() const {
+    return this->vertices;
+}
+
+} // namespace Oryol
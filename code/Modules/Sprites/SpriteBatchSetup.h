@@ -0,0 +1,27 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::SpriteBatchSetup
+    @ingroup Sprites
+    @brief setup parameters for a SpriteBatch
+*/
+#include "Core/Types.h"
+#include "Gfx/Core/Enums.h"
+
+namespace Oryol {
+
+class SpriteBatchSetup {
+public:
+    /// max number of sprites per frame
+    int MaxNumSprites = 128 * 1024;
+    /// true if textures and sprite colors have premultiplied alpha
+    bool PremultipliedAlpha = false;
+    /// render target color format (InvalidPixelFormat: default render target)
+    PixelFormat::Code ColorFormat = PixelFormat::InvalidPixelFormat;
+    /// render target depth format (InvalidPixelFormat: default render target)
+    PixelFormat::Code DepthFormat = PixelFormat::InvalidPixelFormat;
+    /// render target MSAA sample count (0: default render target)
+    int SampleCount = 0;
+};
+
+} // namespace Oryol
@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------------
+//  SpriteBatchTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Sprites/SpriteBatch.h"
+#include <cmath>
+
+using namespace Oryol;
+
+static bool
+equal(float a, float b) {
+    return std::fabs(a - b) < 0.0001f;
+}
+
+static bool
+checkVertex(const SpriteBatch::Vertex& vtx, float x, float y, float u, float v, uint32_t color) {
+    return equal(vtx.x, x) && equal(vtx.y, y) && equal(vtx.u, u) && equal(vtx.v, v) && (vtx.color == color);
+}
+
+TEST(SpriteBatchTest) {
+    SpriteBatchSetup setup;
+    setup.MaxNumSprites = 16;
+    SpriteBatch batch;
+    batch.Setup(setup);
+    CHECK(batch.IsValid());
+    CHECK(batch.MaxNumSprites() == 16);
+    CHECK(batch.Layout().ByteSize() == sizeof(SpriteBatch::Vertex));
+
+    const Id texA(1, 0, 0);
+    const Id texB(2, 1, 0);
+    const SpriteRect rect = SpriteRect::FromPixels(16, 8, 16, 16, 64, 32);
+    CHECK(equal(rect.U0, 0.25f) && equal(rect.V0, 0.25f) && equal(rect.U1, 0.5f) && equal(rect.V1, 0.75f));
+
+    // sprites 0..7 alternate textures in layer 0, sprite 8 is rotated in layer -1,
+    // so the 4-wide SIMD path and the scalar tail are both used
+    batch.Begin();
+    for (int i = 0; i < 8; i++) {
+        const Id& tex = (i & 1) ? texB : texA;
+        CHECK(batch.Add(tex, rect, glm::vec2(float(i * 10), 5.0f), glm::vec2(4.0f, 2.0f), 0xFF000000 | i));
+    }
+    Sprite spr;
+    spr.Texture = texB;
+    spr.Position = glm::vec2(100.0f, 50.0f);
+    spr.Size = glm::vec2(4.0f, 2.0f);
+    spr.Rotation = 3.14159265f * 0.5f;
+    spr.Color = 0xFFFFFFFF;
+    spr.Layer = -1;
+    CHECK(batch.Add(spr));
+    CHECK(batch.NumSprites() == 9);
+    batch.End();
+
+    // layer -1 first, then texture A, then texture B, submission order is kept
+    CHECK(batch.NumBatches() == 3);
+    CHECK(batch.BatchAt(0).Texture == texB);
+    CHECK((batch.BatchAt(0).FirstSprite == 0) && (batch.BatchAt(0).NumSprites == 1));
+    CHECK(batch.BatchAt(1).Texture == texA);
+    CHECK((batch.BatchAt(1).FirstSprite == 1) && (batch.BatchAt(1).NumSprites == 4));
+    CHECK(batch.BatchAt(2).Texture == texB);
+    CHECK((batch.BatchAt(2).FirstSprite == 5) && (batch.BatchAt(2).NumSprites == 4));
+
+    // the rotated sprite rotates around its center pivot
+    const SpriteBatch::Vertex* vtx = batch.Vertices();
+    CHECK(checkVertex(vtx[0], 101.0f, 48.0f, 0.0f, 0.0f, 0xFFFFFFFF));
+    CHECK(checkVertex(vtx[1], 101.0f, 52.0f, 1.0f, 0.0f, 0xFFFFFFFF));
+    CHECK(checkVertex(vtx[2], 99.0f, 52.0f, 1.0f, 1.0f, 0xFFFFFFFF));
+    CHECK(checkVertex(vtx[3], 99.0f, 48.0f, 0.0f, 1.0f, 0xFFFFFFFF));
+
+    // the axis-aligned sprites have their top-left corner at the position
+    const int order[8] = { 0, 2, 4, 6, 1, 3, 5, 7 };
+    for (int i = 0; i < 8; i++) {
+        const SpriteBatch::Vertex* v = vtx + (i + 1) * 4;
+        const float x = float(order[i] * 10);
+        const uint32_t color = 0xFF000000 | order[i];
+        CHECK(checkVertex(v[0], x, 5.0f, 0.25f, 0.25f, color));
+        CHECK(checkVertex(v[1], x + 4.0f, 5.0f, 0.5f, 0.25f, color));
+        CHECK(checkVertex(v[2], x + 4.0f, 7.0f, 0.5f, 0.75f, color));
+        CHECK(checkVertex(v[3], x, 7.0f, 0.25f, 0.75f, color));
+    }
+
+    // the batch is full after MaxNumSprites
+    batch.Begin();
+    CHECK(batch.NumSprites() == 0);
+    CHECK(batch.NumBatches() == 0);
+    for (int i = 0; i < 16; i++) {
+        CHECK(batch.Add(texA, SpriteRect(), glm::vec2(0.0f), glm::vec2(1.0f), 0xFFFFFFFF, 16 - i));
+    }
+    CHECK(!batch.Add(texA, SpriteRect(), glm::vec2(0.0f), glm::vec2(1.0f)));
+    batch.End();
+    CHECK(batch.NumBatches() == 1);
+    CHECK(batch.BatchAt(0).NumSprites == 16);
+
+    batch.Discard();
+    CHECK(!batch.IsValid());
+}
@@ -0,0 +1,422 @@
+//------------------------------------------------------------------------------
+//  BlockEncoder.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "BlockEncoder.h"
+#include "Core/Assertion.h"
+#include <cstring>
+#if ORYOL_HAS_SSE2
+#include <emmintrin.h>
+#elif ORYOL_HAS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+static uint16_t
+to565(const int* c) {
+    return uint16_t((((c[0] * 31 + 127) / 255) << 11) | (((c[1] * 63 + 127) / 255) << 5) | ((c[2] * 31 + 127) / 255));
+}
+
+//------------------------------------------------------------------------------
+static void
+from565(uint16_t c, int* out) {
+    const int r = (c >> 11) & 31;
+    const int g = (c >> 5) & 63;
+    const int b = c & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+//------------------------------------------------------------------------------
+bool
+BlockEncoder::IsSupported(PixelFormat::Code fmt) {
+    switch (fmt) {
+        case PixelFormat::RGBA8:
+        case PixelFormat::DXT1:
+        case PixelFormat::DXT5:
+        case PixelFormat::ETC2_RGB8:
+        case PixelFormat::ETC2_SRGB8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+int
+BlockEncoder::EncodedSize(PixelFormat::Code fmt, int width, int height) {
+    o_assert_dbg(IsSupported(fmt));
+    const int numBlocks = ((width + 3) / 4) * ((height + 3) / 4);
+    switch (fmt) {
+        case PixelFormat::RGBA8:    return width * height * 4;
+        case PixelFormat::DXT5:     return numBlocks * 16;
+        default:                    return numBlocks * 8;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+BlockEncoder::fetchBlock(const uint8_t* rgba, int width, int height, int x, int y, uint8_t* block) {
+    for (int by = 0; by < 4; by++) {
+        const int sy = (y + by) < height ? (y + by) : (height - 1);
+        for (int bx = 0; bx < 4; bx++) {
+            const int sx = (x + bx) < width ? (x + bx) : (width - 1);
+            std::memcpy(block + (by * 4 + bx) * 4, rgba + (sy * width + sx) * 4, 4);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+BlockEncoder::Encode(PixelFormat::Code fmt, const uint8_t* rgba, int width, int height, uint8_t* out) {
+    o_assert_dbg(rgba && out && (width > 0) && (height > 0));
+    if (PixelFormat::RGBA8 == fmt) {
+        std::memcpy(out, rgba, width * height * 4);
+        return;
+    }
+    uint8_t block[64];
+    for (int y = 0; y < height; y += 4) {
+        for (int x = 0; x < width; x += 4) {
+            fetchBlock(rgba, width, height, x, y, block);
+            switch (fmt) {
+                case PixelFormat::DXT1:
+                    EncodeBC1(block, out);
+                    out += 8;
+                    break;
+                case PixelFormat::DXT5:
+                    EncodeBC3(block, out);
+                    out += 16;
+                    break;
+                case PixelFormat::ETC2_RGB8:
+                case PixelFormat::ETC2_SRGB8:
+                    EncodeETC2(block, out);
+                    out += 8;
+                    break;
+                default:
+                    o_error("BlockEncoder::Encode(): unsupported format!\n");
+                    break;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+BlockEncoder::encodeColor(const uint8_t* block, uint8_t* out) {
+
+    // color bounds of the block
+    uint8_t lo[4], hi[4];
+    #if ORYOL_HAS_SSE2
+    const __m128i p0 = _mm_loadu_si128((const __m128i*)(block + 0));
+    const __m128i p1 = _mm_loadu_si128((const __m128i*)(block + 16));
+    const __m128i p2 = _mm_loadu_si128((const __m128i*)(block + 32));
+    const __m128i p3 = _mm_loadu_si128((const __m128i*)(block + 48));
+    __m128i mn = _mm_min_epu8(_mm_min_epu8(p0, p1), _mm_min_epu8(p2, p3));
+    __m128i mx = _mm_max_epu8(_mm_max_epu8(p0, p1), _mm_max_epu8(p2, p3));
+    mn = _mm_min_epu8(mn, _mm_shuffle_epi32(mn, _MM_SHUFFLE(1, 0, 3, 2)));
+    mn = _mm_min_epu8(mn, _mm_shuffle_epi32(mn, _MM_SHUFFLE(2, 3, 0, 1)));
+    mx = _mm_max_epu8(mx, _mm_shuffle_epi32(mx, _MM_SHUFFLE(1, 0, 3, 2)));
+    mx = _mm_max_epu8(mx, _mm_shuffle_epi32(mx, _MM_SHUFFLE(2, 3, 0, 1)));
+    const int mn32 = _mm_cvtsi128_si32(mn);
+    const int mx32 = _mm_cvtsi128_si32(mx);
+    std::memcpy(lo, &mn32, 4);
+    std::memcpy(hi, &mx32, 4);
+    #elif ORYOL_HAS_NEON
+    const uint8x16_t p0 = vld1q_u8(block + 0);
+    const uint8x16_t p1 = vld1q_u8(block + 16);
+    const uint8x16_t p2 = vld1q_u8(block + 32);
+    const uint8x16_t p3 = vld1q_u8(block + 48);
+    const uint8x16_t mn = vminq_u8(vminq_u8(p0, p1), vminq_u8(p2, p3));
+    const uint8x16_t mx = vmaxq_u8(vmaxq_u8(p0, p1), vmaxq_u8(p2, p3));
+    uint8x8_t mn8 = vmin_u8(vget_low_u8(mn), vget_high_u8(mn));
+    uint8x8_t mx8 = vmax_u8(vget_low_u8(mx), vget_high_u8(mx));
+    mn8 = vmin_u8(mn8, vext_u8(mn8, mn8, 4));
+    mx8 = vmax_u8(mx8, vext_u8(mx8, mx8, 4));
+    uint8_t mnBytes[8], mxBytes[8];
+    vst1_u8(mnBytes, mn8);
+    vst1_u8(mxBytes, mx8);
+    std::memcpy(lo, mnBytes, 4);
+    std::memcpy(hi, mxBytes, 4);
+    #else
+    for (int c = 0; c < 4; c++) {
+        lo[c] = 255;
+        hi[c] = 0;
+    }
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 4; c++) {
+            const uint8_t v = block[i * 4 + c];
+            lo[c] = v < lo[c] ? v : lo[c];
+            hi[c] = v > hi[c] ? v : hi[c];
+        }
+    }
+    #endif
+
+    // pick the bounding box diagonal which follows the colors: flip
+    // red or blue if they are anti-correlated with green
+    int e0[3], e1[3];
+    for (int c = 0; c < 3; c++) {
+        e0[c] = hi[c];
+        e1[c] = lo[c];
+    }
+    const int center[3] = { (lo[0] + hi[0]) >> 1, (lo[1] + hi[1]) >> 1, (lo[2] + hi[2]) >> 1 };
+    int covRG = 0, covBG = 0;
+    for (int i = 0; i < 16; i++) {
+        const int g = block[i * 4 + 1] - center[1];
+        covRG += (block[i * 4 + 0] - center[0]) * g;
+        covBG += (block[i * 4 + 2] - center[2]) * g;
+    }
+    if (covRG < 0) {
+        e0[0] = lo[0];
+        e1[0] = hi[0];
+    }
+    if (covBG < 0) {
+        e0[2] = lo[2];
+        e1[2] = hi[2];
+    }
+    // inset the endpoints by 1/16 of the range to reduce the error at the extremes
+    for (int c = 0; c < 3; c++) {
+        const int inset = (e0[c] - e1[c]) / 16;
+        e0[c] -= inset;
+        e1[c] += inset;
+    }
+
+    uint16_t c0 = to565(e0);
+    uint16_t c1 = to565(e1);
+    if (c0 < c1) {
+        const uint16_t tmp = c0;
+        c0 = c1;
+        c1 = tmp;
+    }
+    out[0] = uint8_t(c0); out[1] = uint8_t(c0 >> 8);
+    out[2] = uint8_t(c1); out[3] = uint8_t(c1 >> 8);
+    if (c0 == c1) {
+        // single color block, all pixels use color 0
+        out[4] = out[5] = out[6] = out[7] = 0;
+        return;
+    }
+
+    // project the pixels onto the endpoint axis
+    from565(c0, e0);
+    from565(c1, e1);
+    const int dir[3] = { e0[0] - e1[0], e0[1] - e1[1], e0[2] - e1[2] };
+    int dots[16];
+    #if ORYOL_HAS_SSE2
+    const __m128i dir16 = _mm_setr_epi16(short(dir[0]), short(dir[1]), short(dir[2]), 0, short(dir[0]), short(dir[1]), short(dir[2]), 0);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i pixels[4] = { p0, p1, p2, p3 };
+    for (int i = 0; i < 4; i++) {
+        // (r*dr + g*dg, b*db + a*0) for 2 pixels each, then add the pairs
+        const __m128i a = _mm_madd_epi16(_mm_unpacklo_epi8(pixels[i], zero), dir16);
+        const __m128i b = _mm_madd_epi16(_mm_unpackhi_epi8(pixels[i], zero), dir16);
+        const __m128i sa = _mm_add_epi32(_mm_shuffle_epi32(a, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 1, 3, 1)));
+        const __m128i sb = _mm_add_epi32(_mm_shuffle_epi32(b, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_epi32(b, _MM_SHUFFLE(3, 1, 3, 1)));
+        _mm_storeu_si128((__m128i*)(dots + i * 4), _mm_unpacklo_epi64(sa, sb));
+    }
+    #elif ORYOL_HAS_NEON
+    const int16_t dirData[4] = { int16_t(dir[0]), int16_t(dir[1]), int16_t(dir[2]), 0 };
+    const int16x4_t dir4 = vld1_s16(dirData);
+    for (int i = 0; i < 16; i += 2) {
+        const int16x8_t pix = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(block + i * 4)));
+        const int32x4_t ma = vmull_s16(vget_low_s16(pix), dir4);
+        const int32x4_t mb = vmull_s16(vget_high_s16(pix), dir4);
+        const int32x2_t sa = vpadd_s32(vget_low_s32(ma), vget_high_s32(ma));
+        const int32x2_t sb = vpadd_s32(vget_low_s32(mb), vget_high_s32(mb));
+        vst1_s32(dots + i, vpadd_s32(sa, sb));
+    }
+    #else
+    for (int i = 0; i < 16; i++) {
+        dots[i] = block[i * 4 + 0] * dir[0] + block[i * 4 + 1] * dir[1] + block[i * 4 + 2] * dir[2];
+    }
+    #endif
+
+    // quantize the projections to the 4 palette entries: t=0 is c1, t=3 is c0
+    static const uint32_t indexMap[4] = { 1, 3, 2, 0 };
+    const int d0 = e0[0] * dir[0] + e0[1] * dir[1] + e0[2] * dir[2];
+    const int d1 = e1[0] * dir[0] + e1[1] * dir[1] + e1[2] * dir[2];
+    const int denom = d0 - d1;
+    uint32_t indices = 0;
+    for (int i = 0; i < 16; i++) {
+        int t;
+        if (dots[i] <= d1) {
+            t = 0;
+        }
+        else if (dots[i] >= d0) {
+            t = 3;
+        }
+        else {
+            t = ((dots[i] - d1) * 3 + (denom >> 1)) / denom;
+        }
+        indices |= indexMap[t] << (i * 2);
+    }
+    out[4] = uint8_t(indices);
+    out[5] = uint8_t(indices >> 8);
+    out[6] = uint8_t(indices >> 16);
+    out[7] = uint8_t(indices >> 24);
+}
+
+//------------------------------------------------------------------------------
+void
+BlockEncoder::encodeAlpha(const uint8_t* block, uint8_t* out) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; i++) {
+        const int a = block[i * 4 + 3];
+        a0 = a > a0 ? a : a0;
+        a1 = a < a1 ? a : a1;
+    }
+    out[0] = uint8_t(a0);
+    out[1] = uint8_t(a1);
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        // 8-alpha mode, t=0 is a1, t=7 is a0, interpolated values in between
+        const int range = a0 - a1;
+        for (int i = 0; i < 16; i++) {
+            const int t = ((block[i * 4 + 3] - a1) * 7 + (range >> 1)) / range;
+            const uint64_t index = (7 == t) ? 0 : ((0 == t) ? 1 : (8 - t));
+            indices |= index << (i * 3);
+        }
+    }
+    for (int i = 0; i < 6; i++) {
+        out[2 + i] = uint8_t(indices >> (i * 8));
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+BlockEncoder::EncodeBC1(const uint8_t* block, uint8_t* out) {
+    o_assert_dbg(block && out);
+    encodeColor(block, out);
+}
+
+//------------------------------------------------------------------------------
+void
+BlockEncoder::EncodeBC3(const uint8_t* block, uint8_t* out) {
+    o_assert_dbg(block && out);
+    encodeAlpha(block, out);
+    encodeColor(block, out + 8);
+}
+
+//------------------------------------------------------------------------------
+static const int etcModifiers[8][2] = {
+    { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 }
+};
+
+//------------------------------------------------------------------------------
+int
+BlockEncoder::etcSubBlock(const uint8_t* block, bool flip, int subBlock, const int* base, int& outTable, uint32_t& outIndices) {
+    int bestError = 0x7FFFFFFF;
+    for (int table = 0; table < 8; table++) {
+        // pixel index values: 0: +a, 1: +b, 2: -a, 3: -b
+        const int mods[4] = {
+            etcModifiers[table][0], etcModifiers[table][1], -etcModifiers[table][0], -etcModifiers[table][1]
+        };
+        int error = 0;
+        uint32_t indices = 0;
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                if ((flip ? (y >> 1) : (x >> 1)) != subBlock) {
+                    continue;
+                }
+                const uint8_t* p = block + (y * 4 + x) * 4;
+                int bestPixelError = 0x7FFFFFFF;
+                uint32_t bestIndex = 0;
+                for (uint32_t index = 0; index < 4; index++) {
+                    int pixelError = 0;
+                    for (int c = 0; c < 3; c++) {
+                        int v = base[c] + mods[index];
+                        v = v < 0 ? 0 : (v > 255 ? 255 : v);
+                        pixelError += (v - p[c]) * (v - p[c]);
+                    }
+                    if (pixelError < bestPixelError) {
+                        bestPixelError = pixelError;
+                        bestIndex = index;
+                    }
+                }
+                error += bestPixelError;
+                // the pixels are stored column-major, msb in the upper 16 bits
+                const int bit = x * 4 + y;
+                indices |= ((bestIndex >> 1) << (16 + bit)) | ((bestIndex & 1) << bit);
+            }
+        }
+        if (error < bestError) {
+            bestError = error;
+            outTable = table;
+            outIndices = indices;
+        }
+    }
+    return bestError;
+}
+
+//------------------------------------------------------------------------------
+void
+BlockEncoder::EncodeETC2(const uint8_t* block, uint8_t* out) {
+    o_assert_dbg(block && out);
+    int bestError = 0x7FFFFFFF;
+    uint32_t bestHi = 0, bestLo = 0;
+    for (int flip = 0; flip < 2; flip++) {
+        // average color of the 2 sub-blocks
+        int avg[2][3] = { { 0, 0, 0 }, { 0, 0, 0 } };
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                const int sub = flip ? (y >> 1) : (x >> 1);
+                for (int c = 0; c < 3; c++) {
+                    avg[sub][c] += block[(y * 4 + x) * 4 + c];
+                }
+            }
+        }
+        int q[2][3];
+        bool differential = true;
+        for (int c = 0; c < 3; c++) {
+            avg[0][c] = (avg[0][c] + 4) >> 3;
+            avg[1][c] = (avg[1][c] + 4) >> 3;
+            q[0][c] = (avg[0][c] * 31 + 127) / 255;
+            q[1][c] = (avg[1][c] * 31 + 127) / 255;
+            const int d = q[1][c] - q[0][c];
+            differential &= (d >= -4) && (d <= 3);
+        }
+        // differential mode has 5 bits per base color, individual mode 4 bits
+        int base[2][3];
+        for (int c = 0; c < 3; c++) {
+            if (differential) {
+                base[0][c] = (q[0][c] << 3) | (q[0][c] >> 2);
+                base[1][c] = (q[1][c] << 3) | (q[1][c] >> 2);
+            }
+            else {
+                q[0][c] = (avg[0][c] * 15 + 127) / 255;
+                q[1][c] = (avg[1][c] * 15 + 127) / 255;
+                base[0][c] = (q[0][c] << 4) | q[0][c];
+                base[1][c] = (q[1][c] << 4) | q[1][c];
+            }
+        }
+        int table0 = 0, table1 = 0;
+        uint32_t indices0 = 0, indices1 = 0;
+        const int error = etcSubBlock(block, 0 != flip, 0, base[0], table0, indices0) +
+                          etcSubBlock(block, 0 != flip, 1, base[1], table1, indices1);
+        if (error < bestError) {
+            bestError = error;
+            if (differential) {
+                // NOTE: base + delta is always in range, so this is never
+                // interpreted as one of the additional ETC2 modes
+                bestHi = (uint32_t(q[0][0]) << 27) | (uint32_t((q[1][0] - q[0][0]) & 7) << 24) |
+                         (uint32_t(q[0][1]) << 19) | (uint32_t((q[1][1] - q[0][1]) & 7) << 16) |
+                         (uint32_t(q[0][2]) << 11) | (uint32_t((q[1][2] - q[0][2]) & 7) << 8) | 2;
+            }
+            else {
+                bestHi = (uint32_t(q[0][0]) << 28) | (uint32_t(q[1][0]) << 24) |
+                         (uint32_t(q[0][1]) << 20) | (uint32_t(q[1][1]) << 16) |
+                         (uint32_t(q[0][2]) << 12) | (uint32_t(q[1][2]) << 8);
+            }
+            bestHi |= (uint32_t(table0) << 5) | (uint32_t(table1) << 2) | uint32_t(flip);
+            bestLo = indices0 | indices1;
+        }
+    }
+    // ETC blocks are big-endian
+    for (int i = 0; i < 4; i++) {
+        out[i] = uint8_t(bestHi >> (24 - i * 8));
+        out[4 + i] = uint8_t(bestLo >> (24 - i * 8));
+    }
+}
+
+} // namespace Oryol
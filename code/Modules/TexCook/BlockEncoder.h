@@ -0,0 +1,53 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::BlockEncoder
+    @ingroup TexCook
+    @brief encode RGBA8 pixels into block-compressed texture formats
+
+    Supported formats are PixelFormat::DXT1 (BC1, opaque), DXT5 (BC3),
+    ETC2_RGB8 / ETC2_SRGB8 (ETC2 RGB, encoded with the ETC1-compatible
+    individual and differential modes), and RGBA8 (plain copy).
+
+    The DXT color endpoints are a range fit along the inset bounding
+    box diagonal of the block, the color bounds and the projection of
+    the 16 pixels onto the endpoint axis use SSE2 or NEON (with a
+    scalar fallback). The ETC2 encoder tries both block flips and all
+    8 modifier tables for each sub-block and keeps the best result.
+
+    Images which aren't a multiple of 4 pixels are padded by repeating
+    the last row and column.
+*/
+#include "Core/Types.h"
+#include "Gfx/Core/Enums.h"
+
+namespace Oryol {
+
+class BlockEncoder {
+public:
+    /// return true if the format can be encoded
+    static bool IsSupported(PixelFormat::Code fmt);
+    /// get the encoded byte size of an image
+    static int EncodedSize(PixelFormat::Code fmt, int width, int height);
+    /// encode an RGBA8 image, out must be EncodedSize() bytes
+    static void Encode(PixelFormat::Code fmt, const uint8_t* rgba, int width, int height, uint8_t* out);
+
+    /// encode a 4x4 block of RGBA8 pixels into an 8-byte BC1 block
+    static void EncodeBC1(const uint8_t* block, uint8_t* out);
+    /// encode a 4x4 block of RGBA8 pixels into a 16-byte BC3 block
+    static void EncodeBC3(const uint8_t* block, uint8_t* out);
+    /// encode a 4x4 block of RGBA8 pixels into an 8-byte ETC2 RGB block
+    static void EncodeETC2(const uint8_t* block, uint8_t* out);
+
+private:
+    /// encode the BC1 color part of a block
+    static void encodeColor(const uint8_t* block, uint8_t* out);
+    /// encode the BC3 alpha part of a block
+    static void encodeAlpha(const uint8_t* block, uint8_t* out);
+    /// encode one ETC sub-block with a base color, return squared error
+    static int etcSubBlock(const uint8_t* block, bool flip, int subBlock, const int* base, int& outTable, uint32_t& outIndices);
+    /// fetch a 4x4 block of pixels with edge clamping
+    static void fetchBlock(const uint8_t* rgba, int width, int height, int x, int y, uint8_t* block);
+};
+
+} // namespace Oryol
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+//  MipChain.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "MipChain.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include <cmath>
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+static float
+srgbToLinear(uint8_t c) {
+    const float f = c / 255.0f;
+    return f <= 0.04045f ? f / 12.92f : std::pow((f + 0.055f) / 1.055f, 2.4f);
+}
+
+//------------------------------------------------------------------------------
+static uint8_t
+linearToSrgb(float f) {
+    f = f <= 0.0031308f ? f * 12.92f : 1.055f * std::pow(f, 1.0f / 2.4f) - 0.055f;
+    const int c = int(f * 255.0f + 0.5f);
+    return uint8_t(c < 0 ? 0 : (c > 255 ? 255 : c));
+}
+
+//------------------------------------------------------------------------------
+void
+MipChain::Setup(const uint8_t* rgba, int width, int height, bool mipmaps, bool srgb) {
+    o_assert(rgba && (width > 0) && (height > 0));
+
+    // compute the level sizes, and allocate all levels at once
+    this->numMips = 0;
+    int size = 0;
+    int w = width, h = height;
+    for (;;) {
+        o_assert(this->numMips < MaxNumMips);
+        this->widths[this->numMips] = w;
+        this->heights[this->numMips] = h;
+        this->offsets[this->numMips] = size;
+        this->numMips++;
+        size += w * h * 4;
+        if (!mipmaps || ((1 == w) && (1 == h))) {
+            break;
+        }
+        w = w > 1 ? w >> 1 : 1;
+        h = h > 1 ? h >> 1 : 1;
+    }
+    this->data.Clear();
+    this->data.Reserve(size);
+    uint8_t* dst = this->data.Add(size);
+    Memory::Copy(rgba, dst, width * height * 4);
+    for (int mip = 1; mip < this->numMips; mip++) {
+        downsample(dst + this->offsets[mip - 1], this->widths[mip - 1], this->heights[mip - 1],
+            dst + this->offsets[mip], this->widths[mip], this->heights[mip], srgb);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+MipChain::downsample(const uint8_t* src, int srcWidth, int srcHeight, uint8_t* dst, int dstWidth, int dstHeight, bool srgb) {
+    // a 1-pixel wide or high source level is only filtered in one direction
+    const int dx = srcWidth > 1 ? 4 : 0;
+    const int dy = srcHeight > 1 ? srcWidth * 4 : 0;
+    float toLinear[256];
+    if (srgb) {
+        for (int i = 0; i < 256; i++) {
+            toLinear[i] = srgbToLinear(uint8_t(i));
+        }
+    }
+    for (int y = 0; y < dstHeight; y++) {
+        for (int x = 0; x < dstWidth; x++) {
+            const uint8_t* p = src + ((y * 2) * srcWidth + (x * 2)) * 4;
+            const uint8_t* p00 = p;
+            const uint8_t* p01 = p + dx;
+            const uint8_t* p10 = p + dy;
+            const uint8_t* p11 = p + dy + dx;
+            uint8_t* d = dst + (y * dstWidth + x) * 4;
+            for (int c = 0; c < 3; c++) {
+                if (srgb) {
+                    d[c] = linearToSrgb((toLinear[p00[c]] + toLinear[p01[c]] + toLinear[p10[c]] + toLinear[p11[c]]) * 0.25f);
+                }
+                else {
+                    d[c] = uint8_t((p00[c] + p01[c] + p10[c] + p11[c] + 2) >> 2);
+                }
+            }
+            d[3] = uint8_t((p00[3] + p01[3] + p10[3] + p11[3] + 2) >> 2);
+        }
+    }
+}
+
+} // namespace Oryol
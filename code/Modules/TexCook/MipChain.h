@@ -0,0 +1,73 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::MipChain
+    @ingroup TexCook
+    @brief an RGBA8 image with its generated mipmap levels
+
+    The mipmaps are generated with a 2x2 box filter down to 1x1,
+    odd sizes are rounded down (the last row or column of the
+    parent level is dropped). With sRGB enabled, the color channels
+    are filtered in linear space, alpha is always filtered as is.
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include "Core/Containers/Buffer.h"
+
+namespace Oryol {
+
+class MipChain {
+public:
+    /// max number of mipmap levels
+    static const int MaxNumMips = 16;
+
+    /// setup from RGBA8 pixels, optionally generate mipmaps
+    void Setup(const uint8_t* rgba, int width, int height, bool mipmaps, bool srgb);
+    /// get number of mipmap levels (1 if no mipmaps)
+    int NumMips() const;
+    /// get width of a mipmap level
+    int Width(int mip) const;
+    /// get height of a mipmap level
+    int Height(int mip) const;
+    /// get pixels of a mipmap level
+    const uint8_t* Pixels(int mip) const;
+
+private:
+    /// downsample one level with a 2x2 box filter
+    static void downsample(const uint8_t* src, int srcWidth, int srcHeight, uint8_t* dst, int dstWidth, int dstHeight, bool srgb);
+
+    Buffer data;
+    int numMips = 0;
+    int widths[MaxNumMips];
+    int heights[MaxNumMips];
+    int offsets[MaxNumMips];
+};
+
+//------------------------------------------------------------------------------
+inline int
+MipChain::NumMips() const {
+    return this->numMips;
+}
+
+//------------------------------------------------------------------------------
+inline int
+MipChain::Width(int mip) const {
+    o_assert_dbg((mip >= 0) && (mip < this->numMips));
+    return this->widths[mip];
+}
+
+//------------------------------------------------------------------------------
+inline int
+MipChain::Height(int mip) const {
+    o_assert_dbg((mip >= 0) && (mip < this->numMips));
+    return this->heights[mip];
+}
+
+//------------------------------------------------------------------------------
+inline const uint8_t*
+MipChain::Pixels(int mip) const {
+    o_assert_dbg((mip >= 0) && (mip < this->numMips));
+    return this->data.Data() + this->offsets[mip];
+}
+
+} // namespace Oryol
@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+//  TexCooker.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "TexCooker.h"
+#include "TexCook/BlockEncoder.h"
+#include "TexCook/MipChain.h"
+#include "Core/Assertion.h"
+#include "Core/Log.h"
+#include "Core/Hash/Hash.h"
+#include "Core/String/StringBuilder.h"
+#include <cstdlib>
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+static PixelFormat::Code
+parseFormat(const String& str, bool srgb) {
+    if (str == "rgba8") {
+        return PixelFormat::RGBA8;
+    }
+    else if ((str == "bc1") || (str == "dxt1")) {
+        return PixelFormat::DXT1;
+    }
+    else if ((str == "bc3") || (str == "dxt5")) {
+        return PixelFormat::DXT5;
+    }
+    else if (str == "etc2") {
+        return srgb ? PixelFormat::ETC2_SRGB8 : PixelFormat::ETC2_RGB8;
+    }
+    else {
+        return PixelFormat::InvalidPixelFormat;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+TexCooker::ParseJobs(const char* text, Array<Job>& outJobs) {
+    o_assert_dbg(text);
+    StringBuilder strBuilder(text);
+    Array<String> lines;
+    strBuilder.Tokenize("\r\n", lines);
+    Array<String> tokens;
+    for (const String& line : lines) {
+        if (line.Front() == '#') {
+            continue;
+        }
+        strBuilder.Set(line);
+        if (0 == strBuilder.Tokenize(" \t", tokens)) {
+            continue;
+        }
+        if (tokens.Size() < 3) {
+            o_warn("TexCooker: expected '<src> <dst> <format> [srgb] [nomips]' in line '%s'\n", line.AsCStr());
+            return false;
+        }
+        Job job;
+        job.Src = tokens[0];
+        job.Dst = tokens[1];
+        for (int i = 3; i < tokens.Size(); i++) {
+            if (tokens[i] == "srgb") {
+                job.SRGB = true;
+            }
+            else if (tokens[i] == "nomips") {
+                job.Mipmaps = false;
+            }
+            else {
+                o_warn("TexCooker: unknown option '%s' in line '%s'\n", tokens[i].AsCStr(), line.AsCStr());
+                return false;
+            }
+        }
+        job.Format = parseFormat(tokens[2], job.SRGB);
+        if (PixelFormat::InvalidPixelFormat == job.Format) {
+            o_warn("TexCooker: unknown format '%s' in line '%s'\n", tokens[2].AsCStr(), line.AsCStr());
+            return false;
+        }
+        if (!TextureWriter::IsSupported(ContainerFor(job.Dst), job.Format)) {
+            o_warn("TexCooker: format '%s' can't be written to '%s'\n", tokens[2].AsCStr(), job.Dst.AsCStr());
+            return false;
+        }
+        outJobs.Add(job);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+TextureWriter::Container
+TexCooker::ContainerFor(const String& dst) {
+    const int len = dst.Length();
+    if ((len > 4) && (String(dst, len - 4, EndOfString) == ".ktx")) {
+        return TextureWriter::KTX;
+    }
+    else {
+        return TextureWriter::DDS;
+    }
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+TexCooker::JobHash(const Job& job, const void* srcData, int srcSize) {
+    o_assert_dbg(srcData && (srcSize > 0));
+    HashBuilder hashBuilder;
+    hashBuilder.AddValue(uint32_t(Version));
+    hashBuilder.AddValue(uint32_t(job.Format));
+    hashBuilder.AddValue(uint32_t((job.Mipmaps ? 1 : 0) | (job.SRGB ? 2 : 0)));
+    hashBuilder.Add(srcData, srcSize);
+    return hashBuilder.Result();
+}
+
+//------------------------------------------------------------------------------
+void
+TexCooker::Cook(const Job& job, const uint8_t* rgba, int width, int height, Buffer& outFile) {
+    o_assert(BlockEncoder::IsSupported(job.Format));
+
+    MipChain mipChain;
+    mipChain.Setup(rgba, width, height, job.Mipmaps, job.SRGB);
+    int size = 0;
+    for (int mip = 0; mip < mipChain.NumMips(); mip++) {
+        size += BlockEncoder::EncodedSize(job.Format, mipChain.Width(mip), mipChain.Height(mip));
+    }
+    Buffer encoded;
+    encoded.Reserve(size);
+    for (int mip = 0; mip < mipChain.NumMips(); mip++) {
+        const int w = mipChain.Width(mip);
+        const int h = mipChain.Height(mip);
+        uint8_t* dst = encoded.Add(BlockEncoder::EncodedSize(job.Format, w, h));
+        BlockEncoder::Encode(job.Format, mipChain.Pixels(mip), w, h, dst);
+    }
+    TextureWriter::Write(ContainerFor(job.Dst), job.Format, width, height, mipChain.NumMips(), encoded.Data(), outFile);
+}
+
+//------------------------------------------------------------------------------
+void
+TexCooker::ParseManifest(const char* text, Map<String, uint64_t>& outManifest) {
+    o_assert_dbg(text);
+    StringBuilder strBuilder(text);
+    Array<String> lines;
+    strBuilder.Tokenize("\r\n", lines);
+    Array<String> tokens;
+    for (const String& line : lines) {
+        strBuilder.Set(line);
+        if (2 == strBuilder.Tokenize(" \t", tokens)) {
+            const uint64_t hash = std::strtoull(tokens[0].AsCStr(), nullptr, 16);
+            if (outManifest.Contains(tokens[1])) {
+                outManifest[tokens[1]] = hash;
+            }
+            else {
+                outManifest.Add(tokens[1], hash);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+String
+TexCooker::WriteManifest(const Map<String, uint64_t>& manifest) {
+    StringBuilder strBuilder;
+    for (const auto& kvp : manifest) {
+        strBuilder.AppendFormat(1024, "%016llx %s\n", (unsigned long long)kvp.Value(), kvp.Key().AsCStr());
+    }
+    return strBuilder.GetString();
+}
+
+} // namespace Oryol
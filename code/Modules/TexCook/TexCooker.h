@@ -0,0 +1,61 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::TexCooker
+    @ingroup TexCook
+    @brief cook jobs, content hashes and the incremental build manifest
+
+    A job file has one texture per line:
+
+        <src> <dst> <rgba8|bc1|bc3|etc2> [srgb] [nomips]
+
+    Empty lines and lines starting with '#' are ignored. The container
+    is selected by the dst extension (.ktx writes KTX, everything else
+    DDS), ETC2 can only be written into KTX files.
+
+    The manifest maps each dst path to the JobHash() of the last
+    successful cook, a job only needs to run again when its hash
+    changes (different source content, format or options) or when
+    the dst file is missing.
+*/
+#include "Core/Types.h"
+#include "Core/String/String.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Buffer.h"
+#include "Core/Containers/Map.h"
+#include "Gfx/Core/Enums.h"
+#include "TexCook/TextureWriter.h"
+
+namespace Oryol {
+
+class TexCooker {
+public:
+    /// a single cook job
+    struct Job {
+        String Src;
+        String Dst;
+        PixelFormat::Code Format = PixelFormat::InvalidPixelFormat;
+        bool Mipmaps = true;
+        bool SRGB = false;
+    };
+
+    /// parse a job file, return false on the first invalid line
+    static bool ParseJobs(const char* text, Array<Job>& outJobs);
+    /// get the container for a dst file name
+    static TextureWriter::Container ContainerFor(const String& dst);
+    /// compute the content hash of a job from its source file data
+    static uint64_t JobHash(const Job& job, const void* srcData, int srcSize);
+    /// cook RGBA8 pixels into a complete texture file
+    static void Cook(const Job& job, const uint8_t* rgba, int width, int height, Buffer& outFile);
+
+    /// parse a manifest (one "<hash> <dst>" line per cooked file)
+    static void ParseManifest(const char* text, Map<String, uint64_t>& outManifest);
+    /// write a manifest
+    static String WriteManifest(const Map<String, uint64_t>& manifest);
+
+private:
+    /// bump to invalidate all manifest entries when the encoders change
+    static const uint32_t Version = 1;
+};
+
+} // namespace Oryol
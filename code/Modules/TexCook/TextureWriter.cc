@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+//  TextureWriter.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "TextureWriter.h"
+#include "TexCook/BlockEncoder.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+static int
+mipSize(PixelFormat::Code fmt, int width, int height, int mip) {
+    const int w = width >> mip;
+    const int h = height >> mip;
+    return BlockEncoder::EncodedSize(fmt, w > 0 ? w : 1, h > 0 ? h : 1);
+}
+
+//------------------------------------------------------------------------------
+bool
+TextureWriter::IsSupported(Container container, PixelFormat::Code fmt) {
+    switch (fmt) {
+        case PixelFormat::RGBA8:
+        case PixelFormat::DXT1:
+        case PixelFormat::DXT5:
+            return true;
+        case PixelFormat::ETC2_RGB8:
+        case PixelFormat::ETC2_SRGB8:
+            return KTX == container;
+        default:
+            return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+TextureWriter::Write(Container container, PixelFormat::Code fmt, int width, int height, int numMips, const uint8_t* data, Buffer& out) {
+    o_assert(IsSupported(container, fmt));
+    o_assert(data && (width > 0) && (height > 0) && (numMips > 0));
+    if (DDS == container) {
+        writeDDS(fmt, width, height, numMips, data, out);
+    }
+    else {
+        writeKTX(fmt, width, height, numMips, data, out);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+TextureWriter::writeDDS(PixelFormat::Code fmt, int width, int height, int numMips, const uint8_t* data, Buffer& out) {
+    // DDS_HEADER and DDS_PIXELFORMAT, see the DirectX docs
+    const uint32_t DDSD_CAPS = 0x1, DDSD_HEIGHT = 0x2, DDSD_WIDTH = 0x4, DDSD_PITCH = 0x8;
+    const uint32_t DDSD_PIXELFORMAT = 0x1000, DDSD_MIPMAPCOUNT = 0x20000, DDSD_LINEARSIZE = 0x80000;
+    const uint32_t DDPF_ALPHAPIXELS = 0x1, DDPF_FOURCC = 0x4, DDPF_RGB = 0x40;
+    const uint32_t DDSCAPS_COMPLEX = 0x8, DDSCAPS_TEXTURE = 0x1000, DDSCAPS_MIPMAP = 0x400000;
+
+    uint32_t header[32];
+    Memory::Clear(header, sizeof(header));
+    header[0] = 0x20534444;     // 'DDS '
+    header[1] = 124;
+    header[2] = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT;
+    header[3] = height;
+    header[4] = width;
+    header[7] = numMips;
+    header[19] = 32;
+    if (PixelFormat::RGBA8 == fmt) {
+        header[2] |= DDSD_PITCH;
+        header[5] = width * 4;
+        header[20] = DDPF_RGB | DDPF_ALPHAPIXELS;
+        header[22] = 32;
+        header[23] = 0x000000FF;
+        header[24] = 0x0000FF00;
+        header[25] = 0x00FF0000;
+        header[26] = 0xFF000000;
+    }
+    else {
+        header[2] |= DDSD_LINEARSIZE;
+        header[5] = BlockEncoder::EncodedSize(fmt, width, height);
+        header[20] = DDPF_FOURCC;
+        header[21] = (PixelFormat::DXT1 == fmt) ? 0x31545844 : 0x35545844;  // 'DXT1', 'DXT5'
+    }
+    header[27] = DDSCAPS_TEXTURE;
+    if (numMips > 1) {
+        header[2] |= DDSD_MIPMAPCOUNT;
+        header[27] |= DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+    }
+
+    int dataSize = 0;
+    for (int mip = 0; mip < numMips; mip++) {
+        dataSize += mipSize(fmt, width, height, mip);
+    }
+    out.Reserve(int(sizeof(header)) + dataSize);
+    out.Add((const uint8_t*)header, sizeof(header));
+    out.Add(data, dataSize);
+}
+
+//------------------------------------------------------------------------------
+void
+TextureWriter::writeKTX(PixelFormat::Code fmt, int width, int height, int numMips, const uint8_t* data, Buffer& out) {
+    static const uint8_t identifier[12] = {
+        0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'
+    };
+    uint32_t header[13];
+    Memory::Clear(header, sizeof(header));
+    header[0] = 0x04030201;     // endianness
+    switch (fmt) {
+        case PixelFormat::RGBA8:
+            header[1] = 0x1401;     // glType: GL_UNSIGNED_BYTE
+            header[3] = 0x1908;     // glFormat: GL_RGBA
+            header[4] = 0x8058;     // glInternalFormat: GL_RGBA8
+            header[5] = 0x1908;     // glBaseInternalFormat: GL_RGBA
+            break;
+        case PixelFormat::DXT1:
+            header[4] = 0x83F1;     // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+            header[5] = 0x1908;
+            break;
+        case PixelFormat::DXT5:
+            header[4] = 0x83F3;     // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+            header[5] = 0x1908;
+            break;
+        case PixelFormat::ETC2_RGB8:
+            header[4] = 0x9274;     // GL_COMPRESSED_RGB8_ETC2
+            header[5] = 0x1907;     // GL_RGB
+            break;
+        default:
+            header[4] = 0x9275;     // GL_COMPRESSED_SRGB8_ETC2
+            header[5] = 0x1907;
+            break;
+    }
+    header[2] = 1;              // glTypeSize
+    header[6] = width;
+    header[7] = height;
+    header[10] = 1;             // numberOfFaces
+    header[11] = numMips;
+    out.Add(identifier, sizeof(identifier));
+    out.Add((const uint8_t*)header, sizeof(header));
+
+    // each mip level is prefixed with its size, all sizes are multiples of 4
+    for (int mip = 0; mip < numMips; mip++) {
+        const uint32_t size = mipSize(fmt, width, height, mip);
+        out.Add((const uint8_t*)&size, sizeof(size));
+        out.Add(data, size);
+        data += size;
+    }
+}
+
+} // namespace Oryol
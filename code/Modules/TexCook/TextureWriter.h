@@ -0,0 +1,40 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::TextureWriter
+    @ingroup TexCook
+    @brief write encoded texture data into DDS or KTX files
+
+    The written files can be loaded with the Assets module's
+    TextureLoader (through gliml). DDS is written for RGBA8, DXT1
+    and DXT5, KTX for all formats BlockEncoder supports. The
+    data must be the encoded mipmap levels back-to-back, each
+    level BlockEncoder::EncodedSize() bytes.
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Buffer.h"
+#include "Gfx/Core/Enums.h"
+
+namespace Oryol {
+
+class TextureWriter {
+public:
+    /// texture file containers
+    enum Container {
+        DDS,
+        KTX,
+    };
+
+    /// return true if a pixel format can be written into a container
+    static bool IsSupported(Container container, PixelFormat::Code fmt);
+    /// write a 2D texture file with mipmaps into a buffer
+    static void Write(Container container, PixelFormat::Code fmt, int width, int height, int numMips, const uint8_t* data, Buffer& out);
+
+private:
+    /// write a DDS file
+    static void writeDDS(PixelFormat::Code fmt, int width, int height, int numMips, const uint8_t* data, Buffer& out);
+    /// write a KTX file
+    static void writeKTX(PixelFormat::Code fmt, int width, int height, int numMips, const uint8_t* data, Buffer& out);
+};
+
+} // namespace Oryol
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+//  texcook.cc
+//
+//  Cook the textures of a job file into DDS/KTX files on all CPU cores:
+//
+//      texcook -jobs jobs.txt -src data -dst build/webpage [-threads N] [-force]
+//
+//  Source and destination paths in the job file are relative to -src
+//  and -dst. Textures whose content hash matches the manifest in the
+//  destination directory are skipped, -force cooks everything.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Core/Core.h"
+#include "Core/Args.h"
+#include "Core/Log.h"
+#include "Core/String/StringBuilder.h"
+#include "Core/Threading/WorkerPool.h"
+#include "TexCook/TexCooker.h"
+#include <cstdio>
+#include <thread>
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_NO_STDIO
+#include "stb_image.h"
+
+using namespace Oryol;
+
+//------------------------------------------------------------------------------
+static bool
+readFile(const String& path, Buffer& out) {
+    FILE* fp = std::fopen(path.AsCStr(), "rb");
+    if (!fp) {
+        return false;
+    }
+    std::fseek(fp, 0, SEEK_END);
+    const long size = std::ftell(fp);
+    std::fseek(fp, 0, SEEK_SET);
+    bool success = size > 0;
+    if (success) {
+        out.Clear();
+        success = std::fread(out.Add(int(size)), 1, size_t(size), fp) == size_t(size);
+    }
+    std::fclose(fp);
+    return success;
+}
+
+//------------------------------------------------------------------------------
+static bool
+writeFile(const String& path, const uint8_t* data, int size) {
+    FILE* fp = std::fopen(path.AsCStr(), "wb");
+    if (!fp) {
+        return false;
+    }
+    const bool success = std::fwrite(data, 1, size_t(size), fp) == size_t(size);
+    return (0 == std::fclose(fp)) && success;
+}
+
+//------------------------------------------------------------------------------
+static bool
+fileExists(const String& path) {
+    FILE* fp = std::fopen(path.AsCStr(), "rb");
+    if (fp) {
+        std::fclose(fp);
+        return true;
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+int
+main(int argc, const char** argv) {
+    Core::Setup();
+    Args args(argc, argv);
+    if (!args.HasArg("-jobs")) {
+        Log::Info("usage: texcook -jobs <file> [-src <dir>] [-dst <dir>] [-threads <num>] [-force]\n");
+        Core::Discard();
+        return 10;
+    }
+    const String srcDir = args.GetString("-src", ".");
+    const String dstDir = args.GetString("-dst", ".");
+    const bool force = args.HasArg("-force");
+
+    // load the job file and the manifest of the previous run
+    Buffer fileData;
+    Array<TexCooker::Job> jobs;
+    if (!readFile(args.GetString("-jobs"), fileData)) {
+        Log::Error("texcook: failed to read job file '%s'\n", args.GetString("-jobs").AsCStr());
+        Core::Discard();
+        return 10;
+    }
+    String jobText((const char*)fileData.Data(), 0, fileData.Size());
+    if (!TexCooker::ParseJobs(jobText.AsCStr(), jobs)) {
+        Core::Discard();
+        return 10;
+    }
+    const String manifestPath = StringBuilder({ dstDir, "/texcook.manifest" }).GetString();
+    Map<String, uint64_t> manifest;
+    if (readFile(manifestPath, fileData)) {
+        String manifestText((const char*)fileData.Data(), 0, fileData.Size());
+        TexCooker::ParseManifest(manifestText.AsCStr(), manifest);
+    }
+
+    // cook one job per chunk, jobs only write their own result slot
+    enum Result { Skipped, Cooked, Failed };
+    Array<Result> results;
+    Array<uint64_t> hashes;
+    results.Reserve(jobs.Size());
+    hashes.Reserve(jobs.Size());
+    for (int i = 0; i < jobs.Size(); i++) {
+        results.Add(Failed);
+        hashes.Add(0);
+    }
+    const int numThreads = args.GetInt("-threads", int(std::thread::hardware_concurrency()));
+    WorkerPool workers;
+    workers.Setup(numThreads > 1 ? numThreads - 1 : 0);
+    workers.ParallelFor(jobs.Size(), 1, [&](int begin, int end) {
+        Buffer srcData;
+        Buffer dstData;
+        for (int i = begin; i < end; i++) {
+            const TexCooker::Job& job = jobs[i];
+            const String srcPath = StringBuilder({ srcDir, "/", job.Src }).GetString();
+            const String dstPath = StringBuilder({ dstDir, "/", job.Dst }).GetString();
+            if (!readFile(srcPath, srcData)) {
+                Log::Error("texcook: failed to read '%s'\n", srcPath.AsCStr());
+                continue;
+            }
+            hashes[i] = TexCooker::JobHash(job, srcData.Data(), srcData.Size());
+            const int manifestIndex = manifest.FindIndex(job.Dst);
+            if (!force && (InvalidIndex != manifestIndex) &&
+                (manifest.ValueAtIndex(manifestIndex) == hashes[i]) && fileExists(dstPath)) {
+                results[i] = Skipped;
+                continue;
+            }
+            int width = 0, height = 0, comps = 0;
+            uint8_t* rgba = stbi_load_from_memory(srcData.Data(), srcData.Size(), &width, &height, &comps, 4);
+            if (!rgba) {
+                Log::Error("texcook: failed to decode '%s' (%s)\n", srcPath.AsCStr(), stbi_failure_reason());
+                continue;
+            }
+            dstData.Clear();
+            TexCooker::Cook(job, rgba, width, height, dstData);
+            stbi_image_free(rgba);
+            if (!writeFile(dstPath, dstData.Data(), dstData.Size())) {
+                Log::Error("texcook: failed to write '%s'\n", dstPath.AsCStr());
+                continue;
+            }
+            Log::Info("texcook: %s => %s (%dx%d)\n", srcPath.AsCStr(), dstPath.AsCStr(), width, height);
+            results[i] = Cooked;
+        }
+    });
+    workers.Discard();
+
+    // update the manifest with the cooked jobs, failed jobs are dropped
+    // from the manifest so that they are retried next time
+    int numCooked = 0, numSkipped = 0, numFailed = 0;
+    for (int i = 0; i < jobs.Size(); i++) {
+        if (Failed == results[i]) {
+            numFailed++;
+            if (manifest.Contains(jobs[i].Dst)) {
+                manifest.Erase(jobs[i].Dst);
+            }
+        }
+        else {
+            if (Cooked == results[i]) {
+                numCooked++;
+            }
+            else {
+                numSkipped++;
+            }
+            if (manifest.Contains(jobs[i].Dst)) {
+                manifest[jobs[i].Dst] = hashes[i];
+            }
+            else {
+                manifest.Add(jobs[i].Dst, hashes[i]);
+            }
+        }
+    }
+    const String manifestText = TexCooker::WriteManifest(manifest);
+    if (!writeFile(manifestPath, (const uint8_t*)manifestText.AsCStr(), manifestText.Length())) {
+        Log::Error("texcook: failed to write manifest '%s'\n", manifestPath.AsCStr());
+        numFailed++;
+    }
+    Log::Info("texcook: %d cooked, %d up to date, %d failed\n", numCooked, numSkipped, numFailed);
+    Core::Discard();
+    return numFailed > 0 ? 10 : 0;
+}
@@ -0,0 +1,289 @@
+//------------------------------------------------------------------------------
+//  BlockEncoderTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "TexCook/BlockEncoder.h"
+#include <cstdlib>
+
+using namespace Oryol;
+
+// reference decoders, written straight from the format specs
+static void
+decode565(uint16_t c, int* out) {
+    const int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+static void
+decodeBC1(const uint8_t* src, uint8_t* rgba) {
+    const uint16_t c0 = src[0] | (src[1] << 8);
+    const uint16_t c1 = src[2] | (src[3] << 8);
+    int colors[4][3];
+    decode565(c0, colors[0]);
+    decode565(c1, colors[1]);
+    for (int c = 0; c < 3; c++) {
+        if (c0 > c1) {
+            colors[2][c] = (2 * colors[0][c] + colors[1][c]) / 3;
+            colors[3][c] = (colors[0][c] + 2 * colors[1][c]) / 3;
+        }
+        else {
+            colors[2][c] = (colors[0][c] + colors[1][c]) / 2;
+            colors[3][c] = 0;
+        }
+    }
+    const uint32_t indices = src[4] | (src[5] << 8) | (src[6] << 16) | (uint32_t(src[7]) << 24);
+    for (int i = 0; i < 16; i++) {
+        const int index = (indices >> (i * 2)) & 3;
+        for (int c = 0; c < 3; c++) {
+            rgba[i * 4 + c] = uint8_t(colors[index][c]);
+        }
+        rgba[i * 4 + 3] = 255;
+    }
+}
+
+static void
+decodeBC3Alpha(const uint8_t* src, uint8_t* rgba) {
+    int alphas[8] = { src[0], src[1] };
+    for (int i = 2; i < 8; i++) {
+        if (src[0] > src[1]) {
+            alphas[i] = ((8 - i) * alphas[0] + (i - 1) * alphas[1]) / 7;
+        }
+        else {
+            alphas[i] = (i < 6) ? ((6 - i) * alphas[0] + (i - 1) * alphas[1]) / 5 : (i == 6 ? 0 : 255);
+        }
+    }
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; i++) {
+        indices |= uint64_t(src[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < 16; i++) {
+        rgba[i * 4 + 3] = uint8_t(alphas[(indices >> (i * 3)) & 7]);
+    }
+}
+
+static void
+decodeETC(const uint8_t* src, uint8_t* rgba) {
+    static const int modifiers[8][2] = {
+        { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 }
+    };
+    const uint32_t hi = (uint32_t(src[0]) << 24) | (src[1] << 16) | (src[2] << 8) | src[3];
+    const uint32_t lo = (uint32_t(src[4]) << 24) | (src[5] << 16) | (src[6] << 8) | src[7];
+    const bool diff = 0 != (hi & 2);
+    const bool flip = 0 != (hi & 1);
+    int base[2][3];
+    for (int c = 0; c < 3; c++) {
+        const int shift = 24 - c * 8;
+        if (diff) {
+            const int b0 = (hi >> (shift + 3)) & 31;
+            int d = (hi >> shift) & 7;
+            d = d >= 4 ? d - 8 : d;
+            const int b1 = b0 + d;
+            CHECK((b1 >= 0) && (b1 <= 31));
+            base[0][c] = (b0 << 3) | (b0 >> 2);
+            base[1][c] = (b1 << 3) | (b1 >> 2);
+        }
+        else {
+            const int b0 = (hi >> (shift + 4)) & 15;
+            const int b1 = (hi >> shift) & 15;
+            base[0][c] = (b0 << 4) | b0;
+            base[1][c] = (b1 << 4) | b1;
+        }
+    }
+    const int tables[2] = { int((hi >> 5) & 7), int((hi >> 2) & 7) };
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            const int sub = flip ? (y >> 1) : (x >> 1);
+            const int bit = x * 4 + y;
+            const int index = (((lo >> (16 + bit)) & 1) << 1) | ((lo >> bit) & 1);
+            const int mod = (index & 2 ? -1 : 1) * modifiers[tables[sub]][index & 1];
+            for (int c = 0; c < 3; c++) {
+                const int v = base[sub][c] + mod;
+                rgba[(y * 4 + x) * 4 + c] = uint8_t(v < 0 ? 0 : (v > 255 ? 255 : v));
+            }
+            rgba[(y * 4 + x) * 4 + 3] = 255;
+        }
+    }
+}
+
+// max abs difference of the color (and optionally alpha) channels
+static int
+maxError(const uint8_t* a, const uint8_t* b, int numChannels) {
+    int maxErr = 0;
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < numChannels; c++) {
+            const int err = std::abs(a[i * 4 + c] - b[i * 4 + c]);
+            maxErr = err > maxErr ? err : maxErr;
+        }
+    }
+    return maxErr;
+}
+
+static void
+solidBlock(uint8_t* block, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    for (int i = 0; i < 16; i++) {
+        block[i * 4 + 0] = r;
+        block[i * 4 + 1] = g;
+        block[i * 4 + 2] = b;
+        block[i * 4 + 3] = a;
+    }
+}
+
+// a smooth diagonal gradient with varying alpha
+static void
+gradientBlock(uint8_t* block) {
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            uint8_t* p = block + (y * 4 + x) * 4;
+            p[0] = uint8_t(40 + x * 20 + y * 10);
+            p[1] = uint8_t(100 + x * 15);
+            p[2] = uint8_t(200 - y * 20);
+            p[3] = uint8_t(x * 60 + y * 5);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(BlockEncoderSizeTest) {
+    CHECK(BlockEncoder::IsSupported(PixelFormat::DXT1));
+    CHECK(BlockEncoder::IsSupported(PixelFormat::ETC2_SRGB8));
+    CHECK(!BlockEncoder::IsSupported(PixelFormat::DXT3));
+    CHECK(!BlockEncoder::IsSupported(PixelFormat::PVRTC4_RGB));
+    CHECK(BlockEncoder::EncodedSize(PixelFormat::RGBA8, 5, 3) == 60);
+    CHECK(BlockEncoder::EncodedSize(PixelFormat::DXT1, 5, 5) == 32);
+    CHECK(BlockEncoder::EncodedSize(PixelFormat::DXT1, 1, 1) == 8);
+    CHECK(BlockEncoder::EncodedSize(PixelFormat::DXT5, 8, 4) == 32);
+    CHECK(BlockEncoder::EncodedSize(PixelFormat::ETC2_RGB8, 8, 4) == 16);
+}
+
+//------------------------------------------------------------------------------
+TEST(BlockEncoderBC1Test) {
+    uint8_t block[64], decoded[64], encoded[8];
+
+    // a solid color only loses the 565 quantization
+    solidBlock(block, 200, 100, 50, 255);
+    BlockEncoder::EncodeBC1(block, encoded);
+    decodeBC1(encoded, decoded);
+    CHECK(maxError(block, decoded, 3) <= 4);
+
+    // pure black and white must be exact
+    solidBlock(block, 0, 0, 0, 255);
+    BlockEncoder::EncodeBC1(block, encoded);
+    decodeBC1(encoded, decoded);
+    CHECK(maxError(block, decoded, 3) == 0);
+    solidBlock(block, 255, 255, 255, 255);
+    BlockEncoder::EncodeBC1(block, encoded);
+    decodeBC1(encoded, decoded);
+    CHECK(maxError(block, decoded, 3) == 0);
+
+    // 4-color mode must always be used (no accidental black pixels),
+    // the gradient spans a plane, the error across the fitted line remains
+    gradientBlock(block);
+    BlockEncoder::EncodeBC1(block, encoded);
+    CHECK((encoded[0] | (encoded[1] << 8)) > (encoded[2] | (encoded[3] << 8)));
+    decodeBC1(encoded, decoded);
+    CHECK(maxError(block, decoded, 3) <= 48);
+
+    // two colors on the endpoints of the axis
+    for (int i = 0; i < 16; i++) {
+        const uint8_t v = (i & 1) ? 255 : 0;
+        block[i * 4 + 0] = v;
+        block[i * 4 + 1] = v;
+        block[i * 4 + 2] = v;
+    }
+    BlockEncoder::EncodeBC1(block, encoded);
+    decodeBC1(encoded, decoded);
+    CHECK(maxError(block, decoded, 3) <= 16);
+}
+
+//------------------------------------------------------------------------------
+TEST(BlockEncoderBC3Test) {
+    uint8_t block[64], decoded[64], encoded[16];
+
+    solidBlock(block, 10, 20, 30, 77);
+    BlockEncoder::EncodeBC3(block, encoded);
+    decodeBC1(encoded + 8, decoded);
+    decodeBC3Alpha(encoded, decoded);
+    for (int i = 0; i < 16; i++) {
+        CHECK(decoded[i * 4 + 3] == 77);
+    }
+    CHECK(maxError(block, decoded, 3) <= 4);
+
+    gradientBlock(block);
+    BlockEncoder::EncodeBC3(block, encoded);
+    decodeBC1(encoded + 8, decoded);
+    decodeBC3Alpha(encoded, decoded);
+    // alpha range is 0..195 in 7 steps, max error is half a step
+    CHECK(maxError(block, decoded, 4) <= 48);
+    int maxAlphaErr = 0;
+    for (int i = 0; i < 16; i++) {
+        const int err = std::abs(block[i * 4 + 3] - decoded[i * 4 + 3]);
+        maxAlphaErr = err > maxAlphaErr ? err : maxAlphaErr;
+    }
+    CHECK(maxAlphaErr <= 15);
+}
+
+//------------------------------------------------------------------------------
+TEST(BlockEncoderETC2Test) {
+    uint8_t block[64], decoded[64], encoded[8];
+
+    solidBlock(block, 200, 100, 50, 255);
+    BlockEncoder::EncodeETC2(block, encoded);
+    decodeETC(encoded, decoded);
+    CHECK(maxError(block, decoded, 3) <= 8);
+
+    gradientBlock(block);
+    BlockEncoder::EncodeETC2(block, encoded);
+    decodeETC(encoded, decoded);
+    CHECK(maxError(block, decoded, 3) <= 32);
+
+    // left and right halves too different for differential mode
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            uint8_t* p = block + (y * 4 + x) * 4;
+            p[0] = x < 2 ? 250 : 10;
+            p[1] = x < 2 ? 10 : 250;
+            p[2] = 128;
+        }
+    }
+    BlockEncoder::EncodeETC2(block, encoded);
+    CHECK(0 == (encoded[3] & 2));
+    CHECK(0 == (encoded[3] & 1));
+    decodeETC(encoded, decoded);
+    CHECK(maxError(block, decoded, 3) <= 16);
+}
+
+//------------------------------------------------------------------------------
+TEST(BlockEncoderImageTest) {
+    // a 6x5 image covers full, clamped right, and clamped bottom blocks
+    const int width = 6, height = 5;
+    uint8_t rgba[width * height * 4];
+    for (int i = 0; i < width * height; i++) {
+        rgba[i * 4 + 0] = uint8_t(i * 8);
+        rgba[i * 4 + 1] = uint8_t(255 - i * 8);
+        rgba[i * 4 + 2] = 64;
+        rgba[i * 4 + 3] = 255;
+    }
+    uint8_t dxt1[32], etc2[32], copy[width * height * 4];
+    CHECK(BlockEncoder::EncodedSize(PixelFormat::DXT1, width, height) == 32);
+    BlockEncoder::Encode(PixelFormat::DXT1, rgba, width, height, dxt1);
+    BlockEncoder::Encode(PixelFormat::ETC2_RGB8, rgba, width, height, etc2);
+    BlockEncoder::Encode(PixelFormat::RGBA8, rgba, width, height, copy);
+    for (int i = 0; i < width * height * 4; i++) {
+        CHECK(rgba[i] == copy[i]);
+    }
+
+    // the last block (x=4, y=4) is clamped to the bottom-right pixels
+    uint8_t decoded[64];
+    decodeBC1(dxt1 + 3 * 8, decoded);
+    const uint8_t* last = rgba + ((height - 1) * width + (width - 1)) * 4;
+    for (int i = 0; i < 16; i++) {
+        const int x = (i & 3) ? 5 : 4;
+        CHECK(std::abs(decoded[i * 4 + 0] - rgba[((height - 1) * width + x) * 4]) <= 16);
+    }
+    decodeETC(etc2 + 3 * 8, decoded);
+    CHECK(std::abs(decoded[15 * 4 + 0] - last[0]) <= 16);
+    CHECK(std::abs(decoded[15 * 4 + 1] - last[1]) <= 16);
+}
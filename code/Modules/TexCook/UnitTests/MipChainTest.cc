@@ -0,0 +1,57 @@
+//------------------------------------------------------------------------------
+//  MipChainTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "TexCook/MipChain.h"
+
+using namespace Oryol;
+
+//------------------------------------------------------------------------------
+TEST(MipChainSizeTest) {
+    uint8_t rgba[8 * 3 * 4] = { };
+    MipChain mipChain;
+    mipChain.Setup(rgba, 8, 3, false, false);
+    CHECK(mipChain.NumMips() == 1);
+    CHECK(mipChain.Width(0) == 8);
+    CHECK(mipChain.Height(0) == 3);
+
+    // 8x3 => 4x1 => 2x1 => 1x1
+    mipChain.Setup(rgba, 8, 3, true, false);
+    CHECK(mipChain.NumMips() == 4);
+    CHECK((mipChain.Width(1) == 4) && (mipChain.Height(1) == 1));
+    CHECK((mipChain.Width(2) == 2) && (mipChain.Height(2) == 1));
+    CHECK((mipChain.Width(3) == 1) && (mipChain.Height(3) == 1));
+    CHECK(mipChain.Pixels(1) == mipChain.Pixels(0) + 8 * 3 * 4);
+}
+
+//------------------------------------------------------------------------------
+TEST(MipChainFilterTest) {
+    // 2x2 checker of black and white, alpha 0 and 255
+    const uint8_t rgba[2 * 2 * 4] = {
+        0, 0, 0, 0,         255, 255, 255, 255,
+        255, 255, 255, 255, 0, 0, 0, 0,
+    };
+    MipChain mipChain;
+    mipChain.Setup(rgba, 2, 2, true, false);
+    CHECK(mipChain.NumMips() == 2);
+    const uint8_t* p = mipChain.Pixels(1);
+    CHECK(p[0] == 128);
+    CHECK(p[3] == 128);
+
+    // in sRGB the average of black and white is brighter, alpha stays linear
+    mipChain.Setup(rgba, 2, 2, true, true);
+    p = mipChain.Pixels(1);
+    CHECK((p[0] >= 186) && (p[0] <= 189));
+    CHECK(p[3] == 128);
+
+    // a 4x1 row is only filtered horizontally
+    const uint8_t row[4 * 4] = {
+        0, 0, 0, 255,   100, 0, 0, 255,   200, 0, 0, 255,   250, 0, 0, 255,
+    };
+    mipChain.Setup(row, 4, 1, true, false);
+    CHECK(mipChain.NumMips() == 3);
+    CHECK(mipChain.Pixels(1)[0] == 50);
+    CHECK(mipChain.Pixels(1)[4] == 225);
+    CHECK(mipChain.Pixels(2)[0] == 138);
+}
@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+//  TexCookerTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "TexCook/TexCooker.h"
+
+using namespace Oryol;
+
+//------------------------------------------------------------------------------
+TEST(TexCookerParseJobsTest) {
+    Array<TexCooker::Job> jobs;
+    CHECK(TexCooker::ParseJobs(
+        "# sample textures\n"
+        "lok256.jpg lok_dxt1.dds bc1\n"
+        "\n"
+        "lok256.jpg\tlok_rgba8.dds rgba8 nomips\r\n"
+        "   lok256.jpg lok_etc2.ktx etc2 srgb\n", jobs));
+    CHECK(jobs.Size() == 3);
+    CHECK(jobs[0].Src == "lok256.jpg");
+    CHECK(jobs[0].Dst == "lok_dxt1.dds");
+    CHECK(jobs[0].Format == PixelFormat::DXT1);
+    CHECK(jobs[0].Mipmaps && !jobs[0].SRGB);
+    CHECK(jobs[1].Format == PixelFormat::RGBA8);
+    CHECK(!jobs[1].Mipmaps);
+    CHECK(jobs[2].Format == PixelFormat::ETC2_SRGB8);
+    CHECK(jobs[2].SRGB);
+    CHECK(TexCooker::ContainerFor(jobs[0].Dst) == TextureWriter::DDS);
+    CHECK(TexCooker::ContainerFor(jobs[2].Dst) == TextureWriter::KTX);
+
+    // errors: missing format, unknown format, unknown option, ETC2 in DDS
+    jobs.Clear();
+    CHECK(!TexCooker::ParseJobs("a.png b.dds\n", jobs));
+    CHECK(!TexCooker::ParseJobs("a.png b.dds bc7\n", jobs));
+    CHECK(!TexCooker::ParseJobs("a.png b.dds bc1 fast\n", jobs));
+    CHECK(!TexCooker::ParseJobs("a.png b.dds etc2\n", jobs));
+}
+
+//------------------------------------------------------------------------------
+TEST(TexCookerHashTest) {
+    TexCooker::Job job;
+    job.Src = "a.png";
+    job.Dst = "a.dds";
+    job.Format = PixelFormat::DXT1;
+    const uint8_t src0[4] = { 1, 2, 3, 4 };
+    const uint8_t src1[4] = { 1, 2, 3, 5 };
+    const uint64_t hash = TexCooker::JobHash(job, src0, sizeof(src0));
+    CHECK(hash == TexCooker::JobHash(job, src0, sizeof(src0)));
+    CHECK(hash != TexCooker::JobHash(job, src1, sizeof(src1)));
+    job.Mipmaps = false;
+    CHECK(hash != TexCooker::JobHash(job, src0, sizeof(src0)));
+    job.Mipmaps = true;
+    job.Format = PixelFormat::DXT5;
+    CHECK(hash != TexCooker::JobHash(job, src0, sizeof(src0)));
+}
+
+//------------------------------------------------------------------------------
+TEST(TexCookerManifestTest) {
+    Map<String, uint64_t> manifest;
+    manifest.Add("lok_dxt1.dds", 0x0123456789ABCDEFULL);
+    manifest.Add("lok_etc2.ktx", 42);
+    const String text = TexCooker::WriteManifest(manifest);
+
+    Map<String, uint64_t> parsed;
+    TexCooker::ParseManifest(text.AsCStr(), parsed);
+    CHECK(parsed.Size() == 2);
+    CHECK(parsed["lok_dxt1.dds"] == 0x0123456789ABCDEFULL);
+    CHECK(parsed["lok_etc2.ktx"] == 42);
+
+    // later lines override earlier ones, broken lines are ignored
+    TexCooker::ParseManifest("000000000000002a lok_etc2.ktx\nbroken\n0000000000000007 lok_etc2.ktx\n", parsed);
+    CHECK(parsed.Size() == 2);
+    CHECK(parsed["lok_etc2.ktx"] == 7);
+}
+
+//------------------------------------------------------------------------------
+TEST(TexCookerCookTest) {
+    // a 16x16 gradient cooked to DXT1 with mips: 16x16, 8x8, 4x4, 2x2, 1x1
+    uint8_t rgba[16 * 16 * 4];
+    for (int i = 0; i < 16 * 16; i++) {
+        rgba[i * 4 + 0] = uint8_t(i);
+        rgba[i * 4 + 1] = uint8_t(255 - i);
+        rgba[i * 4 + 2] = 128;
+        rgba[i * 4 + 3] = 255;
+    }
+    TexCooker::Job job;
+    job.Dst = "test.dds";
+    job.Format = PixelFormat::DXT1;
+    Buffer file;
+    TexCooker::Cook(job, rgba, 16, 16, file);
+    CHECK(file.Size() == 128 + 128 + 32 + 8 + 8 + 8);
+
+    job.Dst = "test.ktx";
+    job.Format = PixelFormat::ETC2_RGB8;
+    job.Mipmaps = false;
+    file.Clear();
+    TexCooker::Cook(job, rgba, 16, 16, file);
+    CHECK(file.Size() == 64 + 4 + 128);
+}
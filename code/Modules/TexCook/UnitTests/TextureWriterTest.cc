@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------------
+//  TextureWriterTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "TexCook/TextureWriter.h"
+#include "TexCook/BlockEncoder.h"
+#include "Core/Memory/Memory.h"
+
+using namespace Oryol;
+
+static uint32_t
+u32(const Buffer& buf, int offset) {
+    uint32_t val;
+    Memory::Copy(buf.Data() + offset, &val, sizeof(val));
+    return val;
+}
+
+//------------------------------------------------------------------------------
+TEST(TextureWriterSupportTest) {
+    CHECK(TextureWriter::IsSupported(TextureWriter::DDS, PixelFormat::DXT1));
+    CHECK(TextureWriter::IsSupported(TextureWriter::DDS, PixelFormat::RGBA8));
+    CHECK(!TextureWriter::IsSupported(TextureWriter::DDS, PixelFormat::ETC2_RGB8));
+    CHECK(TextureWriter::IsSupported(TextureWriter::KTX, PixelFormat::ETC2_RGB8));
+    CHECK(TextureWriter::IsSupported(TextureWriter::KTX, PixelFormat::DXT5));
+    CHECK(!TextureWriter::IsSupported(TextureWriter::KTX, PixelFormat::DXT3));
+}
+
+//------------------------------------------------------------------------------
+TEST(TextureWriterDDSTest) {
+    // 8x8 DXT5 with 4 mips: 64 + 16 + 16 + 16 bytes
+    uint8_t data[112];
+    for (int i = 0; i < int(sizeof(data)); i++) {
+        data[i] = uint8_t(i);
+    }
+    Buffer dds;
+    TextureWriter::Write(TextureWriter::DDS, PixelFormat::DXT5, 8, 8, 4, data, dds);
+    CHECK(dds.Size() == 128 + 112);
+    CHECK(u32(dds, 0) == 0x20534444);
+    CHECK(u32(dds, 4) == 124);
+    CHECK((u32(dds, 8) & 0x20000) != 0);
+    CHECK(u32(dds, 12) == 8);
+    CHECK(u32(dds, 16) == 8);
+    CHECK(u32(dds, 20) == 64);
+    CHECK(u32(dds, 28) == 4);
+    CHECK(u32(dds, 76) == 32);
+    CHECK(u32(dds, 80) == 4);
+    CHECK(u32(dds, 84) == 0x35545844);
+    CHECK(u32(dds, 108) == (0x1000 | 0x8 | 0x400000));
+    CHECK(dds.Data()[128] == 0);
+    CHECK(dds.Data()[128 + 111] == 111);
+
+    // uncompressed RGBA8 without mips
+    dds.Clear();
+    TextureWriter::Write(TextureWriter::DDS, PixelFormat::RGBA8, 4, 2, 1, data, dds);
+    CHECK(dds.Size() == 128 + 32);
+    CHECK((u32(dds, 8) & 0x20000) == 0);
+    CHECK(u32(dds, 20) == 16);
+    CHECK(u32(dds, 80) == 0x41);
+    CHECK(u32(dds, 88) == 32);
+    CHECK(u32(dds, 92) == 0xFF);
+    CHECK(u32(dds, 104) == 0xFF000000);
+    CHECK(u32(dds, 108) == 0x1000);
+}
+
+//------------------------------------------------------------------------------
+TEST(TextureWriterKTXTest) {
+    // 4x8 ETC2 with 4 mips (4x8, 2x4, 1x2, 1x1): 16 + 8 + 8 + 8 bytes
+    uint8_t data[40] = { };
+    Buffer ktx;
+    TextureWriter::Write(TextureWriter::KTX, PixelFormat::ETC2_RGB8, 4, 8, 4, data, ktx);
+    CHECK(ktx.Size() == 64 + 4 * 4 + 40);
+    CHECK(ktx.Data()[0] == 0xAB);
+    CHECK(ktx.Data()[1] == 'K');
+    CHECK(ktx.Data()[11] == '\n');
+    CHECK(u32(ktx, 12) == 0x04030201);
+    CHECK(u32(ktx, 16) == 0);
+    CHECK(u32(ktx, 28) == 0x9274);
+    CHECK(u32(ktx, 32) == 0x1907);
+    CHECK(u32(ktx, 36) == 4);
+    CHECK(u32(ktx, 40) == 8);
+    CHECK(u32(ktx, 52) == 1);
+    CHECK(u32(ktx, 56) == 4);
+    CHECK(u32(ktx, 60) == 0);
+    CHECK(u32(ktx, 64) == 16);
+    CHECK(u32(ktx, 64 + 4 + 16) == 8);
+    CHECK(u32(ktx, 64 + 4 + 16 + 4 + 8) == 8);
+}
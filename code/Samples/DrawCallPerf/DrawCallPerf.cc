@@ -8,6 +8,7 @@
 #include "Assets/Gfx/ShapeBuilder.h"
 #include "Dbg/Dbg.h"
 #include "Input/Input.h"
+#include "Particles/ParticleSystem.h"
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/random.hpp"
@@ -24,7 +25,6 @@ public:
 private:
     void updateCamera();
     void emitParticles();
-    void updateParticles();
 
     DrawState drawState;
     glm::mat4 view;
@@ -34,14 +34,10 @@ private:
     Shader::PerParticleParams perParticleParams;
     bool updateEnabled = true;
     int frameCount = 0;
-    int curNumParticles = 0;
     TimePoint lastFrameTimePoint;
     static const int NumParticlesEmittedPerFrame = 100;
     static const int MaxNumParticles = 1024 * 1024;
-    struct {
-        glm::vec4 pos;
-        glm::vec4 vec;
-    } particles[MaxNumParticles];
+    ParticleSystem particleSystem;
 };
 OryolMain(DrawCallPerfApp);
 
@@ -57,7 +53,7 @@ DrawCallPerfApp::OnRunning() {
     if (this->updateEnabled) {
         TimePoint updStart = Clock::Now();
         this->emitParticles();
-        this->updateParticles();
+        this->particleSystem.Update(1.0f / 60.0f);
         updTime = Clock::Since(updStart);
     }
     
@@ -68,8 +64,8 @@ DrawCallPerfApp::OnRunning() {
     TimePoint drawStart = Clock::Now();
     Gfx::ApplyDrawState(this->drawState);
     Gfx::ApplyUniformBlock(this->perFrameParams);
-    for (int i = 0; i < this->curNumParticles; i++) {
-        this->perParticleParams.Translate = this->particles[i].pos;
+    for (int i = 0; i < this->particleSystem.NumParticles(); i++) {
+        this->perParticleParams.Translate = glm::vec4(this->particleSystem.Position(i), 0.0f);
         Gfx::ApplyUniformBlock(this->perParticleParams);
         Gfx::Draw();
     }
@@ -87,7 +83,7 @@ DrawCallPerfApp::OnRunning() {
     Dbg::TextColor(glm::vec4(1.0f, 1.0f, 0.0f, 1.0f));
     Dbg::PrintF("\n %d draws\n\r upd=%.3fms\n\r applyRt=%.3fms\n\r draw=%.3fms\n\r frame=%.3fms\n\r"
                 " LMB/tap: toggle particle update",
-                this->curNumParticles,
+                this->particleSystem.NumParticles(),
                 updTime.AsMilliSeconds(),
                 applyRtTime.AsMilliSeconds(),
                 drawTime.AsMilliSeconds(),
@@ -111,28 +107,10 @@ DrawCallPerfApp::updateCamera() {
 void
 DrawCallPerfApp::emitParticles() {
     for (int i = 0; i < NumParticlesEmittedPerFrame; i++) {
-        if (this->curNumParticles < MaxNumParticles) {
-            this->particles[this->curNumParticles].pos = glm::vec4(0.0f, 0.0f, 0.0f, 0.0f);
-            glm::vec3 rnd = glm::ballRand(0.5f);
-            rnd.y += 2.0f;
-            this->particles[this->curNumParticles].vec = glm::vec4(rnd, 0.0f);
-            this->curNumParticles++;
-        }
-    }
-}
-
-//------------------------------------------------------------------------------
-void
-DrawCallPerfApp::updateParticles() {
-    const float frameTime = 1.0f / 60.0f;
-    for (int i = 0; i < this->curNumParticles; i++) {
-        auto& curParticle = this->particles[i];
-        curParticle.vec.y -= 1.0f * frameTime;
-        curParticle.pos += curParticle.vec * frameTime;
-        if (curParticle.pos.y < -2.0f) {
-            curParticle.pos.y = -1.8f;
-            curParticle.vec.y = -curParticle.vec.y;
-            curParticle.vec *= 0.8f;
+        glm::vec3 rnd = glm::ballRand(0.5f);
+        rnd.y += 2.0f;
+        if (InvalidIndex == this->particleSystem.Emit(glm::vec3(0.0f, 0.0f, 0.0f), rnd)) {
+            break;
         }
     }
 }
@@ -169,6 +147,12 @@ DrawCallPerfApp::OnInit() {
     this->proj = glm::perspectiveFov(glm::radians(45.0f), fbWidth, fbHeight, 0.01f, 100.0f);
     this->view = glm::lookAt(glm::vec3(0.0f, 2.5f, 0.0f), glm::vec3(0.0f, 0.0f, -10.0f), glm::vec3(0.0f, 1.0f, 0.0f));
     this->model = glm::mat4();
+
+    // the particles are only used for per-draw uniforms, no instance data needed
+    ParticleSetup particleSetup;
+    particleSetup.MaxNumParticles = MaxNumParticles;
+    particleSetup.NumWorkers = 3;
+    this->particleSystem.Setup(particleSetup);
     
     return App::OnInit();
 }
@@ -176,6 +160,7 @@ DrawCallPerfApp::OnInit() {
 //------------------------------------------------------------------------------
 AppState::Code
 DrawCallPerfApp::OnCleanup() {
+    this->particleSystem.Discard();
     Dbg::Discard();
     Input::Discard();
     Gfx::Discard();
@@ -8,6 +8,7 @@
 #include "Assets/Gfx/ShapeBuilder.h"
 #include "Dbg/Dbg.h"
 #include "Input/Input.h"
+#include "Particles/ParticleSystem.h"
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/random.hpp"
@@ -24,7 +25,6 @@ public:
 private:
     void updateCamera();
     void emitParticles();
-    void updateParticles();
 
     // the static geometry is at mesh slot 0, and the instance data at slot 1
     static const int geomMeshSlot = 0;
@@ -37,12 +37,10 @@ private:
     Shader::VSParams vsParams;
     bool updateEnabled = true;
     int frameCount = 0;
-    int curNumParticles = 0;
     TimePoint lastFrameTimePoint;
     static const int MaxNumParticles = 1024 * 1024;
     const int NumParticlesEmittedPerFrame = 100;
-    glm::vec4 positions[MaxNumParticles];
-    glm::vec4 vectors[MaxNumParticles];
+    ParticleSystem particleSystem;
 };
 OryolMain(InstancingApp);
 
@@ -58,11 +56,12 @@ InstancingApp::OnRunning() {
     if (this->updateEnabled) {
         TimePoint updStart = Clock::Now();
         this->emitParticles();
-        this->updateParticles();
+        this->particleSystem.Update(1.0f / 60.0f);
         updTime = Clock::Since(updStart);
 
+        // the particle system has written the instance data in the instance mesh's vertex layout
         TimePoint bufStart = Clock::Now();
-        Gfx::UpdateVertices(this->drawState.Mesh[instMeshSlot], this->positions, this->curNumParticles * sizeof(glm::vec4));
+        Gfx::UpdateVertices(this->drawState.Mesh[instMeshSlot], this->particleSystem.InstanceData(), this->particleSystem.InstanceDataSize());
         bufTime = Clock::Since(bufStart);
     }
     
@@ -71,7 +70,7 @@ InstancingApp::OnRunning() {
     Gfx::ApplyDefaultRenderTarget();
     Gfx::ApplyDrawState(this->drawState);
     Gfx::ApplyUniformBlock(this->vsParams);
-    Gfx::Draw(0, this->curNumParticles);
+    Gfx::Draw(0, this->particleSystem.NumParticles());
     drawTime = Clock::Since(drawStart);
     
     Dbg::DrawTextBuffer();
@@ -86,7 +85,7 @@ InstancingApp::OnRunning() {
     Duration frameTime = Clock::LapTime(this->lastFrameTimePoint);
     Dbg::PrintF("\n %d instances\n\r upd=%.3fms\n\r bufUpd=%.3fms\n\r draw=%.3fms\n\r frame=%.3fms\n\r"
                 " LMB/Tap: toggle particle updates",
-                this->curNumParticles,
+                this->particleSystem.NumParticles(),
                 updTime.AsMilliSeconds(),
                 bufTime.AsMilliSeconds(),
                 drawTime.AsMilliSeconds(),
@@ -108,29 +107,10 @@ InstancingApp::updateCamera() {
 void
 InstancingApp::emitParticles() {
     for (int i = 0; i < NumParticlesEmittedPerFrame; i++) {
-        if (this->curNumParticles < MaxNumParticles) {
-            this->positions[this->curNumParticles] = glm::vec4(0.0f, 0.0f, 0.0f, 0.0f);
-            glm::vec3 rnd = glm::ballRand(0.5f);
-            rnd.y += 2.0f;
-            this->vectors[this->curNumParticles] = glm::vec4(rnd, 0.0f);
-            this->curNumParticles++;
-        }
-    }
-}
-
-//------------------------------------------------------------------------------
-void
-InstancingApp::updateParticles() {
-    const float frameTime = 1.0f / 60.0f;
-    for (int i = 0; i < this->curNumParticles; i++) {
-        auto& pos = this->positions[i];
-        auto& vec = this->vectors[i];
-        vec.y -= 1.0f * frameTime;
-        pos += vec * frameTime;
-        if (pos.y < -2.0f) {
-            pos.y = -1.8f;
-            vec.y = -vec.y;
-            vec *= 0.8f;
+        glm::vec3 rnd = glm::ballRand(0.5f);
+        rnd.y += 2.0f;
+        if (InvalidIndex == this->particleSystem.Emit(glm::vec3(0.0f, 0.0f, 0.0f), rnd)) {
+            break;
         }
     }
 }
@@ -166,6 +146,13 @@ InstancingApp::OnInit() {
         .Add(VertexAttr::Instance0, VertexFormat::Float4);
     this->drawState.Mesh[1] = Gfx::CreateResource(instMeshSetup);
 
+    // setup the particle system, this writes directly into the instance mesh format
+    ParticleSetup particleSetup;
+    particleSetup.MaxNumParticles = MaxNumParticles;
+    particleSetup.NumWorkers = 3;
+    particleSetup.Layout = instMeshSetup.Layout;
+    this->particleSystem.Setup(particleSetup);
+
     // setup draw state for instanced rendering
     Id shd = Gfx::CreateResource(Shader::Setup());
     auto ps = PipelineSetup::FromShader(shd);
@@ -187,6 +174,7 @@ InstancingApp::OnInit() {
 //------------------------------------------------------------------------------
 AppState::Code
 InstancingApp::OnCleanup() {
+    this->particleSystem.Discard();
     Input::Discard();
     Dbg::Discard();
     Gfx::Discard();
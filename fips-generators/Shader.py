@@ -2,7 +2,7 @@
 Code generator for shader libraries.
 '''
 
-Version = 58
+Version = 59
 
 import os
 import sys
@@ -159,6 +159,11 @@ validVsInNames = [
 validInOutTypes = [
     'float', 'vec2', 'vec3', 'vec4'
 ]
+# NOTE: no vec3, under std430 a vec3 array has a 16-byte stride, which
+# doesn't match tightly packed Float3 vertex components
+validBufferTypes = [
+    'float', 'vec2', 'vec4'
+]
 
 # NOTE: order is important, always go from greatest to smallest type,
 # and keep texture samplers at start!
@@ -493,15 +498,30 @@ class FragmentShader(Shader) :
     def getTag(self) :
         return 'fs'
 
+#-------------------------------------------------------------------------------
+class ComputeShader(Shader) :
+    '''
+    A compute shader function, with a work group size and storage buffers.
+    '''
+    def __init__(self, name) :
+        Shader.__init__(self, name)
+        self.localSize = [1, 1, 1]
+        self.buffers = []
+
+    def getTag(self) :
+        return 'cs'
+
 #-------------------------------------------------------------------------------
 class Program() :
     '''
-    A shader program, made of vertex/fragment shaders
+    A shader program, made of vertex/fragment shaders, or
+    of a single compute shader
     '''
-    def __init__(self, name, vs, fs, filePath, lineNumber) :
+    def __init__(self, name, vs, fs, cs, filePath, lineNumber) :
         self.name = name
         self.vs = vs
         self.fs = fs
+        self.cs = cs
         self.uniformBlocks = []
         self.textureBlocks = []
         self.filePath = filePath
@@ -651,18 +671,57 @@ class Parser :
         self.shaderLib.fragmentShaders[name] = fs
         self.push(fs)
 
+    #---------------------------------------------------------------------------
+    def onComputeShader(self, args) :
+        if len(args) != 1:
+            util.fmtError("@cs must have 1 arg (name)")
+        if self.current is not None :
+            util.fmtError("cannot nest @cs (missing @end in '{}'?)".format(self.current.name))
+        name = args[0]
+        if name in self.shaderLib.computeShaders :
+            util.fmtError("@cs '{}' already defined!".format(name))
+        cs = ComputeShader(name)
+        self.shaderLib.computeShaders[name] = cs
+        self.push(cs)
+
     #---------------------------------------------------------------------------
     def onProgram(self, args) :        
-        if len(args) != 3:
-            util.fmtError("@program must have 3 args (name vs fs)")
+        if len(args) != 2 and len(args) != 3:
+            util.fmtError("@program must have 3 args (name vs fs) or 2 args (name cs)")
         if self.current is not None :
             util.fmtError("cannot nest @program (missing @end tag in '{}'?)".format(self.current.name))
         name = args[0]
-        vs = args[1]
-        fs = args[2]
-        prog = Program(name, vs, fs, self.fileName, self.lineNumber)
+        if len(args) == 3 :
+            prog = Program(name, args[1], args[2], None, self.fileName, self.lineNumber)
+        else :
+            prog = Program(name, None, None, args[1], self.fileName, self.lineNumber)
         self.shaderLib.programs[name] = prog
 
+    #---------------------------------------------------------------------------
+    def onLocalSize(self, args) :
+        if not self.current or not self.current.getTag() in ['cs'] :
+            util.fmtError("@local_size must come after @cs!")
+        if len(args) < 1 or len(args) > 3 :
+            util.fmtError("@local_size must have 1..3 args (x [y [z]])")
+        for index, arg in enumerate(args) :
+            if not arg.isdigit() or int(arg) < 1 :
+                util.fmtError("invalid @local_size '{}', must be a positive number!".format(arg))
+            self.current.localSize[index] = int(arg)
+
+    #---------------------------------------------------------------------------
+    def onBuffer(self, args) :
+        if not self.current or not self.current.getTag() in ['cs'] :
+            util.fmtError("@buffer must come after @cs!")
+        if len(args) != 2:
+            util.fmtError("@buffer must have 2 args (type name)")
+        type = args[0]
+        name = args[1]
+        if type not in validBufferTypes :
+            util.fmtError("invalid @buffer type '{}', must be one of '{}' (for vec3 data use a float buffer)!".format(type, ','.join(validBufferTypes)))
+        if checkListDup(name, self.current.buffers) :
+            util.fmtError("@buffer '{}' already defined in '{}'!".format(name, self.current.name))
+        self.current.buffers.append(Attr(type, name, self.fileName, self.lineNumber))
+
     #---------------------------------------------------------------------------
     def onIn(self, args) :
         if not self.current or not self.current.getTag() in ['vs', 'fs'] :
@@ -705,8 +764,8 @@ class Parser :
 
     #---------------------------------------------------------------------------
     def onUseCodeBlock(self, args) :
-        if not self.current or not self.current.getTag() in ['code_block', 'vs', 'fs'] :
-            util.fmtError("@use_code_block must come after @code_block, @vs or @fs!")
+        if not self.current or not self.current.getTag() in ['code_block', 'vs', 'fs', 'cs'] :
+            util.fmtError("@use_code_block must come after @code_block, @vs, @fs or @cs!")
         if len(args) < 1:
             util.fmtError("@use_code_block must have at least one arg!")
         for arg in args :
@@ -714,8 +773,8 @@ class Parser :
 
     #---------------------------------------------------------------------------
     def onUseUniformBlock(self, args) :
-        if not self.current or not self.current.getTag() in ['vs', 'fs'] :
-            util.fmtError("@use_uniform_block must come after @vs or @fs!")
+        if not self.current or not self.current.getTag() in ['vs', 'fs', 'cs'] :
+            util.fmtError("@use_uniform_block must come after @vs, @fs or @cs!")
         if len(args) < 1:
             util.fmtError("@use_uniform_block must have at least one arg!")
         for arg in args :
@@ -724,7 +783,7 @@ class Parser :
             uniformBlock = self.shaderLib.uniformBlocks[arg]
             if uniformBlock.bindStage is not None :
                 if uniformBlock.bindStage != self.current.getTag() :
-                    util.fmtError("uniform_block '{}' cannot be used both in @vs and @fs!".format(arg))
+                    util.fmtError("uniform_block '{}' cannot be used in different shader stages!".format(arg))
             uniformBlock.bindStage = self.current.getTag()
             self.current.uniformBlockRefs.append(Reference(arg, self.fileName, self.lineNumber))
             self.current.uniformBlocks.append(uniformBlock)
@@ -748,12 +807,12 @@ class Parser :
 
     #---------------------------------------------------------------------------
     def onEnd(self, args) :
-        if not self.current or not self.current.getTag() in ['uniform_block', 'texture_block', 'code_block', 'vs', 'fs', 'program'] :
-            util.fmtError("@end must come after @uniform_block, @texture_block, @code_block, @vs, @fs or @program!")
+        if not self.current or not self.current.getTag() in ['uniform_block', 'texture_block', 'code_block', 'vs', 'fs', 'cs', 'program'] :
+            util.fmtError("@end must come after @uniform_block, @texture_block, @code_block, @vs, @fs, @cs or @program!")
         if len(args) != 0:
             util.fmtError("@end must not have arguments")
-        if self.current.getTag() in ['code_block', 'vs', 'fs'] and len(self.current.lines) == 0 :
-            util.fmtError("no source code lines in @code_block, @vs or @fs section")
+        if self.current.getTag() in ['code_block', 'vs', 'fs', 'cs'] and len(self.current.lines) == 0 :
+            util.fmtError("no source code lines in @code_block, @vs, @fs or @cs section")
         if self.current.getTag() == 'uniform_block' :
             self.current.parseUniforms()
         if self.current.getTag() == 'texture_block' :
@@ -780,6 +839,12 @@ class Parser :
                 self.onVertexShader(args)
             elif tag == 'fs':
                 self.onFragmentShader(args)
+            elif tag == 'cs':
+                self.onComputeShader(args)
+            elif tag == 'local_size':
+                self.onLocalSize(args)
+            elif tag == 'buffer':
+                self.onBuffer(args)
             elif tag == 'use_code_block':
                 self.onUseCodeBlock(args)
             elif tag == 'use_uniform_block':
@@ -959,6 +1024,39 @@ class GLSLGenerator :
         lines.append(Line('}', fs.lines[-1].path, fs.lines[-1].lineNumber))
         fs.generatedSource[slVersion] = lines
 
+    #---------------------------------------------------------------------------
+    def genComputeShaderSource(self, cs, slVersion) :
+        lines = []
+
+        # compute shaders need GLSL 4.30 (or GL_ARB_compute_shader)
+        lines.append(Line('#version 430'))
+
+        # write compatibility macros
+        for func in slMacros[slVersion] :
+            lines.append(Line('#define {} {}'.format(func, slMacros[slVersion][func])))
+
+        # write the work group size
+        lines.append(Line('layout(local_size_x={}, local_size_y={}, local_size_z={}) in;'.format(
+            cs.localSize[0], cs.localSize[1], cs.localSize[2])))
+
+        # write uniform blocks
+        lines = self.genUniforms(cs, slVersion, lines)
+
+        # write storage buffers, bind slots are the declaration order
+        for slot, buf in enumerate(cs.buffers) :
+            lines.append(Line('layout(std430, binding={}) buffer _{}_buf {{ {} {}[]; }};'.format(
+                slot, buf.name, buf.type, buf.name), buf.filePath, buf.lineNumber))
+
+        # write blocks the cs depends on
+        for dep in cs.resolvedDeps :
+            lines = self.genLines(lines, self.shaderLib.codeBlocks[dep].lines)
+
+        # write compute shader function
+        lines.append(Line('void main() {', cs.lines[0].path, cs.lines[0].lineNumber))
+        lines = self.genLines(lines, cs.lines)
+        lines.append(Line('}', cs.lines[-1].path, cs.lines[-1].lineNumber))
+        cs.generatedSource[slVersion] = lines
+
 #-------------------------------------------------------------------------------
 class HLSLGenerator :
     '''
@@ -1316,6 +1414,7 @@ class ShaderLibrary :
         self.textureBlocks = {}
         self.vertexShaders = {}
         self.fragmentShaders = {}
+        self.computeShaders = {}
         self.programs = {}
         self.current = None
 
@@ -1336,6 +1435,9 @@ class ShaderLibrary :
         print('Fragment Shaders:')
         for fs in self.fragmentShaders.values() :
             fs.dump()
+        print('Compute Shaders:')
+        for cs in self.computeShaders.values() :
+            cs.dump()
         print('Programs:')
         for prog in self.programs.values() :
             program.dump()
@@ -1403,6 +1505,14 @@ class ShaderLibrary :
         Gathers all uniform- and texture-blocks from all shaders in the program
         and assigns the bindStage
         '''
+        if program.cs is not None :
+            if program.cs not in self.computeShaders :
+                util.setErrorLocation(program.filePath, program.lineNumber)
+                util.fmtError("unknown compute shader '{}'".format(program.cs))
+            for uniformBlockRef in self.computeShaders[program.cs].uniformBlockRefs :
+                self.checkAddUniformBlock(uniformBlockRef, program.uniformBlocks)
+            return
+
         if program.vs not in self.vertexShaders :
             util.setErrorLocation(program.filePath, program.lineNumber)
             util.fmtError("unknown vertex shader '{}'".format(program.vs))
@@ -1428,10 +1538,14 @@ class ShaderLibrary :
         '''
         vsUBSlot = 0
         fsUBSlot = 0
+        csUBSlot = 0
         for ub in program.uniformBlocks :
             if ub.bindStage == 'vs' :
                 ub.bindSlot = vsUBSlot
                 vsUBSlot += 1
+            elif ub.bindStage == 'cs' :
+                ub.bindSlot = csUBSlot
+                csUBSlot += 1
             else :
                 ub.bindSlot = fsUBSlot
                 fsUBSlot += 1
@@ -1460,6 +1574,10 @@ class ShaderLibrary :
             for dep in fs.dependencies :
                 self.resolveDeps(fs, dep)
             self.removeDuplicateDeps(fs)
+        for cs in self.computeShaders.values() :
+            for dep in cs.dependencies :
+                self.resolveDeps(cs, dep)
+            self.removeDuplicateDeps(cs)
         for program in self.programs.values() :
             self.resolveUniformAndTextureBlocks(program)
             self.assignBindSlotIndices(program)
@@ -1475,6 +1593,8 @@ class ShaderLibrary :
         from the vertex shader
         '''
         for prog in self.programs.values() :
+            if prog.cs is not None :
+                continue
             fatalError = False
             vs = self.vertexShaders[prog.vs]
             fs = self.fragmentShaders[prog.fs]
@@ -1509,6 +1629,10 @@ class ShaderLibrary :
                     gen.genVertexShaderSource(vs, slVersion)
                 for fs in self.fragmentShaders.values() :
                     gen.genFragmentShaderSource(fs, slVersion)
+            # compute shaders only exist for the desktop GL core profile
+            if slVersion == 'glsl150' :
+                for cs in self.computeShaders.values() :
+                    gen.genComputeShaderSource(cs, slVersion)
 
     def generateShaderSourcesHLSL(self) :
         '''
@@ -1546,6 +1670,9 @@ class ShaderLibrary :
                 for fs in self.fragmentShaders.values() :
                     srcLines = fs.generatedSource[slVersion]
                     glslcompiler.validate(srcLines, 'fs', slVersion)
+                # NOTE: compute shaders are not validated, the bundled
+                # reference compiler predates GLSL 4.30, errors will be
+                # reported by the GL driver when the shader is created
 
     def validateAndWriteShadersHLSL(self, absHdrPath, args) :
         '''
@@ -1616,6 +1743,8 @@ def writeProgramHeader(f, shdLib, program) :
     for ub in program.uniformBlocks :
         if ub.bindStage == 'vs' :
             stageName = 'VS'
+        elif ub.bindStage == 'cs' :
+            stageName = 'CS'
         else :
             stageName = 'FS'
         f.write('        #pragma pack(push,1)\n')
@@ -1680,7 +1809,7 @@ def writeSourceBottom(f, shdLib) :
 
 #-------------------------------------------------------------------------------
 def writeShaderSource(f, absPath, shdLib, shd, slVersion) :
-    # note: shd is either a VertexShader or FragmentShader object
+    # note: shd is either a VertexShader, FragmentShader or ComputeShader object
     if isGLSL[slVersion] :
         # GLSL source code is directly inlined for runtime-compilation
         f.write('#if ORYOL_OPENGL\n')
@@ -1753,12 +1882,38 @@ def writeVertexLayout(f, vs) :
         f.write('    {}.Add({}, {});\n'.format(layoutName, mapAttrName[attr.name], mapAttrType[attr.type]))
     return layoutName
 
+#-------------------------------------------------------------------------------
+def writeProgramUniformBlocks(f, prog) :
+    # add uniform layouts to setup object
+    for ub in prog.uniformBlocks :
+        layoutName = '{}_ublayout'.format(ub.bindName)
+        f.write('    UniformBlockLayout {};\n'.format(layoutName))
+        f.write('    {}.TypeHash = {};\n'.format(layoutName, ub.getHash()))
+        for type in ub.uniformsByType :
+            for uniform in ub.uniformsByType[type] :
+                if uniform.num == 1 :
+                    f.write('    {}.Add("{}", {});\n'.format(layoutName, uniform.name, uniformOryolType[uniform.type]))
+                else :
+                    f.write('    {}.Add("{}", {}, {});\n'.format(layoutName, uniform.name, uniformOryolType[uniform.type], uniform.num))
+        f.write('    setup.AddUniformBlock("{}", {}, {}::_bindShaderStage, {}::_bindSlotIndex);\n'.format(
+            ub.name, layoutName, ub.bindName, ub.bindName))
+
 #-------------------------------------------------------------------------------
 def writeProgramSource(f, shdLib, prog) :
 
     # write the Setup() function
     f.write('ShaderSetup ' + prog.name + '::Setup() {\n')
     f.write('    ShaderSetup setup("' + prog.name + '");\n')
+    if prog.cs is not None :
+        # compute programs only exist as GLSL source
+        f.write('    #if ORYOL_OPENGL\n')
+        f.write('    setup.SetComputeProgramFromSources({}, {}_glsl150_src);\n'.format(
+            slSlangTypes['glsl150'], prog.cs))
+        f.write('    #endif\n')
+        writeProgramUniformBlocks(f, prog)
+        f.write('    return setup;\n')
+        f.write('}\n')
+        return
     vs = shdLib.vertexShaders[prog.vs]
     fs = shdLib.fragmentShaders[prog.fs]
     vsInputLayout = writeVertexLayout(f, vs)
@@ -1786,19 +1941,7 @@ def writeProgramSource(f, shdLib, prog) :
                 slangType, vsInputLayout, vsName, fsName))
         f.write('    #endif\n');
 
-    # add uniform layouts to setup object
-    for ub in prog.uniformBlocks :
-        layoutName = '{}_ublayout'.format(ub.bindName)
-        f.write('    UniformBlockLayout {};\n'.format(layoutName))
-        f.write('    {}.TypeHash = {};\n'.format(layoutName, ub.getHash()))
-        for type in ub.uniformsByType :
-            for uniform in ub.uniformsByType[type] :
-                if uniform.num == 1 :
-                    f.write('    {}.Add("{}", {});\n'.format(layoutName, uniform.name, uniformOryolType[uniform.type]))
-                else :
-                    f.write('    {}.Add("{}", {}, {});\n'.format(layoutName, uniform.name, uniformOryolType[uniform.type], uniform.num))
-        f.write('    setup.AddUniformBlock("{}", {}, {}::_bindShaderStage, {}::_bindSlotIndex);\n'.format(
-            ub.name, layoutName, ub.bindName, ub.bindName))
+    writeProgramUniformBlocks(f, prog)
 
     # add texture layouts to setup objects
     for tb in prog.textureBlocks :
@@ -1829,6 +1972,9 @@ def generateSource(absSourcePath, shdLib) :
             writeShaderSource(f, absSourcePath, shdLib, vs, slVersion)
         for fs in shdLib.fragmentShaders.values() :
             writeShaderSource(f, absSourcePath, shdLib, fs, slVersion)
+        for cs in shdLib.computeShaders.values() :
+            if slVersion in cs.generatedSource :
+                writeShaderSource(f, absSourcePath, shdLib, cs, slVersion)
     for prog in shdLib.programs.values() :
         writeProgramSource(f, shdLib, prog)
     writeSourceBottom(f, shdLib)  
@@ -7,6 +7,7 @@ import os
 import platform
 import subprocess
 import tempfile
+import glob
 
 ProjectDirectory = os.path.dirname(os.path.abspath(__file__)) + '/..'
 TexSrcDirectory = ProjectDirectory + '/data'
@@ -180,16 +181,64 @@ def toETC(srcFilename, dstFilename, format) :
     subprocess.call(args=cmd)
     os.unlink(tmpPath)
 
+#-------------------------------------------------------------------------------
+def getCookerPath() :
+    '''
+    Find the native texcook tool in the fips-deploy directory,
+    returns None if it hasn't been built
+    '''
+    wsDir = os.path.dirname(os.path.abspath(ProjectDirectory))
+    exe = 'texcook.exe' if platform.system() == 'Windows' else 'texcook'
+    paths = glob.glob(wsDir + '/fips-deploy/oryol/*/' + exe)
+    if not paths :
+        return None
+    # use the most recently built config
+    return max(paths, key=os.path.getmtime)
+
+#-------------------------------------------------------------------------------
+def cookTextures(jobs) :
+    '''
+    Convert a list of (srcFilename, dstFilename, format) tuples with
+    the native texcook tool, format is 'bc1', 'bc3', 'rgba8' or 'etc2'
+    (etc2 needs a .ktx dstFilename). All jobs are cooked in one run
+    on all CPU cores, and unchanged textures are skipped. Falls back
+    to the external tools if texcook hasn't been built.
+    '''
+    cooker = getCookerPath()
+    if cooker is None :
+        for srcFilename, dstFilename, fmt in jobs :
+            if fmt == 'etc2' :
+                toETC(srcFilename, dstFilename, 'ETC2')
+            elif fmt == 'rgba8' :
+                toDDS(srcFilename, dstFilename, False, 'rgb', 'rgba8')
+            else :
+                toDDS(srcFilename, dstFilename, False, fmt)
+        return
+
+    ensureDstDirectory()
+    jobPath = tempfile.gettempdir() + '/oryol_texcook_jobs.txt'
+    with open(jobPath, 'w') as f :
+        for srcFilename, dstFilename, fmt in jobs :
+            f.write('{} {} {}\n'.format(srcFilename, dstFilename, fmt))
+    print('=== cookTextures: {} textures => {}:'.format(len(jobs), TexDstDirectory))
+    res = subprocess.call(args=[cooker, '-jobs', jobPath, '-src', TexSrcDirectory, '-dst', TexDstDirectory])
+    os.unlink(jobPath)
+    if res != 0 :
+        error('texcook failed!')
+
 #-------------------------------------------------------------------------------
 def exportSampleTextures(types = ['dds','pvr','etc']) :
+    # textures the native cooker can handle are collected and cooked at the end
+    cookJobs = []
+
     # DDS
     if 'dds' in types :
         # default gamma 2.2
-        toDDS('lok256.jpg', 'lok_dxt1.dds', False, 'bc1')
+        cookJobs.append(('lok256.jpg', 'lok_dxt1.dds', 'bc1'))
+        cookJobs.append(('lok256.jpg', 'lok_dxt5.dds', 'bc3'))
+        cookJobs.append(('lok256.jpg', 'lok_rgba8.dds', 'rgba8'))
         toDDS('lok256.jpg', 'lok_dxt3.dds', False, 'bc2')
-        toDDS('lok256.jpg', 'lok_dxt5.dds', False, 'bc3')
         toDDS('lok256.jpg', 'lok_bgra8.dds', False, 'rgb', 'bgra8')
-        toDDS('lok256.jpg', 'lok_rgba8.dds', False, 'rgb', 'rgba8')
         toDDS('lok256.jpg', 'lok_bgr8.dds', False, 'rgb', 'bgr8')
         toDDS('lok256.jpg', 'lok_rgb8.dds', False, 'rgb', 'rgb8')
         toDDS('lok256.jpg', 'lok_argb4.dds', False, 'rgb', 'argb4')
@@ -225,7 +274,10 @@ def exportSampleTextures(types = ['dds','pvr','etc']) :
     # ETC1/2
     if 'etc' in types :
         toETC('lok256.jpg', 'lok_etc1.ktx', 'ETC1')
-        toETC('lok256.jpg', 'lok_etc2.ktx', 'ETC2')
+        cookJobs.append(('lok256.jpg', 'lok_etc2.ktx', 'etc2'))
+
+    if cookJobs :
+        cookTextures(cookJobs)
 
 #-------------------------------------------------------------------------------
 if __name__ == '__main__' :